@@ -57,6 +57,43 @@ static const char* JSON_PROVIDER_INFO = "{"
 static CmPkcs12* cm_pkcs12 = nullptr;
 
 
+static CM_ERROR init_uapkic (
+        CM_JSON_PCHAR providerParams
+)
+{
+    //  "selfTest": { "mode": "SERIAL" (default) | "PARALLEL" | "DEFERRED" }, without it the self-test is not run
+    JSON_Value* jv_params = providerParams ? json_parse_string((const char*)providerParams) : nullptr;
+    JSON_Object* jo_selftest = json_object_get_object(json_object(jv_params), "selfTest");
+    CM_ERROR cm_err = RET_OK;
+
+    if (jo_selftest) {
+        const char* s_mode = json_object_get_string(jo_selftest, "mode");
+        SelfTestMode mode = SELF_TEST_MODE_SERIAL;
+        if (!s_mode || (strcmp(s_mode, "SERIAL") == 0)) {
+            mode = SELF_TEST_MODE_SERIAL;
+        }
+        else if (strcmp(s_mode, "PARALLEL") == 0) {
+            mode = SELF_TEST_MODE_PARALLEL;
+        }
+        else if (strcmp(s_mode, "DEFERRED") == 0) {
+            mode = SELF_TEST_MODE_DEFERRED;
+        }
+        else {
+            cm_err = RET_CM_INVALID_PARAMETER;
+        }
+        if (cm_err == RET_OK) {
+            cm_err = uapkic_init_ex(nullptr, mode, nullptr);
+        }
+    }
+    else {
+        uapkic_init(nullptr, nullptr);
+    }
+
+    json_value_free(jv_params);
+    return cm_err;
+}
+
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -80,7 +117,10 @@ CM_EXPORT CM_ERROR provider_init (
     DEBUG_OUTPUT("provider_init()");
     CM_ERROR cm_err = RET_CM_GENERAL_ERROR;
     if (!cm_pkcs12) {
-        uapkic_init(nullptr, nullptr);
+        cm_err = init_uapkic(providerParams);
+        if (cm_err != RET_OK) return cm_err;
+
+        cm_err = RET_CM_GENERAL_ERROR;
         cm_pkcs12 = new CmPkcs12();
         if (cm_pkcs12) {
             cm_err = cm_pkcs12->parseConfig(providerParams, cm_pkcs12->getDefaultParam());
@@ -33,17 +33,49 @@
 #include "uapkic-errors.h"
 
 
-int json_object_set_hex (JSON_Object* jsonObject, const char* name, const ByteArray* baData)
+//  Encoded string is written straight into the buffer of the new JSON value,
+//  without intermediate string, copying and UTF-8 validation
+static int json_value_init_encoded (const ByteArray* baData, const bool isBase64, JSON_Value** jsonValue)
+{
+    JSON_Value* json_value = NULL;
+    char* buf = NULL;
+    size_t len;
+    int ret;
+
+    if (!baData) return RET_INVALID_PARAM;
+
+    len = (isBase64) ? 4 * ((ba_get_len(baData) + 2) / 3) + 1 : 2 * ba_get_len(baData) + 1;
+    json_value = json_value_init_string_buffer(len - 1, &buf);
+    if (!json_value) return RET_MEMORY_ALLOC_ERROR;
+
+    ret = (isBase64) ? ba_to_base64(baData, buf, &len) : ba_to_hex(baData, buf, &len);
+    if (ret == RET_OK) {
+        *jsonValue = json_value;
+    }
+    else {
+        json_value_free(json_value);
+    }
+    return ret;
+}
+
+static int json_object_set_encoded (JSON_Object* jsonObject, const char* name, const ByteArray* baData, const bool isBase64)
 {
-    char* str = NULL;
-    int ret = ba_to_hex_with_alloc(baData, &str);
+    JSON_Value* json_value = NULL;
+    int ret = json_value_init_encoded(baData, isBase64, &json_value);
     if (ret == RET_OK) {
-        ret = (json_object_set_string(jsonObject, name, str) == JSONSuccess) ? RET_OK : RET_UAPKI_JSON_FAILURE;
-        free(str);
+        if (json_object_set_value(jsonObject, name, json_value) != JSONSuccess) {
+            json_value_free(json_value);
+            ret = RET_UAPKI_JSON_FAILURE;
+        }
     }
     return ret;
 }
 
+int json_object_set_hex (JSON_Object* jsonObject, const char* name, const ByteArray* baData)
+{
+    return json_object_set_encoded(jsonObject, name, baData, false);
+}
+
 ByteArray* json_object_get_hex (const JSON_Object* jsonObject, const char* name)
 {
     const char* str = json_object_get_string(jsonObject, name);
@@ -53,13 +85,7 @@ ByteArray* json_object_get_hex (const JSON_Object* jsonObject, const char* name)
 
 int json_object_set_base64 (JSON_Object* jsonObject, const char* name, const ByteArray* baData)
 {
-    char* str = NULL;
-    int ret = ba_to_base64_with_alloc(baData, &str);
-    if (ret == RET_OK) {
-        ret = (json_object_set_string(jsonObject, name, str) == JSONSuccess) ? RET_OK : RET_UAPKI_JSON_FAILURE;
-        free(str);
-    }
-    return ret;
+    return json_object_set_encoded(jsonObject, name, baData, true);
 }
 
 ByteArray* json_object_get_base64 (const JSON_Object* jsonObject, const char* name)
@@ -71,11 +97,13 @@ ByteArray* json_object_get_base64 (const JSON_Object* jsonObject, const char* na
 
 int json_array_append_base64 (JSON_Array* jsonArray, const ByteArray* baData)
 {
-    char* str = NULL;
-    int ret = ba_to_base64_with_alloc(baData, &str);
+    JSON_Value* json_value = NULL;
+    int ret = json_value_init_encoded(baData, true, &json_value);
     if (ret == RET_OK) {
-        ret = (json_array_append_string(jsonArray, (const char*)str) == JSONSuccess) ? RET_OK : RET_UAPKI_JSON_FAILURE;
-        free(str);
+        if (json_array_append_value(jsonArray, json_value) != JSONSuccess) {
+            json_value_free(json_value);
+            ret = RET_UAPKI_JSON_FAILURE;
+        }
     }
     return ret;
 }
@@ -1413,6 +1413,26 @@ JSON_Value * json_value_init_string(const char *string) {
     return json_value_init_string_with_len(string, strlen(string));
 }
 
+JSON_Value * json_value_init_string_buffer(size_t length, char **buffer) {
+    char *chars = NULL;
+    JSON_Value *value;
+    if (buffer == NULL || length == (size_t)-1) {
+        return NULL;
+    }
+    chars = (char*)parson_malloc(length + 1);
+    if (chars == NULL) {
+        return NULL;
+    }
+    chars[length] = '\0';
+    value = json_value_init_string_no_copy(chars, length);
+    if (value == NULL) {
+        parson_free(chars);
+        return NULL;
+    }
+    *buffer = chars;
+    return value;
+}
+
 JSON_Value * json_value_init_string_with_len(const char *string, size_t length) {
     char *copy = NULL;
     JSON_Value *value;
@@ -100,23 +100,11 @@ int ArchiveTs3Helper::setSignerInfo (
 {
     if (!signerInfo) return RET_UAPKI_INVALID_PARAMETER;
 
-    int ret = RET_OK;
-    SignerInfo_t* signer_info = (SignerInfo_t*)asn_copy_with_alloc(get_SignerInfo_desc(), signerInfo);
-    ANY_t* any_unsignedattrs = nullptr;
-
-    if (!signer_info) {
-        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
-    }
+    //  Shallow copy without unsignedAttrs: members are only read by the encoder
+    SignerInfo_t signer_info = *signerInfo;
+    signer_info.unsignedAttrs = nullptr;
 
-    any_unsignedattrs = signer_info->unsignedAttrs;
-    signer_info->unsignedAttrs = nullptr;
-
-    DO(asn_encode_ba(get_SignerInfo_desc(), signer_info, &m_Parts.signerInfo));
-
-cleanup:
-    signer_info->unsignedAttrs = any_unsignedattrs;
-    asn_free(get_SignerInfo_desc(), signer_info);
-    return ret;
+    return asn_encode_ba(get_SignerInfo_desc(), &signer_info, &m_Parts.signerInfo);
 }
 
 int ArchiveTs3Helper::setUnsignedAttrs (
@@ -126,38 +114,25 @@ int ArchiveTs3Helper::setUnsignedAttrs (
     if (!unsignedAttrs) return RET_UAPKI_INVALID_PARAMETER;
 
     int ret = RET_OK;
-    Attributes_t* unsigned_attrs = nullptr;
-    Attribute_t* attr = nullptr;
-    SmartBA sba_encoded;
-
-    unsigned_attrs = (Attributes_t*)asn_copy_with_alloc(get_Attributes_desc(), unsignedAttrs);
-    if (!unsigned_attrs) {
-        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
-    }
-    DO(asn_encode_ba(get_Attributes_desc(), unsigned_attrs, &sba_encoded));
-    asn_free(get_Attributes_desc(), unsigned_attrs);
-
-    unsigned_attrs = (Attributes_t*)asn_decode_ba_with_alloc(get_Attributes_desc(), sba_encoded.get());
-    if (!unsigned_attrs) {
-        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
-    }
-
-    m_ATSHashIndex.unsignedAttrHashes.reserve((size_t)unsigned_attrs->list.count);
-    for (int i = 0; i < unsigned_attrs->list.count; i++) {
-        sba_encoded.clear();
-        attr = (Attribute_t*)asn_copy_with_alloc(get_Attribute_desc(), unsigned_attrs->list.array[i]);
-        if (!unsigned_attrs) {
+    SmartBA sba_encoded, sba_attr;
+    AsnTlvCursor cursor;
+    AsnTlv tlv_attrs, tlv_attr;
+
+    //  DER of SET OF is sorted, its elements are hashed as they are - without decoding and re-encoding
+    DO(asn_encode_ba(get_Attributes_desc(), unsignedAttrs, &sba_encoded));
+    DO(asn_tlv_read(sba_encoded.buf(), sba_encoded.size(), &tlv_attrs));
+    DO(asn_tlv_enter(&cursor, &tlv_attrs));
+
+    m_ATSHashIndex.unsignedAttrHashes.reserve((size_t)unsignedAttrs->list.count);
+    while (!asn_tlv_cursor_end(&cursor)) {
+        DO(asn_tlv_next(&cursor, &tlv_attr));
+        if (!sba_attr.reset(asn_tlv_to_ba_view(&tlv_attr))) {
             SET_ERROR(RET_UAPKI_GENERAL_ERROR);
         }
-        DO(asn_encode_ba(get_Attribute_desc(), attr, &sba_encoded));
-        asn_free(get_Attribute_desc(), attr);
-        attr = nullptr;
-        DO(addUnsignedAttr(sba_encoded.get()));
+        DO(addUnsignedAttr(sba_attr.get()));
     }
 
 cleanup:
-    asn_free(get_Attributes_desc(), unsigned_attrs);
-    asn_free(get_Attribute_desc(), attr);
     return ret;
 }
 
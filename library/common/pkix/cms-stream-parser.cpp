@@ -0,0 +1,603 @@
+/*
+ * Copyright (c) 2023, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define FILE_MARKER "common/pkix/cms-stream-parser.cpp"
+
+#include "cms-stream-parser.h"
+#include "macros-internal.h"
+#include "oids.h"
+#include "uapkic-errors.h"
+#include "uapki-errors.h"
+#include "uapki-ns-util.h"
+
+
+using namespace std;
+
+
+namespace UapkiNS {
+
+namespace Pkcs7 {
+
+
+//  Tags (identifier octets) of the elements that the parser needs to distinguish
+static const uint8_t TAG_EOC            = 0x00;
+static const uint8_t TAG_INTEGER        = 0x02;
+static const uint8_t TAG_OCTET_STRING   = 0x04;
+static const uint8_t TAG_OID            = 0x06;
+static const uint8_t TAG_SEQUENCE       = 0x30;
+static const uint8_t TAG_SET            = 0x31;
+static const uint8_t TAG_CONSTRUCTED    = 0x20;
+static const uint8_t TAG_CONTEXT_0      = 0x80;
+static const uint8_t TAG_CONS_CONTEXT_0 = 0xA0;
+static const uint8_t TAG_CONS_CONTEXT_1 = 0xA1;
+
+
+enum class CmsStreamParser::Node : uint32_t {
+    CONTENT_INFO = 0,
+    CONTENT,
+    SIGNED_DATA,
+    ENVELOPED_DATA,
+    ENCAP_CONTENT_INFO,
+    ECONTENT,
+    OCTETS,                 //  constructed OCTET STRING with the content
+    CERTS,
+    CRLS,
+    SIGNER_INFOS,
+    ORIGINATOR_INFO,
+    RECIPIENT_INFOS,
+    ENCRYPTED_CONTENT_INFO,
+    CAPTURED,               //  nested element of the captured element
+    SKIPPED
+};  //  end enum class CmsStreamParser::Node
+
+enum class CmsStreamParser::Capture : uint32_t {
+    NONE = 0,
+    CONTENT_TYPE,
+    VERSION,
+    DIGEST_ALGORITHMS,
+    ENCAP_CONTENT_TYPE,
+    CERT,
+    CRL,
+    SIGNER_INFO,
+    RECIPIENT_INFO,
+    CONTENT_ENCRYPTION_ALGO,
+    UNPROTECTED_ATTRS
+};  //  end enum class CmsStreamParser::Capture
+
+
+CmsStreamParser::CmsStreamParser (
+        const Callbacks& callbacks,
+        const size_t maxElementSize
+)
+    : m_Callbacks(callbacks)
+    , m_MaxElementSize(maxElementSize)
+    , m_Offset(0)
+    , m_HeaderLen(0)
+    , m_Completed(false)
+    , m_PrimitiveLeft(0)
+    , m_PrimitiveStream(false)
+    , m_Capture(Capture::NONE)
+    , m_CaptureDepth(0)
+    , m_Version(0)
+    , m_ContentSize(0)
+    , m_ContentPresent(false)
+{
+}
+
+CmsStreamParser::~CmsStreamParser (void)
+{
+}
+
+int CmsStreamParser::update (
+        const uint8_t* data,
+        const size_t size
+)
+{
+    int ret = RET_OK;
+    size_t pos = 0;
+    bool completed = false;
+
+    if (!data && (size > 0)) return RET_UAPKI_INVALID_PARAMETER;
+
+    while (pos < size) {
+        if (m_PrimitiveLeft > 0) {
+            const size_t len = (m_PrimitiveLeft < (uint64_t)(size - pos)) ? (size_t)m_PrimitiveLeft : (size - pos);
+            DO(onPrimitiveData(data + pos, len));
+            pos += len;
+            m_Offset += len;
+            m_PrimitiveLeft -= len;
+            if (m_PrimitiveLeft == 0) {
+                if ((m_Capture != Capture::NONE) && (m_Stack.size() == m_CaptureDepth)) {
+                    DO(finishCapture());
+                }
+                DO(closeFrames());
+            }
+            continue;
+        }
+
+        //  Trailing data after ContentInfo
+        if (m_Completed) {
+            SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+        }
+
+        if (m_HeaderLen >= sizeof(m_Header)) {
+            SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+        }
+        m_Header[m_HeaderLen++] = data[pos++];
+        m_Offset++;
+        DO(parseHeader(completed));
+        if (completed) {
+            m_HeaderLen = 0;
+        }
+    }
+
+cleanup:
+    return ret;
+}
+
+int CmsStreamParser::final (void)
+{
+    if (!m_Completed || !m_Stack.empty() || (m_HeaderLen > 0) || (m_PrimitiveLeft > 0)) return RET_UAPKI_INVALID_STRUCT;
+
+    return RET_OK;
+}
+
+int CmsStreamParser::closeFrames (void)
+{
+    int ret = RET_OK;
+
+    while (!m_Stack.empty()) {
+        const Frame& frame = m_Stack.back();
+        if (frame.indefinite || (m_Offset < frame.end)) break;
+        if (m_Offset > frame.end) {
+            SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+        }
+
+        m_Stack.pop_back();
+        if ((m_Capture != Capture::NONE) && (m_Stack.size() == m_CaptureDepth)) {
+            DO(finishCapture());
+        }
+    }
+
+    if (m_Stack.empty()) {
+        m_Completed = true;
+    }
+
+cleanup:
+    return ret;
+}
+
+int CmsStreamParser::finishCapture (void)
+{
+    int ret = RET_OK;
+    const Capture capture = m_Capture;
+    AsnArena* arena = nullptr;
+    const void* decoded = nullptr;
+    long version = 0;
+
+    m_Capture = Capture::NONE;
+
+    CHECK_NOT_NULL(arena = asn_arena_alloc(m_Captured.size()));
+
+    switch (capture) {
+    case Capture::CONTENT_TYPE:
+    case Capture::ENCAP_CONTENT_TYPE:
+        CHECK_NOT_NULL(decoded = asn_decode_arena_view(get_OBJECT_IDENTIFIER_desc(), arena, m_Captured.data(), m_Captured.size()));
+        DO(Util::oidFromAsn1((const OBJECT_IDENTIFIER_t*)decoded, (capture == Capture::CONTENT_TYPE) ? m_ContentType : m_EncapContentType));
+        break;
+    case Capture::VERSION:
+        CHECK_NOT_NULL(decoded = asn_decode_arena_view(get_INTEGER_desc(), arena, m_Captured.data(), m_Captured.size()));
+        DO(asn_INTEGER2long((const INTEGER_t*)decoded, &version));
+        if (oid_is_equal(m_ContentType.c_str(), OID_PKCS7_SIGNED_DATA)) {
+            if ((version < 1) || (version > 5) || (version == 2)) {
+                SET_ERROR(RET_UAPKI_INVALID_STRUCT_VERSION);
+            }
+        }
+        else if ((version < 0) || (version > 4)) {
+            SET_ERROR(RET_UAPKI_INVALID_STRUCT_VERSION);
+        }
+        m_Version = (uint32_t)version;
+        break;
+    case Capture::DIGEST_ALGORITHMS:
+        CHECK_NOT_NULL(decoded = asn_decode_arena_view(get_DigestAlgorithmIdentifiers_desc(), arena, m_Captured.data(), m_Captured.size()));
+        DO(SignedDataParser::decodeDigestAlgorithms(*(const DigestAlgorithmIdentifiers_t*)decoded, m_DigestAlgorithms));
+        break;
+    case Capture::CERT:
+        if (m_Callbacks.onCert) {
+            SmartBA sba_cert;
+            //  Re-encoded to DER like SignedDataParser does
+            CHECK_NOT_NULL(decoded = asn_decode_arena_view(get_CertificateChoices_desc(), arena, m_Captured.data(), m_Captured.size()));
+            DO(asn_encode_ba(get_CertificateChoices_desc(), decoded, &sba_cert));
+            DO(m_Callbacks.onCert(m_Callbacks.context, sba_cert.get()));
+        }
+        break;
+    case Capture::CRL:
+        if (m_Callbacks.onCrl) {
+            SmartBA sba_crl;
+            CHECK_NOT_NULL(decoded = asn_decode_arena_view(get_RevocationInfoChoice_desc(), arena, m_Captured.data(), m_Captured.size()));
+            DO(asn_encode_ba(get_RevocationInfoChoice_desc(), decoded, &sba_crl));
+            DO(m_Callbacks.onCrl(m_Callbacks.context, sba_crl.get()));
+        }
+        break;
+    case Capture::SIGNER_INFO:
+        if (m_Callbacks.onSignerInfo) {
+            SignedDataParser::SignerInfo signer_info;
+            CHECK_NOT_NULL(decoded = asn_decode_arena_view(get_SignerInfo_desc(), arena, m_Captured.data(), m_Captured.size()));
+            DO(signer_info.parse((const SignerInfo_t*)decoded));
+            DO(m_Callbacks.onSignerInfo(m_Callbacks.context, signer_info));
+        }
+        break;
+    case Capture::RECIPIENT_INFO:
+        if (m_Callbacks.onRecipientInfo) {
+            CHECK_NOT_NULL(decoded = asn_decode_arena_view(get_RecipientInfo_desc(), arena, m_Captured.data(), m_Captured.size()));
+            DO(m_Callbacks.onRecipientInfo(m_Callbacks.context, *(const RecipientInfo_t*)decoded));
+        }
+        break;
+    case Capture::CONTENT_ENCRYPTION_ALGO:
+        CHECK_NOT_NULL(decoded = asn_decode_arena_view(get_AlgorithmIdentifier_desc(), arena, m_Captured.data(), m_Captured.size()));
+        DO(Util::algorithmIdentifierFromAsn1(*(const AlgorithmIdentifier_t*)decoded, m_ContentEncryptionAlgo));
+        break;
+    case Capture::UNPROTECTED_ATTRS:
+        //  [1] IMPLICIT SET OF Attribute: decoded as Attributes with the universal tag
+        m_Captured[0] = TAG_SET;
+        CHECK_NOT_NULL(decoded = asn_decode_arena_view(get_Attributes_desc(), arena, m_Captured.data(), m_Captured.size()));
+        DO(EnvelopedDataParser::parseUnprotectedAttrs((const Attributes_t*)decoded, m_UnprotectedAttrs));
+        break;
+    default:
+        break;
+    }
+
+cleanup:
+    asn_arena_free(arena);
+    m_Captured.clear();
+    return ret;
+}
+
+int CmsStreamParser::onElement (
+        const uint8_t tag,
+        const bool constructed,
+        const bool indefinite,
+        const uint64_t length
+)
+{
+    enum class Action { DESCEND, CAPTURE, STREAM, SKIP };
+
+    int ret = RET_OK;
+    Action action = Action::SKIP;
+    Node node = Node::SKIPPED;
+    Capture capture = Capture::NONE;
+    size_t idx_child = 0;
+
+    if (!m_Stack.empty()) {
+        Frame& parent = m_Stack.back();
+        idx_child = parent.countChildren++;
+        if (!parent.indefinite && !indefinite && (m_Offset + length > parent.end)) {
+            SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+        }
+    }
+    else if (m_Completed) {
+        SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+    }
+
+    if (m_Capture != Capture::NONE) {
+        //  Nested element of the captured element, header already appended
+        if (constructed) {
+            m_Stack.push_back(Frame{ Node::CAPTURED, indefinite, indefinite ? 0 : m_Offset + length, 0 });
+        }
+        else {
+            m_PrimitiveLeft = length;
+            m_PrimitiveStream = false;
+        }
+        DO(closeFrames());
+        goto cleanup;
+    }
+
+    if (m_Stack.empty()) {
+        if (tag != TAG_SEQUENCE) {
+            SET_ERROR(RET_UAPKI_INVALID_CONTENT_INFO);
+        }
+        action = Action::DESCEND;
+        node = Node::CONTENT_INFO;
+    }
+    else switch (m_Stack.back().node) {
+    case Node::CONTENT_INFO:
+        if ((tag == TAG_OID) && (idx_child == 0)) {
+            action = Action::CAPTURE;
+            capture = Capture::CONTENT_TYPE;
+        }
+        else if ((tag == TAG_CONS_CONTEXT_0) && (idx_child == 1)) {
+            action = Action::DESCEND;
+            node = Node::CONTENT;
+        }
+        else {
+            SET_ERROR(RET_UAPKI_INVALID_CONTENT_INFO);
+        }
+        break;
+    case Node::CONTENT:
+        if ((tag != TAG_SEQUENCE) || (idx_child != 0)) {
+            SET_ERROR(RET_UAPKI_INVALID_CONTENT_INFO);
+        }
+        action = Action::DESCEND;
+        if (oid_is_equal(m_ContentType.c_str(), OID_PKCS7_SIGNED_DATA)) {
+            node = Node::SIGNED_DATA;
+        }
+        else if (oid_is_equal(m_ContentType.c_str(), OID_PKCS7_ENVELOPED_DATA)) {
+            node = Node::ENVELOPED_DATA;
+        }
+        else {
+            SET_ERROR(RET_UAPKI_INVALID_CONTENT_INFO);
+        }
+        break;
+    case Node::SIGNED_DATA:
+        if (tag == TAG_INTEGER) {
+            action = Action::CAPTURE;
+            capture = Capture::VERSION;
+        }
+        else if ((tag == TAG_SET) && (idx_child == 1)) {
+            action = Action::CAPTURE;
+            capture = Capture::DIGEST_ALGORITHMS;
+        }
+        else if (tag == TAG_SEQUENCE) {
+            action = Action::DESCEND;
+            node = Node::ENCAP_CONTENT_INFO;
+        }
+        else if (tag == TAG_CONS_CONTEXT_0) {
+            action = Action::DESCEND;
+            node = Node::CERTS;
+        }
+        else if (tag == TAG_CONS_CONTEXT_1) {
+            action = Action::DESCEND;
+            node = Node::CRLS;
+        }
+        else if (tag == TAG_SET) {
+            action = Action::DESCEND;
+            node = Node::SIGNER_INFOS;
+        }
+        break;
+    case Node::ENVELOPED_DATA:
+        if (tag == TAG_INTEGER) {
+            action = Action::CAPTURE;
+            capture = Capture::VERSION;
+        }
+        else if (tag == TAG_CONS_CONTEXT_0) {
+            action = Action::DESCEND;
+            node = Node::ORIGINATOR_INFO;
+        }
+        else if (tag == TAG_SET) {
+            action = Action::DESCEND;
+            node = Node::RECIPIENT_INFOS;
+        }
+        else if (tag == TAG_SEQUENCE) {
+            action = Action::DESCEND;
+            node = Node::ENCRYPTED_CONTENT_INFO;
+        }
+        else if (tag == TAG_CONS_CONTEXT_1) {
+            action = Action::CAPTURE;
+            capture = Capture::UNPROTECTED_ATTRS;
+        }
+        break;
+    case Node::ORIGINATOR_INFO:
+        if (tag == TAG_CONS_CONTEXT_0) {
+            action = Action::DESCEND;
+            node = Node::CERTS;
+        }
+        else if (tag == TAG_CONS_CONTEXT_1) {
+            action = Action::DESCEND;
+            node = Node::CRLS;
+        }
+        break;
+    case Node::ENCAP_CONTENT_INFO:
+        if (tag == TAG_OID) {
+            action = Action::CAPTURE;
+            capture = Capture::ENCAP_CONTENT_TYPE;
+        }
+        else if (tag == TAG_CONS_CONTEXT_0) {
+            action = Action::DESCEND;
+            node = Node::ECONTENT;
+            m_ContentPresent = true;
+        }
+        break;
+    case Node::ECONTENT:
+    case Node::OCTETS:
+        if (tag == TAG_OCTET_STRING) {
+            action = Action::STREAM;
+        }
+        else if (tag == (TAG_OCTET_STRING | TAG_CONSTRUCTED)) {
+            action = Action::DESCEND;
+            node = Node::OCTETS;
+        }
+        else {
+            SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+        }
+        break;
+    case Node::ENCRYPTED_CONTENT_INFO:
+        if (tag == TAG_OID) {
+            action = Action::CAPTURE;
+            capture = Capture::ENCAP_CONTENT_TYPE;
+        }
+        else if (tag == TAG_SEQUENCE) {
+            action = Action::CAPTURE;
+            capture = Capture::CONTENT_ENCRYPTION_ALGO;
+        }
+        else if (tag == TAG_CONTEXT_0) {
+            action = Action::STREAM;
+            m_ContentPresent = true;
+        }
+        else if (tag == TAG_CONS_CONTEXT_0) {
+            action = Action::DESCEND;
+            node = Node::OCTETS;
+            m_ContentPresent = true;
+        }
+        break;
+    case Node::CERTS:
+        action = Action::CAPTURE;
+        capture = Capture::CERT;
+        break;
+    case Node::CRLS:
+        action = Action::CAPTURE;
+        capture = Capture::CRL;
+        break;
+    case Node::SIGNER_INFOS:
+        action = Action::CAPTURE;
+        capture = Capture::SIGNER_INFO;
+        break;
+    case Node::RECIPIENT_INFOS:
+        action = Action::CAPTURE;
+        capture = Capture::RECIPIENT_INFO;
+        break;
+    default:
+        break;
+    }
+
+    if ((action == Action::DESCEND) && !constructed) {
+        SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+    }
+    if ((action == Action::STREAM) && constructed) {
+        SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+    }
+
+    if (action == Action::CAPTURE) {
+        if (m_HeaderLen + length > m_MaxElementSize) {
+            SET_ERROR(RET_DATA_TOO_LONG);
+        }
+        m_Capture = capture;
+        m_CaptureDepth = m_Stack.size();
+        m_Captured.clear();
+        m_Captured.insert(m_Captured.end(), m_Header, m_Header + m_HeaderLen);
+        node = Node::CAPTURED;
+    }
+
+    if (constructed) {
+        m_Stack.push_back(Frame{ node, indefinite, indefinite ? 0 : m_Offset + length, 0 });
+    }
+    else {
+        m_PrimitiveLeft = length;
+        m_PrimitiveStream = (action == Action::STREAM);
+        if ((length == 0) && (m_Capture != Capture::NONE) && (m_Stack.size() == m_CaptureDepth)) {
+            DO(finishCapture());
+        }
+    }
+
+    DO(closeFrames());
+
+cleanup:
+    return ret;
+}
+
+int CmsStreamParser::onPrimitiveData (
+        const uint8_t* data,
+        const size_t size
+)
+{
+    if (m_Capture != Capture::NONE) {
+        if (m_Captured.size() + size > m_MaxElementSize) return RET_DATA_TOO_LONG;
+        m_Captured.insert(m_Captured.end(), data, data + size);
+        return RET_OK;
+    }
+
+    if (m_PrimitiveStream) {
+        m_ContentSize += size;
+        if (m_Callbacks.onContent) return m_Callbacks.onContent(m_Callbacks.context, data, size);
+    }
+    return RET_OK;
+}
+
+int CmsStreamParser::parseHeader (
+        bool& completed
+)
+{
+    int ret = RET_OK;
+    size_t pos = 1;
+    uint8_t len_byte = 0;
+    bool indefinite = false;
+    uint64_t length = 0;
+    const uint8_t tag = m_Header[0];
+    const bool constructed = ((tag & TAG_CONSTRUCTED) != 0);
+
+    completed = false;
+
+    //  High-tag-number form: subsequent octets with bit 8 set
+    if ((tag & 0x1F) == 0x1F) {
+        while ((pos < m_HeaderLen) && (m_Header[pos] & 0x80)) pos++;
+        if (pos >= m_HeaderLen) return RET_OK;
+        pos++;
+    }
+    if (pos >= m_HeaderLen) return RET_OK;
+
+    len_byte = m_Header[pos++];
+    if (len_byte == 0x80) {
+        indefinite = true;
+    }
+    else if (len_byte & 0x80) {
+        const size_t cnt_bytes = (size_t)(len_byte & 0x7F);
+        if (cnt_bytes > sizeof(uint64_t)) {
+            SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+        }
+        if (m_HeaderLen < pos + cnt_bytes) return RET_OK;
+        for (size_t i = 0; i < cnt_bytes; i++) {
+            length = (length << 8) | m_Header[pos++];
+        }
+    }
+    else {
+        length = len_byte;
+    }
+
+    completed = true;
+    if (indefinite && !constructed) {
+        SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+    }
+
+    if (m_Capture != Capture::NONE) {
+        if (m_Captured.size() + m_HeaderLen > m_MaxElementSize) {
+            SET_ERROR(RET_DATA_TOO_LONG);
+        }
+        m_Captured.insert(m_Captured.end(), m_Header, m_Header + m_HeaderLen);
+    }
+
+    if ((tag == TAG_EOC) && !indefinite) {
+        //  End-of-contents closes the current indefinite-length element
+        if ((length != 0) || m_Stack.empty() || !m_Stack.back().indefinite) {
+            SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+        }
+        m_Stack.pop_back();
+        if ((m_Capture != Capture::NONE) && (m_Stack.size() == m_CaptureDepth)) {
+            DO(finishCapture());
+        }
+        DO(closeFrames());
+    }
+    else {
+        DO(onElement(tag, constructed, indefinite, length));
+    }
+
+cleanup:
+    return ret;
+}
+
+
+}   //  end namespace Pkcs7
+
+}   //  end namespace UapkiNS
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2023, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef UAPKI_NS_CMS_STREAM_PARSER_H
+#define UAPKI_NS_CMS_STREAM_PARSER_H
+
+
+#include "uapki-ns.h"
+#include "envelopeddata-helper.h"
+#include "signeddata-helper.h"
+
+
+namespace UapkiNS {
+
+namespace Pkcs7 {
+
+    //  Push-style parser of ContentInfo with SignedData or EnvelopedData in BER (including
+    //  indefinite-length and constructed OCTET STRING). The encapsulated (encrypted) content
+    //  is passed to the callback chunk by chunk, other elements are decoded one by one,
+    //  so memory does not depend on the size of the content
+    class CmsStreamParser {
+    public:
+        static const size_t DEFAULT_MAX_ELEMENT_SIZE = 64 * 1024 * 1024;
+
+        //  All callbacks are optional, a non-zero return code stops the parsing
+        struct Callbacks {
+            void*   context;
+            int     (*onContent) (void* context, const uint8_t* data, const size_t size);
+            int     (*onCert) (void* context, const ByteArray* baEncoded);
+            int     (*onCrl) (void* context, const ByteArray* baEncoded);
+            int     (*onSignerInfo) (void* context, const SignedDataParser::SignerInfo& signerInfo);
+            int     (*onRecipientInfo) (void* context, const RecipientInfo_t& recipientInfo);
+
+            Callbacks (void)
+                : context(nullptr), onContent(nullptr), onCert(nullptr), onCrl(nullptr)
+                , onSignerInfo(nullptr), onRecipientInfo(nullptr) {
+            }
+        };  //  end struct Callbacks
+
+    private:
+        enum class Node : uint32_t;
+        enum class Capture : uint32_t;
+
+        struct Frame {
+            Node        node;
+            bool        indefinite;
+            uint64_t    end;
+            size_t      countChildren;
+        };  //  end struct Frame
+
+        Callbacks   m_Callbacks;
+        size_t      m_MaxElementSize;
+        uint64_t    m_Offset;
+        uint8_t     m_Header[16];
+        size_t      m_HeaderLen;
+        std::vector<Frame>
+                    m_Stack;
+        bool        m_Completed;
+        uint64_t    m_PrimitiveLeft;
+        bool        m_PrimitiveStream;
+        Capture     m_Capture;
+        size_t      m_CaptureDepth;
+        std::vector<uint8_t>
+                    m_Captured;
+
+        std::string m_ContentType;
+        uint32_t    m_Version;
+        std::vector<std::string>
+                    m_DigestAlgorithms;
+        std::string m_EncapContentType;
+        AlgorithmIdentifier
+                    m_ContentEncryptionAlgo;
+        std::vector<Attribute>
+                    m_UnprotectedAttrs;
+        uint64_t    m_ContentSize;
+        bool        m_ContentPresent;
+
+    public:
+        CmsStreamParser (
+            const Callbacks& callbacks,
+            const size_t maxElementSize = DEFAULT_MAX_ELEMENT_SIZE
+        );
+        ~CmsStreamParser (void);
+
+        int update (
+            const uint8_t* data,
+            const size_t size
+        );
+        int final (void);
+
+    public:
+        //  contentType of ContentInfo: OID_PKCS7_SIGNED_DATA or OID_PKCS7_ENVELOPED_DATA
+        const std::string& getContentType (void) const {
+            return m_ContentType;
+        }
+        uint32_t getVersion (void) const {
+            return m_Version;
+        }
+        const std::vector<std::string>& getDigestAlgorithms (void) const {
+            return m_DigestAlgorithms;
+        }
+        //  eContentType of SignedData or contentType of EncryptedContentInfo
+        const std::string& getEncapContentType (void) const {
+            return m_EncapContentType;
+        }
+        const AlgorithmIdentifier& getContentEncryptionAlgo (void) const {
+            return m_ContentEncryptionAlgo;
+        }
+        const std::vector<Attribute>& getUnprotectedAttrs (void) const {
+            return m_UnprotectedAttrs;
+        }
+        uint64_t getContentSize (void) const {
+            return m_ContentSize;
+        }
+        //  eContent of SignedData or encryptedContent of EnvelopedData is present (maybe empty)
+        bool isContentPresent (void) const {
+            return m_ContentPresent;
+        }
+        bool isCompleted (void) const {
+            return m_Completed;
+        }
+
+    private:
+        int closeFrames (void);
+        int finishCapture (void);
+        int onElement (
+            const uint8_t tag,
+            const bool constructed,
+            const bool indefinite,
+            const uint64_t length
+        );
+        int onPrimitiveData (
+            const uint8_t* data,
+            const size_t size
+        );
+        int parseHeader (
+            bool& completed
+        );
+
+    };  //  end class CmsStreamParser
+
+}   //  end namespace Pkcs7
+
+}   //  end namespace UapkiNS
+
+#endif
@@ -29,6 +29,7 @@
 
 #include "dstu-ns.h"
 #include "macros-internal.h"
+#include "oid-registry.h"
 #include "oid-utils.h"
 #include "uapki-errors.h"
 #include "uapki-ns-util.h"
@@ -89,7 +90,12 @@ cleanup:
 
 bool DstuNS::isDstu4145family (const char* algo)
 {
-    return (algo && (oid_is_parent(OID_DSTU4145_WITH_DSTU7564, algo) || oid_is_parent(OID_DSTU4145_WITH_GOST3411, algo)));
+    uint8_t der[OID_MAX_DER_LEN];
+    const size_t len = oid_text_to_der(algo, der, sizeof(der));
+    return (
+        oid_id_is_parent_der(OID_ID_DSTU4145_WITH_DSTU7564, der, len) ||
+        oid_id_is_parent_der(OID_ID_DSTU4145_WITH_GOST3411, der, len)
+    );
 }
 
 bool DstuNS::isDstu4145family (const string& algo)
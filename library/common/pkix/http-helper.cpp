@@ -144,7 +144,9 @@ static int winhttp_perform_request (
         const vector<wstring>& headers,
         const uint8_t* body,
         size_t body_len,
-        ByteArray** baResponse)
+        ByteArray** baResponse,
+        HttpHelper::WriteDataFunc writeData = nullptr,
+        void* userData = nullptr)
 {
     if (http_helper.offlineMode) {
         if (baResponse) *baResponse = nullptr;
@@ -311,6 +313,29 @@ static int winhttp_perform_request (
             }
         }
     }
+    else if (writeData && (ret == RET_OK)) {
+        vector<uint8_t> chunk;
+        while (true) {
+            DWORD available = 0;
+            if (!WinHttpQueryDataAvailable(hRequest, &available)) {
+                ret = RET_UAPKI_CONNECTION_ERROR;
+                break;
+            }
+            if (available == 0) {
+                break;
+            }
+            chunk.resize(available);
+            DWORD read = 0;
+            if (!WinHttpReadData(hRequest, chunk.data(), available, &read)) {
+                ret = RET_UAPKI_CONNECTION_ERROR;
+                break;
+            }
+            if ((read > 0) && (writeData(chunk.data(), (size_t)read, userData) != (size_t)read)) {
+                ret = RET_UAPKI_CONNECTION_ERROR;
+                break;
+            }
+        }
+    }
 
     WinHttpCloseHandle(hRequest);
     WinHttpCloseHandle(hConnect);
@@ -359,6 +384,32 @@ static size_t cb_curlwrite (
     return realsize;
 }   //  cb_curlwrite
 
+struct CurlWriteStream {
+    CURL*   curl;
+    HttpHelper::WriteDataFunc
+            writeData;
+    void*   userData;
+};  //  end struct CurlWriteStream
+
+static size_t cb_curlwrite_stream (
+        void* dataIn,
+        size_t size,
+        size_t nmemb,
+        void* userp
+)
+{
+    const size_t realsize = size * nmemb;
+    CurlWriteStream* stream = (CurlWriteStream*)userp;
+
+    //  Body of the error response is not passed to the receiver
+    long http_code = 0;
+    if ((curl_easy_getinfo(stream->curl, CURLINFO_RESPONSE_CODE, &http_code) != CURLE_OK) || (http_code != 200)) {
+        return realsize;
+    }
+
+    return stream->writeData((const uint8_t*)dataIn, realsize, stream->userData);
+}   //  cb_curlwrite_stream
+
 static bool curl_set_url_and_proxy (
         CURL* curl,
         const string& uri
@@ -521,6 +572,58 @@ int HttpHelper::get (
 #endif
 }
 
+int HttpHelper::get (
+        const string& uri,
+        WriteDataFunc writeData,
+        void* userData
+)
+{
+#if defined(_WIN32)
+    vector<wstring> headers;
+    return winhttp_perform_request(uri, L"GET", headers, nullptr, 0, nullptr, writeData, userData);
+#else
+    DEBUG_OUTCON(printf("HttpHelper::get(uri='%s', writeData)\n", uri.c_str()));
+    CURL* curl;
+    CURLcode curl_code;
+    CurlWriteStream stream;
+    int ret;
+
+    if (http_helper.offlineMode) {
+        return RET_UAPKI_OFFLINE_MODE;
+    }
+
+    if ((curl = curl_easy_init()) == NULL) {
+        return RET_UAPKI_CONNECTION_ERROR;
+    }
+
+    if (!curl_set_url_and_proxy(curl, uri)) {
+        curl_easy_cleanup(curl);
+        return RET_UAPKI_CONNECTION_ERROR;
+    }
+
+    //  The response is not accumulated: each received chunk is passed to writeData()
+    stream.curl = curl;
+    stream.writeData = writeData;
+    stream.userData = userData;
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, cb_curlwrite_stream);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &stream);
+
+    curl_code = curl_easy_perform(curl);
+    if (curl_code == CURLE_OK) {
+        long http_code = 0;
+        curl_code = curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+        ret = (http_code == 200) ? RET_OK : RET_UAPKI_HTTP_STATUS_NOT_OK;
+    }
+    else {
+        ret = RET_UAPKI_CONNECTION_ERROR;
+    }
+
+    curl_easy_cleanup(curl);
+
+    return ret;
+#endif
+}
+
 int HttpHelper::post (
         const string& uri,
         const char* contentType,
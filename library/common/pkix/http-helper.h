@@ -41,6 +41,9 @@ public:
     static const char* CONTENT_TYPE_OCSP_REQUEST;
     static const char* CONTENT_TYPE_TSP_REQUEST;
 
+    //  Receives the response body by chunks, a return value other than len aborts the transfer
+    typedef size_t (*WriteDataFunc)(const uint8_t* buf, const size_t len, void* userData);
+
     static int init (
         const bool offlineMode,
         const char* proxyUrl,
@@ -55,6 +58,11 @@ public:
         const std::string& uri,
         ByteArray** baResponse
     );
+    static int get (
+        const std::string& uri,
+        WriteDataFunc writeData,
+        void* userData
+    );
     static int post (
         const std::string& uri,
         const char* contentType,
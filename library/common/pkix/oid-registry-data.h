@@ -0,0 +1,765 @@
+/*
+ * Generated by oid-registry-gen.py from oids.h, do not edit.
+ */
+
+#ifndef UAPKI_OID_REGISTRY_DATA_H
+#define UAPKI_OID_REGISTRY_DATA_H
+
+
+typedef enum {
+    OID_ID_UNDEFINED                          = 0,
+    OID_ID_TDES_CBC                           = 1,
+    OID_ID_AES                                = 2,
+    OID_ID_AES128_ECB                         = 3,
+    OID_ID_AES128_CBC_PAD                     = 4,
+    OID_ID_AES128_OFB                         = 5,
+    OID_ID_AES128_CFB                         = 6,
+    OID_ID_AES128_WRAP                        = 7,
+    OID_ID_AES128_GCM                         = 8,
+    OID_ID_AES128_CCM                         = 9,
+    OID_ID_AES128_WRAP_PAD                    = 10,
+    OID_ID_AES192_ECB                         = 11,
+    OID_ID_AES192_CBC_PAD                     = 12,
+    OID_ID_AES192_OFB                         = 13,
+    OID_ID_AES192_CFB                         = 14,
+    OID_ID_AES192_WRAP                        = 15,
+    OID_ID_AES192_GCM                         = 16,
+    OID_ID_AES192_CCM                         = 17,
+    OID_ID_AES192_WRAP_PAD                    = 18,
+    OID_ID_AES256_ECB                         = 19,
+    OID_ID_AES256_CBC_PAD                     = 20,
+    OID_ID_AES256_OFB                         = 21,
+    OID_ID_AES256_CFB                         = 22,
+    OID_ID_AES256_WRAP                        = 23,
+    OID_ID_AES256_GCM                         = 24,
+    OID_ID_AES256_CCM                         = 25,
+    OID_ID_AES256_WRAP_PAD                    = 26,
+    OID_ID_GOST28147                          = 27,
+    OID_ID_GOST28147_ECB                      = 28,
+    OID_ID_GOST28147_CTR                      = 29,
+    OID_ID_GOST28147_CFB                      = 30,
+    OID_ID_GOST28147_CMAC                     = 31,
+    OID_ID_GOST28147_WRAP                     = 32,
+    OID_ID_DSTU7624                           = 33,
+    OID_ID_DSTU7624_ECB                       = 34,
+    OID_ID_DSTU7624_128_ECB                   = 35,
+    OID_ID_DSTU7624_256_ECB                   = 36,
+    OID_ID_DSTU7624_512_ECB                   = 37,
+    OID_ID_DSTU7624_CTR                       = 38,
+    OID_ID_DSTU7624_128_CTR                   = 39,
+    OID_ID_DSTU7624_256_CTR                   = 40,
+    OID_ID_DSTU7624_512_CTR                   = 41,
+    OID_ID_DSTU7624_CFB                       = 42,
+    OID_ID_DSTU7624_128_CFB                   = 43,
+    OID_ID_DSTU7624_256_CFB                   = 44,
+    OID_ID_DSTU7624_512_CFB                   = 45,
+    OID_ID_DSTU7624_CMAC                      = 46,
+    OID_ID_DSTU7624_128_CMAC                  = 47,
+    OID_ID_DSTU7624_256_CMAC                  = 48,
+    OID_ID_DSTU7624_512_CMAC                  = 49,
+    OID_ID_DSTU7624_CBC                       = 50,
+    OID_ID_DSTU7624_128_CBC                   = 51,
+    OID_ID_DSTU7624_256_CBC                   = 52,
+    OID_ID_DSTU7624_512_CBC                   = 53,
+    OID_ID_DSTU7624_OFB                       = 54,
+    OID_ID_DSTU7624_128_OFB                   = 55,
+    OID_ID_DSTU7624_256_OFB                   = 56,
+    OID_ID_DSTU7624_512_OFB                   = 57,
+    OID_ID_DSTU7624_GMAC                      = 58,
+    OID_ID_DSTU7624_128_GMAC                  = 59,
+    OID_ID_DSTU7624_256_GMAC                  = 60,
+    OID_ID_DSTU7624_512_GMAC                  = 61,
+    OID_ID_DSTU7624_CCM                       = 62,
+    OID_ID_DSTU7624_128_CCM                   = 63,
+    OID_ID_DSTU7624_256_CCM                   = 64,
+    OID_ID_DSTU7624_512_CCM                   = 65,
+    OID_ID_DSTU7624_XTS                       = 66,
+    OID_ID_DSTU7624_128_XTS                   = 67,
+    OID_ID_DSTU7624_256_XTS                   = 68,
+    OID_ID_DSTU7624_512_XTS                   = 69,
+    OID_ID_DSTU7624_KW                        = 70,
+    OID_ID_DSTU7624_128_KW                    = 71,
+    OID_ID_DSTU7624_256_KW                    = 72,
+    OID_ID_DSTU7624_512_KW                    = 73,
+    OID_ID_DSTU7624_WRAP                      = 74,
+    OID_ID_DSTU7624_GCM                       = 75,
+    OID_ID_DSTU7624_128_GCM                   = 76,
+    OID_ID_DSTU7624_256_GCM                   = 77,
+    OID_ID_DSTU7624_512_GCM                   = 78,
+    OID_ID_GOST34311                          = 79,
+    OID_ID_HMAC_GOST34311                     = 80,
+    OID_ID_DSTU7564                           = 81,
+    OID_ID_DSTU7564_256                       = 82,
+    OID_ID_DSTU7564_384                       = 83,
+    OID_ID_DSTU7564_512                       = 84,
+    OID_ID_DSTU7564_256_MAC                   = 85,
+    OID_ID_DSTU7564_384_MAC                   = 86,
+    OID_ID_DSTU7564_512_MAC                   = 87,
+    OID_ID_MD5                                = 88,
+    OID_ID_HMAC_MD5                           = 89,
+    OID_ID_SHA1                               = 90,
+    OID_ID_HMAC_SHA1                          = 91,
+    OID_ID_SHA256                             = 92,
+    OID_ID_SHA384                             = 93,
+    OID_ID_SHA512                             = 94,
+    OID_ID_SHA224                             = 95,
+    OID_ID_SHA512_224                         = 96,
+    OID_ID_SHA512_256                         = 97,
+    OID_ID_HMAC_SHA224                        = 98,
+    OID_ID_HMAC_SHA256                        = 99,
+    OID_ID_HMAC_SHA384                        = 100,
+    OID_ID_HMAC_SHA512                        = 101,
+    OID_ID_HMAC_SHA512_224                    = 102,
+    OID_ID_HMAC_SHA512_256                    = 103,
+    OID_ID_SHA3_224                           = 104,
+    OID_ID_SHA3_256                           = 105,
+    OID_ID_SHA3_384                           = 106,
+    OID_ID_SHA3_512                           = 107,
+    OID_ID_SHA3_SHAKE128                      = 108,
+    OID_ID_SHA3_SHAKE256                      = 109,
+    OID_ID_HMAC_SHA3_224                      = 110,
+    OID_ID_HMAC_SHA3_256                      = 111,
+    OID_ID_HMAC_SHA3_384                      = 112,
+    OID_ID_HMAC_SHA3_512                      = 113,
+    OID_ID_RIPEMD160                          = 114,
+    OID_ID_RIPEMD128                          = 115,
+    OID_ID_HMAC_RIPEMD160                     = 116,
+    OID_ID_WHIRLPOOL                          = 117,
+    OID_ID_STREEBOG_256                       = 118,
+    OID_ID_STREEBOG_512                       = 119,
+    OID_ID_SM3                                = 120,
+    OID_ID_SM3_ISO                            = 121,
+    OID_ID_DSTU4145_WITH_GOST3411             = 122,
+    OID_ID_DSTU4145_WITH_DSTU7564             = 123,
+    OID_ID_DSTU4145_WITH_DSTU7564_256         = 124,
+    OID_ID_DSTU4145_WITH_DSTU7564_256_PB      = 125,
+    OID_ID_DSTU4145_WITH_DSTU7564_384         = 126,
+    OID_ID_DSTU4145_WITH_DSTU7564_384_PB      = 127,
+    OID_ID_DSTU4145_WITH_DSTU7564_512         = 128,
+    OID_ID_DSTU4145_WITH_DSTU7564_512_PB      = 129,
+    OID_ID_EC_KEY                             = 130,
+    OID_ID_ECDSA_WITH_SHA1                    = 131,
+    OID_ID_ECDSA_WITH_SHA2                    = 132,
+    OID_ID_ECDSA_WITH_SHA224                  = 133,
+    OID_ID_ECDSA_WITH_SHA256                  = 134,
+    OID_ID_ECDSA_WITH_SHA384                  = 135,
+    OID_ID_ECDSA_WITH_SHA512                  = 136,
+    OID_ID_ECDSA_WITH_SHA3_224                = 137,
+    OID_ID_ECDSA_WITH_SHA3_256                = 138,
+    OID_ID_ECDSA_WITH_SHA3_384                = 139,
+    OID_ID_ECDSA_WITH_SHA3_512                = 140,
+    OID_ID_ECKCDSA                            = 141,
+    OID_ID_ECKCDSA_SIGNATURE                  = 142,
+    OID_ID_ECKCDSA_WITH_SHA1                  = 143,
+    OID_ID_ECKCDSA_WITH_SHA224                = 144,
+    OID_ID_ECKCDSA_WITH_SHA256                = 145,
+    OID_ID_ECGDSA_STD                         = 146,
+    OID_ID_ECGDSA_KEY                         = 147,
+    OID_ID_ECGDSA_SIGNATURE                   = 148,
+    OID_ID_ECGDSA_SIGNATURE_WITH_RIPEMD160    = 149,
+    OID_ID_ECGDSA_SIGNATURE_WITH_SHA1         = 150,
+    OID_ID_ECGDSA_SIGNATURE_WITH_SHA224       = 151,
+    OID_ID_ECGDSA_SIGNATURE_WITH_SHA256       = 152,
+    OID_ID_ECGDSA_SIGNATURE_WITH_SHA384       = 153,
+    OID_ID_ECGDSA_SIGNATURE_WITH_SHA512       = 154,
+    OID_ID_GOST_KEY_3410_2012_256             = 155,
+    OID_ID_GOST_KEY_3410_2012_512             = 156,
+    OID_ID_GOST_3410_2012_256                 = 157,
+    OID_ID_GOST_3410_2012_512                 = 158,
+    OID_ID_SM2                                = 159,
+    OID_ID_SM2_WITH_SM3                       = 160,
+    OID_ID_PKCS1                              = 161,
+    OID_ID_RSA                                = 162,
+    OID_ID_RSA_WITH_MD5                       = 163,
+    OID_ID_RSA_WITH_SHA1                      = 164,
+    OID_ID_RSA_WITH_SHA224                    = 165,
+    OID_ID_RSA_WITH_SHA256                    = 166,
+    OID_ID_RSA_WITH_SHA384                    = 167,
+    OID_ID_RSA_WITH_SHA512                    = 168,
+    OID_ID_RSA_WITH_SHA3_224                  = 169,
+    OID_ID_RSA_WITH_SHA3_256                  = 170,
+    OID_ID_RSA_WITH_SHA3_384                  = 171,
+    OID_ID_RSA_WITH_SHA3_512                  = 172,
+    OID_ID_RSA_WITH_SM3                       = 173,
+    OID_ID_RSA_PSS                            = 174,
+    OID_ID_DSTU4145_PARAM_PB_LE               = 175,
+    OID_ID_DSTU4145_PARAM_SPECIAL_CURVES_PB   = 176,
+    OID_ID_DSTU4145_PARAM_PB_BE               = 177,
+    OID_ID_DSTU4145_PARAM_NAMED_CURVES_PB     = 178,
+    OID_ID_DSTU4145_PARAM_M163_PB             = 179,
+    OID_ID_DSTU4145_PARAM_M167_PB             = 180,
+    OID_ID_DSTU4145_PARAM_M173_PB             = 181,
+    OID_ID_DSTU4145_PARAM_M179_PB             = 182,
+    OID_ID_DSTU4145_PARAM_M191_PB             = 183,
+    OID_ID_DSTU4145_PARAM_M233_PB             = 184,
+    OID_ID_DSTU4145_PARAM_M257_PB             = 185,
+    OID_ID_DSTU4145_PARAM_M307_PB             = 186,
+    OID_ID_DSTU4145_PARAM_M367_PB             = 187,
+    OID_ID_DSTU4145_PARAM_M431_PB             = 188,
+    OID_ID_DSTU4145_PARAM_ONB_LE              = 189,
+    OID_ID_DSTU4145_PARAM_SPECIAL_CURVES_ONB  = 190,
+    OID_ID_DSTU4145_PARAM_ONB_BE              = 191,
+    OID_ID_DSTU4145_PARAM_CURVES_ONB          = 192,
+    OID_ID_DSTU4145_PARAM_M173_ONB            = 193,
+    OID_ID_DSTU4145_PARAM_M179_ONB            = 194,
+    OID_ID_DSTU4145_PARAM_M191_ONB            = 195,
+    OID_ID_DSTU4145_PARAM_M233_ONB            = 196,
+    OID_ID_DSTU4145_PARAM_M431_ONB            = 197,
+    OID_ID_NIST_P192                          = 198,
+    OID_ID_NIST_P224                          = 199,
+    OID_ID_NIST_P256                          = 200,
+    OID_ID_NIST_P384                          = 201,
+    OID_ID_NIST_P521                          = 202,
+    OID_ID_NIST_K233                          = 203,
+    OID_ID_NIST_B233                          = 204,
+    OID_ID_NIST_K283                          = 205,
+    OID_ID_NIST_B283                          = 206,
+    OID_ID_NIST_K409                          = 207,
+    OID_ID_NIST_B409                          = 208,
+    OID_ID_NIST_K571                          = 209,
+    OID_ID_NIST_B571                          = 210,
+    OID_ID_SECP256K1                          = 211,
+    OID_ID_SECT239K1                          = 212,
+    OID_ID_BRAINPOOL                          = 213,
+    OID_ID_BRAINPOOL_EC                       = 214,
+    OID_ID_BRAINPOOL_P224R1                   = 215,
+    OID_ID_BRAINPOOL_P224T1                   = 216,
+    OID_ID_BRAINPOOL_P256R1                   = 217,
+    OID_ID_BRAINPOOL_P256T1                   = 218,
+    OID_ID_BRAINPOOL_P320R1                   = 219,
+    OID_ID_BRAINPOOL_P320T1                   = 220,
+    OID_ID_BRAINPOOL_P384R1                   = 221,
+    OID_ID_BRAINPOOL_P384T1                   = 222,
+    OID_ID_BRAINPOOL_P512R1                   = 223,
+    OID_ID_BRAINPOOL_P512T1                   = 224,
+    OID_ID_ECRDSA_256A                        = 225,
+    OID_ID_ECRDSA_256B                        = 226,
+    OID_ID_ECRDSA_512A                        = 227,
+    OID_ID_ECRDSA_512B                        = 228,
+    OID_ID_SM2DSA_P256                        = 229,
+    OID_ID_X520_CommonName                    = 230,
+    OID_ID_X520_Surname                       = 231,
+    OID_ID_X520_SerialNumber                  = 232,
+    OID_ID_X520_Country                       = 233,
+    OID_ID_X520_Locality                      = 234,
+    OID_ID_X520_State                         = 235,
+    OID_ID_X520_StreetAddress                 = 236,
+    OID_ID_X520_Organization                  = 237,
+    OID_ID_X520_OrganizationalUnit            = 238,
+    OID_ID_X520_Title                         = 239,
+    OID_ID_X520_GivenName                     = 240,
+    OID_ID_X520_Initials                      = 241,
+    OID_ID_X520_GenerationalQualifier         = 242,
+    OID_ID_X520_DNQualifier                   = 243,
+    OID_ID_X520_Pseudonym                     = 244,
+    OID_ID_X520_OrganizationIdentifier        = 245,
+    OID_ID_X509v3_SubjectDirectoryAttributes  = 246,
+    OID_ID_X509v3_SubjectKeyIdentifier        = 247,
+    OID_ID_X509v3_KeyUsage                    = 248,
+    OID_ID_X509v3_PrivateKeyUsagePeriod       = 249,
+    OID_ID_X509v3_SubjectAlternativeName      = 250,
+    OID_ID_X509v3_IssuerAlternativeName       = 251,
+    OID_ID_X509v3_BasicConstraints            = 252,
+    OID_ID_X509v3_CRLNumber                   = 253,
+    OID_ID_X509v3_CRLReason                   = 254,
+    OID_ID_X509v3_HoldInstructionCode         = 255,
+    OID_ID_X509v3_InvalidityDate              = 256,
+    OID_ID_X509v3_DeltaCRLIndicator           = 257,
+    OID_ID_X509v3_CRLIssuingDistributionPoint = 258,
+    OID_ID_X509v3_NameConstraints             = 259,
+    OID_ID_X509v3_CRLDistributionPoints       = 260,
+    OID_ID_X509v3_CertificatePolicies         = 261,
+    OID_ID_X509v3_AuthorityKeyIdentifier      = 262,
+    OID_ID_X509v3_PolicyConstraints           = 263,
+    OID_ID_X509v3_ExtendedKeyUsage            = 264,
+    OID_ID_X509v3_FreshestCRL                 = 265,
+    OID_ID_PKIX_AuthorityInfoAccess           = 266,
+    OID_ID_PKIX_QcStatements                  = 267,
+    OID_ID_PKIX_SubjectInfoAccess             = 268,
+    OID_ID_PKIX_PolicyQualifierIds            = 269,
+    OID_ID_PKIX_PqiCps                        = 270,
+    OID_ID_PKIX_PqiUnotice                    = 271,
+    OID_ID_PKIX_PqiTextNotice                 = 272,
+    OID_ID_PKIX_ExtendedKeyPurposes           = 273,
+    OID_ID_PKIX_KpTspSigning                  = 274,
+    OID_ID_PKIX_KpOcspSigning                 = 275,
+    OID_ID_PKIX_OCSP                          = 276,
+    OID_ID_PKIX_OcspBasic                     = 277,
+    OID_ID_PKIX_OcspNonce                     = 278,
+    OID_ID_PKIX_OcspCrl                       = 279,
+    OID_ID_PKIX_OcspResponse                  = 280,
+    OID_ID_PKIX_CaIssuers                     = 281,
+    OID_ID_PKIX_TimeStamping                  = 282,
+    OID_ID_PKCS5_PBKDF2                       = 283,
+    OID_ID_PKCS5_PBES2                        = 284,
+    OID_ID_PBE_WITH_SHA1_TDES_CBC             = 285,
+    OID_ID_MEDOC_DIGEST                       = 286,
+    OID_ID_IIT_KEYSTORE                       = 287,
+    OID_ID_IIT_KEYSTORE_ATTR_RSA_PRIVKEY      = 288,
+    OID_ID_IIT_KEYSTORE_ATTR_SIGN_KEYID       = 289,
+    OID_ID_IIT_KEYSTORE_ATTR_KEP_SPKI         = 290,
+    OID_ID_IIT_KEYSTORE_ATTR_KEP_PRIVKEY      = 291,
+    OID_ID_IIT_KEYSTORE_ATTR_KEP_KEYID        = 292,
+    OID_ID_IIT_KEYSTORE_ATTR_HMAC_GOST34311   = 293,
+    OID_ID_IIT_KEYSTORE_ATTR_RSA_KEYID        = 294,
+    OID_ID_IIT_KEYPURPOSE_CMP_SIGNING         = 295,
+    OID_ID_PKCS7_DATA                         = 296,
+    OID_ID_PKCS7_SIGNED_DATA                  = 297,
+    OID_ID_PKCS7_ENVELOPED_DATA               = 298,
+    OID_ID_PKCS7_DIGESTED_DATA                = 299,
+    OID_ID_PKCS7_ENCRYPTED_DATA               = 300,
+    OID_ID_PKCS9_CONTENT_TYPE                 = 301,
+    OID_ID_PKCS9_MESSAGE_DIGEST               = 302,
+    OID_ID_PKCS9_SIGNING_TIME                 = 303,
+    OID_ID_PKCS9_CHALLENGE_PASSWORD           = 304,
+    OID_ID_PKCS9_EXTENSION_REQUEST            = 305,
+    OID_ID_PKCS9_FRIENDLY_NAME                = 306,
+    OID_ID_PKCS9_LOCAL_KEYID                  = 307,
+    OID_ID_PKCS9_X509_CERTIFICATE             = 308,
+    OID_ID_PKCS9_SDSI_CERTIFICATE             = 309,
+    OID_ID_PKCS9_X509_CRL                     = 310,
+    OID_ID_PKCS9_TST_INFO                     = 311,
+    OID_ID_PKCS9_TIMESTAMP_TOKEN              = 312,
+    OID_ID_PKCS9_SIG_POLICY_ID                = 313,
+    OID_ID_PKCS9_COMMITMENT_TYPE              = 314,
+    OID_ID_PKCS9_CONTENT_TIMESTAMP            = 315,
+    OID_ID_PKCS9_CERTIFICATE_REFS             = 316,
+    OID_ID_PKCS9_REVOCATION_REFS              = 317,
+    OID_ID_PKCS9_CERT_VALUES                  = 318,
+    OID_ID_PKCS9_REVOCATION_VALUES            = 319,
+    OID_ID_PKCS9_CADES_C_TIMESTAMP            = 320,
+    OID_ID_PKCS9_CERT_CRL_TIMESTAMP           = 321,
+    OID_ID_PKCS9_SIGNING_CERTIFICATE_V2       = 322,
+    OID_ID_PKCS12_BAGTYPES                    = 323,
+    OID_ID_PKCS12_KEY_BAG                     = 324,
+    OID_ID_PKCS12_P8_SHROUDED_KEY_BAG         = 325,
+    OID_ID_PKCS12_CERT_BAG                    = 326,
+    OID_ID_PKCS12_CRL_BAG                     = 327,
+    OID_ID_PKCS12_SECRET_BAG                  = 328,
+    OID_ID_PKCS12_SAFE_CONTENTS_BAG           = 329,
+    OID_ID_COFACTOR_DH_DSTU7564_KDF           = 330,
+    OID_ID_STD_DH_DSTU7564_KDF                = 331,
+    OID_ID_COFACTOR_DH_GOST34311_KDF          = 332,
+    OID_ID_STD_DH_GOST34311_KDF               = 333,
+    OID_ID_DHSINGLEPASS_STD_DH_SHA1_KDF       = 334,
+    OID_ID_DHSINGLEPASS_COFACTOR_DH_SHA1_KDF  = 335,
+    OID_ID_DHSINGLEPASS_STD_DH_SHA256_KDF     = 336,
+    OID_ID_JKS_KEY_PROTECTOR                  = 337,
+    OID_ID_PDS_UKRAINE_DRFO                   = 338,
+    OID_ID_PDS_UKRAINE_EDRPOU                 = 339,
+    OID_ID_PDS_UKRAINE_NBU                    = 340,
+    OID_ID_PDS_UKRAINE_SPMF                   = 341,
+    OID_ID_PDS_UKRAINE_ORG                    = 342,
+    OID_ID_PDS_UKRAINE_UNIT                   = 343,
+    OID_ID_PDS_UKRAINE_USER                   = 344,
+    OID_ID_PDS_UKRAINE_EDDR                   = 345,
+    OID_ID_ETSI_ARCHIVE_TIMESTAMP_V3          = 346,
+    OID_ID_DES_EDE3_CBC                       = OID_ID_TDES_CBC,
+    OID_ID_COUNT                              = 347
+} OidId;
+
+
+#ifdef OID_REGISTRY_DATA_TABLES
+
+#define OID_REGISTRY_BUCKETS 128
+#define OID_REGISTRY_SLOTS 512
+
+static const OidRegistryEntry OID_REGISTRY_ENTRIES[OID_ID_COUNT] = {
+    { 0, NULL, NULL },
+    { 8, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x03\x07", "1.2.840.113549.3.7" },   //  OID_ID_TDES_CBC
+    { 8, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01", "2.16.840.1.101.3.4.1" },   //  OID_ID_AES
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x01", "2.16.840.1.101.3.4.1.1" },   //  OID_ID_AES128_ECB
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x02", "2.16.840.1.101.3.4.1.2" },   //  OID_ID_AES128_CBC_PAD
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x03", "2.16.840.1.101.3.4.1.3" },   //  OID_ID_AES128_OFB
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x04", "2.16.840.1.101.3.4.1.4" },   //  OID_ID_AES128_CFB
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x05", "2.16.840.1.101.3.4.1.5" },   //  OID_ID_AES128_WRAP
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x06", "2.16.840.1.101.3.4.1.6" },   //  OID_ID_AES128_GCM
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x07", "2.16.840.1.101.3.4.1.7" },   //  OID_ID_AES128_CCM
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x08", "2.16.840.1.101.3.4.1.8" },   //  OID_ID_AES128_WRAP_PAD
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x15", "2.16.840.1.101.3.4.1.21" },   //  OID_ID_AES192_ECB
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x16", "2.16.840.1.101.3.4.1.22" },   //  OID_ID_AES192_CBC_PAD
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x17", "2.16.840.1.101.3.4.1.23" },   //  OID_ID_AES192_OFB
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x18", "2.16.840.1.101.3.4.1.24" },   //  OID_ID_AES192_CFB
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x19", "2.16.840.1.101.3.4.1.25" },   //  OID_ID_AES192_WRAP
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x1A", "2.16.840.1.101.3.4.1.26" },   //  OID_ID_AES192_GCM
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x1B", "2.16.840.1.101.3.4.1.27" },   //  OID_ID_AES192_CCM
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x1C", "2.16.840.1.101.3.4.1.28" },   //  OID_ID_AES192_WRAP_PAD
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x29", "2.16.840.1.101.3.4.1.41" },   //  OID_ID_AES256_ECB
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x2A", "2.16.840.1.101.3.4.1.42" },   //  OID_ID_AES256_CBC_PAD
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x2B", "2.16.840.1.101.3.4.1.43" },   //  OID_ID_AES256_OFB
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x2C", "2.16.840.1.101.3.4.1.44" },   //  OID_ID_AES256_CFB
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x2D", "2.16.840.1.101.3.4.1.45" },   //  OID_ID_AES256_WRAP
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x2E", "2.16.840.1.101.3.4.1.46" },   //  OID_ID_AES256_GCM
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x2F", "2.16.840.1.101.3.4.1.47" },   //  OID_ID_AES256_CCM
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x01\x30", "2.16.840.1.101.3.4.1.48" },   //  OID_ID_AES256_WRAP_PAD
+    { 10, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x01", "1.2.804.2.1.1.1.1.1.1" },   //  OID_ID_GOST28147
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x01\x01", "1.2.804.2.1.1.1.1.1.1.1" },   //  OID_ID_GOST28147_ECB
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x01\x02", "1.2.804.2.1.1.1.1.1.1.2" },   //  OID_ID_GOST28147_CTR
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x01\x03", "1.2.804.2.1.1.1.1.1.1.3" },   //  OID_ID_GOST28147_CFB
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x01\x04", "1.2.804.2.1.1.1.1.1.1.4" },   //  OID_ID_GOST28147_CMAC
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x01\x05", "1.2.804.2.1.1.1.1.1.1.5" },   //  OID_ID_GOST28147_WRAP
+    { 10, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03", "1.2.804.2.1.1.1.1.1.3" },   //  OID_ID_DSTU7624
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x01", "1.2.804.2.1.1.1.1.1.3.1" },   //  OID_ID_DSTU7624_ECB
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x01\x01", "1.2.804.2.1.1.1.1.1.3.1.1" },   //  OID_ID_DSTU7624_128_ECB
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x01\x02", "1.2.804.2.1.1.1.1.1.3.1.2" },   //  OID_ID_DSTU7624_256_ECB
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x01\x03", "1.2.804.2.1.1.1.1.1.3.1.3" },   //  OID_ID_DSTU7624_512_ECB
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x02", "1.2.804.2.1.1.1.1.1.3.2" },   //  OID_ID_DSTU7624_CTR
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x02\x01", "1.2.804.2.1.1.1.1.1.3.2.1" },   //  OID_ID_DSTU7624_128_CTR
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x02\x02", "1.2.804.2.1.1.1.1.1.3.2.2" },   //  OID_ID_DSTU7624_256_CTR
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x02\x03", "1.2.804.2.1.1.1.1.1.3.2.3" },   //  OID_ID_DSTU7624_512_CTR
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x03", "1.2.804.2.1.1.1.1.1.3.3" },   //  OID_ID_DSTU7624_CFB
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x03\x01", "1.2.804.2.1.1.1.1.1.3.3.1" },   //  OID_ID_DSTU7624_128_CFB
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x03\x02", "1.2.804.2.1.1.1.1.1.3.3.2" },   //  OID_ID_DSTU7624_256_CFB
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x03\x03", "1.2.804.2.1.1.1.1.1.3.3.3" },   //  OID_ID_DSTU7624_512_CFB
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x04", "1.2.804.2.1.1.1.1.1.3.4" },   //  OID_ID_DSTU7624_CMAC
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x04\x01", "1.2.804.2.1.1.1.1.1.3.4.1" },   //  OID_ID_DSTU7624_128_CMAC
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x04\x02", "1.2.804.2.1.1.1.1.1.3.4.2" },   //  OID_ID_DSTU7624_256_CMAC
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x04\x03", "1.2.804.2.1.1.1.1.1.3.4.3" },   //  OID_ID_DSTU7624_512_CMAC
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x05", "1.2.804.2.1.1.1.1.1.3.5" },   //  OID_ID_DSTU7624_CBC
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x05\x01", "1.2.804.2.1.1.1.1.1.3.5.1" },   //  OID_ID_DSTU7624_128_CBC
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x05\x02", "1.2.804.2.1.1.1.1.1.3.5.2" },   //  OID_ID_DSTU7624_256_CBC
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x05\x03", "1.2.804.2.1.1.1.1.1.3.5.3" },   //  OID_ID_DSTU7624_512_CBC
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x06", "1.2.804.2.1.1.1.1.1.3.6" },   //  OID_ID_DSTU7624_OFB
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x06\x01", "1.2.804.2.1.1.1.1.1.3.6.1" },   //  OID_ID_DSTU7624_128_OFB
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x06\x02", "1.2.804.2.1.1.1.1.1.3.6.2" },   //  OID_ID_DSTU7624_256_OFB
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x06\x03", "1.2.804.2.1.1.1.1.1.3.6.3" },   //  OID_ID_DSTU7624_512_OFB
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x07", "1.2.804.2.1.1.1.1.1.3.7" },   //  OID_ID_DSTU7624_GMAC
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x07\x01", "1.2.804.2.1.1.1.1.1.3.7.1" },   //  OID_ID_DSTU7624_128_GMAC
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x07\x02", "1.2.804.2.1.1.1.1.1.3.7.2" },   //  OID_ID_DSTU7624_256_GMAC
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x07\x03", "1.2.804.2.1.1.1.1.1.3.7.3" },   //  OID_ID_DSTU7624_512_GMAC
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x08", "1.2.804.2.1.1.1.1.1.3.8" },   //  OID_ID_DSTU7624_CCM
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x08\x01", "1.2.804.2.1.1.1.1.1.3.8.1" },   //  OID_ID_DSTU7624_128_CCM
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x08\x02", "1.2.804.2.1.1.1.1.1.3.8.2" },   //  OID_ID_DSTU7624_256_CCM
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x08\x03", "1.2.804.2.1.1.1.1.1.3.8.3" },   //  OID_ID_DSTU7624_512_CCM
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x09", "1.2.804.2.1.1.1.1.1.3.9" },   //  OID_ID_DSTU7624_XTS
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x09\x01", "1.2.804.2.1.1.1.1.1.3.9.1" },   //  OID_ID_DSTU7624_128_XTS
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x09\x02", "1.2.804.2.1.1.1.1.1.3.9.2" },   //  OID_ID_DSTU7624_256_XTS
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x09\x03", "1.2.804.2.1.1.1.1.1.3.9.3" },   //  OID_ID_DSTU7624_512_XTS
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x0A", "1.2.804.2.1.1.1.1.1.3.10" },   //  OID_ID_DSTU7624_KW
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x0A\x01", "1.2.804.2.1.1.1.1.1.3.10.1" },   //  OID_ID_DSTU7624_128_KW
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x0A\x02", "1.2.804.2.1.1.1.1.1.3.10.2" },   //  OID_ID_DSTU7624_256_KW
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x0A\x03", "1.2.804.2.1.1.1.1.1.3.10.3" },   //  OID_ID_DSTU7624_512_KW
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x0B", "1.2.804.2.1.1.1.1.1.3.11" },   //  OID_ID_DSTU7624_WRAP
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x0C", "1.2.804.2.1.1.1.1.1.3.12" },   //  OID_ID_DSTU7624_GCM
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x0C\x01", "1.2.804.2.1.1.1.1.1.3.12.1" },   //  OID_ID_DSTU7624_128_GCM
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x0C\x02", "1.2.804.2.1.1.1.1.1.3.12.2" },   //  OID_ID_DSTU7624_256_GCM
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x03\x0C\x03", "1.2.804.2.1.1.1.1.1.3.12.3" },   //  OID_ID_DSTU7624_512_GCM
+    { 10, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x02\x01", "1.2.804.2.1.1.1.1.2.1" },   //  OID_ID_GOST34311
+    { 10, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x01\x02", "1.2.804.2.1.1.1.1.1.2" },   //  OID_ID_HMAC_GOST34311
+    { 10, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x02\x02", "1.2.804.2.1.1.1.1.2.2" },   //  OID_ID_DSTU7564
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x02\x02\x01", "1.2.804.2.1.1.1.1.2.2.1" },   //  OID_ID_DSTU7564_256
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x02\x02\x02", "1.2.804.2.1.1.1.1.2.2.2" },   //  OID_ID_DSTU7564_384
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x02\x02\x03", "1.2.804.2.1.1.1.1.2.2.3" },   //  OID_ID_DSTU7564_512
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x02\x02\x04", "1.2.804.2.1.1.1.1.2.2.4" },   //  OID_ID_DSTU7564_256_MAC
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x02\x02\x05", "1.2.804.2.1.1.1.1.2.2.5" },   //  OID_ID_DSTU7564_384_MAC
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x02\x02\x06", "1.2.804.2.1.1.1.1.2.2.6" },   //  OID_ID_DSTU7564_512_MAC
+    { 8, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x02\x05", "1.2.840.113549.2.5" },   //  OID_ID_MD5
+    { 8, (const uint8_t*)"\x2B\x06\x01\x05\x05\x08\x01\x01", "1.3.6.1.5.5.8.1.1" },   //  OID_ID_HMAC_MD5
+    { 5, (const uint8_t*)"\x2B\x0E\x03\x02\x1A", "1.3.14.3.2.26" },   //  OID_ID_SHA1
+    { 8, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x02\x07", "1.2.840.113549.2.7" },   //  OID_ID_HMAC_SHA1
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x02\x01", "2.16.840.1.101.3.4.2.1" },   //  OID_ID_SHA256
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x02\x02", "2.16.840.1.101.3.4.2.2" },   //  OID_ID_SHA384
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x02\x03", "2.16.840.1.101.3.4.2.3" },   //  OID_ID_SHA512
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x02\x04", "2.16.840.1.101.3.4.2.4" },   //  OID_ID_SHA224
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x02\x05", "2.16.840.1.101.3.4.2.5" },   //  OID_ID_SHA512_224
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x02\x06", "2.16.840.1.101.3.4.2.6" },   //  OID_ID_SHA512_256
+    { 8, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x02\x08", "1.2.840.113549.2.8" },   //  OID_ID_HMAC_SHA224
+    { 8, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x02\x09", "1.2.840.113549.2.9" },   //  OID_ID_HMAC_SHA256
+    { 8, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x02\x0A", "1.2.840.113549.2.10" },   //  OID_ID_HMAC_SHA384
+    { 8, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x02\x0B", "1.2.840.113549.2.11" },   //  OID_ID_HMAC_SHA512
+    { 8, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x02\x0C", "1.2.840.113549.2.12" },   //  OID_ID_HMAC_SHA512_224
+    { 8, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x02\x0D", "1.2.840.113549.2.13" },   //  OID_ID_HMAC_SHA512_256
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x02\x07", "2.16.840.1.101.3.4.2.7" },   //  OID_ID_SHA3_224
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x02\x08", "2.16.840.1.101.3.4.2.8" },   //  OID_ID_SHA3_256
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x02\x09", "2.16.840.1.101.3.4.2.9" },   //  OID_ID_SHA3_384
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x02\x0A", "2.16.840.1.101.3.4.2.10" },   //  OID_ID_SHA3_512
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x02\x0B", "2.16.840.1.101.3.4.2.11" },   //  OID_ID_SHA3_SHAKE128
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x02\x0C", "2.16.840.1.101.3.4.2.12" },   //  OID_ID_SHA3_SHAKE256
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x02\x0D", "2.16.840.1.101.3.4.2.13" },   //  OID_ID_HMAC_SHA3_224
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x02\x0E", "2.16.840.1.101.3.4.2.14" },   //  OID_ID_HMAC_SHA3_256
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x02\x0F", "2.16.840.1.101.3.4.2.15" },   //  OID_ID_HMAC_SHA3_384
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x02\x10", "2.16.840.1.101.3.4.2.16" },   //  OID_ID_HMAC_SHA3_512
+    { 5, (const uint8_t*)"\x2B\x24\x03\x02\x01", "1.3.36.3.2.1" },   //  OID_ID_RIPEMD160
+    { 5, (const uint8_t*)"\x2B\x24\x03\x02\x02", "1.3.36.3.2.2" },   //  OID_ID_RIPEMD128
+    { 8, (const uint8_t*)"\x2B\x06\x01\x05\x05\x08\x01\x04", "1.3.6.1.5.5.8.1.4" },   //  OID_ID_HMAC_RIPEMD160
+    { 6, (const uint8_t*)"\x28\xCF\x06\x03\x00\x37", "1.0.10118.3.0.55" },   //  OID_ID_WHIRLPOOL
+    { 8, (const uint8_t*)"\x2A\x85\x03\x07\x01\x01\x02\x02", "1.2.643.7.1.1.2.2" },   //  OID_ID_STREEBOG_256
+    { 8, (const uint8_t*)"\x2A\x85\x03\x07\x01\x01\x02\x03", "1.2.643.7.1.1.2.3" },   //  OID_ID_STREEBOG_512
+    { 8, (const uint8_t*)"\x2A\x81\x1C\xCF\x55\x01\x83\x11", "1.2.156.10197.1.401" },   //  OID_ID_SM3
+    { 6, (const uint8_t*)"\x28\xCF\x06\x03\x00\x41", "1.0.10118.3.0.65" },   //  OID_ID_SM3_ISO
+    { 10, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01", "1.2.804.2.1.1.1.1.3.1" },   //  OID_ID_DSTU4145_WITH_GOST3411
+    { 10, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x06", "1.2.804.2.1.1.1.1.3.6" },   //  OID_ID_DSTU4145_WITH_DSTU7564
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x06\x01", "1.2.804.2.1.1.1.1.3.6.1" },   //  OID_ID_DSTU4145_WITH_DSTU7564_256
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x06\x01\x01", "1.2.804.2.1.1.1.1.3.6.1.1" },   //  OID_ID_DSTU4145_WITH_DSTU7564_256_PB
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x06\x02", "1.2.804.2.1.1.1.1.3.6.2" },   //  OID_ID_DSTU4145_WITH_DSTU7564_384
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x06\x02\x01", "1.2.804.2.1.1.1.1.3.6.2.1" },   //  OID_ID_DSTU4145_WITH_DSTU7564_384_PB
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x06\x03", "1.2.804.2.1.1.1.1.3.6.3" },   //  OID_ID_DSTU4145_WITH_DSTU7564_512
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x06\x03\x01", "1.2.804.2.1.1.1.1.3.6.3.1" },   //  OID_ID_DSTU4145_WITH_DSTU7564_512_PB
+    { 7, (const uint8_t*)"\x2A\x86\x48\xCE\x3D\x02\x01", "1.2.840.10045.2.1" },   //  OID_ID_EC_KEY
+    { 7, (const uint8_t*)"\x2A\x86\x48\xCE\x3D\x04\x01", "1.2.840.10045.4.1" },   //  OID_ID_ECDSA_WITH_SHA1
+    { 7, (const uint8_t*)"\x2A\x86\x48\xCE\x3D\x04\x03", "1.2.840.10045.4.3" },   //  OID_ID_ECDSA_WITH_SHA2
+    { 8, (const uint8_t*)"\x2A\x86\x48\xCE\x3D\x04\x03\x01", "1.2.840.10045.4.3.1" },   //  OID_ID_ECDSA_WITH_SHA224
+    { 8, (const uint8_t*)"\x2A\x86\x48\xCE\x3D\x04\x03\x02", "1.2.840.10045.4.3.2" },   //  OID_ID_ECDSA_WITH_SHA256
+    { 8, (const uint8_t*)"\x2A\x86\x48\xCE\x3D\x04\x03\x03", "1.2.840.10045.4.3.3" },   //  OID_ID_ECDSA_WITH_SHA384
+    { 8, (const uint8_t*)"\x2A\x86\x48\xCE\x3D\x04\x03\x04", "1.2.840.10045.4.3.4" },   //  OID_ID_ECDSA_WITH_SHA512
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x03\x09", "2.16.840.1.101.3.4.3.9" },   //  OID_ID_ECDSA_WITH_SHA3_224
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x03\x0A", "2.16.840.1.101.3.4.3.10" },   //  OID_ID_ECDSA_WITH_SHA3_256
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x03\x0B", "2.16.840.1.101.3.4.3.11" },   //  OID_ID_ECDSA_WITH_SHA3_384
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x03\x0C", "2.16.840.1.101.3.4.3.12" },   //  OID_ID_ECDSA_WITH_SHA3_512
+    { 6, (const uint8_t*)"\x28\xF4\x28\x03\x00\x05", "1.0.14888.3.0.5" },   //  OID_ID_ECKCDSA
+    { 9, (const uint8_t*)"\x2A\x83\x1A\x8C\x9A\x44\x01\x64\x04", "1.2.410.200004.1.100.4" },   //  OID_ID_ECKCDSA_SIGNATURE
+    { 10, (const uint8_t*)"\x2A\x83\x1A\x8C\x9A\x44\x01\x64\x04\x03", "1.2.410.200004.1.100.4.3" },   //  OID_ID_ECKCDSA_WITH_SHA1
+    { 10, (const uint8_t*)"\x2A\x83\x1A\x8C\x9A\x44\x01\x64\x04\x04", "1.2.410.200004.1.100.4.4" },   //  OID_ID_ECKCDSA_WITH_SHA224
+    { 10, (const uint8_t*)"\x2A\x83\x1A\x8C\x9A\x44\x01\x64\x04\x05", "1.2.410.200004.1.100.4.5" },   //  OID_ID_ECKCDSA_WITH_SHA256
+    { 6, (const uint8_t*)"\x2B\x24\x03\x03\x02\x05", "1.3.36.3.3.2.5" },   //  OID_ID_ECGDSA_STD
+    { 8, (const uint8_t*)"\x2B\x24\x03\x03\x02\x05\x02\x01", "1.3.36.3.3.2.5.2.1" },   //  OID_ID_ECGDSA_KEY
+    { 7, (const uint8_t*)"\x2B\x24\x03\x03\x02\x05\x04", "1.3.36.3.3.2.5.4" },   //  OID_ID_ECGDSA_SIGNATURE
+    { 8, (const uint8_t*)"\x2B\x24\x03\x03\x02\x05\x04\x01", "1.3.36.3.3.2.5.4.1" },   //  OID_ID_ECGDSA_SIGNATURE_WITH_RIPEMD160
+    { 8, (const uint8_t*)"\x2B\x24\x03\x03\x02\x05\x04\x02", "1.3.36.3.3.2.5.4.2" },   //  OID_ID_ECGDSA_SIGNATURE_WITH_SHA1
+    { 8, (const uint8_t*)"\x2B\x24\x03\x03\x02\x05\x04\x03", "1.3.36.3.3.2.5.4.3" },   //  OID_ID_ECGDSA_SIGNATURE_WITH_SHA224
+    { 8, (const uint8_t*)"\x2B\x24\x03\x03\x02\x05\x04\x04", "1.3.36.3.3.2.5.4.4" },   //  OID_ID_ECGDSA_SIGNATURE_WITH_SHA256
+    { 8, (const uint8_t*)"\x2B\x24\x03\x03\x02\x05\x04\x05", "1.3.36.3.3.2.5.4.5" },   //  OID_ID_ECGDSA_SIGNATURE_WITH_SHA384
+    { 8, (const uint8_t*)"\x2B\x24\x03\x03\x02\x05\x04\x06", "1.3.36.3.3.2.5.4.6" },   //  OID_ID_ECGDSA_SIGNATURE_WITH_SHA512
+    { 8, (const uint8_t*)"\x2A\x85\x03\x07\x01\x01\x01\x01", "1.2.643.7.1.1.1.1" },   //  OID_ID_GOST_KEY_3410_2012_256
+    { 8, (const uint8_t*)"\x2A\x85\x03\x07\x01\x01\x01\x02", "1.2.643.7.1.1.1.2" },   //  OID_ID_GOST_KEY_3410_2012_512
+    { 8, (const uint8_t*)"\x2A\x85\x03\x07\x01\x01\x03\x02", "1.2.643.7.1.1.3.2" },   //  OID_ID_GOST_3410_2012_256
+    { 8, (const uint8_t*)"\x2A\x85\x03\x07\x01\x01\x03\x03", "1.2.643.7.1.1.3.3" },   //  OID_ID_GOST_3410_2012_512
+    { 6, (const uint8_t*)"\x28\xF4\x28\x03\x00\x0E", "1.0.14888.3.0.14" },   //  OID_ID_SM2
+    { 8, (const uint8_t*)"\x2A\x81\x1C\xCF\x55\x01\x83\x75", "1.2.156.10197.1.501" },   //  OID_ID_SM2_WITH_SM3
+    { 8, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x01", "1.2.840.113549.1.1" },   //  OID_ID_PKCS1
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x01\x01", "1.2.840.113549.1.1.1" },   //  OID_ID_RSA
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x01\x04", "1.2.840.113549.1.1.4" },   //  OID_ID_RSA_WITH_MD5
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x01\x05", "1.2.840.113549.1.1.5" },   //  OID_ID_RSA_WITH_SHA1
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x01\x0E", "1.2.840.113549.1.1.14" },   //  OID_ID_RSA_WITH_SHA224
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x01\x0B", "1.2.840.113549.1.1.11" },   //  OID_ID_RSA_WITH_SHA256
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x01\x0C", "1.2.840.113549.1.1.12" },   //  OID_ID_RSA_WITH_SHA384
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x01\x0D", "1.2.840.113549.1.1.13" },   //  OID_ID_RSA_WITH_SHA512
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x03\x0D", "2.16.840.1.101.3.4.3.13" },   //  OID_ID_RSA_WITH_SHA3_224
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x03\x0E", "2.16.840.1.101.3.4.3.14" },   //  OID_ID_RSA_WITH_SHA3_256
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x03\x0F", "2.16.840.1.101.3.4.3.15" },   //  OID_ID_RSA_WITH_SHA3_384
+    { 9, (const uint8_t*)"\x60\x86\x48\x01\x65\x03\x04\x03\x10", "2.16.840.1.101.3.4.3.16" },   //  OID_ID_RSA_WITH_SHA3_512
+    { 8, (const uint8_t*)"\x2A\x81\x1C\xCF\x55\x01\x83\x78", "1.2.156.10197.1.504" },   //  OID_ID_RSA_WITH_SM3
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x01\x0A", "1.2.840.113549.1.1.10" },   //  OID_ID_RSA_PSS
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x01", "1.2.804.2.1.1.1.1.3.1.1" },   //  OID_ID_DSTU4145_PARAM_PB_LE
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x01\x01", "1.2.804.2.1.1.1.1.3.1.1.1" },   //  OID_ID_DSTU4145_PARAM_SPECIAL_CURVES_PB
+    { 13, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x01\x01\x01", "1.2.804.2.1.1.1.1.3.1.1.1.1" },   //  OID_ID_DSTU4145_PARAM_PB_BE
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x01\x02", "1.2.804.2.1.1.1.1.3.1.1.2" },   //  OID_ID_DSTU4145_PARAM_NAMED_CURVES_PB
+    { 13, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x01\x02\x00", "1.2.804.2.1.1.1.1.3.1.1.2.0" },   //  OID_ID_DSTU4145_PARAM_M163_PB
+    { 13, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x01\x02\x01", "1.2.804.2.1.1.1.1.3.1.1.2.1" },   //  OID_ID_DSTU4145_PARAM_M167_PB
+    { 13, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x01\x02\x02", "1.2.804.2.1.1.1.1.3.1.1.2.2" },   //  OID_ID_DSTU4145_PARAM_M173_PB
+    { 13, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x01\x02\x03", "1.2.804.2.1.1.1.1.3.1.1.2.3" },   //  OID_ID_DSTU4145_PARAM_M179_PB
+    { 13, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x01\x02\x04", "1.2.804.2.1.1.1.1.3.1.1.2.4" },   //  OID_ID_DSTU4145_PARAM_M191_PB
+    { 13, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x01\x02\x05", "1.2.804.2.1.1.1.1.3.1.1.2.5" },   //  OID_ID_DSTU4145_PARAM_M233_PB
+    { 13, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x01\x02\x06", "1.2.804.2.1.1.1.1.3.1.1.2.6" },   //  OID_ID_DSTU4145_PARAM_M257_PB
+    { 13, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x01\x02\x07", "1.2.804.2.1.1.1.1.3.1.1.2.7" },   //  OID_ID_DSTU4145_PARAM_M307_PB
+    { 13, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x01\x02\x08", "1.2.804.2.1.1.1.1.3.1.1.2.8" },   //  OID_ID_DSTU4145_PARAM_M367_PB
+    { 13, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x01\x02\x09", "1.2.804.2.1.1.1.1.3.1.1.2.9" },   //  OID_ID_DSTU4145_PARAM_M431_PB
+    { 11, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x02", "1.2.804.2.1.1.1.1.3.1.2" },   //  OID_ID_DSTU4145_PARAM_ONB_LE
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x02\x01", "1.2.804.2.1.1.1.1.3.1.2.1" },   //  OID_ID_DSTU4145_PARAM_SPECIAL_CURVES_ONB
+    { 13, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x02\x01\x01", "1.2.804.2.1.1.1.1.3.1.2.1.1" },   //  OID_ID_DSTU4145_PARAM_ONB_BE
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x02\x02", "1.2.804.2.1.1.1.1.3.1.2.2" },   //  OID_ID_DSTU4145_PARAM_CURVES_ONB
+    { 13, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x02\x02\x00", "1.2.804.2.1.1.1.1.3.1.2.2.0" },   //  OID_ID_DSTU4145_PARAM_M173_ONB
+    { 13, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x02\x02\x01", "1.2.804.2.1.1.1.1.3.1.2.2.1" },   //  OID_ID_DSTU4145_PARAM_M179_ONB
+    { 13, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x02\x02\x02", "1.2.804.2.1.1.1.1.3.1.2.2.2" },   //  OID_ID_DSTU4145_PARAM_M191_ONB
+    { 13, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x02\x02\x03", "1.2.804.2.1.1.1.1.3.1.2.2.3" },   //  OID_ID_DSTU4145_PARAM_M233_ONB
+    { 13, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x01\x02\x02\x04", "1.2.804.2.1.1.1.1.3.1.2.2.4" },   //  OID_ID_DSTU4145_PARAM_M431_ONB
+    { 8, (const uint8_t*)"\x2A\x86\x48\xCE\x3D\x03\x01\x01", "1.2.840.10045.3.1.1" },   //  OID_ID_NIST_P192
+    { 5, (const uint8_t*)"\x2B\x81\x04\x00\x21", "1.3.132.0.33" },   //  OID_ID_NIST_P224
+    { 8, (const uint8_t*)"\x2A\x86\x48\xCE\x3D\x03\x01\x07", "1.2.840.10045.3.1.7" },   //  OID_ID_NIST_P256
+    { 5, (const uint8_t*)"\x2B\x81\x04\x00\x22", "1.3.132.0.34" },   //  OID_ID_NIST_P384
+    { 5, (const uint8_t*)"\x2B\x81\x04\x00\x23", "1.3.132.0.35" },   //  OID_ID_NIST_P521
+    { 5, (const uint8_t*)"\x2B\x81\x04\x00\x1A", "1.3.132.0.26" },   //  OID_ID_NIST_K233
+    { 5, (const uint8_t*)"\x2B\x81\x04\x00\x1B", "1.3.132.0.27" },   //  OID_ID_NIST_B233
+    { 5, (const uint8_t*)"\x2B\x81\x04\x00\x10", "1.3.132.0.16" },   //  OID_ID_NIST_K283
+    { 5, (const uint8_t*)"\x2B\x81\x04\x00\x11", "1.3.132.0.17" },   //  OID_ID_NIST_B283
+    { 5, (const uint8_t*)"\x2B\x81\x04\x00\x24", "1.3.132.0.36" },   //  OID_ID_NIST_K409
+    { 5, (const uint8_t*)"\x2B\x81\x04\x00\x25", "1.3.132.0.37" },   //  OID_ID_NIST_B409
+    { 5, (const uint8_t*)"\x2B\x81\x04\x00\x26", "1.3.132.0.38" },   //  OID_ID_NIST_K571
+    { 5, (const uint8_t*)"\x2B\x81\x04\x00\x27", "1.3.132.0.39" },   //  OID_ID_NIST_B571
+    { 5, (const uint8_t*)"\x2B\x81\x04\x00\x0A", "1.3.132.0.10" },   //  OID_ID_SECP256K1
+    { 5, (const uint8_t*)"\x2B\x81\x04\x00\x03", "1.3.132.0.3" },   //  OID_ID_SECT239K1
+    { 6, (const uint8_t*)"\x2B\x24\x03\x03\x02\x08", "1.3.36.3.3.2.8" },   //  OID_ID_BRAINPOOL
+    { 7, (const uint8_t*)"\x2B\x24\x03\x03\x02\x08\x01", "1.3.36.3.3.2.8.1" },   //  OID_ID_BRAINPOOL_EC
+    { 9, (const uint8_t*)"\x2B\x24\x03\x03\x02\x08\x01\x01\x05", "1.3.36.3.3.2.8.1.1.5" },   //  OID_ID_BRAINPOOL_P224R1
+    { 9, (const uint8_t*)"\x2B\x24\x03\x03\x02\x08\x01\x01\x06", "1.3.36.3.3.2.8.1.1.6" },   //  OID_ID_BRAINPOOL_P224T1
+    { 9, (const uint8_t*)"\x2B\x24\x03\x03\x02\x08\x01\x01\x07", "1.3.36.3.3.2.8.1.1.7" },   //  OID_ID_BRAINPOOL_P256R1
+    { 9, (const uint8_t*)"\x2B\x24\x03\x03\x02\x08\x01\x01\x08", "1.3.36.3.3.2.8.1.1.8" },   //  OID_ID_BRAINPOOL_P256T1
+    { 9, (const uint8_t*)"\x2B\x24\x03\x03\x02\x08\x01\x01\x09", "1.3.36.3.3.2.8.1.1.9" },   //  OID_ID_BRAINPOOL_P320R1
+    { 9, (const uint8_t*)"\x2B\x24\x03\x03\x02\x08\x01\x01\x0A", "1.3.36.3.3.2.8.1.1.10" },   //  OID_ID_BRAINPOOL_P320T1
+    { 9, (const uint8_t*)"\x2B\x24\x03\x03\x02\x08\x01\x01\x0B", "1.3.36.3.3.2.8.1.1.11" },   //  OID_ID_BRAINPOOL_P384R1
+    { 9, (const uint8_t*)"\x2B\x24\x03\x03\x02\x08\x01\x01\x0C", "1.3.36.3.3.2.8.1.1.12" },   //  OID_ID_BRAINPOOL_P384T1
+    { 9, (const uint8_t*)"\x2B\x24\x03\x03\x02\x08\x01\x01\x0D", "1.3.36.3.3.2.8.1.1.13" },   //  OID_ID_BRAINPOOL_P512R1
+    { 9, (const uint8_t*)"\x2B\x24\x03\x03\x02\x08\x01\x01\x0E", "1.3.36.3.3.2.8.1.1.14" },   //  OID_ID_BRAINPOOL_P512T1
+    { 9, (const uint8_t*)"\x2A\x85\x03\x07\x01\x02\x01\x01\x01", "1.2.643.7.1.2.1.1.1" },   //  OID_ID_ECRDSA_256A
+    { 9, (const uint8_t*)"\x2A\x85\x03\x07\x01\x02\x01\x01\x02", "1.2.643.7.1.2.1.1.2" },   //  OID_ID_ECRDSA_256B
+    { 9, (const uint8_t*)"\x2A\x85\x03\x07\x01\x02\x01\x02\x01", "1.2.643.7.1.2.1.2.1" },   //  OID_ID_ECRDSA_512A
+    { 9, (const uint8_t*)"\x2A\x85\x03\x07\x01\x02\x01\x02\x02", "1.2.643.7.1.2.1.2.2" },   //  OID_ID_ECRDSA_512B
+    { 8, (const uint8_t*)"\x2A\x81\x1C\xCF\x55\x01\x82\x2D", "1.2.156.10197.1.301" },   //  OID_ID_SM2DSA_P256
+    { 3, (const uint8_t*)"\x55\x04\x03", "2.5.4.3" },   //  OID_ID_X520_CommonName
+    { 3, (const uint8_t*)"\x55\x04\x04", "2.5.4.4" },   //  OID_ID_X520_Surname
+    { 3, (const uint8_t*)"\x55\x04\x05", "2.5.4.5" },   //  OID_ID_X520_SerialNumber
+    { 3, (const uint8_t*)"\x55\x04\x06", "2.5.4.6" },   //  OID_ID_X520_Country
+    { 3, (const uint8_t*)"\x55\x04\x07", "2.5.4.7" },   //  OID_ID_X520_Locality
+    { 3, (const uint8_t*)"\x55\x04\x08", "2.5.4.8" },   //  OID_ID_X520_State
+    { 3, (const uint8_t*)"\x55\x04\x09", "2.5.4.9" },   //  OID_ID_X520_StreetAddress
+    { 3, (const uint8_t*)"\x55\x04\x0A", "2.5.4.10" },   //  OID_ID_X520_Organization
+    { 3, (const uint8_t*)"\x55\x04\x0B", "2.5.4.11" },   //  OID_ID_X520_OrganizationalUnit
+    { 3, (const uint8_t*)"\x55\x04\x0C", "2.5.4.12" },   //  OID_ID_X520_Title
+    { 3, (const uint8_t*)"\x55\x04\x2A", "2.5.4.42" },   //  OID_ID_X520_GivenName
+    { 3, (const uint8_t*)"\x55\x04\x2B", "2.5.4.43" },   //  OID_ID_X520_Initials
+    { 3, (const uint8_t*)"\x55\x04\x2C", "2.5.4.44" },   //  OID_ID_X520_GenerationalQualifier
+    { 3, (const uint8_t*)"\x55\x04\x2E", "2.5.4.46" },   //  OID_ID_X520_DNQualifier
+    { 3, (const uint8_t*)"\x55\x04\x41", "2.5.4.65" },   //  OID_ID_X520_Pseudonym
+    { 3, (const uint8_t*)"\x55\x04\x61", "2.5.4.97" },   //  OID_ID_X520_OrganizationIdentifier
+    { 3, (const uint8_t*)"\x55\x1D\x09", "2.5.29.9" },   //  OID_ID_X509v3_SubjectDirectoryAttributes
+    { 3, (const uint8_t*)"\x55\x1D\x0E", "2.5.29.14" },   //  OID_ID_X509v3_SubjectKeyIdentifier
+    { 3, (const uint8_t*)"\x55\x1D\x0F", "2.5.29.15" },   //  OID_ID_X509v3_KeyUsage
+    { 3, (const uint8_t*)"\x55\x1D\x10", "2.5.29.16" },   //  OID_ID_X509v3_PrivateKeyUsagePeriod
+    { 3, (const uint8_t*)"\x55\x1D\x11", "2.5.29.17" },   //  OID_ID_X509v3_SubjectAlternativeName
+    { 3, (const uint8_t*)"\x55\x1D\x12", "2.5.29.18" },   //  OID_ID_X509v3_IssuerAlternativeName
+    { 3, (const uint8_t*)"\x55\x1D\x13", "2.5.29.19" },   //  OID_ID_X509v3_BasicConstraints
+    { 3, (const uint8_t*)"\x55\x1D\x14", "2.5.29.20" },   //  OID_ID_X509v3_CRLNumber
+    { 3, (const uint8_t*)"\x55\x1D\x15", "2.5.29.21" },   //  OID_ID_X509v3_CRLReason
+    { 3, (const uint8_t*)"\x55\x1D\x17", "2.5.29.23" },   //  OID_ID_X509v3_HoldInstructionCode
+    { 3, (const uint8_t*)"\x55\x1D\x18", "2.5.29.24" },   //  OID_ID_X509v3_InvalidityDate
+    { 3, (const uint8_t*)"\x55\x1D\x1B", "2.5.29.27" },   //  OID_ID_X509v3_DeltaCRLIndicator
+    { 3, (const uint8_t*)"\x55\x1D\x1C", "2.5.29.28" },   //  OID_ID_X509v3_CRLIssuingDistributionPoint
+    { 3, (const uint8_t*)"\x55\x1D\x1E", "2.5.29.30" },   //  OID_ID_X509v3_NameConstraints
+    { 3, (const uint8_t*)"\x55\x1D\x1F", "2.5.29.31" },   //  OID_ID_X509v3_CRLDistributionPoints
+    { 3, (const uint8_t*)"\x55\x1D\x20", "2.5.29.32" },   //  OID_ID_X509v3_CertificatePolicies
+    { 3, (const uint8_t*)"\x55\x1D\x23", "2.5.29.35" },   //  OID_ID_X509v3_AuthorityKeyIdentifier
+    { 3, (const uint8_t*)"\x55\x1D\x24", "2.5.29.36" },   //  OID_ID_X509v3_PolicyConstraints
+    { 3, (const uint8_t*)"\x55\x1D\x25", "2.5.29.37" },   //  OID_ID_X509v3_ExtendedKeyUsage
+    { 3, (const uint8_t*)"\x55\x1D\x2E", "2.5.29.46" },   //  OID_ID_X509v3_FreshestCRL
+    { 8, (const uint8_t*)"\x2B\x06\x01\x05\x05\x07\x01\x01", "1.3.6.1.5.5.7.1.1" },   //  OID_ID_PKIX_AuthorityInfoAccess
+    { 8, (const uint8_t*)"\x2B\x06\x01\x05\x05\x07\x01\x03", "1.3.6.1.5.5.7.1.3" },   //  OID_ID_PKIX_QcStatements
+    { 8, (const uint8_t*)"\x2B\x06\x01\x05\x05\x07\x01\x0B", "1.3.6.1.5.5.7.1.11" },   //  OID_ID_PKIX_SubjectInfoAccess
+    { 7, (const uint8_t*)"\x2B\x06\x01\x05\x05\x07\x02", "1.3.6.1.5.5.7.2" },   //  OID_ID_PKIX_PolicyQualifierIds
+    { 8, (const uint8_t*)"\x2B\x06\x01\x05\x05\x07\x02\x01", "1.3.6.1.5.5.7.2.1" },   //  OID_ID_PKIX_PqiCps
+    { 8, (const uint8_t*)"\x2B\x06\x01\x05\x05\x07\x02\x02", "1.3.6.1.5.5.7.2.2" },   //  OID_ID_PKIX_PqiUnotice
+    { 8, (const uint8_t*)"\x2B\x06\x01\x05\x05\x07\x02\x03", "1.3.6.1.5.5.7.2.3" },   //  OID_ID_PKIX_PqiTextNotice
+    { 7, (const uint8_t*)"\x2B\x06\x01\x05\x05\x07\x03", "1.3.6.1.5.5.7.3" },   //  OID_ID_PKIX_ExtendedKeyPurposes
+    { 8, (const uint8_t*)"\x2B\x06\x01\x05\x05\x07\x03\x08", "1.3.6.1.5.5.7.3.8" },   //  OID_ID_PKIX_KpTspSigning
+    { 8, (const uint8_t*)"\x2B\x06\x01\x05\x05\x07\x03\x09", "1.3.6.1.5.5.7.3.9" },   //  OID_ID_PKIX_KpOcspSigning
+    { 8, (const uint8_t*)"\x2B\x06\x01\x05\x05\x07\x30\x01", "1.3.6.1.5.5.7.48.1" },   //  OID_ID_PKIX_OCSP
+    { 9, (const uint8_t*)"\x2B\x06\x01\x05\x05\x07\x30\x01\x01", "1.3.6.1.5.5.7.48.1.1" },   //  OID_ID_PKIX_OcspBasic
+    { 9, (const uint8_t*)"\x2B\x06\x01\x05\x05\x07\x30\x01\x02", "1.3.6.1.5.5.7.48.1.2" },   //  OID_ID_PKIX_OcspNonce
+    { 9, (const uint8_t*)"\x2B\x06\x01\x05\x05\x07\x30\x01\x03", "1.3.6.1.5.5.7.48.1.3" },   //  OID_ID_PKIX_OcspCrl
+    { 9, (const uint8_t*)"\x2B\x06\x01\x05\x05\x07\x30\x01\x04", "1.3.6.1.5.5.7.48.1.4" },   //  OID_ID_PKIX_OcspResponse
+    { 8, (const uint8_t*)"\x2B\x06\x01\x05\x05\x07\x30\x02", "1.3.6.1.5.5.7.48.2" },   //  OID_ID_PKIX_CaIssuers
+    { 8, (const uint8_t*)"\x2B\x06\x01\x05\x05\x07\x30\x03", "1.3.6.1.5.5.7.48.3" },   //  OID_ID_PKIX_TimeStamping
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x05\x0C", "1.2.840.113549.1.5.12" },   //  OID_ID_PKCS5_PBKDF2
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x05\x0D", "1.2.840.113549.1.5.13" },   //  OID_ID_PKCS5_PBES2
+    { 10, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x0C\x01\x03", "1.2.840.113549.1.12.1.3" },   //  OID_ID_PBE_WITH_SHA1_TDES_CBC
+    { 10, (const uint8_t*)"\x48\x86\xF7\x0D\x01\x07\x01\xA0\x82\x01", "1.32.113549.1.7.1.524545" },   //  OID_ID_MEDOC_DIGEST
+    { 12, (const uint8_t*)"\x2B\x06\x01\x04\x01\x81\x97\x46\x01\x01\x01\x02", "1.3.6.1.4.1.19398.1.1.1.2" },   //  OID_ID_IIT_KEYSTORE
+    { 12, (const uint8_t*)"\x2B\x06\x01\x04\x01\x81\x97\x46\x01\x01\x01\x05", "1.3.6.1.4.1.19398.1.1.1.5" },   //  OID_ID_IIT_KEYSTORE_ATTR_RSA_PRIVKEY
+    { 12, (const uint8_t*)"\x2B\x06\x01\x04\x01\x81\x97\x46\x01\x01\x02\x01", "1.3.6.1.4.1.19398.1.1.2.1" },   //  OID_ID_IIT_KEYSTORE_ATTR_SIGN_KEYID
+    { 12, (const uint8_t*)"\x2B\x06\x01\x04\x01\x81\x97\x46\x01\x01\x02\x02", "1.3.6.1.4.1.19398.1.1.2.2" },   //  OID_ID_IIT_KEYSTORE_ATTR_KEP_SPKI
+    { 12, (const uint8_t*)"\x2B\x06\x01\x04\x01\x81\x97\x46\x01\x01\x02\x03", "1.3.6.1.4.1.19398.1.1.2.3" },   //  OID_ID_IIT_KEYSTORE_ATTR_KEP_PRIVKEY
+    { 12, (const uint8_t*)"\x2B\x06\x01\x04\x01\x81\x97\x46\x01\x01\x02\x05", "1.3.6.1.4.1.19398.1.1.2.5" },   //  OID_ID_IIT_KEYSTORE_ATTR_KEP_KEYID
+    { 12, (const uint8_t*)"\x2B\x06\x01\x04\x01\x81\x97\x46\x01\x01\x02\x06", "1.3.6.1.4.1.19398.1.1.2.6" },   //  OID_ID_IIT_KEYSTORE_ATTR_HMAC_GOST34311
+    { 12, (const uint8_t*)"\x2B\x06\x01\x04\x01\x81\x97\x46\x01\x01\x02\x07", "1.3.6.1.4.1.19398.1.1.2.7" },   //  OID_ID_IIT_KEYSTORE_ATTR_RSA_KEYID
+    { 12, (const uint8_t*)"\x2B\x06\x01\x04\x01\x81\x97\x46\x01\x01\x08\x01", "1.3.6.1.4.1.19398.1.1.8.1" },   //  OID_ID_IIT_KEYPURPOSE_CMP_SIGNING
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x07\x01", "1.2.840.113549.1.7.1" },   //  OID_ID_PKCS7_DATA
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x07\x02", "1.2.840.113549.1.7.2" },   //  OID_ID_PKCS7_SIGNED_DATA
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x07\x03", "1.2.840.113549.1.7.3" },   //  OID_ID_PKCS7_ENVELOPED_DATA
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x07\x05", "1.2.840.113549.1.7.5" },   //  OID_ID_PKCS7_DIGESTED_DATA
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x07\x06", "1.2.840.113549.1.7.6" },   //  OID_ID_PKCS7_ENCRYPTED_DATA
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x03", "1.2.840.113549.1.9.3" },   //  OID_ID_PKCS9_CONTENT_TYPE
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x04", "1.2.840.113549.1.9.4" },   //  OID_ID_PKCS9_MESSAGE_DIGEST
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x05", "1.2.840.113549.1.9.5" },   //  OID_ID_PKCS9_SIGNING_TIME
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x07", "1.2.840.113549.1.9.7" },   //  OID_ID_PKCS9_CHALLENGE_PASSWORD
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x0E", "1.2.840.113549.1.9.14" },   //  OID_ID_PKCS9_EXTENSION_REQUEST
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x14", "1.2.840.113549.1.9.20" },   //  OID_ID_PKCS9_FRIENDLY_NAME
+    { 9, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x15", "1.2.840.113549.1.9.21" },   //  OID_ID_PKCS9_LOCAL_KEYID
+    { 10, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x16\x01", "1.2.840.113549.1.9.22.1" },   //  OID_ID_PKCS9_X509_CERTIFICATE
+    { 10, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x16\x02", "1.2.840.113549.1.9.22.2" },   //  OID_ID_PKCS9_SDSI_CERTIFICATE
+    { 10, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x17\x01", "1.2.840.113549.1.9.23.1" },   //  OID_ID_PKCS9_X509_CRL
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x10\x01\x04", "1.2.840.113549.1.9.16.1.4" },   //  OID_ID_PKCS9_TST_INFO
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x10\x02\x0E", "1.2.840.113549.1.9.16.2.14" },   //  OID_ID_PKCS9_TIMESTAMP_TOKEN
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x10\x02\x0F", "1.2.840.113549.1.9.16.2.15" },   //  OID_ID_PKCS9_SIG_POLICY_ID
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x10\x02\x10", "1.2.840.113549.1.9.16.2.16" },   //  OID_ID_PKCS9_COMMITMENT_TYPE
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x10\x02\x14", "1.2.840.113549.1.9.16.2.20" },   //  OID_ID_PKCS9_CONTENT_TIMESTAMP
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x10\x02\x15", "1.2.840.113549.1.9.16.2.21" },   //  OID_ID_PKCS9_CERTIFICATE_REFS
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x10\x02\x16", "1.2.840.113549.1.9.16.2.22" },   //  OID_ID_PKCS9_REVOCATION_REFS
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x10\x02\x17", "1.2.840.113549.1.9.16.2.23" },   //  OID_ID_PKCS9_CERT_VALUES
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x10\x02\x18", "1.2.840.113549.1.9.16.2.24" },   //  OID_ID_PKCS9_REVOCATION_VALUES
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x10\x02\x19", "1.2.840.113549.1.9.16.2.25" },   //  OID_ID_PKCS9_CADES_C_TIMESTAMP
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x10\x02\x1A", "1.2.840.113549.1.9.16.2.26" },   //  OID_ID_PKCS9_CERT_CRL_TIMESTAMP
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x09\x10\x02\x2F", "1.2.840.113549.1.9.16.2.47" },   //  OID_ID_PKCS9_SIGNING_CERTIFICATE_V2
+    { 10, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x0C\x0A\x01", "1.2.840.113549.1.12.10.1" },   //  OID_ID_PKCS12_BAGTYPES
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x0C\x0A\x01\x01", "1.2.840.113549.1.12.10.1.1" },   //  OID_ID_PKCS12_KEY_BAG
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x0C\x0A\x01\x02", "1.2.840.113549.1.12.10.1.2" },   //  OID_ID_PKCS12_P8_SHROUDED_KEY_BAG
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x0C\x0A\x01\x03", "1.2.840.113549.1.12.10.1.3" },   //  OID_ID_PKCS12_CERT_BAG
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x0C\x0A\x01\x04", "1.2.840.113549.1.12.10.1.4" },   //  OID_ID_PKCS12_CRL_BAG
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x0C\x0A\x01\x05", "1.2.840.113549.1.12.10.1.5" },   //  OID_ID_PKCS12_SECRET_BAG
+    { 11, (const uint8_t*)"\x2A\x86\x48\x86\xF7\x0D\x01\x0C\x0A\x01\x06", "1.2.840.113549.1.12.10.1.6" },   //  OID_ID_PKCS12_SAFE_CONTENTS_BAG
+    { 10, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x07", "1.2.804.2.1.1.1.1.3.7" },   //  OID_ID_COFACTOR_DH_DSTU7564_KDF
+    { 10, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x08", "1.2.804.2.1.1.1.1.3.8" },   //  OID_ID_STD_DH_DSTU7564_KDF
+    { 10, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x04", "1.2.804.2.1.1.1.1.3.4" },   //  OID_ID_COFACTOR_DH_GOST34311_KDF
+    { 10, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x01\x03\x05", "1.2.804.2.1.1.1.1.3.5" },   //  OID_ID_STD_DH_GOST34311_KDF
+    { 9, (const uint8_t*)"\x2B\x81\x05\x10\x86\x48\x3F\x00\x02", "1.3.133.16.840.63.0.2" },   //  OID_ID_DHSINGLEPASS_STD_DH_SHA1_KDF
+    { 9, (const uint8_t*)"\x2B\x81\x05\x10\x86\x48\x3F\x00\x03", "1.3.133.16.840.63.0.3" },   //  OID_ID_DHSINGLEPASS_COFACTOR_DH_SHA1_KDF
+    { 6, (const uint8_t*)"\x2B\x81\x04\x01\x0B\x01", "1.3.132.1.11.1" },   //  OID_ID_DHSINGLEPASS_STD_DH_SHA256_KDF
+    { 10, (const uint8_t*)"\x2B\x06\x01\x04\x01\x2A\x02\x11\x01\x01", "1.3.6.1.4.1.42.2.17.1.1" },   //  OID_ID_JKS_KEY_PROTECTOR
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x0B\x01\x04\x01\x01", "1.2.804.2.1.1.1.11.1.4.1.1" },   //  OID_ID_PDS_UKRAINE_DRFO
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x0B\x01\x04\x02\x01", "1.2.804.2.1.1.1.11.1.4.2.1" },   //  OID_ID_PDS_UKRAINE_EDRPOU
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x0B\x01\x04\x03\x01", "1.2.804.2.1.1.1.11.1.4.3.1" },   //  OID_ID_PDS_UKRAINE_NBU
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x0B\x01\x04\x04\x01", "1.2.804.2.1.1.1.11.1.4.4.1" },   //  OID_ID_PDS_UKRAINE_SPMF
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x0B\x01\x04\x05\x01", "1.2.804.2.1.1.1.11.1.4.5.1" },   //  OID_ID_PDS_UKRAINE_ORG
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x0B\x01\x04\x06\x01", "1.2.804.2.1.1.1.11.1.4.6.1" },   //  OID_ID_PDS_UKRAINE_UNIT
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x0B\x01\x04\x07\x01", "1.2.804.2.1.1.1.11.1.4.7.1" },   //  OID_ID_PDS_UKRAINE_USER
+    { 12, (const uint8_t*)"\x2A\x86\x24\x02\x01\x01\x01\x0B\x01\x04\x0B\x01", "1.2.804.2.1.1.1.11.1.4.11.1" },   //  OID_ID_PDS_UKRAINE_EDDR
+    { 6, (const uint8_t*)"\x04\x00\x8D\x45\x02\x04", "0.4.0.1733.2.4" },   //  OID_ID_ETSI_ARCHIVE_TIMESTAMP_V3
+};
+
+static const uint16_t OID_REGISTRY_SEEDS[OID_REGISTRY_BUCKETS] = {
+    0, 11, 6, 2, 1, 5, 3, 12, 1, 1, 7, 1, 6, 1, 1, 2,
+    3, 4, 1, 4, 6, 7, 7, 8, 9, 1, 3, 1, 1, 1, 7, 1,
+    2, 1, 5, 6, 1, 2, 0, 3, 0, 5, 1, 20, 3, 0, 4, 1,
+    2, 3, 2, 5, 7, 0, 1, 4, 4, 0, 2, 0, 8, 7, 1, 25,
+    1, 1, 2, 2, 1, 1, 6, 2, 12, 8, 12, 10, 12, 1, 0, 4,
+    1, 1, 5, 1, 1, 1, 6, 6, 2, 3, 1, 2, 2, 4, 2, 2,
+    1, 1, 2, 4, 1, 1, 3, 4, 11, 4, 4, 3, 1, 15, 33, 3,
+    1, 10, 5, 2, 4, 2, 1, 19, 7, 2, 9, 2, 7, 0, 2, 20,
+};
+
+static const uint16_t OID_REGISTRY_INDEX[OID_REGISTRY_SLOTS] = {
+    71, 70, 323, 0, 0, 103, 6, 115, 285, 133, 0, 147, 0, 302, 283, 0,
+    274, 50, 331, 0, 119, 0, 297, 0, 0, 0, 0, 343, 247, 19, 0, 171,
+    55, 0, 28, 188, 182, 121, 0, 272, 0, 185, 233, 0, 0, 114, 174, 0,
+    0, 0, 319, 257, 316, 332, 142, 0, 279, 81, 0, 134, 109, 84, 22, 286,
+    232, 157, 64, 0, 190, 68, 0, 0, 0, 63, 145, 317, 309, 0, 111, 0,
+    153, 0, 0, 130, 318, 210, 53, 290, 0, 0, 227, 0, 0, 127, 249, 253,
+    0, 246, 0, 0, 0, 0, 179, 229, 0, 219, 90, 239, 62, 0, 0, 99,
+    0, 164, 0, 9, 175, 172, 39, 156, 294, 281, 165, 15, 110, 40, 46, 0,
+    250, 105, 0, 137, 310, 0, 0, 17, 154, 0, 260, 91, 97, 0, 0, 333,
+    95, 60, 305, 101, 216, 222, 0, 0, 0, 86, 275, 108, 301, 152, 0, 0,
+    0, 0, 0, 35, 0, 76, 259, 125, 0, 342, 241, 25, 220, 74, 0, 14,
+    34, 256, 69, 206, 194, 223, 144, 116, 30, 113, 0, 12, 44, 204, 0, 5,
+    287, 0, 0, 93, 0, 163, 173, 49, 0, 304, 0, 242, 0, 78, 298, 0,
+    0, 139, 0, 0, 92, 207, 218, 0, 89, 0, 176, 336, 45, 306, 203, 20,
+    135, 83, 0, 312, 208, 82, 282, 168, 112, 0, 0, 58, 0, 200, 140, 0,
+    334, 186, 295, 0, 16, 0, 189, 21, 136, 291, 0, 0, 0, 258, 0, 327,
+    211, 162, 340, 245, 85, 0, 0, 106, 308, 335, 72, 148, 321, 264, 314, 123,
+    0, 104, 0, 79, 132, 183, 201, 255, 24, 59, 0, 0, 124, 0, 29, 324,
+    307, 0, 56, 65, 181, 47, 10, 238, 27, 303, 0, 150, 4, 87, 261, 0,
+    51, 0, 0, 0, 48, 192, 180, 42, 251, 0, 195, 0, 0, 280, 138, 0,
+    23, 0, 199, 161, 146, 205, 1, 0, 0, 271, 0, 269, 0, 143, 100, 268,
+    0, 0, 131, 0, 167, 0, 11, 213, 339, 0, 0, 107, 296, 345, 118, 0,
+    43, 289, 0, 0, 0, 0, 234, 158, 0, 0, 3, 141, 328, 0, 0, 26,
+    337, 0, 191, 266, 198, 224, 0, 117, 0, 338, 263, 0, 0, 0, 270, 129,
+    0, 126, 57, 313, 277, 225, 330, 0, 33, 0, 170, 8, 67, 36, 0, 212,
+    98, 184, 320, 326, 237, 0, 217, 159, 0, 341, 252, 262, 0, 0, 0, 94,
+    0, 7, 73, 13, 38, 299, 284, 177, 228, 197, 346, 254, 61, 265, 0, 248,
+    0, 88, 230, 236, 344, 122, 149, 311, 273, 0, 0, 155, 0, 31, 0, 54,
+    276, 166, 160, 329, 235, 66, 215, 315, 0, 300, 0, 278, 32, 0, 18, 178,
+    202, 120, 0, 231, 0, 221, 0, 226, 187, 325, 196, 0, 102, 0, 0, 0,
+    0, 80, 244, 322, 128, 41, 75, 267, 0, 52, 0, 96, 77, 2, 293, 0,
+    0, 243, 292, 288, 240, 193, 214, 169, 209, 151, 37, 0, 0, 0, 0, 0,
+};
+
+#endif
+
+#endif
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2023, The UAPKI Project Authors.
+#
+# Generates oid-registry-data.h from the DEFINE_OID() list in oids.h:
+#   - OidId enumeration (OID_xxx -> OID_ID_xxx, in the order of oids.h);
+#   - DER content bytes and text of every OID;
+#   - hash-and-displace perfect hash over the DER content bytes.
+# Run it after changing oids.h:  python3 oid-registry-gen.py
+# With --check the file is not written, exit code 1 means that oid-registry-data.h is out of date
+# (the check is a build step of uapki).
+
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SRC = os.path.join(HERE, 'oids.h')
+DST = os.path.join(HERE, 'oid-registry-data.h')
+
+#  Keep in sync with oid_registry_hash() in oid-registry.c
+FNV_OFFSET = 0x811C9DC5
+FNV_PRIME = 0x01000193
+BUCKETS = 128
+SLOTS = 512
+
+
+def der_content(text):
+    arcs = [int(a) for a in text.split('.')]
+    if len(arcs) < 2 or arcs[0] > 2 or (arcs[0] < 2 and arcs[1] > 39):
+        raise ValueError('invalid OID: ' + text)
+    arcs = [arcs[0] * 40 + arcs[1]] + arcs[2:]
+    out = bytearray()
+    for arc in arcs:
+        enc = [arc & 0x7F]
+        arc >>= 7
+        while arc:
+            enc.append(0x80 | (arc & 0x7F))
+            arc >>= 7
+        out.extend(reversed(enc))
+    return bytes(out)
+
+
+def fnv(seed, data):
+    h = (FNV_OFFSET ^ seed) & 0xFFFFFFFF
+    for b in data:
+        h ^= b
+        h = (h * FNV_PRIME) & 0xFFFFFFFF
+    return h
+
+
+def build_perfect_hash(keys):
+    buckets = [[] for _ in range(BUCKETS)]
+    for idx, key in enumerate(keys):
+        buckets[fnv(0, key) % BUCKETS].append(idx)
+    seeds = [0] * BUCKETS
+    slots = [0] * SLOTS
+    for b in sorted(range(BUCKETS), key=lambda i: -len(buckets[i])):
+        if not buckets[b]:
+            continue
+        for seed in range(1, 0x10000):
+            pos = [fnv(seed, keys[i]) % SLOTS for i in buckets[b]]
+            if len(set(pos)) == len(pos) and all(slots[p] == 0 for p in pos):
+                for i, p in zip(buckets[b], pos):
+                    slots[p] = i + 1
+                seeds[b] = seed
+                break
+        else:
+            sys.exit('perfect hash: no seed for bucket %d' % b)
+    return seeds, slots
+
+
+def c_bytes(data):
+    return ''.join('\\x%02X' % b for b in data)
+
+
+def main():
+    entries = []
+    aliases = []
+    by_value = {}
+    for name, value in re.findall(r'DEFINE_OID\(\s*(OID_\w+)\s*,\s*"([^"]*)"\s*\)', open(SRC).read()):
+        value = value.strip()
+        ident = 'OID_ID_' + name[4:]
+        if value in by_value:
+            aliases.append((ident, by_value[value]))
+            continue
+        by_value[value] = ident
+        entries.append((ident, value, der_content(value)))
+
+    seeds, slots = build_perfect_hash([e[2] for e in entries])
+    width = max(len(e[0]) for e in entries + aliases)
+
+    out = []
+    out.append('/*')
+    out.append(' * Generated by oid-registry-gen.py from oids.h, do not edit.')
+    out.append(' */')
+    out.append('')
+    out.append('#ifndef UAPKI_OID_REGISTRY_DATA_H')
+    out.append('#define UAPKI_OID_REGISTRY_DATA_H')
+    out.append('')
+    out.append('')
+    out.append('typedef enum {')
+    out.append('    %s = 0,' % 'OID_ID_UNDEFINED'.ljust(width))
+    for i, (ident, _, _) in enumerate(entries, 1):
+        out.append('    %s = %d,' % (ident.ljust(width), i))
+    for ident, target in aliases:
+        out.append('    %s = %s,' % (ident.ljust(width), target))
+    out.append('    %s = %d' % ('OID_ID_COUNT'.ljust(width), len(entries) + 1))
+    out.append('} OidId;')
+    out.append('')
+    out.append('')
+    out.append('#ifdef OID_REGISTRY_DATA_TABLES')
+    out.append('')
+    out.append('#define OID_REGISTRY_BUCKETS %d' % BUCKETS)
+    out.append('#define OID_REGISTRY_SLOTS %d' % SLOTS)
+    out.append('')
+    out.append('static const OidRegistryEntry OID_REGISTRY_ENTRIES[OID_ID_COUNT] = {')
+    out.append('    { 0, NULL, NULL },')
+    for ident, value, der in entries:
+        out.append('    { %d, (const uint8_t*)"%s", "%s" },   //  %s' % (len(der), c_bytes(der), value, ident))
+    out.append('};')
+    out.append('')
+    out.append('static const uint16_t OID_REGISTRY_SEEDS[OID_REGISTRY_BUCKETS] = {')
+    for i in range(0, BUCKETS, 16):
+        out.append('    ' + ', '.join('%d' % v for v in seeds[i:i + 16]) + ',')
+    out.append('};')
+    out.append('')
+    out.append('static const uint16_t OID_REGISTRY_INDEX[OID_REGISTRY_SLOTS] = {')
+    for i in range(0, SLOTS, 16):
+        out.append('    ' + ', '.join('%d' % v for v in slots[i:i + 16]) + ',')
+    out.append('};')
+    out.append('')
+    out.append('#endif')
+    out.append('')
+    out.append('#endif')
+    out.append('')
+
+    text = '\n'.join(out)
+    if '--check' in sys.argv[1:]:
+        with open(DST, newline='') as f:
+            if f.read() != text:
+                sys.exit('%s is out of date, run %s' % (DST, os.path.basename(__file__)))
+        return
+
+    with open(DST, 'w', newline='\n') as f:
+        f.write(text)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2023, The UAPKI Project Authors.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions are 
+ * met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright 
+ * notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright 
+ * notice, this list of conditions and the following disclaimer in the 
+ * documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS 
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED 
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A 
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED 
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR 
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define FILE_MARKER "common/pkix/oid-registry.c"
+
+#define OID_REGISTRY_DATA_TABLES
+#include "oid-registry.h"
+#include <string.h>
+
+
+//  Keep in sync with fnv() in oid-registry-gen.py
+static uint32_t oid_registry_hash (const uint32_t seed, const uint8_t* buf, const size_t len)
+{
+    uint32_t h = 0x811C9DC5 ^ seed;
+    for (size_t i = 0; i < len; i++) {
+        h ^= buf[i];
+        h *= 0x01000193;
+    }
+    return h;
+}
+
+OidId oid_id_from_der (const uint8_t* buf, const size_t len)
+{
+    if (!buf || (len == 0)) return OID_ID_UNDEFINED;
+
+    const uint16_t seed = OID_REGISTRY_SEEDS[oid_registry_hash(0, buf, len) % OID_REGISTRY_BUCKETS];
+    const uint16_t idx = OID_REGISTRY_INDEX[oid_registry_hash(seed, buf, len) % OID_REGISTRY_SLOTS];
+    if (idx == 0) return OID_ID_UNDEFINED;
+
+    const OidRegistryEntry* entry = &OID_REGISTRY_ENTRIES[idx];
+    return ((entry->derLen == len) && (memcmp(entry->der, buf, len) == 0)) ? (OidId)idx : OID_ID_UNDEFINED;
+}
+
+OidId oid_id_from_OID (const OBJECT_IDENTIFIER_t* oid)
+{
+    if (!oid || (oid->size <= 0)) return OID_ID_UNDEFINED;
+
+    return oid_id_from_der(oid->buf, (size_t)oid->size);
+}
+
+OidId oid_id_from_text (const char* oid)
+{
+    uint8_t der[OID_MAX_DER_LEN];
+    const size_t len = oid_text_to_der(oid, der, sizeof(der));
+    return oid_id_from_der(der, len);
+}
+
+const char* oid_id_to_text (const OidId oidId)
+{
+    return ((oidId > OID_ID_UNDEFINED) && (oidId < OID_ID_COUNT)) ? OID_REGISTRY_ENTRIES[oidId].text : NULL;
+}
+
+bool oid_id_is_parent_der (const OidId parentId, const uint8_t* buf, const size_t len)
+{
+    if ((parentId <= OID_ID_UNDEFINED) || (parentId >= OID_ID_COUNT) || !buf) return false;
+
+    //  Every subidentifier ends with a byte without the high bit, so a DER prefix is always a whole arc prefix
+    const OidRegistryEntry* parent = &OID_REGISTRY_ENTRIES[parentId];
+    return (len >= parent->derLen) && (memcmp(parent->der, buf, parent->derLen) == 0);
+}
+
+bool OID_is_child_id (const OBJECT_IDENTIFIER_t* oid, const OidId parentId)
+{
+    if (!oid || (oid->size <= 0)) return false;
+
+    return oid_id_is_parent_der(parentId, oid->buf, (size_t)oid->size);
+}
+
+static size_t oid_put_arc (uint64_t arc, uint8_t* buf, const size_t size, size_t pos)
+{
+    uint8_t tmp[10];
+    size_t cnt = 0;
+
+    do {
+        tmp[cnt++] = (uint8_t)(arc & 0x7F);
+        arc >>= 7;
+    } while (arc > 0);
+
+    if (size - pos < cnt) return 0;
+
+    while (cnt > 1) {
+        buf[pos++] = tmp[--cnt] | 0x80;
+    }
+    buf[pos++] = tmp[0];
+    return pos;
+}
+
+size_t oid_text_to_der (const char* oid, uint8_t* buf, const size_t size)
+{
+    uint64_t arc, first = 0;
+    size_t pos = 0, idx = 0;
+    const char* p = oid;
+
+    if (!oid || !buf) return 0;
+
+    for (;;) {
+        //  Canonical decimal arc: no sign, no leading zeros
+        if ((*p < '0') || (*p > '9')) return 0;
+        if ((*p == '0') && (p[1] >= '0') && (p[1] <= '9')) return 0;
+        for (arc = 0; (*p >= '0') && (*p <= '9'); p++) {
+            if (arc > (UINT64_MAX - 9) / 10) return 0;
+            arc = arc * 10 + (uint64_t)(*p - '0');
+        }
+
+        if (idx == 0) {
+            if (arc > 2) return 0;
+            first = arc;
+        }
+        else if (idx == 1) {
+            if ((first < 2) && (arc > 39)) return 0;
+            if (arc > UINT64_MAX - 80) return 0;
+            pos = oid_put_arc(first * 40 + arc, buf, size, pos);
+            if (pos == 0) return 0;
+        }
+        else {
+            pos = oid_put_arc(arc, buf, size, pos);
+            if (pos == 0) return 0;
+        }
+        idx++;
+
+        if (*p == '\0') break;
+        if (*p != '.') return 0;
+        p++;
+    }
+
+    return (idx >= 2) ? pos : 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2023, The UAPKI Project Authors.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions are 
+ * met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright 
+ * notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright 
+ * notice, this list of conditions and the following disclaimer in the 
+ * documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS 
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED 
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A 
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED 
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR 
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UAPKI_OID_REGISTRY_H
+#define UAPKI_OID_REGISTRY_H
+
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "uapkif.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+//  Enough for the DER content bytes of any OID used in practice (oid_text_to_der)
+#define OID_MAX_DER_LEN 64
+
+typedef struct OidRegistryEntry_st {
+    size_t          derLen;
+    const uint8_t*  der;
+    const char*     text;
+} OidRegistryEntry;
+
+#include "oid-registry-data.h"
+
+
+//  Interned OIDs of oids.h: OidId is resolved from the DER content bytes by a perfect hash,
+//  without the conversion to text and without allocations.
+//  Tables are generated by oid-registry-gen.py
+OidId oid_id_from_der (const uint8_t* buf, const size_t len);
+OidId oid_id_from_OID (const OBJECT_IDENTIFIER_t* oid);
+OidId oid_id_from_text (const char* oid);
+const char* oid_id_to_text (const OidId oidId);
+//  Returns true if oid equals to parentId or is a descendant of it (like oid_is_parent())
+bool oid_id_is_parent_der (const OidId parentId, const uint8_t* buf, const size_t len);
+bool OID_is_child_id (const OBJECT_IDENTIFIER_t* oid, const OidId parentId);
+//  Encodes dotted text into DER content bytes, returns the length or 0 if text is not a canonical OID
+size_t oid_text_to_der (const char* oid, uint8_t* buf, const size_t size);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
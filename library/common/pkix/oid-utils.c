@@ -26,6 +26,8 @@
  */
 
 #include "oid-utils.h"
+#include "oid-registry.h"
+#include <string.h>
 
 
 const char* ecid_to_oid (EcParamsId ecid)
@@ -112,58 +114,98 @@ const char* ecid_to_oid (EcParamsId ecid)
     }
 }
 
+static EcParamsId ecid_from_id (const OidId oidId)
+{
+    switch (oidId) {
+    case OID_ID_DSTU4145_PARAM_M163_PB:
+        return EC_PARAMS_ID_DSTU4145_M163_PB;
+    case OID_ID_DSTU4145_PARAM_M167_PB:
+        return EC_PARAMS_ID_DSTU4145_M167_PB;
+    case OID_ID_DSTU4145_PARAM_M173_PB:
+        return EC_PARAMS_ID_DSTU4145_M173_PB;
+    case OID_ID_DSTU4145_PARAM_M179_PB:
+        return EC_PARAMS_ID_DSTU4145_M179_PB;
+    case OID_ID_DSTU4145_PARAM_M191_PB:
+        return EC_PARAMS_ID_DSTU4145_M191_PB;
+    case OID_ID_DSTU4145_PARAM_M233_PB:
+        return EC_PARAMS_ID_DSTU4145_M233_PB;
+    case OID_ID_DSTU4145_PARAM_M257_PB:
+        return EC_PARAMS_ID_DSTU4145_M257_PB;
+    case OID_ID_DSTU4145_PARAM_M307_PB:
+        return EC_PARAMS_ID_DSTU4145_M307_PB;
+    case OID_ID_DSTU4145_PARAM_M367_PB:
+        return EC_PARAMS_ID_DSTU4145_M367_PB;
+    case OID_ID_DSTU4145_PARAM_M431_PB:
+        return EC_PARAMS_ID_DSTU4145_M431_PB;
+    case OID_ID_DSTU4145_PARAM_M173_ONB:
+        return EC_PARAMS_ID_DSTU4145_M173_ONB;
+    case OID_ID_DSTU4145_PARAM_M179_ONB:
+        return EC_PARAMS_ID_DSTU4145_M179_ONB;
+    case OID_ID_DSTU4145_PARAM_M191_ONB:
+        return EC_PARAMS_ID_DSTU4145_M191_ONB;
+    case OID_ID_DSTU4145_PARAM_M233_ONB:
+        return EC_PARAMS_ID_DSTU4145_M233_ONB;
+    case OID_ID_DSTU4145_PARAM_M431_ONB:
+        return EC_PARAMS_ID_DSTU4145_M431_ONB;
+    case OID_ID_NIST_P192:
+        return EC_PARAMS_ID_NIST_P192;
+    case OID_ID_NIST_P224:
+        return EC_PARAMS_ID_NIST_P224;
+    case OID_ID_NIST_P256:
+        return EC_PARAMS_ID_NIST_P256;
+    case OID_ID_NIST_P384:
+        return EC_PARAMS_ID_NIST_P384;
+    case OID_ID_NIST_P521:
+        return EC_PARAMS_ID_NIST_P521;
+    case OID_ID_NIST_B233:
+        return EC_PARAMS_ID_NIST_B233;
+    case OID_ID_NIST_B283:
+        return EC_PARAMS_ID_NIST_B283;
+    case OID_ID_NIST_B409:
+        return EC_PARAMS_ID_NIST_B409;
+    case OID_ID_NIST_B571:
+        return EC_PARAMS_ID_NIST_B571;
+    case OID_ID_NIST_K233:
+        return EC_PARAMS_ID_NIST_K233;
+    case OID_ID_NIST_K283:
+        return EC_PARAMS_ID_NIST_K283;
+    case OID_ID_NIST_K409:
+        return EC_PARAMS_ID_NIST_K409;
+    case OID_ID_NIST_K571:
+        return EC_PARAMS_ID_NIST_K571;
+    case OID_ID_SECP256K1:
+        return EC_PARAMS_ID_SEC_P256_K1;
+    case OID_ID_BRAINPOOL_P224R1:
+        return EC_PARAMS_ID_BRAINPOOL_P224_R1;
+    case OID_ID_BRAINPOOL_P256R1:
+        return EC_PARAMS_ID_BRAINPOOL_P256_R1;
+    case OID_ID_BRAINPOOL_P384R1:
+        return EC_PARAMS_ID_BRAINPOOL_P384_R1;
+    case OID_ID_BRAINPOOL_P512R1:
+        return EC_PARAMS_ID_BRAINPOOL_P512_R1;
+    case OID_ID_ECRDSA_256A:
+        return EC_PARAMS_ID_GOST_P256_A;
+    case OID_ID_ECRDSA_256B:
+        return EC_PARAMS_ID_GOST_P256_B;
+    case OID_ID_ECRDSA_512A:
+        return EC_PARAMS_ID_GOST_P512_A;
+    case OID_ID_ECRDSA_512B:
+        return EC_PARAMS_ID_GOST_P512_B;
+    case OID_ID_SM2DSA_P256:
+        return EC_PARAMS_ID_SM2_P256;
+    default:
+        return EC_PARAMS_ID_UNDEFINED;
+    }
+}
+
 EcParamsId ecid_from_oid (const char* oid)
 {
-    if (oid_is_equal(OID_DSTU4145_PARAM_M257_PB, oid)) return EC_PARAMS_ID_DSTU4145_M257_PB;
-    if (oid_is_equal(OID_DSTU4145_PARAM_M431_PB, oid)) return EC_PARAMS_ID_DSTU4145_M431_PB;
-    if (oid_is_equal(OID_DSTU4145_PARAM_M307_PB, oid)) return EC_PARAMS_ID_DSTU4145_M307_PB;
-    if (oid_is_equal(OID_DSTU4145_PARAM_M367_PB, oid)) return EC_PARAMS_ID_DSTU4145_M367_PB;
-    if (oid_is_equal(OID_DSTU4145_PARAM_M163_PB, oid)) return EC_PARAMS_ID_DSTU4145_M163_PB;
-    if (oid_is_equal(OID_DSTU4145_PARAM_M167_PB, oid)) return EC_PARAMS_ID_DSTU4145_M167_PB;
-    if (oid_is_equal(OID_DSTU4145_PARAM_M173_PB, oid)) return EC_PARAMS_ID_DSTU4145_M173_PB;
-    if (oid_is_equal(OID_DSTU4145_PARAM_M179_PB, oid)) return EC_PARAMS_ID_DSTU4145_M179_PB;
-    if (oid_is_equal(OID_DSTU4145_PARAM_M191_PB, oid)) return EC_PARAMS_ID_DSTU4145_M191_PB;
-    if (oid_is_equal(OID_DSTU4145_PARAM_M233_PB, oid)) return EC_PARAMS_ID_DSTU4145_M233_PB;
-    if (oid_is_equal(OID_DSTU4145_PARAM_M173_ONB, oid)) return EC_PARAMS_ID_DSTU4145_M173_ONB;
-    if (oid_is_equal(OID_DSTU4145_PARAM_M179_ONB, oid)) return EC_PARAMS_ID_DSTU4145_M179_ONB;
-    if (oid_is_equal(OID_DSTU4145_PARAM_M191_ONB, oid)) return EC_PARAMS_ID_DSTU4145_M191_ONB;
-    if (oid_is_equal(OID_DSTU4145_PARAM_M233_ONB, oid)) return EC_PARAMS_ID_DSTU4145_M233_ONB;
-    if (oid_is_equal(OID_DSTU4145_PARAM_M431_ONB, oid)) return EC_PARAMS_ID_DSTU4145_M431_ONB;
-    if (oid_is_equal(OID_NIST_P192, oid)) return EC_PARAMS_ID_NIST_P192;
-    if (oid_is_equal(OID_NIST_P224, oid)) return EC_PARAMS_ID_NIST_P224;
-    if (oid_is_equal(OID_NIST_P256, oid)) return EC_PARAMS_ID_NIST_P256;
-    if (oid_is_equal(OID_NIST_P384, oid)) return EC_PARAMS_ID_NIST_P384;
-    if (oid_is_equal(OID_NIST_P521, oid)) return EC_PARAMS_ID_NIST_P521;
-    if (oid_is_equal(OID_NIST_B233, oid)) return EC_PARAMS_ID_NIST_B233;
-    if (oid_is_equal(OID_NIST_B283, oid)) return EC_PARAMS_ID_NIST_B283;
-    if (oid_is_equal(OID_NIST_B409, oid)) return EC_PARAMS_ID_NIST_B409;
-    if (oid_is_equal(OID_NIST_B571, oid)) return EC_PARAMS_ID_NIST_B571;
-    if (oid_is_equal(OID_NIST_K233, oid)) return EC_PARAMS_ID_NIST_K233;
-    if (oid_is_equal(OID_NIST_K283, oid)) return EC_PARAMS_ID_NIST_K283;
-    if (oid_is_equal(OID_NIST_K409, oid)) return EC_PARAMS_ID_NIST_K409;
-    if (oid_is_equal(OID_NIST_K571, oid)) return EC_PARAMS_ID_NIST_K571;
-    if (oid_is_equal(OID_SECP256K1, oid)) return EC_PARAMS_ID_SEC_P256_K1;
-    if (oid_is_equal(OID_BRAINPOOL_P224R1, oid)) return EC_PARAMS_ID_BRAINPOOL_P224_R1;
-    if (oid_is_equal(OID_BRAINPOOL_P256R1, oid)) return EC_PARAMS_ID_BRAINPOOL_P256_R1;
-    if (oid_is_equal(OID_BRAINPOOL_P384R1, oid)) return EC_PARAMS_ID_BRAINPOOL_P384_R1;
-    if (oid_is_equal(OID_BRAINPOOL_P512R1, oid)) return EC_PARAMS_ID_BRAINPOOL_P512_R1;
-    if (oid_is_equal(OID_ECRDSA_256A, oid)) return EC_PARAMS_ID_GOST_P256_A;
-    if (oid_is_equal(OID_ECRDSA_256B, oid)) return EC_PARAMS_ID_GOST_P256_B;
-    if (oid_is_equal(OID_ECRDSA_512A, oid)) return EC_PARAMS_ID_GOST_P512_A;
-    if (oid_is_equal(OID_ECRDSA_512B, oid)) return EC_PARAMS_ID_GOST_P512_B;
-    if (oid_is_equal(OID_SM2DSA_P256, oid)) return EC_PARAMS_ID_SM2_P256;
-    return EC_PARAMS_ID_UNDEFINED;
+    return ecid_from_id(oid_id_from_text(oid));
 }
 
 EcParamsId ecid_from_OID (const OBJECT_IDENTIFIER_t* oid)
 {
-    EcParamsId rv_ecid = EC_PARAMS_ID_UNDEFINED;
-    char* s_oid = NULL;
-    if (asn_oid_to_text(oid, &s_oid) == RET_OK) {
-        rv_ecid = ecid_from_oid(s_oid);
-        free(s_oid);
-    }
-    return rv_ecid;
+    return ecid_from_id(oid_id_from_OID(oid));
 }
 
 const char* hash_to_oid (HashAlg hash)
@@ -214,203 +256,227 @@ const char* hash_to_oid (HashAlg hash)
     }
 }
 
-HashAlg hash_from_oid (const char* oid)
+static HashAlg hash_from_der (const uint8_t* buf, const size_t len)
 {
-    if (oid_is_equal(OID_DSTU7564_256, oid) ||
-        oid_is_parent(OID_DSTU4145_WITH_DSTU7564_256, oid))
+    switch (oid_id_from_der(buf, len)) {
+    case OID_ID_DSTU7564_256:
         return HASH_ALG_DSTU7564_256;
-    if (oid_is_equal(OID_DSTU7564_384, oid) ||
-        oid_is_parent(OID_DSTU4145_WITH_DSTU7564_384, oid))
+    case OID_ID_DSTU7564_384:
         return HASH_ALG_DSTU7564_384;
-    if (oid_is_equal(OID_DSTU7564_512, oid) ||
-        oid_is_parent(OID_DSTU4145_WITH_DSTU7564_512, oid))
+    case OID_ID_DSTU7564_512:
         return HASH_ALG_DSTU7564_512;
-    if (oid_is_equal(OID_GOST34311, oid) ||
-        oid_is_equal(OID_HMAC_GOST34311, oid) ||
-        oid_is_parent(OID_DSTU4145_WITH_GOST3411, oid))
+    case OID_ID_GOST34311:
+    case OID_ID_HMAC_GOST34311:
         return HASH_ALG_GOST34311;
-    if (oid_is_equal(OID_SHA1, oid) ||
-        oid_is_equal(OID_HMAC_SHA1, oid) ||
-        oid_is_equal(OID_ECDSA_WITH_SHA1, oid) ||
-        oid_is_equal(OID_ECKCDSA_WITH_SHA1, oid) ||
-        oid_is_equal(OID_ECGDSA_SIGNATURE_WITH_SHA1, oid) ||
-        oid_is_equal(OID_RSA_WITH_SHA1, oid))
+    case OID_ID_SHA1:
+    case OID_ID_HMAC_SHA1:
+    case OID_ID_ECDSA_WITH_SHA1:
+    case OID_ID_ECKCDSA_WITH_SHA1:
+    case OID_ID_ECGDSA_SIGNATURE_WITH_SHA1:
+    case OID_ID_RSA_WITH_SHA1:
         return HASH_ALG_SHA1;
-    if (oid_is_equal(OID_SHA224, oid) ||
-        oid_is_equal(OID_HMAC_SHA224, oid) ||
-        oid_is_equal(OID_ECDSA_WITH_SHA224, oid) ||
-        oid_is_equal(OID_ECKCDSA_WITH_SHA224, oid) ||
-        oid_is_equal(OID_ECGDSA_SIGNATURE_WITH_SHA224, oid) ||
-        oid_is_equal(OID_RSA_WITH_SHA224, oid))
+    case OID_ID_SHA224:
+    case OID_ID_HMAC_SHA224:
+    case OID_ID_ECDSA_WITH_SHA224:
+    case OID_ID_ECKCDSA_WITH_SHA224:
+    case OID_ID_ECGDSA_SIGNATURE_WITH_SHA224:
+    case OID_ID_RSA_WITH_SHA224:
         return HASH_ALG_SHA224;
-    if (oid_is_equal(OID_SHA256, oid) ||
-        oid_is_equal(OID_HMAC_SHA256, oid) ||
-        oid_is_equal(OID_ECDSA_WITH_SHA256, oid) ||
-        oid_is_equal(OID_ECKCDSA_WITH_SHA256, oid) ||
-        oid_is_equal(OID_ECGDSA_SIGNATURE_WITH_SHA256, oid) ||
-        oid_is_equal(OID_RSA_WITH_SHA256, oid))
+    case OID_ID_SHA256:
+    case OID_ID_HMAC_SHA256:
+    case OID_ID_ECDSA_WITH_SHA256:
+    case OID_ID_ECKCDSA_WITH_SHA256:
+    case OID_ID_ECGDSA_SIGNATURE_WITH_SHA256:
+    case OID_ID_RSA_WITH_SHA256:
         return HASH_ALG_SHA256;
-    if (oid_is_equal(OID_SHA384, oid) ||
-        oid_is_equal(OID_HMAC_SHA384, oid) ||
-        oid_is_equal(OID_ECDSA_WITH_SHA384, oid) ||
-        oid_is_equal(OID_ECGDSA_SIGNATURE_WITH_SHA384, oid) ||
-        oid_is_equal(OID_RSA_WITH_SHA384, oid))
+    case OID_ID_SHA384:
+    case OID_ID_HMAC_SHA384:
+    case OID_ID_ECDSA_WITH_SHA384:
+    case OID_ID_ECGDSA_SIGNATURE_WITH_SHA384:
+    case OID_ID_RSA_WITH_SHA384:
         return HASH_ALG_SHA384;
-    if (oid_is_equal(OID_SHA512, oid) ||
-        oid_is_equal(OID_HMAC_SHA512, oid) ||
-        oid_is_equal(OID_ECDSA_WITH_SHA512, oid) ||
-        oid_is_equal(OID_ECGDSA_SIGNATURE_WITH_SHA512, oid) ||
-        oid_is_equal(OID_RSA_WITH_SHA512, oid))
+    case OID_ID_SHA512:
+    case OID_ID_HMAC_SHA512:
+    case OID_ID_ECDSA_WITH_SHA512:
+    case OID_ID_ECGDSA_SIGNATURE_WITH_SHA512:
+    case OID_ID_RSA_WITH_SHA512:
         return HASH_ALG_SHA512;
-    if (oid_is_equal(OID_SHA3_224, oid) ||
-        oid_is_equal(OID_ECDSA_WITH_SHA3_224, oid) ||
-        oid_is_equal(OID_RSA_WITH_SHA3_224, oid))
+    case OID_ID_SHA3_224:
+    case OID_ID_ECDSA_WITH_SHA3_224:
+    case OID_ID_RSA_WITH_SHA3_224:
         return HASH_ALG_SHA3_224;
-    if (oid_is_equal(OID_SHA3_256, oid) ||
-        oid_is_equal(OID_ECDSA_WITH_SHA3_256, oid) ||
-        oid_is_equal(OID_RSA_WITH_SHA3_256, oid))
+    case OID_ID_SHA3_256:
+    case OID_ID_ECDSA_WITH_SHA3_256:
+    case OID_ID_RSA_WITH_SHA3_256:
         return HASH_ALG_SHA3_256;
-    if (oid_is_equal(OID_SHA3_384, oid) ||
-        oid_is_equal(OID_ECDSA_WITH_SHA3_384, oid) ||
-        oid_is_equal(OID_RSA_WITH_SHA3_384, oid))
+    case OID_ID_SHA3_384:
+    case OID_ID_ECDSA_WITH_SHA3_384:
+    case OID_ID_RSA_WITH_SHA3_384:
         return HASH_ALG_SHA3_384;
-    if (oid_is_equal(OID_SHA3_512, oid) ||
-        oid_is_equal(OID_ECDSA_WITH_SHA3_512, oid) ||
-        oid_is_equal(OID_RSA_WITH_SHA3_512, oid))
+    case OID_ID_SHA3_512:
+    case OID_ID_ECDSA_WITH_SHA3_512:
+    case OID_ID_RSA_WITH_SHA3_512:
         return HASH_ALG_SHA3_512;
-    if (oid_is_equal(OID_SM3, oid) ||
-        oid_is_equal(OID_SM3_ISO, oid) ||
-        oid_is_equal(OID_SM2_WITH_SM3, oid) ||
-        oid_is_equal(OID_RSA_WITH_SM3, oid))
+    case OID_ID_SM3:
+    case OID_ID_SM3_ISO:
+    case OID_ID_SM2_WITH_SM3:
+    case OID_ID_RSA_WITH_SM3:
         return HASH_ALG_SM3;
-    if (oid_is_equal(OID_STREEBOG_256, oid) ||
-        oid_is_equal(OID_GOST_3410_2012_256, oid))
+    case OID_ID_STREEBOG_256:
+    case OID_ID_GOST_3410_2012_256:
         return HASH_ALG_GOSTR3411_2012_256;
-    if (oid_is_equal(OID_STREEBOG_512, oid) ||
-        oid_is_equal(OID_GOST_3410_2012_512, oid))
+    case OID_ID_STREEBOG_512:
+    case OID_ID_GOST_3410_2012_512:
         return HASH_ALG_GOSTR3411_2012_512;
-    if (oid_is_equal(OID_RIPEMD128, oid))
+    case OID_ID_RIPEMD128:
         return HASH_ALG_RIPEMD128;
-    if (oid_is_equal(OID_RIPEMD160, oid) ||
-        oid_is_equal(OID_HMAC_RIPEMD160, oid) ||
-        oid_is_equal(OID_ECGDSA_SIGNATURE_WITH_RIPEMD160, oid))
+    case OID_ID_RIPEMD160:
+    case OID_ID_HMAC_RIPEMD160:
+    case OID_ID_ECGDSA_SIGNATURE_WITH_RIPEMD160:
         return HASH_ALG_RIPEMD160;
-    if (oid_is_equal(OID_MD5, oid) ||
-        oid_is_equal(OID_HMAC_MD5, oid) ||
-        oid_is_equal(OID_RSA_WITH_MD5, oid))
+    case OID_ID_MD5:
+    case OID_ID_HMAC_MD5:
+    case OID_ID_RSA_WITH_MD5:
         return HASH_ALG_MD5;
-    if (oid_is_equal(OID_WHIRLPOOL, oid))
+    case OID_ID_WHIRLPOOL:
         return HASH_ALG_WHIRLPOOL;
+    default:
+        break;
+    }
+
+    //  DSTU 4145 signature algorithms and their descendants
+    if (oid_id_is_parent_der(OID_ID_DSTU4145_WITH_DSTU7564_256, buf, len)) return HASH_ALG_DSTU7564_256;
+    if (oid_id_is_parent_der(OID_ID_DSTU4145_WITH_DSTU7564_384, buf, len)) return HASH_ALG_DSTU7564_384;
+    if (oid_id_is_parent_der(OID_ID_DSTU4145_WITH_DSTU7564_512, buf, len)) return HASH_ALG_DSTU7564_512;
+    if (oid_id_is_parent_der(OID_ID_DSTU4145_WITH_GOST3411, buf, len)) return HASH_ALG_GOST34311;
     return HASH_ALG_UNDEFINED;
 }
 
+HashAlg hash_from_oid (const char* oid)
+{
+    uint8_t der[OID_MAX_DER_LEN];
+    const size_t len = oid_text_to_der(oid, der, sizeof(der));
+    return hash_from_der(der, len);
+}
+
 HashAlg hash_from_OID (const OBJECT_IDENTIFIER_t* oid)
 {
-    HashAlg rv_hashalg = HASH_ALG_UNDEFINED;
-    char* s_oid = NULL;
-    if (asn_oid_to_text(oid, &s_oid) == RET_OK) {
-        rv_hashalg = hash_from_oid(s_oid);
-        free(s_oid);
-    }
-    return rv_hashalg;
+    if (!oid || (oid->size <= 0)) return HASH_ALG_UNDEFINED;
+
+    return hash_from_der(oid->buf, (size_t)oid->size);
 }
 
-SignAlg signature_from_oid (const char* oid)
+static SignAlg signature_from_der (const uint8_t* buf, const size_t len)
 {
-    if (oid_is_parent(OID_DSTU4145_PARAM_PB_LE, oid) ||
-        oid_is_parent(OID_DSTU4145_WITH_DSTU7564, oid)) {
+    const OidId oid_id = oid_id_from_der(buf, len);
+
+    if (oid_id_is_parent_der(OID_ID_DSTU4145_PARAM_PB_LE, buf, len) ||
+        oid_id_is_parent_der(OID_ID_DSTU4145_WITH_DSTU7564, buf, len)) {
         return SIGN_DSTU4145;
     }
 
-    if (oid_is_equal(OID_ECDSA_WITH_SHA1, oid) ||
-        oid_is_parent("1.2.840.10045.4.3", oid) ||
-        oid_is_equal(OID_ECDSA_WITH_SHA3_224, oid) ||
-        oid_is_equal(OID_ECDSA_WITH_SHA3_256, oid) ||
-        oid_is_equal(OID_ECDSA_WITH_SHA3_384, oid) ||
-        oid_is_equal(OID_ECDSA_WITH_SHA3_512, oid)) {
+    if ((oid_id == OID_ID_ECDSA_WITH_SHA1) ||
+        oid_id_is_parent_der(OID_ID_ECDSA_WITH_SHA2, buf, len) ||
+        (oid_id == OID_ID_ECDSA_WITH_SHA3_224) ||
+        (oid_id == OID_ID_ECDSA_WITH_SHA3_256) ||
+        (oid_id == OID_ID_ECDSA_WITH_SHA3_384) ||
+        (oid_id == OID_ID_ECDSA_WITH_SHA3_512)) {
         return SIGN_ECDSA;
     }
 
-    if (oid_is_parent("1.2.410.200004.1.100.4", oid)) {
+    if (oid_id_is_parent_der(OID_ID_ECKCDSA_SIGNATURE, buf, len)) {
         return SIGN_ECKCDSA;
     }
 
-    if (oid_is_parent(OID_ECGDSA_SIGNATURE, oid)) {
+    if (oid_id_is_parent_der(OID_ID_ECGDSA_SIGNATURE, buf, len)) {
         return SIGN_ECGDSA;
     }
 
-    if (oid_is_equal(OID_GOST_3410_2012_256, oid) ||
-        oid_is_equal(OID_GOST_3410_2012_512, oid)) {
+    if ((oid_id == OID_ID_GOST_3410_2012_256) ||
+        (oid_id == OID_ID_GOST_3410_2012_512)) {
         return SIGN_ECRDSA;
     }
 
-    if (oid_is_equal(OID_SM2_WITH_SM3, oid)) {
+    if (oid_id == OID_ID_SM2_WITH_SM3) {
         return SIGN_SM2DSA;
     }
 
-    if (oid_is_parent("1.2.840.113549.1.1", oid) ||
-        oid_is_equal(OID_RSA_WITH_SHA3_224, oid) ||
-        oid_is_equal(OID_RSA_WITH_SHA3_256, oid) ||
-        oid_is_equal(OID_RSA_WITH_SHA3_384, oid) ||
-        oid_is_equal(OID_RSA_WITH_SHA3_512, oid) ||
-        oid_is_equal(OID_RSA_WITH_SM3, oid)) {
+    if (oid_id_is_parent_der(OID_ID_PKCS1, buf, len) ||
+        (oid_id == OID_ID_RSA_WITH_SHA3_224) ||
+        (oid_id == OID_ID_RSA_WITH_SHA3_256) ||
+        (oid_id == OID_ID_RSA_WITH_SHA3_384) ||
+        (oid_id == OID_ID_RSA_WITH_SHA3_512) ||
+        (oid_id == OID_ID_RSA_WITH_SM3)) {
         return SIGN_RSA_PKCS_1_5;
     }
 
-    if (oid_is_equal(OID_RSA_PSS, oid)) {
+    if (oid_id == OID_ID_RSA_PSS) {
         return SIGN_RSA_PSS;
     }
 
     return SIGN_UNDEFINED;
 }
 
+SignAlg signature_from_oid (const char* oid)
+{
+    uint8_t der[OID_MAX_DER_LEN];
+    const size_t len = oid_text_to_der(oid, der, sizeof(der));
+    return signature_from_der(der, len);
+}
+
 SignAlg signature_from_OID (const OBJECT_IDENTIFIER_t* oid)
 {
-    SignAlg rv_signalg = SIGN_UNDEFINED;
-    char* s_oid = NULL;
-    if (asn_oid_to_text(oid, &s_oid) == RET_OK) {
-        rv_signalg = signature_from_oid(s_oid);
-        free(s_oid);
-    }
-    return rv_signalg;
+    if (!oid || (oid->size <= 0)) return SIGN_UNDEFINED;
+
+    return signature_from_der(oid->buf, (size_t)oid->size);
 }
 
 bool OID_is_child_oid (const OBJECT_IDENTIFIER_t* oid, const char* strOidParent)
 {
-    bool is_child = false;
-    char* s_oid = NULL;
-    if (asn_oid_to_text(oid, &s_oid) == RET_OK) {
-        is_child = oid_is_parent(strOidParent, s_oid);
-        free(s_oid);
-    }
-    return is_child;
+    uint8_t der[OID_MAX_DER_LEN];
+    const size_t len = oid_text_to_der(strOidParent, der, sizeof(der));
+    if (!oid || (len == 0) || (oid->size < (int)len)) return false;
+
+    return (memcmp(oid->buf, der, len) == 0);
 }
 
 bool OID_is_equal_oid (const OBJECT_IDENTIFIER_t* oid, const char* strOid)
 {
-    bool is_equal = false;
-    char* s_oid = NULL;
-    if (asn_oid_to_text(oid, &s_oid) == RET_OK) {
-        is_equal = oid_is_equal(strOid, s_oid);
-        free(s_oid);
-    }
-    return is_equal;
+    uint8_t der[OID_MAX_DER_LEN];
+    const size_t len = oid_text_to_der(strOid, der, sizeof(der));
+    if (!oid || (len == 0) || (oid->size != (int)len)) return false;
+
+    return (memcmp(oid->buf, der, len) == 0);
 }
 
 const char* oid_to_rdname (const char* oid)
 {
-    const char* rv_s = oid;
-    if (strcmp(oid,      OID_X520_CommonName            ) == 0) rv_s = "CN";
-    else if (strcmp(oid, OID_X520_Surname               ) == 0) rv_s = "SN";
-    else if (strcmp(oid, OID_X520_SerialNumber          ) == 0) rv_s = "SERIALNUMBER";
-    else if (strcmp(oid, OID_X520_Country               ) == 0) rv_s = "C";
-    else if (strcmp(oid, OID_X520_Locality              ) == 0) rv_s = "L";
-    else if (strcmp(oid, OID_X520_State                 ) == 0) rv_s = "S";
-    else if (strcmp(oid, OID_X520_StreetAddress         ) == 0) rv_s = "STREET";
-    else if (strcmp(oid, OID_X520_Organization          ) == 0) rv_s = "O";
-    else if (strcmp(oid, OID_X520_OrganizationalUnit    ) == 0) rv_s = "OU";
-    else if (strcmp(oid, OID_X520_Title                 ) == 0) rv_s = "TITLE";
-    else if (strcmp(oid, OID_X520_GivenName             ) == 0) rv_s = "G";
-    else if (strcmp(oid, OID_X520_OrganizationIdentifier) == 0) rv_s = "OI";
-    return rv_s;
+    switch (oid_id_from_text(oid)) {
+    case OID_ID_X520_CommonName:
+        return "CN";
+    case OID_ID_X520_Surname:
+        return "SN";
+    case OID_ID_X520_SerialNumber:
+        return "SERIALNUMBER";
+    case OID_ID_X520_Country:
+        return "C";
+    case OID_ID_X520_Locality:
+        return "L";
+    case OID_ID_X520_State:
+        return "S";
+    case OID_ID_X520_StreetAddress:
+        return "STREET";
+    case OID_ID_X520_Organization:
+        return "O";
+    case OID_ID_X520_OrganizationalUnit:
+        return "OU";
+    case OID_ID_X520_Title:
+        return "TITLE";
+    case OID_ID_X520_GivenName:
+        return "G";
+    case OID_ID_X520_OrganizationIdentifier:
+        return "OI";
+    default:
+        return oid;
+    }
 }
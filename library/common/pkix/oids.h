@@ -212,6 +212,7 @@ DEFINE_OID(OID_DSTU4145_WITH_DSTU7564_512_PB,   "1.2.804.2.1.1.1.1.3.6.3.1");
 //EC-DSA
 DEFINE_OID(OID_EC_KEY,              "1.2.840.10045.2.1");
 DEFINE_OID(OID_ECDSA_WITH_SHA1,     "1.2.840.10045.4.1");
+DEFINE_OID(OID_ECDSA_WITH_SHA2,     "1.2.840.10045.4.3");
 DEFINE_OID(OID_ECDSA_WITH_SHA224,   "1.2.840.10045.4.3.1");
 DEFINE_OID(OID_ECDSA_WITH_SHA256,   "1.2.840.10045.4.3.2");
 DEFINE_OID(OID_ECDSA_WITH_SHA384,   "1.2.840.10045.4.3.3");
@@ -223,6 +224,7 @@ DEFINE_OID(OID_ECDSA_WITH_SHA3_512, "2.16.840.1.101.3.4.3.12");
 
 //EC-KCDSA
 DEFINE_OID(OID_ECKCDSA,             "1.0.14888.3.0.5");
+DEFINE_OID(OID_ECKCDSA_SIGNATURE,   "1.2.410.200004.1.100.4");
 DEFINE_OID(OID_ECKCDSA_WITH_SHA1,   "1.2.410.200004.1.100.4.3");
 DEFINE_OID(OID_ECKCDSA_WITH_SHA224, "1.2.410.200004.1.100.4.4");
 DEFINE_OID(OID_ECKCDSA_WITH_SHA256, "1.2.410.200004.1.100.4.5");
@@ -249,6 +251,7 @@ DEFINE_OID(OID_SM2,             "1.0.14888.3.0.14");
 DEFINE_OID(OID_SM2_WITH_SM3,    "1.2.156.10197.1.501");
 
 //RSA
+DEFINE_OID(OID_PKCS1,               "1.2.840.113549.1.1");
 DEFINE_OID(OID_RSA,                 "1.2.840.113549.1.1.1");
 DEFINE_OID(OID_RSA_WITH_MD5,        "1.2.840.113549.1.1.4");
 DEFINE_OID(OID_RSA_WITH_SHA1,       "1.2.840.113549.1.1.5");
@@ -188,6 +188,30 @@ cleanup:
     return ret;
 }
 
+int SignedDataBuilder::addSignerInfo (
+        const ByteArray* baSignerInfoEncoded
+)
+{
+    int ret = RET_OK;
+    SignerInfo_t* signer_info = nullptr;
+    SmartBA sba_digestalgo;
+
+    if (!m_SignedData || !baSignerInfoEncoded) return RET_UAPKI_INVALID_PARAMETER;
+
+    CHECK_NOT_NULL(signer_info = (SignerInfo_t*)asn_decode_ba_with_alloc(get_SignerInfo_desc(), baSignerInfoEncoded));
+    //  The digest algorithm is needed to collect digestAlgorithms of SignedData
+    DO(asn_encode_ba(get_AlgorithmIdentifier_desc(), &signer_info->digestAlgorithm, &sba_digestalgo));
+
+    ASN_SET_ADD(&m_SignedData->signerInfos, signer_info);
+    m_SignerInfos.push_back(new SignerInfo(signer_info));
+    m_SignerInfos.back()->m_BaDigestAlgoEncoded = sba_digestalgo.pop();
+    signer_info = nullptr;
+
+cleanup:
+    asn_free(get_SignerInfo_desc(), signer_info);
+    return ret;
+}
+
 SignedDataBuilder::SignerInfo* SignedDataBuilder::getSignerInfo (
         const size_t index
 ) const
@@ -559,7 +583,8 @@ cleanup:
 
 
 SignedDataParser::SignedDataParser (void)
-    : m_SignedData(nullptr)
+    : m_Arena(nullptr)
+    , m_SignedData(nullptr)
     , m_Version(0)
     , m_CountSignerInfos(0)
 {
@@ -569,7 +594,7 @@ SignedDataParser::SignedDataParser (void)
 SignedDataParser::~SignedDataParser (void)
 {
     DEBUG_OUTCON(puts("SignedDataParser::~SignedDataParser()"));
-    asn_free(get_SignedData_desc(), m_SignedData);
+    asn_arena_free(m_Arena);
 }
 
 int SignedDataParser::parse (
@@ -577,10 +602,16 @@ int SignedDataParser::parse (
 )
 {
     int ret = RET_OK;
-    ContentInfo_t* cinfo = nullptr;
+    const ContentInfo_t* cinfo = nullptr;
     long version = 0;
 
-    CHECK_NOT_NULL(cinfo = (ContentInfo_t*)asn_decode_ba_with_alloc(get_ContentInfo_desc(), baEncoded));
+    //  Decoded objects are placed into one arena and refer to the own copy of the encoded bytes
+    if (m_Arena || !m_Encoded.set(ba_copy_with_alloc(baEncoded, 0, 0))) {
+        SET_ERROR(RET_UAPKI_INVALID_PARAMETER);
+    }
+    CHECK_NOT_NULL(m_Arena = asn_arena_alloc(ba_get_len(baEncoded) / 2));
+
+    CHECK_NOT_NULL(cinfo = (const ContentInfo_t*)asn_decode_ba_arena_view(get_ContentInfo_desc(), m_Arena, m_Encoded.get()));
 
     if (!OID_is_equal_oid(&cinfo->contentType, OID_PKCS7_SIGNED_DATA)) {
         SET_ERROR(RET_UAPKI_INVALID_CONTENT_INFO);
@@ -590,7 +621,7 @@ int SignedDataParser::parse (
         SET_ERROR(RET_UAPKI_INVALID_CONTENT_INFO);
     }
 
-    CHECK_NOT_NULL(m_SignedData = (SignedData_t*)asn_any2type(&cinfo->content, get_SignedData_desc()));
+    CHECK_NOT_NULL(m_SignedData = (const SignedData_t*)asn_decode_arena_view(get_SignedData_desc(), m_Arena, cinfo->content.buf, (size_t)cinfo->content.size));
 
     //  =version=
     DO(asn_INTEGER2long(&m_SignedData->version, &version));
@@ -627,7 +658,6 @@ int SignedDataParser::parse (
     m_CountSignerInfos = static_cast<size_t>(m_SignedData->signerInfos.list.count);
 
 cleanup:
-    asn_free(get_ContentInfo_desc(), cinfo);
     return ret;
 }
 
@@ -677,7 +707,8 @@ int SignedDataParser::decodeEncapContentInfo (
 
     DO(Util::oidFromAsn1(&encapContentInfo.eContentType, decodedEncapContentInfo.contentType));
     if (encapContentInfo.eContent) {
-        DO(asn_OCTSTRING2ba(encapContentInfo.eContent, &decodedEncapContentInfo.baEncapContent));
+        //  The content is not copied, it lives as long as the parser
+        CHECK_NOT_NULL(decodedEncapContentInfo.baEncapContent = ba_alloc_view(encapContentInfo.eContent->buf, (size_t)encapContentInfo.eContent->size));
     }
 
 cleanup:
@@ -702,8 +733,6 @@ int SignedDataParser::SignerInfo::parse (const SignerInfo_t* signerInfo)
 {
     int ret = RET_OK;
     long version = 0;
-    Attributes_t* signed_attrs = nullptr;
-    Attributes_t* unsigned_attrs = nullptr;
 
     if (!signerInfo) return RET_UAPKI_INVALID_PARAMETER;
 
@@ -744,8 +773,7 @@ int SignedDataParser::SignerInfo::parse (const SignerInfo_t* signerInfo)
         SET_ERROR(RET_UAPKI_GENERAL_ERROR);
     }
     DO(ba_set_byte(m_SignedAttrsEncoded.get(), 0, 0x31));
-    CHECK_NOT_NULL(signed_attrs = (Attributes_t*)asn_decode_ba_with_alloc(get_Attributes_desc(), m_SignedAttrsEncoded.get()));
-    DO(decodeAttributes(*signed_attrs, m_SignedAttrs));
+    DO(decodeAttributes(m_SignedAttrsEncoded.get(), m_SignedAttrs));
     DO(decodeMandatoryAttrs());
 
     //  =signatureAlgorithm=
@@ -760,19 +788,16 @@ int SignedDataParser::SignerInfo::parse (const SignerInfo_t* signerInfo)
         if ((signerInfo->unsignedAttrs->size == 0) || (signerInfo->unsignedAttrs->buf[0] != 0xA1)) {
             SET_ERROR(RET_UAPKI_INVALID_STRUCT);
         }
-        if (!sba_encoded.set(ba_alloc_from_uint8(signerInfo->unsignedAttrs->buf, signerInfo->unsignedAttrs->size))) {
+        //  The walker accepts the IMPLICIT tag, so the attributes are read in place
+        if (!sba_encoded.set(ba_alloc_view(signerInfo->unsignedAttrs->buf, signerInfo->unsignedAttrs->size))) {
             SET_ERROR(RET_UAPKI_GENERAL_ERROR);
         }
-        DO(ba_set_byte(sba_encoded.get(), 0, 0x31));
-        CHECK_NOT_NULL(unsigned_attrs = (Attributes_t*)asn_decode_ba_with_alloc(get_Attributes_desc(), sba_encoded.get()));
-        DO(decodeAttributes(*unsigned_attrs, m_UnsignedAttrs));
+        DO(decodeAttributes(sba_encoded.get(), m_UnsignedAttrs));
     }
 
     m_SignerInfo = signerInfo;
 
 cleanup:
-    asn_free(get_Attributes_desc(), signed_attrs);
-    asn_free(get_Attributes_desc(), unsigned_attrs);
     return ret;
 }
 
@@ -814,6 +839,45 @@ cleanup:
     return ret;
 }
 
+int SignedDataParser::SignerInfo::decodeAttributes (
+        const ByteArray* baEncoded,
+        vector<Attribute>& decodedAttrs
+)
+{
+    int ret = RET_OK;
+    AsnTlvCursor cursor;
+    AsnTlv tlv_attrs, tlv_attr;
+    size_t cnt_attrs = 0;
+
+    //  SET OF Attribute (or its IMPLICIT form) is walked without decoding Attributes_t
+    if (
+        (asn_tlv_read(ba_get_buf_const(baEncoded), ba_get_len(baEncoded), &tlv_attrs) != RET_OK) ||
+        (tlv_attrs.tlv_len != ba_get_len(baEncoded)) ||
+        (asn_tlv_enter(&cursor, &tlv_attrs) != RET_OK)
+    ) {
+        SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+    }
+
+    while (!asn_tlv_cursor_end(&cursor)) {
+        if (asn_tlv_skip(&cursor) != RET_OK) {
+            SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+        }
+        cnt_attrs++;
+    }
+
+    if (cnt_attrs > 0) {
+        decodedAttrs.resize(cnt_attrs);
+        DO(asn_tlv_enter(&cursor, &tlv_attrs));
+        for (size_t i = 0; i < cnt_attrs; i++) {
+            DO(asn_tlv_next(&cursor, &tlv_attr));
+            DO(Util::attributeFromTlv(tlv_attr, decodedAttrs[i]));
+        }
+    }
+
+cleanup:
+    return ret;
+}
+
 int keyIdToSid (
         const ByteArray* baKeyId,
         ByteArray** baSidEncoded
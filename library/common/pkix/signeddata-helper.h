@@ -46,6 +46,8 @@ namespace Pkcs7 {
 
     struct EncapsulatedContentInfo {
         std::string contentType;
+        //  Decoded by SignedDataParser it is a view (ba_alloc_view) of eContent,
+        //  it is valid while the source (the parser) lives and must be copied to be kept longer
         ByteArray*  baEncapContent;
 
         EncapsulatedContentInfo (void)
@@ -75,6 +77,8 @@ namespace Pkcs7 {
             ByteArray*  m_BaSignedAttrsEncoded;
             std::string m_SignAlgo;
 
+            friend class SignedDataBuilder;
+
         public:
             SignerInfo (
                 SignerInfo_t* iSignerInfo
@@ -189,6 +193,10 @@ namespace Pkcs7 {
             const ByteArray* baCrlEncoded
         );
         int addSignerInfo (void);
+        //  Adds the signed SignerInfo as is (e.g. taken from another SignedData)
+        int addSignerInfo (
+            const ByteArray* baSignerInfoEncoded
+        );
         SignerInfo* getSignerInfo (
             const size_t index = 0
         ) const;
@@ -209,7 +217,9 @@ namespace Pkcs7 {
     };  //  end class SignedDataBuilder
 
     class SignedDataParser {
-        SignedData_t*
+        SmartBA     m_Encoded;
+        AsnArena*   m_Arena;
+        const SignedData_t*
                     m_SignedData;
         uint32_t    m_Version;
         std::vector<std::string>
@@ -296,6 +306,10 @@ namespace Pkcs7 {
                 const Attributes_t& attrs,
                 std::vector<Attribute>& decodedAttrs
             );
+            static int decodeAttributes (
+                const ByteArray* baEncoded,
+                std::vector<Attribute>& decodedAttrs
+            );
 
         };  //  end class SignerInfo
 
@@ -31,6 +31,7 @@
 #include "iconv-utils.h"
 #include "macros-internal.h"
 #include "oids.h"
+#include "oid-registry.h"
 #include "oid-utils.h"
 #include "time-util.h"
 #include "uapki-errors.h"
@@ -150,6 +151,60 @@ cleanup:
     return ret;
 }
 
+int Util::attributeFromTlv (
+        const AsnTlv& tlv,
+        Attribute& attr
+)
+{
+    int ret = RET_OK;
+    AsnTlvCursor cursor, cursor_values;
+    AsnTlv tlv_type, tlv_values, tlv_value;
+    OBJECT_IDENTIFIER_t oid;
+
+    //  Attribute ::= SEQUENCE { attrType OBJECT IDENTIFIER, attrValues SET OF AttributeValue }
+    if (
+        (tlv.tag != 0x30) ||
+        (asn_tlv_enter(&cursor, &tlv) != RET_OK) ||
+        (asn_tlv_next(&cursor, &tlv_type) != RET_OK) ||
+        (tlv_type.tag != 0x06) ||
+        (asn_tlv_next(&cursor, &tlv_values) != RET_OK) ||
+        (tlv_values.tag != 0x31) ||
+        !asn_tlv_cursor_end(&cursor) ||
+        (asn_tlv_enter(&cursor_values, &tlv_values) != RET_OK)
+    ) {
+        SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+    }
+
+    //  =attrType=
+    memset(&oid, 0, sizeof(oid));
+    oid.buf = (uint8_t*)tlv_type.value;
+    oid.size = (int)tlv_type.len;
+    DO(oidFromAsn1(&oid, attr.type));
+
+    //  =attrValues=
+    if (!asn_tlv_cursor_end(&cursor_values)) {
+        if (asn_tlv_next(&cursor_values, &tlv_value) != RET_OK) {
+            SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+        }
+        attr.baValues = ba_alloc_from_uint8(tlv_value.tlv, tlv_value.tlv_len);
+        //  Other values are not returned, only their bounds are checked
+        while (!asn_tlv_cursor_end(&cursor_values)) {
+            if (asn_tlv_skip(&cursor_values) != RET_OK) {
+                SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+            }
+        }
+    }
+    else {
+        attr.baValues = ba_alloc();
+    }
+    if (!attr.baValues) {
+        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+    }
+
+cleanup:
+    return ret;
+}
+
 int Util::attributeToAsn1 (
         Attribute_t& asn1,
         const char* type,
@@ -1035,6 +1090,12 @@ int Util::oidFromAsn1 (
         string& sOid
 )
 {
+    const OidId oid_id = oid_id_from_OID(oid);
+    if (oid_id != OID_ID_UNDEFINED) {
+        sOid = string(oid_id_to_text(oid_id));
+        return RET_OK;
+    }
+
     char* s_oid = nullptr;
     const int ret = asn_oid_to_text(oid, &s_oid);
     if ((ret == RET_OK) && s_oid) {
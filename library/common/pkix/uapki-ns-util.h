@@ -60,6 +60,10 @@ namespace Util {
         const Attribute_t& asn1,
         UapkiNS::Attribute& attr
     );
+    int attributeFromTlv (
+        const AsnTlv& tlv,
+        UapkiNS::Attribute& attr
+    );
     int attributeToAsn1 (
         Attribute_t& asn1,
         const char* type,
@@ -30,6 +30,7 @@
 #include "uapki-ns-verify.h"
 #include "dstu4145-params.h"
 #include "macros-internal.h"
+#include "oid-registry.h"
 #include "oid-utils.h"
 #include "uapkif.h"
 #include "uapki-errors.h"
@@ -274,24 +275,27 @@ int Verify::parseSpki (
 {
     int ret = RET_OK;
     SubjectPublicKeyInfo_t* spki = nullptr;
-    char* s_oid = nullptr;
+    OidId oid_keyalgo = OID_ID_UNDEFINED;
 
     CHECK_NOT_NULL(spki = (SubjectPublicKeyInfo_t*)asn_decode_ba_with_alloc(get_SubjectPublicKeyInfo_desc(), baSignerSPKI));
 
-    DO(asn_oid_to_text(&spki->algorithm.algorithm, &s_oid));
     if (spki->algorithm.parameters == NULL) {
         SET_ERROR(RET_UAPKI_INVALID_STRUCT);
     }
 
-    if (oid_is_parent(OID_DSTU4145_WITH_DSTU7564, s_oid) || oid_is_parent(OID_DSTU4145_WITH_GOST3411, s_oid)) {
+    oid_keyalgo = oid_id_from_OID(&spki->algorithm.algorithm);
+    if (
+        OID_is_child_id(&spki->algorithm.algorithm, OID_ID_DSTU4145_WITH_DSTU7564) ||
+        OID_is_child_id(&spki->algorithm.algorithm, OID_ID_DSTU4145_WITH_GOST3411)
+    ) {
         DO(parse_dstu_spki(spki, ecParamsId, baPubkey));
         *keyAlgo = SIGN_DSTU4145;
     }
-    else if (oid_is_equal(OID_EC_KEY, s_oid)) {
+    else if (oid_keyalgo == OID_ID_EC_KEY) {
         DO(parse_ecdsa_spki(spki, ecParamsId, baPubkey));
         *keyAlgo = SIGN_ECDSA;
     }
-    else if (oid_is_equal(OID_RSA, s_oid)) {
+    else if (oid_keyalgo == OID_ID_RSA) {
         DO(parse_rsa_spki(spki, baPubkey, baPubkeyRsaE));
         *keyAlgo = SIGN_RSA_PKCS_1_5;
     }
@@ -301,7 +305,6 @@ int Verify::parseSpki (
 
 cleanup:
     asn_free(get_SubjectPublicKeyInfo_desc(), spki);
-    free(s_oid);
     return ret;
 }
 
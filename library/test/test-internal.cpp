@@ -0,0 +1,4479 @@
+/*
+ * Copyright (c) 2023, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define FILE_MARKER "test/test-internal.cpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <errno.h>
+#include <functional>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#include "test-internal.h"
+#include "asn1-utils.h"
+#include "Attributes.h"
+#include "ba-utils.h"
+#include "BasicOCSPResponse.h"
+#include "byte-array-internal.h"
+#include "CertID.h"
+#include "cert-validator.h"
+#include "Certificate.h"
+#include "CertificateList.h"
+#include "CertificateSerialNumber.h"
+#include "cms-stream-parser.h"
+#include "content-hasher.h"
+#include "crl-refresher.h"
+#include "crl-revocation-view.h"
+#include "crl-stream-parser.h"
+#include "doc-verify.h"
+#include "dstu-ns.h"
+#include "envelopeddata-helper.h"
+#include "extension-helper.h"
+#include "GeneralNames.h"
+#include "global-objects.h"
+#include "http-helper.h"
+#include "INTEGER.h"
+#include "IssuerAndSerialNumber.h"
+#include "KeyIdentifier.h"
+#include "macros-internal.h"
+#include "NetworkAddress.h"
+#include "NumericString.h"
+#include "ocsp-cache.h"
+#include "OCTET_STRING.h"
+#include "oid-registry.h"
+#include "oid-utils.h"
+#include "oids.h"
+#include "parson-helper.h"
+#include "PrintableString.h"
+#include "signeddata-helper.h"
+#include "SignedData.h"
+#include "SignerInfo.h"
+#include "SingleResponse.h"
+#include "store-loader.h"
+#include "SubjectAltName.h"
+#include "TBSCertificate.h"
+#include "time-util.h"
+#include "TSTInfo.h"
+#include "uapki-ns-util.h"
+#include "uapki-errors.h"
+#include "uapkic.h"
+#include "UTF8String.h"
+
+
+using namespace std;
+using namespace UapkiNS;
+
+
+static bool checkFailed (
+        const char* format,
+        ...
+)
+{
+    va_list args;
+    va_start(args, format);
+    printf("FAILED: ");
+    vprintf(format, args);
+    printf("\n");
+    va_end(args);
+    return false;
+}
+
+static string baToString (
+        const ByteArray* ba
+)
+{
+    return ba ? string((const char*)ba_get_buf_const(ba), ba_get_len(ba)) : string();
+}
+
+static bool isEqualBa (
+        const ByteArray* ba1,
+        const ByteArray* ba2
+)
+{
+    //  Both absent values are equal (ba_cmp() returns an error for them)
+    if (!ba1 || !ba2) return (ba1 == ba2);
+    return (ba_cmp(ba1, ba2) == 0);
+}
+
+static bool readSample (
+        const char* fileName,
+        vector<uint8_t>& data
+)
+{
+    data.clear();
+    FILE* f = fopen(fileName, "rb");
+    if (!f) return false;
+
+    uint8_t buf[4096];
+    size_t len;
+    while ((len = fread(buf, 1, sizeof(buf), f)) > 0) {
+        data.insert(data.end(), buf, buf + len);
+    }
+    fclose(f);
+    return !data.empty();
+}
+
+static ByteArray* readSampleBa (
+        const char* fileName
+)
+{
+    vector<uint8_t> data;
+    if (!fileName || !readSample(fileName, data)) return nullptr;
+    return ba_alloc_from_uint8(data.data(), data.size());
+}
+
+static vector<size_t> getChunkSizes (
+        JSON_Object* joParams,
+        const size_t sizeSample
+)
+{
+    //  Size 0 means the whole sample at once
+    vector<size_t> rv_sizes;
+    JSON_Array* ja_sizes = json_object_get_array(joParams, "chunkSizes");
+    for (size_t i = 0; i < json_array_get_count(ja_sizes); i++) {
+        const size_t size = (size_t)json_array_get_number(ja_sizes, i);
+        rv_sizes.push_back((size > 0) ? size : sizeSample);
+    }
+    if (rv_sizes.empty()) {
+        rv_sizes.push_back(sizeSample);
+    }
+    return rv_sizes;
+}
+
+
+//  =====  CmsStreamParser  =====
+
+struct CmsParsed {
+    string      contentType;
+    uint32_t    version;
+    vector<string>
+                digestAlgorithms;
+    string      encapContentType;
+    string      content;
+    vector<string>
+                certs;
+    vector<string>
+                crls;
+    vector<string>
+                signerInfos;
+    size_t      countRecipientInfos;
+    string      contentEncryptionAlgo;
+    size_t      countUnprotectedAttrs;
+
+    CmsParsed (void)
+        : version(0), countRecipientInfos(0), countUnprotectedAttrs(0) {
+    }
+};  //  end struct CmsParsed
+
+static string signerInfoToString (
+        const Pkcs7::SignedDataParser::SignerInfo& signerInfo
+)
+{
+    //  The values that identify SignerInfo: sid, digest algorithm, signed attributes and signature
+    return baToString(signerInfo.getSidEncoded()) + "|"
+        + signerInfo.getDigestAlgorithm().algorithm + "|"
+        + baToString(signerInfo.getSignedAttrsEncoded()) + "|"
+        + signerInfo.getSignatureAlgorithm().algorithm + "|"
+        + baToString(signerInfo.getSignature());
+}
+
+static int cms_on_content (void* context, const uint8_t* data, const size_t size)
+{
+    ((CmsParsed*)context)->content.append((const char*)data, size);
+    return RET_OK;
+}
+
+static int cms_on_cert (void* context, const ByteArray* baEncoded)
+{
+    ((CmsParsed*)context)->certs.push_back(baToString(baEncoded));
+    return RET_OK;
+}
+
+static int cms_on_crl (void* context, const ByteArray* baEncoded)
+{
+    ((CmsParsed*)context)->crls.push_back(baToString(baEncoded));
+    return RET_OK;
+}
+
+static int cms_on_signerinfo (void* context, const Pkcs7::SignedDataParser::SignerInfo& signerInfo)
+{
+    ((CmsParsed*)context)->signerInfos.push_back(signerInfoToString(signerInfo));
+    return RET_OK;
+}
+
+static int cms_on_recipientinfo (void* context, const RecipientInfo_t& recipientInfo)
+{
+    (void)recipientInfo;
+    ((CmsParsed*)context)->countRecipientInfos++;
+    return RET_OK;
+}
+
+static int parseCmsByStream (
+        const vector<uint8_t>& data,
+        const size_t sizeFed,
+        const size_t chunkSize,
+        CmsParsed& parsed
+)
+{
+    Pkcs7::CmsStreamParser::Callbacks callbacks;
+    callbacks.context = &parsed;
+    callbacks.onContent = cms_on_content;
+    callbacks.onCert = cms_on_cert;
+    callbacks.onCrl = cms_on_crl;
+    callbacks.onSignerInfo = cms_on_signerinfo;
+    callbacks.onRecipientInfo = cms_on_recipientinfo;
+
+    Pkcs7::CmsStreamParser parser(callbacks);
+    for (size_t offset = 0; offset < sizeFed; offset += chunkSize) {
+        const size_t len = (chunkSize < sizeFed - offset) ? chunkSize : (sizeFed - offset);
+        const int ret = parser.update(data.data() + offset, len);
+        if (ret != RET_OK) return ret;
+    }
+    const int ret = parser.final();
+    if (ret != RET_OK) return ret;
+
+    parsed.contentType = parser.getContentType();
+    parsed.version = parser.getVersion();
+    parsed.digestAlgorithms = parser.getDigestAlgorithms();
+    parsed.encapContentType = parser.getEncapContentType();
+    parsed.contentEncryptionAlgo = parser.getContentEncryptionAlgo().algorithm + "|"
+        + baToString(parser.getContentEncryptionAlgo().baParameters);
+    parsed.countUnprotectedAttrs = parser.getUnprotectedAttrs().size();
+    if (parser.getContentSize() != (uint64_t)parsed.content.size()) return RET_UAPKI_INVALID_STRUCT;
+    return RET_OK;
+}
+
+static int parseCmsByParser (
+        const vector<uint8_t>& data,
+        CmsParsed& parsed
+)
+{
+    int ret = RET_OK;
+    SmartBA sba_encoded;
+    if (!sba_encoded.set(ba_alloc_from_uint8(data.data(), data.size()))) return RET_UAPKI_GENERAL_ERROR;
+
+    Pkcs7::SignedDataParser sdata_parser;
+    ret = sdata_parser.parse(sba_encoded.get());
+    if (ret == RET_OK) {
+        parsed.contentType = string(OID_PKCS7_SIGNED_DATA);
+        parsed.version = sdata_parser.getVersion();
+        parsed.digestAlgorithms = sdata_parser.getDigestAlgorithms();
+        parsed.encapContentType = sdata_parser.getEncapContentInfo().contentType;
+        parsed.content = baToString(sdata_parser.getEncapContentInfo().baEncapContent);
+        for (const auto& it : sdata_parser.getCerts()) {
+            parsed.certs.push_back(baToString(it));
+        }
+        for (const auto& it : sdata_parser.getCrls()) {
+            parsed.crls.push_back(baToString(it));
+        }
+        for (size_t i = 0; i < sdata_parser.getCountSignerInfos(); i++) {
+            Pkcs7::SignedDataParser::SignerInfo signer_info;
+            ret = sdata_parser.parseSignerInfo(i, signer_info);
+            if (ret != RET_OK) return ret;
+            parsed.signerInfos.push_back(signerInfoToString(signer_info));
+        }
+        parsed.contentEncryptionAlgo = "|";
+        return RET_OK;
+    }
+    if (ret != RET_UAPKI_INVALID_CONTENT_INFO) return ret;
+
+    Pkcs7::EnvelopedDataParser envdata_parser;
+    ret = envdata_parser.parse(sba_encoded.get());
+    if (ret != RET_OK) return ret;
+
+    const Pkcs7::EncryptedContentInfo& encrypted_contentinfo = envdata_parser.getEncryptedContentInfo();
+    parsed.contentType = string(OID_PKCS7_ENVELOPED_DATA);
+    parsed.version = envdata_parser.getVersion();
+    parsed.encapContentType = encrypted_contentinfo.contentType;
+    parsed.content = baToString(encrypted_contentinfo.baEncryptedContent);
+    for (const auto& it : envdata_parser.getOriginatorCerts()) {
+        parsed.certs.push_back(baToString(it));
+    }
+    for (const auto& it : envdata_parser.getOriginatorCrls()) {
+        parsed.crls.push_back(baToString(it));
+    }
+    parsed.countRecipientInfos = envdata_parser.getRecipientInfoTypes().size();
+    parsed.contentEncryptionAlgo = encrypted_contentinfo.contentEncryptionAlgo.algorithm + "|"
+        + baToString(encrypted_contentinfo.contentEncryptionAlgo.baParameters);
+    parsed.countUnprotectedAttrs = envdata_parser.getUnprotectedAttrs().size();
+    return RET_OK;
+}
+
+static bool compareCmsParsed (
+        const CmsParsed& expected,
+        const CmsParsed& actual
+)
+{
+    if (actual.contentType != expected.contentType) return checkFailed("contentType '%s', expected '%s'", actual.contentType.c_str(), expected.contentType.c_str());
+    if (actual.version != expected.version) return checkFailed("version %u, expected %u", actual.version, expected.version);
+    if (actual.digestAlgorithms != expected.digestAlgorithms) return checkFailed("digestAlgorithms differ");
+    if (actual.encapContentType != expected.encapContentType) return checkFailed("encapContentType differs");
+    if (actual.content != expected.content) return checkFailed("content differs, size %zu, expected %zu", actual.content.size(), expected.content.size());
+    if (actual.certs != expected.certs) return checkFailed("certificates differ, count %zu, expected %zu", actual.certs.size(), expected.certs.size());
+    if (actual.crls != expected.crls) return checkFailed("crls differ, count %zu, expected %zu", actual.crls.size(), expected.crls.size());
+    if (actual.signerInfos != expected.signerInfos) return checkFailed("signerInfos differ, count %zu, expected %zu", actual.signerInfos.size(), expected.signerInfos.size());
+    if (actual.countRecipientInfos != expected.countRecipientInfos) return checkFailed("count recipientInfos %zu, expected %zu", actual.countRecipientInfos, expected.countRecipientInfos);
+    if (actual.contentEncryptionAlgo != expected.contentEncryptionAlgo) return checkFailed("contentEncryptionAlgorithm differs");
+    if (actual.countUnprotectedAttrs != expected.countUnprotectedAttrs) return checkFailed("count unprotectedAttrs %zu, expected %zu", actual.countUnprotectedAttrs, expected.countUnprotectedAttrs);
+    return true;
+}
+
+static bool checkVerifyByFile (
+        const char* fileName,
+        const vector<uint8_t>& data
+)
+{
+    //  VerifySignedDoc::parseFile() reads the signature by CmsStreamParser: it must give the same
+    //  SignedData and hash values of the content as parse() with getContent(), without the content itself
+    const Doc::Verify::VerifyOptions verify_options;
+    Doc::Verify::VerifySignedDoc expected(nullptr, nullptr, nullptr, verify_options);
+    Doc::Verify::VerifySignedDoc actual(nullptr, nullptr, nullptr, verify_options);
+    ContentHasher hasher_expected, hasher_actual;
+    SmartBA sba_encoded;
+    if (!sba_encoded.set(ba_alloc_from_uint8(data.data(), data.size()))) return checkFailed("no memory");
+
+    int ret = expected.parse(sba_encoded.get());
+    if (ret == RET_OK) {
+        ret = expected.getContent(hasher_expected);
+    }
+    if (ret != RET_OK) return checkFailed("parse() returned %d", ret);
+    ret = actual.parseFile(fileName, hasher_actual);
+    if (ret != RET_OK) return checkFailed("parseFile() returned %d", ret);
+
+    const Pkcs7::SignedDataParser& sdata_expected = expected.sdataParser;
+    const Pkcs7::SignedDataParser& sdata_actual = actual.sdataParser;
+    if (sdata_actual.getVersion() != sdata_expected.getVersion()) return checkFailed("parseFile(): version differs");
+    if (sdata_actual.getDigestAlgorithms() != sdata_expected.getDigestAlgorithms()) return checkFailed("parseFile(): digestAlgorithms differ");
+    if (sdata_actual.getEncapContentInfo().contentType != sdata_expected.getEncapContentInfo().contentType) return checkFailed("parseFile(): eContentType differs");
+    if (sdata_actual.getEncapContentInfo().baEncapContent) return checkFailed("parseFile(): content is kept");
+    if (sdata_actual.getCerts().size() != sdata_expected.getCerts().size()) return checkFailed("parseFile(): count certificates differs");
+    for (size_t i = 0; i < sdata_expected.getCerts().size(); i++) {
+        if (!isEqualBa(sdata_actual.getCerts()[i], sdata_expected.getCerts()[i])) return checkFailed("parseFile(): certificate %zu differs", i);
+    }
+    if (sdata_actual.getCrls().size() != sdata_expected.getCrls().size()) return checkFailed("parseFile(): count crls differs");
+    for (size_t i = 0; i < sdata_expected.getCrls().size(); i++) {
+        if (!isEqualBa(sdata_actual.getCrls()[i], sdata_expected.getCrls()[i])) return checkFailed("parseFile(): crl %zu differs", i);
+    }
+    if (sdata_actual.getCountSignerInfos() != sdata_expected.getCountSignerInfos()) return checkFailed("parseFile(): count signerInfos differs");
+    for (size_t i = 0; i < sdata_expected.getCountSignerInfos(); i++) {
+        Pkcs7::SignedDataParser::SignerInfo sinfo_expected, sinfo_actual;
+        if (
+            (expected.sdataParser.parseSignerInfo(i, sinfo_expected) != RET_OK) ||
+            (actual.sdataParser.parseSignerInfo(i, sinfo_actual) != RET_OK)
+        ) return checkFailed("can't parse signerInfo %zu", i);
+        if (signerInfoToString(sinfo_actual) != signerInfoToString(sinfo_expected)) return checkFailed("parseFile(): signerInfo %zu differs", i);
+    }
+
+    if (!sdata_expected.getEncapContentInfo().baEncapContent) {
+        if (hasher_actual.isPresent()) return checkFailed("parseFile(): content hasher is set without the content");
+        return true;
+    }
+    if (hasher_actual.getSourceType() != ContentHasher::SourceType::DIGESTS) return checkFailed("parseFile(): content hasher has no digests");
+    for (const auto& it : sdata_expected.getDigestAlgorithms()) {
+        const HashAlg hash_alg = hash_from_oid(it.c_str());
+        if (
+            (hasher_expected.digest(hash_alg) != RET_OK) ||
+            (hasher_actual.digest(hash_alg) != RET_OK)
+        ) return checkFailed("can't digest the content by '%s'", it.c_str());
+        if (!isEqualBa(hasher_actual.getHashValue(), hasher_expected.getHashValue())) return checkFailed("parseFile(): hash value by '%s' differs", it.c_str());
+    }
+    //  Other hash values can't be computed without the content
+    const vector<string>& digest_algos = sdata_expected.getDigestAlgorithms();
+    if (find(digest_algos.begin(), digest_algos.end(), string(OID_SHA512)) == digest_algos.end()) {
+        ret = hasher_actual.digest(HASH_ALG_SHA512);
+        if (ret != RET_UAPKI_UNSUPPORTED_ALG) return checkFailed("parseFile(): digest by absent algorithm returned %d", ret);
+    }
+    return true;
+}
+
+//  Parameters: "files" - ContentInfo with SignedData or EnvelopedData (BER is allowed),
+//  "chunkSizes" - sizes of the chunks that are fed to CmsStreamParser.
+//  The result must be the same as SignedDataParser/EnvelopedDataParser give,
+//  the truncated sample must be rejected by final()
+static bool testCmsStreamParser (
+        JSON_Object* joParams
+)
+{
+    JSON_Array* ja_files = json_object_get_array(joParams, "files");
+    if (json_array_get_count(ja_files) == 0) return checkFailed("no files");
+
+    for (size_t i = 0; i < json_array_get_count(ja_files); i++) {
+        const char* s_file = json_array_get_string(ja_files, i);
+        vector<uint8_t> data;
+        CmsParsed expected;
+        if (!s_file || !readSample(s_file, data)) return checkFailed("can't read file '%s'", s_file ? s_file : "");
+
+        int ret = parseCmsByParser(data, expected);
+        if (ret != RET_OK) return checkFailed("'%s': parser returned %d", s_file, ret);
+
+        for (const auto& chunk_size : getChunkSizes(joParams, data.size())) {
+            CmsParsed actual;
+            ret = parseCmsByStream(data, data.size(), chunk_size, actual);
+            if (ret != RET_OK) return checkFailed("'%s', chunk size %zu: stream parser returned %d", s_file, chunk_size, ret);
+            if (!compareCmsParsed(expected, actual)) return checkFailed("'%s', chunk size %zu", s_file, chunk_size);
+        }
+
+        const size_t truncated_sizes[] = { data.size() - 1, data.size() - 2, data.size() / 2, 1 };
+        for (const auto& size_fed : truncated_sizes) {
+            CmsParsed actual;
+            if (parseCmsByStream(data, size_fed, 1024, actual) == RET_OK) {
+                return checkFailed("'%s': truncated to %zu bytes is accepted", s_file, size_fed);
+            }
+        }
+        if ((expected.contentType == string(OID_PKCS7_SIGNED_DATA)) && !checkVerifyByFile(s_file, data)) {
+            return checkFailed("'%s': verify by file", s_file);
+        }
+        printf("'%s': ok, content type: %s, content size: %zu, certs: %zu, signerInfos: %zu, recipientInfos: %zu\n",
+            s_file, expected.contentType.c_str(), expected.content.size(),
+            expected.certs.size(), expected.signerInfos.size(), expected.countRecipientInfos);
+    }
+    return true;
+}
+
+
+//  =====  ASN.1 fast decoders  =====
+
+struct Asn1Type {
+    const char* name;
+    asn_TYPE_descriptor_t*
+                (*getDesc)(void);
+};  //  end struct Asn1Type
+
+static const Asn1Type ASN1_TYPES[] = {
+    { "Attributes",              get_Attributes_desc },
+    { "BasicOCSPResponse",       get_BasicOCSPResponse_desc },
+    { "Certificate",             get_Certificate_desc },
+    { "CertificateList",         get_CertificateList_desc },
+    { "CertificateSerialNumber", get_CertificateSerialNumber_desc },
+    { "SignedData",              get_SignedData_desc },
+    { "SignerInfo",              get_SignerInfo_desc },
+    { "SingleResponse",          get_SingleResponse_desc },
+    { "TBSCertificate",          get_TBSCertificate_desc },
+    { "TSTInfo",                 get_TSTInfo_desc }
+};
+
+static asn_TYPE_descriptor_t* findAsn1Type (
+        const char* name
+)
+{
+    for (const auto& it : ASN1_TYPES) {
+        if (name && (string(name) == it.name)) return it.getDesc();
+    }
+    return nullptr;
+}
+
+struct Asn1Decoded {
+    int         code;
+    size_t      consumed;
+    void*       st;
+    string      encoded;
+
+    Asn1Decoded (void)
+        : code(RC_FAIL), consumed(0), st(nullptr) {
+    }
+};  //  end struct Asn1Decoded
+
+static void decodeAsn1 (
+        asn_TYPE_descriptor_t* desc,
+        const bool fast,
+        const uint8_t* data,
+        const size_t size,
+        Asn1Decoded& decoded
+)
+{
+    asn_set_fast_decoders(fast);
+    const asn_dec_rval_t rval = ber_decode(nullptr, desc, &decoded.st, data, size);
+    asn_set_fast_decoders(true);
+
+    decoded.code = rval.code;
+    decoded.consumed = rval.consumed;
+    if (decoded.code == RC_OK) {
+        ByteArray* ba_encoded = nullptr;
+        if (asn_encode_ba(desc, decoded.st, &ba_encoded) == RET_OK) {
+            decoded.encoded = baToString(ba_encoded);
+        }
+        ba_free(ba_encoded);
+    }
+}
+
+//  The fast and the generic decoder must give the same result code, consumed size and structure
+static bool compareAsn1Decoders (
+        asn_TYPE_descriptor_t* desc,
+        const uint8_t* data,
+        const size_t size,
+        bool& isDecoded
+)
+{
+    Asn1Decoded fast, generic;
+    decodeAsn1(desc, true, data, size, fast);
+    decodeAsn1(desc, false, data, size, generic);
+
+    bool rv = (fast.code == generic.code);
+    if (rv && (fast.code == RC_OK)) {
+        rv = (fast.consumed == generic.consumed)
+            && asn_equals(desc, fast.st, generic.st)
+            && !fast.encoded.empty()
+            && (fast.encoded == generic.encoded);
+    }
+    isDecoded = (fast.code == RC_OK);
+
+    asn_free(desc, fast.st);
+    asn_free(desc, generic.st);
+    return rv;
+}
+
+//  Parameters: "samples" - array of { "type", "file" }, the type is one of ASN1_TYPES.
+//  Each sample, all its truncated prefixes and all single-byte mutations
+//  (xor 0x01, xor 0x80, 0x00, 0xFF in each position) are decoded by the fast decoders
+//  and by the generic decoder (asn_set_fast_decoders(false)), the results must be the same
+static bool testAsn1FastDecoders (
+        JSON_Object* joParams
+)
+{
+    JSON_Array* ja_samples = json_object_get_array(joParams, "samples");
+    if (json_array_get_count(ja_samples) == 0) return checkFailed("no samples");
+
+    for (size_t i = 0; i < json_array_get_count(ja_samples); i++) {
+        JSON_Object* jo_sample = json_array_get_object(ja_samples, i);
+        const char* s_type = json_object_get_string(jo_sample, "type");
+        const char* s_file = json_object_get_string(jo_sample, "file");
+        asn_TYPE_descriptor_t* desc = findAsn1Type(s_type);
+        vector<uint8_t> data;
+        bool is_decoded = false;
+
+        if (!desc) return checkFailed("unknown type '%s'", s_type ? s_type : "");
+        if (!s_file || !readSample(s_file, data)) return checkFailed("can't read file '%s'", s_file ? s_file : "");
+
+        if (!compareAsn1Decoders(desc, data.data(), data.size(), is_decoded)) {
+            return checkFailed("'%s' (%s): decoders differ", s_file, s_type);
+        }
+        if (!is_decoded) return checkFailed("'%s' (%s): can't decode", s_file, s_type);
+
+        for (size_t size = 0; size < data.size(); size++) {
+            if (!compareAsn1Decoders(desc, data.data(), size, is_decoded)) {
+                return checkFailed("'%s' (%s): decoders differ on truncated to %zu bytes", s_file, s_type, size);
+            }
+            if (is_decoded) return checkFailed("'%s' (%s): truncated to %zu bytes is accepted", s_file, s_type, size);
+        }
+
+        size_t cnt_mutated = 0, cnt_decoded = 0;
+        vector<uint8_t> mutated = data;
+        for (size_t pos = 0; pos < data.size(); pos++) {
+            const uint8_t values[] = {
+                (uint8_t)(data[pos] ^ 0x01), (uint8_t)(data[pos] ^ 0x80), 0x00, 0xFF
+            };
+            for (const auto& value : values) {
+                if (value == data[pos]) continue;
+                mutated[pos] = value;
+                if (!compareAsn1Decoders(desc, mutated.data(), mutated.size(), is_decoded)) {
+                    return checkFailed("'%s' (%s): decoders differ on byte %zu set to 0x%02X", s_file, s_type, pos, value);
+                }
+                cnt_mutated++;
+                if (is_decoded) cnt_decoded++;
+            }
+            mutated[pos] = data[pos];
+        }
+        printf("'%s' (%s): ok, truncated: %zu, mutated: %zu (decoded: %zu)\n",
+            s_file, s_type, data.size(), cnt_mutated, cnt_decoded);
+    }
+    return true;
+}
+
+
+//  =====  ASN.1 arena  =====
+
+static bool encodeAsn1 (
+        asn_TYPE_descriptor_t* desc,
+        const void* st,
+        string& encoded
+)
+{
+    ByteArray* ba_encoded = nullptr;
+    encoded.clear();
+    if (st && (asn_encode_ba(desc, st, &ba_encoded) == RET_OK)) {
+        encoded = baToString(ba_encoded);
+    }
+    ba_free(ba_encoded);
+    return !encoded.empty();
+}
+
+static bool checkArenaCerts (
+        const vector<const Certificate_t*>& certs,
+        const string& expected
+)
+{
+    for (const auto& it : certs) {
+        string encoded;
+        if (!encodeAsn1(get_Certificate_desc(), it, encoded) || (encoded != expected)) return false;
+    }
+    return true;
+}
+
+//  A tree decoded into an arena is read-only: asn_free(), FREEMEM and REALLOC of its memory
+//  (the chunks and the source of the view) must leave it intact and must not reach free()/realloc()
+static bool checkArenaMutations (
+        const vector<uint8_t>& data,
+        const bool view,
+        const string& expected
+)
+{
+    AsnArena* arena = asn_arena_alloc(0);
+    if (!arena) return checkFailed("can't alloc arena");
+
+    bool rv = false;
+    const Certificate_t* cert = (const Certificate_t*)(view
+        ? asn_decode_arena_view(get_Certificate_desc(), arena, data.data(), data.size())
+        : asn_decode_arena(get_Certificate_desc(), arena, data.data(), data.size()));
+    Certificate_t* mutable_cert = (Certificate_t*)cert;
+    const Extensions_t* extns = cert ? cert->tbsCertificate.extensions : nullptr;
+    const uint8_t new_value[] = { 0x04, 0x00 };
+    Certificate_t* heap_cert = nullptr;
+    string encoded;
+
+    if (!extns || (extns->list.count == 0)) {
+        checkFailed("can't decode into arena (view: %d) or no extensions", view);
+        goto cleanup;
+    }
+
+    asn_free(get_Certificate_desc(), mutable_cert);
+    thread([mutable_cert]() { asn_free(get_Certificate_desc(), mutable_cert); }).join();
+    if (!checkArenaCerts({ cert }, expected)) {
+        checkFailed("asn_free() changed the arena object (view: %d)", view);
+        goto cleanup;
+    }
+
+    if (asn_bytes2OCTSTRING(&extns->list.array[0]->extnValue, new_value, sizeof(new_value)) == RET_OK) {
+        checkFailed("REALLOC of the arena memory is not rejected (view: %d)", view);
+        goto cleanup;
+    }
+    if (!checkArenaCerts({ cert }, expected)) {
+        checkFailed("rejected REALLOC changed the arena object (view: %d)", view);
+        goto cleanup;
+    }
+
+    //  The supported way: a copy on the heap
+    heap_cert = (Certificate_t*)asn_copy_with_alloc(get_Certificate_desc(), cert);
+    if (
+        !heap_cert ||
+        (asn_bytes2OCTSTRING(&heap_cert->tbsCertificate.extensions->list.array[0]->extnValue, new_value, sizeof(new_value)) != RET_OK) ||
+        !encodeAsn1(get_Certificate_desc(), heap_cert, encoded) ||
+        (encoded == expected) ||
+        !checkArenaCerts({ cert }, expected)
+    ) {
+        checkFailed("can't change the copy of the arena object (view: %d)", view);
+        goto cleanup;
+    }
+
+    //  Contents are freed member by member: every FREEMEM is skipped, the arena is released as usual
+    ASN_FREE(get_Certificate_desc(), mutable_cert);
+    rv = true;
+
+cleanup:
+    asn_free(get_Certificate_desc(), heap_cert);
+    asn_arena_free(arena);
+    return rv;
+}
+
+//  Parameters: "files" - array of certificates (with extensions).
+//  The trees decoded into one arena (copied and as views) must live until the arena is released:
+//  while the arena grows by new chunks and after a failed decoding that rolls the arena back.
+//  The released arena must not affect the heap decoding
+static bool testAsn1Arena (
+        JSON_Object* joParams
+)
+{
+    JSON_Array* ja_files = json_object_get_array(joParams, "files");
+    if (json_array_get_count(ja_files) == 0) return checkFailed("no files");
+
+    for (size_t i = 0; i < json_array_get_count(ja_files); i++) {
+        const char* s_file = json_array_get_string(ja_files, i);
+        vector<uint8_t> data;
+        string expected;
+
+        if (!s_file || !readSample(s_file, data)) return checkFailed("can't read file '%s'", s_file ? s_file : "");
+
+        Certificate_t* cert = (Certificate_t*)asn_decode_with_alloc(get_Certificate_desc(), data.data(), data.size());
+        const bool is_encoded = encodeAsn1(get_Certificate_desc(), cert, expected);
+        asn_free(get_Certificate_desc(), cert);
+        if (!is_encoded) return checkFailed("'%s': can't decode", s_file);
+
+        //  Lifetime
+        AsnArena* arena = asn_arena_alloc(0);
+        if (!arena) return checkFailed("can't alloc arena");
+        vector<const Certificate_t*> certs;
+        bool rv = true;
+        for (size_t j = 0; rv && (j < 32); j++) {
+            const Certificate_t* decoded = (const Certificate_t*)((j % 2)
+                ? asn_decode_arena_view(get_Certificate_desc(), arena, data.data(), data.size())
+                : asn_decode_arena(get_Certificate_desc(), arena, data.data(), data.size()));
+            rv = (decoded != nullptr)
+                && !asn_decode_arena(get_Certificate_desc(), arena, data.data(), data.size() - 1 - j)
+                && !asn_decode_arena_view(get_Certificate_desc(), arena, data.data(), data.size() / 2);
+            certs.push_back(decoded);
+            rv = rv && checkArenaCerts(certs, expected);
+        }
+        asn_arena_free(arena);
+        if (!rv) return checkFailed("'%s': the arena objects are changed by the next decoding", s_file);
+
+        if (!checkArenaMutations(data, false, expected) || !checkArenaMutations(data, true, expected)) {
+            return checkFailed("'%s': the arena object is not protected", s_file);
+        }
+
+        //  Addresses of the released arenas are reused by the heap
+        for (size_t j = 0; j < 100; j++) {
+            cert = (Certificate_t*)asn_decode_with_alloc(get_Certificate_desc(), data.data(), data.size());
+            string encoded;
+            rv = encodeAsn1(get_Certificate_desc(), cert, encoded) && (encoded == expected);
+            asn_free(get_Certificate_desc(), cert);
+            if (!rv) return checkFailed("'%s': heap decoding fails after the arena is released", s_file);
+        }
+        printf("'%s': ok\n", s_file);
+    }
+    return true;
+}
+
+
+//  =====  Zero-copy views  =====
+
+static bool isInside (
+        const void* ptr,
+        const vector<uint8_t>& data
+)
+{
+    const uint8_t* p = (const uint8_t*)ptr;
+    return (p >= data.data()) && (p < data.data() + data.size());
+}
+
+//  The primitive of the view tree refers to the source, it equals the primitive of the heap tree
+//  without the terminating zero, that is read only with the size
+static bool checkViewPrimitive (
+        const char* name,
+        const uint8_t* viewBuf,
+        const int viewSize,
+        const uint8_t* heapBuf,
+        const int heapSize,
+        const vector<uint8_t>& data
+)
+{
+    if (!isInside(viewBuf, data)) return checkFailed("%s: the view is copied", name);
+    if ((viewSize != heapSize) || (memcmp(viewBuf, heapBuf, (size_t)heapSize) != 0)) return checkFailed("%s: the view differs", name);
+    if (heapBuf[heapSize] != 0) return checkFailed("%s: the heap copy is not terminated by zero", name);
+    if ((viewBuf + viewSize < data.data() + data.size()) && (viewBuf[viewSize] != data[viewBuf + viewSize - data.data()])) {
+        return checkFailed("%s: the view is not followed by the source", name);
+    }
+    return true;
+}
+
+static bool checkViewTree (
+        const vector<uint8_t>& data,
+        const Certificate_t* viewCert,
+        const Certificate_t* heapCert
+)
+{
+    const TBSCertificate_t& view_tbs = viewCert->tbsCertificate;
+    const TBSCertificate_t& heap_tbs = heapCert->tbsCertificate;
+    SmartBA sba_view, sba_heap;
+    char* s_view = nullptr;
+    char* s_heap = nullptr;
+
+    if (
+        !checkViewPrimitive("serialNumber", view_tbs.serialNumber.buf, view_tbs.serialNumber.size,
+            heap_tbs.serialNumber.buf, heap_tbs.serialNumber.size, data) ||
+        !checkViewPrimitive("signature.algorithm", view_tbs.signature.algorithm.buf, view_tbs.signature.algorithm.size,
+            heap_tbs.signature.algorithm.buf, heap_tbs.signature.algorithm.size, data)
+    ) {
+        return false;
+    }
+
+    //  Users of the primitives take the size into account
+    if (
+        (asn_INTEGER2ba(&view_tbs.serialNumber, &sba_view) != RET_OK) ||
+        (asn_INTEGER2ba(&heap_tbs.serialNumber, &sba_heap) != RET_OK) ||
+        !isEqualBa(sba_view.get(), sba_heap.get())
+    ) {
+        return checkFailed("asn_INTEGER2ba() differs for the view");
+    }
+    const bool is_equal_oid = (asn_oid_to_text(&view_tbs.signature.algorithm, &s_view) == RET_OK)
+        && (asn_oid_to_text(&heap_tbs.signature.algorithm, &s_heap) == RET_OK)
+        && (strcmp(s_view, s_heap) == 0);
+    free(s_view);
+    free(s_heap);
+    if (!is_equal_oid) return checkFailed("asn_oid_to_text() differs for the view");
+
+    const AttributeTypeAndValue_t* view_atv = view_tbs.issuer.choice.rdnSequence.list.array[0]->list.array[0];
+    const AttributeTypeAndValue_t* heap_atv = heap_tbs.issuer.choice.rdnSequence.list.array[0]->list.array[0];
+    if (!checkViewPrimitive("issuer value (ANY)", view_atv->value.buf, view_atv->value.size,
+        heap_atv->value.buf, heap_atv->value.size, data)) return false;
+
+    for (int i = 0; i < view_tbs.extensions->list.count; i++) {
+        const OCTET_STRING_t& view_value = view_tbs.extensions->list.array[i]->extnValue;
+        const OCTET_STRING_t& heap_value = heap_tbs.extensions->list.array[i]->extnValue;
+        if (!checkViewPrimitive("extnValue", view_value.buf, view_value.size, heap_value.buf, heap_value.size, data)) return false;
+        sba_view.clear();
+        sba_heap.clear();
+        if (
+            (asn_OCTSTRING2ba(&view_value, &sba_view) != RET_OK) ||
+            (asn_OCTSTRING2ba(&heap_value, &sba_heap) != RET_OK) ||
+            !isEqualBa(sba_view.get(), sba_heap.get())
+        ) {
+            return checkFailed("asn_OCTSTRING2ba() differs for the view");
+        }
+    }
+
+    //  BIT STRING is copied into the arena
+    if (isInside(viewCert->signature.buf, data)) return checkFailed("BIT STRING is not copied");
+    return true;
+}
+
+//  Character strings are copied into the arena and terminated by zero
+static bool checkViewStrings (void)
+{
+    const vector<uint8_t> data = { 0x0C, 0x03, 'a', 'b', 'c', 'X', 0x13, 0x02, 'U', 'A', 'Y' };
+    AsnArena* arena = asn_arena_alloc(0);
+    if (!arena) return checkFailed("can't alloc arena");
+
+    const UTF8String_t* utf8_str = (const UTF8String_t*)asn_decode_arena_view(get_UTF8String_desc(), arena, data.data(), 6);
+    const PrintableString_t* printable_str = (const PrintableString_t*)asn_decode_arena_view(get_PrintableString_desc(), arena, data.data() + 6, 5);
+    const bool rv = utf8_str && printable_str
+        && !isInside(utf8_str->buf, data) && (utf8_str->size == 3) && (strcmp((const char*)utf8_str->buf, "abc") == 0)
+        && !isInside(printable_str->buf, data) && (printable_str->size == 2) && (strcmp((const char*)printable_str->buf, "UA") == 0);
+    asn_arena_free(arena);
+    return rv ? true : checkFailed("character string is not copied or not terminated by zero");
+}
+
+//  ByteArray view is read-only and does not own the bytes, its copy outlives the source
+static bool checkByteArrayView (
+        const vector<uint8_t>& data
+)
+{
+    vector<uint8_t> source = data;
+    SmartBA sba_view, sba_other, sba_copy;
+    uint8_t value = 0;
+
+    if (!sba_view.set(ba_alloc_view(source.data(), source.size())) || !sba_other.set(ba_alloc_by_len(source.size()))) {
+        return checkFailed("can't alloc ByteArray");
+    }
+    if (!ba_is_view(sba_view.get()) || (ba_get_buf_const(sba_view.get()) != source.data()) || (ba_get_len(sba_view.get()) != source.size())) {
+        return checkFailed("ByteArray view does not refer to the source");
+    }
+    if (
+        (ba_set_byte(sba_view.get(), 0, 0x00) != RET_INVALID_PARAM) ||
+        (ba_set(sba_view.get(), 0x00) != RET_INVALID_PARAM) ||
+        (ba_swap(sba_view.get()) != RET_INVALID_PARAM) ||
+        (ba_xor(sba_view.get(), sba_other.get()) != RET_INVALID_PARAM) ||
+        (ba_copy(sba_other.get(), 0, 0, sba_view.get(), 0) != RET_INVALID_PARAM) ||
+        (ba_change_len(sba_view.get(), 1) != RET_INVALID_PARAM) ||
+        (ba_append(sba_other.get(), 0, 0, sba_view.get()) != RET_INVALID_PARAM) ||
+        (ba_from_uint8(data.data(), 1, sba_view.get()) != RET_INVALID_PARAM)
+    ) {
+        return checkFailed("ByteArray view can be changed");
+    }
+    if ((source != data) || (ba_get_byte(sba_view.get(), 0, &value) != RET_OK) || (value != data[0])) {
+        return checkFailed("the source is changed through ByteArray view");
+    }
+
+    if (!sba_copy.set(ba_copy_with_alloc(sba_view.get(), 0, 0)) || ba_is_view(sba_copy.get())) {
+        return checkFailed("the copy of ByteArray view is a view");
+    }
+    sba_view.clear();
+    source.assign(source.size(), 0x00);
+    source.clear();
+    source.shrink_to_fit();
+    if ((ba_get_len(sba_copy.get()) != data.size()) || (memcmp(ba_get_buf_const(sba_copy.get()), data.data(), data.size()) != 0)) {
+        return checkFailed("the copy of ByteArray view does not outlive the source");
+    }
+    return true;
+}
+
+//  baEncapContent is a view of the parser's own copy of the encoded bytes
+static bool checkEncapContentView (
+        const char* fileName
+)
+{
+    vector<uint8_t> data;
+    if (!readSample(fileName, data)) return checkFailed("can't read file '%s'", fileName);
+
+    SmartBA sba_encoded, sba_content;
+    Pkcs7::SignedDataParser sdata_parser;
+    if (!sba_encoded.set(ba_alloc_from_uint8(data.data(), data.size())) || (sdata_parser.parse(sba_encoded.get()) != RET_OK)) {
+        return checkFailed("'%s': can't parse", fileName);
+    }
+
+    const ByteArray* ba_content = sdata_parser.getEncapContentInfo().baEncapContent;
+    if (!ba_content || !ba_is_view(ba_content) || !sba_content.set(ba_copy_with_alloc(ba_content, 0, 0))) {
+        return checkFailed("'%s': eContent is not a view", fileName);
+    }
+    ba_set(sba_encoded.get(), 0x00);
+    sba_encoded.clear();
+    if (!isEqualBa(ba_content, sba_content.get())) return checkFailed("'%s': eContent refers to the input of parse()", fileName);
+    return true;
+}
+
+//  Parameters: "certificate" - certificate with extensions, "signedData" - CMS SignedData with eContent.
+//  Primitives decoded by asn_decode_arena_view() refer to the source and are not terminated by zero,
+//  character strings and BIT STRING are copied; ByteArray views are read-only and are detached by a copy
+static bool testAsn1Views (
+        JSON_Object* joParams
+)
+{
+    const char* s_certificate = json_object_get_string(joParams, "certificate");
+    const char* s_signeddata = json_object_get_string(joParams, "signedData");
+    vector<uint8_t> data;
+    if (!s_certificate || !readSample(s_certificate, data)) return checkFailed("can't read certificate");
+    if (!s_signeddata) return checkFailed("no signedData");
+
+    AsnArena* arena = asn_arena_alloc(0);
+    if (!arena) return checkFailed("can't alloc arena");
+    Certificate_t* heap_cert = (Certificate_t*)asn_decode_with_alloc(get_Certificate_desc(), data.data(), data.size());
+    const Certificate_t* view_cert = (const Certificate_t*)asn_decode_arena_view(get_Certificate_desc(), arena, data.data(), data.size());
+    bool rv = heap_cert && view_cert && view_cert->tbsCertificate.extensions;
+    if (!rv) {
+        checkFailed("'%s': can't decode or no extensions", s_certificate);
+    }
+    rv = rv && checkViewTree(data, view_cert, heap_cert);
+    asn_free(get_Certificate_desc(), heap_cert);
+    asn_arena_free(arena);
+
+    return rv
+        && checkViewStrings()
+        && checkByteArrayView(data)
+        && checkEncapContentView(s_signeddata);
+}
+
+
+//  =====  Crl::RevocationView  =====
+
+static Crl::CrlItem* loadCrlSample (
+        const char* fileName
+)
+{
+    ByteArray* ba_encoded = readSampleBa(fileName);
+    Crl::CrlItem* crl_item = nullptr;
+    if (!ba_encoded) return nullptr;
+
+    //  On success CrlItem takes ownership of ba_encoded
+    if (Crl::parseCrl(ba_encoded, &crl_item) != RET_OK) {
+        ba_free(ba_encoded);
+        return nullptr;
+    }
+    return crl_item;
+}
+
+static bool checkRevocationStatus (
+        const Crl::RevocationView& view,
+        const uint64_t validateTime,
+        JSON_Object* joCert
+)
+{
+    const char* s_file = json_object_get_string(joCert, "file");
+    const char* s_expectedstatus = json_object_get_string(joCert, "status");
+    const char* s_expectedreason = json_object_get_string(joCert, "crlReason");
+    ByteArray* ba_encoded = readSampleBa(s_file);
+    Cert::CerItem* cer_item = nullptr;
+    if (!ba_encoded) return checkFailed("can't read file '%s'", s_file ? s_file : "");
+    if (Cert::parseCert(ba_encoded, &cer_item) != RET_OK) {
+        ba_free(ba_encoded);
+        return checkFailed("'%s': can't parse certificate", s_file);
+    }
+
+    vector<const Crl::RevokedCertItem*> revoked_items;
+    int ret = view.revokedCerts(cer_item, revoked_items);
+    UapkiNS::CertStatus status = UapkiNS::CertStatus::UNDEFINED;
+    Crl::RevokedCertItem revcert_item;
+    if (ret == RET_OK) {
+        (void)Crl::findRevokedCert(revoked_items, validateTime, status, revcert_item);
+    }
+    for (auto& it : revoked_items) {
+        delete it;
+    }
+    delete cer_item;
+
+    const string s_status = Crl::certStatusToStr(status);
+    const string s_reason = Crl::crlReasonToStr(revcert_item.crlReason);
+    if (ret != RET_OK) return checkFailed("'%s': revokedCerts() returned %d", s_file, ret);
+    if (
+        (s_status != (s_expectedstatus ? s_expectedstatus : "")) ||
+        (s_expectedreason && (s_reason != s_expectedreason))
+    ) return checkFailed("'%s': status %s (%s), expected %s (%s)", s_file, s_status.c_str(), s_reason.c_str(),
+        s_expectedstatus ? s_expectedstatus : "", s_expectedreason ? s_expectedreason : "");
+
+    printf("'%s': ok, status: %s, crlReason: %s\n", s_file, s_status.c_str(), s_reason.c_str());
+    return true;
+}
+
+static bool checkRevocationView (
+        JSON_Object* joParams,
+        vector<Crl::CrlItem*>& crlItems
+)
+{
+    const char* s_fullcrl = json_object_get_string(joParams, "fullCrl");
+    JSON_Array* ja_deltacrls = json_object_get_array(joParams, "deltaCrls");
+    JSON_Array* ja_certs = json_object_get_array(joParams, "certs");
+    uint64_t validate_time = 0;
+
+    if (TimeUtil::ftimeToMtime(ParsonHelper::jsonObjectGetString(joParams, "validateTime"), validate_time) != RET_OK) {
+        return checkFailed("invalid validateTime");
+    }
+    if (json_array_get_count(ja_certs) == 0) return checkFailed("no certs");
+
+    Crl::CrlItem* full_crl = loadCrlSample(s_fullcrl);
+    if (!full_crl) return checkFailed("can't load full CRL '%s'", s_fullcrl ? s_fullcrl : "");
+    crlItems.push_back(full_crl);
+
+    Crl::RevocationView view(full_crl);
+    for (size_t i = 0; i < json_array_get_count(ja_deltacrls); i++) {
+        const char* s_deltacrl = json_array_get_string(ja_deltacrls, i);
+        Crl::CrlItem* delta_crl = loadCrlSample(s_deltacrl);
+        if (!delta_crl) return checkFailed("can't load delta CRL '%s'", s_deltacrl ? s_deltacrl : "");
+        crlItems.push_back(delta_crl);
+
+        const int ret = view.applyDelta(delta_crl);
+        if (ret != RET_OK) return checkFailed("'%s': applyDelta() returned %d", s_deltacrl, ret);
+    }
+    printf("delta CRL number: %s, count delta entries: %zu\n",
+        view.getDeltaCrlNumber() ? Util::baToHex(view.getDeltaCrlNumber()).c_str() : "", view.getCountDeltaEntries());
+
+    bool rv = true;
+    for (size_t i = 0; i < json_array_get_count(ja_certs); i++) {
+        rv = checkRevocationStatus(view, validate_time, json_array_get_object(ja_certs, i)) && rv;
+    }
+    return rv;
+}
+
+//  Parameters: "fullCrl", "deltaCrls" - delta CRLs in the order of applying, "validateTime",
+//  "certs" - array of { "file", "status", "crlReason" }.
+//  Each delta CRL is cumulative since the full CRL, the status must be resolved by the newest applied
+//  delta CRL only, older delta CRL (applied after the newer one) is skipped
+static bool testCrlRevocationView (
+        JSON_Object* joParams
+)
+{
+    vector<Crl::CrlItem*> crl_items;
+    const bool rv = checkRevocationView(joParams, crl_items);
+    for (auto& it : crl_items) {
+        delete it;
+    }
+    return rv;
+}
+
+
+//  =====  Crl::CrlStreamParser  =====
+
+static int parseCrlByStream (
+        const vector<uint8_t>& data,
+        const size_t sizeFed,
+        const size_t chunkSize,
+        Crl::CrlItem** crlItem
+)
+{
+    Crl::CrlStreamParser parser;
+    for (size_t pos = 0; pos < sizeFed; pos += chunkSize) {
+        const int ret = parser.write(data.data() + pos, (chunkSize < sizeFed - pos) ? chunkSize : sizeFed - pos);
+        if (ret != RET_OK) return ret;
+    }
+    return parser.finish(crlItem);
+}
+
+//  Hash of the encoded tbsCertList by the hash algorithm of signature, nullptr if it is not supported
+static int calcTbsHash (
+        const ByteArray* baEncoded,
+        ByteArray** baTbsHash
+)
+{
+    int ret = RET_OK;
+    CertificateList_t* crl = nullptr;
+    ByteArray* ba_tbs = nullptr;
+    string s_signalgo;
+    HashAlg hash_algo = HASH_ALG_UNDEFINED;
+
+    *baTbsHash = nullptr;
+    CHECK_NOT_NULL(crl = (CertificateList_t*)asn_decode_ba_with_alloc(get_CertificateList_desc(), baEncoded));
+    DO(Util::oidFromAsn1(&crl->signatureAlgorithm.algorithm, s_signalgo));
+    hash_algo = hash_from_oid(s_signalgo.c_str());
+    if (hash_algo != HASH_ALG_UNDEFINED) {
+        DO(asn_encode_ba(get_TBSCertList_desc(), &crl->tbsCertList, &ba_tbs));
+        DO(::hash(hash_algo, ba_tbs, baTbsHash));
+    }
+
+cleanup:
+    asn_free(get_CertificateList_desc(), crl);
+    ba_free(ba_tbs);
+    return ret;
+}
+
+static bool compareCrlItems (
+        const Crl::CrlItem* expected,
+        const Crl::CrlItem* actual
+)
+{
+    if (
+        (expected->getType() != actual->getType()) ||
+        (expected->getVersion() != actual->getVersion()) ||
+        !isEqualBa(expected->getIssuer(), actual->getIssuer()) ||
+        (expected->getThisUpdate() != actual->getThisUpdate()) ||
+        (expected->getNextUpdate() != actual->getNextUpdate()) ||
+        !isEqualBa(expected->getAuthorityKeyId(), actual->getAuthorityKeyId()) ||
+        !isEqualBa(expected->getCrlNumber(), actual->getCrlNumber()) ||
+        !isEqualBa(expected->getDeltaCrl(), actual->getDeltaCrl()) ||
+        !isEqualBa(expected->getCrlId(), actual->getCrlId())
+    ) return checkFailed("fields of CRL differ");
+
+    const Crl::RevocationTable& expected_table = expected->getRevocationTable();
+    const Crl::RevocationTable& actual_table = actual->getRevocationTable();
+    if (expected_table.count() != actual_table.count()) {
+        return checkFailed("count of revoked certs: %zu, expected %zu", actual_table.count(), expected_table.count());
+    }
+    for (size_t i = 0; i < expected_table.count(); i++) {
+        if (
+            (expected_table.getSerialNumberLen(i) != actual_table.getSerialNumberLen(i)) ||
+            (memcmp(expected_table.getSerialNumberBuf(i), actual_table.getSerialNumberBuf(i), expected_table.getSerialNumberLen(i)) != 0) ||
+            (expected_table.getRevocationDate(i) != actual_table.getRevocationDate(i)) ||
+            (expected_table.getInvalidityDate(i) != actual_table.getInvalidityDate(i)) ||
+            (expected_table.getCrlReason(i) != actual_table.getCrlReason(i)) ||
+            (expected_table.isHoldInstruction(i) != actual_table.isHoldInstruction(i))
+        ) return checkFailed("revoked cert %zu differs", i);
+    }
+    return true;
+}
+
+static bool checkCrlStreamOverflow (void)
+{
+    //  CRL header, TBS header, version, signature, issuer, thisUpdate, header of revokedCertificates
+    static const uint8_t HEAD[] = {
+        0x30, 0x84, 0x00, 0x40, 0x00, 0x00,
+        0x30, 0x84, 0x00, 0x3F, 0x00, 0x00,
+        0x02, 0x01, 0x01,
+        0x30, 0x0A, 0x06, 0x08, 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x02,
+        0x30, 0x00,
+        0x17, 0x0D, '2', '3', '0', '1', '0', '1', '0', '0', '0', '0', '0', '0', 'Z',
+        0x30, 0x84, 0x00, 0x3E, 0x00, 0x00
+    };
+    //  The element is rejected by its header, before MAX_ELEMENT_LEN bytes are buffered
+    const size_t vlen = Crl::CrlStreamParser::MAX_ELEMENT_LEN - 4 + 1;
+
+    for (size_t with_entry = 0; with_entry < 2; with_entry++) {
+        Crl::CrlStreamParser parser;
+        //  Revoked entry or crlExtensions (instead of revokedCertificates)
+        const uint8_t elem_header[] = {
+            (uint8_t)(with_entry ? 0x30 : 0xA0), 0x83, (uint8_t)(vlen >> 16), (uint8_t)(vlen >> 8), (uint8_t)vlen
+        };
+        int ret = parser.write(HEAD, with_entry ? sizeof(HEAD) : sizeof(HEAD) - 6);
+        if (ret != RET_OK) return checkFailed("overflow: head is rejected, error %d", ret);
+        ret = parser.write(elem_header, sizeof(elem_header));
+        if ((ret == RET_OK) || !parser.isFailed()) {
+            return checkFailed("overflow: %s of %zu bytes is accepted",
+                with_entry ? "revoked entry" : "field of TBS", sizeof(elem_header) + vlen);
+        }
+    }
+    printf("overflow: ok, element of %zu bytes is rejected\n", (size_t)(Crl::CrlStreamParser::MAX_ELEMENT_LEN + 1));
+    return true;
+}
+
+static bool checkCrlStreamTrailing (
+        const char* fileName,
+        const vector<uint8_t>& data
+)
+{
+    //  Trailing byte in the same chunk and in the next chunk after the end of CRL
+    vector<uint8_t> data_trailing = data;
+    data_trailing.push_back(0x00);
+    for (size_t separate = 0; separate < 2; separate++) {
+        Crl::CrlStreamParser parser;
+        Crl::CrlItem* crl_item = nullptr;
+        int ret = separate ? parser.write(data.data(), data.size()) : RET_OK;
+        if (ret == RET_OK) {
+            ret = separate ? parser.write(&data_trailing.back(), 1) : parser.write(data_trailing.data(), data_trailing.size());
+            if (ret == RET_OK) {
+                ret = parser.finish(&crl_item);
+            }
+        }
+        if (ret == RET_OK) {
+            delete crl_item;
+            return checkFailed("'%s': trailing data %s is accepted", fileName, separate ? "in the next chunk" : "in the same chunk");
+        }
+    }
+    return true;
+}
+
+static bool checkCrlFileBacked (
+        const char* fileName,
+        const vector<uint8_t>& data
+)
+{
+    //  The copy of sample is parsed, then it is replaced by the other content of the same size
+    const string s_tmpfile = string(fileName) + ".tmp";
+    const UapkiNS::AlgorithmIdentifier aid_digest(OID_SHA256);
+    SmartBA sba_encoded, sba_hash, sba_tampered;
+    Crl::CrlItem* crl_item = nullptr;
+    const ByteArray* ba_loaded = nullptr;
+    const UapkiNS::OtherHash* crl_hash = nullptr;
+    bool ok = false;
+    int ret;
+
+    if (
+        !sba_encoded.set(ba_alloc_from_uint8(data.data(), data.size())) ||
+        (::hash(HASH_ALG_SHA256, sba_encoded.get(), &sba_hash) != RET_OK) ||
+        !sba_tampered.set(ba_copy_with_alloc(sba_encoded.get(), 0, 0)) ||
+        (ba_to_file(sba_encoded.get(), s_tmpfile.c_str()) != RET_OK)
+    ) return checkFailed("'%s': can't prepare the copy of file", fileName);
+    ba_get_buf(sba_tampered.get())[data.size() - 1] ^= 0x01;
+
+    //  The same file: the content and the hash are equal to the sample
+    ret = Crl::CrlStreamParser::parseFile(s_tmpfile, &crl_item);
+    if (ret == RET_OK) {
+        crl_item->setDirName(string());
+        crl_item->setFileName(s_tmpfile);
+        ret = crl_item->getEncoded(&ba_loaded);
+        if ((ret == RET_OK) && isEqualBa(ba_loaded, sba_encoded.get())) {
+            ret = crl_item->generateHash(aid_digest, &crl_hash);
+            ok = (ret == RET_OK) && isEqualBa(crl_hash->baHashValue, sba_hash.get());
+        }
+        delete crl_item;
+        crl_item = nullptr;
+    }
+    if (!ok) {
+        delete_file(s_tmpfile.c_str());
+        return checkFailed("'%s': file-backed CRL is not loaded, error %d", fileName, ret);
+    }
+
+    //  The replaced file: error instead of the content, then the restored file is loaded
+    ok = false;
+    ret = Crl::CrlStreamParser::parseFile(s_tmpfile, &crl_item);
+    if (ret == RET_OK) {
+        crl_item->setDirName(string());
+        crl_item->setFileName(s_tmpfile);
+        ba_loaded = nullptr;
+        if (
+            (ba_to_file(sba_tampered.get(), s_tmpfile.c_str()) == RET_OK) &&
+            (crl_item->getEncoded(&ba_loaded) == RET_UAPKI_CRL_NOT_FOUND) && !ba_loaded &&
+            (crl_item->generateHash(aid_digest, &crl_hash) == RET_UAPKI_CRL_NOT_FOUND) &&
+            (ba_to_file(sba_encoded.get(), s_tmpfile.c_str()) == RET_OK)
+        ) {
+            ret = crl_item->getEncoded(&ba_loaded);
+            ok = (ret == RET_OK) && isEqualBa(ba_loaded, sba_encoded.get());
+        }
+        delete crl_item;
+    }
+    delete_file(s_tmpfile.c_str());
+    if (!ok) return checkFailed("'%s': replaced file of CRL is not detected, error %d", fileName, ret);
+    return true;
+}
+
+static bool makeDir (
+        const string& dirName
+)
+{
+#ifdef _WIN32
+    return (_mkdir(dirName.c_str()) == 0) || (errno == EEXIST);
+#else
+    return (mkdir(dirName.c_str(), 0755) == 0) || (errno == EEXIST);
+#endif
+}
+
+static void removeDir (
+        const string& dirName
+)
+{
+#ifdef _WIN32
+    (void)_rmdir(dirName.c_str());
+#else
+    (void)rmdir(dirName.c_str());
+#endif
+}
+
+static bool checkCrlStoreFileBacked (
+        JSON_Array* jaFiles,
+        const string& storeDir
+)
+{
+    vector<string> file_paths;
+    size_t cnt_unique = 0;
+    bool ok = makeDir(storeDir);
+    if (!ok) return checkFailed("can't create directory '%s'", storeDir.c_str());
+
+    //  CRL added to the store with directory is written to the file and is not kept in memory
+    {
+        Crl::CrlStore crl_store;
+        crl_store.setParams(storeDir, true);
+        for (size_t i = 0; ok && (i < json_array_get_count(jaFiles)); i++) {
+            const char* s_file = json_array_get_string(jaFiles, i);
+            ByteArray* ba_encoded = readSampleBa(s_file);
+            SmartBA sba_expected;
+            Crl::CrlItem* crl_item = nullptr;
+            const ByteArray* ba_loaded = nullptr;
+            bool is_unique = false;
+            int ret = (ba_encoded && sba_expected.set(ba_copy_with_alloc(ba_encoded, 0, 0)))
+                ? crl_store.addCrl(ba_encoded, true, is_unique, &crl_item) : RET_UAPKI_FILE_OPEN_ERROR;
+            if (ret != RET_OK) {
+                //  On success CrlStore takes ownership of ba_encoded
+                ba_free(ba_encoded);
+                ok = checkFailed("'%s': addCrl() returned %d", s_file ? s_file : "", ret);
+                break;
+            }
+            if (is_unique) {
+                cnt_unique++;
+                file_paths.push_back(crl_item->getFilePath());
+            }
+            if (!crl_item->isFileBacked()) {
+                ok = checkFailed("'%s': CRL of the store is kept in memory", s_file);
+                break;
+            }
+            ret = crl_item->getEncoded(&ba_loaded);
+            if ((ret != RET_OK) || !isEqualBa(ba_loaded, sba_expected.get())) {
+                ok = checkFailed("'%s': getEncoded() returned %d", s_file, ret);
+            }
+        }
+    }
+
+    //  Loaded store: all CRLs are file-backed (obsolete CRLs are removed by load())
+    if (ok) {
+        Crl::CrlStore crl_store;
+        size_t cnt_loaded = 0;
+        crl_store.setParams(storeDir, true);
+        int ret = crl_store.load();
+        if (ret == RET_OK) {
+            ret = crl_store.getCount(cnt_loaded);
+        }
+        if ((ret != RET_OK) || (cnt_loaded == 0) || (cnt_loaded > cnt_unique)) {
+            ok = checkFailed("load() returned %d, loaded %zu CRLs of %zu", ret, cnt_loaded, cnt_unique);
+        }
+        for (const auto& it : crl_store.getCrlItems()) {
+            if (ok && !it->isFileBacked()) {
+                ok = checkFailed("'%s': loaded CRL is kept in memory", it->getFileName().c_str());
+            }
+        }
+    }
+
+    for (const auto& it : file_paths) {
+        delete_file(it.c_str());
+    }
+    removeDir(storeDir);
+    if (ok) {
+        printf("store '%s': ok, %zu file-backed CRLs\n", storeDir.c_str(), cnt_unique);
+    }
+    return ok;
+}
+
+//  Parameters: "files" - DER-encoded CRLs, "chunkSizes" - sizes of the chunks that are fed to CrlStreamParser.
+//  CrlStreamParser (by parseFile() and by chunks) must give the same fields and revocation table as parseCrl()
+//  and the hash of TBS, the truncated CRL must be rejected by finish(), the trailing data and the element longer
+//  than MAX_ELEMENT_LEN must be rejected, the file-backed CRL must be loaded only from the file that was parsed.
+//  "storeDir" (optional) - temporary directory of CrlStore, CRLs added to it and loaded from it must be file-backed
+static bool testCrlStreamParser (
+        JSON_Object* joParams
+)
+{
+    JSON_Array* ja_files = json_object_get_array(joParams, "files");
+    if (json_array_get_count(ja_files) == 0) return checkFailed("no files");
+
+    for (size_t i = 0; i < json_array_get_count(ja_files); i++) {
+        const char* s_file = json_array_get_string(ja_files, i);
+        Crl::CrlItem* expected = nullptr;
+        Crl::CrlItem* actual = nullptr;
+        ByteArray* ba_encoded = readSampleBa(s_file);
+        ByteArray* ba_tbshash = nullptr;
+        vector<uint8_t> data;
+        bool is_equal = false;
+        int ret;
+
+        if (!ba_encoded || !readSample(s_file, data)) {
+            ba_free(ba_encoded);
+            return checkFailed("can't read file '%s'", s_file ? s_file : "");
+        }
+        ret = calcTbsHash(ba_encoded, &ba_tbshash);
+        if (ret == RET_OK) {
+            ret = Crl::parseCrl(ba_encoded, &expected);
+        }
+        if (ret != RET_OK) {
+            ba_free(ba_encoded);
+            ba_free(ba_tbshash);
+            return checkFailed("'%s': parseCrl() returned %d", s_file, ret);
+        }
+
+        ret = Crl::CrlStreamParser::parseFile(s_file, &actual);
+        if (ret == RET_OK) {
+            is_equal = actual->isFileBacked()
+                && isEqualBa(actual->getTbsHash(), ba_tbshash)
+                && compareCrlItems(expected, actual);
+            delete actual;
+            actual = nullptr;
+        }
+        if ((ret != RET_OK) || !is_equal) {
+            delete expected;
+            ba_free(ba_tbshash);
+            return checkFailed("'%s': parseFile() returned %d", s_file, ret);
+        }
+
+        for (const auto& chunk_size : getChunkSizes(joParams, data.size())) {
+            ret = parseCrlByStream(data, data.size(), chunk_size, &actual);
+            if (ret == RET_OK) {
+                is_equal = isEqualBa(actual->getTbsHash(), ba_tbshash) && compareCrlItems(expected, actual);
+                delete actual;
+                actual = nullptr;
+            }
+            if ((ret != RET_OK) || !is_equal) {
+                delete expected;
+                ba_free(ba_tbshash);
+                return checkFailed("'%s', chunk size %zu: stream parser returned %d", s_file, chunk_size, ret);
+            }
+        }
+
+        //  All prefixes of the small CRL, the head, the tail and each 997th prefix of the big one
+        size_t cnt_truncated = 0;
+        for (size_t size_fed = 0; size_fed < data.size(); size_fed++) {
+            if ((size_fed >= 1024) && (size_fed + 1024 < data.size()) && (size_fed % 997 != 0)) continue;
+            ret = parseCrlByStream(data, size_fed, 4096, &actual);
+            if (ret == RET_OK) {
+                delete actual;
+                delete expected;
+                ba_free(ba_tbshash);
+                return checkFailed("'%s': truncated to %zu bytes is accepted", s_file, size_fed);
+            }
+            cnt_truncated++;
+        }
+
+        if (!checkCrlStreamTrailing(s_file, data) || !checkCrlFileBacked(s_file, data)) {
+            delete expected;
+            ba_free(ba_tbshash);
+            return false;
+        }
+
+        printf("'%s': ok, type: %s, revoked certs: %zu, truncated: %zu, TBS hash: %s\n", s_file,
+            (expected->getType() == Crl::Type::FULL) ? "FULL" : "DELTA", expected->getCountRevokedCerts(), cnt_truncated,
+            ba_tbshash ? Util::baToHex(ba_tbshash).c_str() : "none");
+        delete expected;
+        ba_free(ba_tbshash);
+    }
+
+    if (json_object_has_value_of_type(joParams, "storeDir", JSONString)) {
+        if (!checkCrlStoreFileBacked(ja_files, json_object_get_string(joParams, "storeDir"))) return false;
+    }
+
+    return checkCrlStreamOverflow();
+}
+
+
+
+//  =====  Ocsp::OcspCache, policy  =====
+
+static uint32_t getParamU32 (
+        JSON_Object* joParams,
+        const char* name,
+        const uint32_t defValue
+)
+{
+    return json_object_has_value_of_type(joParams, name, JSONNumber)
+        ? (uint32_t)json_object_get_number(joParams, name) : defValue;
+}
+
+static bool checkOcspValidTime (
+        const Ocsp::OcspCache& ocspCache,
+        JSON_Object* joCase
+)
+{
+    //  Times in seconds
+    const uint64_t ms_thisupdate = (uint64_t)json_object_get_number(joCase, "thisUpdate") * 1000;
+    const uint64_t ms_nextupdate = (uint64_t)json_object_get_number(joCase, "nextUpdate") * 1000;
+    const uint64_t ms_expected = (uint64_t)json_object_get_number(joCase, "validTime") * 1000;
+    const uint64_t ms_valid = ocspCache.getValidTime(ms_thisupdate, ms_nextupdate);
+    if (ms_valid != ms_expected) {
+        return checkFailed("getValidTime(%llu, %llu): %llu, expected %llu",
+            (unsigned long long)ms_thisupdate, (unsigned long long)ms_nextupdate,
+            (unsigned long long)ms_valid, (unsigned long long)ms_expected);
+    }
+
+    bool is_stale = false;
+    if (!ocspCache.isFresh(ms_thisupdate, ms_nextupdate, ms_valid - 1, false, is_stale) || is_stale) {
+        return checkFailed("isFresh() before validTime %llu", (unsigned long long)ms_valid);
+    }
+    if (ocspCache.isFresh(ms_thisupdate, ms_nextupdate, ms_valid, false, is_stale) || !is_stale) {
+        return checkFailed("isFresh() at validTime %llu", (unsigned long long)ms_valid);
+    }
+    return true;
+}
+
+static bool checkOcspBackoff (
+        Ocsp::OcspCache& ocspCache,
+        JSON_Array* jaDelays
+)
+{
+    //  Delays (seconds) after each next failure of the responder
+    const string s_responder = "http://ocsp.test/";
+    uint64_t ms_time = 1000000;
+    for (size_t i = 0; i < json_array_get_count(jaDelays); i++) {
+        const uint64_t ms_delay = (uint64_t)json_array_get_number(jaDelays, i) * 1000;
+        ocspCache.registerFailure(s_responder, ms_time);
+        if ((ms_delay > 0) && !ocspCache.isBackoff(s_responder, ms_time + ms_delay - 1)) {
+            return checkFailed("failure %zu: responder must be in backoff before %llu ms", i + 1, (unsigned long long)ms_delay);
+        }
+        if (ocspCache.isBackoff(s_responder, ms_time + ms_delay)) {
+            return checkFailed("failure %zu: responder must be requested after %llu ms", i + 1, (unsigned long long)ms_delay);
+        }
+        //  Next failure is registered when the responder is requested again
+        ms_time += ms_delay;
+    }
+
+    ocspCache.registerFailure(s_responder, ms_time);
+    ocspCache.registerSuccess(s_responder);
+    if (ocspCache.isBackoff(s_responder, ms_time)) {
+        return checkFailed("registerSuccess() must reset backoff");
+    }
+    return true;
+}
+
+//  Parameters: "policy" - as parameter "ocsp" of INIT (minTtl, maxTtl, useNextUpdate, negativeTtl, negativeTtlMax),
+//  "validTimes" - array of { "thisUpdate", "nextUpdate" (0 - absent), "validTime" } in seconds,
+//  "backoffDelays" - expected delays in seconds after each next failure
+static bool testOcspCachePolicy (
+        JSON_Object* joParams
+)
+{
+    JSON_Object* jo_policy = json_object_get_object(joParams, "policy");
+    JSON_Array* ja_validtimes = json_object_get_array(joParams, "validTimes");
+    LibraryConfig::OcspParams policy;
+    Ocsp::OcspCache ocsp_cache;
+
+    policy.minTtl = getParamU32(jo_policy, "minTtl", LibraryConfig::OcspParams::MIN_TTL_DEFAULT);
+    policy.maxTtl = getParamU32(jo_policy, "maxTtl", LibraryConfig::OcspParams::MAX_TTL_DEFAULT);
+    policy.useNextUpdate = ParsonHelper::jsonObjectGetBoolean(jo_policy, "useNextUpdate", true);
+    policy.negativeTtl = getParamU32(jo_policy, "negativeTtl", LibraryConfig::OcspParams::NEGATIVE_TTL_DEFAULT);
+    policy.negativeTtlMax = getParamU32(jo_policy, "negativeTtlMax", LibraryConfig::OcspParams::NEGATIVE_TTL_MAX_DEFAULT);
+    //  Policy is used without directory of cache
+    ocsp_cache.setParams(string(), policy);
+
+    bool rv = true;
+    for (size_t i = 0; i < json_array_get_count(ja_validtimes); i++) {
+        rv = checkOcspValidTime(ocsp_cache, json_array_get_object(ja_validtimes, i)) && rv;
+    }
+    if (json_object_has_value_of_type(joParams, "backoffDelays", JSONArray)) {
+        rv = checkOcspBackoff(ocsp_cache, json_object_get_array(joParams, "backoffDelays")) && rv;
+    }
+    return rv;
+}
+
+
+
+//  =====  Ocsp::OcspCache, files  =====
+
+static bool loadOcspCacheCerts (
+        JSON_Object* joParams,
+        Cert::CerStore& cerStore,
+        Cert::CerItem** cerIssuer,
+        vector<Cert::CerItem*>& cerSubjects
+)
+{
+    JSON_Array* ja_subjects = json_object_get_array(joParams, "subjects");
+    VectorBA vba_certs;
+    vector<Cert::CerStore::AddedCerItem> added_ceritems;
+
+    vba_certs.push_back(readSampleBa(json_object_get_string(joParams, "issuer")));
+    for (size_t i = 0; i < json_array_get_count(ja_subjects); i++) {
+        vba_certs.push_back(readSampleBa(json_array_get_string(ja_subjects, i)));
+    }
+    for (const auto& it : vba_certs) {
+        if (!it) return checkFailed("can't read certificates");
+    }
+    if (cerStore.addCerts(Cert::NOT_TRUSTED, Cert::NOT_PERMANENT, vba_certs, added_ceritems) != RET_OK) {
+        return checkFailed("can't add certificates");
+    }
+    for (const auto& it : added_ceritems) {
+        if (it.errorCode != RET_OK) return checkFailed("can't parse certificate, error: %d", it.errorCode);
+    }
+
+    *cerIssuer = added_ceritems[0].cerItem;
+    cerSubjects.clear();
+    for (size_t i = 1; i < added_ceritems.size(); i++) {
+        cerSubjects.push_back(added_ceritems[i].cerItem);
+    }
+    return true;
+}
+
+static bool getOcspCertId (
+        const Cert::CerItem* cerIssuer,
+        const Cert::CerItem* cerSubject,
+        ByteArray** baCertId
+)
+{
+    //  Key of OcspCache is CertID of request, as validateByOcsp() gets it
+    Ocsp::OcspHelper ocsp_helper;
+    return (ocsp_helper.init() == RET_OK)
+        && (ocsp_helper.addCert(cerIssuer, cerSubject) == RET_OK)
+        && (ocsp_helper.getRequestCertId(0, baCertId) == RET_OK);
+}
+
+static string getOcspCacheFilePath (
+        const string& dir,
+        const ByteArray* baCertId
+)
+{
+    SmartBA sba_hash;
+    if (::hash(HASH_ALG_SHA256, baCertId, &sba_hash) != RET_OK) return string();
+    return dir + Util::baToHex(sba_hash.get()) + ".ocsp";
+}
+
+static bool checkOcspCacheFormat (
+        const Ocsp::OcspCache& ocspCache,
+        const VectorBA& vbaCertIds,
+        const ByteArray* baResponse
+)
+{
+    const uint64_t ms_now = TimeUtil::mtimeNow();
+    const string s_filepath = getOcspCacheFilePath(ocspCache.getPath(), vbaCertIds[0]);
+    const string s_otherpath = getOcspCacheFilePath(ocspCache.getPath(), vbaCertIds[1]);
+    Ocsp::OcspHelper::SingleResponseInfo single_response;
+    Ocsp::OcspCache::Entry entry;
+    SmartBA sba_entry;
+
+    single_response.certStatus = UapkiNS::CertStatus::GOOD;
+    single_response.msThisUpdate = ms_now;
+    single_response.msNextUpdate = ms_now + 2 * 3600 * 1000;
+
+    //  Round-trip, the name of file is SHA-256 of CertID
+    int ret = ocspCache.save(vbaCertIds[0], single_response, baResponse);
+    if (ret != RET_OK) return checkFailed("save() returned %d", ret);
+    if (ba_alloc_from_file(s_filepath.c_str(), &sba_entry) != RET_OK) {
+        return checkFailed("entry is not saved to '%s'", s_filepath.c_str());
+    }
+    if (
+        !ocspCache.find(vbaCertIds[0], ms_now, entry) ||
+        (entry.certStatus != single_response.certStatus) ||
+        (entry.msThisUpdate != single_response.msThisUpdate) ||
+        (entry.msNextUpdate != single_response.msNextUpdate) ||
+        !isEqualBa(entry.baResponse.get(), baResponse) ||
+        entry.isStale
+    ) return checkFailed("saved entry is not found");
+
+    //  Corrupted entry: magic, version, status, times, lengths, CertID, response, checksum; truncated entry
+    const size_t len_certid = ba_get_len(vbaCertIds[0]);
+    const size_t offsets[] = { 0, 8, 12, 16, 24, 32, 36, 40, 40 + len_certid, sba_entry.size() - 1 };
+    for (const auto& it : offsets) {
+        SmartBA sba_corrupted;
+        if (!sba_corrupted.set(ba_copy_with_alloc(sba_entry.get(), 0, 0))) return checkFailed("no memory");
+        sba_corrupted.buf()[it] ^= 0x01;
+        if ((ba_to_file(sba_corrupted.get(), s_filepath.c_str()) != RET_OK) || ocspCache.find(vbaCertIds[0], ms_now, entry)) {
+            return checkFailed("entry corrupted at offset %zu is found", it);
+        }
+    }
+    {
+        SmartBA sba_truncated;
+        if (
+            !sba_truncated.set(ba_copy_with_alloc(sba_entry.get(), 0, sba_entry.size() - 1)) ||
+            (ba_to_file(sba_truncated.get(), s_filepath.c_str()) != RET_OK) ||
+            ocspCache.find(vbaCertIds[0], ms_now, entry)
+        ) return checkFailed("truncated entry is found");
+    }
+    if ((ba_to_file(sba_entry.get(), s_filepath.c_str()) != RET_OK) || !ocspCache.find(vbaCertIds[0], ms_now, entry)) {
+        return checkFailed("restored entry is not found");
+    }
+
+    //  Entry copied to the name of other CertID
+    if (ba_to_file(sba_entry.get(), s_otherpath.c_str()) != RET_OK) return checkFailed("can't write '%s'", s_otherpath.c_str());
+    const bool is_found = ocspCache.find(vbaCertIds[1], ms_now, entry);
+    delete_file(s_otherpath.c_str());
+    if (is_found) return checkFailed("entry of other CertID is found");
+
+    //  Expiry: valid time by the policy, then stale time
+    const uint64_t ms_valid = ocspCache.getValidTime(single_response.msThisUpdate, single_response.msNextUpdate);
+    if (!ocspCache.find(vbaCertIds[0], ms_valid - 1, entry) || ocspCache.find(vbaCertIds[0], ms_valid, entry)) {
+        return checkFailed("entry must expire at %llu", (unsigned long long)(ms_valid - ms_now));
+    }
+    if (
+        !ocspCache.find(vbaCertIds[0], ms_valid, entry, true) || !entry.isStale ||
+        !ocspCache.isStaleAllowed(ms_valid, ms_valid) || ocspCache.isStaleAllowed(ms_valid, ms_valid + 24 * 3600 * 1000) ||
+        ocspCache.find(vbaCertIds[0], ms_valid + 24 * 3600 * 1000, entry, true)
+    ) return checkFailed("stale entry must be found within staleTtl only");
+
+    delete_file(s_filepath.c_str());
+    printf("format: ok, entry of %zu bytes\n", sba_entry.size());
+    return true;
+}
+
+struct OcspCacheConcurrency {
+    const Ocsp::OcspCache*
+                ocspCache;
+    const ByteArray*
+                baCertId;
+    uint64_t    msThisUpdate;
+    size_t      iterations;
+    atomic<size_t>
+                countHits;
+    atomic<size_t>
+                countErrors;
+};  //  end struct OcspCacheConcurrency
+
+static void ocspCacheWriter (
+        OcspCacheConcurrency* ctx,
+        const size_t index
+)
+{
+    //  Each writer saves its own response: index+1 bytes x 100 of value index, thisUpdate + index
+    Ocsp::OcspHelper::SingleResponseInfo single_response;
+    SmartBA sba_response;
+    if (!sba_response.set(ba_alloc_by_len(100 * (index + 1)))) {
+        ctx->countErrors++;
+        return;
+    }
+    memset(sba_response.buf(), (int)index, sba_response.size());
+    single_response.certStatus = UapkiNS::CertStatus::GOOD;
+    single_response.msThisUpdate = ctx->msThisUpdate + index;
+    for (size_t i = 0; i < ctx->iterations; i++) {
+        if (ctx->ocspCache->save(ctx->baCertId, single_response, sba_response.get()) != RET_OK) {
+            ctx->countErrors++;
+        }
+    }
+}
+
+static void ocspCacheReader (
+        OcspCacheConcurrency* ctx
+)
+{
+    for (size_t i = 0; i < ctx->iterations; i++) {
+        Ocsp::OcspCache::Entry entry;
+        //  On Windows the file is deleted before rename, the entry can be absent for a moment
+        if (!ctx->ocspCache->find(ctx->baCertId, ctx->msThisUpdate, entry)) continue;
+
+        const size_t index = (size_t)(entry.msThisUpdate - ctx->msThisUpdate);
+        const uint8_t* buf = entry.baResponse.buf();
+        bool is_whole = (entry.baResponse.size() == 100 * (index + 1));
+        for (size_t j = 0; is_whole && (j < entry.baResponse.size()); j++) {
+            is_whole = (buf[j] == (uint8_t)index);
+        }
+        if (is_whole) {
+            ctx->countHits++;
+        }
+        else {
+            ctx->countErrors++;
+        }
+    }
+}
+
+static bool checkOcspCacheConcurrency (
+        const Ocsp::OcspCache& ocspCache,
+        const ByteArray* baCertId,
+        JSON_Object* joConcurrent
+)
+{
+    const size_t cnt_writers = getParamU32(joConcurrent, "writers", 4);
+    const size_t cnt_readers = getParamU32(joConcurrent, "readers", 4);
+    OcspCacheConcurrency ctx;
+    vector<thread> threads;
+    vector<string> tmp_files;
+
+    ctx.ocspCache = &ocspCache;
+    ctx.baCertId = baCertId;
+    ctx.msThisUpdate = TimeUtil::mtimeNow();
+    ctx.iterations = getParamU32(joConcurrent, "iterations", 200);
+    ctx.countHits = 0;
+    ctx.countErrors = 0;
+    for (size_t i = 0; i < cnt_writers; i++) {
+        threads.push_back(thread(ocspCacheWriter, &ctx, i));
+    }
+    for (size_t i = 0; i < cnt_readers; i++) {
+        threads.push_back(thread(ocspCacheReader, &ctx));
+    }
+    for (auto& it : threads) {
+        it.join();
+    }
+
+    //  Last saved entry is found, temporary files are renamed or deleted
+    Ocsp::OcspCache::Entry entry;
+    const bool is_found = ocspCache.find(baCertId, ctx.msThisUpdate, entry);
+    (void)StoreLoader::listFiles(ocspCache.getPath(), ".tmp", tmp_files);
+    delete_file(getOcspCacheFilePath(ocspCache.getPath(), baCertId).c_str());
+    if ((ctx.countErrors > 0) || !is_found || !tmp_files.empty()) {
+        return checkFailed("concurrent replace: %zu errors, found: %d, temporary files: %zu",
+            ctx.countErrors.load(), (int)is_found, tmp_files.size());
+    }
+
+    printf("concurrent replace: ok, %zu writers, %zu readers, %zu hits\n", cnt_writers, cnt_readers, ctx.countHits.load());
+    return true;
+}
+
+static bool setOcspCacheProducedAt (
+        ByteArray* baResponse
+)
+{
+    //  The first GeneralizedTime of OCSP-response is producedAt of tbsResponseData: its second is changed
+    uint8_t* buf = ba_get_buf(baResponse);
+    const size_t len = ba_get_len(baResponse);
+    for (size_t i = 0; i + 17 <= len; i++) {
+        if ((buf[i] == 0x18) && (buf[i + 1] == 0x0F) && (buf[i + 16] == 'Z')) {
+            buf[i + 15] = (buf[i + 15] == '0') ? '1' : '0';
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool checkOcspCacheReverifyCase (
+        JSON_Object* joParams,
+        const LibraryConfig& libConfig,
+        const size_t indexSubject,
+        const ByteArray* baResponse,
+        const char* expectedStatus
+)
+{
+    //  Each case has own CerItems: the verified status is kept in CerItem
+    LibraryConfig lib_config = libConfig;
+    Cert::CerStore cer_store;
+    Crl::CrlStore crl_store;
+    CertValidator::CertValidator cert_validator;
+    Cert::CerItem* cer_issuer = nullptr;
+    vector<Cert::CerItem*> cer_subjects;
+    SmartBA sba_certid;
+    Ocsp::OcspHelper::SingleResponseInfo single_response;
+    Ocsp::VerifiedResponse verified_response;
+    CertValidator::ResultValidationByOcsp result_validation;
+    bool is_stale = false;
+
+    if (!loadOcspCacheCerts(joParams, cer_store, &cer_issuer, cer_subjects)) return false;
+    if (!cert_validator.init(&lib_config, &cer_store, &crl_store)) return checkFailed("CertValidator is not initialized");
+    if (!getOcspCertId(cer_issuer, cer_subjects[indexSubject], &sba_certid)) return checkFailed("can't get CertID");
+
+    //  The header of entry is not signed: it claims GOOD and the whole day
+    single_response.certStatus = UapkiNS::CertStatus::GOOD;
+    single_response.msThisUpdate = TimeUtil::mtimeNow();
+    single_response.msNextUpdate = single_response.msThisUpdate + 24 * 3600 * 1000;
+    if (get_ocspcache()->save(sba_certid.get(), single_response, baResponse) != RET_OK) return checkFailed("save() failed");
+
+    const int ret_verify = cert_validator.verifyCachedOcspResponse(sba_certid.get(), baResponse, false, verified_response, is_stale);
+    const int ret = cert_validator.validateByOcsp(cer_subjects[indexSubject], cer_issuer, result_validation);
+    delete_file(getOcspCacheFilePath(get_ocspcache()->getPath(), sba_certid.get()).c_str());
+
+    const Cert::CertStatusInfo& certstatus_info = cer_subjects[indexSubject]->getCertStatusByOcsp();
+    if (!expectedStatus) {
+        //  Rejected entry is the miss of cache: the responder is requested and it is not available
+        if ((ret_verify == RET_OK) || (ret == RET_OK) || certstatus_info.verifiedResponse) {
+            return checkFailed("subject %zu: rejected response is used, errors: %d, %d", indexSubject, ret_verify, ret);
+        }
+        return true;
+    }
+
+    if (
+        (ret_verify != RET_OK) || (ret != RET_OK) ||
+        (string(Crl::certStatusToStr(result_validation.singleResponseInfo.certStatus)) != string(expectedStatus)) ||
+        (certstatus_info.status != result_validation.singleResponseInfo.certStatus) ||
+        !certstatus_info.verifiedResponse ||
+        !isEqualBa(certstatus_info.baResult, baResponse)
+    ) {
+        return checkFailed("subject %zu: status '%s', expected '%s', errors: %d, %d", indexSubject,
+            Crl::certStatusToStr(result_validation.singleResponseInfo.certStatus), expectedStatus, ret_verify, ret);
+    }
+    return true;
+}
+
+static bool checkOcspCacheReverify (
+        JSON_Object* joParams,
+        const LibraryConfig::OcspParams& policy
+)
+{
+    JSON_Array* ja_responses = json_object_get_array(joParams, "responses");
+    JSON_Array* ja_statuses = json_object_get_array(joParams, "statuses");
+    VectorBA vba_responses;
+    LibraryConfig lib_config;
+    bool ok = true;
+
+    for (size_t i = 0; i < json_array_get_count(ja_responses); i++) {
+        vba_responses.push_back(readSampleBa(json_array_get_string(ja_responses, i)));
+        if (!vba_responses.back()) return checkFailed("can't read response %zu", i);
+    }
+    if ((vba_responses.size() < 2) || (json_array_get_count(ja_statuses) != vba_responses.size())) {
+        return checkFailed("responses and statuses of two subjects are expected");
+    }
+
+    //  Responder (URI of certificates) is not available: the status is taken from the cache only
+    lib_config.setOcsp(policy);
+    get_ocspcache()->setParams(get_ocspcache()->getPath(), policy);
+    (void)HttpHelper::init(false, nullptr, nullptr);
+
+    //  Status is taken from the verified response, not from the header of entry
+    for (size_t i = 0; ok && (i < vba_responses.size()); i++) {
+        ok = checkOcspCacheReverifyCase(joParams, lib_config, i, vba_responses[i], json_array_get_string(ja_statuses, i));
+    }
+    //  Response with the changed producedAt: the signature is not valid
+    SmartBA sba_tampered;
+    if (ok && (!sba_tampered.set(ba_copy_with_alloc(vba_responses[0], 0, 0)) || !setOcspCacheProducedAt(sba_tampered.get()))) {
+        ok = checkFailed("can't change producedAt");
+    }
+    ok = ok && checkOcspCacheReverifyCase(joParams, lib_config, 0, sba_tampered.get(), nullptr);
+    //  Response of other certificate saved with CertID of the first one
+    ok = ok && checkOcspCacheReverifyCase(joParams, lib_config, 0, vba_responses[1], nullptr);
+
+    HttpHelper::deinit();
+    if (ok) {
+        printf("re-verification: ok, %zu responses\n", vba_responses.size());
+    }
+    return ok;
+}
+
+//  Parameters: "dir" - temporary directory of cache, "policy" - as parameter "ocsp" of INIT (maxTtl, staleTtl),
+//  "issuer" and "subjects" - certificates, "responses" - OCSP-responses of subjects (responder is included),
+//  "statuses" - their statuses. "format": true - round-trip, corrupted entry, entry of other CertID, expiry;
+//  "concurrent" - { "writers", "readers", "iterations" } - atomic replace of entry; "reverify": true -
+//  the entry is used by CertValidator only after verification of response
+static bool testOcspCacheFiles (
+        JSON_Object* joParams
+)
+{
+    const string s_dir = ParsonHelper::jsonObjectGetString(joParams, "dir");
+    JSON_Object* jo_policy = json_object_get_object(joParams, "policy");
+    LibraryConfig::OcspParams policy;
+    Ocsp::OcspCache& ocsp_cache = *get_ocspcache();
+    Cert::CerStore cer_store;
+    Cert::CerItem* cer_issuer = nullptr;
+    vector<Cert::CerItem*> cer_subjects;
+    VectorBA vba_certids;
+    SmartBA sba_response;
+    bool rv = true;
+
+    if (s_dir.empty() || !makeDir(s_dir)) return checkFailed("can't create directory '%s'", s_dir.c_str());
+    if (!loadOcspCacheCerts(joParams, cer_store, &cer_issuer, cer_subjects) || (cer_subjects.size() < 2)) {
+        removeDir(s_dir);
+        return checkFailed("issuer and two subjects are expected");
+    }
+    for (const auto& it : cer_subjects) {
+        vba_certids.push_back(nullptr);
+        if (!getOcspCertId(cer_issuer, it, &vba_certids.back())) {
+            removeDir(s_dir);
+            return checkFailed("can't get CertID");
+        }
+    }
+
+    policy.nonceLen = 0;
+    policy.maxTtl = getParamU32(jo_policy, "maxTtl", LibraryConfig::OcspParams::MAX_TTL_DEFAULT);
+    policy.staleTtl = getParamU32(jo_policy, "staleTtl", LibraryConfig::OcspParams::STALE_TTL_DEFAULT);
+    //  The cache of library is used, as validateByOcsp() uses it
+    ocsp_cache.setParams(s_dir, policy);
+
+    if (ParsonHelper::jsonObjectGetBoolean(joParams, "format", false)) {
+        rv = sba_response.set(readSampleBa(json_array_get_string(json_object_get_array(joParams, "responses"), 0)))
+            && checkOcspCacheFormat(ocsp_cache, vba_certids, sba_response.get());
+    }
+    if (rv && json_object_has_value_of_type(joParams, "concurrent", JSONObject)) {
+        rv = checkOcspCacheConcurrency(ocsp_cache, vba_certids[0], json_object_get_object(joParams, "concurrent"));
+    }
+    if (rv && ParsonHelper::jsonObjectGetBoolean(joParams, "reverify", false)) {
+        rv = checkOcspCacheReverify(joParams, policy);
+    }
+
+    ocsp_cache.setParams(string(), LibraryConfig::OcspParams());
+    removeDir(s_dir);
+    return rv;
+}
+
+
+
+//  =====  Cert::CertStatusInfo  =====
+
+static bool checkCertStatusInfoSetReset (
+        const ByteArray* baResponse
+)
+{
+    Cert::CertStatusInfo certstatus_info(Cert::ValidationType::OCSP);
+    Ocsp::VerifiedResponse* verified_response = new Ocsp::VerifiedResponse();
+    const uint64_t ms_valid = TimeUtil::mtimeNow() + 3600 * 1000;
+
+    //  set(): baResult is own copy, verifiedResponse is taken
+    verified_response->singleResponseInfo.certStatus = UapkiNS::CertStatus::REVOKED;
+    if (
+        (certstatus_info.set(UapkiNS::CertStatus::REVOKED, ms_valid, baResponse, verified_response) != RET_OK) ||
+        certstatus_info.needUpdate ||
+        (certstatus_info.status != UapkiNS::CertStatus::REVOKED) || (certstatus_info.validTime != ms_valid) ||
+        (certstatus_info.baResult == baResponse) || !isEqualBa(certstatus_info.baResult, baResponse) ||
+        (certstatus_info.verifiedResponse != verified_response)
+    ) return checkFailed("set(): inconsistent state");
+
+    //  set() with own baResult and without outcome: the outcome of previous response is not kept
+    if (
+        (certstatus_info.set(UapkiNS::CertStatus::GOOD, ms_valid, certstatus_info.baResult) != RET_OK) ||
+        !isEqualBa(certstatus_info.baResult, baResponse) || certstatus_info.verifiedResponse ||
+        (certstatus_info.status != UapkiNS::CertStatus::GOOD)
+    ) return checkFailed("set() with own baResult: inconsistent state");
+
+    //  isExpired(): validTime is the last valid time
+    if (certstatus_info.isExpired(ms_valid) || certstatus_info.needUpdate || !certstatus_info.isExpired(ms_valid + 1) || !certstatus_info.needUpdate) {
+        return checkFailed("isExpired(): invalid result");
+    }
+
+    //  set() failed: nothing of the previous state is left, verifiedResponse is deleted
+    if (
+        (certstatus_info.set(UapkiNS::CertStatus::GOOD, ms_valid, nullptr, new Ocsp::VerifiedResponse()) == RET_OK) ||
+        certstatus_info.baResult || certstatus_info.verifiedResponse || (certstatus_info.status != UapkiNS::CertStatus::UNDEFINED)
+    ) return checkFailed("failed set(): inconsistent state");
+
+    //  reset()
+    if (certstatus_info.set(UapkiNS::CertStatus::GOOD, ms_valid, baResponse, new Ocsp::VerifiedResponse()) != RET_OK) {
+        return checkFailed("set() failed");
+    }
+    certstatus_info.reset();
+    if (
+        certstatus_info.baResult || certstatus_info.verifiedResponse ||
+        (certstatus_info.status != UapkiNS::CertStatus::UNDEFINED) || (certstatus_info.validTime != 0)
+    ) return checkFailed("reset(): inconsistent state");
+
+    printf("set/reset: ok\n");
+    return true;
+}
+
+static bool checkCertStatusInfoOutcome (
+        JSON_Object* joParams,
+        const LibraryConfig& libConfig,
+        const size_t indexSubject,
+        const ByteArray* baResponse,
+        const char* expectedStatus
+)
+{
+    LibraryConfig lib_config = libConfig;
+    Cert::CerStore cer_store;
+    Crl::CrlStore crl_store;
+    CertValidator::CertValidator cert_validator;
+    Cert::CerItem* cer_issuer = nullptr;
+    vector<Cert::CerItem*> cer_subjects;
+    SmartBA sba_certid;
+    Ocsp::OcspHelper::SingleResponseInfo single_response;
+    CertValidator::ResultValidationByOcsp result_validation1, result_validation2, result_validation3;
+    bool ok = true;
+
+    if (!loadOcspCacheCerts(joParams, cer_store, &cer_issuer, cer_subjects)) return false;
+    if (!cert_validator.init(&lib_config, &cer_store, &crl_store)) return checkFailed("CertValidator is not initialized");
+    if (!getOcspCertId(cer_issuer, cer_subjects[indexSubject], &sba_certid)) return checkFailed("can't get CertID");
+
+    //  The first validation: response from OCSP-cache is verified and its outcome is kept in CerItem
+    Cert::CerItem* cer_subject = cer_subjects[indexSubject];
+    const Cert::CertStatusInfo& certstatus_info = cer_subject->getCertStatusByOcsp();
+    single_response.certStatus = UapkiNS::CertStatus::GOOD;
+    single_response.msThisUpdate = TimeUtil::mtimeNow();
+    single_response.msNextUpdate = single_response.msThisUpdate + 24 * 3600 * 1000;
+    if (get_ocspcache()->save(sba_certid.get(), single_response, baResponse) != RET_OK) return checkFailed("save() failed");
+    int ret = cert_validator.validateByOcsp(cer_subject, cer_issuer, result_validation1);
+    delete_file(getOcspCacheFilePath(get_ocspcache()->getPath(), sba_certid.get()).c_str());
+    if (
+        (ret != RET_OK) || !certstatus_info.verifiedResponse || certstatus_info.needUpdate ||
+        !isEqualBa(certstatus_info.baResult, baResponse) ||
+        (string(Crl::certStatusToStr(certstatus_info.status)) != string(expectedStatus))
+    ) return checkFailed("subject %zu: outcome is not kept, error: %d", indexSubject, ret);
+
+    //  The second validation: no OCSP-cache entry, no responder - the kept outcome is used as is
+    const Ocsp::VerifiedResponse* verified_response = certstatus_info.verifiedResponse;
+    ret = cert_validator.validateByOcsp(cer_subject, cer_issuer, result_validation2);
+    if (
+        (ret != RET_OK) || (certstatus_info.verifiedResponse != verified_response) ||
+        (result_validation2.singleResponseInfo.certStatus != result_validation1.singleResponseInfo.certStatus) ||
+        (result_validation2.msProducedAt != result_validation1.msProducedAt) ||
+        !isEqualBa(result_validation2.basicOcspResponse.get(), result_validation1.basicOcspResponse.get()) ||
+        !isEqualBa(result_validation2.ocspResponse.get(), baResponse)
+    ) return checkFailed("subject %zu: kept outcome is not used, error: %d", indexSubject, ret);
+
+    //  Kept response is replaced by unparsable one with the same outcome: it is not parsed and not verified again
+    SmartBA sba_garbage;
+    if (!sba_garbage.set(ba_alloc_by_len(16))) return checkFailed("no memory");
+    memset(sba_garbage.buf(), 0xFF, sba_garbage.size());
+    {
+        lock_guard<mutex> lock(cer_subject->getMutex());
+        Cert::CertStatusInfo& rcertstatus_info = cer_subject->getCertStatusByOcsp();
+        Ocsp::VerifiedResponse* verified_copy = new Ocsp::VerifiedResponse();
+        verified_copy->singleResponseInfo = verified_response->singleResponseInfo;
+        verified_copy->msProducedAt = verified_response->msProducedAt;
+        verified_copy->statusSignature = verified_response->statusSignature;
+        ok = verified_copy->baBasicOcspResponse.set(ba_copy_with_alloc(verified_response->baBasicOcspResponse.get(), 0, 0))
+            && (rcertstatus_info.set(rcertstatus_info.status, rcertstatus_info.validTime, sba_garbage.get(), verified_copy) == RET_OK);
+    }
+    if (!ok) return checkFailed("set() failed");
+    ret = cert_validator.validateByOcsp(cer_subject, cer_issuer, result_validation3);
+    if (
+        (ret != RET_OK) ||
+        (result_validation3.singleResponseInfo.certStatus != result_validation1.singleResponseInfo.certStatus) ||
+        !isEqualBa(result_validation3.ocspResponse.get(), sba_garbage.get())
+    ) return checkFailed("subject %zu: kept response is parsed again, error: %d", indexSubject, ret);
+
+    //  Without outcome the kept response is parsed: unparsable one is an error
+    {
+        lock_guard<mutex> lock(cer_subject->getMutex());
+        Cert::CertStatusInfo& rcertstatus_info = cer_subject->getCertStatusByOcsp();
+        ok = (rcertstatus_info.set(rcertstatus_info.status, rcertstatus_info.validTime, sba_garbage.get()) == RET_OK);
+    }
+    CertValidator::ResultValidationByOcsp result_validation4;
+    if (!ok || (cert_validator.validateByOcsp(cer_subject, cer_issuer, result_validation4) == RET_OK)) {
+        return checkFailed("subject %zu: unparsable response without outcome is used", indexSubject);
+    }
+    return true;
+}
+
+//  Parameters: "dir" - temporary directory of OCSP-cache, "issuer" and "subjects" - certificates,
+//  "responses" - OCSP-responses of subjects (responder is included), "statuses" - their statuses
+static bool testCertStatusInfo (
+        JSON_Object* joParams
+)
+{
+    const string s_dir = ParsonHelper::jsonObjectGetString(joParams, "dir");
+    JSON_Array* ja_responses = json_object_get_array(joParams, "responses");
+    JSON_Array* ja_statuses = json_object_get_array(joParams, "statuses");
+    LibraryConfig::OcspParams policy;
+    LibraryConfig lib_config;
+    VectorBA vba_responses;
+    bool rv = true;
+
+    for (size_t i = 0; i < json_array_get_count(ja_responses); i++) {
+        vba_responses.push_back(readSampleBa(json_array_get_string(ja_responses, i)));
+        if (!vba_responses.back()) return checkFailed("can't read response %zu", i);
+    }
+    if (vba_responses.empty() || (json_array_get_count(ja_statuses) != vba_responses.size())) {
+        return checkFailed("responses and their statuses are expected");
+    }
+    if (!checkCertStatusInfoSetReset(vba_responses[0])) return false;
+
+    //  Response gets to CerItem through OCSP-cache, responder (URI of certificates) is not available
+    if (s_dir.empty() || !makeDir(s_dir)) return checkFailed("can't create directory '%s'", s_dir.c_str());
+    policy.nonceLen = 0;
+    policy.maxTtl = 24 * 3600;
+    lib_config.setOcsp(policy);
+    get_ocspcache()->setParams(s_dir, policy);
+    (void)HttpHelper::init(false, nullptr, nullptr);
+
+    for (size_t i = 0; rv && (i < vba_responses.size()); i++) {
+        rv = checkCertStatusInfoOutcome(joParams, lib_config, i, vba_responses[i], json_array_get_string(ja_statuses, i));
+    }
+    if (rv) {
+        printf("kept outcome: ok, %zu responses\n", vba_responses.size());
+    }
+
+    HttpHelper::deinit();
+    get_ocspcache()->setParams(string(), LibraryConfig::OcspParams());
+    removeDir(s_dir);
+    return rv;
+}
+
+
+
+//  =====  StoreLoader  =====
+
+struct ParallelForCounters {
+    vector<atomic<uint32_t>>*
+                calls;
+    mutex       mtx;
+    vector<thread::id>
+                threadIds;
+};  //  end struct ParallelForCounters
+
+static void parallelForCount (
+        void* ctx,
+        const size_t index
+)
+{
+    ParallelForCounters* counters = (ParallelForCounters*)ctx;
+    (*counters->calls)[index]++;
+    lock_guard<mutex> lock(counters->mtx);
+    if (find(counters->threadIds.begin(), counters->threadIds.end(), this_thread::get_id()) == counters->threadIds.end()) {
+        counters->threadIds.push_back(this_thread::get_id());
+    }
+}
+
+static bool checkParallelFor (
+        JSON_Array* jaCounts,
+        JSON_Array* jaWorkers
+)
+{
+    for (size_t i = 0; i < json_array_get_count(jaCounts); i++) {
+        const size_t count = (size_t)json_array_get_number(jaCounts, i);
+        for (size_t j = 0; j < json_array_get_count(jaWorkers); j++) {
+            const size_t max_workers = (size_t)json_array_get_number(jaWorkers, j);
+            vector<atomic<uint32_t>> calls(count);
+            ParallelForCounters counters;
+            counters.calls = &calls;
+            for (auto& it : calls) {
+                it = 0;
+            }
+
+            StoreLoader::parallelFor(count, parallelForCount, &counters, max_workers);
+
+            for (size_t k = 0; k < count; k++) {
+                if (calls[k] != 1) return checkFailed("parallelFor(%zu, workers: %zu): index %zu is called %u times", count, max_workers, k, calls[k].load());
+            }
+            if (counters.threadIds.size() > max(max_workers, (size_t)1)) {
+                return checkFailed("parallelFor(%zu, workers: %zu): %zu threads", count, max_workers, counters.threadIds.size());
+            }
+        }
+    }
+    printf("parallelFor: ok\n");
+    return true;
+}
+
+static bool checkAsnDescriptors (void)
+{
+    //  Derived types get the codecs of base type, NetworkAddress is based on X121Address (NumericString)
+    asn_init_descriptors();
+    if (
+        (get_KeyIdentifier_desc()->free_struct != get_OCTET_STRING_desc()->free_struct) ||
+        (get_KeyIdentifier_desc()->der_encoder != get_OCTET_STRING_desc()->der_encoder) ||
+        (get_CertificateSerialNumber_desc()->ber_decoder != get_INTEGER_desc()->ber_decoder) ||
+        (get_SubjectAltName_desc()->elements != get_GeneralNames_desc()->elements) ||
+        (get_NetworkAddress_desc()->der_encoder != get_NumericString_desc()->der_encoder) ||
+        (get_NetworkAddress_desc()->free_struct != get_NumericString_desc()->free_struct)
+    ) return checkFailed("descriptors of derived types are not filled");
+    printf("descriptors: ok\n");
+    return true;
+}
+
+struct ParallelParseContext {
+    const VectorBA*
+                encoded;
+    vector<Cert::CerItem*>*
+                cerItems;
+    vector<Crl::CrlItem*>*
+                crlItems;
+    atomic<size_t>
+                countErrors;
+};  //  end struct ParallelParseContext
+
+static void parallelParse (
+        void* ctx,
+        const size_t index
+)
+{
+    ParallelParseContext* parse_ctx = (ParallelParseContext*)ctx;
+    const ByteArray* ba_encoded = (*parse_ctx->encoded)[index];
+    int ret = RET_OK;
+
+    if (parse_ctx->cerItems) {
+        Cert::CerItem* cer_item = nullptr;
+        ret = Cert::parseCert(ba_encoded, &cer_item);
+        //  Decoding of the whole certificate on demand is used by parallel threads too
+        if ((ret == RET_OK) && !cer_item->getCert()) {
+            ret = RET_UAPKI_INVALID_STRUCT;
+        }
+        (*parse_ctx->cerItems)[index] = cer_item;
+    }
+    else {
+        Crl::CrlItem* crl_item = nullptr;
+        SmartBA sba_encoded;
+        if (!sba_encoded.set(ba_copy_with_alloc(ba_encoded, 0, 0))) {
+            parse_ctx->countErrors++;
+            return;
+        }
+        ret = Crl::parseCrl(sba_encoded.get(), &crl_item);
+        if (ret == RET_OK) {
+            (void)sba_encoded.set(nullptr);
+        }
+        (*parse_ctx->crlItems)[index] = crl_item;
+    }
+    if (ret != RET_OK) {
+        parse_ctx->countErrors++;
+    }
+}
+
+static bool checkParallelParse (
+        const VectorBA& vbaCerts,
+        const VectorBA& vbaCrls,
+        const size_t repeats,
+        const size_t maxWorkers
+)
+{
+    //  Every sample is parsed repeatedly on parallel threads and compared with serial parsing
+    VectorBA vba_encoded;
+    for (size_t i = 0; i < repeats; i++) {
+        for (const auto& it : vbaCerts) {
+            vba_encoded.push_back(ba_copy_with_alloc(it, 0, 0));
+        }
+    }
+    vector<Cert::CerItem*> cer_items(vba_encoded.size(), nullptr), cer_serial(vbaCerts.size(), nullptr);
+    ParallelParseContext parse_ctx;
+    parse_ctx.encoded = &vba_encoded;
+    parse_ctx.cerItems = &cer_items;
+    parse_ctx.crlItems = nullptr;
+    parse_ctx.countErrors = 0;
+    StoreLoader::parallelFor(vba_encoded.size(), parallelParse, &parse_ctx, maxWorkers);
+    parse_ctx.encoded = &vbaCerts;
+    parse_ctx.cerItems = &cer_serial;
+    StoreLoader::parallelFor(vbaCerts.size(), parallelParse, &parse_ctx, 1);
+
+    bool ok = (parse_ctx.countErrors == 0);
+    for (size_t i = 0; ok && (i < cer_items.size()); i++) {
+        const Cert::CerItem* cer_serialitem = cer_serial[i % vbaCerts.size()];
+        ok = isEqualBa(cer_items[i]->getCertId(), cer_serialitem->getCertId())
+            && isEqualBa(cer_items[i]->getSerialNumber(), cer_serialitem->getSerialNumber())
+            && (cer_items[i]->getNotAfter() == cer_serialitem->getNotAfter())
+            && (cer_items[i]->getKeyAlgo() == cer_serialitem->getKeyAlgo());
+    }
+    for (auto& it : cer_items) delete it;
+    for (auto& it : cer_serial) delete it;
+    if (!ok) return checkFailed("certificates parsed in parallel differ, errors: %zu", parse_ctx.countErrors.load());
+
+    vba_encoded.clear();
+    for (size_t i = 0; i < repeats; i++) {
+        for (const auto& it : vbaCrls) {
+            vba_encoded.push_back(ba_copy_with_alloc(it, 0, 0));
+        }
+    }
+    vector<Crl::CrlItem*> crl_items(vba_encoded.size(), nullptr), crl_serial(vbaCrls.size(), nullptr);
+    parse_ctx.encoded = &vba_encoded;
+    parse_ctx.cerItems = nullptr;
+    parse_ctx.crlItems = &crl_items;
+    StoreLoader::parallelFor(vba_encoded.size(), parallelParse, &parse_ctx, maxWorkers);
+    parse_ctx.encoded = &vbaCrls;
+    parse_ctx.crlItems = &crl_serial;
+    StoreLoader::parallelFor(vbaCrls.size(), parallelParse, &parse_ctx, 1);
+
+    ok = (parse_ctx.countErrors == 0);
+    for (size_t i = 0; ok && (i < crl_items.size()); i++) {
+        const Crl::CrlItem* crl_serialitem = crl_serial[i % vbaCrls.size()];
+        ok = isEqualBa(crl_items[i]->getCrlIdentifier(), crl_serialitem->getCrlIdentifier())
+            && isEqualBa(crl_items[i]->getCrlNumber(), crl_serialitem->getCrlNumber())
+            && (crl_items[i]->getThisUpdate() == crl_serialitem->getThisUpdate())
+            && (crl_items[i]->getCountRevokedCerts() == crl_serialitem->getCountRevokedCerts());
+    }
+    for (auto& it : crl_items) delete it;
+    for (auto& it : crl_serial) delete it;
+    if (!ok) return checkFailed("CRLs parsed in parallel differ, errors: %zu", parse_ctx.countErrors.load());
+
+    printf("parallel parsing: ok, %zu certificates, %zu CRLs, %zu workers\n", vbaCerts.size() * repeats, vbaCrls.size() * repeats, maxWorkers);
+    return true;
+}
+
+static bool checkCerStoreLoad (
+        const VectorBA& vbaCerts,
+        const string& storeDir
+)
+{
+    //  Directory of the store: unique certificates and the copy of each one (it is removed by loading)
+    bool ok = makeDir(storeDir);
+    for (size_t i = 0; ok && (i < vbaCerts.size()); i++) {
+        ok = (ba_to_file(vbaCerts[i], (storeDir + to_string(i) + ".cer").c_str()) == RET_OK)
+            && (ba_to_file(vbaCerts[i], (storeDir + to_string(i) + "-copy.cer").c_str()) == RET_OK);
+    }
+
+    size_t cnt_loaded = 0;
+    if (ok) {
+        Cert::CerStore cer_store;
+        cer_store.setParams(storeDir);
+        ok = (cer_store.load() == RET_OK) && (cer_store.getCount(cnt_loaded) == RET_OK) && (cnt_loaded == vbaCerts.size());
+        for (size_t i = 0; ok && (i < vbaCerts.size()); i++) {
+            Cert::CerItem* cer_item = nullptr;
+            ok = (cer_store.getCertByEncoded(vbaCerts[i], &cer_item) == RET_OK) && cer_item && !cer_item->getFileName().empty();
+        }
+    }
+
+    vector<string> file_names;
+    (void)StoreLoader::listFiles(storeDir, ".cer", file_names);
+    for (const auto& it : file_names) {
+        delete_file((storeDir + it).c_str());
+    }
+    removeDir(storeDir);
+    if (!ok || (file_names.size() != vbaCerts.size())) {
+        return checkFailed("CerStore::load(): %zu certificates, %zu files, expected %zu", cnt_loaded, file_names.size(), vbaCerts.size());
+    }
+
+    printf("CerStore::load(): ok, %zu certificates\n", cnt_loaded);
+    return true;
+}
+
+//  Parameters: "counts" and "workers" - calls of parallelFor(); "certs" and "crls" - samples that are parsed
+//  "repeats" times on "parseWorkers" threads; "storeDir" - temporary directory of CerStore
+static bool testStoreLoader (
+        JSON_Object* joParams
+)
+{
+    JSON_Array* ja_certs = json_object_get_array(joParams, "certs");
+    JSON_Array* ja_crls = json_object_get_array(joParams, "crls");
+    VectorBA vba_certs, vba_crls;
+
+    if (json_object_has_value_of_type(joParams, "counts", JSONArray)) {
+        if (!checkParallelFor(json_object_get_array(joParams, "counts"), json_object_get_array(joParams, "workers"))) return false;
+    }
+    if (!checkAsnDescriptors()) return false;
+
+    for (size_t i = 0; i < json_array_get_count(ja_certs); i++) {
+        vba_certs.push_back(readSampleBa(json_array_get_string(ja_certs, i)));
+        if (!vba_certs.back()) return checkFailed("can't read certificate %zu", i);
+    }
+    for (size_t i = 0; i < json_array_get_count(ja_crls); i++) {
+        vba_crls.push_back(readSampleBa(json_array_get_string(ja_crls, i)));
+        if (!vba_crls.back()) return checkFailed("can't read CRL %zu", i);
+    }
+    if (!vba_certs.empty() && !vba_crls.empty()) {
+        if (!checkParallelParse(
+            vba_certs,
+            vba_crls,
+            getParamU32(joParams, "repeats", 8),
+            getParamU32(joParams, "parseWorkers", 4)
+        )) return false;
+    }
+
+    const string s_storedir = ParsonHelper::jsonObjectGetString(joParams, "storeDir");
+    if (!s_storedir.empty() && !checkCerStoreLoad(vba_certs, s_storedir)) return false;
+    return true;
+}
+
+
+
+//  =====  OID registry  =====
+
+//  Previous implementation of the lookups (chains of string comparisons),
+//  the registry must give the same results
+static EcParamsId refEcidFromOid (
+        const char* oid
+)
+{
+    static const struct { const char* oid; EcParamsId ecid; } EC_PARAMS[] = {
+        { OID_DSTU4145_PARAM_M257_PB, EC_PARAMS_ID_DSTU4145_M257_PB },
+        { OID_DSTU4145_PARAM_M431_PB, EC_PARAMS_ID_DSTU4145_M431_PB },
+        { OID_DSTU4145_PARAM_M307_PB, EC_PARAMS_ID_DSTU4145_M307_PB },
+        { OID_DSTU4145_PARAM_M367_PB, EC_PARAMS_ID_DSTU4145_M367_PB },
+        { OID_DSTU4145_PARAM_M163_PB, EC_PARAMS_ID_DSTU4145_M163_PB },
+        { OID_DSTU4145_PARAM_M167_PB, EC_PARAMS_ID_DSTU4145_M167_PB },
+        { OID_DSTU4145_PARAM_M173_PB, EC_PARAMS_ID_DSTU4145_M173_PB },
+        { OID_DSTU4145_PARAM_M179_PB, EC_PARAMS_ID_DSTU4145_M179_PB },
+        { OID_DSTU4145_PARAM_M191_PB, EC_PARAMS_ID_DSTU4145_M191_PB },
+        { OID_DSTU4145_PARAM_M233_PB, EC_PARAMS_ID_DSTU4145_M233_PB },
+        { OID_DSTU4145_PARAM_M173_ONB, EC_PARAMS_ID_DSTU4145_M173_ONB },
+        { OID_DSTU4145_PARAM_M179_ONB, EC_PARAMS_ID_DSTU4145_M179_ONB },
+        { OID_DSTU4145_PARAM_M191_ONB, EC_PARAMS_ID_DSTU4145_M191_ONB },
+        { OID_DSTU4145_PARAM_M233_ONB, EC_PARAMS_ID_DSTU4145_M233_ONB },
+        { OID_DSTU4145_PARAM_M431_ONB, EC_PARAMS_ID_DSTU4145_M431_ONB },
+        { OID_NIST_P192, EC_PARAMS_ID_NIST_P192 },
+        { OID_NIST_P224, EC_PARAMS_ID_NIST_P224 },
+        { OID_NIST_P256, EC_PARAMS_ID_NIST_P256 },
+        { OID_NIST_P384, EC_PARAMS_ID_NIST_P384 },
+        { OID_NIST_P521, EC_PARAMS_ID_NIST_P521 },
+        { OID_NIST_B233, EC_PARAMS_ID_NIST_B233 },
+        { OID_NIST_B283, EC_PARAMS_ID_NIST_B283 },
+        { OID_NIST_B409, EC_PARAMS_ID_NIST_B409 },
+        { OID_NIST_B571, EC_PARAMS_ID_NIST_B571 },
+        { OID_NIST_K233, EC_PARAMS_ID_NIST_K233 },
+        { OID_NIST_K283, EC_PARAMS_ID_NIST_K283 },
+        { OID_NIST_K409, EC_PARAMS_ID_NIST_K409 },
+        { OID_NIST_K571, EC_PARAMS_ID_NIST_K571 },
+        { OID_SECP256K1, EC_PARAMS_ID_SEC_P256_K1 },
+        { OID_BRAINPOOL_P224R1, EC_PARAMS_ID_BRAINPOOL_P224_R1 },
+        { OID_BRAINPOOL_P256R1, EC_PARAMS_ID_BRAINPOOL_P256_R1 },
+        { OID_BRAINPOOL_P384R1, EC_PARAMS_ID_BRAINPOOL_P384_R1 },
+        { OID_BRAINPOOL_P512R1, EC_PARAMS_ID_BRAINPOOL_P512_R1 },
+        { OID_ECRDSA_256A, EC_PARAMS_ID_GOST_P256_A },
+        { OID_ECRDSA_256B, EC_PARAMS_ID_GOST_P256_B },
+        { OID_ECRDSA_512A, EC_PARAMS_ID_GOST_P512_A },
+        { OID_ECRDSA_512B, EC_PARAMS_ID_GOST_P512_B },
+        { OID_SM2DSA_P256, EC_PARAMS_ID_SM2_P256 }
+    };
+    for (const auto& it : EC_PARAMS) {
+        if (oid_is_equal(it.oid, oid)) return it.ecid;
+    }
+    return EC_PARAMS_ID_UNDEFINED;
+}
+
+static HashAlg refHashFromOid (
+        const char* oid
+)
+{
+    if (oid_is_equal(OID_DSTU7564_256, oid) ||
+        oid_is_parent(OID_DSTU4145_WITH_DSTU7564_256, oid))
+        return HASH_ALG_DSTU7564_256;
+    if (oid_is_equal(OID_DSTU7564_384, oid) ||
+        oid_is_parent(OID_DSTU4145_WITH_DSTU7564_384, oid))
+        return HASH_ALG_DSTU7564_384;
+    if (oid_is_equal(OID_DSTU7564_512, oid) ||
+        oid_is_parent(OID_DSTU4145_WITH_DSTU7564_512, oid))
+        return HASH_ALG_DSTU7564_512;
+    if (oid_is_equal(OID_GOST34311, oid) ||
+        oid_is_equal(OID_HMAC_GOST34311, oid) ||
+        oid_is_parent(OID_DSTU4145_WITH_GOST3411, oid))
+        return HASH_ALG_GOST34311;
+    if (oid_is_equal(OID_SHA1, oid) ||
+        oid_is_equal(OID_HMAC_SHA1, oid) ||
+        oid_is_equal(OID_ECDSA_WITH_SHA1, oid) ||
+        oid_is_equal(OID_ECKCDSA_WITH_SHA1, oid) ||
+        oid_is_equal(OID_ECGDSA_SIGNATURE_WITH_SHA1, oid) ||
+        oid_is_equal(OID_RSA_WITH_SHA1, oid))
+        return HASH_ALG_SHA1;
+    if (oid_is_equal(OID_SHA224, oid) ||
+        oid_is_equal(OID_HMAC_SHA224, oid) ||
+        oid_is_equal(OID_ECDSA_WITH_SHA224, oid) ||
+        oid_is_equal(OID_ECKCDSA_WITH_SHA224, oid) ||
+        oid_is_equal(OID_ECGDSA_SIGNATURE_WITH_SHA224, oid) ||
+        oid_is_equal(OID_RSA_WITH_SHA224, oid))
+        return HASH_ALG_SHA224;
+    if (oid_is_equal(OID_SHA256, oid) ||
+        oid_is_equal(OID_HMAC_SHA256, oid) ||
+        oid_is_equal(OID_ECDSA_WITH_SHA256, oid) ||
+        oid_is_equal(OID_ECKCDSA_WITH_SHA256, oid) ||
+        oid_is_equal(OID_ECGDSA_SIGNATURE_WITH_SHA256, oid) ||
+        oid_is_equal(OID_RSA_WITH_SHA256, oid))
+        return HASH_ALG_SHA256;
+    if (oid_is_equal(OID_SHA384, oid) ||
+        oid_is_equal(OID_HMAC_SHA384, oid) ||
+        oid_is_equal(OID_ECDSA_WITH_SHA384, oid) ||
+        oid_is_equal(OID_ECGDSA_SIGNATURE_WITH_SHA384, oid) ||
+        oid_is_equal(OID_RSA_WITH_SHA384, oid))
+        return HASH_ALG_SHA384;
+    if (oid_is_equal(OID_SHA512, oid) ||
+        oid_is_equal(OID_HMAC_SHA512, oid) ||
+        oid_is_equal(OID_ECDSA_WITH_SHA512, oid) ||
+        oid_is_equal(OID_ECGDSA_SIGNATURE_WITH_SHA512, oid) ||
+        oid_is_equal(OID_RSA_WITH_SHA512, oid))
+        return HASH_ALG_SHA512;
+    if (oid_is_equal(OID_SHA3_224, oid) ||
+        oid_is_equal(OID_ECDSA_WITH_SHA3_224, oid) ||
+        oid_is_equal(OID_RSA_WITH_SHA3_224, oid))
+        return HASH_ALG_SHA3_224;
+    if (oid_is_equal(OID_SHA3_256, oid) ||
+        oid_is_equal(OID_ECDSA_WITH_SHA3_256, oid) ||
+        oid_is_equal(OID_RSA_WITH_SHA3_256, oid))
+        return HASH_ALG_SHA3_256;
+    if (oid_is_equal(OID_SHA3_384, oid) ||
+        oid_is_equal(OID_ECDSA_WITH_SHA3_384, oid) ||
+        oid_is_equal(OID_RSA_WITH_SHA3_384, oid))
+        return HASH_ALG_SHA3_384;
+    if (oid_is_equal(OID_SHA3_512, oid) ||
+        oid_is_equal(OID_ECDSA_WITH_SHA3_512, oid) ||
+        oid_is_equal(OID_RSA_WITH_SHA3_512, oid))
+        return HASH_ALG_SHA3_512;
+    if (oid_is_equal(OID_SM3, oid) ||
+        oid_is_equal(OID_SM3_ISO, oid) ||
+        oid_is_equal(OID_SM2_WITH_SM3, oid) ||
+        oid_is_equal(OID_RSA_WITH_SM3, oid))
+        return HASH_ALG_SM3;
+    if (oid_is_equal(OID_STREEBOG_256, oid) ||
+        oid_is_equal(OID_GOST_3410_2012_256, oid))
+        return HASH_ALG_GOSTR3411_2012_256;
+    if (oid_is_equal(OID_STREEBOG_512, oid) ||
+        oid_is_equal(OID_GOST_3410_2012_512, oid))
+        return HASH_ALG_GOSTR3411_2012_512;
+    if (oid_is_equal(OID_RIPEMD128, oid))
+        return HASH_ALG_RIPEMD128;
+    if (oid_is_equal(OID_RIPEMD160, oid) ||
+        oid_is_equal(OID_HMAC_RIPEMD160, oid) ||
+        oid_is_equal(OID_ECGDSA_SIGNATURE_WITH_RIPEMD160, oid))
+        return HASH_ALG_RIPEMD160;
+    if (oid_is_equal(OID_MD5, oid) ||
+        oid_is_equal(OID_HMAC_MD5, oid) ||
+        oid_is_equal(OID_RSA_WITH_MD5, oid))
+        return HASH_ALG_MD5;
+    if (oid_is_equal(OID_WHIRLPOOL, oid))
+        return HASH_ALG_WHIRLPOOL;
+    return HASH_ALG_UNDEFINED;
+}
+
+static SignAlg refSignatureFromOid (
+        const char* oid
+)
+{
+    if (oid_is_parent(OID_DSTU4145_PARAM_PB_LE, oid) ||
+        oid_is_parent(OID_DSTU4145_WITH_DSTU7564, oid))
+        return SIGN_DSTU4145;
+    if (oid_is_equal(OID_ECDSA_WITH_SHA1, oid) ||
+        oid_is_parent("1.2.840.10045.4.3", oid) ||
+        oid_is_equal(OID_ECDSA_WITH_SHA3_224, oid) ||
+        oid_is_equal(OID_ECDSA_WITH_SHA3_256, oid) ||
+        oid_is_equal(OID_ECDSA_WITH_SHA3_384, oid) ||
+        oid_is_equal(OID_ECDSA_WITH_SHA3_512, oid))
+        return SIGN_ECDSA;
+    if (oid_is_parent("1.2.410.200004.1.100.4", oid))
+        return SIGN_ECKCDSA;
+    if (oid_is_parent(OID_ECGDSA_SIGNATURE, oid))
+        return SIGN_ECGDSA;
+    if (oid_is_equal(OID_GOST_3410_2012_256, oid) ||
+        oid_is_equal(OID_GOST_3410_2012_512, oid))
+        return SIGN_ECRDSA;
+    if (oid_is_equal(OID_SM2_WITH_SM3, oid))
+        return SIGN_SM2DSA;
+    if (oid_is_parent("1.2.840.113549.1.1", oid) ||
+        oid_is_equal(OID_RSA_WITH_SHA3_224, oid) ||
+        oid_is_equal(OID_RSA_WITH_SHA3_256, oid) ||
+        oid_is_equal(OID_RSA_WITH_SHA3_384, oid) ||
+        oid_is_equal(OID_RSA_WITH_SHA3_512, oid) ||
+        oid_is_equal(OID_RSA_WITH_SM3, oid))
+        return SIGN_RSA_PKCS_1_5;
+    if (oid_is_equal(OID_RSA_PSS, oid))
+        return SIGN_RSA_PSS;
+    return SIGN_UNDEFINED;
+}
+
+static const char* refOidToRdname (
+        const char* oid
+)
+{
+    static const struct { const char* oid; const char* rdname; } RDNAMES[] = {
+        { OID_X520_CommonName, "CN" },
+        { OID_X520_Surname, "SN" },
+        { OID_X520_SerialNumber, "SERIALNUMBER" },
+        { OID_X520_Country, "C" },
+        { OID_X520_Locality, "L" },
+        { OID_X520_State, "S" },
+        { OID_X520_StreetAddress, "STREET" },
+        { OID_X520_Organization, "O" },
+        { OID_X520_OrganizationalUnit, "OU" },
+        { OID_X520_Title, "TITLE" },
+        { OID_X520_GivenName, "G" },
+        { OID_X520_OrganizationIdentifier, "OI" }
+    };
+    for (const auto& it : RDNAMES) {
+        if (strcmp(oid, it.oid) == 0) return it.rdname;
+    }
+    return oid;
+}
+
+static OBJECT_IDENTIFIER_t* oidFromText (
+        const char* oid
+)
+{
+    OBJECT_IDENTIFIER_t* rv_oid = (OBJECT_IDENTIFIER_t*)calloc(1, sizeof(OBJECT_IDENTIFIER_t));
+    if (rv_oid && (asn_set_oid_from_text(oid, rv_oid) != RET_OK)) {
+        asn_free(get_OBJECT_IDENTIFIER_desc(), rv_oid);
+        rv_oid = nullptr;
+    }
+    return rv_oid;
+}
+
+static bool checkOidRegistryEntries (void)
+{
+    //  Every entry is found by its text and by its DER content bytes, the DER is the same as asn1c gives
+    for (int id = OID_ID_UNDEFINED + 1; id < OID_ID_COUNT; id++) {
+        const char* s_oid = oid_id_to_text((OidId)id);
+        if (!s_oid) return checkFailed("no text of OidId %d", id);
+
+        OBJECT_IDENTIFIER_t* asn_oid = oidFromText(s_oid);
+        if (!asn_oid) return checkFailed("'%s': asn_set_oid_from_text() failed", s_oid);
+        const string s_der((const char*)asn_oid->buf, (size_t)asn_oid->size);
+        const OidId id_asn = oid_id_from_OID(asn_oid);
+        asn_free(get_OBJECT_IDENTIFIER_desc(), asn_oid);
+
+        uint8_t der[OID_MAX_DER_LEN];
+        const size_t der_len = oid_text_to_der(s_oid, der, sizeof(der));
+        if (string((const char*)der, der_len) != s_der) return checkFailed("'%s': oid_text_to_der() differs from asn1c", s_oid);
+        if (id_asn != (OidId)id) return checkFailed("'%s': oid_id_from_OID() returned %d, expected %d", s_oid, id_asn, id);
+        if (oid_id_from_text(s_oid) != (OidId)id) return checkFailed("'%s': oid_id_from_text() failed", s_oid);
+        if (!oid_id_is_parent_der((OidId)id, der, der_len)) return checkFailed("'%s': oid_id_is_parent_der() of itself is false", s_oid);
+    }
+    return true;
+}
+
+static bool checkOidLookups (
+        const string& oid,
+        const vector<string>& parents
+)
+{
+    const char* s_oid = oid.c_str();
+    OBJECT_IDENTIFIER_t* asn_oid = oidFromText(s_oid);
+    if (!asn_oid) return checkFailed("'%s': asn_set_oid_from_text() failed", s_oid);
+
+    bool ok = true;
+    const EcParamsId ref_ecid = refEcidFromOid(s_oid);
+    const HashAlg ref_hash = refHashFromOid(s_oid);
+    const SignAlg ref_sign = refSignatureFromOid(s_oid);
+    if ((ecid_from_oid(s_oid) != ref_ecid) || (ecid_from_OID(asn_oid) != ref_ecid)) {
+        ok = checkFailed("'%s': ecid %d, expected %d", s_oid, ecid_from_oid(s_oid), ref_ecid);
+    }
+    else if ((hash_from_oid(s_oid) != ref_hash) || (hash_from_OID(asn_oid) != ref_hash)) {
+        ok = checkFailed("'%s': hash %d, expected %d", s_oid, hash_from_oid(s_oid), ref_hash);
+    }
+    else if ((signature_from_oid(s_oid) != ref_sign) || (signature_from_OID(asn_oid) != ref_sign)) {
+        ok = checkFailed("'%s': signature %d, expected %d", s_oid, signature_from_oid(s_oid), ref_sign);
+    }
+    else if (strcmp(oid_to_rdname(s_oid), refOidToRdname(s_oid)) != 0) {
+        ok = checkFailed("'%s': rdname '%s', expected '%s'", s_oid, oid_to_rdname(s_oid), refOidToRdname(s_oid));
+    }
+    else {
+        const OidId oid_id = oid_id_from_text(s_oid);
+        if ((oid_id != OID_ID_UNDEFINED) && (strcmp(oid_id_to_text(oid_id), s_oid) != 0)) {
+            ok = checkFailed("'%s': resolved to '%s'", s_oid, oid_id_to_text(oid_id));
+        }
+        for (const auto& it : parents) {
+            if (!ok) break;
+            if (OID_is_equal_oid(asn_oid, it.c_str()) != oid_is_equal(it.c_str(), s_oid)) {
+                ok = checkFailed("'%s': OID_is_equal_oid('%s') differs", s_oid, it.c_str());
+            }
+            else if (OID_is_child_oid(asn_oid, it.c_str()) != oid_is_parent(it.c_str(), s_oid)) {
+                ok = checkFailed("'%s': OID_is_child_oid('%s') differs", s_oid, it.c_str());
+            }
+        }
+    }
+
+    asn_free(get_OBJECT_IDENTIFIER_desc(), asn_oid);
+    return ok;
+}
+
+//  Parameters: "extraOids" - OIDs that are absent in oids.h, "invalidOids" - texts that are not OIDs.
+//  The table (generated from oids.h, its currency is checked by the build) is checked against asn1c,
+//  the lookups are compared with the previous string implementation on every OID of oids.h,
+//  its children, parents and "extraOids"
+static bool testOidRegistry (
+        JSON_Object* joParams
+)
+{
+    if (!checkOidRegistryEntries()) return false;
+
+    vector<string> registered, candidates;
+    for (int id = OID_ID_UNDEFINED + 1; id < OID_ID_COUNT; id++) {
+        const string s_oid = string(oid_id_to_text((OidId)id));
+        registered.push_back(s_oid);
+        candidates.push_back(s_oid);
+        //  Children, including arcs that take two and three bytes
+        for (const char* arc : { ".0", ".1", ".127", ".128", ".16384" }) {
+            candidates.push_back(s_oid + arc);
+        }
+        //  Parents with at least two arcs
+        for (size_t pos = s_oid.rfind('.'); (pos != string::npos) && (s_oid.find('.') < pos); pos = s_oid.rfind('.', pos - 1)) {
+            candidates.push_back(s_oid.substr(0, pos));
+        }
+    }
+    JSON_Array* ja_extras = json_object_get_array(joParams, "extraOids");
+    for (size_t i = 0; i < json_array_get_count(ja_extras); i++) {
+        candidates.push_back(string(json_array_get_string(ja_extras, i)));
+    }
+    sort(candidates.begin(), candidates.end());
+    candidates.erase(unique(candidates.begin(), candidates.end()), candidates.end());
+
+    for (const auto& it : candidates) {
+        if (!checkOidLookups(it, registered)) return false;
+    }
+
+    JSON_Array* ja_invalids = json_object_get_array(joParams, "invalidOids");
+    for (size_t i = 0; i < json_array_get_count(ja_invalids); i++) {
+        const char* s_oid = json_array_get_string(ja_invalids, i);
+        uint8_t der[OID_MAX_DER_LEN];
+        if (oid_text_to_der(s_oid, der, sizeof(der)) != 0) return checkFailed("'%s': accepted by oid_text_to_der()", s_oid);
+        if (oid_id_from_text(s_oid) != OID_ID_UNDEFINED) return checkFailed("'%s': resolved by oid_id_from_text()", s_oid);
+        if (hash_from_oid(s_oid) != refHashFromOid(s_oid)) return checkFailed("'%s': hash differs", s_oid);
+        if (signature_from_oid(s_oid) != refSignatureFromOid(s_oid)) return checkFailed("'%s': signature differs", s_oid);
+    }
+
+    printf("registered OIDs: %zu, checked OIDs: %zu, invalid texts: %zu\n",
+        registered.size(), candidates.size(), json_array_get_count(ja_invalids));
+    return true;
+}
+
+
+
+//  =====  DER encoder  =====
+
+static int appendEncoded (
+        const void* buffer,
+        size_t size,
+        void* key
+)
+{
+    ((string*)key)->append((const char*)buffer, size);
+    return 0;
+}
+
+//  asn_encode() and asn_encode_ba() must give the same bytes as der_encode() of asn1c
+static bool checkDerEncoder (
+        asn_TYPE_descriptor_t* desc,
+        const void* st,
+        string& encoded
+)
+{
+    string expected;
+    uint8_t* buf = nullptr;
+    size_t len = 0;
+
+    const asn_enc_rval_t erval = der_encode(desc, (void*)st, appendEncoded, &expected);
+    if ((erval.encoded <= 0) || ((size_t)erval.encoded != expected.size())) return false;
+    if (!encodeAsn1(desc, st, encoded) || (encoded != expected)) return false;
+    if (asn_encode(desc, st, &buf, &len) != RET_OK) return false;
+
+    const bool rv = (string((const char*)buf, len) == expected);
+    free(buf);
+    return rv;
+}
+
+//  Calls the check for each single-byte mutation of the sample (xor 0x01, xor 0x80, 0x00, 0xFF
+//  in each position) that is decoded, stops on the first fail
+static bool checkDecodedMutations (
+        asn_TYPE_descriptor_t* desc,
+        const vector<uint8_t>& data,
+        const function<bool(const void*)>& check,
+        size_t& cntDecoded
+)
+{
+    vector<uint8_t> mutated = data;
+    cntDecoded = 0;
+    for (size_t pos = 0; pos < data.size(); pos++) {
+        const uint8_t values[] = {
+            (uint8_t)(data[pos] ^ 0x01), (uint8_t)(data[pos] ^ 0x80), 0x00, 0xFF
+        };
+        for (const auto& value : values) {
+            if (value == data[pos]) continue;
+            mutated[pos] = value;
+            void* st = asn_decode_with_alloc(desc, mutated.data(), mutated.size());
+            if (st) {
+                cntDecoded++;
+                const bool rv = check(st);
+                asn_free(desc, st);
+                if (!rv) return checkFailed("byte %zu set to 0x%02X", pos, value);
+            }
+        }
+        mutated[pos] = data[pos];
+    }
+    return true;
+}
+
+//  Parameters: "samples" - array of { "type", "file" } (DER), "sets" - array of { "type", "hex", "expected" },
+//  the type is one of ASN1_TYPES. The samples, their single-byte mutations and the sets are encoded
+//  by asn_encode(), asn_encode_ba() and der_encode(), the bytes must be the same.
+//  The samples must be encoded back as they are, the sets as "expected" (SET OF sorted by encodings)
+static bool testDerEncoder (
+        JSON_Object* joParams
+)
+{
+    JSON_Array* ja_samples = json_object_get_array(joParams, "samples");
+    JSON_Array* ja_sets = json_object_get_array(joParams, "sets");
+    if (json_array_get_count(ja_samples) == 0) return checkFailed("no samples");
+
+    for (size_t i = 0; i < json_array_get_count(ja_samples); i++) {
+        JSON_Object* jo_sample = json_array_get_object(ja_samples, i);
+        const char* s_type = json_object_get_string(jo_sample, "type");
+        const char* s_file = json_object_get_string(jo_sample, "file");
+        asn_TYPE_descriptor_t* desc = findAsn1Type(s_type);
+        vector<uint8_t> data;
+        string encoded;
+        size_t cnt_decoded = 0;
+
+        if (!desc) return checkFailed("unknown type '%s'", s_type ? s_type : "");
+        if (!s_file || !readSample(s_file, data)) return checkFailed("can't read file '%s'", s_file ? s_file : "");
+
+        void* st = asn_decode_with_alloc(desc, data.data(), data.size());
+        const bool rv = st && checkDerEncoder(desc, st, encoded);
+        asn_free(desc, st);
+        if (!rv) return checkFailed("'%s' (%s): encoders differ", s_file, s_type);
+        if (encoded != string((const char*)data.data(), data.size())) {
+            return checkFailed("'%s' (%s): encoded is not the same as the sample", s_file, s_type);
+        }
+
+        if (!checkDecodedMutations(desc, data, [desc](const void* st) {
+            string encoded;
+            return checkDerEncoder(desc, st, encoded);
+        }, cnt_decoded)) {
+            return checkFailed("'%s' (%s): encoders differ on mutated", s_file, s_type);
+        }
+        printf("'%s' (%s): ok, mutated decoded: %zu\n", s_file, s_type, cnt_decoded);
+    }
+
+    for (size_t i = 0; i < json_array_get_count(ja_sets); i++) {
+        JSON_Object* jo_set = json_array_get_object(ja_sets, i);
+        const char* s_type = json_object_get_string(jo_set, "type");
+        asn_TYPE_descriptor_t* desc = findAsn1Type(s_type);
+        ByteArray* ba_set = ba_alloc_from_hex(json_object_get_string(jo_set, "hex"));
+        ByteArray* ba_expected = ba_alloc_from_hex(json_object_get_string(jo_set, "expected"));
+        string encoded;
+
+        if (!desc || !ba_set || !ba_expected) {
+            ba_free(ba_set);
+            ba_free(ba_expected);
+            return checkFailed("sets[%zu]: unknown type '%s' or invalid hex", i, s_type ? s_type : "");
+        }
+
+        void* st = asn_decode_ba_with_alloc(desc, ba_set);
+        const bool rv = st && checkDerEncoder(desc, st, encoded) && (encoded == baToString(ba_expected));
+        asn_free(desc, st);
+        ba_free(ba_set);
+        ba_free(ba_expected);
+        if (!rv) return checkFailed("sets[%zu] (%s): encoded is not the same as der_encode() or expected", i, s_type);
+        printf("sets[%zu] (%s): ok\n", i, s_type);
+    }
+    return true;
+}
+
+
+
+//  =====  ASN.1 copy and comparison  =====
+
+//  The copy must be equal to the source and encoded as the source. The copy of the copy must outlive
+//  the first copy: no memory is shared
+static bool checkAsnCopy (
+        asn_TYPE_descriptor_t* desc,
+        const void* st
+)
+{
+    string expected, encoded;
+    if (!encodeAsn1(desc, st, expected)) return false;
+
+    void* copy = asn_copy_with_alloc(desc, st);
+    void* copy2 = copy ? asn_copy_with_alloc(desc, copy) : nullptr;
+    bool rv = copy2 && asn_equals(desc, st, copy) && asn_equals(desc, copy, st)
+        && encodeAsn1(desc, copy, encoded) && (encoded == expected);
+    asn_free(desc, copy);
+    rv = rv && asn_equals(desc, st, copy2) && encodeAsn1(desc, copy2, encoded) && (encoded == expected);
+    asn_free(desc, copy2);
+    return rv;
+}
+
+//  asn_equals() must be the same as the comparison of DER encodings, in both directions
+static bool checkAsnEquals (
+        asn_TYPE_descriptor_t* desc,
+        const void* a,
+        const void* b,
+        bool& isEqual
+)
+{
+    string encoded_a, encoded_b;
+    if (!encodeAsn1(desc, a, encoded_a) || !encodeAsn1(desc, b, encoded_b)) return false;
+
+    isEqual = asn_equals(desc, a, b);
+    return (isEqual == (encoded_a == encoded_b)) && (isEqual == asn_equals(desc, b, a));
+}
+
+//  Parameters: "samples" - array of { "type", "file" }, "pairs" - array of { "type", "a", "b", "equal" }
+//  with hex of the values, the type is one of ASN1_TYPES.
+//  The samples and their single-byte mutations (that are decoded) are copied by asn_copy_with_alloc(),
+//  each mutated is compared with the sample by asn_equals(), the result must be the same as
+//  the comparison of DER encodings. The pairs check the cases that differ in BER only
+//  (order of SET OF, sign extension of INTEGER)
+static bool testAsn1CopyEquals (
+        JSON_Object* joParams
+)
+{
+    JSON_Array* ja_samples = json_object_get_array(joParams, "samples");
+    JSON_Array* ja_pairs = json_object_get_array(joParams, "pairs");
+    if (json_array_get_count(ja_samples) == 0) return checkFailed("no samples");
+
+    for (size_t i = 0; i < json_array_get_count(ja_samples); i++) {
+        JSON_Object* jo_sample = json_array_get_object(ja_samples, i);
+        const char* s_type = json_object_get_string(jo_sample, "type");
+        const char* s_file = json_object_get_string(jo_sample, "file");
+        asn_TYPE_descriptor_t* desc = findAsn1Type(s_type);
+        vector<uint8_t> data;
+        size_t cnt_decoded = 0, cnt_equal = 0;
+
+        if (!desc) return checkFailed("unknown type '%s'", s_type ? s_type : "");
+        if (!s_file || !readSample(s_file, data)) return checkFailed("can't read file '%s'", s_file ? s_file : "");
+
+        void* st = asn_decode_with_alloc(desc, data.data(), data.size());
+        if (!st || !checkAsnCopy(desc, st)) {
+            asn_free(desc, st);
+            return checkFailed("'%s' (%s): can't decode or copy", s_file, s_type);
+        }
+
+        const bool rv = checkDecodedMutations(desc, data, [desc, st, &cnt_equal](const void* mutated) {
+            bool is_equal = false;
+            if (!checkAsnCopy(desc, mutated) || !checkAsnEquals(desc, st, mutated, is_equal)) return false;
+            if (is_equal) cnt_equal++;
+            return true;
+        }, cnt_decoded);
+        asn_free(desc, st);
+        if (!rv) return checkFailed("'%s' (%s): copy or comparison fails on mutated", s_file, s_type);
+        printf("'%s' (%s): ok, mutated decoded: %zu (equal: %zu)\n", s_file, s_type, cnt_decoded, cnt_equal);
+    }
+
+    for (size_t i = 0; i < json_array_get_count(ja_pairs); i++) {
+        JSON_Object* jo_pair = json_array_get_object(ja_pairs, i);
+        const char* s_type = json_object_get_string(jo_pair, "type");
+        asn_TYPE_descriptor_t* desc = findAsn1Type(s_type);
+        ByteArray* ba_a = ba_alloc_from_hex(json_object_get_string(jo_pair, "a"));
+        ByteArray* ba_b = ba_alloc_from_hex(json_object_get_string(jo_pair, "b"));
+        void* st_a = (desc && ba_a) ? asn_decode_ba_with_alloc(desc, ba_a) : nullptr;
+        void* st_b = (desc && ba_b) ? asn_decode_ba_with_alloc(desc, ba_b) : nullptr;
+        bool is_equal = false;
+
+        const bool rv = st_a && st_b
+            && checkAsnCopy(desc, st_a) && checkAsnCopy(desc, st_b)
+            && checkAsnEquals(desc, st_a, st_b, is_equal);
+        if (desc) {
+            asn_free(desc, st_a);
+            asn_free(desc, st_b);
+        }
+        ba_free(ba_a);
+        ba_free(ba_b);
+        if (!rv) return checkFailed("pairs[%zu] (%s): can't decode, copy or compare", i, s_type ? s_type : "");
+        if (is_equal != (json_object_get_boolean(jo_pair, "equal") > 0)) {
+            return checkFailed("pairs[%zu] (%s): asn_equals() returns %d", i, s_type, is_equal);
+        }
+        printf("pairs[%zu] (%s): ok, equal: %d\n", i, s_type, is_equal);
+    }
+    return true;
+}
+
+
+
+//  =====  Cert::CerItem, lazy decoding  =====
+
+struct RefCerFields {
+    string      authorityKeyId;
+    string      certId;
+    string      issuer;
+    string      keyAlgo;
+    string      keyId;
+    string      serialNumber;
+    string      spki;
+    string      subject;
+    HashAlg     algoKeyId;
+    uint64_t    notBefore;
+    uint64_t    notAfter;
+    uint32_t    keyUsage;
+    Cert::CerItem::Uris
+                uris;
+
+    RefCerFields (void)
+        : algoKeyId(HASH_ALG_UNDEFINED), notBefore(0), notAfter(0), keyUsage(0) {
+    }
+};  //  end struct RefCerFields
+
+//  The fields as parseCert() took them before the lazy decoding: from the whole decoded tree,
+//  names, SPKI and IssuerAndSerialNumber are encoded back
+static int refCerFields (
+        const Certificate_t* cert,
+        RefCerFields& fields
+)
+{
+    int ret = RET_OK;
+    const TBSCertificate_t& tbs = cert->tbsCertificate;
+    const Extensions_t* extns = tbs.extensions;
+    IssuerAndSerialNumber_t* issuer_and_sn = nullptr;
+    SmartBA sba_authoritykeyid, sba_certid, sba_issuer, sba_keyid, sba_pubkey, sba_serialnum, sba_spki, sba_subject;
+
+    if (!extns) return RET_UAPKI_INVALID_STRUCT;
+
+    DO(asn_INTEGER2ba(&tbs.serialNumber, &sba_serialnum));
+    DO(asn_encode_ba(get_Name_desc(), &tbs.issuer, &sba_issuer));
+    DO(Util::pkixTimeFromAsn1(&tbs.validity.notBefore, fields.notBefore));
+    DO(Util::pkixTimeFromAsn1(&tbs.validity.notAfter, fields.notAfter));
+    DO(asn_encode_ba(get_Name_desc(), &tbs.subject, &sba_subject));
+    DO(asn_encode_ba(get_SubjectPublicKeyInfo_desc(), &tbs.subjectPublicKeyInfo, &sba_spki));
+    DO(Util::oidFromAsn1(&tbs.subjectPublicKeyInfo.algorithm.algorithm, fields.keyAlgo));
+    if (DstuNS::isDstu4145family(fields.keyAlgo)) {
+        fields.algoKeyId = HASH_ALG_GOST34311;
+        DO(Util::bitStringEncapOctetFromAsn1(&tbs.subjectPublicKeyInfo.subjectPublicKey, &sba_pubkey));
+    }
+    else {
+        fields.algoKeyId = HASH_ALG_SHA1;
+        DO(asn_BITSTRING2ba(&tbs.subjectPublicKeyInfo.subjectPublicKey, &sba_pubkey));
+    }
+    DO(Cert::calcKeyId(fields.algoKeyId, sba_pubkey.get(), &sba_keyid));
+
+    ASN_ALLOC_TYPE(issuer_and_sn, IssuerAndSerialNumber_t);
+    DO(asn_copy(get_Name_desc(), &tbs.issuer, &issuer_and_sn->issuer));
+    DO(asn_copy(get_INTEGER_desc(), &tbs.serialNumber, &issuer_and_sn->serialNumber));
+    DO(asn_encode_ba(get_IssuerAndSerialNumber_desc(), issuer_and_sn, &sba_certid));
+
+    //  An invalid keyUsage is not an error for parseCert()
+    if (ExtensionHelper::getKeyUsage(extns, fields.keyUsage) == RET_UAPKI_EXTENSION_NOT_PRESENT) {
+        fields.keyUsage = 0;
+    }
+    DO(ExtensionHelper::getAuthorityKeyId(extns, &sba_authoritykeyid));
+
+    for (int i = 0; i < extns->list.count; i++) {
+        const Extension_t* extn = extns->list.array[i];
+        SmartBA sba_extnvalue;
+        switch (oid_id_from_OID(&extn->extnID)) {
+        case OID_ID_X509v3_CRLDistributionPoints:
+            DO(asn_OCTSTRING2ba(&extn->extnValue, &sba_extnvalue));
+            DO(ExtensionHelper::decodeDistributionPoints(sba_extnvalue.get(), fields.uris.fullCrl));
+            break;
+        case OID_ID_X509v3_FreshestCRL:
+            DO(asn_OCTSTRING2ba(&extn->extnValue, &sba_extnvalue));
+            DO(ExtensionHelper::decodeDistributionPoints(sba_extnvalue.get(), fields.uris.deltaCrl));
+            break;
+        case OID_ID_PKIX_AuthorityInfoAccess:
+            DO(asn_OCTSTRING2ba(&extn->extnValue, &sba_extnvalue));
+            DO(ExtensionHelper::decodeAccessDescriptions(sba_extnvalue.get(), OID_PKIX_OCSP, fields.uris.ocsp));
+            break;
+        case OID_ID_PKIX_SubjectInfoAccess:
+            DO(asn_OCTSTRING2ba(&extn->extnValue, &sba_extnvalue));
+            DO(ExtensionHelper::decodeAccessDescriptions(sba_extnvalue.get(), OID_PKIX_TimeStamping, fields.uris.tsp));
+            break;
+        default:
+            break;
+        }
+    }
+
+    fields.authorityKeyId = baToString(sba_authoritykeyid.get());
+    fields.certId = baToString(sba_certid.get());
+    fields.issuer = baToString(sba_issuer.get());
+    fields.keyId = baToString(sba_keyid.get());
+    fields.serialNumber = baToString(sba_serialnum.get());
+    fields.spki = baToString(sba_spki.get());
+    fields.subject = baToString(sba_subject.get());
+
+cleanup:
+    asn_free(get_IssuerAndSerialNumber_desc(), issuer_and_sn);
+    return ret;
+}
+
+static bool isEqualUris (
+        const Cert::CerItem::Uris& uris1,
+        const Cert::CerItem::Uris& uris2
+)
+{
+    return (uris1.fullCrl == uris2.fullCrl) && (uris1.deltaCrl == uris2.deltaCrl)
+        && (uris1.ocsp == uris2.ocsp) && (uris1.tsp == uris2.tsp);
+}
+
+//  Names, SPKI and IssuerAndSerialNumber of CerItem are the source bytes, not encoded back:
+//  they are the same as before for DER only, for BER the decoded values are the same
+static bool isEqualEncoded (
+        asn_TYPE_descriptor_t* desc,
+        const ByteArray* baEncoded,
+        const string& expected,
+        const bool isDer
+)
+{
+    if (baToString(baEncoded) == expected) return true;
+    if (isDer) return false;
+
+    void* st = asn_decode_ba_with_alloc(desc, baEncoded);
+    void* st_expected = asn_decode_with_alloc(desc, expected.data(), expected.size());
+    const bool rv = st && st_expected && asn_equals(desc, st, st_expected);
+    asn_free(desc, st);
+    asn_free(desc, st_expected);
+    return rv;
+}
+
+static bool checkCerItemFields (
+        const Cert::CerItem& cerItem,
+        const RefCerFields& fields,
+        const bool isDer
+)
+{
+    SmartBA sba_issuerandsn;
+    return (cerItem.getIssuerAndSN(&sba_issuerandsn) == RET_OK)
+        && isEqualEncoded(get_IssuerAndSerialNumber_desc(), sba_issuerandsn.get(), fields.certId, isDer)
+        && isEqualEncoded(get_IssuerAndSerialNumber_desc(), cerItem.getCertId(), fields.certId, isDer)
+        && isEqualEncoded(get_Name_desc(), cerItem.getIssuer(), fields.issuer, isDer)
+        && isEqualEncoded(get_SubjectPublicKeyInfo_desc(), cerItem.getSpki(), fields.spki, isDer)
+        && isEqualEncoded(get_Name_desc(), cerItem.getSubject(), fields.subject, isDer)
+        && (baToString(cerItem.getAuthorityKeyId()) == fields.authorityKeyId)
+        && (cerItem.getKeyAlgo() == fields.keyAlgo)
+        && (baToString(cerItem.getKeyId()) == fields.keyId)
+        && (baToString(cerItem.getSerialNumber()) == fields.serialNumber)
+        && (cerItem.getAlgoKeyId() == fields.algoKeyId)
+        && (cerItem.getNotBefore() == fields.notBefore)
+        && (cerItem.getNotAfter() == fields.notAfter)
+        && (cerItem.getKeyUsage() == fields.keyUsage)
+        && isEqualUris(cerItem.getUris(), fields.uris);
+}
+
+//  parseCert() must accept the certificate when the whole tree is decoded and its fields are taken,
+//  with the same fields (see isEqualEncoded()). It may accept more (the parts outside tbs, names and extensions are not decoded
+//  at load time), then getCert() must return nullptr
+static bool checkCerItemParity (
+        const uint8_t* data,
+        const size_t size,
+        bool& isParsed,
+        bool& isLazyOnly
+)
+{
+    SmartBA sba_encoded;
+    Cert::CerItem* cer_item = nullptr;
+    RefCerFields fields;
+    string expected, encoded;
+    bool rv = false;
+
+    isParsed = isLazyOnly = false;
+    if (!sba_encoded.set(ba_alloc_from_uint8(data, size))) return false;
+
+    Certificate_t* cert = (Certificate_t*)asn_decode_ba_with_alloc(get_Certificate_desc(), sba_encoded.get());
+    const bool is_ref = cert && (refCerFields(cert, fields) == RET_OK) && encodeAsn1(get_Certificate_desc(), cert, expected);
+    asn_free(get_Certificate_desc(), cert);
+    const bool is_lazy = (Cert::parseCert(sba_encoded.get(), &cer_item) == RET_OK);
+
+    if (is_ref) {
+        const bool is_der = (expected == string((const char*)data, size));
+        rv = is_lazy && checkCerItemFields(*cer_item, fields, is_der)
+            && encodeAsn1(get_Certificate_desc(), cer_item->getCert(), encoded) && (encoded == expected)
+            && (cer_item->getCert() == cer_item->getCert());
+        isParsed = true;
+    }
+    else if (is_lazy) {
+        rv = !cert && !cer_item->getCert();
+        isLazyOnly = true;
+    }
+    else {
+        rv = true;
+    }
+
+    delete cer_item;
+    return rv;
+}
+
+//  The first access from several threads decodes the tree once, all of them get it
+static bool checkCerItemConcurrentAccess (
+        const ByteArray* baEncoded
+)
+{
+    Cert::CerItem* cer_item = nullptr;
+    if (Cert::parseCert(baEncoded, &cer_item) != RET_OK) return false;
+
+    const size_t cnt_threads = 8;
+    vector<const Certificate_t*> certs(cnt_threads, nullptr);
+    vector<thread> threads;
+    atomic_bool started(false);
+    for (size_t i = 0; i < cnt_threads; i++) {
+        threads.push_back(thread([&, i]() {
+            while (!started) this_thread::yield();
+            certs[i] = cer_item->getCert();
+        }));
+    }
+    started = true;
+    for (auto& it : threads) {
+        it.join();
+    }
+
+    bool rv = (certs[0] != nullptr);
+    for (const auto& it : certs) {
+        rv = rv && (it == certs[0]);
+    }
+    delete cer_item;
+    return rv;
+}
+
+//  Parameters: "files" - array of certificates (with extensions).
+//  The fields of CerItem loaded with the lazy decoding must be the same as taken from the whole
+//  decoded tree (as before), for the certificates and their single-byte mutations. getCert() decodes
+//  the tree on the first access, the same for all threads, or returns nullptr for a malformed certificate
+static bool testCerItemLazy (
+        JSON_Object* joParams
+)
+{
+    JSON_Array* ja_files = json_object_get_array(joParams, "files");
+    if (json_array_get_count(ja_files) == 0) return checkFailed("no files");
+
+    for (size_t i = 0; i < json_array_get_count(ja_files); i++) {
+        const char* s_file = json_array_get_string(ja_files, i);
+        vector<uint8_t> data;
+        bool is_parsed = false, is_lazyonly = false;
+
+        if (!s_file || !readSample(s_file, data)) return checkFailed("can't read file '%s'", s_file ? s_file : "");
+
+        if (!checkCerItemParity(data.data(), data.size(), is_parsed, is_lazyonly) || !is_parsed) {
+            return checkFailed("'%s': lazy fields differ or the certificate is not parsed", s_file);
+        }
+
+        SmartBA sba_encoded;
+        if (!sba_encoded.set(ba_alloc_from_uint8(data.data(), data.size())) || !checkCerItemConcurrentAccess(sba_encoded.get())) {
+            return checkFailed("'%s': concurrent getCert() fails", s_file);
+        }
+
+        size_t cnt_parsed = 0, cnt_lazyonly = 0;
+        vector<uint8_t> mutated = data;
+        for (size_t pos = 0; pos < data.size(); pos++) {
+            const uint8_t values[] = {
+                (uint8_t)(data[pos] ^ 0x01), (uint8_t)(data[pos] ^ 0x80), 0x00, 0xFF
+            };
+            for (const auto& value : values) {
+                if (value == data[pos]) continue;
+                mutated[pos] = value;
+                if (!checkCerItemParity(mutated.data(), mutated.size(), is_parsed, is_lazyonly)) {
+                    return checkFailed("'%s': lazy fields differ on byte %zu set to 0x%02X (lazy only: %d)",
+                        s_file, pos, value, is_lazyonly);
+                }
+                if (is_parsed) cnt_parsed++;
+                if (is_lazyonly) cnt_lazyonly++;
+            }
+            mutated[pos] = data[pos];
+        }
+        printf("'%s': ok, mutated parsed: %zu, parsed by lazy only: %zu\n", s_file, cnt_parsed, cnt_lazyonly);
+    }
+    return true;
+}
+
+
+
+//  =====  ASN.1 TLV cursor  =====
+
+//  Reference: the tag and length parsers of asn1c, limited as asn_tlv_read() to 4 octets of tag,
+//  4 octets of length value and definite length. The length octet 0x80 is rejected for any element
+//  (asn1c takes it as zero length of the primitive)
+static bool refTlvRead (
+        const uint8_t* buf,
+        const size_t size,
+        AsnTlv& tlv
+)
+{
+    ber_tlv_tag_t tag = 0;
+    ber_tlv_len_t len = 0;
+    const ssize_t len_tag = ber_fetch_tag(buf, size, &tag);
+    if ((len_tag <= 0) || (len_tag > 4) || ((size_t)len_tag == size) || (buf[len_tag] == 0x80)) return false;
+
+    const ssize_t len_len = ber_fetch_length(BER_TLV_CONSTRUCTED(buf), buf + len_tag, size - len_tag, &len);
+    if ((len_len <= 0) || (len_len > 5) || (len < 0) || ((size_t)len > size - len_tag - len_len)) return false;
+
+    tlv.tag = 0;
+    for (ssize_t i = 0; i < len_tag; i++) {
+        tlv.tag = (tlv.tag << 8) | buf[i];
+    }
+    tlv.tlv = buf;
+    tlv.tlv_len = len_tag + len_len + len;
+    tlv.value = buf + len_tag + len_len;
+    tlv.len = len;
+    return true;
+}
+
+static bool isEqualTlv (
+        const AsnTlv& tlv1,
+        const AsnTlv& tlv2
+)
+{
+    return (tlv1.tag == tlv2.tag) && (tlv1.tlv == tlv2.tlv) && (tlv1.tlv_len == tlv2.tlv_len)
+        && (tlv1.value == tlv2.value) && (tlv1.len == tlv2.len);
+}
+
+//  Walks all elements by the cursor (into constructed ones) and by the reference parser,
+//  the elements must be the same and must fill their parent exactly. The walk is stopped
+//  by the first invalid element, both must reject it and the cursor must stay on it
+static bool walkTlvCursor (
+        AsnTlvCursor& cursor,
+        size_t& cntElements,
+        bool& isValid
+)
+{
+    while (!asn_tlv_cursor_end(&cursor)) {
+        const size_t pos = cursor.pos;
+        AsnTlv tlv, tlv_peek, tlv_ref;
+        const bool is_ref = refTlvRead(cursor.buf + pos, cursor.size - pos, tlv_ref);
+        const int ret = asn_tlv_next(&cursor, &tlv);
+        if (ret != RET_OK) {
+            isValid = false;
+            return (ret == RET_ASN1_DECODE_ERROR) && !is_ref && (cursor.pos == pos)
+                && (asn_tlv_peek(&cursor, &tlv_peek) == RET_ASN1_DECODE_ERROR);
+        }
+        if (!is_ref || !isEqualTlv(tlv, tlv_ref) || (cursor.pos != pos + tlv.tlv_len)) return false;
+        cntElements++;
+
+        AsnTlvCursor inner;
+        const int ret_enter = asn_tlv_enter(&inner, &tlv);
+        if (!ASN_TLV_IS_CONSTRUCTED(&tlv)) {
+            if (ret_enter != RET_ASN1_DECODE_ERROR) return false;
+            continue;
+        }
+        if ((ret_enter != RET_OK) || (inner.buf != tlv.value) || (inner.size != tlv.len) || (inner.pos != 0)) return false;
+        if (!walkTlvCursor(inner, cntElements, isValid)) return false;
+        if (!isValid) return true;
+    }
+    return (cursor.pos == cursor.size);
+}
+
+static bool checkTlvWalk (
+        const uint8_t* data,
+        const size_t size,
+        size_t& cntElements,
+        bool& isValid
+)
+{
+    AsnTlvCursor cursor;
+    asn_tlv_cursor_init(&cursor, data, size);
+    cntElements = 0;
+    isValid = true;
+    return walkTlvCursor(cursor, cntElements, isValid);
+}
+
+//  SEQUENCE { INTEGER 5, [0] { OCTET STRING 'AA'H }, NULL }
+static const uint8_t TLV_SCENARIO[] = {
+    0x30, 0x0A, 0x02, 0x01, 0x05, 0xA0, 0x03, 0x04, 0x01, 0xAA, 0x05, 0x00
+};
+//  SEQUENCE { INTEGER 5, OCTET STRING with the length out of the parent }
+static const uint8_t TLV_SCENARIO_BROKEN[] = {
+    0x30, 0x06, 0x02, 0x01, 0x05, 0x04, 0x05, 0xAA
+};
+
+static bool checkTlvCursorScenario (void)
+{
+    AsnTlvCursor cursor, seq, ctx;
+    AsnTlv tlv, tlv_seq, tlv_ctx;
+
+    asn_tlv_cursor_init(&cursor, TLV_SCENARIO, sizeof(TLV_SCENARIO));
+    if (
+        (asn_tlv_next(&cursor, &tlv_seq) != RET_OK) || (tlv_seq.tag != 0x30) || (tlv_seq.len != 10) ||
+        !asn_tlv_cursor_end(&cursor) ||
+        (asn_tlv_enter(&seq, &tlv_seq) != RET_OK)
+    ) return checkFailed("scenario: can't enter SEQUENCE");
+
+    //  Peek does not move the cursor
+    if (
+        (asn_tlv_peek(&seq, &tlv) != RET_OK) || (tlv.tag != 0x02) || (seq.pos != 0) ||
+        (asn_tlv_peek(&seq, &tlv) != RET_OK) || (tlv.tag != 0x02) || (seq.pos != 0)
+    ) return checkFailed("scenario: peek moves the cursor");
+
+    //  Search is on the level of the cursor only and skips the preceding elements
+    if (
+        (asn_tlv_find_tag(&seq, 0xA0, &tlv_ctx) != RET_OK) || (tlv_ctx.len != 3) || (seq.pos != 8) ||
+        (asn_tlv_enter(&ctx, &tlv_ctx) != RET_OK) ||
+        (asn_tlv_next(&ctx, &tlv) != RET_OK) || (tlv.tag != 0x04) || (tlv.len != 1) || (tlv.value[0] != 0xAA) ||
+        (asn_tlv_enter(&cursor, &tlv) != RET_ASN1_DECODE_ERROR) ||
+        !asn_tlv_cursor_end(&ctx)
+    ) return checkFailed("scenario: can't find or enter [0]");
+
+    ByteArray* ba_view = asn_tlv_to_ba_view(&tlv_ctx);
+    const bool is_view = ba_view && (ba_get_buf_const(ba_view) == TLV_SCENARIO + 5) && (ba_get_len(ba_view) == 5);
+    ba_free(ba_view);
+    if (!is_view) return checkFailed("scenario: asn_tlv_to_ba_view() is not a view of the element");
+
+    if (
+        (asn_tlv_skip(&seq) != RET_OK) || !asn_tlv_cursor_end(&seq) ||
+        (asn_tlv_peek(&seq, &tlv) != RET_ASN1_DECODE_ERROR) ||
+        (asn_tlv_next(&seq, &tlv) != RET_ASN1_DECODE_ERROR) ||
+        (asn_tlv_skip(&seq) != RET_ASN1_DECODE_ERROR) ||
+        (asn_tlv_find_tag(&seq, 0x05, &tlv) != RET_ASN1_NOT_FOUND)
+    ) return checkFailed("scenario: the cursor at the end is not rejected");
+
+    //  Nested elements are not found, the cursor is left at the end
+    asn_tlv_enter(&seq, &tlv_seq);
+    if ((asn_tlv_find_tag(&seq, 0x04, &tlv) != RET_ASN1_NOT_FOUND) || !asn_tlv_cursor_end(&seq)) {
+        return checkFailed("scenario: nested element is found");
+    }
+
+    //  The broken element stops the search with the error, the cursor stays on it
+    asn_tlv_cursor_init(&cursor, TLV_SCENARIO_BROKEN, sizeof(TLV_SCENARIO_BROKEN));
+    if (
+        (asn_tlv_next(&cursor, &tlv_seq) != RET_OK) || (asn_tlv_enter(&seq, &tlv_seq) != RET_OK) ||
+        (asn_tlv_find_tag(&seq, 0x05, &tlv) != RET_ASN1_DECODE_ERROR) || (seq.pos != 3) ||
+        (asn_tlv_skip(&seq) != RET_ASN1_DECODE_ERROR) || (seq.pos != 3) || asn_tlv_cursor_end(&seq)
+    ) return checkFailed("scenario: the broken element is not rejected");
+
+    //  Absent buffer and element
+    asn_tlv_cursor_init(&cursor, nullptr, 10);
+    if (
+        !asn_tlv_cursor_end(&cursor) || (cursor.size != 0) ||
+        (asn_tlv_next(&cursor, &tlv) != RET_ASN1_DECODE_ERROR) ||
+        (asn_tlv_enter(&cursor, nullptr) != RET_ASN1_DECODE_ERROR) ||
+        asn_tlv_to_ba_view(nullptr) ||
+        (asn_tlv_read(nullptr, 2, &tlv) != RET_ASN1_DECODE_ERROR) ||
+        (asn_tlv_read(TLV_SCENARIO, sizeof(TLV_SCENARIO), nullptr) != RET_ASN1_DECODE_ERROR)
+    ) return checkFailed("scenario: absent buffer or element is not rejected");
+
+    return true;
+}
+
+//  Parameters: "samples" - array of DER-files, "reads" - array of { "hex", "tag", "len", "tlvLen" } for
+//  asn_tlv_read(), the element is rejected if "tag" is absent, the tag is hex of the identifier octets.
+//  The samples and their single-byte mutations are walked by the cursor and by the parsers of asn1c
+static bool testAsn1TlvCursor (
+        JSON_Object* joParams
+)
+{
+    JSON_Array* ja_samples = json_object_get_array(joParams, "samples");
+    JSON_Array* ja_reads = json_object_get_array(joParams, "reads");
+    if ((json_array_get_count(ja_samples) == 0) || (json_array_get_count(ja_reads) == 0)) return checkFailed("no samples or reads");
+
+    for (size_t i = 0; i < json_array_get_count(ja_reads); i++) {
+        JSON_Object* jo_read = json_array_get_object(ja_reads, i);
+        const char* s_hex = json_object_get_string(jo_read, "hex");
+        const char* s_tag = json_object_get_string(jo_read, "tag");
+        AsnTlv tlv, tlv_ref;
+
+        if (!s_hex || (strlen(s_hex) % 2 != 0)) return checkFailed("reads[%zu]: invalid hex", i);
+        vector<uint8_t> data;
+        for (size_t j = 0; j < strlen(s_hex); j += 2) {
+            data.push_back((uint8_t)stoul(string(s_hex + j, 2), nullptr, 16));
+        }
+
+        const int ret = asn_tlv_read(data.data(), data.size(), &tlv);
+        const bool is_ref = refTlvRead(data.data(), data.size(), tlv_ref);
+        if (s_tag) {
+            if (
+                (ret != RET_OK) || !is_ref || !isEqualTlv(tlv, tlv_ref) ||
+                (tlv.tag != (uint32_t)stoul(s_tag, nullptr, 16)) ||
+                (tlv.len != (size_t)json_object_get_number(jo_read, "len")) ||
+                (tlv.tlv_len != (size_t)json_object_get_number(jo_read, "tlvLen"))
+            ) return checkFailed("reads[%zu] '%s': ret %d, tag 0x%X, len %zu", i, s_hex, ret, tlv.tag, tlv.len);
+        }
+        else if ((ret != RET_ASN1_DECODE_ERROR) || is_ref) {
+            return checkFailed("reads[%zu] '%s': is not rejected (ret %d, asn1c: %d)", i, s_hex, ret, is_ref);
+        }
+    }
+    printf("reads: ok, %zu\n", json_array_get_count(ja_reads));
+
+    if (!checkTlvCursorScenario()) return false;
+    printf("scenario: ok\n");
+
+    for (size_t i = 0; i < json_array_get_count(ja_samples); i++) {
+        const char* s_file = json_array_get_string(ja_samples, i);
+        vector<uint8_t> data;
+        size_t cnt_elements = 0;
+        bool is_valid = false;
+
+        if (!s_file || !readSample(s_file, data)) return checkFailed("can't read file '%s'", s_file ? s_file : "");
+
+        if (!checkTlvWalk(data.data(), data.size(), cnt_elements, is_valid) || !is_valid) {
+            return checkFailed("'%s': walk fails", s_file);
+        }
+        for (size_t size = 1; size < data.size(); size++) {
+            size_t cnt = 0;
+            if (!checkTlvWalk(data.data(), size, cnt, is_valid) || is_valid) {
+                return checkFailed("'%s': walk differs on truncated to %zu bytes", s_file, size);
+            }
+        }
+
+        size_t cnt_mutated = 0, cnt_valid = 0;
+        vector<uint8_t> mutated = data;
+        for (size_t pos = 0; pos < data.size(); pos++) {
+            const uint8_t values[] = {
+                (uint8_t)(data[pos] ^ 0x01), (uint8_t)(data[pos] ^ 0x80), 0x00, 0xFF
+            };
+            for (const auto& value : values) {
+                if (value == data[pos]) continue;
+                mutated[pos] = value;
+                size_t cnt = 0;
+                if (!checkTlvWalk(mutated.data(), mutated.size(), cnt, is_valid)) {
+                    return checkFailed("'%s': walk differs on byte %zu set to 0x%02X", s_file, pos, value);
+                }
+                cnt_mutated++;
+                if (is_valid) cnt_valid++;
+            }
+            mutated[pos] = data[pos];
+        }
+        printf("'%s': ok, elements: %zu, mutated: %zu (valid: %zu)\n", s_file, cnt_elements, cnt_mutated, cnt_valid);
+    }
+    return true;
+}
+
+
+
+//  =====  Crl::CrlRefresher  =====
+
+static bool checkRefresherDueTime (
+        JSON_Object* joCase
+)
+{
+    //  Times in seconds
+    const uint64_t ms_nextupdate = (uint64_t)json_object_get_number(joCase, "nextUpdate") * 1000;
+    const uint64_t ms_leadtime = (uint64_t)json_object_get_number(joCase, "leadTime") * 1000;
+    const uint64_t ms_jitter = (uint64_t)json_object_get_number(joCase, "jitter") * 1000;
+    const uint64_t ms_retrytime = (uint64_t)json_object_get_number(joCase, "retryTime") * 1000;
+    const uint64_t ms_expected = (uint64_t)json_object_get_number(joCase, "dueTime") * 1000;
+    const uint64_t ms_due = Crl::CrlRefresher::calcDueTime(ms_nextupdate, ms_leadtime, ms_jitter, ms_retrytime);
+    if (ms_due != ms_expected) {
+        return checkFailed("calcDueTime(%llu, %llu, %llu, %llu): %llu, expected %llu",
+            (unsigned long long)ms_nextupdate, (unsigned long long)ms_leadtime, (unsigned long long)ms_jitter,
+            (unsigned long long)ms_retrytime, (unsigned long long)ms_due, (unsigned long long)ms_expected);
+    }
+    return true;
+}
+
+static bool checkRefresherRetryTime (
+        JSON_Object* joCase
+)
+{
+    //  Times in seconds, "retryTime" is the delay after "now" (0 - the next download is by nextUpdate)
+    const bool is_refreshed = ParsonHelper::jsonObjectGetBoolean(joCase, "refreshed", false);
+    const uint64_t ms_nextupdate = (uint64_t)json_object_get_number(joCase, "nextUpdate") * 1000;
+    const uint64_t ms_leadtime = (uint64_t)json_object_get_number(joCase, "leadTime") * 1000;
+    const uint64_t ms_jitter = (uint64_t)json_object_get_number(joCase, "jitter") * 1000;
+    const uint64_t ms_now = (uint64_t)json_object_get_number(joCase, "now") * 1000;
+    const uint64_t ms_delay = (uint64_t)json_object_get_number(joCase, "retryTime") * 1000;
+    const uint64_t ms_expected = (ms_delay > 0) ? ms_now + ms_delay : 0;
+    const uint64_t ms_retry = Crl::CrlRefresher::calcRetryTime(is_refreshed, ms_nextupdate, ms_leadtime, ms_jitter, ms_now);
+    if (ms_retry != ms_expected) {
+        return checkFailed("calcRetryTime(%d, %llu, %llu, %llu, %llu): %llu, expected %llu", (int)is_refreshed,
+            (unsigned long long)ms_nextupdate, (unsigned long long)ms_leadtime, (unsigned long long)ms_jitter,
+            (unsigned long long)ms_now, (unsigned long long)ms_retry, (unsigned long long)ms_expected);
+    }
+    return true;
+}
+
+static bool checkRefresherJitter (
+        JSON_Object* joJitter
+)
+{
+    const uint32_t jitter = getParamU32(joJitter, "jitter", 0);
+    const uint32_t cnt_values = getParamU32(joJitter, "count", 1000);
+    uint64_t ms_min = UINT64_MAX, ms_max = 0;
+
+    for (uint32_t i = 0; i < cnt_values; i++) {
+        const uint64_t ms_jitter = Crl::CrlRefresher::calcJitter(jitter);
+        if ((ms_jitter > (uint64_t)jitter * 1000) || (ms_jitter % 1000 != 0)) {
+            return checkFailed("calcJitter(%u): %llu ms is out of range", jitter, (unsigned long long)ms_jitter);
+        }
+        ms_min = (ms_jitter < ms_min) ? ms_jitter : ms_min;
+        ms_max = (ms_jitter > ms_max) ? ms_jitter : ms_max;
+    }
+    //  Values are spread over the range (they are taken from DRBG)
+    if ((jitter > 0) && ((ms_min > (uint64_t)jitter * 250) || (ms_max < (uint64_t)jitter * 750))) {
+        return checkFailed("calcJitter(%u): values in [%llu, %llu] ms are not spread", jitter,
+            (unsigned long long)ms_min, (unsigned long long)ms_max);
+    }
+
+    printf("jitter %u s: ok, %u values in [%llu, %llu] ms\n", jitter, cnt_values, (unsigned long long)ms_min, (unsigned long long)ms_max);
+    return true;
+}
+
+static bool checkRefresherTrackStored (
+        JSON_Object* joTrack
+)
+{
+    JSON_Array* ja_certs = json_object_get_array(joTrack, "certs");
+    JSON_Array* ja_crls = json_object_get_array(joTrack, "crls");
+    const size_t expected_targets = (size_t)json_object_get_number(joTrack, "targets");
+    Cert::CerStore cer_store;
+    Crl::CrlStore crl_store;
+    VectorBA vba_certs;
+    vector<Cert::CerStore::AddedCerItem> added_ceritems;
+
+    crl_store.setParams(string(), ParsonHelper::jsonObjectGetBoolean(joTrack, "useDeltaCrl", true));
+    for (size_t i = 0; i < json_array_get_count(ja_certs); i++) {
+        ByteArray* ba_encoded = readSampleBa(json_array_get_string(ja_certs, i));
+        if (!ba_encoded) return checkFailed("can't read certificate %zu", i);
+        vba_certs.push_back(ba_encoded);
+    }
+    if (cer_store.addCerts(Cert::NOT_TRUSTED, Cert::NOT_PERMANENT, vba_certs, added_ceritems) != RET_OK) {
+        return checkFailed("can't add certificates");
+    }
+    for (size_t i = 0; i < json_array_get_count(ja_crls); i++) {
+        const char* s_file = json_array_get_string(ja_crls, i);
+        ByteArray* ba_encoded = readSampleBa(s_file);
+        bool is_unique = false;
+        //  On success CrlStore takes ownership of ba_encoded
+        const int ret = ba_encoded ? crl_store.addCrl(ba_encoded, false, is_unique, nullptr) : RET_UAPKI_FILE_OPEN_ERROR;
+        if (ret != RET_OK) {
+            ba_free(ba_encoded);
+            return checkFailed("can't add CRL '%s', error: %d", s_file ? s_file : "", ret);
+        }
+    }
+
+    //  Thread is not started: nothing is downloaded
+    Crl::CrlRefresher crl_refresher(crl_store, Crl::CrlRefresher::Params());
+    crl_refresher.trackStored(cer_store);
+    if (crl_refresher.countTargets() != expected_targets) {
+        return checkFailed("trackStored(): %zu targets, expected %zu", crl_refresher.countTargets(), expected_targets);
+    }
+    //  Same targets are registered by validation of certificate, they are not duplicated
+    crl_refresher.trackStored(cer_store);
+    if (crl_refresher.countTargets() != expected_targets) {
+        return checkFailed("trackStored() again: %zu targets, expected %zu", crl_refresher.countTargets(), expected_targets);
+    }
+
+    printf("trackStored: ok, %zu targets\n", expected_targets);
+    return true;
+}
+
+#ifndef _WIN32
+//  HTTP-server sends the body by one byte in 50 ms during 5 s, the download is not finished before stop()
+static void slowHttpServer (
+        const int fdListen,
+        atomic<bool>& isSending
+)
+{
+    const int fd = accept(fdListen, nullptr, nullptr);
+    if (fd < 0) return;
+
+    char buf[1024];
+    const char header[] = "HTTP/1.1 200 OK\r\nContent-Length: 100000000\r\n\r\n";
+    (void)recv(fd, buf, sizeof(buf), 0);
+    if (send(fd, header, sizeof(header) - 1, MSG_NOSIGNAL) == (ssize_t)(sizeof(header) - 1)) {
+        isSending = true;
+        for (size_t i = 0; i < 100; i++) {
+            if (send(fd, "0", 1, MSG_NOSIGNAL) != 1) break;
+            this_thread::sleep_for(chrono::milliseconds(50));
+        }
+    }
+    close(fd);
+}
+
+static bool checkRefresherStop (void)
+{
+    const int fd_listen = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr;
+    socklen_t addr_len = sizeof(addr);
+    atomic<bool> is_sending(false);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (
+        (fd_listen < 0) ||
+        (::bind(fd_listen, (const sockaddr*)&addr, sizeof(addr)) != 0) ||
+        (listen(fd_listen, 4) != 0) ||
+        (getsockname(fd_listen, (sockaddr*)&addr, &addr_len) != 0)
+    ) {
+        if (fd_listen >= 0) {
+            close(fd_listen);
+        }
+        return checkFailed("can't start HTTP-server");
+    }
+    thread server(slowHttpServer, fd_listen, ref(is_sending));
+
+    Crl::CrlStore crl_store;
+    Crl::CrlRefresher::Params params;
+    params.jitter = 0;
+    Crl::CrlRefresher crl_refresher(crl_store, params);
+    const uint8_t authoritykeyid[] = { 0x01, 0x02, 0x03, 0x04 };
+    ByteArray* ba_authoritykeyid = ba_alloc_from_uint8(authoritykeyid, sizeof(authoritykeyid));
+    const string s_uri = "http://127.0.0.1:" + to_string(ntohs(addr.sin_port)) + "/slow.crl";
+
+    //  CRL is absent in the store, it is due immediately
+    (void)HttpHelper::init(false, nullptr, nullptr);
+    crl_store.setParams(string(), true);
+    crl_refresher.track(ba_authoritykeyid, Crl::Type::FULL, vector<string>{ s_uri }, vector<string>());
+    ba_free(ba_authoritykeyid);
+    bool rv = (crl_refresher.start() == RET_OK);
+    for (size_t i = 0; rv && !is_sending && (i < 100); i++) {
+        this_thread::sleep_for(chrono::milliseconds(50));
+    }
+    rv = rv && is_sending;
+    this_thread::sleep_for(chrono::milliseconds(200));
+
+    const uint64_t ms_start = TimeUtil::mtimeNow();
+    crl_refresher.stop();
+    const uint64_t ms_stop = TimeUtil::mtimeNow() - ms_start;
+
+    (void)shutdown(fd_listen, SHUT_RDWR);
+    server.join();
+    close(fd_listen);
+    HttpHelper::deinit();
+
+    if (!rv) return checkFailed("download is not started");
+    if (ms_stop > 2000) return checkFailed("stop() waited for the download %llu ms", (unsigned long long)ms_stop);
+
+    printf("stop: ok, download is aborted in %llu ms\n", (unsigned long long)ms_stop);
+    return true;
+}
+#endif
+
+//  Parameters: "dueTimes" - array of { "nextUpdate", "leadTime", "jitter", "retryTime", "dueTime" } in seconds,
+//  "retryTimes" - array of { "refreshed", "nextUpdate", "leadTime", "jitter", "now", "retryTime" } in seconds,
+//  "jitter" - { "jitter", "count" }, "trackStored" - { "certs", "crls", "useDeltaCrl", "targets" },
+//  "stop" - stop() aborts the download from slow HTTP-server (ignored on Windows)
+static bool testCrlRefresher (
+        JSON_Object* joParams
+)
+{
+    JSON_Array* ja_duetimes = json_object_get_array(joParams, "dueTimes");
+    JSON_Array* ja_retrytimes = json_object_get_array(joParams, "retryTimes");
+    bool rv = true;
+
+    for (size_t i = 0; i < json_array_get_count(ja_duetimes); i++) {
+        rv = checkRefresherDueTime(json_array_get_object(ja_duetimes, i)) && rv;
+    }
+    for (size_t i = 0; i < json_array_get_count(ja_retrytimes); i++) {
+        rv = checkRefresherRetryTime(json_array_get_object(ja_retrytimes, i)) && rv;
+    }
+    if (json_object_has_value_of_type(joParams, "jitter", JSONObject)) {
+        rv = checkRefresherJitter(json_object_get_object(joParams, "jitter")) && rv;
+    }
+    if (json_object_has_value_of_type(joParams, "trackStored", JSONObject)) {
+        rv = checkRefresherTrackStored(json_object_get_object(joParams, "trackStored")) && rv;
+    }
+#ifndef _WIN32
+    if (ParsonHelper::jsonObjectGetBoolean(joParams, "stop", false)) {
+        rv = checkRefresherStop() && rv;
+    }
+#endif
+    return rv;
+}
+
+
+
+//  =====  Ocsp::OcspHelper, batched response  =====
+
+static SingleResponse_t* makeSingleResponse (
+        const SingleResponse_t* singleTemplate,
+        const ByteArray* baCertId,
+        const UapkiNS::CertStatus certStatus
+)
+{
+    SingleResponse_t* single_resp = (SingleResponse_t*)asn_copy_with_alloc(get_SingleResponse_desc(), singleTemplate);
+    if (!single_resp) return nullptr;
+
+    //  Template gives thisUpdate and nextUpdate, CertID and status are replaced
+    ASN_FREE_CONTENT_STATIC(get_CertID_desc(), &single_resp->certID);
+    ASN_FREE_CONTENT_STATIC(get_CertStatus_desc(), &single_resp->certStatus);
+    single_resp->certStatus.present = (certStatus == UapkiNS::CertStatus::GOOD) ? CertStatus_PR_good : CertStatus_PR_unknown;
+    if (asn_decode_ba(get_CertID_desc(), &single_resp->certID, baCertId) != RET_OK) {
+        asn_free(get_SingleResponse_desc(), single_resp);
+        return nullptr;
+    }
+    return single_resp;
+}
+
+static UapkiNS::CertStatus expectedBatchStatus (
+        const size_t idxCertId
+)
+{
+    return ((idxCertId % 2) == 0) ? UapkiNS::CertStatus::GOOD : UapkiNS::CertStatus::UNKNOWN;
+}
+
+static bool buildBatchResponse (
+        Ocsp::OcspHelper& ocspHelper,
+        const ByteArray* baTemplate,
+        JSON_Array* jaOrder,
+        const bool extraResponse,
+        ByteArray** baEncoded
+)
+{
+    BasicOCSPResponse_t* basic_resp = (BasicOCSPResponse_t*)asn_decode_ba_with_alloc(get_BasicOCSPResponse_desc(), baTemplate);
+    if (!basic_resp || (basic_resp->tbsResponseData.responses.list.count <= 0)) {
+        asn_free(get_BasicOCSPResponse_desc(), basic_resp);
+        return checkFailed("can't decode template of BasicOCSPResponse");
+    }
+
+    //  Responses of template are detached, the first one is template of each new response
+    auto& list_resps = basic_resp->tbsResponseData.responses.list;
+    vector<SingleResponse_t*> template_resps(list_resps.array, list_resps.array + list_resps.count);
+    list_resps.count = 0;
+
+    bool rv = true;
+    if (extraResponse) {
+        //  Response for CertID that is absent in request (e.g. cached one) is placed before the others
+        SingleResponse_t* single_resp = (SingleResponse_t*)asn_copy_with_alloc(get_SingleResponse_desc(), template_resps[0]);
+        rv = single_resp && (ASN_SEQUENCE_ADD(&list_resps, single_resp) == 0);
+    }
+    for (size_t i = 0; rv && (i < json_array_get_count(jaOrder)); i++) {
+        const size_t idx_certid = (size_t)json_array_get_number(jaOrder, i);
+        SmartBA sba_certid;
+        SingleResponse_t* single_resp = nullptr;
+        rv = (ocspHelper.getRequestCertId(idx_certid, &sba_certid) == RET_OK) &&
+            ((single_resp = makeSingleResponse(template_resps[0], sba_certid.get(), expectedBatchStatus(idx_certid))) != nullptr) &&
+            (ASN_SEQUENCE_ADD(&list_resps, single_resp) == 0);
+    }
+    rv = rv && (asn_encode_ba(get_BasicOCSPResponse_desc(), basic_resp, baEncoded) == RET_OK);
+
+    for (auto& it : template_resps) {
+        asn_free(get_SingleResponse_desc(), it);
+    }
+    asn_free(get_BasicOCSPResponse_desc(), basic_resp);
+    return rv ? true : checkFailed("can't build BasicOCSPResponse");
+}
+
+//  Parameters: "issuer" - certificate of issuer, "basicOcspResponse" - template of BasicOCSPResponse,
+//  "serialNumbers" - serial numbers (hex) in order of request, "responseOrder" - indexes of request CertIDs
+//  in order of response, "extraResponse" - response has the status of other certificate.
+//  Statuses of even CertIDs are good, odd ones are unknown; response without status of some CertID is invalid
+static bool testOcspBatchResponse (
+        JSON_Object* joParams
+)
+{
+    const char* s_issuer = json_object_get_string(joParams, "issuer");
+    JSON_Array* ja_serials = json_object_get_array(joParams, "serialNumbers");
+    JSON_Array* ja_order = json_object_get_array(joParams, "responseOrder");
+    const bool extra_response = ParsonHelper::jsonObjectGetBoolean(joParams, "extraResponse", false);
+    const size_t cnt_certids = json_array_get_count(ja_serials);
+    ByteArray* ba_issuer = readSampleBa(s_issuer);
+    Cert::CerItem* cer_issuer = nullptr;
+    SmartBA sba_template, sba_response;
+    Ocsp::OcspHelper ocsp_helper;
+    vector<bool> is_responded(cnt_certids, false);
+    bool rv = true;
+
+    if (!ba_issuer) return checkFailed("can't read file '%s'", s_issuer ? s_issuer : "");
+    //  On success CerItem takes ownership of ba_issuer
+    if (Cert::parseCert(ba_issuer, &cer_issuer) != RET_OK) {
+        ba_free(ba_issuer);
+        return checkFailed("'%s': can't parse certificate", s_issuer);
+    }
+    if (!sba_template.set(readSampleBa(json_object_get_string(joParams, "basicOcspResponse")))) {
+        delete cer_issuer;
+        return checkFailed("can't read template of BasicOCSPResponse");
+    }
+
+    rv = (ocsp_helper.init() == RET_OK);
+    for (size_t i = 0; rv && (i < cnt_certids); i++) {
+        SmartBA sba_serial;
+        rv = sba_serial.set(ba_alloc_from_hex(json_array_get_string(ja_serials, i))) &&
+            (ocsp_helper.addIssuerAndSN(cer_issuer, sba_serial.get()) == RET_OK);
+    }
+    if (!rv) {
+        delete cer_issuer;
+        return checkFailed("can't add CertIDs to request");
+    }
+    for (size_t i = 0; i < json_array_get_count(ja_order); i++) {
+        const size_t idx_certid = (size_t)json_array_get_number(ja_order, i);
+        if (idx_certid < cnt_certids) {
+            is_responded[idx_certid] = true;
+        }
+    }
+
+    rv = buildBatchResponse(ocsp_helper, sba_template.get(), ja_order, extra_response, &sba_response);
+    delete cer_issuer;
+    if (!rv) return false;
+
+    int ret = ocsp_helper.parseBasicOcspResponse(sba_response.get());
+    if (ret != RET_OK) return checkFailed("parseBasicOcspResponse() returned %d", ret);
+    ret = ocsp_helper.scanSingleResponses();
+    for (size_t i = 0; i < cnt_certids; i++) {
+        if (!is_responded[i]) {
+            //  Status of this certificate can't be taken from the other single response
+            if (ret != RET_UAPKI_OCSP_RESPONSE_INVALID) return checkFailed("CertID %zu is not responded, scanSingleResponses() returned %d", i, ret);
+            printf("response without CertID %zu: ok, rejected\n", i);
+            return true;
+        }
+    }
+    if (ret != RET_OK) return checkFailed("scanSingleResponses() returned %d", ret);
+    if (ocsp_helper.countSingleResponses() != cnt_certids) {
+        return checkFailed("count of single responses: %zu, expected %zu", ocsp_helper.countSingleResponses(), cnt_certids);
+    }
+
+    for (size_t i = 0; i < cnt_certids; i++) {
+        SmartBA sba_expected, sba_serial;
+        const UapkiNS::CertStatus status = ocsp_helper.getSingleResponseInfo(i).certStatus;
+        (void)sba_expected.set(ba_alloc_from_hex(json_array_get_string(ja_serials, i)));
+        if (
+            (ocsp_helper.getSerialNumberFromCertId(i, &sba_serial) != RET_OK) ||
+            !isEqualBa(sba_serial.get(), sba_expected.get())
+        ) return checkFailed("CertID %zu: serial number of single response is not matched", i);
+        if (status != expectedBatchStatus(i)) {
+            return checkFailed("CertID %zu: status %d, expected %d", i, (int)status, (int)expectedBatchStatus(i));
+        }
+    }
+
+    printf("%zu CertIDs: ok, matched out of order\n", cnt_certids);
+    return true;
+}
+
+
+
+//  =====  uapkic, per-thread DRBG  =====
+
+static const size_t DRBG_BLOCK_LEN = 32;
+
+static bool checkDrbgThreads (
+        const size_t cntThreads,
+        const size_t cntBlocks
+)
+{
+    vector<vector<string>> outputs(cntThreads);
+    vector<int> rets(cntThreads, RET_OK);
+    vector<thread> threads;
+
+    for (size_t t = 0; t < cntThreads; t++) {
+        threads.push_back(thread([&outputs, &rets, t, cntBlocks]() {
+            for (size_t i = 0; (i < cntBlocks) && (rets[t] == RET_OK); i++) {
+                ByteArray* ba_random = ba_alloc_by_len(DRBG_BLOCK_LEN);
+                //  Reseed by one thread changes generation while the others generate
+                if ((t == 0) && (i == cntBlocks / 2)) {
+                    rets[t] = drbg_reseed(nullptr);
+                }
+                if (rets[t] == RET_OK) {
+                    rets[t] = ba_random ? drbg_random(ba_random) : RET_MEMORY_ALLOC_ERROR;
+                }
+                outputs[t].push_back(baToString(ba_random));
+                ba_free(ba_random);
+            }
+        }));
+    }
+    for (auto& it : threads) {
+        it.join();
+    }
+
+    vector<string> all_blocks;
+    for (size_t t = 0; t < cntThreads; t++) {
+        if (rets[t] != RET_OK) return checkFailed("thread %zu: drbg_random() returned %d", t, rets[t]);
+        all_blocks.insert(all_blocks.end(), outputs[t].begin(), outputs[t].end());
+    }
+    sort(all_blocks.begin(), all_blocks.end());
+    if (adjacent_find(all_blocks.begin(), all_blocks.end()) != all_blocks.end()) {
+        return checkFailed("threads generated the same block");
+    }
+
+    printf("%zu threads x %zu blocks: ok, all blocks are distinct\n", cntThreads, cntBlocks);
+    return true;
+}
+
+#ifndef _WIN32
+static bool checkDrbgFork (void)
+{
+    ByteArray* ba_parent = ba_alloc_by_len(DRBG_BLOCK_LEN);
+    uint8_t child_block[DRBG_BLOCK_LEN];
+    size_t cnt_read = 0;
+    int fds[2];
+    int status = 0;
+
+    //  Instance of this thread is created before fork, the child inherits it
+    if (!ba_parent || (drbg_random(ba_parent) != RET_OK) || (pipe(fds) != 0)) {
+        ba_free(ba_parent);
+        return checkFailed("can't prepare fork");
+    }
+
+    fflush(stdout);
+    const pid_t pid = fork();
+    if (pid == 0) {
+        ByteArray* ba_child = ba_alloc_by_len(DRBG_BLOCK_LEN);
+        int rv = 1;
+        close(fds[0]);
+        if (ba_child && (drbg_random(ba_child) == RET_OK)) {
+            rv = (write(fds[1], ba_get_buf_const(ba_child), DRBG_BLOCK_LEN) == (ssize_t)DRBG_BLOCK_LEN) ? 0 : 1;
+        }
+        ba_free(ba_child);
+        close(fds[1]);
+        //  exit() calls the handlers of atexit(), the thread key of DRBG is deleted
+        exit(rv);
+    }
+
+    close(fds[1]);
+    int ret = (pid > 0) ? drbg_random(ba_parent) : RET_UAPKI_GENERAL_ERROR;
+    while ((pid > 0) && (cnt_read < DRBG_BLOCK_LEN)) {
+        const ssize_t rv_read = read(fds[0], child_block + cnt_read, DRBG_BLOCK_LEN - cnt_read);
+        if (rv_read <= 0) break;
+        cnt_read += (size_t)rv_read;
+    }
+    close(fds[0]);
+    const bool is_exited = (pid > 0) && (waitpid(pid, &status, 0) == pid) && WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+    const bool is_same = (cnt_read == DRBG_BLOCK_LEN) && (memcmp(child_block, ba_get_buf_const(ba_parent), DRBG_BLOCK_LEN) == 0);
+    ba_free(ba_parent);
+
+    if ((ret != RET_OK) || !is_exited || (cnt_read != DRBG_BLOCK_LEN)) {
+        return checkFailed("fork: parent returned %d, child status 0x%X, read %zu bytes", ret, status, cnt_read);
+    }
+    //  Without reseed the child repeats the next output of the parent
+    if (is_same) return checkFailed("fork: child generated the same block as parent");
+
+    printf("fork: ok, child reseeded\n");
+    return true;
+}
+#endif
+
+//  Parameters: "threads" - count of threads, "blocks" - count of blocks generated by each thread,
+//  "fork" - check that the forked child doesn't repeat the output of parent (ignored on Windows)
+static bool testDrbgThreads (
+        JSON_Object* joParams
+)
+{
+    bool rv = checkDrbgThreads(
+        getParamU32(joParams, "threads", 8),
+        getParamU32(joParams, "blocks", 1000)
+    );
+#ifndef _WIN32
+    if (ParsonHelper::jsonObjectGetBoolean(joParams, "fork", false)) {
+        rv = checkDrbgFork() && rv;
+    }
+#endif
+    return rv;
+}
+
+
+
+//  =====  uapkic, vector kernels of byte array  =====
+
+static string refBase64 (
+        const uint8_t* data,
+        const size_t len
+)
+{
+    static const char* codes = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    string rv;
+    for (size_t i = 0; i < len; i += 3) {
+        const uint32_t t = ((uint32_t)data[i] << 16)
+            | ((i + 1 < len) ? (uint32_t)data[i + 1] << 8 : 0)
+            | ((i + 2 < len) ? (uint32_t)data[i + 2] : 0);
+        rv += codes[(t >> 18) & 0x3F];
+        rv += codes[(t >> 12) & 0x3F];
+        rv += (i + 1 < len) ? codes[(t >> 6) & 0x3F] : '=';
+        rv += (i + 2 < len) ? codes[t & 0x3F] : '=';
+    }
+    return rv;
+}
+
+static string refHex (
+        const uint8_t* data,
+        const size_t len
+)
+{
+    static const char* codes = "0123456789ABCDEF";
+    string rv;
+    for (size_t i = 0; i < len; i++) {
+        rv += codes[data[i] >> 4];
+        rv += codes[data[i] & 0x0F];
+    }
+    return rv;
+}
+
+static const uint8_t SIMD_SENTINEL = 0xA5;
+static const size_t SIMD_GUARD = 64;
+
+static bool isSimdGuardIntact (
+        const vector<uint8_t>& buf,
+        const size_t from
+)
+{
+    for (size_t i = from; i < buf.size(); i++) {
+        if (buf[i] != SIMD_SENTINEL) return false;
+    }
+    return true;
+}
+
+static bool isSimdDoneValid (
+        const size_t total,
+        const size_t done,
+        const bool isEnabled,
+        const size_t maxTail
+)
+{
+    //  Disabled kernels handle nothing
+    return isEnabled ? (total - done < maxTail) : (done == 0);
+}
+
+static bool checkSimdKernels (
+        const vector<uint8_t>& data,
+        const size_t len,
+        const bool isEnabled
+)
+{
+    //  Every kernel handles the whole blocks of prefix (not less than len - 64), writes no more than by contract,
+    //  the output is the same as of the scalar code
+    const string s_b64 = refBase64(data.data(), len);
+    const string s_hex = refHex(data.data(), len);
+    vector<uint8_t> out;
+
+    out.assign(len / 3 * 4 + SIMD_GUARD, SIMD_SENTINEL);
+    size_t done = ba_simd_base64_encode(data.data(), len, out.data());
+    if (
+        (done % 3 != 0) || (done > len) || !isSimdDoneValid(len, done, isEnabled, 64) ||
+        (memcmp(out.data(), s_b64.data(), done / 3 * 4) != 0) || !isSimdGuardIntact(out, done / 3 * 4)
+    ) return checkFailed("base64 encode, length %zu: %zu bytes are encoded", len, done);
+
+    //  Decoding is limited by outlen: whole output and its half
+    const size_t outlens[] = { len, len / 2 };
+    for (const auto& outlen : outlens) {
+        out.assign(outlen + SIMD_GUARD, SIMD_SENTINEL);
+        done = ba_simd_base64_decode((const uint8_t*)s_b64.data(), s_b64.size(), out.data(), outlen);
+        if (
+            (done % 4 != 0) || (done > s_b64.size()) || (done / 4 * 3 > outlen) ||
+            ((outlen == len) && !isSimdDoneValid(s_b64.size(), done, isEnabled, 68)) ||
+            (memcmp(out.data(), data.data(), done / 4 * 3) != 0) || !isSimdGuardIntact(out, outlen)
+        ) return checkFailed("base64 decode, length %zu, outlen %zu: %zu chars are decoded", len, outlen, done);
+    }
+
+    //  Character out of the alphabet: the block that contains it is left to the scalar code
+    if (len >= 3) {
+        const size_t positions[] = { 0, s_b64.size() / 2, (len / 3) * 4 - 1 };
+        for (const auto& pos : positions) {
+            string s_bad = s_b64;
+            s_bad[pos] = '*';
+            out.assign(len + SIMD_GUARD, SIMD_SENTINEL);
+            done = ba_simd_base64_decode((const uint8_t*)s_bad.data(), s_bad.size(), out.data(), len);
+            if ((done > pos) || (done % 4 != 0) || (memcmp(out.data(), data.data(), done / 4 * 3) != 0)) {
+                return checkFailed("base64 decode, length %zu, bad char at %zu: %zu chars are decoded", len, pos, done);
+            }
+        }
+    }
+
+    out.assign(2 * len + SIMD_GUARD, SIMD_SENTINEL);
+    done = ba_simd_hex_encode(data.data(), len, (char*)out.data());
+    if (
+        (done > len) || !isSimdDoneValid(len, done, isEnabled, 64) ||
+        (memcmp(out.data(), s_hex.data(), 2 * done) != 0) || !isSimdGuardIntact(out, 2 * done)
+    ) return checkFailed("hex encode, length %zu: %zu bytes are encoded", len, done);
+
+    //  Lower and upper case are decoded
+    string s_hexmixed = s_hex;
+    for (size_t i = 0; i < s_hexmixed.size(); i += 3) {
+        s_hexmixed[i] = (char)tolower(s_hexmixed[i]);
+    }
+    out.assign(len + SIMD_GUARD, SIMD_SENTINEL);
+    done = ba_simd_hex_decode(s_hexmixed.data(), s_hexmixed.size(), out.data());
+    if (
+        (done % 2 != 0) || (done > s_hexmixed.size()) || !isSimdDoneValid(s_hexmixed.size(), done, isEnabled, 128) ||
+        (memcmp(out.data(), data.data(), done / 2) != 0) || !isSimdGuardIntact(out, done / 2)
+    ) return checkFailed("hex decode, length %zu: %zu chars are decoded", len, done);
+
+    if (len > 0) {
+        const size_t positions[] = { 0, s_hex.size() / 2, s_hex.size() - 1 };
+        for (const auto& pos : positions) {
+            string s_bad = s_hex;
+            s_bad[pos] = 'g';
+            out.assign(len + SIMD_GUARD, SIMD_SENTINEL);
+            done = ba_simd_hex_decode(s_bad.data(), s_bad.size(), out.data());
+            if ((done > pos) || (done % 2 != 0) || (memcmp(out.data(), data.data(), done / 2) != 0)) {
+                return checkFailed("hex decode, length %zu, bad char at %zu: %zu chars are decoded", len, pos, done);
+            }
+        }
+    }
+    return true;
+}
+
+static bool checkByteArrayCodecs (
+        const vector<uint8_t>& data,
+        const size_t len
+)
+{
+    //  Codecs of library (scalar code with kernels that are selected by CPU)
+    const string s_b64 = refBase64(data.data(), len);
+    const string s_hex = refHex(data.data(), len);
+    SmartBA sba_data, sba_decoded;
+    char* s_encoded = nullptr;
+
+    if (!sba_data.set(ba_alloc_from_uint8(data.data(), len))) return checkFailed("no memory");
+    if (ba_to_base64_with_alloc(sba_data.get(), &s_encoded) != RET_OK) return checkFailed("ba_to_base64_with_alloc() failed");
+    const bool is_b64equal = (s_b64 == string(s_encoded));
+    free(s_encoded);
+    s_encoded = nullptr;
+    if (ba_to_hex_with_alloc(sba_data.get(), &s_encoded) != RET_OK) return checkFailed("ba_to_hex_with_alloc() failed");
+    const bool is_hexequal = (s_hex == string(s_encoded));
+    free(s_encoded);
+    if (!is_b64equal || !is_hexequal) return checkFailed("length %zu: encoded value differs", len);
+
+    if (len == 0) return true;
+    if (!sba_decoded.set(ba_alloc_from_base64(s_b64.c_str())) || !isEqualBa(sba_decoded.get(), sba_data.get())) {
+        return checkFailed("length %zu: base64 is decoded wrong", len);
+    }
+    if (!sba_decoded.set(ba_alloc_from_hex(s_hex.c_str())) || !isEqualBa(sba_decoded.get(), sba_data.get())) {
+        return checkFailed("length %zu: hex is decoded wrong", len);
+    }
+
+    //  PEM-like lines: separators are skipped, size of output is estimated by upper bound
+    string s_lines;
+    for (size_t i = 0; i < s_b64.size(); i += 64) {
+        s_lines += s_b64.substr(i, 64) + "\r\n";
+    }
+    if (!sba_decoded.set(ba_alloc_from_base64(s_lines.c_str())) || !isEqualBa(sba_decoded.get(), sba_data.get())) {
+        return checkFailed("length %zu: base64 with line breaks is decoded wrong", len);
+    }
+    return true;
+}
+
+//  Parameters: "maxLength" - all lengths from 0, "lengths" - other lengths (boundaries of blocks: 12/16 bytes SSSE3,
+//  24/32 bytes AVX2, 48/64 bytes NEON), "base64" - decoded lengths of base64 strings { "value", "length" }
+static bool testByteArraySimd (
+        JSON_Object* joParams
+)
+{
+    JSON_Array* ja_lengths = json_object_get_array(joParams, "lengths");
+    JSON_Array* ja_base64 = json_object_get_array(joParams, "base64");
+    const int sets_features[] = {
+        0,
+        BA_SIMD_FEATURE_SSSE3,
+        BA_SIMD_FEATURE_SSSE3 | BA_SIMD_FEATURE_AVX2,
+        BA_SIMD_FEATURE_NEON
+    };
+    vector<size_t> lengths;
+    vector<int> used_features;
+    vector<uint8_t> data;
+    uint32_t seed = 0x12345678;
+    bool ok = true;
+
+    for (size_t i = 0; i <= (size_t)getParamU32(joParams, "maxLength", 256); i++) {
+        lengths.push_back(i);
+    }
+    for (size_t i = 0; i < json_array_get_count(ja_lengths); i++) {
+        lengths.push_back((size_t)json_array_get_number(ja_lengths, i));
+    }
+    data.resize(*max_element(lengths.begin(), lengths.end()));
+    for (auto& it : data) {
+        seed = seed * 1103515245 + 12345;
+        it = (uint8_t)(seed >> 16);
+    }
+
+    //  Every set of kernels that is supported by CPU is compared with the scalar code
+    for (const auto& features : sets_features) {
+        const int used = ba_simd_set_features(features);
+        if (find(used_features.begin(), used_features.end(), used) != used_features.end()) continue;
+
+        used_features.push_back(used);
+        for (size_t i = 0; ok && (i < lengths.size()); i++) {
+            ok = checkSimdKernels(data, lengths[i], (used != 0));
+        }
+        printf("kernels 0x%02X: %s\n", used, ok ? "ok" : "failed");
+    }
+    (void)ba_simd_set_features(-1);
+    if (!ok) return false;
+
+    for (size_t i = 0; i < lengths.size(); i++) {
+        if (!checkByteArrayCodecs(data, lengths[i])) return false;
+    }
+
+    //  Length of decoded value: exact for canonical string and with separators
+    for (size_t i = 0; i < json_array_get_count(ja_base64); i++) {
+        JSON_Object* jo_item = json_array_get_object(ja_base64, i);
+        const string s_value = ParsonHelper::jsonObjectGetString(jo_item, "value");
+        const size_t expected_len = (size_t)ParsonHelper::jsonObjectGetUint32(jo_item, "length", 0);
+        SmartBA sba_decoded;
+        if (!sba_decoded.set(ba_alloc_from_base64(s_value.c_str())) || (sba_decoded.size() != expected_len)) {
+            return checkFailed("base64 '%s': decoded %zu bytes, expected %zu", s_value.c_str(), sba_decoded.size(), expected_len);
+        }
+    }
+
+    printf("codecs: ok, %zu lengths\n", lengths.size());
+    return true;
+}
+
+
+
+//  =====  uapkic, modes of self-test  =====
+
+static const HashAlg SELF_TEST_HASH_ALGOS[] = {
+    HASH_ALG_DSTU7564_256, HASH_ALG_GOST34311, HASH_ALG_SHA256, HASH_ALG_SHA3_256, HASH_ALG_WHIRLPOOL
+};
+
+static bool hashByAlgos (
+        const ByteArray* baData,
+        vector<string>& hashes
+)
+{
+    hashes.clear();
+    for (const auto& hash_algo : SELF_TEST_HASH_ALGOS) {
+        SmartBA sba_hash;
+        if (::hash(hash_algo, baData, &sba_hash) != RET_OK) return false;
+        hashes.push_back(Util::baToHex(sba_hash.get()));
+    }
+    return true;
+}
+
+static bool parseSelfTestMode (
+        const string& name,
+        SelfTestMode& mode
+)
+{
+    if (name == "SERIAL") mode = SELF_TEST_MODE_SERIAL;
+    else if (name == "PARALLEL") mode = SELF_TEST_MODE_PARALLEL;
+    else if (name == "DEFERRED") mode = SELF_TEST_MODE_DEFERRED;
+    else return false;
+    return true;
+}
+
+//  Parameters: "modes" - names of SelfTestMode, "threads" - count of threads that use the algorithms at once.
+//  Each mode must pass the self-test, the algorithms must give the same hashes as after the serial self-test
+//  (in mode DEFERRED the threads run the self-tests of algorithms on the first use), the unknown mode is rejected
+static bool testSelfTestModes (
+        JSON_Object* joParams
+)
+{
+    JSON_Array* ja_modes = json_object_get_array(joParams, "modes");
+    const size_t cnt_threads = getParamU32(joParams, "threads", 4);
+    const char* s_data = "The quick brown fox jumps over the lazy dog";
+    SmartBA sba_data;
+    vector<string> expected_hashes;
+    uint32_t version = 0, status = 0;
+    int ret;
+
+    if (json_array_get_count(ja_modes) == 0) return checkFailed("no modes");
+    if (
+        !sba_data.set(ba_alloc_from_uint8((const uint8_t*)s_data, strlen(s_data))) ||
+        (uapkic_init_ex(&version, SELF_TEST_MODE_SERIAL, &status) != RET_OK) ||
+        !hashByAlgos(sba_data.get(), expected_hashes)
+    ) return checkFailed("serial self-test failed, status 0x%08X", status);
+
+    for (size_t i = 0; i < json_array_get_count(ja_modes); i++) {
+        const string s_mode = ParsonHelper::jsonArrayGetString(ja_modes, i);
+        SelfTestMode mode = SELF_TEST_MODE_SERIAL;
+        if (!parseSelfTestMode(s_mode, mode)) return checkFailed("unknown mode '%s'", s_mode.c_str());
+
+        status = 0xFFFFFFFF;
+        ret = uapkic_init_ex(&version, mode, &status);
+        if ((ret != RET_OK) || (status != 0)) {
+            return checkFailed("mode %s: returned %d, status 0x%08X", s_mode.c_str(), ret, status);
+        }
+
+        vector<vector<string>> thread_hashes(cnt_threads);
+        vector<thread> threads;
+        for (size_t j = 0; j < cnt_threads; j++) {
+            threads.emplace_back([&sba_data, &thread_hashes, j]() {
+                (void)hashByAlgos(sba_data.get(), thread_hashes[j]);
+            });
+        }
+        for (auto& it : threads) {
+            it.join();
+        }
+        for (size_t j = 0; j < cnt_threads; j++) {
+            if (thread_hashes[j] != expected_hashes) return checkFailed("mode %s: thread %zu gave other hashes", s_mode.c_str(), j);
+        }
+        if (uapkic_get_self_test_status() != 0) {
+            return checkFailed("mode %s: status after use 0x%08X", s_mode.c_str(), uapkic_get_self_test_status());
+        }
+        printf("mode %s: ok, threads: %zu\n", s_mode.c_str(), cnt_threads);
+    }
+
+    ret = uapkic_init_ex(nullptr, (SelfTestMode)(SELF_TEST_MODE_DEFERRED + 1), nullptr);
+    if (ret != RET_INVALID_PARAM) return checkFailed("unknown mode is not rejected, returned %d", ret);
+
+    //  Next tasks are run with the serial self-test
+    return (uapkic_init_ex(nullptr, SELF_TEST_MODE_SERIAL, nullptr) == RET_OK);
+}
+
+bool runInternalTest (
+        const string& method,
+        JSON_Object* joParams
+)
+{
+    bool passed = false;
+    if (method == string("_TEST_ASN1_ARENA")) {
+        passed = testAsn1Arena(joParams);
+    }
+    else if (method == string("_TEST_ASN1_COPY_EQUALS")) {
+        passed = testAsn1CopyEquals(joParams);
+    }
+    else if (method == string("_TEST_ASN1_FAST_DECODERS")) {
+        passed = testAsn1FastDecoders(joParams);
+    }
+    else if (method == string("_TEST_ASN1_TLV_CURSOR")) {
+        passed = testAsn1TlvCursor(joParams);
+    }
+    else if (method == string("_TEST_ASN1_VIEWS")) {
+        passed = testAsn1Views(joParams);
+    }
+    else if (method == string("_TEST_BYTE_ARRAY_SIMD")) {
+        passed = testByteArraySimd(joParams);
+    }
+    else if (method == string("_TEST_CERT_STATUS_INFO")) {
+        passed = testCertStatusInfo(joParams);
+    }
+    else if (method == string("_TEST_CER_ITEM_LAZY")) {
+        passed = testCerItemLazy(joParams);
+    }
+    else if (method == string("_TEST_CMS_STREAM_PARSER")) {
+        passed = testCmsStreamParser(joParams);
+    }
+    else if (method == string("_TEST_CRL_REFRESHER")) {
+        passed = testCrlRefresher(joParams);
+    }
+    else if (method == string("_TEST_CRL_REVOCATION_VIEW")) {
+        passed = testCrlRevocationView(joParams);
+    }
+    else if (method == string("_TEST_CRL_STREAM_PARSER")) {
+        passed = testCrlStreamParser(joParams);
+    }
+    else if (method == string("_TEST_DER_ENCODER")) {
+        passed = testDerEncoder(joParams);
+    }
+    else if (method == string("_TEST_DRBG_THREADS")) {
+        passed = testDrbgThreads(joParams);
+    }
+    else if (method == string("_TEST_OCSP_BATCH_RESPONSE")) {
+        passed = testOcspBatchResponse(joParams);
+    }
+    else if (method == string("_TEST_OCSP_CACHE_FILES")) {
+        passed = testOcspCacheFiles(joParams);
+    }
+    else if (method == string("_TEST_OCSP_CACHE_POLICY")) {
+        passed = testOcspCachePolicy(joParams);
+    }
+    else if (method == string("_TEST_OID_REGISTRY")) {
+        passed = testOidRegistry(joParams);
+    }
+    else if (method == string("_TEST_SELF_TEST_MODES")) {
+        passed = testSelfTestModes(joParams);
+    }
+    else if (method == string("_TEST_STORE_LOADER")) {
+        passed = testStoreLoader(joParams);
+    }
+    else {
+        return checkFailed("unknown method '%s'", method.c_str());
+    }
+
+    printf("%s\n", passed ? "PASSED" : "FAILED");
+    return passed;
+}
@@ -38,6 +38,9 @@
 #include <vector>
 #include "parson-helper.h"
 #include "uapki-loader.h"
+#ifdef UAPKI_TEST_INTERNAL
+#include "test-internal.h"
+#endif
 
 #ifdef _WIN32
  #include <windows.h>
@@ -201,6 +204,7 @@ int main (int argc, char *argv[])
     printf("hardware_concurrency: %d\n", thread::hardware_concurrency());
     vector<thread> threads;
     vector<uint32_t> threadIds;
+    size_t cnt_failedtests = 0;
 
     JSON_Array* ja_tasks = json.getArray("tasks");
     const size_t cnt_tasks = json_array_get_count(ja_tasks);
@@ -284,6 +288,13 @@ int main (int argc, char *argv[])
                     s_completemsg
                 )) break;
             }
+#ifdef UAPKI_TEST_INTERNAL
+            else if (s_method.compare(0, 6, "_TEST_") == 0) {
+                if (!runInternalTest(s_method, json_object_get_object(jo_task, "parameters"))) {
+                    cnt_failedtests++;
+                }
+            }
+#endif
         }
     }
 
@@ -293,5 +304,9 @@ int main (int argc, char *argv[])
         }
     }
 
+    if (cnt_failedtests > 0) {
+        printf("\nFailed tests: %zu\n", cnt_failedtests);
+        return -3;
+    }
     return 0;
 }
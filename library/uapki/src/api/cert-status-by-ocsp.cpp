@@ -52,8 +52,11 @@ int uapki_cert_status_by_ocsp (JSON_Object* joParams, JSON_Object* joResult)
     int ret = RET_OK;
     Ocsp::OcspHelper ocsp_helper;
     Cert::CerStore& cer_store = *cert_validator.getCerStore();
+    const Ocsp::OcspCache* ocsp_cache = get_ocspcache();
     Cert::CerItem* cer_issuer = nullptr;
-    SmartBA sba_issuercertid, sba_serialnumber, sba_issuerbytes, sba_resp;
+    SmartBA sba_issuercertid, sba_serialnumber, sba_issuerbytes, sba_resp, sba_certid;
+    bool from_ocspcache = false;
+    Ocsp::VerifiedResponse* verified_response = nullptr;
 
     const string s_url = ParsonHelper::jsonObjectGetString(joParams, "url");
     const uint32_t nonce_len = ParsonHelper::jsonObjectGetUint32(joParams, "nonceLen", 0);
@@ -102,6 +105,10 @@ int uapki_cert_status_by_ocsp (JSON_Object* joParams, JSON_Object* joResult)
     if ((nonce_len >= Ocsp::NONCE_MINLEN) && (nonce_len <= Ocsp::NONCE_MAXLEN)) {
         DO(ocsp_helper.genNonce(nonce_len));
     }
+    else if (ocsp_cache->isEnabled()) {
+        //  Request with nonce needs the fresh response, so the OCSP-cache is used only without nonce
+        DO(ocsp_helper.getRequestCertId(0, &sba_certid));
+    }
 
     DO(ocsp_helper.encodeRequest());
 
@@ -112,30 +119,76 @@ int uapki_cert_status_by_ocsp (JSON_Object* joParams, JSON_Object* joResult)
             SET_ERROR(RET_UAPKI_OFFLINE_MODE);
         }
 
-        lock_guard<mutex> lock(HttpHelper::lockUri(s_url));
+        if (!sba_certid.empty()) {
+            //  Response from the OCSP-cache is used if it is verified and fresh, else it is requested
+            Ocsp::OcspCache::Entry ocspcache_entry;
+            bool is_stale = false;
+            if (ocsp_cache->find(sba_certid.get(), TimeUtil::mtimeNow(), ocspcache_entry)) {
+                verified_response = new Ocsp::VerifiedResponse();
+                if (!verified_response) {
+                    SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+                }
+                from_ocspcache = (cert_validator.verifyCachedOcspResponse(
+                    sba_certid.get(),
+                    ocspcache_entry.baResponse.get(),
+                    false,
+                    *verified_response,
+                    is_stale
+                ) == RET_OK);
+                if (from_ocspcache) {
+                    (void)sba_resp.set(ocspcache_entry.baResponse.pop());
+                }
+                else {
+                    delete verified_response;
+                    verified_response = nullptr;
+                }
+            }
+        }
+
+        if (!from_ocspcache) {
+            lock_guard<mutex> lock(HttpHelper::lockUri(s_url));
 
-        DO(HttpHelper::post(
-            s_url,
-            HttpHelper::CONTENT_TYPE_OCSP_REQUEST,
-            ocsp_helper.getRequestEncoded(),
-            &sba_resp
-        ));
+            DO(HttpHelper::post(
+                s_url,
+                HttpHelper::CONTENT_TYPE_OCSP_REQUEST,
+                ocsp_helper.getRequestEncoded(),
+                &sba_resp
+            ));
+        }
 
         if (sba_resp.empty()) {
             SET_ERROR(RET_UAPKI_OCSP_RESPONSE_INVALID);
         }
         DO(json_object_set_base64(joResult, "bytes", sba_resp.get()));
 
-        ret = ocsp_helper.parseResponse(sba_resp.get());
-        DO_JSON(json_object_set_string(joResult, "responseStatus", Ocsp::responseStatusToStr(ocsp_helper.getResponseStatus())));
+        if (from_ocspcache) {
+            //  The response from the OCSP-cache is verified already
+            DO_JSON(json_object_set_string(joResult, "responseStatus", Ocsp::responseStatusToStr(Ocsp::ResponseStatus::SUCCESSFUL)));
+            DO(CertValidator::verifiedResponseToJson(joResult, *verified_response));
+        }
+        else {
+            ret = ocsp_helper.parseResponse(sba_resp.get());
+            DO_JSON(json_object_set_string(joResult, "responseStatus", Ocsp::responseStatusToStr(ocsp_helper.getResponseStatus())));
+
+            if ((ret == RET_OK) && (ocsp_helper.getResponseStatus() == Ocsp::ResponseStatus::SUCCESSFUL)) {
+                verified_response = new Ocsp::VerifiedResponse();
+                if (!verified_response) {
+                    SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+                }
+                DO(cert_validator.processResponseData(
+                    ocsp_helper,
+                    *verified_response,
+                    joResult
+                ));
+
+                if (!sba_certid.empty()) {
+                    (void)ocsp_cache->save(sba_certid.get(), verified_response->singleResponseInfo, sba_resp.get());
+                }
+            }
+        }
 
-        if ((ret == RET_OK) && (ocsp_helper.getResponseStatus() == Ocsp::ResponseStatus::SUCCESSFUL)) {
-            Ocsp::OcspHelper::SingleResponseInfo singleresp_info;
-            DO(cert_validator.processResponseData(
-                ocsp_helper,
-                singleresp_info,
-                joResult
-            ));
+        if (verified_response) {
+            const Ocsp::OcspHelper::SingleResponseInfo& singleresp_info = verified_response->singleResponseInfo;
 
             if (cer_issuer || !sba_issuerbytes.empty()) {
                 Cert::CerItem* cer_subject = nullptr;
@@ -147,11 +200,16 @@ int uapki_cert_status_by_ocsp (JSON_Object* joParams, JSON_Object* joResult)
                 }
                 if ((ret == RET_OK) && cer_subject) {
                     lock_guard<mutex> lock(cer_subject->getMutex());
-                    DO(cer_subject->getCertStatusByOcsp().set(
+                    ret = cer_subject->getCertStatusByOcsp().set(
                         singleresp_info.certStatus,
-                        singleresp_info.msThisUpdate + Ocsp::OFFSET_EXPIRE_DEFAULT,
-                        sba_resp.get()
-                    ));
+                        ocsp_cache->getValidTime(singleresp_info.msThisUpdate, singleresp_info.msNextUpdate),
+                        sba_resp.get(),
+                        verified_response
+                    );
+                    verified_response = nullptr;    //  Owned by CertStatusInfo
+                    if (ret != RET_OK) {
+                        SET_ERROR(ret);
+                    }
                 }
                 ret = RET_OK;   //  getCertByIssuerAndSN() may return RET_UAPKI_CERT_NOT_FOUND
             }
@@ -159,5 +217,6 @@ int uapki_cert_status_by_ocsp (JSON_Object* joParams, JSON_Object* joResult)
     }
 
 cleanup:
+    delete verified_response;
     return ret;
 }
@@ -100,7 +100,12 @@ static int generate_ephemeral_privkey (
     if (DstuNS::isDstu4145family(cerRecipient.getKeyAlgo())) {
         SmartBA sba_params;
         string s_params;
-        const ANY_t* algo_params = cerRecipient.getCert()->tbsCertificate.subjectPublicKeyInfo.algorithm.parameters;
+        const Certificate_t* cert = cerRecipient.getCert();
+        if (!cert) {
+            SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+        }
+
+        const ANY_t* algo_params = cert->tbsCertificate.subjectPublicKeyInfo.algorithm.parameters;
         if (!algo_params) {
             SET_ERROR(RET_UAPKI_INVALID_PARAMETER);
         }
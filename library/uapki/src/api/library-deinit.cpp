@@ -40,6 +40,7 @@ int uapki_deinit (JSON_Object* joParams, JSON_Object* joResult)
     (void)joParams;
     (void)joResult;
 
+    stop_refreshers();
     release_config();
     CmProviders::deinit();
     release_stores();
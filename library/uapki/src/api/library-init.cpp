@@ -34,6 +34,7 @@
 #include "parson-helper.h"
 #include "tsp-helper.h"
 #include "uapki-ns-util.h"
+#include "uapkic.h"
 
 
 using namespace std;
@@ -144,6 +145,21 @@ cleanup:
     return ret;
 }   //  setup_crl_cache
 
+static int setup_crl_refresher (JSON_Object* joParams, const bool offline)
+{
+    Crl::CrlRefresher::Params refresher_params;
+    JSON_Object* jo_refresh = json_object_get_object(joParams, "refresh");
+
+    if (!jo_refresh || offline) return RET_OK;
+    if (!ParsonHelper::jsonObjectGetBoolean(jo_refresh, "enabled", true)) return RET_OK;
+
+    //  =leadTime=, =jitter= (in seconds)
+    refresher_params.leadTime = ParsonHelper::jsonObjectGetUint32(jo_refresh, "leadTime", Crl::CrlRefresher::Params::LEAD_TIME_DEFAULT);
+    refresher_params.jitter = ParsonHelper::jsonObjectGetUint32(jo_refresh, "jitter", Crl::CrlRefresher::Params::JITTER_DEFAULT);
+
+    return start_crlrefresher(refresher_params);
+}   //  setup_crl_refresher
+
 static int setup_ocsp (LibraryConfig& libConfig, JSON_Object* joParams)
 {
     LibraryConfig::OcspParams ocsp_params;
@@ -154,10 +170,70 @@ static int setup_ocsp (LibraryConfig& libConfig, JSON_Object* joParams)
         ocsp_params.nonceLen = 0;
     }
 
+    //  =minTtl=, =maxTtl=, =useNextUpdate=
+    ocsp_params.minTtl = ParsonHelper::jsonObjectGetUint32(joParams, "minTtl", LibraryConfig::OcspParams::MIN_TTL_DEFAULT);
+    ocsp_params.maxTtl = ParsonHelper::jsonObjectGetUint32(joParams, "maxTtl", LibraryConfig::OcspParams::MAX_TTL_DEFAULT);
+    if (ocsp_params.maxTtl < ocsp_params.minTtl) {
+        ocsp_params.maxTtl = ocsp_params.minTtl;
+    }
+    ocsp_params.useNextUpdate = ParsonHelper::jsonObjectGetBoolean(joParams, "useNextUpdate", true);
+
+    //  =negativeTtl=, =negativeTtlMax=
+    ocsp_params.negativeTtl = ParsonHelper::jsonObjectGetUint32(joParams, "negativeTtl", LibraryConfig::OcspParams::NEGATIVE_TTL_DEFAULT);
+    ocsp_params.negativeTtlMax = ParsonHelper::jsonObjectGetUint32(joParams, "negativeTtlMax", LibraryConfig::OcspParams::NEGATIVE_TTL_MAX_DEFAULT);
+    if (ocsp_params.negativeTtlMax < ocsp_params.negativeTtl) {
+        ocsp_params.negativeTtlMax = ocsp_params.negativeTtl;
+    }
+
+    //  =staleTtl=
+    ocsp_params.staleTtl = ParsonHelper::jsonObjectGetUint32(joParams, "staleTtl", LibraryConfig::OcspParams::STALE_TTL_DEFAULT);
+
     libConfig.setOcsp(ocsp_params);
     return RET_OK;
 }   //  setup_ocsp
 
+static int setup_ocsp_cache (const LibraryConfig& libConfig, JSON_Object* joParams)
+{
+    Ocsp::OcspCache& ocsp_cache = *get_ocspcache();
+
+    //  Without path the OCSP-responses are cached in memory only (in CerItem), the policy is used anyway
+    ocsp_cache.setParams(ParsonHelper::jsonObjectGetString(joParams, "path"), libConfig.getOcsp());
+    return RET_OK;
+}   //  setup_ocsp_cache
+
+static int setup_ocsp_refresher (const LibraryConfig& libConfig, const bool offline)
+{
+    //  Stale-while-revalidate needs background refresh, without staleTtl nothing to do
+    if (offline || (libConfig.getOcsp().staleTtl == 0)) return RET_OK;
+
+    return start_ocsprefresher();
+}   //  setup_ocsp_refresher
+
+static int setup_self_test (JSON_Object* joParams, string& selfTestMode, uint32_t& selfTestStatus)
+{
+    SelfTestMode mode = SELF_TEST_MODE_SERIAL;
+
+    //  Without "selfTest" the self-test of algorithms is not run (as before)
+    if (!joParams) return RET_OK;
+
+    //  =mode=: "SERIAL" (default), "PARALLEL" or "DEFERRED"
+    selfTestMode = ParsonHelper::jsonObjectGetString(joParams, "mode", "SERIAL");
+    if (selfTestMode == "SERIAL") {
+        mode = SELF_TEST_MODE_SERIAL;
+    }
+    else if (selfTestMode == "PARALLEL") {
+        mode = SELF_TEST_MODE_PARALLEL;
+    }
+    else if (selfTestMode == "DEFERRED") {
+        mode = SELF_TEST_MODE_DEFERRED;
+    }
+    else {
+        return RET_UAPKI_INVALID_PARAMETER;
+    }
+
+    return uapkic_init_ex(nullptr, mode, &selfTestStatus);
+}   //  setup_self_test
+
 static int setup_tsp (LibraryConfig& libConfig, JSON_Object* joParams)
 {
     LibraryConfig::TspParams tsp_params;
@@ -214,6 +290,8 @@ int uapki_init (JSON_Object* joParams, JSON_Object* joResult)
     JSON_Object* jo_category = nullptr;
     size_t cnt_certs, cnt_crls, cnt_trustedcerts;
     bool offline;
+    string s_selftestmode;
+    uint32_t selftest_status = 0;
 
     if (!lib_config || !lib_cerstore || !lib_crlstore) {
         SET_ERROR(RET_UAPKI_GENERAL_ERROR);
@@ -226,7 +304,9 @@ int uapki_init (JSON_Object* joParams, JSON_Object* joResult)
         jo_refparams = json.rootObject();
     }
 
-    //  Setup subsystems
+    //  Setup subsystems, the self-test is first: the stores verify signatures on loading
+    DO(setup_self_test(json_object_get_object(jo_refparams, "selfTest"), s_selftestmode, selftest_status));
+
     DO(setup_cm_providers(json_object_get_object(jo_refparams, "cmProviders")));
 
     DO(setup_cert_cache(json_object_get_object(jo_refparams, "certCache")));
@@ -235,6 +315,8 @@ int uapki_init (JSON_Object* joParams, JSON_Object* joResult)
 
     DO(setup_ocsp(*lib_config, json_object_get_object(jo_refparams, "ocsp")));
 
+    DO(setup_ocsp_cache(*lib_config, json_object_get_object(jo_refparams, "ocspCache")));
+
     offline = ParsonHelper::jsonObjectGetBoolean(jo_refparams, "offline", false);
     lib_config->setOffline(offline);
 
@@ -249,6 +331,10 @@ int uapki_init (JSON_Object* joParams, JSON_Object* joResult)
         );
     }
 
+    DO(setup_crl_refresher(json_object_get_object(jo_refparams, "crlCache"), offline));
+
+    DO(setup_ocsp_refresher(*lib_config, offline));
+
     lib_config->setValidationByCrl(ParsonHelper::jsonObjectGetBoolean(jo_refparams, "validationByCrl", false));
 
     lib_config->setInitialized(true);
@@ -265,6 +351,13 @@ int uapki_init (JSON_Object* joParams, JSON_Object* joResult)
     (void)lib_crlstore->getCount(cnt_crls);
     DO_JSON(ParsonHelper::jsonObjectSetUint32(jo_category, "countCrls", (uint32_t)cnt_crls));
     DO_JSON(ParsonHelper::jsonObjectSetBoolean(jo_category, "useDeltaCrl", lib_crlstore->useDeltaCrl()));
+    if (get_crlrefresher()) {
+        const Crl::CrlRefresher::Params& refresher_params = get_crlrefresher()->getParams();
+        DO_JSON(json_object_set_value(jo_category, "refresh", json_value_init_object()));
+        JSON_Object* jo_refresh = json_object_get_object(jo_category, "refresh");
+        DO_JSON(ParsonHelper::jsonObjectSetUint32(jo_refresh, "leadTime", refresher_params.leadTime));
+        DO_JSON(ParsonHelper::jsonObjectSetUint32(jo_refresh, "jitter", refresher_params.jitter));
+    }
 
     DO_JSON(ParsonHelper::jsonObjectSetUint32(joResult, "countCmProviders", (uint32_t)CmProviders::count()));
 
@@ -275,6 +368,18 @@ int uapki_init (JSON_Object* joParams, JSON_Object* joResult)
     if (jo_category) {
         const LibraryConfig::OcspParams& ocsp_params = lib_config->getOcsp();
         DO_JSON(ParsonHelper::jsonObjectSetUint32(jo_category, "nonceLen", (uint32_t)ocsp_params.nonceLen));
+        DO_JSON(ParsonHelper::jsonObjectSetUint32(jo_category, "minTtl", ocsp_params.minTtl));
+        DO_JSON(ParsonHelper::jsonObjectSetUint32(jo_category, "maxTtl", ocsp_params.maxTtl));
+        DO_JSON(ParsonHelper::jsonObjectSetBoolean(jo_category, "useNextUpdate", ocsp_params.useNextUpdate));
+        DO_JSON(ParsonHelper::jsonObjectSetUint32(jo_category, "negativeTtl", ocsp_params.negativeTtl));
+        DO_JSON(ParsonHelper::jsonObjectSetUint32(jo_category, "negativeTtlMax", ocsp_params.negativeTtlMax));
+        DO_JSON(ParsonHelper::jsonObjectSetUint32(jo_category, "staleTtl", ocsp_params.staleTtl));
+    }
+
+    if (get_ocspcache()->isEnabled()) {
+        DO_JSON(json_object_set_value(joResult, "ocspCache", json_value_init_object()));
+        jo_category = json_object_get_object(joResult, "ocspCache");
+        DO_JSON(json_object_set_string(jo_category, "path", get_ocspcache()->getPath().c_str()));
     }
 
     DO_JSON(json_object_set_value(joResult, "proxy", json_value_init_object()));
@@ -296,10 +401,18 @@ int uapki_init (JSON_Object* joParams, JSON_Object* joResult)
         DO_JSON(json_object_set_string(jo_category, "url", s_url.c_str()));
     }
 
+    if (!s_selftestmode.empty()) {
+        DO_JSON(json_object_set_value(joResult, "selfTest", json_value_init_object()));
+        jo_category = json_object_get_object(joResult, "selfTest");
+        DO_JSON(json_object_set_string(jo_category, "mode", s_selftestmode.c_str()));
+        DO_JSON(ParsonHelper::jsonObjectSetUint32(jo_category, "status", selftest_status));
+    }
+
     DO_JSON(ParsonHelper::jsonObjectSetBoolean(joResult, "validationByCrl", lib_config->getValidationByCrl()));
 
 cleanup:
     if (ret != RET_OK) {
+        stop_refreshers();
         release_config();
         CmProviders::deinit();
         release_stores();
@@ -32,6 +32,7 @@
 #include "global-objects.h"
 #include "parson-ba-utils.h"
 #include "parson-helper.h"
+#include "oid-registry.h"
 #include "oid-utils.h"
 #include "store-json.h"
 #include "uapki-errors.h"
@@ -129,25 +130,24 @@ static int extensions_to_json (
 
     for (int i = 0; i < extns->list.count; i++) {
         const Extension_t* extn = extns->list.array[i];
-        string s_extnid;
+        SmartBA sba_value;
 
-        DO(Util::oidFromAsn1(&extn->extnID, s_extnid));
-
-        if (oid_is_equal(s_extnid.c_str(), OID_X509v3_BasicConstraints)) {
-            SmartBA sba_value;
+        switch (oid_id_from_OID(&extn->extnID)) {
+        case OID_ID_X509v3_BasicConstraints:
             DO(asn_OCTSTRING2ba(&extn->extnValue, &sba_value));
             DO(basicconstraints_to_json(joResult, sba_value.get()));
-        }
-        else if (oid_is_equal(s_extnid.c_str(), OID_X509v3_KeyUsage)) {
-            SmartBA sba_value;
+            break;
+        case OID_ID_X509v3_KeyUsage:
             DO(asn_OCTSTRING2ba(&extn->extnValue, &sba_value));
             DO_JSON(json_object_set_value(joResult, "keyUsage", json_value_init_object()));
             DO(ExtensionHelper::DecodeToJsonObject::keyUsage(sba_value.get(), json_object_get_object(joResult, "keyUsage")));
-        }
-        else if (oid_is_equal(s_extnid.c_str(), OID_X509v3_ExtendedKeyUsage)) {
-            SmartBA sba_value;
+            break;
+        case OID_ID_X509v3_ExtendedKeyUsage:
             DO(asn_OCTSTRING2ba(&extn->extnValue, &sba_value));
             DO(extendedkeyusage_to_json(joResult, sba_value.get()));
+            break;
+        default:
+            break;
         }
     }
 
@@ -160,8 +160,11 @@ static int info_to_json (
         const Cert::CerItem* cerItem
 )
 {
+    const Certificate_t* cert = cerItem->getCert();
+    if (!cert) return RET_UAPKI_INVALID_STRUCT;
+
     int ret = RET_OK;
-    const TBSCertificate_t& tbs_cert = cerItem->getCert()->tbsCertificate;
+    const TBSCertificate_t& tbs_cert = cert->tbsCertificate;
 
     DO(json_object_set_base64(joResult, "certId", cerItem->getCertId()));
 
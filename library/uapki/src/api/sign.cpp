@@ -551,6 +551,24 @@ int uapki_sign (
     if ((sign_params.signatureFormat != UapkiNS::SignatureFormat::RAW) && ((!sign_params.sidUseKeyId || sign_params.includeCert))) {
         DO(cer_store.getCertByKeyId(sign_params.keyId.get(), &sign_params.signer.pCerSubject));
         if (sign_params.isCadesFormat) {
+            if (sign_params.isCadesCXA) {
+                vector<Cert::CerItem*> service_certs;
+                DO(cer_store.getChainCerts(sign_params.signer.pCerSubject, service_certs));
+                for (auto& it : service_certs) {
+                    DO(sign_params.addCert(it));
+                }
+                if (sign_params.signatureFormat != UapkiNS::SignatureFormat::CADES_C) {
+                    //  Statuses of the signer and of the chain are requested together, one OCSP-request for each responder
+                    vector<Cert::CerItem*> cer_subjects;
+                    if (!sign_options.ignoreCertStatus) {
+                        cer_subjects.push_back(sign_params.signer.pCerSubject);
+                    }
+                    for (const auto& it : sign_params.chainCerts) {
+                        cer_subjects.push_back(it->pCerSubject);
+                    }
+                    (void)cert_validator.prefetchOcsp(cer_subjects);
+                }
+            }
             if (!sign_options.ignoreCertStatus) {
                 if (
                     (sign_params.signatureFormat == UapkiNS::SignatureFormat::CADES_C) ||
@@ -567,11 +585,6 @@ int uapki_sign (
             DO(sign_params.signer.pCerSubject->generateEssCertId(sign_params.aidDigest, &ess_certid));
             DO(Doc::Sign::SigningDoc::encodeSigningCertificate(*ess_certid, sign_params.attrSigningCert));
             if (sign_params.isCadesCXA) {
-                vector<Cert::CerItem*> service_certs;
-                DO(cer_store.getChainCerts(sign_params.signer.pCerSubject, service_certs));
-                for (auto& it : service_certs) {
-                    DO(sign_params.addCert(it));
-                }
                 for (auto& it : sign_params.chainCerts) {
                     if (sign_params.signatureFormat != UapkiNS::SignatureFormat::CADES_C) {
                         DO(get_cert_status_by_ocsp(cert_validator, sign_params, *it));
@@ -652,6 +665,7 @@ int uapki_sign (
             vba_signatures
         ));
 
+        vector<Cert::CerItem*> cer_subjects;
         for (size_t i = 0; i < signing_docs.size(); i++) {
             Doc::Sign::SigningDoc& sdoc = signing_docs[i];
             DO(sdoc.setSignature(vba_signatures[i]));
@@ -669,7 +683,20 @@ int uapki_sign (
                 for (auto& it : chain_certs) {
                     DO(sdoc.addCert(it));
                 }
+                for (const auto& it : sdoc.getCerts()) {
+                    cer_subjects.push_back(it->pCerSubject);
+                }
+            }
+        }
 
+        //  Statuses of the certificates of all documents (TSP-certificates and their chains) are requested together
+        if (sign_params.isCadesCXA && (sign_params.signatureFormat != UapkiNS::SignatureFormat::CADES_C)) {
+            (void)cert_validator.prefetchOcsp(cer_subjects);
+        }
+
+        for (size_t i = 0; i < signing_docs.size(); i++) {
+            Doc::Sign::SigningDoc& sdoc = signing_docs[i];
+            if (sign_params.isCadesCXA) {
                 const vector<Doc::Sign::SigningDoc::CerDataItem*> certs = sdoc.getCerts();
                 for (auto& it : certs) {
                     if (sign_params.signatureFormat != UapkiNS::SignatureFormat::CADES_C) {
@@ -561,32 +561,71 @@ static int validate_by_ocsp (
 )
 {
     int ret = RET_OK;
-    Ocsp::OcspHelper ocsp_helper;
-    SmartBA sba_sn;
 
+    //  Status, producedAt and statusSignature are set by validateByOcsp(), the single response
+    //  is matched to the certificate by CertID
     DO(verifiedSignerInfo.validateByOcsp(
         certChainItem.getSubject(),
         certChainItem.getIssuer(),
         certChainItem.getResultValidationByOcsp()
     ));
-
-    DO(ocsp_helper.parseBasicOcspResponse(certChainItem.getResultValidationByOcsp().basicOcspResponse.get()));
-    DO(ocsp_helper.scanSingleResponses());
-    DO(ocsp_helper.getSerialNumberFromCertId(0, &sba_sn));  //  Work with one OCSP request that has one certificate
-    if (ba_cmp(sba_sn.get(), certChainItem.getSubject()->getSerialNumber()) == 0) {
-        CertValidator::ResultValidationByOcsp& result_valbyocsp = certChainItem.getResultValidationByOcsp();
-        result_valbyocsp.dataSource = CertValidator::DataSource::STORE;
-        result_valbyocsp.responseStatus = Ocsp::ResponseStatus::SUCCESSFUL;
-        result_valbyocsp.statusSignature = SignatureVerifyStatus::VALID; // Previous check is passed
-        result_valbyocsp.msProducedAt = ocsp_helper.getProducedAt();
-        result_valbyocsp.singleResponseInfo = ocsp_helper.getSingleResponseInfo(0); //  Work with one OCSP request that has one certificate
-    }
+    certChainItem.getResultValidationByOcsp().dataSource = CertValidator::DataSource::STORE;
     certChainItem.setValidationType(Cert::ValidationType::OCSP);
 
 cleanup:
     return ret;
 }   //  validate_by_ocsp
 
+static bool is_verified_signer (
+        const Doc::Verify::VerifyOptions& verifyOptions,
+        const size_t idx
+)
+{
+    return (verifyOptions.verifySignerInfoIndex < 0) || (verifyOptions.verifySignerInfoIndex == (int)idx);
+}   //  is_verified_signer
+
+static void prefetch_ocsp (
+        Doc::Verify::VerifySignedDoc& verifySignedDoc
+)
+{
+    const Doc::Verify::VerifyOptions& verify_options = verifySignedDoc.verifyOptions;
+    Doc::Verify::VerifiedSignerInfo* verified_sinfo = nullptr;
+    vector<Cert::CerItem*> cer_subjects;
+
+    if (verify_options.validationType != Doc::Verify::VerifyOptions::ValidationType::FULL) return;
+
+    //  Chains of all signers are collected, the statuses are requested once for each OCSP-responder
+    for (size_t idx = 0; idx < verifySignedDoc.verifiedSignerInfos.size(); idx++) {
+        Doc::Verify::VerifiedSignerInfo& it_sinfo = verifySignedDoc.verifiedSignerInfos[idx];
+        if (!is_verified_signer(verify_options, idx)) continue;
+
+        switch (it_sinfo.getSignatureFormat()) {
+        case SignatureFormat::CMS_SID_KEYID:
+        case SignatureFormat::CADES_BES:
+        case SignatureFormat::CADES_T:
+            it_sinfo.validateValidityTimeCerts(it_sinfo.getBestSignatureTime());
+            if (!verify_options.onlyCrl) {
+                for (const auto& it : it_sinfo.getCertChainItems()) {
+                    if (!it->isExpired() && (it->getValidationType() == Cert::ValidationType::UNDEFINED)) {
+                        cer_subjects.push_back(it->getSubject());
+                    }
+                }
+                if (!verified_sinfo) {
+                    verified_sinfo = &it_sinfo;
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    //  Statuses are kept in certificates, so any of validators can request them
+    if (verified_sinfo && !cer_subjects.empty()) {
+        (void)verified_sinfo->prefetchOcsp(cer_subjects);
+    }
+}   //  prefetch_ocsp
+
 static int validate_certs (
         Doc::Verify::VerifySignedDoc& verifySignedDoc,
         Doc::Verify::VerifiedSignerInfo& verifiedSignerInfo
@@ -607,7 +646,7 @@ static int validate_certs (
         case SignatureFormat::CMS_SID_KEYID:
         case SignatureFormat::CADES_BES:
         case SignatureFormat::CADES_T:
-            verifiedSignerInfo.validateValidityTimeCerts(bestsign_time);
+            //  Validity time is checked and statuses are prefetched by prefetch_ocsp()
             for (auto& it : verifiedSignerInfo.getCertChainItems()) {
                 if (!it->isExpired()) {
                     if (it->getValidationType() == Cert::ValidationType::UNDEFINED) {
@@ -669,6 +708,7 @@ cleanup:
 
 static int verify_p7s (
         const ByteArray* baSignature,
+        const char* signatureFile,
         ContentHasher& contentHasher,
         const bool isDigest,
         const Doc::Verify::VerifyOptions& verifyOptions,
@@ -687,8 +727,13 @@ static int verify_p7s (
         SET_ERROR(RET_UAPKI_GENERAL_ERROR);
     }
 
-    DO(verify_sdoc.parse(baSignature));
-    DO(verify_sdoc.getContent(contentHasher));
+    if (!signatureFile) {
+        DO(verify_sdoc.parse(baSignature));
+        DO(verify_sdoc.getContent(contentHasher));
+    }
+    else {
+        DO(verify_sdoc.parseFile(signatureFile, contentHasher));
+    }
     DO(verify_sdoc.addCertsToStore());
 
     //  For each signer_info
@@ -708,10 +753,7 @@ static int verify_p7s (
         }
 
         DO(verified_sinfo.parseAttributes());
-        if (
-            (verifyOptions.verifySignerInfoIndex < 0) ||
-            (verifyOptions.verifySignerInfoIndex == idx)
-        ) {
+        if (is_verified_signer(verifyOptions, idx)) {
             DO(verified_sinfo.verifySignedAttribute());
             DO(verified_sinfo.verifyMessageDigest(*verify_sdoc.refContentHasher));
             DO(verified_sinfo.verifySigningCertificateV2());
@@ -727,6 +769,13 @@ static int verify_p7s (
             if (verifyOptions.validationType >= Doc::Verify::VerifyOptions::ValidationType::CHAIN) {
                 DO(verified_sinfo.buildCertChain());
             }
+        }
+    }
+
+    prefetch_ocsp(verify_sdoc);
+    for (size_t idx = 0; idx < verify_sdoc.verifiedSignerInfos.size(); idx++) {
+        Doc::Verify::VerifiedSignerInfo& verified_sinfo = verify_sdoc.verifiedSignerInfos[idx];
+        if (is_verified_signer(verifyOptions, idx)) {
             DO(validate_certs(verify_sdoc, verified_sinfo));
             verified_sinfo.validateStatusCerts();
         }
@@ -823,7 +872,9 @@ int uapki_verify_signature (
     jo_signparams = json_object_get_object(joParams, "signParams");
     jo_signerpubkey = json_object_get_object(joParams, "signerPubkey");
     const bool is_digest = ParsonHelper::jsonObjectGetBoolean(jo_signature, "isDigest", false);
-    if (!sba_signature.set(json_object_get_base64(jo_signature, "bytes"))) {
+    //  Large P7S-signature (e.g. with attached content) can be passed as file, it is read by parts
+    const char* signature_file = json_object_get_string(jo_signature, "signatureFile");
+    if (!signature_file && !sba_signature.set(json_object_get_base64(jo_signature, "bytes"))) {
         SET_ERROR(RET_UAPKI_INVALID_PARAMETER);
     }
 
@@ -854,6 +905,7 @@ int uapki_verify_signature (
         DO(parse_verify_options(json_object_get_object(joParams, "options"), verify_options));
         DO(verify_p7s(
             sba_signature.get(),
+            signature_file,
             content_hasher,
             is_digest,
             verify_options,
@@ -862,7 +914,7 @@ int uapki_verify_signature (
     }
     else if (jo_signparams && jo_signerpubkey) {
         //  Is RAW-signature
-        if (!content_hasher.getContentBytes() || !jo_signparams || !jo_signerpubkey) {
+        if (!sba_signature.get() || !content_hasher.getContentBytes() || !jo_signparams || !jo_signerpubkey) {
             SET_ERROR(RET_UAPKI_INVALID_PARAMETER);
         }
         DO(verify_raw(
@@ -33,6 +33,8 @@
 #include "dstu-ns.h"
 #include "extension-helper.h"
 #include "macros-internal.h"
+#include "oid-registry.h"
+#include "ocsp-helper.h"
 #include "oids.h"
 #include "time-util.h"
 #include "uapki-errors.h"
@@ -83,26 +85,158 @@ void debug_ceritem_info (CerItem& cerItem)
 }   //  debug_ceritem_info
 #endif
 
+struct TlvRange {
+    size_t      offset;
+    size_t      headerLength;
+    size_t      length;
+    uint8_t     tag;
+};  //  end struct TlvRange
+
+struct CertTlvs {
+    TlvRange    tbs;
+    TlvRange    serialNumber;
+    TlvRange    issuer;
+    TlvRange    validity;
+    TlvRange    subject;
+    TlvRange    spki;
+    TlvRange    extensions;
+};  //  end struct CertTlvs
+
+static bool read_tlv (
+        const ByteArray* baEncoded,
+        const size_t offset,
+        const size_t end,
+        TlvRange& tlv
+)
+{
+    const uint8_t* buf = ba_get_buf_const(baEncoded);
+    if ((end > ba_get_len(baEncoded)) || (offset + 2 > end)) return false;
+
+    //  Only low-tag-number form and definite length, as DER for X.509 requires
+    size_t pos = offset;
+    tlv.tag = buf[pos++];
+    if ((tlv.tag & 0x1F) == 0x1F) return false;
+
+    size_t len = buf[pos++];
+    if (len & 0x80) {
+        const size_t cnt = len & 0x7F;
+        if ((cnt == 0) || (cnt > sizeof(size_t)) || (pos + cnt > end)) return false;
+        len = 0;
+        for (size_t i = 0; i < cnt; i++) {
+            len = (len << 8) | buf[pos++];
+        }
+    }
+    if (len > end - pos) return false;
+
+    tlv.offset = offset;
+    tlv.headerLength = pos - offset;
+    tlv.length = tlv.headerLength + len;
+    return true;
+}   //  read_tlv
+
+static bool read_tlv_tagged (
+        const ByteArray* baEncoded,
+        const size_t offset,
+        const size_t end,
+        const uint8_t tag,
+        TlvRange& tlv
+)
+{
+    return read_tlv(baEncoded, offset, end, tlv) && (tlv.tag == tag);
+}   //  read_tlv_tagged
+
+static int scan_cert_tlvs (
+        const ByteArray* baEncoded,
+        CertTlvs& tlvs
+)
+{
+    TlvRange tlv_cert, tlv;
+
+    if (!read_tlv_tagged(baEncoded, 0, ba_get_len(baEncoded), 0x30, tlv_cert)) return RET_UAPKI_INVALID_STRUCT;
+    const size_t end_cert = tlv_cert.offset + tlv_cert.length;
+    if (!read_tlv_tagged(baEncoded, tlv_cert.headerLength, end_cert, 0x30, tlvs.tbs)) return RET_UAPKI_INVALID_STRUCT;
+
+    const size_t end_tbs = tlvs.tbs.offset + tlvs.tbs.length;
+    size_t pos = tlvs.tbs.offset + tlvs.tbs.headerLength;
+    if (!read_tlv(baEncoded, pos, end_tbs, tlv)) return RET_UAPKI_INVALID_STRUCT;
+    if (tlv.tag == 0xA0) {
+        pos += tlv.length;
+    }
+    if (!read_tlv_tagged(baEncoded, pos, end_tbs, 0x02, tlvs.serialNumber)) return RET_UAPKI_INVALID_STRUCT;
+    pos += tlvs.serialNumber.length;
+    //  signature AlgorithmIdentifier
+    if (!read_tlv_tagged(baEncoded, pos, end_tbs, 0x30, tlv)) return RET_UAPKI_INVALID_STRUCT;
+    pos += tlv.length;
+    if (!read_tlv_tagged(baEncoded, pos, end_tbs, 0x30, tlvs.issuer)) return RET_UAPKI_INVALID_STRUCT;
+    pos += tlvs.issuer.length;
+    if (!read_tlv_tagged(baEncoded, pos, end_tbs, 0x30, tlvs.validity)) return RET_UAPKI_INVALID_STRUCT;
+    pos += tlvs.validity.length;
+    if (!read_tlv_tagged(baEncoded, pos, end_tbs, 0x30, tlvs.subject)) return RET_UAPKI_INVALID_STRUCT;
+    pos += tlvs.subject.length;
+    if (!read_tlv_tagged(baEncoded, pos, end_tbs, 0x30, tlvs.spki)) return RET_UAPKI_INVALID_STRUCT;
+    pos += tlvs.spki.length;
+
+    //  Skip issuerUniqueID [1] and subjectUniqueID [2], extensions [3] are required
+    memset(&tlvs.extensions, 0, sizeof(TlvRange));
+    while (pos < end_tbs) {
+        if (!read_tlv(baEncoded, pos, end_tbs, tlv)) return RET_UAPKI_INVALID_STRUCT;
+        if (tlv.tag == 0xA3) {
+            if (!read_tlv_tagged(baEncoded, pos + tlv.headerLength, pos + tlv.length, 0x30, tlvs.extensions)) return RET_UAPKI_INVALID_STRUCT;
+        }
+        pos += tlv.length;
+    }
+    if (tlvs.extensions.length == 0) return RET_UAPKI_INVALID_STRUCT;
+
+    //  signatureAlgorithm and signatureValue
+    if (!read_tlv_tagged(baEncoded, end_tbs, end_cert, 0x30, tlv)) return RET_UAPKI_INVALID_STRUCT;
+    if (!read_tlv_tagged(baEncoded, tlv.offset + tlv.length, end_cert, 0x03, tlv)) return RET_UAPKI_INVALID_STRUCT;
+
+    return RET_OK;
+}   //  scan_cert_tlvs
+
+static ByteArray* tlv_to_view (
+        const ByteArray* baEncoded,
+        const TlvRange& tlv
+)
+{
+    return ba_alloc_view(ba_get_buf_const(baEncoded) + tlv.offset, tlv.length);
+}   //  tlv_to_view
+
 static int encode_issuer_and_sn (
-        const TBSCertificate_t* tbsCert,
+        const ByteArray* baEncoded,
+        const TlvRange& tlvIssuer,
+        const TlvRange& tlvSerialNumber,
         ByteArray** baIssuerAndSN
 )
 {
-    int ret = RET_OK;
-    IssuerAndSerialNumber_t* issuer_and_sn = nullptr;
+    const uint8_t* buf = ba_get_buf_const(baEncoded);
+    const size_t len = tlvIssuer.length + tlvSerialNumber.length;
+    uint8_t hdr[1 + 1 + sizeof(size_t)];
+    size_t hdr_len = 0, cnt = 0;
 
-    if (!tbsCert || !baIssuerAndSN) return RET_UAPKI_INVALID_PARAMETER;
-
-    CHECK_NOT_NULL(issuer_and_sn = (IssuerAndSerialNumber_t*)calloc(1, sizeof(IssuerAndSerialNumber_t)));
+    //  IssuerAndSerialNumber ::= SEQUENCE { issuer Name, serialNumber INTEGER } from the DER-encoded parts
+    hdr[hdr_len++] = 0x30;
+    if (len < 0x80) {
+        hdr[hdr_len++] = (uint8_t)len;
+    }
+    else {
+        for (size_t l = len; l > 0; l >>= 8) cnt++;
+        hdr[hdr_len++] = (uint8_t)(0x80 | cnt);
+        for (size_t i = cnt; i > 0; i--) {
+            hdr[hdr_len++] = (uint8_t)(len >> (8 * (i - 1)));
+        }
+    }
 
-    DO(asn_copy(get_Name_desc(), &tbsCert->issuer, &issuer_and_sn->issuer));
-    DO(asn_copy(get_INTEGER_desc(), &tbsCert->serialNumber, &issuer_and_sn->serialNumber));
+    ByteArray* ba_issuerandsn = ba_alloc_by_len(hdr_len + len);
+    if (!ba_issuerandsn) return RET_UAPKI_GENERAL_ERROR;
 
-    DO(asn_encode_ba(get_IssuerAndSerialNumber_desc(), issuer_and_sn, baIssuerAndSN));
+    uint8_t* dst = ba_get_buf(ba_issuerandsn);
+    memcpy(dst, hdr, hdr_len);
+    memcpy(dst + hdr_len, buf + tlvIssuer.offset, tlvIssuer.length);
+    memcpy(dst + hdr_len + tlvIssuer.length, buf + tlvSerialNumber.offset, tlvSerialNumber.length);
 
-cleanup:
-    asn_free(get_IssuerAndSerialNumber_desc(), issuer_and_sn);
-    return ret;
+    *baIssuerAndSN = ba_issuerandsn;
+    return RET_OK;
 }   //  encode_issuer_and_sn
 
 static int scan_and_parse_uris (
@@ -113,25 +247,26 @@ static int scan_and_parse_uris (
     int ret = RET_OK;
     for (int i = 0; i < extns.list.count; i++) {
         const Extension_t* extn = extns.list.array[i];
-        if (OID_is_equal_oid(&extn->extnID, OID_X509v3_CRLDistributionPoints)) {
-            SmartBA sba_extnvalue;
+        SmartBA sba_extnvalue;
+        switch (oid_id_from_OID(&extn->extnID)) {
+        case OID_ID_X509v3_CRLDistributionPoints:
             DO(asn_OCTSTRING2ba(&extn->extnValue, &sba_extnvalue));
             DO(ExtensionHelper::decodeDistributionPoints(sba_extnvalue.get(), uris.fullCrl));
-        }
-        else if (OID_is_equal_oid(&extn->extnID, OID_X509v3_FreshestCRL)) {
-            SmartBA sba_extnvalue;
+            break;
+        case OID_ID_X509v3_FreshestCRL:
             DO(asn_OCTSTRING2ba(&extn->extnValue, &sba_extnvalue));
             DO(ExtensionHelper::decodeDistributionPoints(sba_extnvalue.get(), uris.deltaCrl));
-        }
-        else if (OID_is_equal_oid(&extn->extnID, OID_PKIX_AuthorityInfoAccess)) {
-            SmartBA sba_extnvalue;
+            break;
+        case OID_ID_PKIX_AuthorityInfoAccess:
             DO(asn_OCTSTRING2ba(&extn->extnValue, &sba_extnvalue));
             DO(ExtensionHelper::decodeAccessDescriptions(sba_extnvalue.get(), OID_PKIX_OCSP, uris.ocsp));
-        }
-        else if (OID_is_equal_oid(&extn->extnID, OID_PKIX_SubjectInfoAccess)) {
-            SmartBA sba_extnvalue;
+            break;
+        case OID_ID_PKIX_SubjectInfoAccess:
             DO(asn_OCTSTRING2ba(&extn->extnValue, &sba_extnvalue));
             DO(ExtensionHelper::decodeAccessDescriptions(sba_extnvalue.get(), OID_PKIX_TimeStamping, uris.tsp));
+            break;
+        default:
+            break;
         }
     }
 
@@ -148,6 +283,7 @@ CertStatusInfo::CertStatusInfo (
     , baResult(nullptr)
     , status(UapkiNS::CertStatus::UNDEFINED)
     , validTime(0)
+    , verifiedResponse(nullptr)
 {
 }
 
@@ -170,25 +306,37 @@ void CertStatusInfo::reset (void)
     baResult = nullptr;
     status = UapkiNS::CertStatus::UNDEFINED;
     validTime = 0;
+    delete verifiedResponse;
+    verifiedResponse = nullptr;
 }
 
 int CertStatusInfo::set (
         const UapkiNS::CertStatus status,
         const uint64_t validTime,
-        const ByteArray* baResult
+        const ByteArray* baResult,
+        Ocsp::VerifiedResponse* verifiedResponse
 )
 {
+    //  Copy before reset(), baResult can be the own value
+    ByteArray* ba_result = ba_copy_with_alloc(baResult, 0, 0);
     reset();
+    if (!ba_result) {
+        delete verifiedResponse;
+        return RET_UAPKI_GENERAL_ERROR;
+    }
+
     this->needUpdate = false;
     this->status = status;
     this->validTime = validTime;
-    this->baResult = ba_copy_with_alloc(baResult, 0, 0);
-    return (this->baResult) ? RET_OK : RET_UAPKI_GENERAL_ERROR;
+    this->baResult = ba_result;
+    this->verifiedResponse = verifiedResponse;
+    return RET_OK;
 }
 
 
 CerItem::CerItem (void)
     : m_Encoded(nullptr)
+    , m_Arena(nullptr)
     , m_Cert(nullptr)
     , m_AuthorityKeyId(nullptr)
     , m_CertId(nullptr)
@@ -212,7 +360,7 @@ CerItem::CerItem (void)
 CerItem::~CerItem (void)
 {
     ba_free((ByteArray*)m_Encoded);
-    asn_free(get_Certificate_desc(), (Certificate_t*)m_Cert);
+    asn_arena_free(m_Arena);
     ba_free((ByteArray*)m_AuthorityKeyId);
     ba_free((ByteArray*)m_CertId);
     ba_free((ByteArray*)m_SerialNumber);
@@ -318,23 +466,30 @@ int CerItem::verify (
     if (!cerIssuer) return RET_OK;
 
     int ret = RET_OK;
+    AsnArena* arena = nullptr;
+    const X509Tbs_t* x509_tbs = nullptr;
     SmartBA sba_signvalue, sba_tbs;
     string s_signalgo;
 
-    X509Tbs_t* x509_tbs = (X509Tbs_t*)asn_decode_ba_with_alloc(get_X509Tbs_desc(), m_Encoded);
+    //  TBS-data is not copied: the decoded object and sba_tbs refer to m_Encoded
+    arena = asn_arena_alloc(0);
+    if (!arena) {
+        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+    }
+    x509_tbs = (const X509Tbs_t*)asn_decode_ba_arena_view(get_X509Tbs_desc(), arena, m_Encoded);
     if (!x509_tbs) {
         SET_ERROR(RET_UAPKI_INVALID_STRUCT);
     }
-    if (!sba_tbs.set(ba_alloc_from_uint8(x509_tbs->tbsData.buf, x509_tbs->tbsData.size))) {
+    if (!sba_tbs.set(ba_alloc_view(x509_tbs->tbsData.buf, x509_tbs->tbsData.size))) {
         SET_ERROR(RET_UAPKI_GENERAL_ERROR);
     }
 
-    DO(Util::oidFromAsn1(&m_Cert->signatureAlgorithm.algorithm, s_signalgo));
+    DO(Util::oidFromAsn1(&x509_tbs->signAlgo.algorithm, s_signalgo));
     if (m_AlgoKeyId == HASH_ALG_GOST34311) {
-        DO(Util::bitStringEncapOctetFromAsn1(&m_Cert->signature, &sba_signvalue));
+        DO(Util::bitStringEncapOctetFromAsn1(&x509_tbs->signValue, &sba_signvalue));
     }
     else {
-        DO(asn_BITSTRING2ba(&m_Cert->signature, &sba_signvalue));
+        DO(asn_BITSTRING2ba(&x509_tbs->signValue, &sba_signvalue));
     }
 
     ret = Verify::verifySignature(s_signalgo.c_str(), sba_tbs.get(), false, cerIssuer->getSpki(), sba_signvalue.get());
@@ -359,10 +514,22 @@ int CerItem::verify (
     }
 
 cleanup:
-    asn_free(get_X509Tbs_desc(), x509_tbs);
+    asn_arena_free(arena);
     return ret;
 }
 
+const Certificate_t* const CerItem::getCert (void) const
+{
+    //  The whole tree is decoded on the first access only, in view-mode over m_Encoded
+    call_once(m_CertDecoded, [this]() {
+        m_Arena = asn_arena_alloc(ba_get_len(m_Encoded));
+        if (m_Arena) {
+            m_Cert = (const Certificate_t*)asn_decode_ba_arena_view(get_Certificate_desc(), m_Arena, m_Encoded);
+        }
+    });
+    return m_Cert;
+}
+
 int CerItem::checkValidity (
         const uint64_t validateTime
 ) const
@@ -395,8 +562,10 @@ int CerItem::getIssuerAndSN (
         ByteArray** baIssuerAndSN
 ) const
 {
-    const int ret = encode_issuer_and_sn(&m_Cert->tbsCertificate, baIssuerAndSN);
-    return ret;
+    if (!baIssuerAndSN) return RET_UAPKI_INVALID_PARAMETER;
+
+    *baIssuerAndSN = ba_copy_with_alloc(m_CertId, 0, 0);
+    return (*baIssuerAndSN) ? RET_OK : RET_UAPKI_GENERAL_ERROR;
 }
 
 int CerItem::keyUsageByBit (
@@ -598,15 +767,16 @@ int parseCert (
 {
     if (!baEncoded || !cerItem) return RET_UAPKI_INVALID_PARAMETER;
 
-    Certificate_t* cert = (Certificate_t*)asn_decode_ba_with_alloc(get_Certificate_desc(), baEncoded);
-    if (!cert || !cert->tbsCertificate.extensions) return RET_UAPKI_INVALID_STRUCT;
-
     int ret = RET_OK;
-    TBSCertificate_t& tbs = cert->tbsCertificate;
-    Extensions_t* extns = tbs.extensions;
+    CertTlvs tlvs;
+    AsnArena* arena = nullptr;
+    const uint8_t* buf = nullptr;
+    const Validity_t* validity = nullptr;
+    const SubjectPublicKeyInfo_t* spki = nullptr;
+    const Extensions_t* extns = nullptr;
+    SmartBA sba_encoded;
     SmartBA sba_authoritykeyid;
     SmartBA sba_certid;
-    SmartBA sba_encoded;
     SmartBA sba_issuer;
     SmartBA sba_keyid;
     SmartBA sba_pubkey;
@@ -619,25 +789,60 @@ int parseCert (
     uint64_t not_after = 0, not_before = 0;
     uint32_t key_usage = 0;
     CerItem::Uris uris;
+    size_t len_serialnum = 0;
+
+    if (!sba_encoded.set(ba_copy_with_alloc(baEncoded, 0, 0))) {
+        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+    }
+    buf = sba_encoded.buf();
+
+    //  Only TLV-offsets are taken from the certificate, issuer/subject/SPKI refer to the encoded bytes
+    //  owned by CerItem, the whole tree is decoded on demand by CerItem::getCert()
+    DO(scan_cert_tlvs(sba_encoded.get(), tlvs));
+
+    //  Validity, SPKI and extensions are decoded into a temporary arena for the loading time only
+    arena = asn_arena_alloc(tlvs.validity.length + tlvs.spki.length + tlvs.extensions.length);
+    if (!arena) {
+        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+    }
+    validity = (const Validity_t*)asn_decode_arena_view(get_Validity_desc(), arena,
+        buf + tlvs.validity.offset, tlvs.validity.length);
+    spki = (const SubjectPublicKeyInfo_t*)asn_decode_arena_view(get_SubjectPublicKeyInfo_desc(), arena,
+        buf + tlvs.spki.offset, tlvs.spki.length);
+    extns = (const Extensions_t*)asn_decode_arena_view(get_Extensions_desc(), arena,
+        buf + tlvs.extensions.offset, tlvs.extensions.length);
+    if (!validity || !spki || !extns) {
+        SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+    }
+
+    //  Serial number without leading zeros, as asn_INTEGER2ba()
+    len_serialnum = tlvs.serialNumber.length - tlvs.serialNumber.headerLength;
+    for (buf += tlvs.serialNumber.offset + tlvs.serialNumber.headerLength; (len_serialnum > 0) && (*buf == 0); buf++) {
+        len_serialnum--;
+    }
+    if (
+        !sba_serialnum.set(ba_alloc_from_uint8(buf, len_serialnum)) ||
+        !sba_issuer.set(tlv_to_view(sba_encoded.get(), tlvs.issuer)) ||
+        !sba_subject.set(tlv_to_view(sba_encoded.get(), tlvs.subject)) ||
+        !sba_spki.set(tlv_to_view(sba_encoded.get(), tlvs.spki))
+    ) {
+        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+    }
 
-    DO(asn_INTEGER2ba(&tbs.serialNumber, &sba_serialnum));
-    DO(asn_encode_ba(get_Name_desc(), &tbs.issuer, &sba_issuer));
-    DO(Util::pkixTimeFromAsn1(&tbs.validity.notBefore, not_before));
-    DO(Util::pkixTimeFromAsn1(&tbs.validity.notAfter, not_after));
-    DO(asn_encode_ba(get_Name_desc(), &tbs.subject, &sba_subject));
-    DO(asn_encode_ba(get_SubjectPublicKeyInfo_desc(), &tbs.subjectPublicKeyInfo, &sba_spki));
-    DO(Util::oidFromAsn1(&tbs.subjectPublicKeyInfo.algorithm.algorithm, s_keyalgo));
+    DO(Util::pkixTimeFromAsn1(&validity->notBefore, not_before));
+    DO(Util::pkixTimeFromAsn1(&validity->notAfter, not_after));
+    DO(Util::oidFromAsn1(&spki->algorithm.algorithm, s_keyalgo));
     if (DstuNS::isDstu4145family(s_keyalgo)) {
         algo_keyid = HASH_ALG_GOST34311;
         //  Note: calcKeyId() automatic wrapped pubkey into octet-string before compute hash
-        DO(Util::bitStringEncapOctetFromAsn1(&tbs.subjectPublicKeyInfo.subjectPublicKey, &sba_pubkey));
+        DO(Util::bitStringEncapOctetFromAsn1(&spki->subjectPublicKey, &sba_pubkey));
     }
     else {
-        DO(asn_BITSTRING2ba(&tbs.subjectPublicKeyInfo.subjectPublicKey, &sba_pubkey));
+        DO(asn_BITSTRING2ba(&spki->subjectPublicKey, &sba_pubkey));
     }
 
     DO(calcKeyId(algo_keyid, sba_pubkey.get(), &sba_keyid));
-    DO(encode_issuer_and_sn(&tbs, &sba_certid));
+    DO(encode_issuer_and_sn(sba_encoded.get(), tlvs.issuer, tlvs.serialNumber, &sba_certid));
 
     ret = ExtensionHelper::getKeyUsage(extns, key_usage);
     if (ret != RET_OK) {
@@ -651,17 +856,12 @@ int parseCert (
 
     DO(scan_and_parse_uris(*extns, uris));
 
-    if (!sba_encoded.set(ba_copy_with_alloc(baEncoded, 0, 0))) {
-        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
-    }
-
     cer_item = new CerItem();
     if (!cer_item) {
         SET_ERROR(RET_UAPKI_GENERAL_ERROR);
     }
 
     cer_item->m_Encoded = sba_encoded.pop();
-    cer_item->m_Cert = cert;
     cer_item->m_AuthorityKeyId = sba_authoritykeyid.pop();
     cer_item->m_CertId = sba_certid.pop();
     cer_item->m_KeyAlgo = s_keyalgo;
@@ -676,8 +876,6 @@ int parseCert (
     cer_item->m_KeyUsage = key_usage;
     cer_item->m_Uris = uris;
 
-    cert = nullptr;
-
     *cerItem = cer_item;
 #ifdef DEBUG_CERITEM_INFO
     debug_ceritem_info(*cer_item);
@@ -685,7 +883,7 @@ int parseCert (
     cer_item = nullptr;
 
 cleanup:
-    asn_free(get_Certificate_desc(), cert);
+    asn_arena_free(arena);
     delete cer_item;
     return ret;
 }
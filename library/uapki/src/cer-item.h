@@ -38,6 +38,10 @@
 
 namespace UapkiNS {
 
+namespace Ocsp {
+    struct VerifiedResponse;
+}
+
 namespace Cert {
 
 
@@ -76,6 +80,9 @@ struct CertStatusInfo {
     UapkiNS::CertStatus
                 status;
     uint64_t    validTime;
+    //  Outcome of the verified OCSP-response that is in baResult (for ValidationType::OCSP)
+    Ocsp::VerifiedResponse*
+                verifiedResponse;
 
     CertStatusInfo (
         const ValidationType validationType
@@ -86,10 +93,12 @@ struct CertStatusInfo {
         const uint64_t time
     );
     void reset (void);
+    //  Takes ownership of verifiedResponse
     int set (
         const UapkiNS::CertStatus status,
         const uint64_t validTime,
-        const ByteArray* baResult
+        const ByteArray* baResult,
+        Ocsp::VerifiedResponse* verifiedResponse = nullptr
     );
 
 };  //  end struct CertStatusInfo
@@ -119,7 +128,11 @@ private:
     std::string m_FileName;
     const ByteArray*
                 m_Encoded;
-    const Certificate_t*
+    mutable std::once_flag
+                m_CertDecoded;
+    mutable AsnArena*
+                m_Arena;
+    mutable const Certificate_t*
                 m_Cert;
     const ByteArray*
                 m_AuthorityKeyId;
@@ -130,6 +143,7 @@ private:
                 m_SerialNumber;
     const ByteArray*
                 m_KeyId;
+    //  Issuer, subject and SPKI are views (ba_alloc_view) of m_Encoded, they live as long as CerItem
     const ByteArray*
                 m_Issuer;
     const ByteArray*
@@ -165,9 +179,7 @@ public:
     const ByteArray* getAuthorityKeyId (void) const {
         return m_AuthorityKeyId;
     }
-    const Certificate_t* const getCert (void) const {
-        return m_Cert;
-    }
+    const Certificate_t* const getCert (void) const;
     const ByteArray* getCertId (void) const {
         return m_CertId;
     }
@@ -36,6 +36,7 @@
 #include "extension-helper.h"
 #include "macros-internal.h"
 #include "oids.h"
+#include "store-loader.h"
 #include "time-util.h"
 #include "uapki-errors.h"
 #include "uapki-ns-util.h"
@@ -503,49 +504,66 @@ CerItem* CerStore::addItem (
     return item;
 }
 
-int CerStore::loadDir (void)
+struct CerFileResult {
+    string      fileName;
+    int         ret;
+    CerItem*    item;
+};  //  end struct CerFileResult
+
+struct CerLoadContext {
+    const string*           path;
+    vector<CerFileResult>*  results;
+};  //  end struct CerLoadContext
+
+static void load_cer_file (
+        void* ctx,
+        const size_t index
+)
 {
-    DIR* dir = nullptr;
-    struct dirent* in_file;
+    CerLoadContext* load_ctx = (CerLoadContext*)ctx;
+    CerFileResult& result = (*load_ctx->results)[index];
+    const string s_fullpath = *load_ctx->path + result.fileName;
 
-    if (m_Path.empty()) return RET_OK;
+    SmartBA sba_encoded;
+    result.ret = ba_alloc_from_file(s_fullpath.c_str(), &sba_encoded);
+    if (result.ret != RET_OK) return;
 
-    dir = opendir(m_Path.c_str());
-    if (!dir) return RET_UAPKI_CERT_STORE_LOAD_ERROR;
+    result.ret = parseCert(sba_encoded.get(), &result.item);
+}
 
-    while ((in_file = readdir(dir))) {
-        if (!strcmp(in_file->d_name, ".") || !strcmp(in_file->d_name, "..")) {
-            continue;
-        }
+int CerStore::loadDir (void)
+{
+    if (m_Path.empty()) return RET_OK;
 
-        //  Check file-extension
-        const string s_name = string(in_file->d_name);
-        const size_t pos = s_name.rfind(CER_EXT);
-        if (pos != s_name.length() - CER_EXT_LEN) {
-            continue;
-        }
+    vector<string> file_names;
+    if (StoreLoader::listFiles(m_Path, CER_EXT, file_names) != RET_OK) return RET_UAPKI_CERT_STORE_LOAD_ERROR;
 
-        const string s_fullpath = m_Path + s_name;
-        if (!is_dir(s_fullpath.c_str())) {
-            SmartBA sba_encoded;
-            int ret = ba_alloc_from_file(s_fullpath.c_str(), &sba_encoded);
-            if (ret != RET_OK) continue;
-
-            CerItem* parsed_item = nullptr;
-            ret = parseCert(sba_encoded.get(), &parsed_item);
-            if (ret == RET_OK) {
-                (void)parsed_item->setFileName(s_name);
-                CerItem* added_item = addItem(parsed_item);
-                if (added_item != parsed_item) {
-                    (void)delete_file(s_fullpath.c_str());
-                    delete parsed_item;
-                }
-            }
+    //  Read and parse files in parallel
+    vector<CerFileResult> results(file_names.size());
+    for (size_t i = 0; i < file_names.size(); i++) {
+        results[i].fileName = file_names[i];
+        results[i].ret = RET_OK;
+        results[i].item = nullptr;
+    }
+    CerLoadContext load_ctx;
+    load_ctx.path = &m_Path;
+    load_ctx.results = &results;
+    StoreLoader::parallelFor(results.size(), load_cer_file, &load_ctx);
+
+    //  Merge in the order of file names
+    for (auto& it : results) {
+        if ((it.ret != RET_OK) || !it.item) continue;
+
+        CerItem* parsed_item = it.item;
+        (void)parsed_item->setFileName(it.fileName);
+        CerItem* added_item = addItem(parsed_item);
+        if (added_item != parsed_item) {
+            const string s_fullpath = m_Path + it.fileName;
+            (void)delete_file(s_fullpath.c_str());
+            delete parsed_item;
         }
     }
 
-    closedir(dir);
-
     for (auto& it : m_Items) {
         const string s_genname = it->generateFileName();
         if (s_genname != it->getFileName()) {
@@ -27,8 +27,10 @@
 
 #define FILE_MARKER "uapki/cert-validator.cpp"
 
+#include <map>
 #include "cert-validator.h"
 #include "ba-utils.h"
+#include "global-objects.h"
 #include "macros-internal.h"
 #include "oid-utils.h"
 #include "parson-ba-utils.h"
@@ -83,8 +85,11 @@ bool CertChainItem::checkValidityTime (
 
 int CertChainItem::decodeName (void)
 {
+    const Certificate_t* cert = m_CerSubject->getCert();
+    if (!cert) return RET_UAPKI_INVALID_STRUCT;
+
     return rdnameFromName(
-        m_CerSubject->getCert()->tbsCertificate.subject,
+        cert->tbsCertificate.subject,
         OID_X520_CommonName,
         m_CommonName
     );
@@ -434,12 +439,24 @@ int CertValidator::validateByCrl (
 
     int ret = RET_OK;
     Crl::CrlItem* crl_item = nullptr;
+    Crl::CrlItem* full_item = nullptr;
+    Crl::CrlItem* delta_item = nullptr;
+    Crl::CrlRefresher* crl_refresher = get_crlrefresher();
     vector<const Crl::RevokedCertItem*> revoked_items;
     JSON_Object* joDelta = nullptr;
     JSON_Object* joFull = nullptr;
     const ByteArray* ba_crlnumber = nullptr;
     bool is_found;
 
+    //  CRLs of this CA will be downloaded in the background before their nextUpdate
+    if (crl_refresher) {
+        const Cert::CerItem::Uris& uris = cerSubject->getUris();
+        crl_refresher->track(cerSubject->getAuthorityKeyId(), Crl::Type::FULL, uris.fullCrl, uris.deltaCrl);
+        if (m_CrlStore->useDeltaCrl()) {
+            crl_refresher->track(cerSubject->getAuthorityKeyId(), Crl::Type::DELTA, uris.deltaCrl, uris.deltaCrl);
+        }
+    }
+
     if (joResult) {
         DO_JSON(json_object_set_string(joResult, "status", Crl::certStatusToStr(resultValidation.certStatus)));
         DO_JSON(json_object_set_value(joResult, "full", json_value_init_object()));
@@ -455,7 +472,7 @@ int CertValidator::validateByCrl (
         joFull
     ));
     DEBUG_OUTCON(printf("validateByCrl(), ba_crlnumber: "); ba_print(stdout, ba_crlnumber));
-    DO(crl_item->revokedCerts(cerSubject, revoked_items));
+    full_item = crl_item;
     resultValidation.crlItem = crl_item;
 
     if (
@@ -475,10 +492,13 @@ int CertValidator::validateByCrl (
             &crl_item,
             joDelta
         ));
-        DO(crl_item->revokedCerts(cerSubject, revoked_items));
+        delta_item = crl_item;
         resultValidation.crlItem = crl_item;
     }
 
+    //  Entries of full CRL merged with entries of delta CRL (delta is applied once per CRL number)
+    DO(m_CrlStore->revokedCerts(full_item, delta_item, cerSubject, revoked_items));
+
     DEBUG_OUTCON(for (auto& it : revoked_items) {
         printf("revocationDate: %lld  crlReason: %i  invalidityDate: %lld\n", it->revocationDate, it->crlReason, it->invalidityDate);
     });
@@ -543,9 +563,14 @@ int CertValidator::validateByOcsp (
     int ret = RET_OK;
     const LibraryConfig::OcspParams& ocsp_params = m_LibConfig->getOcsp();
     Cert::CertStatusInfo& certstatusinfo_by_ocsp = cerSubject->getCertStatusByOcsp();
+    Ocsp::OcspCache* ocsp_cache = get_ocspcache();
     Ocsp::OcspHelper ocsp_helper;
     vector<string> shuffled_uris, uris;
+    string s_responder;
     const ByteArray* pba_ocspresponse = nullptr;
+    SmartBA sba_certid;
+    bool from_ocspcache = false;
+    Ocsp::VerifiedResponse* verified_response = nullptr;
 
     if (joResult) {
         DO_JSON(json_object_set_string(joResult, "status", Crl::certStatusToStr(UapkiNS::CertStatus::UNDEFINED)));
@@ -560,9 +585,47 @@ int CertValidator::validateByOcsp (
         SET_ERROR(RET_UAPKI_OCSP_URL_NOT_PRESENT);
     }
 
-    if (certstatusinfo_by_ocsp.isExpired(TimeUtil::mtimeNow())) {
+    if (certstatusinfo_by_ocsp.isExpired(TimeUtil::mtimeNow()) && !useStaleOcsp(cerSubject, TimeUtil::mtimeNow())) {
         DO(ocsp_helper.init());
         DO(ocsp_helper.addCert(cerIssuer, cerSubject));
+        if (ocsp_cache->isEnabled()) {
+            //  Response from the OCSP-cache is verified as received one, but it has not our nonce
+            Ocsp::OcspCache::Entry ocspcache_entry;
+            Ocsp::OcspRefresher* ocsp_refresher = get_ocsprefresher();
+            const bool allow_stale = (ocsp_refresher != nullptr);
+            bool is_stale = false;
+            DO(ocsp_helper.getRequestCertId(0, &sba_certid));
+            if (ocsp_cache->find(sba_certid.get(), TimeUtil::mtimeNow(), ocspcache_entry, allow_stale)) {
+                verified_response = new Ocsp::VerifiedResponse();
+                if (!verified_response) {
+                    SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+                }
+                from_ocspcache = (verifyCachedOcspResponse(
+                    sba_certid.get(),
+                    ocspcache_entry.baResponse.get(),
+                    allow_stale,
+                    *verified_response,
+                    is_stale
+                ) == RET_OK);
+                if (from_ocspcache) {
+                    (void)m_OcspResponse.reset(ocspcache_entry.baResponse.pop());
+                    if (is_stale) {
+                        ocsp_refresher->schedule(cerSubject);
+                    }
+                }
+                else {
+                    delete verified_response;
+                    verified_response = nullptr;
+                }
+            }
+        }
+    }
+
+    if (certstatusinfo_by_ocsp.needUpdate && !from_ocspcache) {
+        s_responder = Util::joinStrings(uris);
+        if (ocsp_cache->isBackoff(s_responder, TimeUtil::mtimeNow())) {
+            SET_ERROR(RET_UAPKI_OCSP_NOT_RESPONDING);
+        }
         if (ocsp_params.nonceLen > 0) {
             DO(ocsp_helper.genNonce(ocsp_params.nonceLen));
         }
@@ -582,73 +645,201 @@ int CertValidator::validateByOcsp (
                 break;
             }
         }
+        if ((ret == RET_OK) && m_OcspResponse.empty()) {
+            ret = RET_UAPKI_OCSP_RESPONSE_INVALID;
+        }
         if (ret != RET_OK) {
+            ocsp_cache->registerFailure(s_responder, TimeUtil::mtimeNow());
             SET_ERROR(ret);
         }
-        else if (m_OcspResponse.empty()) {
-            SET_ERROR(RET_UAPKI_OCSP_RESPONSE_INVALID);
-        }
     }
 
-    pba_ocspresponse = certstatusinfo_by_ocsp.needUpdate ? m_OcspResponse.get() : certstatusinfo_by_ocsp.baResult;
-    ret = ocsp_helper.parseResponse(pba_ocspresponse);
-    if (joResult) {
-        DO_JSON(json_object_set_string(joResult, "responseStatus", Ocsp::responseStatusToStr(ocsp_helper.getResponseStatus())));
-    }
+    if (certstatusinfo_by_ocsp.needUpdate || !certstatusinfo_by_ocsp.verifiedResponse) {
+        pba_ocspresponse = certstatusinfo_by_ocsp.needUpdate ? m_OcspResponse.get() : certstatusinfo_by_ocsp.baResult;
+        if (from_ocspcache) {
+            //  The response from the OCSP-cache is verified already
+            if (joResult) {
+                DO_JSON(json_object_set_string(joResult, "responseStatus", Ocsp::responseStatusToStr(Ocsp::ResponseStatus::SUCCESSFUL)));
+                DO(verifiedResponseToJson(joResult, *verified_response));
+            }
+        }
+        else {
+            const bool is_received = certstatusinfo_by_ocsp.needUpdate;
+            ret = ocsp_helper.parseResponse(pba_ocspresponse);
+            if (joResult) {
+                DO_JSON(json_object_set_string(joResult, "responseStatus", Ocsp::responseStatusToStr(ocsp_helper.getResponseStatus())));
+            }
+            if (ret != RET_OK) {
+                SET_ERROR(ret);
+            }
+            if (ocsp_helper.getResponseStatus() != Ocsp::ResponseStatus::SUCCESSFUL) {
+                if (is_received) {
+                    //  tryLater, internalError and others: the responder is overloaded or misconfigured
+                    ocsp_cache->registerFailure(s_responder, TimeUtil::mtimeNow());
+                }
+                SET_ERROR(RET_UAPKI_OCSP_RESPONSE_NOT_SUCCESSFUL);
+            }
+            if (is_received) {
+                ocsp_cache->registerSuccess(s_responder);
+            }
 
-    if (ret == RET_OK) {
-        if (ocsp_helper.getResponseStatus() == Ocsp::ResponseStatus::SUCCESSFUL) {
+            verified_response = new Ocsp::VerifiedResponse();
+            if (!verified_response) {
+                SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+            }
             DO(processResponseData(
                 ocsp_helper,
-                resultValidation.singleResponseInfo,
+                *verified_response,
                 joResult
             ));
 
-            (void)resultValidation.basicOcspResponse.set(ocsp_helper.getBasicOcspResponseEncoded(true));
-            if (resultValidation.needOcspIdentifier) {
-                DO(ocsp_helper.getOcspIdentifier(&resultValidation.ocspIdentifier));
-            }
-            if (!resultValidation.ocspResponse.set(ba_copy_with_alloc(pba_ocspresponse, 0, 0))) {
-                SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+            if (is_received && !sba_certid.empty()) {
+                (void)ocsp_cache->save(sba_certid.get(), verified_response->singleResponseInfo, pba_ocspresponse);
             }
+        }
 
-            if (certstatusinfo_by_ocsp.needUpdate) {
-                DO(certstatusinfo_by_ocsp.set(
-                    resultValidation.singleResponseInfo.certStatus,
-                    resultValidation.singleResponseInfo.msThisUpdate + Ocsp::OFFSET_EXPIRE_DEFAULT,
-                    m_OcspResponse.get()
-                ));
-            }
+        ret = certstatusinfo_by_ocsp.set(
+            verified_response->singleResponseInfo.certStatus,
+            ocsp_cache->getValidTime(
+                verified_response->singleResponseInfo.msThisUpdate,
+                verified_response->singleResponseInfo.msNextUpdate
+            ),
+            pba_ocspresponse,
+            verified_response
+        );
+        verified_response = nullptr;    //  Owned by CertStatusInfo
+        if (ret != RET_OK) {
+            SET_ERROR(ret);
         }
-        else {
-            SET_ERROR(RET_UAPKI_OCSP_RESPONSE_NOT_SUCCESSFUL);
+    }
+    else if (joResult) {
+        //  The response is verified already, its outcome is used without parsing and verifying
+        DO_JSON(json_object_set_string(joResult, "responseStatus", Ocsp::responseStatusToStr(Ocsp::ResponseStatus::SUCCESSFUL)));
+        DO(verifiedResponseToJson(joResult, *certstatusinfo_by_ocsp.verifiedResponse));
+    }
+
+    {
+        const Ocsp::VerifiedResponse& verified = *certstatusinfo_by_ocsp.verifiedResponse;
+        resultValidation.responseStatus = Ocsp::ResponseStatus::SUCCESSFUL;
+        resultValidation.responderIdType = verified.responderIdType;
+        (void)resultValidation.baResponderId.reset(ba_copy_with_alloc(verified.baResponderId.get(), 0, 0));
+        resultValidation.msProducedAt = verified.msProducedAt;
+        resultValidation.statusSignature = verified.statusSignature;
+        resultValidation.singleResponseInfo = verified.singleResponseInfo;
+        if (!resultValidation.basicOcspResponse.reset(ba_copy_with_alloc(verified.baBasicOcspResponse.get(), 0, 0))) {
+            SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+        }
+        if (
+            resultValidation.needOcspIdentifier &&
+            !resultValidation.ocspIdentifier.reset(ba_copy_with_alloc(verified.baOcspIdentifier.get(), 0, 0))
+        ) {
+            SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+        }
+        if (!resultValidation.ocspResponse.reset(ba_copy_with_alloc(certstatusinfo_by_ocsp.baResult, 0, 0))) {
+            SET_ERROR(RET_UAPKI_GENERAL_ERROR);
         }
     }
 
 cleanup:
+    delete verified_response;
     return ret;
 }
 
+static int copy_verified_response (
+        const Ocsp::VerifiedResponse& src,
+        Ocsp::VerifiedResponse& dst
+)
+{
+    //  Copy of the outcome that is common for all single responses
+    dst.msProducedAt = src.msProducedAt;
+    dst.responderIdType = src.responderIdType;
+    dst.statusSignature = src.statusSignature;
+    if (
+        !dst.baResponderId.reset(ba_copy_with_alloc(src.baResponderId.get(), 0, 0)) ||
+        !dst.baBasicOcspResponse.reset(ba_copy_with_alloc(src.baBasicOcspResponse.get(), 0, 0)) ||
+        (!src.baOcspIdentifier.empty() && !dst.baOcspIdentifier.reset(ba_copy_with_alloc(src.baOcspIdentifier.get(), 0, 0)))
+    ) return RET_UAPKI_GENERAL_ERROR;
+
+    for (const auto& it : src.certIds) {
+        dst.certIds.push_back(ba_copy_with_alloc(it, 0, 0));
+        if (!dst.certIds.back()) return RET_UAPKI_GENERAL_ERROR;
+    }
+    return RET_OK;
+}
+
+int CertValidator::prefetchOcsp (
+        const vector<Cert::CerItem*>& cerSubjects
+)
+{
+    if (HttpHelper::isOfflineMode()) return RET_OK;
+
+    const Ocsp::OcspCache* ocsp_cache = get_ocspcache();
+    const uint64_t ms_now = TimeUtil::mtimeNow();
+    map<string, vector<pair<Cert::CerItem*, Cert::CerItem*>>> groups_byuris;
+
+    for (auto& it : cerSubjects) {
+        Cert::CerItem* cer_issuer = nullptr;
+        bool is_selfsigned = false;
+
+        if (!it || it->getUris().ocsp.empty()) continue;
+        //  Issuer is taken from the store only, expected certs are added by validateByOcsp() callers
+        if ((m_CerStore->getIssuerCert(it, &cer_issuer, is_selfsigned) != RET_OK) || is_selfsigned) continue;
+        {
+            lock_guard<mutex> lock(it->getMutex());
+            if (!it->getCertStatusByOcsp().isExpired(ms_now) || useStaleOcsp(it, ms_now)) continue;
+        }
+        if (ocsp_cache->isEnabled()) {
+            //  The entry is found by the header of cache-file only, validateByOcsp() verifies the response
+            //  and requests the status itself if the response is not valid
+            Ocsp::OcspHelper ocsp_helper;
+            Ocsp::OcspCache::Entry ocspcache_entry;
+            SmartBA sba_certid;
+            if (
+                (ocsp_helper.init() != RET_OK) ||
+                (ocsp_helper.addCert(cer_issuer, it) != RET_OK) ||
+                (ocsp_helper.getRequestCertId(0, &sba_certid) != RET_OK) ||
+                ocsp_cache->find(sba_certid.get(), ms_now, ocspcache_entry, (get_ocsprefresher() != nullptr))
+            ) continue;
+        }
+
+        vector<pair<Cert::CerItem*, Cert::CerItem*>>& group = groups_byuris[Util::joinStrings(it->getUris().ocsp)];
+        bool is_present = false;
+        for (const auto& it_item : group) {
+            if (it_item.first == it) {
+                is_present = true;
+                break;
+            }
+        }
+        if (!is_present) {
+            group.push_back(make_pair(it, cer_issuer));
+        }
+    }
+
+    //  Errors are ignored, validateByOcsp() requests the status of each remaining certificate
+    for (const auto& it : groups_byuris) {
+        if (it.second.size() > 1) {
+            (void)requestOcspBatch(it.second);
+        }
+    }
+    return RET_OK;
+}
+
 int CertValidator::processResponseData (
         Ocsp::OcspHelper& ocspHelper,
-        Ocsp::OcspHelper::SingleResponseInfo& singleRespInfo,
+        Ocsp::VerifiedResponse& verifiedResponse,
         JSON_Object* joResult
 )
 {
     int ret = RET_OK;
     const size_t idx_certid = 0;    //  Work with one OCSP request that has one certificate
-    const ByteArray* ba_certid = nullptr;
     SmartBA sba_serialnumber;
     VectorBA vba_encodedcerts;
     vector<Cert::CerStore::AddedCerItem> added_ceritems;
-    string s_time;
-
-    if (joResult) {
-        DO_JSON(json_object_set_string(joResult, "status", Crl::certStatusToStr(CertStatus::UNDEFINED)));
-    }
 
+    DO(ocspHelper.scanSingleResponses());
     DO(ocspHelper.getSerialNumberFromCertId(idx_certid, &sba_serialnumber));
     DO(ocspHelper.getCerts(vba_encodedcerts));
+    verifiedResponse.msProducedAt = ocspHelper.getProducedAt();
 
     if (!vba_encodedcerts.empty()) {
         DO(m_CerStore->addCerts(
@@ -658,90 +849,65 @@ int CertValidator::processResponseData (
             added_ceritems
         ));
         for (auto& it : added_ceritems) {
-            if (it.cerItem && (ba_cmp(it.cerItem->getSerialNumber(), sba_serialnumber.get()) == 0)) {
-                ba_certid = it.cerItem->getCertId();
+            if (!it.cerItem) continue;
+
+            verifiedResponse.certIds.push_back(ba_copy_with_alloc(it.cerItem->getCertId(), 0, 0));
+            if (!verifiedResponse.certIds.back()) {
+                SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+            }
+            if (ba_cmp(it.cerItem->getSerialNumber(), sba_serialnumber.get()) == 0) {
+                (void)verifiedResponse.baCertId.reset(ba_copy_with_alloc(it.cerItem->getCertId(), 0, 0));
             }
         }
     }
 
-    if (joResult) {
-        DO_JSON(json_object_set_value(joResult, "certIds", json_value_init_array()));
-        JSON_Array* ja_certids = json_object_get_array(joResult, "certIds");
-        for (auto& it : added_ceritems) {
-            DO(json_array_append_base64(ja_certids, it.cerItem->getCertId()));
-        }
+    verifiedResponse.singleResponseInfo = ocspHelper.getSingleResponseInfo(idx_certid);
 
-        if (ba_certid) {
-            DO_JSON(json_object_set_base64(joResult, "certId", ba_certid));
-        }
+    DO(ocspHelper.checkNonce());
+    DO(verifyResponseData(ocspHelper, verifiedResponse));
 
-        s_time = TimeUtil::mtimeToFtime(ocspHelper.getProducedAt());
-        DO_JSON(json_object_set_string(joResult, "producedAt", s_time.c_str()));
+    //  Encoded values are kept in the outcome, they are not re-encoded for the next results
+    if (!verifiedResponse.baBasicOcspResponse.set(ocspHelper.getBasicOcspResponseEncoded(true))) {
+        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
     }
+    DO(ocspHelper.getOcspIdentifier(&verifiedResponse.baOcspIdentifier));
 
-    DO(ocspHelper.scanSingleResponses());
-    singleRespInfo = ocspHelper.getSingleResponseInfo(idx_certid);
-
+cleanup:
     if (joResult) {
-        DO_JSON(json_object_set_string(joResult, "status", Crl::certStatusToStr(singleRespInfo.certStatus)));
-
-        s_time = TimeUtil::mtimeToFtime(singleRespInfo.msThisUpdate);
-        DO_JSON(json_object_set_string(joResult, "thisUpdate", s_time.c_str()));
-
-        if (singleRespInfo.msNextUpdate > 0) {
-            s_time = TimeUtil::mtimeToFtime(singleRespInfo.msNextUpdate);
-            DO_JSON(json_object_set_string(joResult, "nextUpdate", s_time.c_str()));
-        }
-
-        if (singleRespInfo.certStatus == UapkiNS::CertStatus::REVOKED) {
-            DO_JSON(json_object_set_string(joResult, "revocationReason", Crl::crlReasonToStr(singleRespInfo.revocationReason)));
-            s_time = TimeUtil::mtimeToFtime(singleRespInfo.msRevocationTime);
-            DO_JSON(json_object_set_string(joResult, "revocationTime", s_time.c_str()));
+        const int ret_json = verifiedResponseToJson(joResult, verifiedResponse);
+        if (ret == RET_OK) {
+            ret = ret_json;
         }
     }
-
-    DO(ocspHelper.checkNonce());
-    DO(verifyResponseData(ocspHelper, joResult));
-
-cleanup:
     return ret;
 }
 
 int CertValidator::verifyResponseData (
         Ocsp::OcspHelper& ocspHelper,
-        JSON_Object* joResult
+        Ocsp::VerifiedResponse& verifiedResponse
 )
 {
     int ret = RET_OK;
-    SmartBA sba_responderid;
-    Ocsp::ResponderIdType responder_idtype = Ocsp::ResponderIdType::UNDEFINED;
-    SignatureVerifyStatus status_sign = SignatureVerifyStatus::UNDEFINED;
     Cert::CerItem* cer_responder = nullptr;
 
-    DO(ocspHelper.getResponderId(responder_idtype, &sba_responderid));
-    if (joResult) {
-        DO(responderIdToJson(joResult, responder_idtype, sba_responderid.get()));
-    }
-    if (responder_idtype == Ocsp::ResponderIdType::BY_NAME) {
-        ret = m_CerStore->getCertBySubject(sba_responderid.get(), &cer_responder);
+    DO(ocspHelper.getResponderId(verifiedResponse.responderIdType, &verifiedResponse.baResponderId));
+    if (verifiedResponse.responderIdType == Ocsp::ResponderIdType::BY_NAME) {
+        ret = m_CerStore->getCertBySubject(verifiedResponse.baResponderId.get(), &cer_responder);
         if (ret == RET_UAPKI_CERT_NOT_FOUND) {
-            const int ret2 = addExpectedOcspCert(false, sba_responderid.get());
+            const int ret2 = addExpectedOcspCert(false, verifiedResponse.baResponderId.get());
             SET_ERROR((ret2 == RET_OK) ? ret : ret2);
         }
     }
     else {
         //  responder_idtype == OcspHelper::ResponderIdType::BY_KEY
-        ret = m_CerStore->getCertByKeyId(sba_responderid.get(), &cer_responder);
+        ret = m_CerStore->getCertByKeyId(verifiedResponse.baResponderId.get(), &cer_responder);
         if (ret == RET_UAPKI_CERT_NOT_FOUND) {
-            const int ret2 = addExpectedOcspCert(true, sba_responderid.get());
+            const int ret2 = addExpectedOcspCert(true, verifiedResponse.baResponderId.get());
             SET_ERROR((ret2 == RET_OK) ? ret : ret2);
         }
     }
 
-    ret = ocspHelper.verifyTbsResponseData(cer_responder, status_sign);
-    if (joResult) {
-        DO_JSON(json_object_set_string(joResult, "statusSignature", verifyStatusToStr(status_sign)));
-    }
+    ret = ocspHelper.verifyTbsResponseData(cer_responder, verifiedResponse.statusSignature);
     if (ret == RET_VERIFY_FAILED) {
         SET_ERROR(RET_UAPKI_OCSP_RESPONSE_VERIFY_FAILED);
     }
@@ -753,6 +919,189 @@ cleanup:
     return ret;
 }
 
+int CertValidator::verifyCachedOcspResponse (
+        const ByteArray* baCertId,
+        const ByteArray* baResponse,
+        const bool allowStale,
+        Ocsp::VerifiedResponse& verifiedResponse,
+        bool& isStale
+)
+{
+    int ret = RET_OK;
+    const Ocsp::OcspCache* ocsp_cache = get_ocspcache();
+    Ocsp::OcspHelper ocsp_helper;
+
+    //  Own request with the same CertID: the helper of caller is not changed if the response is not used
+    DO(ocsp_helper.init());
+    DO(ocsp_helper.addCertId(baCertId));
+    DO(ocsp_helper.parseResponse(baResponse));
+    if (ocsp_helper.getResponseStatus() != Ocsp::ResponseStatus::SUCCESSFUL) {
+        SET_ERROR(RET_UAPKI_OCSP_RESPONSE_NOT_SUCCESSFUL);
+    }
+    DO(processResponseData(ocsp_helper, verifiedResponse));
+
+    //  The header of cache-file is not signed, only the verified values are used
+    if (!ocsp_cache->isFresh(
+        verifiedResponse.singleResponseInfo.msThisUpdate,
+        verifiedResponse.singleResponseInfo.msNextUpdate,
+        TimeUtil::mtimeNow(),
+        allowStale,
+        isStale
+    )) {
+        SET_ERROR(RET_UAPKI_OCSP_RESPONSE_INVALID);
+    }
+
+cleanup:
+    return ret;
+}
+
+int CertValidator::refreshByOcsp (
+        Cert::CerItem* cerSubject,
+        Cert::CerItem* cerIssuer
+)
+{
+    if (!cerSubject || !cerIssuer) return RET_UAPKI_INVALID_PARAMETER;
+    if (HttpHelper::isOfflineMode()) return RET_UAPKI_OFFLINE_MODE;
+    if (cerSubject->getUris().ocsp.empty()) return RET_UAPKI_OCSP_URL_NOT_PRESENT;
+
+    //  The request of one certificate, requestOcspBatch() locks cerSubject only to set the status
+    vector<pair<Cert::CerItem*, Cert::CerItem*>> subject_issuers;
+    subject_issuers.push_back(make_pair(cerSubject, cerIssuer));
+    return requestOcspBatch(subject_issuers);
+}
+
+bool CertValidator::useStaleOcsp (
+        Cert::CerItem* cerSubject,
+        const uint64_t time
+)
+{
+    //  Stale-while-revalidate: the expired verified status is used while OCSP-refresher requests new one.
+    //  Note: called under lock of cerSubject
+    Ocsp::OcspRefresher* ocsp_refresher = get_ocsprefresher();
+    Cert::CertStatusInfo& certstatusinfo_by_ocsp = cerSubject->getCertStatusByOcsp();
+    if (
+        !ocsp_refresher ||
+        !certstatusinfo_by_ocsp.verifiedResponse ||
+        !get_ocspcache()->isStaleAllowed(certstatusinfo_by_ocsp.validTime, time)
+    ) return false;
+
+    ocsp_refresher->schedule(cerSubject);
+    certstatusinfo_by_ocsp.needUpdate = false;
+    return true;
+}
+
+int CertValidator::requestOcspBatch (
+        const vector<pair<Cert::CerItem*, Cert::CerItem*>>& subjectIssuers
+)
+{
+    int ret = RET_OK;
+    const LibraryConfig::OcspParams& ocsp_params = m_LibConfig->getOcsp();
+    Ocsp::OcspCache* ocsp_cache = get_ocspcache();
+    Ocsp::OcspHelper ocsp_helper;
+    Ocsp::VerifiedResponse verified_response;
+    vector<string> shuffled_uris;
+    SmartBA sba_request, sba_response;
+
+    if (subjectIssuers.empty()) return RET_UAPKI_INVALID_PARAMETER;
+
+    const string s_responder = Util::joinStrings(subjectIssuers[0].first->getUris().ocsp);
+    if (ocsp_cache->isBackoff(s_responder, TimeUtil::mtimeNow())) return RET_UAPKI_OCSP_NOT_RESPONDING;
+
+    DO(ocsp_helper.init());
+    for (const auto& it : subjectIssuers) {
+        DO(ocsp_helper.addCert(it.second, it.first));
+    }
+    if (ocsp_params.nonceLen > 0) {
+        DO(ocsp_helper.genNonce(ocsp_params.nonceLen));
+    }
+    DO(ocsp_helper.encodeRequest());
+    if (!sba_request.set(ocsp_helper.getRequestEncoded(true))) {
+        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+    }
+
+    shuffled_uris = HttpHelper::randomURIs(subjectIssuers[0].first->getUris().ocsp);
+    for (auto& it : shuffled_uris) {
+        ret = HttpHelper::post(
+            it,
+            HttpHelper::CONTENT_TYPE_OCSP_REQUEST,
+            sba_request.get(),
+            &sba_response
+        );
+        if (ret == RET_OK) {
+            DEBUG_OUTCON(printf("requestOcspBatch(), url: '%s', count: %zu, size: %zu\n", it.c_str(), subjectIssuers.size(), sba_response.size()));
+            break;
+        }
+    }
+    if ((ret == RET_OK) && sba_response.empty()) {
+        ret = RET_UAPKI_OCSP_RESPONSE_INVALID;
+    }
+    if (ret != RET_OK) {
+        ocsp_cache->registerFailure(s_responder, TimeUtil::mtimeNow());
+        SET_ERROR(ret);
+    }
+
+    DO(ocsp_helper.parseResponse(sba_response.get()));
+    if (ocsp_helper.getResponseStatus() != Ocsp::ResponseStatus::SUCCESSFUL) {
+        ocsp_cache->registerFailure(s_responder, TimeUtil::mtimeNow());
+        SET_ERROR(RET_UAPKI_OCSP_RESPONSE_NOT_SUCCESSFUL);
+    }
+    ocsp_cache->registerSuccess(s_responder);
+    //  Signature covers all single responses, it is verified once
+    DO(processResponseData(ocsp_helper, verified_response));
+
+    for (size_t i = 0; i < subjectIssuers.size(); i++) {
+        Cert::CerItem* cer_subject = subjectIssuers[i].first;
+        const Ocsp::OcspHelper::SingleResponseInfo& single_response = ocsp_helper.getSingleResponseInfo(i);
+        SmartBA sba_serialnumber;
+        const ByteArray* ba_certid = nullptr;
+
+        //  CertId of the certificate (from response) that has serial number of this subject, as processResponseData() does
+        DO(ocsp_helper.getSerialNumberFromCertId(i, &sba_serialnumber));
+        for (const auto& it : verified_response.certIds) {
+            Cert::CerItem* cer_item = nullptr;
+            if (
+                (m_CerStore->getCertByCertId(it, &cer_item) == RET_OK) &&
+                (ba_cmp(cer_item->getSerialNumber(), sba_serialnumber.get()) == 0)
+            ) {
+                ba_certid = it;
+            }
+        }
+
+        Ocsp::VerifiedResponse* verified_single = new Ocsp::VerifiedResponse();
+        if (!verified_single) {
+            SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+        }
+
+        ret = copy_verified_response(verified_response, *verified_single);
+        if (ret != RET_OK) {
+            delete verified_single;
+            SET_ERROR(ret);
+        }
+        verified_single->singleResponseInfo = single_response;
+        if (ba_certid) {
+            (void)verified_single->baCertId.reset(ba_copy_with_alloc(ba_certid, 0, 0));
+        }
+
+        if (ocsp_cache->isEnabled()) {
+            SmartBA sba_certid;
+            if (ocsp_helper.getRequestCertId(i, &sba_certid) == RET_OK) {
+                (void)ocsp_cache->save(sba_certid.get(), single_response, sba_response.get());
+            }
+        }
+
+        lock_guard<mutex> lock(cer_subject->getMutex());
+        DO(cer_subject->getCertStatusByOcsp().set(
+            single_response.certStatus,
+            ocsp_cache->getValidTime(single_response.msThisUpdate, single_response.msNextUpdate),
+            sba_response.get(),
+            verified_single
+        ));
+    }
+
+cleanup:
+    return ret;
+}
+
 int CertValidator::verifySignatureSignerInfo (
         const CertEntity certEntity,
         Pkcs7::SignedDataParser::SignerInfo& signerInfo,
@@ -905,6 +1254,51 @@ cleanup:
     return ret;
 }   //  responderIdToJson
 
+int verifiedResponseToJson (
+        JSON_Object* joResult,
+        const Ocsp::VerifiedResponse& verifiedResponse
+)
+{
+    int ret = RET_OK;
+    const Ocsp::OcspHelper::SingleResponseInfo& single_respinfo = verifiedResponse.singleResponseInfo;
+    JSON_Array* ja_certids = nullptr;
+
+    DO_JSON(json_object_set_string(joResult, "status", Crl::certStatusToStr(single_respinfo.certStatus)));
+
+    DO_JSON(json_object_set_value(joResult, "certIds", json_value_init_array()));
+    ja_certids = json_object_get_array(joResult, "certIds");
+    for (const auto& it : verifiedResponse.certIds) {
+        DO(json_array_append_base64(ja_certids, it));
+    }
+    if (!verifiedResponse.baCertId.empty()) {
+        DO_JSON(json_object_set_base64(joResult, "certId", verifiedResponse.baCertId.get()));
+    }
+
+    if (verifiedResponse.msProducedAt > 0) {
+        DO_JSON(json_object_set_string(joResult, "producedAt", TimeUtil::mtimeToFtime(verifiedResponse.msProducedAt).c_str()));
+    }
+    if (single_respinfo.msThisUpdate > 0) {
+        DO_JSON(json_object_set_string(joResult, "thisUpdate", TimeUtil::mtimeToFtime(single_respinfo.msThisUpdate).c_str()));
+    }
+    if (single_respinfo.msNextUpdate > 0) {
+        DO_JSON(json_object_set_string(joResult, "nextUpdate", TimeUtil::mtimeToFtime(single_respinfo.msNextUpdate).c_str()));
+    }
+    if (single_respinfo.certStatus == UapkiNS::CertStatus::REVOKED) {
+        DO_JSON(json_object_set_string(joResult, "revocationReason", Crl::crlReasonToStr(single_respinfo.revocationReason)));
+        DO_JSON(json_object_set_string(joResult, "revocationTime", TimeUtil::mtimeToFtime(single_respinfo.msRevocationTime).c_str()));
+    }
+
+    if (verifiedResponse.responderIdType != Ocsp::ResponderIdType::UNDEFINED) {
+        DO(responderIdToJson(joResult, verifiedResponse.responderIdType, verifiedResponse.baResponderId.get()));
+    }
+    if (verifiedResponse.statusSignature != SignatureVerifyStatus::UNDEFINED) {
+        DO_JSON(json_object_set_string(joResult, "statusSignature", verifyStatusToStr(verifiedResponse.statusSignature)));
+    }
+
+cleanup:
+    return ret;
+}   //  verifiedResponseToJson
+
 int getCrl (
         Crl::CrlStore& crlStore,
         const Cert::CerItem* cerSubject,
@@ -920,7 +1314,6 @@ int getCrl (
     Crl::CrlItem* crl_item = nullptr;
     const Cert::CerItem::Uris& uris = cerSubject->getUris();
     vector<string> uris_crl;
-    SmartBA sba_crl;
 
     uris_crl = (is_full) ? uris.fullCrl : uris.deltaCrl;
     if (joResult) {
@@ -962,28 +1355,17 @@ int getCrl (
                 SET_ERROR(RET_UAPKI_CRL_URL_NOT_PRESENT);
             }
 
+            bool is_unique;
             const vector<string> shuffled_uris = HttpHelper::randomURIs(uris_crl);
             DEBUG_OUTCON(printf("CertValidator::getCrl(is full=%d), download CRL", is_full));
             for (auto& it : shuffled_uris) {
-                DEBUG_OUTCON(printf("CertValidator::getCrl(), HttpHelper::get('%s')\n", it.c_str()));
-                ret = HttpHelper::get(it, &sba_crl);
-                if (ret == RET_OK) {
-                    DEBUG_OUTCON(printf("CertValidator::getCrl(), url: '%s', size: %zu\n", it.c_str(), sba_crl.size()));
-                    break;
-                }
+                DEBUG_OUTCON(printf("CertValidator::getCrl(), CrlStore::downloadCrl('%s')\n", it.c_str()));
+                ret = crlStore.downloadCrl(it, is_unique, &crl_item);
+                if (ret == RET_OK) break;
             }
             if (ret != RET_OK) {
-                SET_ERROR(RET_UAPKI_CRL_NOT_DOWNLOADED);
+                SET_ERROR(ret);
             }
-
-            bool is_unique;
-            DO(crlStore.addCrl(
-                sba_crl.get(),
-                true,
-                is_unique,
-                &crl_item
-            ));
-            sba_crl.set(nullptr);
             if (!crl_item) {
                 SET_ERROR(RET_UAPKI_CRL_NOT_FOUND);
             }
@@ -404,14 +404,35 @@ public:
         ResultValidationByOcsp& resultValidation,
         JSON_Object* joResult = nullptr
     );
+    //  Requests in one OCSP-request the statuses of certificates that have the same OCSP-responder,
+    //  the statuses are kept in certificates and used by validateByOcsp() without network access
+    int prefetchOcsp (
+        const std::vector<Cert::CerItem*>& cerSubjects
+    );
+    //  Requests the new status without use of stale one, it is called by OCSP-refresher.
+    //  Network round-trip is done without lock of cerSubject, the status is set under lock,
+    //  so validateByOcsp() for the same certificate is not blocked during refresh
+    int refreshByOcsp (
+        Cert::CerItem* cerSubject,
+        Cert::CerItem* cerIssuer
+    );
     int processResponseData (
         Ocsp::OcspHelper& ocspHelper,
-        Ocsp::OcspHelper::SingleResponseInfo& singleRespInfo,
+        Ocsp::VerifiedResponse& verifiedResponse,
         JSON_Object* joResult = nullptr
     );
     int verifyResponseData (
         Ocsp::OcspHelper& ocspHelper,
-        JSON_Object* joResult = nullptr
+        Ocsp::VerifiedResponse& verifiedResponse
+    );
+    //  Response from OCSP-cache (baCertId is the key) is parsed and verified as received one, its freshness
+    //  is checked by thisUpdate/nextUpdate of verified SingleResponse. Any error means the miss of cache
+    int verifyCachedOcspResponse (
+        const ByteArray* baCertId,
+        const ByteArray* baResponse,
+        const bool allowStale,
+        Ocsp::VerifiedResponse& verifiedResponse,
+        bool& isStale
     );
     int verifySignatureSignerInfo (
         const CertEntity certEntity,
@@ -419,6 +440,15 @@ public:
         Cert::CerItem** cerSigner
     );
 
+private:
+    bool useStaleOcsp (
+        Cert::CerItem* cerSubject,
+        const uint64_t time
+    );
+    int requestOcspBatch (
+        const std::vector<std::pair<Cert::CerItem*, Cert::CerItem*>>& subjectIssuers
+    );
+
 };  //  end class CertValidator
 
 
@@ -444,6 +474,10 @@ int responderIdToJson (
     const Ocsp::ResponderIdType responderIdType,
     const ByteArray* baResponderId
 );
+int verifiedResponseToJson (
+    JSON_Object* joResult,
+    const Ocsp::VerifiedResponse& verifiedResponse
+);
 
 int getCrl (
     Crl::CrlStore& crlStore,
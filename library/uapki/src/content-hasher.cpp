@@ -38,13 +38,6 @@
 #define FILE_BLOCK_SIZE (10 * 1024 * 1024)
 
 
- //  See: byte-array-internal.h
-struct ByteArray_st {
-    const uint8_t*  buf;
-    size_t          len;
-};
-
-
 using namespace std;
 
 namespace UapkiNS {
@@ -65,6 +58,25 @@ ContentHasher::~ContentHasher (void)
     reset();
 }
 
+int ContentHasher::addDigest (
+        const HashAlg hashAlgo,
+        const ByteArray* baHashValue
+)
+{
+    if ((hashAlgo == HASH_ALG_UNDEFINED) || !baHashValue) return RET_UAPKI_INVALID_PARAMETER;
+
+    if (m_SourceType != SourceType::DIGESTS) {
+        reset();
+    }
+    setSourceType(SourceType::DIGESTS);
+
+    ByteArray* ba_value = ba_copy_with_alloc(baHashValue, 0, 0);
+    if (!ba_value) return RET_UAPKI_GENERAL_ERROR;
+
+    m_Digests.push_back(make_pair(hashAlgo, ba_value));
+    return RET_OK;
+}
+
 int ContentHasher::digest (
         const HashAlg hashAlgo
 )
@@ -89,6 +101,9 @@ int ContentHasher::digest (
     case SourceType::MEMORY:
         ret = digestMemory(hashAlgo);
         break;
+    case SourceType::DIGESTS:
+        ret = digestDigests(hashAlgo);
+        break;
     default:
         ret = RET_UAPKI_INVALID_PARAMETER;
         break;
@@ -109,6 +124,10 @@ void ContentHasher::reset (void)
     m_Filename.clear();
     m_MemoryPtr = nullptr;
     m_MemorySize = 0;
+    for (auto& it : m_Digests) {
+        ba_free(it.second);
+    }
+    m_Digests.clear();
     m_SourceType = SourceType::UNDEFINED;
 }
 
@@ -171,6 +190,19 @@ bool ContentHasher::numberToSize (
     return (fSize >= 0) && ((double)size == fSize);
 }
 
+int ContentHasher::digestDigests (
+        const HashAlg hashAlgo
+)
+{
+    for (const auto& it : m_Digests) {
+        if (it.first == hashAlgo) {
+            return m_Value.set(ba_copy_with_alloc(it.second, 0, 0)) ? RET_OK : RET_UAPKI_GENERAL_ERROR;
+        }
+    }
+    //  The content is not available anymore to compute other hash values
+    return RET_UAPKI_UNSUPPORTED_ALG;
+}
+
 int ContentHasher::digestFile (
         const HashAlg hashAlgo
 )
@@ -178,6 +210,7 @@ int ContentHasher::digestFile (
     int ret = RET_OK;
     HashCtx* hash_ctx = nullptr;
     ByteArray* ba_data = nullptr;
+    size_t read_len = 0;
     FILE* f = nullptr;
 
     f = fopen_utf8(m_Filename.c_str(), 0);
@@ -190,9 +223,13 @@ int ContentHasher::digestFile (
     CHECK_NOT_NULL(ba_data = ba_alloc_by_len(FILE_BLOCK_SIZE));
 
     do {
-        ba_data->len = fread(ba_get_buf(ba_data), 1, FILE_BLOCK_SIZE, f);
-        DO(hash_update(hash_ctx, ba_data));
-    } while (ba_data->len == FILE_BLOCK_SIZE);
+        SmartBA sba_block;
+        read_len = fread(ba_get_buf(ba_data), 1, FILE_BLOCK_SIZE, f);
+        if (!sba_block.set(ba_alloc_view(ba_get_buf_const(ba_data), read_len))) {
+            SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+        }
+        DO(hash_update(hash_ctx, sba_block.get()));
+    } while (read_len == FILE_BLOCK_SIZE);
 
     if (ferror(f)) {
         SET_ERROR(RET_UAPKI_FILE_READ_ERROR);
@@ -213,8 +250,10 @@ int ContentHasher::digestMemory (
         const HashAlg hashAlgo
 )
 {
-    ByteArray ba_local = { m_MemoryPtr, m_MemorySize };
-    return ::hash(hashAlgo, &ba_local, &m_Value);
+    SmartBA sba_local;
+    if (!sba_local.set(ba_alloc_view(m_MemoryPtr, m_MemorySize))) return RET_UAPKI_GENERAL_ERROR;
+
+    return ::hash(hashAlgo, sba_local.get(), &m_Value);
 }
 
 void ContentHasher::setSourceType (
@@ -32,6 +32,7 @@
 #include "uapki-ns.h"
 #include "hash.h"
 #include <string>
+#include <vector>
 
 
 namespace UapkiNS {
@@ -43,7 +44,8 @@ public:
         UNDEFINED   = 0,
         BYTEARRAY   = 1,
         FILE        = 2,
-        MEMORY      = 3
+        MEMORY      = 3,
+        DIGESTS     = 4     //  only hash values, computed while the content was read
     };  //  end enum SourceType
 
 private:
@@ -55,12 +57,18 @@ private:
     const uint8_t*
                 m_MemoryPtr;
     size_t      m_MemorySize;
+    std::vector<std::pair<HashAlg, ByteArray*>>
+                m_Digests;
     SmartBA     m_Value;
 
 public:
     ContentHasher (void);
     ~ContentHasher (void);
 
+    int addDigest (
+        const HashAlg hashAlgo,
+        const ByteArray* baHashValue
+    );
     int digest (
         const HashAlg hashAlgo
     );
@@ -101,6 +109,9 @@ public:
     );
 
 private:
+    int digestDigests (
+        const HashAlg hashAlgo
+    );
     int digestFile (
         const HashAlg hashAlgo
     );
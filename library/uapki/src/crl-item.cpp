@@ -34,6 +34,7 @@
 #include "dirent-internal.h"
 #include "extension-helper.h"
 #include "macros-internal.h"
+#include "oid-registry.h"
 #include "oids.h"
 #include "time-util.h"
 #include "uapki-errors.h"
@@ -54,6 +55,8 @@ namespace UapkiNS {
 namespace Crl {
 
 
+static const size_t FILE_CHUNK_SIZE = 64 * 1024;
+
 static const char* CERT_STATUS_STRINGS[4] = {
     "UNDEFINED", "GOOD", "REVOKED", "UNKNOWN"
 };
@@ -65,51 +68,6 @@ static const char* CRL_REASON_STRINGS[12] = {
 };
 
 
-static int add_revokedcert (
-        const uint8_t* bufEncoded,
-        size_t lenEncoded,
-        size_t offset,
-        vector<const RevokedCertItem*>& revokedItems
-)
-{
-    if (offset >= lenEncoded) return RET_UAPKI_INVALID_STRUCT;
-
-    bufEncoded += offset;
-    lenEncoded -= offset;
-
-    uint32_t tag;
-    size_t hlen, vlen;
-    bool ok = Util::decodeAsn1Header(bufEncoded, lenEncoded, tag, hlen, vlen);
-    if (!ok || (tag != 0x30) || (hlen + vlen > lenEncoded)) return RET_UAPKI_INVALID_STRUCT;
-
-    RevokedCertificate_t* revoked_cert = (RevokedCertificate_t*)asn_decode_with_alloc(get_RevokedCertificate_desc(), bufEncoded, hlen + vlen);
-    if (!revoked_cert) return RET_UAPKI_INVALID_STRUCT;
-
-    int ret = RET_OK;
-    uint64_t invalidity_date = 0, revocation_date = 0;
-    UapkiNS::CrlReason crl_reason = UapkiNS::CrlReason::UNDEFINED;
-    const RevokedCertItem* revcert_item = nullptr;
-
-    DO(Util::pkixTimeFromAsn1(&revoked_cert->revocationDate, revocation_date));
-    if (revoked_cert->crlEntryExtensions) {
-        uint32_t u32_crlreason = 0;
-        ret = ExtensionHelper::getCrlReason(revoked_cert->crlEntryExtensions, u32_crlreason);
-        if (ret == RET_OK) {
-            crl_reason = (UapkiNS::CrlReason)u32_crlreason;
-        }
-        ExtensionHelper::getCrlInvalidityDate(revoked_cert->crlEntryExtensions, invalidity_date);
-    }
-
-    revcert_item = new RevokedCertItem(revocation_date, crl_reason, invalidity_date);
-    if (revcert_item) {
-        revokedItems.push_back(revcert_item);
-    }
-
-cleanup:
-    asn_free(get_RevokedCertificate_desc(), revoked_cert);
-    return ret;
-}   //  add_revokedcert
-
 static int encode_crlid (
         const TBSCertListAlt_t& tbs,
         const ByteArray* baCrlNumber,
@@ -168,57 +126,84 @@ cleanup:
     return ret;
 }   //  encode_crlidentifier
 
-static size_t search_offset (
-        const vector<RevokedCertOffset>& revokedCertOffsets,
-        const size_t offsetSn
+static int decode_tbscrl (
+        const ByteArray* baEncoded,
+        AsnArena** arena,
+        const TBSCertListAlt_t** tbsCrl
 )
 {
-    //  Note: 0 (and 1) - impossible offset value
-    if (revokedCertOffsets.empty()) return 0;
-
-    size_t left = 0, right = revokedCertOffsets.size() - 1;
-    while (left <= right) {
-        size_t mid = left + (right - left) / 2;
-        const RevokedCertOffset& item = revokedCertOffsets[mid];
-        if (item.offsetSn < offsetSn) {
-            left = mid + 1;
-        }
-        else if (item.offsetSn > offsetSn) {
-            right = mid - 1;
-        }
-        else {
-            return item.offset;
-        }
-    }
+    //  Decoded CRL is placed into one arena, owned by CrlItem,
+    //  its primitives (e.g. revokedCertificates) refer to baEncoded that is also owned by CrlItem
+    AsnArena* rv_arena = asn_arena_alloc(ba_get_len(baEncoded) / 4);
+    if (!rv_arena) return RET_UAPKI_GENERAL_ERROR;
 
-    return 0;
-}   //  search_offset
+    const X509Tbs_t* x509_tbs = (const X509Tbs_t*)asn_decode_ba_arena_view(get_X509Tbs_desc(), rv_arena, baEncoded);
+    const TBSCertListAlt_t* tbs = nullptr;
+    if (x509_tbs && (x509_tbs->tbsData.size >= 12)) {
+        tbs = (const TBSCertListAlt_t*)asn_decode_arena_view(get_TBSCertListAlt_desc(), rv_arena, x509_tbs->tbsData.buf, x509_tbs->tbsData.size);
+    }
+    if (!tbs || !Util::equalValuePrimitiveType(tbs->signature.algorithm, x509_tbs->signAlgo.algorithm)) {
+        asn_arena_free(rv_arena);
+        return RET_UAPKI_INVALID_STRUCT;
+    }
 
-static vector<size_t> find_equal_sn (
-        const uint8_t* bufEncoded,
-        size_t lenEncoded,
-        const uint8_t* bufSerialNumber,
-        size_t lenSerialNumber,
-        const vector<RevokedCertOffset>& revokedCertOffsets
+    *arena = rv_arena;
+    *tbsCrl = tbs;
+    return RET_OK;
+}   //  decode_tbscrl
+
+static int hash_file (
+        const HashAlg hashAlgo,
+        const string& fileName,
+        const uint64_t fileSize,
+        const ByteArray* baFileHash,
+        ByteArray** baHash
 )
 {
-    vector<size_t> sn_offsets, rv_offsets;
-    lenEncoded -= lenSerialNumber;
-    for (size_t i = 0; i < lenEncoded; i++, bufEncoded++) {
-        if (memcmp(bufEncoded, bufSerialNumber, lenSerialNumber) == 0) {
-            sn_offsets.push_back(i);
+    //  The file is hashed by chunks, it is also checked by its size and SHA-256 (see CrlItem::getEncoded())
+    int ret = RET_OK;
+    HashCtx* hash_ctx = nullptr;
+    HashCtx* filehash_ctx = nullptr;
+    FILE* f = nullptr;
+    vector<uint8_t> chunk(FILE_CHUNK_SIZE);
+    size_t len;
+    uint64_t total_len = 0;
+    SmartBA sba_filehash;
+
+    CHECK_NOT_NULL(hash_ctx = hash_alloc(hashAlgo));
+    CHECK_NOT_NULL(filehash_ctx = hash_alloc(HASH_ALG_SHA256));
+    f = fopen_utf8(fileName.c_str(), 0);
+    if (!f) {
+        SET_ERROR(RET_UAPKI_FILE_OPEN_ERROR);
+    }
+
+    while ((len = fread(chunk.data(), 1, chunk.size(), f)) > 0) {
+        SmartBA sba_chunk;
+        if (!sba_chunk.set(ba_alloc_view(chunk.data(), len))) {
+            SET_ERROR(RET_UAPKI_GENERAL_ERROR);
         }
+        DO(hash_update(hash_ctx, sba_chunk.get()));
+        DO(hash_update(filehash_ctx, sba_chunk.get()));
+        total_len += len;
+    }
+    if (ferror(f)) {
+        SET_ERROR(RET_UAPKI_FILE_READ_ERROR);
     }
 
-    for (const auto& it_sn : sn_offsets) {
-        const size_t offset = search_offset(revokedCertOffsets, it_sn);
-        if (offset > 0) {
-            rv_offsets.push_back(offset);
-        }
+    DO(hash_final(filehash_ctx, &sba_filehash));
+    if ((total_len != fileSize) || (ba_cmp(sba_filehash.get(), baFileHash) != 0)) {
+        SET_ERROR(RET_UAPKI_CRL_NOT_FOUND);
     }
+    DO(hash_final(hash_ctx, baHash));
 
-    return rv_offsets;
-}   //  find_equal_sn
+cleanup:
+    if (f) {
+        fclose(f);
+    }
+    hash_free(hash_ctx);
+    hash_free(filehash_ctx);
+    return ret;
+}   //  hash_file
 
 
 CrlItem::CrlItem (
@@ -227,6 +212,11 @@ CrlItem::CrlItem (
     : m_Version(0)
     , m_Type(iType)
     , m_Encoded(nullptr)
+    , m_Summary(nullptr)
+    , m_TbsHash(nullptr)
+    , m_FileSize(0)
+    , m_FileHash(nullptr)
+    , m_Arena(nullptr)
     , m_TbsCrl(nullptr)
     , m_CrlId(nullptr)
     , m_Issuer(nullptr)
@@ -243,7 +233,10 @@ CrlItem::CrlItem (
 CrlItem::~CrlItem (void)
 {
     ba_free((ByteArray*)m_Encoded);
-    asn_free(get_TBSCertListAlt_desc(), (TBSCertListAlt_t*)m_TbsCrl);
+    ba_free((ByteArray*)m_Summary);
+    ba_free((ByteArray*)m_TbsHash);
+    ba_free((ByteArray*)m_FileHash);
+    asn_arena_free(m_Arena);
     ba_free((ByteArray*)m_CrlId);
     ba_free((ByteArray*)m_Issuer);
     m_ThisUpdate = 0;
@@ -278,7 +271,9 @@ int CrlItem::generateHash (
     if (hash_alg == HashAlg::HASH_ALG_UNDEFINED) return RET_UAPKI_UNSUPPORTED_ALG;
 
     SmartBA sba_hashvalue;
-    const int ret = ::hash(hash_alg, m_Encoded, &sba_hashvalue);
+    const int ret = isFileBacked()
+        ? hash_file(hash_alg, getFilePath(), m_FileSize, m_FileHash, &sba_hashvalue)
+        : ::hash(hash_alg, m_Encoded, &sba_hashvalue);
     if (ret != RET_OK) return ret;
 
     UapkiNS::OtherHash* crl_hash = new UapkiNS::OtherHash();
@@ -312,6 +307,15 @@ void CrlItem::setActuality (
     m_Actuality = actuality;
 }
 
+void CrlItem::setDirName (
+        const string& dirName
+)
+{
+    lock_guard<mutex> lock(m_Mutex);
+
+    m_DirName = dirName;
+}
+
 bool CrlItem::setFileName (
         const string& fileName
 )
@@ -337,21 +341,28 @@ int CrlItem::verify (
     if (!cerIssuer) return RET_OK;
 
     int ret = RET_OK;
+    AsnArena* arena = nullptr;
+    const X509Tbs_t* x509_tbs = nullptr;
     SmartBA sba_signvalue, sba_tbs;
     string s_signalgo;
 
-    X509Tbs_t* x509_tbs = (X509Tbs_t*)asn_decode_ba_with_alloc(get_X509Tbs_desc(), m_Encoded);
+    //  TBS-data is not copied: the decoded object and sba_tbs refer to m_Encoded (or m_Summary)
+    arena = asn_arena_alloc(0);
+    if (!arena) {
+        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+    }
+    x509_tbs = (const X509Tbs_t*)asn_decode_ba_arena_view(get_X509Tbs_desc(), arena, isFileBacked() ? m_Summary : m_Encoded);
     if (!x509_tbs) {
         SET_ERROR(RET_UAPKI_INVALID_STRUCT);
     }
-    if (!sba_tbs.set(ba_alloc_from_uint8(x509_tbs->tbsData.buf, x509_tbs->tbsData.size))) {
+    if (!sba_tbs.set(ba_alloc_view(x509_tbs->tbsData.buf, x509_tbs->tbsData.size))) {
         SET_ERROR(RET_UAPKI_GENERAL_ERROR);
     }
 
     DO(Util::oidFromAsn1(&x509_tbs->signAlgo.algorithm, s_signalgo));
     if (
-        oid_is_parent(OID_DSTU4145_WITH_DSTU7564, s_signalgo.c_str()) ||
-        oid_is_parent(OID_DSTU4145_WITH_GOST3411, s_signalgo.c_str())
+        OID_is_child_id(&x509_tbs->signAlgo.algorithm, OID_ID_DSTU4145_WITH_DSTU7564) ||
+        OID_is_child_id(&x509_tbs->signAlgo.algorithm, OID_ID_DSTU4145_WITH_GOST3411)
     ) {
         DO(Util::bitStringEncapOctetFromAsn1(&x509_tbs->signValue, &sba_signvalue));
     }
@@ -359,7 +370,15 @@ int CrlItem::verify (
         DO(asn_BITSTRING2ba(&x509_tbs->signValue, &sba_signvalue));
     }
 
-    ret = Verify::verifySignature(s_signalgo.c_str(), sba_tbs.get(), false, cerIssuer->getSpki(), sba_signvalue.get());
+    if (!isFileBacked()) {
+        ret = Verify::verifySignature(s_signalgo.c_str(), sba_tbs.get(), false, cerIssuer->getSpki(), sba_signvalue.get());
+    }
+    else {
+        //  TBS of the summary is not signed, the hash of the original TBS is calculated while parsing
+        ret = (m_TbsHash)
+            ? Verify::verifySignature(s_signalgo.c_str(), m_TbsHash, true, cerIssuer->getSpki(), sba_signvalue.get())
+            : RET_UAPKI_UNSUPPORTED_ALG;
+    }
     switch (ret) {
     case RET_OK:
         m_StatusSign = Cert::VerifyStatus::VALID;
@@ -372,10 +391,45 @@ int CrlItem::verify (
     }
 
 cleanup:
-    asn_free(get_X509Tbs_desc(), x509_tbs);
+    asn_arena_free(arena);
     return ret;
 }
 
+int CrlItem::getEncoded (
+        const ByteArray** baEncoded
+) const
+{
+    if (!baEncoded) return RET_UAPKI_INVALID_PARAMETER;
+
+    lock_guard<mutex> lock(m_EncodedMutex);
+
+    if (!m_Encoded && isFileBacked()) {
+        SmartBA sba_encoded, sba_filehash;
+        int ret = ba_alloc_from_file(getFilePath().c_str(), &sba_encoded);
+        if (ret != RET_OK) return ret;
+
+        ret = ::hash(HASH_ALG_SHA256, sba_encoded.get(), &sba_filehash);
+        if (ret != RET_OK) return ret;
+        //  The file was replaced after parsing, it is not the CRL which signature is verified
+        if ((sba_encoded.size() != m_FileSize) || (ba_cmp(sba_filehash.get(), m_FileHash) != 0)) return RET_UAPKI_CRL_NOT_FOUND;
+
+        m_Encoded = sba_encoded.pop();
+    }
+
+    *baEncoded = m_Encoded;
+    return (m_Encoded) ? RET_OK : RET_UAPKI_GENERAL_ERROR;
+}
+
+const TBSCertListAlt_t* const CrlItem::getTbsCrl (void) const
+{
+    //  TBS is decoded on the first access only (CRL_INFO, reports), lookups use the revocation table.
+    //  For file-backed CRL it is TBS of the summary, its revokedCertificates is empty
+    call_once(m_TbsDecoded, [this]() {
+        (void)decode_tbscrl(isFileBacked() ? m_Summary : m_Encoded, &m_Arena, &m_TbsCrl);
+    });
+    return m_TbsCrl;
+}
+
 string CrlItem::generateFileName (void) const
 {
     string rv_s;
@@ -402,79 +456,43 @@ int CrlItem::parsedRevokedCert (
         uint64_t& invalidityDate
 ) const
 {
-    if (index >= m_RevokedCertOffsets.size()) return RET_UAPKI_INVALID_PARAMETER;
-
-    const uint8_t* buf = m_TbsCrl->revokedCertificates.buf + m_RevokedCertOffsets[index].offset;
-    uint32_t tag;
-    size_t hlen, vlen;
-
-    if (!Util::decodeAsn1Header(buf, 6, tag, hlen, vlen)) return RET_UAPKI_INVALID_STRUCT;
+    if (index >= m_RevocationTable.count()) return RET_UAPKI_INVALID_PARAMETER;
 
-    int ret = RET_OK;
-    RevokedCertificate_t* revoked_cert = (RevokedCertificate_t*)asn_decode_with_alloc(get_RevokedCertificate_desc(), buf, hlen + vlen);
-    if (!revoked_cert) return RET_UAPKI_INVALID_STRUCT;
-
-    revocationDate = invalidityDate = 0;
-    crlReason = UapkiNS::CrlReason::UNDEFINED;
-
-    DO(asn_INTEGER2ba(&revoked_cert->userCertificate, baSerialNumber));
-    DO(Util::pkixTimeFromAsn1(&revoked_cert->revocationDate, revocationDate));
-
-    if (revoked_cert->crlEntryExtensions) {
-        uint32_t u32_crlreason = 0;
-        ret = ExtensionHelper::getCrlReason(revoked_cert->crlEntryExtensions, u32_crlreason);
-        if (ret == RET_OK) {
-            crlReason = (CrlReason)u32_crlreason;
-        }
-        ret = RET_OK;
-        (void)ExtensionHelper::getCrlInvalidityDate(revoked_cert->crlEntryExtensions, invalidityDate);
-    }
+    const int ret = m_RevocationTable.getSerialNumber(index, baSerialNumber);
+    if (ret != RET_OK) return ret;
 
-cleanup:
-    asn_free(get_RevokedCertificate_desc(), revoked_cert);
-    return ret;
+    revocationDate = m_RevocationTable.getRevocationDate(index);
+    crlReason = m_RevocationTable.getCrlReason(index);
+    invalidityDate = m_RevocationTable.getInvalidityDate(index);
+    return RET_OK;
 }
 
 int CrlItem::revokedCerts (
         const Cert::CerItem* cerSubject,
         vector<const RevokedCertItem*>& revokedItems
-)
+) const
 {
     if (!cerSubject) return RET_UAPKI_INVALID_PARAMETER;
 
-    int ret = RET_OK;
-    SmartBA sba_snencoded;
-    vector<size_t> offsets;
+    vector<size_t> indexes;
 
     DEBUG_OUTCON(printf("CrlItem::revokedCerts() cerSubject->baSerialNumber, hex: "); ba_print(stdout, cerSubject->getSerialNumber()));
-    DO(Util::encodeInteger(cerSubject->getSerialNumber(), &sba_snencoded));
-
-    if (m_RevokedCertOffsets.empty()) return RET_OK;
-    if (sba_snencoded.size() > (size_t)m_TbsCrl->revokedCertificates.size) return RET_UAPKI_INVALID_STRUCT;
-
-    offsets = find_equal_sn(
-        m_TbsCrl->revokedCertificates.buf,
-        (size_t)m_TbsCrl->revokedCertificates.size,
-        sba_snencoded.buf(),
-        sba_snencoded.size(),
-        m_RevokedCertOffsets
-    );
-
-    for (const auto& it : offsets) {
-        DO(add_revokedcert(
-            m_TbsCrl->revokedCertificates.buf,
-            (size_t)m_TbsCrl->revokedCertificates.size,
-            it,
-            revokedItems
-        ));
+    m_RevocationTable.find(cerSubject->getSerialNumber(), indexes);
+
+    for (const auto& it : indexes) {
+        const RevokedCertItem* revcert_item = new RevokedCertItem(
+            m_RevocationTable.getRevocationDate(it),
+            m_RevocationTable.getCrlReason(it),
+            m_RevocationTable.getInvalidityDate(it)
+        );
+        if (!revcert_item) return RET_UAPKI_GENERAL_ERROR;
+        revokedItems.push_back(revcert_item);
     }
 
-cleanup:
-    return ret;
+    return RET_OK;
 }
 
 
-
 const char* certStatusToStr (
         const UapkiNS::CertStatus status
 )
@@ -591,54 +609,6 @@ bool findRevokedCert (
     return rv_isfound;
 }
 
-int parseRevokedCerts (
-        std::vector<RevokedCertOffset>& Offsets,
-        const uint8_t* bufEncoded,
-        const int lenEncoded
-)
-{
-    Offsets.clear();
-    if (!bufEncoded || (lenEncoded == 0)) return RET_OK;
-
-    uint32_t tag;
-    size_t hlen, vlen, offset;
-    bool ok = Util::decodeAsn1Header(bufEncoded, (size_t) lenEncoded, tag, hlen, vlen);
-    if (!ok || (tag != 0x30) || (hlen + vlen > lenEncoded)) return RET_UAPKI_INVALID_STRUCT;
-    if (vlen == 0) return RET_OK;
-
-    bufEncoded += hlen;
-    offset = hlen;
-
-    size_t hlen2, vlen2, size2;
-    ok = Util::decodeAsn1Header(bufEncoded, vlen, tag, hlen2, vlen2);
-    if (!ok || (tag != 0x30) || (vlen2 < 4)) return RET_UAPKI_INVALID_STRUCT;
-
-    size2 = hlen2 + vlen2;
-    RevokedCertificate_t* revoked_cert = (RevokedCertificate_t*)asn_decode_with_alloc(get_RevokedCertificate_desc(), bufEncoded, size2);
-    if (!revoked_cert) return RET_UAPKI_INVALID_STRUCT;
-    asn_free(get_RevokedCertificate_desc(), revoked_cert);
-    revoked_cert = nullptr;
-
-    size_t reserved_size = (lenEncoded / (size2)) + 1;
-    Offsets.reserve(reserved_size);
-    Offsets.push_back(RevokedCertOffset(offset, offset + hlen2));
-    bufEncoded += size2;
-    offset += size2;
-    vlen -= size2;
-
-    while (vlen > 2) {
-        ok = Util::decodeAsn1Header(bufEncoded, vlen, tag, hlen2, vlen2);
-        if (!ok || (tag != 0x30) || (vlen2 < 4)) return RET_UAPKI_INVALID_STRUCT;
-
-        Offsets.push_back(RevokedCertOffset(offset, offset + hlen2));
-        bufEncoded += size2;
-        offset += size2;
-        vlen -= size2;
-    }
-
-    return 0;
-}
-
 int parseCrl (
         const ByteArray* baEncoded,
         CrlItem** crlItem
@@ -646,10 +616,11 @@ int parseCrl (
 {
     if (!baEncoded || !crlItem) return RET_UAPKI_INVALID_PARAMETER;
 
-    X509Tbs_t* x509_tbs = (X509Tbs_t*)asn_decode_ba_with_alloc(get_X509Tbs_desc(), baEncoded);
-    if (!x509_tbs || (x509_tbs->tbsData.size < 12)) return RET_UAPKI_INVALID_STRUCT;
+    AsnArena* arena = nullptr;
+    const TBSCertListAlt_t* tbs = nullptr;
+    int ret = decode_tbscrl(baEncoded, &arena, &tbs);
+    if (ret != RET_OK) return ret;
 
-    int ret = RET_OK;
     Extensions_t* extns = nullptr;
     unsigned long version = 0;
     SmartBA sba_authoritykeyid;
@@ -661,28 +632,21 @@ int parseCrl (
     CrlItem* crl_item = nullptr;
     Type crl_type = Type::UNDEFINED;
     uint64_t this_update = 0, next_update = 0;
-    vector<RevokedCertOffset> revcert_offsets;
+    RevocationTable revocation_table;
     CrlItem::Uris uris;
 
-    TBSCertListAlt_t* tbs = (TBSCertListAlt_t*)asn_decode_with_alloc(get_TBSCertListAlt_desc(), x509_tbs->tbsData.buf, x509_tbs->tbsData.size);
-    if (!tbs) {
-        SET_ERROR(RET_UAPKI_INVALID_STRUCT);
-    }
-
     if (tbs->version) {
         DO(asn_INTEGER2ulong(tbs->version, &version));
     }
     if (version < 1) {
         SET_ERROR(RET_UAPKI_INVALID_STRUCT_VERSION);
     }
-    if (!Util::equalValuePrimitiveType(tbs->signature.algorithm, x509_tbs->signAlgo.algorithm)) {
-        SET_ERROR(RET_UAPKI_INVALID_STRUCT);
-    }
     DO(asn_encode_ba(get_Name_desc(), &tbs->issuer, &sba_issuer));
     DO(Util::pkixTimeFromAsn1(&tbs->thisUpdate, this_update));
     DO(Util::pkixTimeFromAsn1(&tbs->nextUpdate, next_update));
 
-    DO(parseRevokedCerts(revcert_offsets, tbs->revokedCertificates.buf, tbs->revokedCertificates.size));
+    DO(revocation_table.addEntries(tbs->revokedCertificates.buf, (size_t)tbs->revokedCertificates.size));
+    revocation_table.complete();
 
     extns = tbs->crlExtensions;
     DO(ExtensionHelper::getAuthorityKeyId(extns, &sba_authoritykeyid));
@@ -714,32 +678,28 @@ int parseCrl (
     if (crl_item) {
         crl_item->m_Encoded = baEncoded;
         crl_item->m_Version = (uint32_t)version;
-        crl_item->m_TbsCrl = tbs;
         crl_item->m_CrlId = sba_crlid.pop();
         crl_item->m_Issuer = sba_issuer.pop();
         crl_item->m_ThisUpdate = this_update;
         crl_item->m_NextUpdate = next_update;
-        crl_item->m_RevokedCertOffsets = revcert_offsets;
+        crl_item->m_RevocationTable = move(revocation_table);
         crl_item->m_AuthorityKeyId = sba_authoritykeyid.pop();
         crl_item->m_CrlNumber = sba_crlnumber.pop();
         crl_item->m_DeltaCrl = sba_deltacrl.pop();
         crl_item->m_CrlIdentifier = sba_crlident.pop();
         crl_item->m_Uris = uris;
 
-        tbs = nullptr;
-
         *crlItem = crl_item;
         crl_item = nullptr;
     }
 
 cleanup:
-    asn_free(get_TBSCertListAlt_desc(), tbs);
-    asn_free(get_X509Tbs_desc(), x509_tbs);
+    //  Decoded TBS is not kept: revoked entries are in the table, see CrlItem::getTbsCrl()
+    asn_arena_free(arena);
     delete crl_item;
     return ret;
 }
 
-
 }   //  end namespace Crl
 
 }   //  end namespace UapkiNS
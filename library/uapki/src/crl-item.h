@@ -30,6 +30,7 @@
 
 #include <mutex>
 #include "cer-item.h"
+#include "crl-revocation-table.h"
 #include "byte-array.h"
 #include "uapkif.h"
 #include "uapki-ns.h"
@@ -73,18 +74,8 @@ struct RevokedCertItem {
     }
 };  //  end struct RevokedCertItem
 
-struct RevokedCertOffset {
-    size_t  offset;
-    size_t  offsetSn;
 
-    RevokedCertOffset (
-        const size_t iOffset = 0,
-        const size_t iOffsetSn = 0
-    )
-    : offset(iOffset)
-    , offsetSn(iOffsetSn)
-    {}
-};  //  end struct RevokedCertOffset
+class CrlStreamParser;
 
 
 class CrlItem {
@@ -107,9 +98,26 @@ private:
     std::string m_FileName;
     uint32_t    m_Version;
     const Type  m_Type;
-    const ByteArray*
+    mutable std::mutex
+                m_EncodedMutex;
+    mutable const ByteArray*
                 m_Encoded;
-    const TBSCertListAlt_t*
+    //  CRL that is not kept in memory (file-backed): the summary is the CRL without revoked entries,
+    //  the signature is verified by the hash of TBS. Size and SHA-256 of the whole file are taken
+    //  from the parsed stream, the file is checked by them when it is read again
+    std::string m_DirName;
+    const ByteArray*
+                m_Summary;
+    const ByteArray*
+                m_TbsHash;
+    uint64_t    m_FileSize;
+    const ByteArray*
+                m_FileHash;
+    mutable std::once_flag
+                m_TbsDecoded;
+    mutable AsnArena*
+                m_Arena;
+    mutable const TBSCertListAlt_t*
                 m_TbsCrl;
     const ByteArray*
                 m_CrlId;
@@ -117,8 +125,8 @@ private:
                 m_Issuer;
     uint64_t    m_ThisUpdate;
     uint64_t    m_NextUpdate;
-    std::vector<RevokedCertOffset>
-                m_RevokedCertOffsets;
+    RevocationTable
+                m_RevocationTable;
     const ByteArray*
                 m_AuthorityKeyId;
     const ByteArray*
@@ -148,7 +156,7 @@ public:
         return m_AuthorityKeyId;
     }
     size_t getCountRevokedCerts (void) const {
-        return m_RevokedCertOffsets.size();
+        return m_RevocationTable.count();
     }
     const ByteArray* getCrlId (void) const {
         return m_CrlId;
@@ -162,12 +170,17 @@ public:
     const ByteArray* getDeltaCrl (void) const {
         return m_DeltaCrl;
     }
-    const ByteArray* getEncoded (void) const {
-        return m_Encoded;
-    }
+    //  File-backed CRL is read from the file on the first access, the file must be the same
+    //  that was parsed (RET_UAPKI_CRL_NOT_FOUND otherwise), failed read is repeated on the next access
+    int getEncoded (
+        const ByteArray** baEncoded
+    ) const;
     const std::string& getFileName (void) const {
         return m_FileName;
     }
+    std::string getFilePath (void) const {
+        return m_DirName + m_FileName;
+    }
     const ByteArray* getIssuer (void) const {
         return m_Issuer;
     }
@@ -177,11 +190,16 @@ public:
     uint64_t getNextUpdate (void) const {
         return m_NextUpdate;
     }
+    const RevocationTable& getRevocationTable (void) const {
+        return m_RevocationTable;
+    }
     Cert::VerifyStatus getStatusSign (void) const {
         return m_StatusSign;
     }
-    const TBSCertListAlt_t* const getTbsCrl (void) const {
-        return m_TbsCrl;
+    const TBSCertListAlt_t* const getTbsCrl (void) const;
+    //  Hash of TBS for file-backed CRL, nullptr if the hash algorithm is not supported
+    const ByteArray* getTbsHash (void) const {
+        return m_TbsHash;
     }
     uint64_t getThisUpdate (void) const {
         return m_ThisUpdate;
@@ -195,6 +213,9 @@ public:
     uint32_t getVersion (void) const {
         return m_Version;
     }
+    bool isFileBacked (void) const {
+        return (m_Summary != nullptr);
+    }
 
 public:
     //  The group of functions that have lock_guard
@@ -208,6 +229,9 @@ public:
     void setActuality (
         const Actuality actuality
     );
+    void setDirName (
+        const std::string& dirName
+    );
     bool setFileName (
         const std::string& fileName
     );
@@ -228,9 +252,10 @@ public:
     int revokedCerts (
         const Cert::CerItem* cerSubject,
         std::vector<const RevokedCertItem*>& revokedItems
-    );
+    ) const;
 
 public:
+    friend class CrlStreamParser;
     friend int parseCrl (
         const ByteArray* baEncoded,
         CrlItem** crlItem
@@ -261,11 +286,7 @@ bool findRevokedCert (
     UapkiNS::CertStatus& status,
     RevokedCertItem& revokedCertItem
 );
-int parseRevokedCerts (
-    std::vector<RevokedCertOffset>& Offsets,
-    const uint8_t* bufEncoded,
-    const int lenEncoded
-);
+//  Takes ownership of baEncoded on success
 int parseCrl (
     const ByteArray* baEncoded,
     CrlItem** crlItem
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2021, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define FILE_MARKER "uapki/crl-refresher.cpp"
+
+#include <system_error>
+#include "crl-refresher.h"
+#include "http-helper.h"
+#include "macros-internal.h"
+#include "time-util.h"
+#include "uapki-errors.h"
+#include "uapki-ns-util.h"
+
+
+#define DEBUG_OUTCON(expression)
+#ifndef DEBUG_OUTCON
+#define DEBUG_OUTCON(expression) expression
+#endif
+
+
+using namespace std;
+
+
+namespace UapkiNS {
+
+namespace Crl {
+
+
+//  Interval of re-check when nothing is due (new targets wake up the thread immediately)
+static const uint64_t CHECK_INTERVAL    = 10 * 60 * 1000;
+
+
+CrlRefresher::Target::Target (void)
+    : authorityKeyId(nullptr)
+    , type(Type::UNDEFINED)
+    , jitter(0)
+    , retryTime(0)
+{
+}
+
+CrlRefresher::Target::~Target (void)
+{
+    ba_free(authorityKeyId);
+}
+
+
+CrlRefresher::CrlRefresher (
+        CrlStore& crlStore,
+        const Params& params
+)
+    : m_CrlStore(crlStore)
+    , m_Params(params)
+    , m_Stop(false)
+    , m_Changed(false)
+{
+}
+
+CrlRefresher::~CrlRefresher (void)
+{
+    stop();
+    for (auto& it : m_Targets) {
+        delete it.second;
+    }
+}
+
+int CrlRefresher::start (void)
+{
+    lock_guard<mutex> lock(m_Mutex);
+
+    if (m_Thread.joinable()) return RET_OK;
+
+    m_Stop = false;
+    try {
+        m_Thread = thread(&CrlRefresher::run, this);
+    }
+    catch (const system_error&) {
+        return RET_UAPKI_GENERAL_ERROR;
+    }
+    return RET_OK;
+}
+
+void CrlRefresher::stop (void)
+{
+    {
+        lock_guard<mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_CondVar.notify_all();
+    if (m_Thread.joinable()) {
+        m_Thread.join();
+    }
+}
+
+void CrlRefresher::track (
+        const ByteArray* baAuthorityKeyId,
+        const Type crlType,
+        const vector<string>& urisCrl,
+        const vector<string>& urisDeltaFromCert
+)
+{
+    if (!baAuthorityKeyId || urisCrl.empty()) return;
+
+    //  Same identification as CrlStore::removeObsolete(): full CRL is also distinguished by delta-URI
+    string s_id = Util::baToHex(baAuthorityKeyId) + ((crlType == Type::FULL) ? "-full" : "-delta");
+    if (!urisDeltaFromCert.empty()) {
+        s_id += "-" + urisDeltaFromCert[0];
+    }
+
+    lock_guard<mutex> lock(m_Mutex);
+
+    if (m_Targets.find(s_id) != m_Targets.end()) return;
+
+    Target* target = new Target();
+    if (!target) return;
+
+    target->authorityKeyId = ba_copy_with_alloc(baAuthorityKeyId, 0, 0);
+    target->type = crlType;
+    target->urisCrl = urisCrl;
+    target->urisDeltaFromCert = urisDeltaFromCert;
+    if (!target->authorityKeyId) {
+        delete target;
+        return;
+    }
+
+    //  Jitter spreads downloads of CRLs with the same nextUpdate (and between processes)
+    target->jitter = calcJitter(m_Params.jitter);
+
+    m_Targets[s_id] = target;
+    m_Changed = true;
+    m_CondVar.notify_all();
+}
+
+void CrlRefresher::trackStored (
+        Cert::CerStore& cerStore
+)
+{
+    const vector<Cert::CerItem*> cer_items = cerStore.getCerItems();
+
+    for (const auto& it : m_CrlStore.getCrlItems()) {
+        if (it->getActuality() == CrlItem::Actuality::OBSOLETE) continue;
+
+        vector<string> uris_full = it->getUris().fullCrl;
+        vector<string> uris_delta = it->getUris().deltaCrl;
+        if (uris_full.empty()) {
+            //  CRL usually has no distribution points, they are taken from a certificate issued by this CA
+            for (const auto& it_cer : cer_items) {
+                if (
+                    it_cer->getAuthorityKeyId() &&
+                    (ba_cmp(it_cer->getAuthorityKeyId(), it->getAuthorityKeyId()) == 0) &&
+                    !it_cer->getUris().fullCrl.empty()
+                ) {
+                    uris_full = it_cer->getUris().fullCrl;
+                    uris_delta = it_cer->getUris().deltaCrl;
+                    break;
+                }
+            }
+        }
+
+        if (it->getType() == Type::FULL) {
+            track(it->getAuthorityKeyId(), Type::FULL, uris_full, uris_delta);
+        }
+        else if (m_CrlStore.useDeltaCrl()) {
+            track(it->getAuthorityKeyId(), Type::DELTA, uris_delta, uris_delta);
+        }
+    }
+}
+
+size_t CrlRefresher::countTargets (void)
+{
+    lock_guard<mutex> lock(m_Mutex);
+
+    return m_Targets.size();
+}
+
+uint64_t CrlRefresher::calcDueTime (
+        const uint64_t nextUpdate,
+        const uint64_t msLeadTime,
+        const uint64_t msJitter,
+        const uint64_t retryTime
+)
+{
+    const uint64_t ahead = msLeadTime + msJitter;
+    const uint64_t due_time = (nextUpdate > ahead) ? nextUpdate - ahead : 0;
+    return (due_time > retryTime) ? due_time : retryTime;
+}
+
+uint64_t CrlRefresher::calcJitter (
+        const uint32_t jitter
+)
+{
+    SmartBA sba_random;
+
+    if (jitter == 0) return 0;
+    if (!sba_random.set(ba_alloc_by_len(4)) || (drbg_random(sba_random.get()) != RET_OK)) return 0;
+
+    const uint8_t* buf = sba_random.buf();
+    const uint32_t rnd = ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) | ((uint32_t)buf[2] << 8) | buf[3];
+    return (uint64_t)(rnd % (jitter + 1)) * 1000;
+}
+
+uint64_t CrlRefresher::calcRetryTime (
+        const bool isRefreshed,
+        const uint64_t nextUpdate,
+        const uint64_t msLeadTime,
+        const uint64_t msJitter,
+        const uint64_t now
+)
+{
+    if (!isRefreshed) return now + RETRY_INTERVAL;
+
+    //  The downloaded CRL expires within the lead time - do not repeat too often
+    return (calcDueTime(nextUpdate, msLeadTime, msJitter, 0) <= now) ? now + RETRY_INTERVAL : 0;
+}
+
+uint64_t CrlRefresher::dueTime (
+        const Target& target
+)
+{
+    //  Note: CrlItem is not kept - it may be replaced in the store at any time
+    const CrlItem* crl_item = m_CrlStore.getCrl(target.authorityKeyId, target.type, target.urisDeltaFromCert);
+    const uint64_t next_update = crl_item ? crl_item->getNextUpdate() : 0;
+    return calcDueTime(next_update, (uint64_t)m_Params.leadTime * 1000, target.jitter, target.retryTime);
+}
+
+bool CrlRefresher::refresh (
+        const Target& target
+)
+{
+    int ret = RET_UAPKI_CRL_NOT_DOWNLOADED;
+    CrlItem* crl_item = nullptr;
+    bool is_unique = false;
+
+    //  CrlStore::downloadCrl() adds CRL at the end, it is the atomic swap: getCrl() returns the newest CRL from now on
+    const vector<string> shuffled_uris = HttpHelper::randomURIs(target.urisCrl);
+    for (const auto& it : shuffled_uris) {
+        DEBUG_OUTCON(printf("CrlRefresher::refresh(), CrlStore::downloadCrl('%s')\n", it.c_str()));
+        //  stop() aborts the transfer, the thread doesn't wait for the end of download
+        ret = m_CrlStore.downloadCrl(it, is_unique, &crl_item, &m_Stop);
+        if ((ret == RET_OK) || m_Stop) break;
+    }
+    if (ret != RET_OK) return false;
+
+    DEBUG_OUTCON(printf("CrlRefresher::refresh(), is_unique: %d\n", is_unique));
+    return is_unique;
+}
+
+void CrlRefresher::run (void)
+{
+    unique_lock<mutex> lock(m_Mutex);
+
+    while (!m_Stop) {
+        uint64_t now = TimeUtil::mtimeNow();
+        m_Changed = false;
+        uint64_t next_check = now + CHECK_INTERVAL;
+
+        for (auto& it : m_Targets) {
+            Target& target = *it.second;
+            if (m_Stop) break;
+
+            uint64_t due_time = dueTime(target);
+            if (due_time <= now) {
+                //  Network I/O is done without lock, targets are never removed while the thread runs
+                lock.unlock();
+                const bool is_refreshed = refresh(target);
+                lock.lock();
+
+                now = TimeUtil::mtimeNow();
+                const CrlItem* crl_item = m_CrlStore.getCrl(target.authorityKeyId, target.type, target.urisDeltaFromCert);
+                target.retryTime = calcRetryTime(
+                    is_refreshed,
+                    crl_item ? crl_item->getNextUpdate() : 0,
+                    (uint64_t)m_Params.leadTime * 1000,
+                    target.jitter,
+                    now
+                );
+                due_time = dueTime(target);
+            }
+            if (due_time < next_check) {
+                next_check = due_time;
+            }
+        }
+
+        if (next_check > now) {
+            (void)m_CondVar.wait_for(lock, chrono::milliseconds(next_check - now), [this]() {
+                return (m_Stop || m_Changed);
+            });
+        }
+    }
+}
+
+
+}   //  end namespace Crl
+
+}   //  end namespace UapkiNS
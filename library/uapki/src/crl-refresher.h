@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2021, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UAPKI_CRL_REFRESHER_H
+#define UAPKI_CRL_REFRESHER_H
+
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "cer-store.h"
+#include "crl-store.h"
+
+
+namespace UapkiNS {
+
+namespace Crl {
+
+
+//  Background downloading of CRLs before their nextUpdate, so that validation by CRL finds
+//  the actual CRL in the store and does not wait for the network.
+//  Download sources (URIs from certificates) are registered by track() and trackStored()
+class CrlRefresher {
+public:
+    //  Interval of retry after failed download or when the CA has not published a newer CRL yet
+    static const uint64_t RETRY_INTERVAL = 5 * 60 * 1000;
+
+    struct Params {
+        static const uint32_t LEAD_TIME_DEFAULT = 3600;     //  In seconds
+        static const uint32_t JITTER_DEFAULT    = 600;      //  In seconds
+
+        uint32_t    leadTime;
+        uint32_t    jitter;
+
+        Params (void)
+            : leadTime(LEAD_TIME_DEFAULT)
+            , jitter(JITTER_DEFAULT)
+        {}
+    };  //  end struct Params
+
+private:
+    struct Target {
+        ByteArray*  authorityKeyId;
+        Type        type;
+        std::vector<std::string>
+                    urisCrl;
+        std::vector<std::string>
+                    urisDeltaFromCert;
+        uint64_t    jitter;
+        uint64_t    retryTime;
+
+        Target (void);
+        ~Target (void);
+    };  //  end struct Target
+
+    CrlStore&   m_CrlStore;
+    Params      m_Params;
+    std::mutex  m_Mutex;
+    std::condition_variable
+                m_CondVar;
+    std::thread m_Thread;
+    std::atomic<bool>
+                m_Stop;             //  Also read by download_write_data() of CrlStore without lock
+    bool        m_Changed;
+    std::map<std::string, Target*>
+                m_Targets;
+
+public:
+    CrlRefresher (
+        CrlStore& crlStore,
+        const Params& params
+    );
+    ~CrlRefresher (void);
+
+    const Params& getParams (void) const {
+        return m_Params;
+    }
+
+public:
+    //  Time of download: leadTime and jitter (in ms) before nextUpdate (0 - CRL is absent),
+    //  not earlier than retryTime
+    static uint64_t calcDueTime (
+        const uint64_t nextUpdate,
+        const uint64_t msLeadTime,
+        const uint64_t msJitter,
+        const uint64_t retryTime
+    );
+    //  Random jitter (in ms) in range [0, jitter] seconds
+    static uint64_t calcJitter (
+        const uint32_t jitter
+    );
+    //  Time of next attempt after download (0 - by nextUpdate of CRL): failed download
+    //  and CRL that expires within the lead time are retried after RETRY_INTERVAL
+    static uint64_t calcRetryTime (
+        const bool isRefreshed,
+        const uint64_t nextUpdate,
+        const uint64_t msLeadTime,
+        const uint64_t msJitter,
+        const uint64_t now
+    );
+
+public:
+    //  The group of functions that have lock_guard
+    int start (void);
+    void stop (void);
+    void track (
+        const ByteArray* baAuthorityKeyId,
+        const Type crlType,
+        const std::vector<std::string>& urisCrl,
+        const std::vector<std::string>& urisDeltaFromCert
+    );
+    //  Registers CRLs that are in the store already (loaded from directory), URIs are taken from CRL
+    //  or from a certificate of the same CA
+    void trackStored (
+        Cert::CerStore& cerStore
+    );
+    size_t countTargets (void);
+
+private:
+    uint64_t dueTime (
+        const Target& target
+    );
+    bool refresh (
+        const Target& target
+    );
+    void run (void);
+
+};  //  end class CrlRefresher
+
+
+}   //  end namespace Crl
+
+}   //  end namespace UapkiNS
+
+#endif
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2021, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define FILE_MARKER "uapki/crl-revocation-table.cpp"
+
+#include <algorithm>
+#include <string.h>
+#include "crl-revocation-table.h"
+#include "asn1-utils.h"
+#include "macros-internal.h"
+#include "oid-registry.h"
+#include "uapki-errors.h"
+
+
+using namespace std;
+
+
+namespace UapkiNS {
+
+namespace Crl {
+
+
+//  Value of CRLReason that is out of the range of int8_t, it is reported as undefined reason
+static const int8_t CRL_REASON_OUT_OF_RANGE = 127;
+
+
+static uint64_t time_from_tlv (
+        const AsnTlv& tlvTime
+)
+{
+    //  OCTET_STRING_t is the view of content, asn_UT2time()/asn_GT2time() only read it
+    OCTET_STRING_t asn_time;
+    memset(&asn_time, 0, sizeof(asn_time));
+    asn_time.buf = (uint8_t*)tlvTime.value;
+    asn_time.size = (int)tlvTime.len;
+
+    switch (tlvTime.tag) {
+    case 0x17: return asn_UT2time(&asn_time, nullptr);
+    case 0x18: return asn_GT2time(&asn_time, nullptr);
+    default: break;
+    }
+    return 0;
+}   //  time_from_tlv
+
+static bool read_extnvalue (
+        const AsnTlv& tlvExtnValue,
+        AsnTlv& tlvValue
+)
+{
+    //  extnValue is OCTET STRING that contains one DER-element
+    return (
+        (asn_tlv_read(tlvExtnValue.value, tlvExtnValue.len, &tlvValue) == RET_OK) &&
+        (tlvValue.tlv_len == tlvExtnValue.len)
+    );
+}   //  read_extnvalue
+
+static int parse_entry_extensions (
+        const AsnTlv& tlvExtensions,
+        int8_t& crlReason,
+        uint64_t& invalidityDate,
+        uint8_t& flags
+)
+{
+    AsnTlv tlv_extn, tlv_item, tlv_value;
+    AsnTlvCursor cursor, cursor_extn;
+
+    if ((tlvExtensions.tag != 0x30) || (asn_tlv_enter(&cursor, &tlvExtensions) != RET_OK)) return RET_UAPKI_INVALID_STRUCT;
+
+    while (!asn_tlv_cursor_end(&cursor)) {
+        //  Extension ::= SEQUENCE { extnID OID, critical BOOLEAN DEFAULT FALSE, extnValue OCTET STRING }
+        if (
+            (asn_tlv_next(&cursor, &tlv_extn) != RET_OK) ||
+            (tlv_extn.tag != 0x30) ||
+            (asn_tlv_enter(&cursor_extn, &tlv_extn) != RET_OK) ||
+            (asn_tlv_next(&cursor_extn, &tlv_item) != RET_OK) ||
+            (tlv_item.tag != 0x06)
+        ) return RET_UAPKI_INVALID_STRUCT;
+
+        const OidId oid_id = oid_id_from_der(tlv_item.value, tlv_item.len);
+        if (asn_tlv_find_tag(&cursor_extn, 0x04, &tlv_item) != RET_OK) return RET_UAPKI_INVALID_STRUCT;
+
+        //  Malformed values are ignored like it was done by ExtensionHelper
+        switch (oid_id) {
+        case OID_ID_X509v3_CRLReason:
+            if (
+                read_extnvalue(tlv_item, tlv_value) &&
+                (tlv_value.tag == 0x0A) && (tlv_value.len > 0) && (tlv_value.len <= 4)
+            ) {
+                uint32_t u32_reason = 0;
+                for (size_t i = 0; i < tlv_value.len; i++) {
+                    u32_reason = (u32_reason << 8) | tlv_value.value[i];
+                }
+                crlReason = (u32_reason < (uint32_t)CRL_REASON_OUT_OF_RANGE) ? (int8_t)u32_reason : CRL_REASON_OUT_OF_RANGE;
+            }
+            break;
+        case OID_ID_X509v3_InvalidityDate:
+            if (read_extnvalue(tlv_item, tlv_value)) {
+                invalidityDate = time_from_tlv(tlv_value);
+            }
+            break;
+        case OID_ID_X509v3_HoldInstructionCode:
+            flags |= RevocationTable::FLAG_HOLD_INSTRUCTION;
+            break;
+        default:
+            break;
+        }
+    }
+
+    return RET_OK;
+}   //  parse_entry_extensions
+
+
+RevocationTable::RevocationTable (void)
+{
+    m_SerialOffsets.push_back(0);
+}
+
+int RevocationTable::addEntry (
+        const uint8_t* bufEntry,
+        const size_t lenEntry
+)
+{
+    //  RevokedCertificate ::= SEQUENCE { userCertificate INTEGER, revocationDate Time, crlEntryExtensions Extensions OPTIONAL }
+    AsnTlv tlv_entry, tlv_sn, tlv_time, tlv_extns;
+    AsnTlvCursor cursor;
+    int8_t crl_reason = (int8_t)UapkiNS::CrlReason::UNDEFINED;
+    uint64_t invalidity_date = 0;
+    uint8_t flags = 0;
+
+    if (
+        (asn_tlv_read(bufEntry, lenEntry, &tlv_entry) != RET_OK) ||
+        (tlv_entry.tag != 0x30) ||
+        (tlv_entry.len < 4) ||
+        (asn_tlv_enter(&cursor, &tlv_entry) != RET_OK) ||
+        (asn_tlv_next(&cursor, &tlv_sn) != RET_OK) ||
+        (tlv_sn.tag != 0x02) ||
+        (asn_tlv_next(&cursor, &tlv_time) != RET_OK) ||
+        ((tlv_time.tag != 0x17) && (tlv_time.tag != 0x18))
+    ) return RET_UAPKI_INVALID_STRUCT;
+
+    if (!asn_tlv_cursor_end(&cursor)) {
+        if (
+            (asn_tlv_next(&cursor, &tlv_extns) != RET_OK) ||
+            (parse_entry_extensions(tlv_extns, crl_reason, invalidity_date, flags) != RET_OK)
+        ) return RET_UAPKI_INVALID_STRUCT;
+    }
+
+    if (!pushSerial(tlv_sn.value, tlv_sn.len)) return RET_UAPKI_INVALID_STRUCT;
+
+    m_RevocationDates.push_back(time_from_tlv(tlv_time));
+    m_InvalidityDates.push_back(invalidity_date);
+    m_CrlReasons.push_back(crl_reason);
+    m_Flags.push_back(flags);
+    return RET_OK;
+}
+
+int RevocationTable::addEntries (
+        const uint8_t* bufEntries,
+        const size_t lenEntries
+)
+{
+    if (!bufEntries || (lenEntries == 0)) return RET_OK;
+
+    AsnTlv tlv_list, tlv_entry;
+    AsnTlvCursor cursor;
+    if (
+        (asn_tlv_read(bufEntries, lenEntries, &tlv_list) != RET_OK) ||
+        (tlv_list.tag != 0x30) ||
+        (asn_tlv_enter(&cursor, &tlv_list) != RET_OK)
+    ) return RET_UAPKI_INVALID_STRUCT;
+
+    //  Average entry (serial number, UTCTime and reason) is about 40 bytes
+    m_RevocationDates.reserve(m_RevocationDates.size() + tlv_list.len / 40 + 1);
+    while (!asn_tlv_cursor_end(&cursor)) {
+        if (
+            (asn_tlv_next(&cursor, &tlv_entry) != RET_OK) ||
+            (addEntry(tlv_entry.tlv, tlv_entry.tlv_len) != RET_OK)
+        ) {
+            clear();
+            return RET_UAPKI_INVALID_STRUCT;
+        }
+    }
+
+    return RET_OK;
+}
+
+void RevocationTable::clear (void)
+{
+    m_Serials.clear();
+    m_SerialOffsets.clear();
+    m_SerialOffsets.push_back(0);
+    m_RevocationDates.clear();
+    m_InvalidityDates.clear();
+    m_CrlReasons.clear();
+    m_Flags.clear();
+    m_SortedBySerial.clear();
+}
+
+void RevocationTable::complete (void)
+{
+    m_SortedBySerial.resize(count());
+    for (size_t i = 0; i < m_SortedBySerial.size(); i++) {
+        m_SortedBySerial[i] = (uint32_t)i;
+    }
+    //  Entries with equal serial numbers keep the order of CRL
+    sort(m_SortedBySerial.begin(), m_SortedBySerial.end(), [this](const uint32_t a, const uint32_t b) {
+        return isOrdered(a, b);
+    });
+
+    shrinkToFit();
+}
+
+void RevocationTable::find (
+        const ByteArray* baSerialNumber,
+        vector<size_t>& indexes
+) const
+{
+    const uint8_t* buf = ba_get_buf_const(baSerialNumber);
+    const size_t len = ba_get_len(baSerialNumber);
+
+    auto it = lower_bound(m_SortedBySerial.begin(), m_SortedBySerial.end(), 0, [this, buf, len](const uint32_t index, const int) {
+        return (compareSerial(index, buf, len) < 0);
+    });
+    for (; (it != m_SortedBySerial.end()) && (compareSerial(*it, buf, len) == 0); it++) {
+        indexes.push_back(*it);
+    }
+}
+
+int RevocationTable::getSerialNumber (
+        const size_t index,
+        ByteArray** baSerialNumber
+) const
+{
+    if (index >= count()) return RET_UAPKI_INVALID_PARAMETER;
+
+    *baSerialNumber = ba_alloc_from_uint8(getSerialNumberBuf(index), getSerialNumberLen(index));
+    return (*baSerialNumber) ? RET_OK : RET_UAPKI_GENERAL_ERROR;
+}
+
+int RevocationTable::compareSerial (
+        const uint32_t index,
+        const uint8_t* bufSerialNumber,
+        const size_t lenSerialNumber
+) const
+{
+    //  Order by length then by bytes, it is enough for the search of equal values
+    const size_t len = getSerialNumberLen(index);
+    if (len != lenSerialNumber) return (len < lenSerialNumber) ? -1 : 1;
+    return (len > 0) ? memcmp(getSerialNumberBuf(index), bufSerialNumber, len) : 0;
+}
+
+bool RevocationTable::isOrdered (
+        const uint32_t indexA,
+        const uint32_t indexB
+) const
+{
+    const int r = compareSerial(indexA, getSerialNumberBuf(indexB), getSerialNumberLen(indexB));
+    return (r < 0) || ((r == 0) && (indexA < indexB));
+}
+
+bool RevocationTable::pushSerial (
+        const uint8_t* bufSerialNumber,
+        size_t lenSerialNumber
+)
+{
+    //  Leading zero bytes are skipped, like asn_INTEGER2ba() does
+    while ((lenSerialNumber > 0) && (*bufSerialNumber == 0)) {
+        bufSerialNumber++;
+        lenSerialNumber--;
+    }
+    if ((uint64_t)m_Serials.size() + lenSerialNumber > 0xFFFFFFFF) return false;
+
+    m_Serials.insert(m_Serials.end(), bufSerialNumber, bufSerialNumber + lenSerialNumber);
+    m_SerialOffsets.push_back((uint32_t)m_Serials.size());
+    return true;
+}
+
+void RevocationTable::shrinkToFit (void)
+{
+    m_Serials.shrink_to_fit();
+    m_SerialOffsets.shrink_to_fit();
+    m_RevocationDates.shrink_to_fit();
+    m_InvalidityDates.shrink_to_fit();
+    m_CrlReasons.shrink_to_fit();
+    m_Flags.shrink_to_fit();
+}
+
+
+}   //  end namespace Crl
+
+}   //  end namespace UapkiNS
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2021, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UAPKI_CRL_REVOCATION_TABLE_H
+#define UAPKI_CRL_REVOCATION_TABLE_H
+
+
+#include <vector>
+#include "byte-array.h"
+#include "uapki-ns.h"
+
+
+namespace UapkiNS {
+
+namespace Crl {
+
+
+//  Columnar representation of revokedCertificates, it is built once while parsing CRL:
+//  the serial numbers are packed into one blob, the other fields of entries are stored in
+//  separate columns. Lookup and enumeration of entries do not decode ASN.1
+class RevocationTable {
+public:
+    static const uint8_t FLAG_HOLD_INSTRUCTION = 0x01;
+
+private:
+    //  Serial numbers without leading zero bytes (as CerItem::getSerialNumber()),
+    //  entry i is m_Serials[m_SerialOffsets[i]..m_SerialOffsets[i + 1])
+    std::vector<uint8_t>
+                m_Serials;
+    std::vector<uint32_t>
+                m_SerialOffsets;
+    std::vector<uint64_t>
+                m_RevocationDates;
+    std::vector<uint64_t>
+                m_InvalidityDates;
+    std::vector<int8_t>
+                m_CrlReasons;
+    std::vector<uint8_t>
+                m_Flags;
+    //  Indexes of entries ordered by serial number
+    std::vector<uint32_t>
+                m_SortedBySerial;
+
+public:
+    RevocationTable (void);
+
+    size_t count (void) const {
+        return m_RevocationDates.size();
+    }
+    UapkiNS::CrlReason getCrlReason (
+        const size_t index
+    ) const {
+        return (UapkiNS::CrlReason)m_CrlReasons[index];
+    }
+    uint64_t getInvalidityDate (
+        const size_t index
+    ) const {
+        return m_InvalidityDates[index];
+    }
+    uint64_t getRevocationDate (
+        const size_t index
+    ) const {
+        return m_RevocationDates[index];
+    }
+    const uint8_t* getSerialNumberBuf (
+        const size_t index
+    ) const {
+        return m_Serials.data() + m_SerialOffsets[index];
+    }
+    size_t getSerialNumberLen (
+        const size_t index
+    ) const {
+        return m_SerialOffsets[index + 1] - m_SerialOffsets[index];
+    }
+    bool isHoldInstruction (
+        const size_t index
+    ) const {
+        return ((m_Flags[index] & FLAG_HOLD_INSTRUCTION) != 0);
+    }
+
+public:
+    //  Adds one RevokedCertificate (complete TLV)
+    int addEntry (
+        const uint8_t* bufEntry,
+        const size_t lenEntry
+    );
+    //  Adds all entries of revokedCertificates (complete TLV of SEQUENCE OF)
+    int addEntries (
+        const uint8_t* bufEntries,
+        const size_t lenEntries
+    );
+    void clear (void);
+    //  Must be called after the last added entry, builds the order for find()
+    void complete (void);
+    void find (
+        const ByteArray* baSerialNumber,
+        std::vector<size_t>& indexes
+    ) const;
+    int getSerialNumber (
+        const size_t index,
+        ByteArray** baSerialNumber
+    ) const;
+
+private:
+    int compareSerial (
+        const uint32_t index,
+        const uint8_t* bufSerialNumber,
+        const size_t lenSerialNumber
+    ) const;
+    bool isOrdered (
+        const uint32_t indexA,
+        const uint32_t indexB
+    ) const;
+    bool pushSerial (
+        const uint8_t* bufSerialNumber,
+        size_t lenSerialNumber
+    );
+    void shrinkToFit (void);
+
+};  //  end class RevocationTable
+
+
+}   //  end namespace Crl
+
+}   //  end namespace UapkiNS
+
+#endif
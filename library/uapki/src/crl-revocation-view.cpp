@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2021, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define FILE_MARKER "uapki/crl-revocation-view.cpp"
+
+#include "crl-revocation-view.h"
+#include "macros-internal.h"
+#include "uapki-errors.h"
+
+
+#define DEBUG_OUTCON(expression)
+#ifndef DEBUG_OUTCON
+#define DEBUG_OUTCON(expression) expression
+#endif
+
+
+using namespace std;
+
+
+namespace UapkiNS {
+
+namespace Crl {
+
+
+RevocationView::RevocationView (
+        const CrlItem* iFullCrl
+)
+    : m_FullCrl(iFullCrl)
+    , m_DeltaCrlNumber(nullptr)
+{
+}
+
+RevocationView::~RevocationView (void)
+{
+    ba_free((ByteArray*)m_DeltaCrlNumber);
+}
+
+int RevocationView::applyDelta (
+        const CrlItem* deltaCrl
+)
+{
+    if (!deltaCrl || (deltaCrl->getType() != Type::DELTA)) return RET_UAPKI_INVALID_PARAMETER;
+    if (
+        (ba_cmp(deltaCrl->getAuthorityKeyId(), m_FullCrl->getAuthorityKeyId()) != 0) ||
+        (ba_cmp(deltaCrl->getDeltaCrl(), m_FullCrl->getCrlNumber()) != 0)
+    ) return RET_UAPKI_INVALID_PARAMETER;
+
+    //  CRL numbers are compared as unsigned values without leading zeros (ba_cmp compares the length first)
+    if (m_DeltaCrlNumber && (ba_cmp(deltaCrl->getCrlNumber(), m_DeltaCrlNumber) <= 0)) return RET_OK;
+
+    ByteArray* ba_crlnumber = ba_copy_with_alloc(deltaCrl->getCrlNumber(), 0, 0);
+    if (!ba_crlnumber) return RET_UAPKI_GENERAL_ERROR;
+
+    //  Delta CRL lists all changes since the full CRL (RFC 5280, 5.2.4), so the newest delta replaces
+    //  the entries of the previous one entirely: the entry that is absent in it has the status of full CRL
+    const RevocationTable& table = deltaCrl->getRevocationTable();
+    map<string, vector<RevokedCertItem>> delta_entries;
+    for (size_t i = 0; i < table.count(); i++) {
+        const string s_sn((const char*)table.getSerialNumberBuf(i), table.getSerialNumberLen(i));
+        delta_entries[s_sn].push_back(RevokedCertItem(
+            table.getRevocationDate(i),
+            table.getCrlReason(i),
+            table.getInvalidityDate(i)
+        ));
+    }
+    m_DeltaEntries.swap(delta_entries);
+
+    DEBUG_OUTCON(printf("RevocationView::applyDelta(), applied %zu entries, count delta entries: %zu\n", table.count(), m_DeltaEntries.size()));
+    ba_free((ByteArray*)m_DeltaCrlNumber);
+    m_DeltaCrlNumber = ba_crlnumber;
+    return RET_OK;
+}
+
+int RevocationView::revokedCerts (
+        const Cert::CerItem* cerSubject,
+        vector<const RevokedCertItem*>& revokedItems
+) const
+{
+    if (!cerSubject) return RET_UAPKI_INVALID_PARAMETER;
+
+    const int ret = m_FullCrl->revokedCerts(cerSubject, revokedItems);
+    if ((ret != RET_OK) || m_DeltaEntries.empty()) return ret;
+
+    const ByteArray* ba_sn = cerSubject->getSerialNumber();
+    const auto it = m_DeltaEntries.find(string((const char*)ba_get_buf_const(ba_sn), ba_get_len(ba_sn)));
+    if (it == m_DeltaEntries.end()) return RET_OK;
+
+    for (const auto& it_item : it->second) {
+        const RevokedCertItem* revcert_item = new RevokedCertItem(it_item);
+        if (!revcert_item) return RET_UAPKI_GENERAL_ERROR;
+        revokedItems.push_back(revcert_item);
+    }
+    return RET_OK;
+}
+
+
+}   //  end namespace Crl
+
+}   //  end namespace UapkiNS
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2021, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UAPKI_CRL_REVOCATION_VIEW_H
+#define UAPKI_CRL_REVOCATION_VIEW_H
+
+
+#include <map>
+#include <string>
+#include <vector>
+#include "crl-item.h"
+
+
+namespace UapkiNS {
+
+namespace Crl {
+
+
+//  Revocation status by full CRL and its delta CRLs. The entries of full CRL are not copied (base table),
+//  the newest applicable delta CRL replaces the entries of the previously applied one (each delta CRL is
+//  cumulative since the full CRL), the cost is O(size of delta). Entries removeFromCRL are kept in the view,
+//  the status on the validation time is resolved by findRevokedCert()
+class RevocationView {
+    const CrlItem*
+                m_FullCrl;
+    const ByteArray*
+                m_DeltaCrlNumber;
+    std::map<std::string, std::vector<RevokedCertItem>>
+                m_DeltaEntries;
+
+public:
+    RevocationView (
+        const CrlItem* iFullCrl
+    );
+    ~RevocationView (void);
+
+    size_t getCountDeltaEntries (void) const {
+        return m_DeltaEntries.size();
+    }
+    const ByteArray* getDeltaCrlNumber (void) const {
+        return m_DeltaCrlNumber;
+    }
+    const CrlItem* getFullCrl (void) const {
+        return m_FullCrl;
+    }
+
+public:
+    //  Delta CRL must be based on the full CRL of view, delta CRL that is not newer than applied is skipped
+    int applyDelta (
+        const CrlItem* deltaCrl
+    );
+    int revokedCerts (
+        const Cert::CerItem* cerSubject,
+        std::vector<const RevokedCertItem*>& revokedItems
+    ) const;
+
+};  //  end class RevocationView
+
+
+}   //  end namespace Crl
+
+}   //  end namespace UapkiNS
+
+#endif
@@ -31,10 +31,13 @@
 #include <string.h>
 #include "crl-store.h"
 #include "ba-utils.h"
+#include "crl-stream-parser.h"
 #include "dirent-internal.h"
 #include "extension-helper.h"
+#include "http-helper.h"
 #include "macros-internal.h"
 #include "oids.h"
+#include "store-loader.h"
 #include "time-util.h"
 #include "uapki-errors.h"
 #include "uapki-ns-util.h"
@@ -48,11 +51,80 @@
 
 using namespace std;
 
+
 namespace UapkiNS {
 
 namespace Crl {
 
 
+struct DownloadStream {
+    CrlStreamParser*
+                parser;             //  Store with directory: CRL is parsed and written to file by chunks
+    vector<uint8_t>
+                data;               //  Store without directory: CRL is kept in memory
+    const atomic<bool>*
+                abortFlag;
+
+    DownloadStream (void)
+        : parser(nullptr)
+        , abortFlag(nullptr)
+    {}
+};  //  end struct DownloadStream
+
+static size_t download_write_data (
+        const uint8_t* buf,
+        const size_t len,
+        void* userData
+)
+{
+    DownloadStream* stream = (DownloadStream*)userData;
+    if (stream->abortFlag && stream->abortFlag->load()) return 0;
+
+    if (stream->parser) {
+        return CrlStreamParser::writeData(buf, len, stream->parser);
+    }
+    stream->data.insert(stream->data.end(), buf, buf + len);
+    return len;
+}   //  download_write_data
+
+static int generate_tmppath (
+        const string& path,
+        string& tmpPath
+)
+{
+    //  Temporary name is unique between threads and processes, it is not listed by loadDir()
+    SmartBA sba_random;
+    if (!sba_random.set(ba_alloc_by_len(8))) return RET_UAPKI_GENERAL_ERROR;
+
+    const int ret = drbg_random(sba_random.get());
+    if (ret != RET_OK) return ret;
+
+    tmpPath = path + Util::baToHex(sba_random.get()) + ".tmp";
+    return RET_OK;
+}   //  generate_tmppath
+
+static int parse_in_memory (
+        const string& fileName,
+        CrlItem** crlItem
+)
+{
+    //  File-backed CRL is verified by the hash of TBS. If the signature algorithm has no such hash
+    //  (e.g. RSA-PSS) CRL is kept in memory
+    delete *crlItem;
+    *crlItem = nullptr;
+
+    SmartBA sba_encoded;
+    int ret = ba_alloc_from_file(fileName.c_str(), &sba_encoded);
+    if (ret != RET_OK) return ret;
+
+    ret = parseCrl(sba_encoded.get(), crlItem);
+    if (ret == RET_OK) {
+        (void)sba_encoded.set(nullptr);
+    }
+    return ret;
+}   //  parse_in_memory
+
+
 static bool check_uris_delta (
         const Type crlType,
         const vector<string>& urisDeltaFromCrl,
@@ -126,32 +198,102 @@ int CrlStore::addCrl (
         CrlItem** crlItem
 )
 {
-    lock_guard<mutex> lock(m_Mutex);
-
     int ret = RET_OK;
     CrlItem* parsed_item = nullptr;
     CrlItem* added_item = nullptr;
 
-    DO(parseCrl(baEncoded, &parsed_item));
+    if (permanent && !m_Path.empty()) {
+        //  CRL of the store is written to the file and is not kept in memory, as after downloadCrl()
+        CrlStreamParser parser;
+        string s_tmppath;
+
+        DO(generate_tmppath(m_Path, s_tmppath));
+        DO(parser.open(s_tmppath));
+        ret = parser.write(ba_get_buf_const(baEncoded), ba_get_len(baEncoded));
+        const int ret_finish = parser.finish(&parsed_item);
+        if (ret == RET_OK) {
+            ret = ret_finish;
+        }
+        if (ret != RET_OK) {
+            (void)delete_file(s_tmppath.c_str());
+            SET_ERROR(ret);
+        }
 
-    added_item = addItem(parsed_item);
-    isUnique = (added_item == parsed_item);
-    if (isUnique) {
-        parsed_item = nullptr;
-    }
-    if (crlItem) {
-        *crlItem = added_item;
+        DO(addTempFile(s_tmppath, parsed_item, isUnique, crlItem));
+        //  Like for CRL in memory, baEncoded is owned by store on success
+        ba_free((ByteArray*)baEncoded);
+        return RET_OK;
     }
 
-    if (isUnique && permanent && !m_Path.empty()) {
-        if (added_item->setFileName(added_item->generateFileName())) {
-            ret = added_item->saveToFile(m_Path);
+    {   //  begin lock_guard
+        lock_guard<mutex> lock(m_Mutex);
+
+        DO(parseCrl(baEncoded, &parsed_item));
+
+        added_item = addItem(parsed_item);
+        isUnique = (added_item == parsed_item);
+        if (isUnique) {
+            parsed_item = nullptr;
         }
-        else {
-            ret = RET_UAPKI_GENERAL_ERROR;
+        if (crlItem) {
+            *crlItem = added_item;
         }
+    }   //  end lock_guard
+
+cleanup:
+    delete parsed_item;
+    return ret;
+}
+
+int CrlStore::downloadCrl (
+        const string& uri,
+        bool& isUnique,
+        CrlItem** crlItem,
+        const atomic<bool>* abortFlag
+)
+{
+    int ret = RET_OK;
+    SmartBA sba_crl;
+    string s_tmppath;
+    CrlStreamParser parser;
+    DownloadStream stream;
+    CrlItem* parsed_item = nullptr;
+
+    stream.abortFlag = abortFlag;
+    //  Store without directory keeps CRL in memory only
+    if (m_Path.empty()) {
+        ret = HttpHelper::get(uri, download_write_data, &stream);
+        if ((ret != RET_OK) || stream.data.empty()) return RET_UAPKI_CRL_NOT_DOWNLOADED;
+        if (!sba_crl.set(ba_alloc_from_uint8(stream.data.data(), stream.data.size()))) return RET_UAPKI_GENERAL_ERROR;
+
+        ret = addCrl(sba_crl.get(), true, isUnique, crlItem);
+        if (ret == RET_OK) {
+            sba_crl.set(nullptr);
+        }
+        return ret;
     }
 
+    DO(generate_tmppath(m_Path, s_tmppath));
+    DO(parser.open(s_tmppath));
+    stream.parser = &parser;
+    ret = HttpHelper::get(uri, download_write_data, &stream);
+    if (ret == RET_OK) {
+        ret = parser.finish(&parsed_item);
+    }
+    else {
+        //  Error of parsing aborts the transfer, finish() also closes the file
+        const int ret_parse = parser.finish(&parsed_item);
+        ret = (parser.isFailed()) ? ret_parse : RET_UAPKI_CRL_NOT_DOWNLOADED;
+    }
+    if (ret != RET_OK) {
+        (void)delete_file(s_tmppath.c_str());
+        SET_ERROR(ret);
+    }
+
+    //  addTempFile() takes ownership of parsed_item and the temporary file
+    ret = addTempFile(s_tmppath, parsed_item, isUnique, crlItem);
+    parsed_item = nullptr;
+
 cleanup:
     delete parsed_item;
     return ret;
@@ -312,12 +454,55 @@ int CrlStore::removeCrl (
             const string s_fullpath = m_Path + it->getFileName();
             (void)delete_file(s_fullpath.c_str());
         }
+        removeViews(it);
         delete it;
     }
 
     return ret;
 }
 
+int CrlStore::revokedCerts (
+        const CrlItem* fullCrl,
+        const CrlItem* deltaCrl,
+        const Cert::CerItem* cerSubject,
+        vector<const RevokedCertItem*>& revokedItems
+)
+{
+    lock_guard<mutex> lock(m_Mutex);
+
+    if (!fullCrl || (fullCrl->getType() != Type::FULL) || !cerSubject) return RET_UAPKI_INVALID_PARAMETER;
+
+    RevocationView* view = nullptr;
+    vector<RevocationView*> views;
+    for (auto& it : m_Views) {
+        if (it->getFullCrl() == fullCrl) {
+            view = it;
+            views.push_back(it);
+        }
+        else if (it->getFullCrl()->getActuality() == CrlItem::Actuality::OBSOLETE) {
+            //  Full CRL is replaced by newer one, its view is not needed anymore
+            delete it;
+        }
+        else {
+            views.push_back(it);
+        }
+    }
+    m_Views.swap(views);
+
+    if (!view) {
+        view = new RevocationView(fullCrl);
+        if (!view) return RET_UAPKI_GENERAL_ERROR;
+        m_Views.push_back(view);
+    }
+
+    if (deltaCrl) {
+        const int ret = view->applyDelta(deltaCrl);
+        if (ret != RET_OK) return ret;
+    }
+
+    return view->revokedCerts(cerSubject, revokedItems);
+}
+
 CrlItem* CrlStore::addItem (
         CrlItem* item
 )
@@ -349,49 +534,116 @@ CrlItem* CrlStore::addItem (
     return item;
 }
 
-int CrlStore::loadDir (void)
+int CrlStore::addTempFile (
+        const string& tmpPath,
+        CrlItem* parsedItem,
+        bool& isUnique,
+        CrlItem** crlItem
+)
 {
-    DIR* dir = nullptr;
-    struct dirent* in_file;
+    int ret = RET_OK;
+    CrlItem* added_item = nullptr;
+    bool is_renamed = false;
 
-    if (m_Path.empty()) return RET_OK;
+    if (!parsedItem->getTbsHash()) {
+        DO(parse_in_memory(tmpPath, &parsedItem));
+    }
 
-    dir = opendir(m_Path.c_str());
-    if (!dir) return RET_UAPKI_CRL_STORE_LOAD_ERROR;
+    {   //  begin lock_guard
+        lock_guard<mutex> lock(m_Mutex);
 
-    while ((in_file = readdir(dir))) {
-        if (!strcmp(in_file->d_name, ".") || !strcmp(in_file->d_name, "..")) {
-            continue;
+        added_item = addItem(parsedItem);
+        isUnique = (added_item == parsedItem);
+        if (isUnique) {
+            parsedItem = nullptr;
+            const string s_filename = added_item->generateFileName();
+            const string s_fullpath = m_Path + s_filename;
+            (void)delete_file(s_fullpath.c_str());
+            is_renamed = (!s_filename.empty() && (rename(tmpPath.c_str(), s_fullpath.c_str()) == 0));
+            if (!is_renamed) {
+                //  Item without file is not kept: addItem() has appended it
+                m_Items.pop_back();
+                parsedItem = added_item;
+                SET_ERROR(RET_UAPKI_FILE_WRITE_ERROR);
+            }
+            (void)added_item->setFileName(s_filename);
+            added_item->setDirName(m_Path);
         }
-
-        //  Check file-extension
-        const string s_name = string(in_file->d_name);
-        const size_t pos = s_name.rfind(CRL_EXT);
-        if (pos != s_name.length() - CRL_EXT_LEN) {
-            continue;
+        if (crlItem) {
+            *crlItem = added_item;
         }
+    }   //  end lock_guard
 
-        const string s_fullpath = m_Path + s_name;
-        if (!is_dir(s_fullpath.c_str())) {
-            SmartBA sba_encoded;
-            int ret = ba_alloc_from_file(s_fullpath.c_str(), &sba_encoded);
-            if (ret != RET_OK) continue;
-
-            CrlItem* parsed_item = nullptr;
-            ret = parseCrl(sba_encoded.get(), &parsed_item);
-            if (ret == RET_OK) {
-                (void)sba_encoded.set(nullptr);
-                (void)parsed_item->setFileName(s_name);
-                CrlItem* added_item = addItem(parsed_item);
-                if (added_item != parsed_item) {
-                    (void)delete_file(s_fullpath.c_str());
-                    delete parsed_item;
-                }
-            }
-        }
+cleanup:
+    if (!is_renamed) {
+        (void)delete_file(tmpPath.c_str());
     }
+    delete parsedItem;
+    return ret;
+}
 
-    closedir(dir);
+struct CrlFileResult {
+    string      fileName;
+    int         ret;
+    CrlItem*    item;
+};  //  end struct CrlFileResult
+
+struct CrlLoadContext {
+    const string*           path;
+    vector<CrlFileResult>*  results;
+};  //  end struct CrlLoadContext
+
+static void load_crl_file (
+        void* ctx,
+        const size_t index
+)
+{
+    CrlLoadContext* load_ctx = (CrlLoadContext*)ctx;
+    CrlFileResult& result = (*load_ctx->results)[index];
+    const string s_fullpath = *load_ctx->path + result.fileName;
+
+    //  File is parsed by chunks, the encoded CRL and its revoked entries are not kept in memory
+    result.ret = CrlStreamParser::parseFile(s_fullpath, &result.item);
+    if ((result.ret == RET_OK) && !result.item->getTbsHash()) {
+        result.ret = parse_in_memory(s_fullpath, &result.item);
+    }
+}
+
+int CrlStore::loadDir (void)
+{
+    if (m_Path.empty()) return RET_OK;
+
+    vector<string> file_names;
+    if (StoreLoader::listFiles(m_Path, CRL_EXT, file_names) != RET_OK) return RET_UAPKI_CRL_STORE_LOAD_ERROR;
+
+    //  Read and parse files in parallel
+    vector<CrlFileResult> results(file_names.size());
+    for (size_t i = 0; i < file_names.size(); i++) {
+        results[i].fileName = file_names[i];
+        results[i].ret = RET_OK;
+        results[i].item = nullptr;
+    }
+    CrlLoadContext load_ctx;
+    load_ctx.path = &m_Path;
+    load_ctx.results = &results;
+    StoreLoader::parallelFor(results.size(), load_crl_file, &load_ctx);
+
+    //  Merge in the order of file names
+    for (auto& it : results) {
+        if ((it.ret != RET_OK) || !it.item) continue;
+
+        CrlItem* parsed_item = it.item;
+        (void)parsed_item->setFileName(it.fileName);
+        if (parsed_item->isFileBacked()) {
+            parsed_item->setDirName(m_Path);
+        }
+        CrlItem* added_item = addItem(parsed_item);
+        if (added_item != parsed_item) {
+            const string s_fullpath = m_Path + it.fileName;
+            (void)delete_file(s_fullpath.c_str());
+            delete parsed_item;
+        }
+    }
 
     for (auto& it : m_Items) {
         const string s_genname = it->generateFileName();
@@ -471,6 +723,7 @@ int CrlStore::removeObsolete (void)
     for (auto& it : deleting_items) {
         const string s_fullpath = m_Path + it->getFileName();
         (void)delete_file(s_fullpath.c_str());
+        removeViews(it);
         delete it;
     }
 
@@ -488,8 +741,28 @@ int CrlStore::removeObsolete (void)
     return RET_OK;
 }
 
+void CrlStore::removeViews (
+        const CrlItem* crlItem
+)
+{
+    vector<RevocationView*> views;
+    for (auto& it : m_Views) {
+        if (it->getFullCrl() == crlItem) {
+            delete it;
+        }
+        else {
+            views.push_back(it);
+        }
+    }
+    m_Views.swap(views);
+}
+
 void CrlStore::reset (void)
 {
+    for (auto& it : m_Views) {
+        delete it;
+    }
+    m_Views.clear();
     for (auto& it : m_Items) {
         delete it;
     }
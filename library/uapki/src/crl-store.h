@@ -28,8 +28,10 @@
 #ifndef UAPKI_CRL_STORE_H
 #define UAPKI_CRL_STORE_H
 
+#include <atomic>
 #include "cer-item.h"
 #include "crl-item.h"
+#include "crl-revocation-view.h"
 
 
 namespace UapkiNS {
@@ -44,6 +46,9 @@ class CrlStore {
     bool        m_UseDeltaCrl;
     std::vector<CrlItem*>
                 m_Items;
+    //  Merged views of full and delta CRLs, one per full CRL
+    std::vector<RevocationView*>
+                m_Views;
 
 public:
     CrlStore (void);
@@ -62,6 +67,14 @@ public:
         bool& isUnique,
         CrlItem** crlItem
     );
+    //  Downloads CRL directly into the directory of store (lock_guard is not held while downloading),
+    //  abortFlag (optional) aborts the transfer on the next received chunk
+    int downloadCrl (
+        const std::string& uri,
+        bool& isUnique,
+        CrlItem** crlItem,
+        const std::atomic<bool>* abortFlag = nullptr
+    );
     int getCount (
         size_t& count
     );
@@ -84,6 +97,14 @@ public:
         const ByteArray* baCrlId,
         const bool permanent
     );
+    //  Looks up the certificate in the merged view of full CRL and delta CRL (optional),
+    //  delta CRL is applied to the view once
+    int revokedCerts (
+        const CrlItem* fullCrl,
+        const CrlItem* deltaCrl,
+        const Cert::CerItem* cerSubject,
+        std::vector<const RevokedCertItem*>& revokedItems
+    );
 
 public:
     std::mutex& getMutexFirstDownloading (void) {
@@ -97,8 +118,19 @@ private:
     CrlItem* addItem (
         CrlItem* crlStoreItem
     );
+    //  Adds file-backed CRL and renames its temporary file into the store,
+    //  takes ownership of parsedItem and removes the file on error
+    int addTempFile (
+        const std::string& tmpPath,
+        CrlItem* parsedItem,
+        bool& isUnique,
+        CrlItem** crlItem
+    );
     int loadDir (void);
     int removeObsolete (void);
+    void removeViews (
+        const CrlItem* crlItem
+    );
     void reset (void);
 
 };  //  end class CrlStore
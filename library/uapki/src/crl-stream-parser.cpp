@@ -0,0 +1,497 @@
+/*
+ * Copyright (c) 2021, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define FILE_MARKER "uapki/crl-stream-parser.cpp"
+
+#include <string.h>
+#include "crl-stream-parser.h"
+#include "ba-utils.h"
+#include "macros-internal.h"
+#include "oid-utils.h"
+#include "uapki-errors.h"
+#include "uapki-ns-util.h"
+
+
+#define DEBUG_OUTCON(expression)
+#ifndef DEBUG_OUTCON
+#define DEBUG_OUTCON(expression) expression
+#endif
+
+
+using namespace std;
+
+
+namespace UapkiNS {
+
+namespace Crl {
+
+
+static const size_t CHUNK_SIZE = 64 * 1024;
+static const size_t MAX_COUNT_REVOKED_CERTS = 0xFFFFFFFF;
+
+
+struct TlvHeader {
+    uint8_t     tag;
+    size_t      hlen;
+    uint64_t    vlen;
+};  //  end struct TlvHeader
+
+//  Returns RET_OK with hlen = 0 if the header is incomplete
+static int read_header (
+        const uint8_t* buf,
+        const size_t len,
+        TlvHeader& header
+)
+{
+    header.hlen = 0;
+    if (len < 2) return RET_OK;
+
+    //  Only DER with low-tag-number form is expected in CRL
+    header.tag = buf[0];
+    if ((header.tag & 0x1F) == 0x1F) return RET_UAPKI_INVALID_STRUCT;
+
+    if (buf[1] < 0x80) {
+        header.vlen = buf[1];
+        header.hlen = 2;
+        return RET_OK;
+    }
+
+    const size_t cnt_lenbytes = buf[1] & 0x7F;
+    if ((cnt_lenbytes == 0) || (cnt_lenbytes > 8)) return RET_UAPKI_INVALID_STRUCT;
+    if (len < 2 + cnt_lenbytes) return RET_OK;
+
+    header.vlen = 0;
+    for (size_t i = 0; i < cnt_lenbytes; i++) {
+        header.vlen = (header.vlen << 8) | buf[2 + i];
+    }
+    if (header.vlen > (uint64_t)0x7FFFFFFFFFFFFFFFULL) return RET_UAPKI_INVALID_STRUCT;
+
+    header.hlen = 2 + cnt_lenbytes;
+    return RET_OK;
+}   //  read_header
+
+static void append_header (
+        vector<uint8_t>& out,
+        const uint8_t tag,
+        const size_t len
+)
+{
+    out.push_back(tag);
+    if (len < 0x80) {
+        out.push_back((uint8_t)len);
+        return;
+    }
+
+    uint8_t buf[sizeof(size_t)];
+    size_t cnt_lenbytes = 0;
+    for (size_t value = len; value > 0; value >>= 8) {
+        buf[cnt_lenbytes++] = (uint8_t)value;
+    }
+    out.push_back((uint8_t)(0x80 | cnt_lenbytes));
+    while (cnt_lenbytes > 0) {
+        out.push_back(buf[--cnt_lenbytes]);
+    }
+}   //  append_header
+
+
+CrlStreamParser::CrlStreamParser (void)
+    : m_State(State::CRL_HEADER)
+    , m_Error(RET_OK)
+    , m_File(nullptr)
+    , m_Size(0)
+    , m_BufferPos(0)
+    , m_Position(0)
+    , m_CrlEnd(0)
+    , m_TbsEnd(0)
+    , m_RevokedEnd(0)
+    , m_AfterRevoked(false)
+    , m_CountTimes(0)
+    , m_HashAlgoKnown(false)
+    , m_HashCtx(nullptr)
+    , m_FileHashCtx(nullptr)
+{
+}
+
+CrlStreamParser::~CrlStreamParser (void)
+{
+    close();
+    hash_free(m_HashCtx);
+    hash_free(m_FileHashCtx);
+}
+
+int CrlStreamParser::open (
+        const string& fileName
+)
+{
+    close();
+    m_File = fopen_utf8(fileName.c_str(), 1);
+    return (m_File) ? RET_OK : RET_UAPKI_FILE_OPEN_ERROR;
+}
+
+int CrlStreamParser::write (
+        const uint8_t* buf,
+        const size_t len
+)
+{
+    if (m_State == State::FAILED) return m_Error;
+    if (len == 0) return RET_OK;
+
+    int ret = RET_OK;
+    SmartBA sba_data;
+    if (m_State == State::DONE) {
+        SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+    }
+    if (m_File && (fwrite(buf, 1, len, m_File) != len)) {
+        SET_ERROR(RET_UAPKI_FILE_WRITE_ERROR);
+    }
+    m_Size += len;
+
+    if (!m_FileHashCtx) {
+        CHECK_NOT_NULL(m_FileHashCtx = hash_alloc(HASH_ALG_SHA256));
+    }
+    if (!sba_data.set(ba_alloc_view(buf, len))) {
+        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+    }
+    DO(hash_update(m_FileHashCtx, sba_data.get()));
+
+    //  Buffer keeps the incomplete element only
+    if (m_BufferPos > 0) {
+        m_Buffer.erase(m_Buffer.begin(), m_Buffer.begin() + m_BufferPos);
+        m_BufferPos = 0;
+    }
+    m_Buffer.insert(m_Buffer.end(), buf, buf + len);
+
+    DO(parse());
+    //  Trailing data in the same chunk
+    if ((m_State == State::DONE) && (m_BufferPos < m_Buffer.size())) {
+        SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+    }
+
+cleanup:
+    if (ret != RET_OK) {
+        m_State = State::FAILED;
+        m_Error = ret;
+        m_Buffer.clear();
+        m_BufferPos = 0;
+    }
+    return ret;
+}
+
+int CrlStreamParser::finish (
+        CrlItem** crlItem
+)
+{
+    if (!crlItem) return RET_UAPKI_INVALID_PARAMETER;
+
+    int ret = RET_OK;
+    SmartBA sba_filehash, sba_summary, sba_tbshash;
+    CrlItem* crl_item = nullptr;
+    vector<uint8_t> tbs, crl;
+
+    if (m_File) {
+        const bool is_closed = (fclose(m_File) == 0);
+        m_File = nullptr;
+        if (!is_closed) {
+            SET_ERROR(RET_UAPKI_FILE_WRITE_ERROR);
+        }
+    }
+    if (m_State == State::FAILED) {
+        SET_ERROR(m_Error);
+    }
+    if (m_State != State::DONE) {
+        SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+    }
+
+    DO(flushHash(true));
+    if (m_HashCtx) {
+        DO(hash_final(m_HashCtx, &sba_tbshash));
+    }
+    DO(hash_final(m_FileHashCtx, &sba_filehash));
+
+    //  Summary: the same CRL with empty revokedCertificates
+    append_header(tbs, 0x30, m_TbsHead.size() + 2 + m_TbsTail.size());
+    tbs.insert(tbs.end(), m_TbsHead.begin(), m_TbsHead.end());
+    tbs.push_back(0x30);
+    tbs.push_back(0x00);
+    tbs.insert(tbs.end(), m_TbsTail.begin(), m_TbsTail.end());
+    append_header(crl, 0x30, tbs.size() + m_Signature.size());
+    crl.insert(crl.end(), tbs.begin(), tbs.end());
+    crl.insert(crl.end(), m_Signature.begin(), m_Signature.end());
+    if (!sba_summary.set(ba_alloc_from_uint8(crl.data(), crl.size()))) {
+        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+    }
+
+    DO(parseCrl(sba_summary.get(), &crl_item));
+    sba_summary.set(nullptr);
+
+    crl_item->m_Summary = crl_item->m_Encoded;
+    crl_item->m_Encoded = nullptr;
+    crl_item->m_TbsHash = sba_tbshash.pop();
+    crl_item->m_FileSize = m_Size;
+    crl_item->m_FileHash = sba_filehash.pop();
+    m_RevocationTable.complete();
+    crl_item->m_RevocationTable = move(m_RevocationTable);
+
+    *crlItem = crl_item;
+
+cleanup:
+    return ret;
+}
+
+size_t CrlStreamParser::writeData (
+        const uint8_t* buf,
+        const size_t len,
+        void* userData
+)
+{
+    CrlStreamParser* parser = (CrlStreamParser*)userData;
+    return (parser->write(buf, len) == RET_OK) ? len : 0;
+}
+
+int CrlStreamParser::parseFile (
+        const string& fileName,
+        CrlItem** crlItem
+)
+{
+    int ret = RET_OK;
+    CrlStreamParser parser;
+    FILE* f = nullptr;
+    vector<uint8_t> chunk(CHUNK_SIZE);
+    size_t len;
+
+    f = fopen_utf8(fileName.c_str(), 0);
+    if (!f) {
+        SET_ERROR(RET_UAPKI_FILE_OPEN_ERROR);
+    }
+
+    while ((len = fread(chunk.data(), 1, chunk.size(), f)) > 0) {
+        DO(parser.write(chunk.data(), len));
+    }
+    if (ferror(f)) {
+        SET_ERROR(RET_UAPKI_FILE_READ_ERROR);
+    }
+
+    DO(parser.finish(crlItem));
+
+cleanup:
+    if (f) {
+        fclose(f);
+    }
+    return ret;
+}
+
+void CrlStreamParser::close (void)
+{
+    if (m_File) {
+        fclose(m_File);
+        m_File = nullptr;
+    }
+}
+
+void CrlStreamParser::consume (
+        const size_t len,
+        const bool isTbs
+)
+{
+    //  TBS is hashed by chunks, the bytes before AlgorithmIdentifier of TBS are pending
+    if (isTbs && (!m_HashAlgoKnown || m_HashCtx)) {
+        const uint8_t* buf = m_Buffer.data() + m_BufferPos;
+        m_HashPending.insert(m_HashPending.end(), buf, buf + len);
+    }
+    m_BufferPos += len;
+    m_Position += len;
+}
+
+int CrlStreamParser::flushHash (
+        const bool force
+)
+{
+    if (!m_HashAlgoKnown || m_HashPending.empty()) return RET_OK;
+    if (!force && (m_HashPending.size() < CHUNK_SIZE)) return RET_OK;
+
+    int ret = RET_OK;
+    if (m_HashCtx) {
+        SmartBA sba_data;
+        if (!sba_data.set(ba_alloc_view(m_HashPending.data(), m_HashPending.size()))) return RET_UAPKI_GENERAL_ERROR;
+        ret = hash_update(m_HashCtx, sba_data.get());
+    }
+    m_HashPending.clear();
+    return ret;
+}
+
+int CrlStreamParser::parse (void)
+{
+    int ret = RET_OK;
+    TlvHeader header;
+
+    while (m_State != State::DONE) {
+        const uint8_t* buf = m_Buffer.data() + m_BufferPos;
+        const size_t len = m_Buffer.size() - m_BufferPos;
+        uint64_t elem_end = 0;
+        size_t elem_len = 0;
+
+        if ((m_State == State::TBS_FIELD) && (m_Position == m_TbsEnd)) {
+            DO(flushHash(true));
+            m_State = State::SIGNATURE;
+            continue;
+        }
+        if ((m_State == State::REVOKED_ENTRY) && (m_Position == m_RevokedEnd)) {
+            m_State = State::TBS_FIELD;
+            continue;
+        }
+        if ((m_State == State::SIGNATURE) && (m_Position == m_CrlEnd)) {
+            m_State = State::DONE;
+            break;
+        }
+
+        DO(read_header(buf, len, header));
+        if (header.hlen == 0) break;
+
+        elem_end = m_Position + header.hlen + header.vlen;
+        switch (m_State) {
+        case State::CRL_HEADER:
+            if (header.tag != 0x30) {
+                SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+            }
+            m_CrlEnd = elem_end;
+            consume(header.hlen, false);
+            m_State = State::TBS_HEADER;
+            continue;
+        case State::TBS_HEADER:
+            if ((header.tag != 0x30) || (elem_end > m_CrlEnd)) {
+                SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+            }
+            m_TbsEnd = elem_end;
+            consume(header.hlen, true);
+            m_State = State::TBS_FIELD;
+            continue;
+        case State::TBS_FIELD:
+            if (elem_end > m_TbsEnd) {
+                SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+            }
+            //  revokedCertificates follows thisUpdate/nextUpdate, only its header is consumed here
+            if ((header.tag == 0x30) && !m_AfterRevoked && (m_CountTimes > 0)) {
+                m_RevokedEnd = elem_end;
+                m_AfterRevoked = true;
+                consume(header.hlen, true);
+                m_State = State::REVOKED_ENTRY;
+                continue;
+            }
+            break;
+        case State::REVOKED_ENTRY:
+            if ((header.tag != 0x30) || (elem_end > m_RevokedEnd) || (header.vlen < 4)) {
+                SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+            }
+            break;
+        case State::SIGNATURE:
+            if (elem_end > m_CrlEnd) {
+                SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+            }
+            break;
+        default:
+            SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+        }
+
+        //  Other elements are processed when they are complete
+        if (header.hlen + header.vlen > MAX_ELEMENT_LEN) {
+            SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+        }
+        elem_len = header.hlen + (size_t)header.vlen;
+        if (len < elem_len) break;
+
+        if (m_State == State::REVOKED_ENTRY) {
+            if (m_RevocationTable.count() >= MAX_COUNT_REVOKED_CERTS) {
+                SET_ERROR(RET_UAPKI_INVALID_STRUCT);
+            }
+            DO(m_RevocationTable.addEntry(buf, elem_len));
+            consume(elem_len, true);
+            DO(flushHash(false));
+        }
+        else if (m_State == State::TBS_FIELD) {
+            switch (header.tag) {
+            case 0x17:
+            case 0x18:
+                m_CountTimes++;
+                break;
+            case 0x30:
+                if (!m_HashAlgoKnown) {
+                    DO(setHashAlgo(buf, elem_len));
+                }
+                break;
+            case 0xA0:
+                //  CRL without revokedCertificates
+                m_AfterRevoked = true;
+                break;
+            default:
+                break;
+            }
+            vector<uint8_t>& fields = (m_AfterRevoked) ? m_TbsTail : m_TbsHead;
+            fields.insert(fields.end(), buf, buf + elem_len);
+            consume(elem_len, true);
+        }
+        else {
+            m_Signature.insert(m_Signature.end(), buf, buf + elem_len);
+            consume(elem_len, false);
+        }
+    }
+
+cleanup:
+    return ret;
+}
+
+int CrlStreamParser::setHashAlgo (
+        const uint8_t* bufAlgoId,
+        const size_t lenAlgoId
+)
+{
+    int ret = RET_OK;
+    AlgorithmIdentifier_t* algo_id = nullptr;
+    string s_signalgo;
+    HashAlg hash_algo = HASH_ALG_UNDEFINED;
+
+    CHECK_NOT_NULL(algo_id = (AlgorithmIdentifier_t*)asn_decode_with_alloc(get_AlgorithmIdentifier_desc(), bufAlgoId, lenAlgoId));
+    DO(Util::oidFromAsn1(&algo_id->algorithm, s_signalgo));
+
+    //  Unsupported algorithm is not an error of parsing, CrlItem::verify() will report it
+    m_HashAlgoKnown = true;
+    hash_algo = hash_from_oid(s_signalgo.c_str());
+    if (hash_algo != HASH_ALG_UNDEFINED) {
+        m_HashCtx = hash_alloc(hash_algo);
+    }
+    if (!m_HashCtx) {
+        m_HashPending.clear();
+    }
+
+cleanup:
+    asn_free(get_AlgorithmIdentifier_desc(), algo_id);
+    return ret;
+}
+
+
+}   //  end namespace Crl
+
+}   //  end namespace UapkiNS
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2021, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UAPKI_CRL_STREAM_PARSER_H
+#define UAPKI_CRL_STREAM_PARSER_H
+
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "crl-item.h"
+#include "hash.h"
+
+
+namespace UapkiNS {
+
+namespace Crl {
+
+
+//  Incremental parsing of CRL that arrives by chunks (from network or file) with bounded memory:
+//  the revoked entries are added to the revocation table as bytes arrive and are not kept, the copy of stream
+//  can be written to the file. Result is file-backed CrlItem (see CrlItem::isFileBacked())
+class CrlStreamParser {
+public:
+    //  Limit for the length of one element of CRL: revoked entry, issuer, extensions, etc.
+    static const size_t MAX_ELEMENT_LEN = 1024 * 1024;
+
+private:
+    enum class State : uint32_t {
+        CRL_HEADER      = 0,
+        TBS_HEADER      = 1,
+        TBS_FIELD       = 2,
+        REVOKED_ENTRY   = 3,
+        SIGNATURE       = 4,
+        DONE            = 5,
+        FAILED          = 6
+    };  //  end enum State
+
+    State       m_State;
+    int         m_Error;
+    FILE*       m_File;
+    uint64_t    m_Size;
+    std::vector<uint8_t>
+                m_Buffer;
+    size_t      m_BufferPos;
+    uint64_t    m_Position;
+    uint64_t    m_CrlEnd;
+    uint64_t    m_TbsEnd;
+    uint64_t    m_RevokedEnd;
+    bool        m_AfterRevoked;
+    size_t      m_CountTimes;
+    std::vector<uint8_t>
+                m_TbsHead;
+    std::vector<uint8_t>
+                m_TbsTail;
+    std::vector<uint8_t>
+                m_Signature;
+    bool        m_HashAlgoKnown;
+    HashCtx*    m_HashCtx;
+    //  SHA-256 of the whole stream, the file-backed CrlItem checks its file by it
+    HashCtx*    m_FileHashCtx;
+    std::vector<uint8_t>
+                m_HashPending;
+    RevocationTable
+                m_RevocationTable;
+
+public:
+    CrlStreamParser (void);
+    ~CrlStreamParser (void);
+
+    uint64_t getSize (void) const {
+        return m_Size;
+    }
+    bool isFailed (void) const {
+        return (m_State == State::FAILED);
+    }
+
+public:
+    //  Opens the file for the copy of stream (optional)
+    int open (
+        const std::string& fileName
+    );
+    //  Data after the end of CRL is an error, like for parseCrl()
+    int write (
+        const uint8_t* buf,
+        const size_t len
+    );
+    //  Closes the file, returns CrlItem without the name of file
+    int finish (
+        CrlItem** crlItem
+    );
+
+public:
+    //  Callback for HttpHelper::get(), userData is CrlStreamParser
+    static size_t writeData (
+        const uint8_t* buf,
+        const size_t len,
+        void* userData
+    );
+    static int parseFile (
+        const std::string& fileName,
+        CrlItem** crlItem
+    );
+
+private:
+    void close (void);
+    void consume (
+        const size_t len,
+        const bool isTbs
+    );
+    int flushHash (
+        const bool force
+    );
+    int parse (void);
+    int setHashAlgo (
+        const uint8_t* bufAlgoId,
+        const size_t lenAlgoId
+    );
+
+};  //  end class CrlStreamParser
+
+
+}   //  end namespace Crl
+
+}   //  end namespace UapkiNS
+
+#endif
@@ -40,6 +40,8 @@
 #include <io.h> /* _findfirst and _findnext set errno iff they return -1 */
 #include <stdlib.h>
 #include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -189,6 +191,23 @@ bool is_dir(const char *path)
     return is_dir;
 }
 
+bool get_file_info(const char *path, uint64_t *size, uint64_t *mtime)
+{
+    struct _stat64 path_stat;
+    int r = -1;
+    wchar_t *szPath = utf8_to_wchar(path);
+
+    if (szPath) {
+        r = _wstat64(szPath, &path_stat);
+        free(szPath);
+    }
+    if ((r != 0) || ((path_stat.st_mode & _S_IFMT) != _S_IFREG)) return false;
+
+    *size = (uint64_t)path_stat.st_size;
+    *mtime = (uint64_t)path_stat.st_mtime;
+    return true;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -203,4 +222,14 @@ bool is_dir(const char *path)
     return S_ISDIR(path_stat.st_mode) != 0;
 }
 
+bool get_file_info(const char *path, uint64_t *size, uint64_t *mtime)
+{
+    struct stat path_stat;
+    if ((stat(path, &path_stat) != 0) || !S_ISREG(path_stat.st_mode)) return false;
+
+    *size = (uint64_t)path_stat.st_size;
+    *mtime = (uint64_t)path_stat.st_mtime;
+    return true;
+}
+
 #endif
@@ -29,6 +29,7 @@
 #define _DIRENT_COMMON_H_
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -48,6 +49,7 @@ struct dirent *readdir(DIR *);
 void          rewinddir(DIR *);
 
 bool          is_dir(const char* path);
+bool          get_file_info(const char* path, uint64_t* size, uint64_t* mtime);
 
 #else
 #  ifdef __unix__
@@ -55,6 +57,7 @@ bool          is_dir(const char* path);
 #  endif /* __unix__ */
 #  include <dirent.h>
     bool      is_dir(const char* path);
+    bool      get_file_info(const char* path, uint64_t* size, uint64_t* mtime);
 #endif /* _WIN32 */
 
 #ifdef __cplusplus
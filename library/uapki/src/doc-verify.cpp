@@ -30,7 +30,9 @@
 #include "doc-verify.h"
 #include "api-json-internal.h"
 #include "attribute-helper.h"
+#include "ba-utils.h"
 #include "cert-validator.h"
+#include "cms-stream-parser.h"
 #include "global-objects.h"
 #include "hash.h"
 #include "oid-utils.h"
@@ -50,6 +52,9 @@
 #endif
 
 
+#define FILE_BLOCK_SIZE (1024 * 1024)
+
+
 using namespace std;
 
 
@@ -681,20 +686,23 @@ int VerifiedSignerInfo::setRevocationValuesForChain (
         Ocsp::OcspHelper ocsp_helper;
         ret = ocsp_helper.parseBasicOcspResponse(it_ocspval);
         if (ret == RET_OK) {
-            SmartBA sba_sn;
             DO(ocsp_helper.scanSingleResponses());
-            DO(ocsp_helper.getSerialNumberFromCertId(0, &sba_sn));  //  Work with one OCSP request that has one certificate
-
-            for (const auto& it_cci : m_CertChainItems) {
-                if (ba_cmp(sba_sn.get(), it_cci->getSubject()->getSerialNumber()) == 0) {
-                    ResultValidationByOcsp& result_valbyocsp = it_cci->getResultValidationByOcsp();
-                    result_valbyocsp.dataSource = DataSource::SIGNATURE;
-                    result_valbyocsp.responseStatus = Ocsp::ResponseStatus::SUCCESSFUL;
-                    (void)verifyOcspResponse(ocsp_helper, result_valbyocsp);
-                    result_valbyocsp.msProducedAt = ocsp_helper.getProducedAt();
-                    result_valbyocsp.singleResponseInfo = ocsp_helper.getSingleResponseInfo(0); //  Work with one OCSP request that has one certificate
-                    it_cci->setValidationType(Cert::ValidationType::OCSP);
-                    break;
+            //  Response can contain the statuses of several certificates (multi-certificate request)
+            for (size_t idx = 0; idx < ocsp_helper.countSingleResponses(); idx++) {
+                SmartBA sba_sn;
+                DO(ocsp_helper.getSerialNumberFromCertId(idx, &sba_sn));
+
+                for (const auto& it_cci : m_CertChainItems) {
+                    if (ba_cmp(sba_sn.get(), it_cci->getSubject()->getSerialNumber()) == 0) {
+                        ResultValidationByOcsp& result_valbyocsp = it_cci->getResultValidationByOcsp();
+                        result_valbyocsp.dataSource = DataSource::SIGNATURE;
+                        result_valbyocsp.responseStatus = Ocsp::ResponseStatus::SUCCESSFUL;
+                        (void)verifyOcspResponse(ocsp_helper, result_valbyocsp);
+                        result_valbyocsp.msProducedAt = ocsp_helper.getProducedAt();
+                        result_valbyocsp.singleResponseInfo = ocsp_helper.getSingleResponseInfo(idx);
+                        it_cci->setValidationType(Cert::ValidationType::OCSP);
+                        break;
+                    }
                 }
             }
         }
@@ -839,7 +847,9 @@ int VerifiedSignerInfo::verifyArchiveTimeStamp (
             DO(m_ArchiveTsHelper.addCertificate(it->getEncoded()));
         }
         for (const auto& it : crls) {
-            DO(m_ArchiveTsHelper.addCrl(it->getEncoded()));
+            const ByteArray* ba_encoded = nullptr;
+            DO(it->getEncoded(&ba_encoded));
+            DO(m_ArchiveTsHelper.addCrl(ba_encoded));
         }
         for (const auto& it : m_SignerInfo.getUnsignedAttrs()) {
             if (it.type != string(OID_ETSI_ARCHIVE_TIMESTAMP_V3)) {
@@ -1256,6 +1266,145 @@ int VerifySignedDoc::getContent (
     return ret;
 }
 
+//  Collects the parts of the streamed SignedData: the content is hashed by all digest algorithms
+//  of SignedData, other elements are added to the detached copy of SignedData
+struct StreamedSignedData {
+    const Pkcs7::CmsStreamParser*
+                parser;
+    Pkcs7::SignedDataBuilder
+                sdataBuilder;
+    std::vector<std::pair<HashAlg, HashCtx*>>
+                hashCtxs;
+    bool        hashStarted;
+
+    StreamedSignedData (void)
+        : parser(nullptr), hashStarted(false) {
+    }
+    ~StreamedSignedData (void) {
+        for (auto& it : hashCtxs) {
+            hash_free(it.second);
+        }
+    }
+
+    int startHash (void) {
+        if (hashStarted) return RET_OK;
+        hashStarted = true;
+        for (const auto& it : parser->getDigestAlgorithms()) {
+            const HashAlg hash_alg = hash_from_oid(it.c_str());
+            if (hash_alg == HASH_ALG_UNDEFINED) continue;
+            HashCtx* hash_ctx = hash_alloc(hash_alg);
+            if (!hash_ctx) return RET_UAPKI_GENERAL_ERROR;
+            hashCtxs.push_back(make_pair(hash_alg, hash_ctx));
+        }
+        return RET_OK;
+    }
+
+    static int onContent (void* context, const uint8_t* data, const size_t size) {
+        StreamedSignedData* streamed = (StreamedSignedData*)context;
+        int ret = streamed->startHash();
+        if (ret != RET_OK) return ret;
+
+        SmartBA sba_chunk;
+        if (!sba_chunk.set(ba_alloc_view(data, size))) return RET_UAPKI_GENERAL_ERROR;
+        for (auto& it : streamed->hashCtxs) {
+            ret = hash_update(it.second, sba_chunk.get());
+            if (ret != RET_OK) break;
+        }
+        return ret;
+    }
+    static int onCert (void* context, const ByteArray* baEncoded) {
+        return ((StreamedSignedData*)context)->sdataBuilder.addCertificate(baEncoded);
+    }
+    static int onCrl (void* context, const ByteArray* baEncoded) {
+        return ((StreamedSignedData*)context)->sdataBuilder.addCrl(baEncoded);
+    }
+    static int onSignerInfo (void* context, const Pkcs7::SignedDataParser::SignerInfo& signerInfo) {
+        StreamedSignedData* streamed = (StreamedSignedData*)context;
+        //  The content is hashed only by digestAlgorithms of SignedData
+        bool is_present = false;
+        for (const auto& it : streamed->parser->getDigestAlgorithms()) {
+            is_present = (signerInfo.getDigestAlgorithm().algorithm == it);
+            if (is_present) break;
+        }
+        if (!is_present) return RET_UAPKI_UNSUPPORTED_ALG;
+
+        SmartBA sba_encoded;
+        const int ret = asn_encode_ba(get_SignerInfo_desc(), signerInfo.getAsn1Data(), &sba_encoded);
+        if (ret != RET_OK) return ret;
+        return streamed->sdataBuilder.addSignerInfo(sba_encoded.get());
+    }
+};  //  end struct StreamedSignedData
+
+int VerifySignedDoc::parseFile (
+        const char* filename,
+        ContentHasher& contentHasher
+)
+{
+    int ret = RET_OK;
+    StreamedSignedData streamed;
+    Pkcs7::CmsStreamParser::Callbacks callbacks;
+    SmartBA sba_block;
+    size_t read_len = 0;
+    FILE* f = nullptr;
+
+    callbacks.context = &streamed;
+    callbacks.onContent = StreamedSignedData::onContent;
+    callbacks.onCert = StreamedSignedData::onCert;
+    callbacks.onCrl = StreamedSignedData::onCrl;
+    callbacks.onSignerInfo = StreamedSignedData::onSignerInfo;
+    Pkcs7::CmsStreamParser cms_parser(callbacks);
+    streamed.parser = &cms_parser;
+
+    if (!filename) return RET_UAPKI_INVALID_PARAMETER;
+
+    f = fopen_utf8(filename, 0);
+    if (!f) {
+        SET_ERROR(RET_UAPKI_FILE_OPEN_ERROR);
+    }
+
+    DO(streamed.sdataBuilder.init());
+    if (!sba_block.set(ba_alloc_by_len(FILE_BLOCK_SIZE))) {
+        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+    }
+
+    do {
+        read_len = fread(sba_block.buf(), 1, FILE_BLOCK_SIZE, f);
+        DO(cms_parser.update(sba_block.buf(), read_len));
+    } while (read_len == FILE_BLOCK_SIZE);
+
+    if (ferror(f)) {
+        SET_ERROR(RET_UAPKI_FILE_READ_ERROR);
+    }
+    DO(cms_parser.final());
+
+    if (!oid_is_equal(cms_parser.getContentType().c_str(), OID_PKCS7_SIGNED_DATA)) {
+        SET_ERROR(RET_UAPKI_INVALID_CONTENT_INFO);
+    }
+
+    //  Detached copy of SignedData is verified as usual
+    DO(streamed.sdataBuilder.setVersion(cms_parser.getVersion()));
+    DO(streamed.sdataBuilder.setEncapContentInfo(cms_parser.getEncapContentType(), nullptr));
+    DO(streamed.sdataBuilder.encode());
+    DO(parse(streamed.sdataBuilder.getEncoded()));
+
+    refContentHasher = &contentHasher;
+    if (cms_parser.isContentPresent()) {
+        DO(streamed.startHash());
+        contentHasher.reset();
+        for (auto& it : streamed.hashCtxs) {
+            SmartBA sba_hash;
+            DO(hash_final(it.second, &sba_hash));
+            DO(contentHasher.addDigest(it.first, sba_hash.get()));
+        }
+    }
+
+cleanup:
+    if (f) {
+        fclose(f);
+    }
+    return ret;
+}
+
 int VerifySignedDoc::addCertsToStore (void)
 {
     int ret = RET_OK;
@@ -386,6 +386,12 @@ struct VerifySignedDoc {
     int getContent (
         ContentHasher& contentHasher
     );
+    //  Parses the signature from the file by parts (the content is hashed by chunks and is not kept),
+    //  replaces parse() and getContent()
+    int parseFile (
+        const char* filename,
+        ContentHasher& contentHasher
+    );
     int addCertsToStore (void);
     void detectCertSources (void);
     int getLastError (void);
@@ -26,6 +26,7 @@
  */
 
 #include "global-objects.h"
+#include "uapki-errors.h"
 
 
 namespace UapkiNS {
@@ -34,6 +35,9 @@ namespace UapkiNS {
 static LibraryConfig* lib_config = nullptr;
 static Cert::CerStore* lib_cerstore = nullptr;
 static Crl::CrlStore* lib_crlstore = nullptr;
+static Crl::CrlRefresher* lib_crlrefresher = nullptr;
+static Ocsp::OcspCache* lib_ocspcache = nullptr;
+static Ocsp::OcspRefresher* lib_ocsprefresher = nullptr;
 
 
 LibraryConfig* get_config (void)
@@ -60,6 +64,72 @@ Crl::CrlStore* get_crlstore (void)
     return lib_crlstore;
 }
 
+Ocsp::OcspCache* get_ocspcache (void)
+{
+    if (!lib_ocspcache) {
+        lib_ocspcache = new Ocsp::OcspCache();
+    }
+    return lib_ocspcache;
+}
+
+Crl::CrlRefresher* get_crlrefresher (void)
+{
+    return lib_crlrefresher;
+}
+
+int start_crlrefresher (const Crl::CrlRefresher::Params& params)
+{
+    if (lib_crlrefresher) return RET_OK;
+
+    Crl::CrlRefresher* crl_refresher = new Crl::CrlRefresher(*get_crlstore(), params);
+    if (!crl_refresher) return RET_UAPKI_GENERAL_ERROR;
+
+    //  CRLs of the cache are refreshed from the start, not only after the validation by CRL
+    crl_refresher->trackStored(*get_cerstore());
+    const int ret = crl_refresher->start();
+    if (ret != RET_OK) {
+        delete crl_refresher;
+        return ret;
+    }
+
+    lib_crlrefresher = crl_refresher;
+    return RET_OK;
+}
+
+Ocsp::OcspRefresher* get_ocsprefresher (void)
+{
+    return lib_ocsprefresher;
+}
+
+int start_ocsprefresher (void)
+{
+    if (lib_ocsprefresher) return RET_OK;
+
+    Ocsp::OcspRefresher* ocsp_refresher = new Ocsp::OcspRefresher(*get_config(), *get_cerstore(), *get_crlstore());
+    if (!ocsp_refresher) return RET_UAPKI_GENERAL_ERROR;
+
+    const int ret = ocsp_refresher->start();
+    if (ret != RET_OK) {
+        delete ocsp_refresher;
+        return ret;
+    }
+
+    lib_ocsprefresher = ocsp_refresher;
+    return RET_OK;
+}
+
+void stop_refreshers (void)
+{
+    if (lib_ocsprefresher) {
+        delete lib_ocsprefresher;
+        lib_ocsprefresher = nullptr;
+    }
+    if (lib_crlrefresher) {
+        delete lib_crlrefresher;
+        lib_crlrefresher = nullptr;
+    }
+}
+
 void release_config (void)
 {
     if (lib_config) {
@@ -70,6 +140,8 @@ void release_config (void)
 
 void release_stores (void)
 {
+    //  Refreshers use the stores, they must be stopped first
+    stop_refreshers();
     if (lib_cerstore) {
         delete lib_cerstore;
         lib_cerstore = nullptr;
@@ -78,6 +150,10 @@ void release_stores (void)
         delete lib_crlstore;
         lib_crlstore = nullptr;
     }
+    if (lib_ocspcache) {
+        delete lib_ocspcache;
+        lib_ocspcache = nullptr;
+    }
 }
 
 
@@ -31,7 +31,10 @@
 
 #include "cer-store.h"
 #include "crl-store.h"
+#include "crl-refresher.h"
 #include "library-config.h"
+#include "ocsp-cache.h"
+#include "ocsp-refresher.h"
 
 
 namespace UapkiNS {
@@ -39,7 +42,17 @@ namespace UapkiNS {
 extern LibraryConfig* get_config (void);
 extern Cert::CerStore* get_cerstore (void);
 extern Crl::CrlStore* get_crlstore (void);
-
+extern Ocsp::OcspCache* get_ocspcache (void);
+//  Returns nullptr if CRL-refresher is not started
+extern Crl::CrlRefresher* get_crlrefresher (void);
+extern int start_crlrefresher (const Crl::CrlRefresher::Params& params);
+//  Returns nullptr if OCSP-refresher is not started
+extern Ocsp::OcspRefresher* get_ocsprefresher (void);
+extern int start_ocsprefresher (void);
+
+//  Stops the threads of refreshers, they use the config and the stores,
+//  so it must be called before release_config() and release_stores()
+extern void stop_refreshers (void);
 extern void release_config (void);
 extern void release_stores (void);
 
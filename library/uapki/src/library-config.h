@@ -42,11 +42,39 @@ class LibraryConfig {
 public:
     struct OcspParams {
         static const size_t NONCE_LEN_DEFAULT = 20;
+        //  Cache policy, times in seconds
+        static const uint32_t MIN_TTL_DEFAULT           = 0;
+        static const uint32_t MAX_TTL_DEFAULT           = 30 * 60;
+        static const uint32_t NEGATIVE_TTL_DEFAULT      = 0;
+        static const uint32_t NEGATIVE_TTL_MAX_DEFAULT  = 10 * 60;
+        static const uint32_t STALE_TTL_DEFAULT         = 0;
 
         size_t  nonceLen;
+        //  Status is used during thisUpdate + maxTtl, but not later than nextUpdate (if useNextUpdate)
+        //  and not earlier than thisUpdate + minTtl
+        uint32_t
+                minTtl;
+        uint32_t
+                maxTtl;
+        bool    useNextUpdate;
+        //  After failure the responder is not requested during negativeTtl, doubled for each next
+        //  failure up to negativeTtlMax; 0 - disabled
+        uint32_t
+                negativeTtl;
+        uint32_t
+                negativeTtlMax;
+        //  Expired status is used during staleTtl while it is refreshed in background; 0 - disabled
+        uint32_t
+                staleTtl;
 
         OcspParams (void)
             : nonceLen (NONCE_LEN_DEFAULT)
+            , minTtl(MIN_TTL_DEFAULT)
+            , maxTtl(MAX_TTL_DEFAULT)
+            , useNextUpdate(true)
+            , negativeTtl(NEGATIVE_TTL_DEFAULT)
+            , negativeTtlMax(NEGATIVE_TTL_MAX_DEFAULT)
+            , staleTtl(STALE_TTL_DEFAULT)
         {
         }
     };  //  end struct OcspParams
@@ -110,6 +138,12 @@ public:
     }
     void setOcsp (const OcspParams& ocspParams) {
         m_OcspParams.nonceLen = ocspParams.nonceLen;
+        m_OcspParams.minTtl = ocspParams.minTtl;
+        m_OcspParams.maxTtl = ocspParams.maxTtl;
+        m_OcspParams.useNextUpdate = ocspParams.useNextUpdate;
+        m_OcspParams.negativeTtl = ocspParams.negativeTtl;
+        m_OcspParams.negativeTtlMax = ocspParams.negativeTtlMax;
+        m_OcspParams.staleTtl = ocspParams.staleTtl;
     }
     void setOffline (bool offline) {
         m_Offline = offline;
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2021, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define FILE_MARKER "uapki/ocsp-cache.cpp"
+
+#include <stdio.h>
+#include <string.h>
+#include "ocsp-cache.h"
+#include "ba-utils.h"
+#include "drbg.h"
+#include "macros-internal.h"
+#include "uapki-errors.h"
+#include "uapki-ns-util.h"
+
+
+#define DEBUG_OUTCON(expression)
+#ifndef DEBUG_OUTCON
+#define DEBUG_OUTCON(expression) expression
+#endif
+
+
+using namespace std;
+
+
+namespace UapkiNS {
+
+namespace Ocsp {
+
+
+//  Layout of the entry-file (all integers are little-endian):
+//    header:  magic "UAPKIOCS", u32 version, u32 certStatus, u64 thisUpdate, u64 nextUpdate,
+//             u32 length of CertID, u32 length of OCSP-response;
+//    body:    encoded CertID, encoded OCSP-response, u64 FNV-1a checksum of header and body.
+//  The name of file is SHA-256 of encoded CertID in hex (see getFilePath())
+static const uint8_t ENTRY_MAGIC[8]     = { 'U', 'A', 'P', 'K', 'I', 'O', 'C', 'S' };
+static const uint32_t ENTRY_VERSION     = 1;
+static const size_t ENTRY_HEADER_LEN    = 40;
+static const size_t ENTRY_CHECKSUM_LEN  = 8;
+static const char* ENTRY_FILE_EXT       = ".ocsp";
+static const uint64_t FNV64_OFFSET      = 0xCBF29CE484222325ULL;
+static const uint64_t FNV64_PRIME       = 0x00000100000001B3ULL;
+
+
+//  FNV-1a 64-bit
+static uint64_t hash64 (
+        const uint8_t* buf,
+        const size_t len
+)
+{
+    uint64_t rv = FNV64_OFFSET;
+    for (size_t i = 0; i < len; i++) {
+        rv ^= buf[i];
+        rv *= FNV64_PRIME;
+    }
+    return rv;
+}
+
+
+static void put_le (
+        uint8_t* buf,
+        uint64_t value,
+        const size_t len
+)
+{
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)value;
+        value >>= 8;
+    }
+}
+
+static uint64_t get_le (
+        const uint8_t* buf,
+        const size_t len
+)
+{
+    uint64_t rv = 0;
+    for (size_t i = len; i > 0; i--) {
+        rv = (rv << 8) | buf[i - 1];
+    }
+    return rv;
+}
+
+
+OcspCache::OcspCache (void)
+{
+}
+
+OcspCache::~OcspCache (void)
+{
+}
+
+void OcspCache::setParams (
+        const string& path,
+        const LibraryConfig::OcspParams& policy
+)
+{
+    m_Path = path;
+    m_Policy = policy;
+}
+
+bool OcspCache::find (
+        const ByteArray* baCertId,
+        const uint64_t time,
+        Entry& entry,
+        const bool allowStale
+) const
+{
+    if (m_Path.empty() || !baCertId) return false;
+
+    const string s_filepath = getFilePath(baCertId);
+    SmartBA sba_data;
+    if (s_filepath.empty() || (ba_alloc_from_file(s_filepath.c_str(), &sba_data) != RET_OK)) return false;
+
+    const uint8_t* buf = sba_data.buf();
+    const size_t len = sba_data.size();
+    if (
+        (len < ENTRY_HEADER_LEN + ENTRY_CHECKSUM_LEN) ||
+        (memcmp(buf, ENTRY_MAGIC, sizeof(ENTRY_MAGIC)) != 0) ||
+        (get_le(buf + 8, 4) != ENTRY_VERSION)
+    ) return false;
+
+    const size_t len_certid = (size_t)get_le(buf + 32, 4);
+    const size_t len_response = (size_t)get_le(buf + 36, 4);
+    if (len != ENTRY_HEADER_LEN + len_certid + len_response + ENTRY_CHECKSUM_LEN) return false;
+    if (get_le(buf + len - ENTRY_CHECKSUM_LEN, 8) != hash64(buf, len - ENTRY_CHECKSUM_LEN)) return false;
+
+    //  The file was copied or renamed: it is the entry of other CertID
+    if (
+        (len_certid != ba_get_len(baCertId)) ||
+        (memcmp(buf + ENTRY_HEADER_LEN, ba_get_buf_const(baCertId), len_certid) != 0)
+    ) return false;
+
+    const uint64_t ms_thisupdate = get_le(buf + 16, 8);
+    const uint64_t ms_nextupdate = get_le(buf + 24, 8);
+    bool is_stale = false;
+    if (!isFresh(ms_thisupdate, ms_nextupdate, time, allowStale, is_stale)) return false;
+
+    if (!entry.baResponse.set(ba_alloc_from_uint8(buf + ENTRY_HEADER_LEN + len_certid, len_response))) return false;
+    entry.certStatus = (CertStatus)(int32_t)get_le(buf + 12, 4);
+    entry.msThisUpdate = ms_thisupdate;
+    entry.msNextUpdate = ms_nextupdate;
+    entry.isStale = is_stale;
+
+    DEBUG_OUTCON(printf("OcspCache::find(), hit, thisUpdate: %llu\n", (unsigned long long)ms_thisupdate));
+    return true;
+}
+
+int OcspCache::save (
+        const ByteArray* baCertId,
+        const OcspHelper::SingleResponseInfo& singleResponseInfo,
+        const ByteArray* baResponse
+) const
+{
+    int ret = RET_OK;
+    SmartBA sba_data, sba_random;
+    string s_filepath, s_tmppath;
+    uint8_t* buf = nullptr;
+    size_t len_certid, len_response, offset;
+
+    if (m_Path.empty()) return RET_OK;
+    if (!baCertId || !baResponse) return RET_UAPKI_INVALID_PARAMETER;
+
+    len_certid = ba_get_len(baCertId);
+    len_response = ba_get_len(baResponse);
+    if (!sba_data.set(ba_alloc_by_len(ENTRY_HEADER_LEN + len_certid + len_response + ENTRY_CHECKSUM_LEN))) {
+        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+    }
+
+    buf = sba_data.buf();
+    memcpy(buf, ENTRY_MAGIC, sizeof(ENTRY_MAGIC));
+    put_le(buf + 8, ENTRY_VERSION, 4);
+    put_le(buf + 12, (uint32_t)singleResponseInfo.certStatus, 4);
+    put_le(buf + 16, singleResponseInfo.msThisUpdate, 8);
+    put_le(buf + 24, singleResponseInfo.msNextUpdate, 8);
+    put_le(buf + 32, (uint64_t)len_certid, 4);
+    put_le(buf + 36, (uint64_t)len_response, 4);
+    offset = ENTRY_HEADER_LEN;
+    memcpy(buf + offset, ba_get_buf_const(baCertId), len_certid);
+    offset += len_certid;
+    memcpy(buf + offset, ba_get_buf_const(baResponse), len_response);
+    offset += len_response;
+    put_le(buf + offset, hash64(buf, offset), 8);
+
+    //  Temporary name is unique between threads and processes
+    if (!sba_random.set(ba_alloc_by_len(8))) {
+        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+    }
+    DO(drbg_random(sba_random.get()));
+    s_filepath = getFilePath(baCertId);
+    if (s_filepath.empty()) {
+        SET_ERROR(RET_UAPKI_GENERAL_ERROR);
+    }
+    s_tmppath = s_filepath + "." + Util::baToHex(sba_random.get()) + ".tmp";
+
+    DO(ba_to_file(sba_data.get(), s_tmppath.c_str()));
+    //  rename() replaces the file atomically on POSIX, on other systems the file must be deleted before
+    if (rename(s_tmppath.c_str(), s_filepath.c_str()) != 0) {
+        (void)delete_file(s_filepath.c_str());
+        if (rename(s_tmppath.c_str(), s_filepath.c_str()) != 0) {
+            (void)delete_file(s_tmppath.c_str());
+            SET_ERROR(RET_UAPKI_FILE_WRITE_ERROR);
+        }
+    }
+
+cleanup:
+    return ret;
+}
+
+uint64_t OcspCache::getValidTime (
+        const uint64_t msThisUpdate,
+        const uint64_t msNextUpdate
+) const
+{
+    uint64_t rv_time = msThisUpdate + (uint64_t)m_Policy.maxTtl * 1000;
+    if (m_Policy.useNextUpdate && (msNextUpdate > 0) && (msNextUpdate < rv_time)) {
+        rv_time = msNextUpdate;
+    }
+    //  Protects the responder that gives very short nextUpdate
+    const uint64_t min_time = msThisUpdate + (uint64_t)m_Policy.minTtl * 1000;
+    return (rv_time > min_time) ? rv_time : min_time;
+}
+
+bool OcspCache::isStaleAllowed (
+        const uint64_t validTime,
+        const uint64_t time
+) const
+{
+    return (m_Policy.staleTtl > 0) && (time < validTime + (uint64_t)m_Policy.staleTtl * 1000);
+}
+
+bool OcspCache::isFresh (
+        const uint64_t msThisUpdate,
+        const uint64_t msNextUpdate,
+        const uint64_t time,
+        const bool allowStale,
+        bool& isStale
+) const
+{
+    const uint64_t valid_time = getValidTime(msThisUpdate, msNextUpdate);
+    isStale = (time >= valid_time);
+    return !isStale || (allowStale && isStaleAllowed(valid_time, time));
+}
+
+bool OcspCache::isBackoff (
+        const string& responder,
+        const uint64_t time
+) const
+{
+    if (m_Policy.negativeTtl == 0) return false;
+
+    lock_guard<mutex> lock(m_Mutex);
+
+    const auto it = m_Backoffs.find(responder);
+    return (it != m_Backoffs.end()) && (time < it->second.retryTime);
+}
+
+void OcspCache::registerFailure (
+        const string& responder,
+        const uint64_t time
+)
+{
+    if (m_Policy.negativeTtl == 0) return;
+
+    lock_guard<mutex> lock(m_Mutex);
+
+    //  Exponential backoff: negativeTtl, 2*negativeTtl, 4*negativeTtl ... negativeTtlMax
+    Backoff& backoff = m_Backoffs[responder];
+    const uint64_t ms_max = (uint64_t)((m_Policy.negativeTtlMax > m_Policy.negativeTtl) ? m_Policy.negativeTtlMax : m_Policy.negativeTtl) * 1000;
+    uint64_t ms_delay = (uint64_t)m_Policy.negativeTtl * 1000;
+    for (uint32_t i = 0; (i < backoff.countFailures) && (ms_delay < ms_max); i++) {
+        ms_delay *= 2;
+    }
+    backoff.countFailures++;
+    backoff.retryTime = time + ((ms_delay < ms_max) ? ms_delay : ms_max);
+    DEBUG_OUTCON(printf("OcspCache::registerFailure(), responder: '%s', failures: %u\n", responder.c_str(), backoff.countFailures));
+}
+
+void OcspCache::registerSuccess (
+        const string& responder
+)
+{
+    if (m_Policy.negativeTtl == 0) return;
+
+    lock_guard<mutex> lock(m_Mutex);
+
+    (void)m_Backoffs.erase(responder);
+}
+
+string OcspCache::getFilePath (
+        const ByteArray* baCertId
+) const
+{
+    //  SHA-256 of encoded CertID: the CertIDs of other certificates never get the same name,
+    //  also the name can't be chosen by the content of certificate to replace the entry of other one
+    SmartBA sba_hash;
+    if (::hash(HASH_ALG_SHA256, baCertId, &sba_hash) != RET_OK) return string();
+
+    return m_Path + Util::baToHex(sba_hash.get()) + string(ENTRY_FILE_EXT);
+}
+
+
+}   //  end namespace Ocsp
+
+}   //  end namespace UapkiNS
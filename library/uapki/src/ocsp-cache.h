@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2021, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UAPKI_OCSP_CACHE_H
+#define UAPKI_OCSP_CACHE_H
+
+
+#include <map>
+#include <mutex>
+#include <string>
+#include "library-config.h"
+#include "ocsp-helper.h"
+
+
+namespace UapkiNS {
+
+namespace Ocsp {
+
+
+//  Directory of OCSP-responses that survives restarts and is shared by the processes of the host.
+//  One file per CertID: the name is SHA-256 of encoded CertID, the content is verified OCSP-response
+//  with thisUpdate/nextUpdate of its SingleResponse. Files are replaced by rename of temporary file,
+//  so readers see old or new content and never the partial one; no locks are needed.
+//  The header of file is not signed, it only skips the expired responses: the found response is verified
+//  as received one and its freshness is checked by isFresh() with the values of verified SingleResponse.
+//  Also keeps the cache policy and the failures of OCSP-responders (in memory, per process)
+class OcspCache {
+public:
+    struct Entry {
+        CertStatus  certStatus;
+        uint64_t    msThisUpdate;
+        uint64_t    msNextUpdate;
+        SmartBA     baResponse;
+        bool        isStale;
+
+        Entry (void)
+            : certStatus(CertStatus::UNDEFINED)
+            , msThisUpdate(0)
+            , msNextUpdate(0)
+            , isStale(false)
+        {}
+    };  //  end struct Entry
+
+private:
+    struct Backoff {
+        uint32_t    countFailures;
+        uint64_t    retryTime;
+
+        Backoff (void)
+            : countFailures(0)
+            , retryTime(0)
+        {}
+    };  //  end struct Backoff
+
+    std::string m_Path;
+    LibraryConfig::OcspParams
+                m_Policy;
+    mutable std::mutex
+                m_Mutex;
+    std::map<std::string, Backoff>
+                m_Backoffs;
+
+public:
+    OcspCache (void);
+    ~OcspCache (void);
+
+    void setParams (
+        const std::string& path,
+        const LibraryConfig::OcspParams& policy
+    );
+
+    const std::string& getPath (void) const {
+        return m_Path;
+    }
+    bool isEnabled (void) const {
+        return !m_Path.empty();
+    }
+
+public:
+    //  Returns true if the entry for CertID is present and valid at the time by the header of file,
+    //  with allowStale also the expired entry within staleTtl (entry.isStale is set)
+    bool find (
+        const ByteArray* baCertId,
+        const uint64_t time,
+        Entry& entry,
+        const bool allowStale = false
+    ) const;
+    int save (
+        const ByteArray* baCertId,
+        const OcspHelper::SingleResponseInfo& singleResponseInfo,
+        const ByteArray* baResponse
+    ) const;
+
+public:
+    //  Time until the status is used without new request: thisUpdate + maxTtl,
+    //  but not later than nextUpdate (if present and used) and not earlier than thisUpdate + minTtl
+    uint64_t getValidTime (
+        const uint64_t msThisUpdate,
+        const uint64_t msNextUpdate
+    ) const;
+    bool isStaleAllowed (
+        const uint64_t validTime,
+        const uint64_t time
+    ) const;
+    //  Returns true if the status is valid at the time by the policy,
+    //  with allowStale also the expired status within staleTtl (isStale is set)
+    bool isFresh (
+        const uint64_t msThisUpdate,
+        const uint64_t msNextUpdate,
+        const uint64_t time,
+        const bool allowStale,
+        bool& isStale
+    ) const;
+
+public:
+    //  Negative caching: the responder (joined URIs) that failed is not requested until retry time
+    bool isBackoff (
+        const std::string& responder,
+        const uint64_t time
+    ) const;
+    void registerFailure (
+        const std::string& responder,
+        const uint64_t time
+    );
+    void registerSuccess (
+        const std::string& responder
+    );
+
+private:
+    std::string getFilePath (
+        const ByteArray* baCertId
+    ) const;
+
+};  //  end class OcspCache
+
+
+}   //  end namespace Ocsp
+
+}   //  end namespace UapkiNS
+
+#endif
@@ -62,6 +62,7 @@ static OcspHelper::SingleResponseInfo singleresponseinfo_empty;
 
 OcspHelper::OcspHelper (void)
     : m_OcspRequest(nullptr)
+    , m_RespArena(nullptr)
     , m_BasicOcspResp(nullptr)
     , m_BaBasicOcspResponse(nullptr)
     , m_BaNonce(nullptr)
@@ -81,7 +82,7 @@ OcspHelper::~OcspHelper (void)
 void OcspHelper::reset (void)
 {
     asn_free(get_OCSPRequest_desc(), m_OcspRequest);
-    asn_free(get_BasicOCSPResponse_desc(), m_BasicOcspResp);
+    asn_arena_free(m_RespArena);
     ba_free(m_BaBasicOcspResponse);
     ba_free(m_BaNonce);
     ba_free(m_BaRequestEncoded);
@@ -89,7 +90,9 @@ void OcspHelper::reset (void)
     ba_free(m_BaTbsResponseData);
 
     m_SingleResponseInfos.clear();
+    m_ResponseIndexes.clear();
     m_OcspRequest = nullptr;
+    m_RespArena = nullptr;
     m_BasicOcspResp = nullptr;
     m_BaBasicOcspResponse = nullptr;
     m_BaNonce = nullptr;
@@ -149,6 +152,27 @@ cleanup:
     return ret;
 }
 
+int OcspHelper::addCertId (
+        const ByteArray* baCertId
+)
+{
+    int ret = RET_OK;
+    Request_t* request = nullptr;
+
+    if (!m_OcspRequest || !baCertId) return RET_UAPKI_INVALID_PARAMETER;
+
+    ASN_ALLOC_TYPE(request, Request_t);
+
+    DO(asn_decode_ba(get_CertID_desc(), &request->reqCert, baCertId));
+
+    DO(ASN_SEQUENCE_ADD(&m_OcspRequest->tbsRequest.requestList.list, request));
+    request = nullptr;
+
+cleanup:
+    asn_free(get_Request_desc(), request);
+    return ret;
+}
+
 int OcspHelper::addIssuerAndSN (
         const Cert::CerItem* cerIssuer,
         const ByteArray* baSerialNumber
@@ -156,14 +180,12 @@ int OcspHelper::addIssuerAndSN (
 {
     int ret = RET_OK;
     UapkiNS::AlgorithmIdentifier aid_hashalgo;
-    SmartBA sba_subject, sba_issuernamehash;
+    SmartBA sba_issuernamehash;
 
     if (!m_OcspRequest || !cerIssuer || !baSerialNumber) return RET_UAPKI_INVALID_PARAMETER;
 
-    DO(asn_encode_ba(get_Name_desc(), &cerIssuer->getCert()->tbsCertificate.subject, &sba_subject));
-
     aid_hashalgo.algorithm = string(hash_to_oid(cerIssuer->getAlgoKeyId()));
-    DO(::hash(cerIssuer->getAlgoKeyId(), sba_subject.get(), &sba_issuernamehash));
+    DO(::hash(cerIssuer->getAlgoKeyId(), cerIssuer->getSubject(), &sba_issuernamehash));
 
     DO(addCertId(
         aid_hashalgo,
@@ -240,7 +262,7 @@ int OcspHelper::parseOcspResponse (
     if (!ocsp_resp) return RET_UAPKI_OCSP_RESPONSE_INVALID;
 
     int ret = RET_OK;
-    BasicOCSPResponse_t* basic_ocspresp = nullptr;
+    const BasicOCSPResponse_t* basic_ocspresp = nullptr;
     uint32_t status = 0;
     DO(Util::enumeratedFromAsn1(&ocsp_resp->responseStatus, &status));
 
@@ -251,8 +273,9 @@ int OcspHelper::parseOcspResponse (
             SET_ERROR(RET_UAPKI_OCSP_RESPONSE_INVALID);
         }
 
-        basic_ocspresp = (BasicOCSPResponse_t*)asn_decode_with_alloc(
-            get_BasicOCSPResponse_desc(), resp_bytes->response.buf, resp_bytes->response.size);
+        DO(allocRespArena((size_t)resp_bytes->response.size));
+        basic_ocspresp = (const BasicOCSPResponse_t*)asn_decode_arena(
+            get_BasicOCSPResponse_desc(), m_RespArena, resp_bytes->response.buf, resp_bytes->response.size);
         if (!basic_ocspresp) {
             SET_ERROR(RET_UAPKI_OCSP_RESPONSE_INVALID);
         }
@@ -269,11 +292,20 @@ int OcspHelper::parseOcspResponse (
     }
 
 cleanup:
-    asn_free(get_BasicOCSPResponse_desc(), basic_ocspresp);
     asn_free(get_OCSPResponse_desc(), ocsp_resp);
     return ret;
 }
 
+int OcspHelper::allocRespArena (
+        const size_t sizeHint
+)
+{
+    if (!m_RespArena) {
+        m_RespArena = asn_arena_alloc(sizeHint);
+    }
+    return (m_RespArena) ? RET_OK : RET_UAPKI_GENERAL_ERROR;
+}
+
 int OcspHelper::encodeTbsRequest (void)
 {
     if (!m_OcspRequest) return RET_UAPKI_INVALID_PARAMETER;
@@ -338,6 +370,17 @@ ByteArray* OcspHelper::getRequestEncoded (
     return rv_ba;
 }
 
+int OcspHelper::getRequestCertId (
+        const size_t index,
+        ByteArray** baCertId
+)
+{
+    if (!m_OcspRequest || !baCertId) return RET_UAPKI_INVALID_PARAMETER;
+    if (index >= (size_t)m_OcspRequest->tbsRequest.requestList.list.count) return RET_UAPKI_INVALID_PARAMETER;
+
+    return asn_encode_ba(get_CertID_desc(), &m_OcspRequest->tbsRequest.requestList.list.array[index]->reqCert, baCertId);
+}
+
 int OcspHelper::parseBasicOcspResponse (
         const ByteArray* baEncoded
 )
@@ -346,7 +389,8 @@ int OcspHelper::parseBasicOcspResponse (
 
     if (!baEncoded) return RET_UAPKI_INVALID_PARAMETER;
 
-    CHECK_NOT_NULL(m_BasicOcspResp = (BasicOCSPResponse_t*)asn_decode_ba_with_alloc(get_BasicOCSPResponse_desc(), baEncoded));
+    DO(allocRespArena(ba_get_len(baEncoded)));
+    CHECK_NOT_NULL(m_BasicOcspResp = (const BasicOCSPResponse_t*)asn_decode_ba_arena(get_BasicOCSPResponse_desc(), m_RespArena, baEncoded));
 
     DO(asn_encode_ba(get_ResponseData_desc(), &m_BasicOcspResp->tbsResponseData, &m_BaTbsResponseData));
 
@@ -496,9 +540,10 @@ int OcspHelper::getSerialNumberFromCertId (
     if (!m_BasicOcspResp) return RET_UAPKI_INVALID_PARAMETER;
 
     const ResponseData_t* tbs_respdata = &m_BasicOcspResp->tbsResponseData;
-    if (index >= (size_t)tbs_respdata->responses.list.count) return RET_UAPKI_INVALID_PARAMETER;
+    const size_t idx_resp = (index < m_ResponseIndexes.size()) ? m_ResponseIndexes[index] : index;
+    if (idx_resp >= (size_t)tbs_respdata->responses.list.count) return RET_UAPKI_INVALID_PARAMETER;
 
-    const SingleResponse_t* resp = tbs_respdata->responses.list.array[index];
+    const SingleResponse_t* resp = tbs_respdata->responses.list.array[idx_resp];
     return asn_INTEGER2ba(&resp->certID.serialNumber, baSerialNumber);
 }
 
@@ -515,31 +560,40 @@ int OcspHelper::scanSingleResponses (void)
     const int cnt_responses = tbs_respdata->responses.list.count;
     if (cnt_responses <= 0) return RET_UAPKI_INVALID_COUNT_ITEMS;
 
-    m_SingleResponseInfos.resize((size_t)cnt_responses);
+    m_ResponseIndexes.clear();
     if (m_OcspRequest) {
+        //  Responder may return the responses in other order or the response for several requests (cached one)
         tbs_req = &m_OcspRequest->tbsRequest;
-        if (tbs_req->requestList.list.count != cnt_responses) {
-            SET_ERROR(RET_UAPKI_OCSP_RESPONSE_INVALID);
+        for (int i = 0; i < tbs_req->requestList.list.count; i++) {
+            const CertID_t& req_certid = tbs_req->requestList.list.array[i]->reqCert;
+            int idx_resp = 0;
+            for (; idx_resp < cnt_responses; idx_resp++) {
+                const CertID_t& resp_certid = tbs_respdata->responses.list.array[idx_resp]->certID;
+                if (
+                    Util::equalValuePrimitiveType(req_certid.hashAlgorithm.algorithm, resp_certid.hashAlgorithm.algorithm) &&
+                    Util::equalValueOctetString(req_certid.issuerNameHash, resp_certid.issuerNameHash) &&
+                    Util::equalValueOctetString(req_certid.issuerKeyHash, resp_certid.issuerKeyHash) &&
+                    Util::equalValuePrimitiveType(req_certid.serialNumber, resp_certid.serialNumber)
+                ) break;
+            }
+            if (idx_resp == cnt_responses) {
+                SET_ERROR(RET_UAPKI_OCSP_RESPONSE_INVALID);
+            }
+            m_ResponseIndexes.push_back((size_t)idx_resp);
+        }
+    }
+    else {
+        for (int i = 0; i < cnt_responses; i++) {
+            m_ResponseIndexes.push_back((size_t)i);
         }
     }
+    m_SingleResponseInfos.resize(m_ResponseIndexes.size());
 
     for (size_t i = 0; i < m_SingleResponseInfos.size(); i++) {
-        const SingleResponse_t* resp = tbs_respdata->responses.list.array[i];
+        const SingleResponse_t* resp = tbs_respdata->responses.list.array[m_ResponseIndexes[i]];
         SingleResponseInfo& ocsp_item = m_SingleResponseInfos[i];
         uint32_t crl_reason = 0;
 
-        if (m_OcspRequest) {
-            const CertID_t& req_certid = tbs_req->requestList.list.array[i]->reqCert;
-            if (
-                !Util::equalValuePrimitiveType(req_certid.hashAlgorithm.algorithm, resp->certID.hashAlgorithm.algorithm) ||
-                !Util::equalValueOctetString(req_certid.issuerNameHash, resp->certID.issuerNameHash) ||
-                !Util::equalValueOctetString(req_certid.issuerKeyHash, resp->certID.issuerKeyHash) ||
-                !Util::equalValuePrimitiveType(req_certid.serialNumber, resp->certID.serialNumber)
-            ) {
-                SET_ERROR(RET_UAPKI_OCSP_RESPONSE_INVALID);
-            }
-        }
-
         switch (resp->certStatus.present) {
         case CertStatus_PR_good:
             ocsp_item.certStatus = UapkiNS::CertStatus::GOOD;
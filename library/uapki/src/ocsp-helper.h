@@ -60,7 +60,6 @@ namespace Ocsp {
 
     static const size_t NONCE_MAXLEN    = 64;
     static const size_t NONCE_MINLEN    = 8;
-    static const uint64_t OFFSET_EXPIRE_DEFAULT = 30 * 60000;
 
     class OcspHelper
     {
@@ -85,9 +84,12 @@ namespace Ocsp {
     private:
         std::vector<SingleResponseInfo>
                     m_SingleResponseInfos;
+        std::vector<size_t>
+                    m_ResponseIndexes;      //  Index of SingleResponse for each SingleResponseInfo
         OCSPRequest_t*
                     m_OcspRequest;
-        BasicOCSPResponse_t*
+        AsnArena*   m_RespArena;
+        const BasicOCSPResponse_t*
                     m_BasicOcspResp;
         ByteArray*  m_BaBasicOcspResponse;
         ByteArray*  m_BaNonce;
@@ -115,6 +117,9 @@ namespace Ocsp {
             const ByteArray* baIssuerKeyHash,
             const ByteArray* baSerialNumber
         );
+        int addCertId (             //  Note: encoded CertID, as getRequestCertId() returns (key of OcspCache)
+            const ByteArray* baCertId
+        );
         int addIssuerAndSN (
             const Cert::CerItem* cerIssuer,
             const ByteArray* baSerialNumber
@@ -137,6 +142,10 @@ namespace Ocsp {
         ByteArray* getRequestEncoded (
             const bool move = false
         );
+        int getRequestCertId (      //  Note: encoded CertID of request, used as key of OcspCache
+            const size_t index,
+            ByteArray** baCertId
+        );
 
         int parseBasicOcspResponse (
             const ByteArray* baEncoded
@@ -165,6 +174,7 @@ namespace Ocsp {
             const size_t index,
             ByteArray** baSerialNumber
         );
+        //  SingleResponseInfo are in order of request (if it is present), the responses are matched by CertID
         int scanSingleResponses (void);
         int verifyTbsResponseData (
             const Cert::CerItem* cerResponder,
@@ -197,6 +207,11 @@ namespace Ocsp {
             const ByteArray* baEncoded
         );
 
+    private:
+        int allocRespArena (
+            const size_t sizeHint
+        );
+
     };  //  end class OcspHelper
 
     struct ResponseInfo {
@@ -223,6 +238,30 @@ namespace Ocsp {
 
     };  //  end struct ResponseInfo
 
+    //  Outcome of the verified OCSP-response. It is kept together with the bytes of response
+    //  (Cert::CertStatusInfo), so the result is returned again without parsing and verifying
+    struct VerifiedResponse {
+        OcspHelper::SingleResponseInfo
+                    singleResponseInfo;
+        uint64_t    msProducedAt;
+        ResponderIdType
+                    responderIdType;
+        SmartBA     baResponderId;
+        SignatureVerifyStatus
+                    statusSignature;
+        VectorBA    certIds;                //  CertIds of the certificates from response
+        SmartBA     baCertId;               //  CertId of the certificate from response with serial number of subject
+        SmartBA     baBasicOcspResponse;
+        SmartBA     baOcspIdentifier;
+
+        VerifiedResponse (void)
+        : msProducedAt(0)
+        , responderIdType(ResponderIdType::UNDEFINED)
+        , statusSignature(SignatureVerifyStatus::UNDEFINED)
+        {}
+
+    };  //  end struct VerifiedResponse
+
     int generateOtherHash (
         const ByteArray* baOcspResponseEncoded,
         const UapkiNS::AlgorithmIdentifier& aidHash,
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2021, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define FILE_MARKER "uapki/ocsp-refresher.cpp"
+
+#include <system_error>
+#include "ocsp-refresher.h"
+#include "cert-validator.h"
+#include "uapki-errors.h"
+#include "uapki-ns-util.h"
+
+
+using namespace std;
+
+
+namespace UapkiNS {
+
+namespace Ocsp {
+
+
+OcspRefresher::OcspRefresher (
+        LibraryConfig& libConfig,
+        Cert::CerStore& cerStore,
+        Crl::CrlStore& crlStore
+)
+    : m_LibConfig(libConfig)
+    , m_CerStore(cerStore)
+    , m_CrlStore(crlStore)
+    , m_Stop(false)
+{
+}
+
+OcspRefresher::~OcspRefresher (void)
+{
+    stop();
+    for (auto& it : m_Pending) {
+        ba_free(it.second);
+    }
+}
+
+int OcspRefresher::start (void)
+{
+    lock_guard<mutex> lock(m_Mutex);
+
+    if (m_Thread.joinable()) return RET_OK;
+
+    m_Stop = false;
+    try {
+        m_Thread = thread(&OcspRefresher::run, this);
+    }
+    catch (const system_error&) {
+        return RET_UAPKI_GENERAL_ERROR;
+    }
+    return RET_OK;
+}
+
+void OcspRefresher::stop (void)
+{
+    {
+        lock_guard<mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_CondVar.notify_all();
+    if (m_Thread.joinable()) {
+        m_Thread.join();
+    }
+}
+
+void OcspRefresher::schedule (
+        const Cert::CerItem* cerSubject
+)
+{
+    if (!cerSubject || !cerSubject->getCertId() || !cerSubject->getEncoded()) return;
+
+    const string s_id = Util::baToHex(cerSubject->getCertId());
+
+    lock_guard<mutex> lock(m_Mutex);
+
+    if (m_Stop || (m_Pending.find(s_id) != m_Pending.end())) return;
+
+    ByteArray* ba_encoded = ba_copy_with_alloc(cerSubject->getEncoded(), 0, 0);
+    if (!ba_encoded) return;
+
+    m_Pending[s_id] = ba_encoded;
+    m_CondVar.notify_all();
+}
+
+void OcspRefresher::refresh (
+        const ByteArray* baEncoded
+)
+{
+    CertValidator::CertValidator cert_validator;
+    Cert::CerItem* cer_parsed = nullptr;
+    Cert::CerItem* cer_subject = nullptr;
+    Cert::CerItem* cer_issuer = nullptr;
+    bool is_selfsigned = false;
+
+    //  Note: CerItem is not kept - the certificate may be removed from the store meanwhile
+    if (!cert_validator.init(&m_LibConfig, &m_CerStore, &m_CrlStore)) return;
+    if (Cert::parseCert(baEncoded, &cer_parsed) != RET_OK) return;
+    if (m_CerStore.getCertByCertId(cer_parsed->getCertId(), &cer_subject) != RET_OK) {
+        cer_subject = cer_parsed;
+    }
+    if ((m_CerStore.getIssuerCert(cer_subject, &cer_issuer, is_selfsigned) == RET_OK) && !is_selfsigned) {
+        (void)cert_validator.refreshByOcsp(cer_subject, cer_issuer);
+    }
+    delete cer_parsed;
+}
+
+void OcspRefresher::run (void)
+{
+    unique_lock<mutex> lock(m_Mutex);
+
+    while (!m_Stop) {
+        if (m_Pending.empty()) {
+            m_CondVar.wait(lock, [this]() {
+                return (m_Stop || !m_Pending.empty());
+            });
+            continue;
+        }
+
+        SmartBA sba_encoded;
+        (void)sba_encoded.set(m_Pending.begin()->second);
+        m_Pending.erase(m_Pending.begin());
+
+        //  Network I/O is done without lock, new certificates can be scheduled meanwhile
+        lock.unlock();
+        refresh(sba_encoded.get());
+        lock.lock();
+    }
+}
+
+
+}   //  end namespace Ocsp
+
+}   //  end namespace UapkiNS
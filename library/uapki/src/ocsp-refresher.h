@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2021, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UAPKI_OCSP_REFRESHER_H
+#define UAPKI_OCSP_REFRESHER_H
+
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "cer-store.h"
+#include "crl-store.h"
+#include "library-config.h"
+
+
+namespace UapkiNS {
+
+namespace Ocsp {
+
+
+//  Background refresh of OCSP-statuses (stale-while-revalidate): the expired status is used
+//  during staleTtl and the new one is requested by this thread, not on the path of request.
+//  Certificates are registered by schedule(), each one is refreshed once per registration.
+//  Certificate is kept encoded: it is found in the store by CertId, otherwise it is parsed again
+//  (certificate that is not in the store, the new status is saved in the OCSP-cache only)
+class OcspRefresher {
+    LibraryConfig&
+                m_LibConfig;
+    Cert::CerStore&
+                m_CerStore;
+    Crl::CrlStore&
+                m_CrlStore;
+    std::mutex  m_Mutex;
+    std::condition_variable
+                m_CondVar;
+    std::thread m_Thread;
+    bool        m_Stop;
+    std::map<std::string, ByteArray*>
+                m_Pending;
+
+public:
+    OcspRefresher (
+        LibraryConfig& libConfig,
+        Cert::CerStore& cerStore,
+        Crl::CrlStore& crlStore
+    );
+    ~OcspRefresher (void);
+
+public:
+    //  The group of functions that have lock_guard
+    int start (void);
+    void stop (void);
+    void schedule (
+        const Cert::CerItem* cerSubject
+    );
+
+private:
+    void refresh (
+        const ByteArray* baEncoded
+    );
+    void run (void);
+
+};  //  end class OcspRefresher
+
+
+}   //  end namespace Ocsp
+
+}   //  end namespace UapkiNS
+
+#endif
@@ -32,6 +32,7 @@
 #include "extension-helper-json.h"
 #include "dstu-ns.h"
 #include "macros-internal.h"
+#include "oid-registry.h"
 #include "oid-utils.h"
 #include "parson-ba-utils.h"
 #include "parson-helper.h"
@@ -234,8 +235,11 @@ int detailInfoToJson (
         const CerItem* cerItem
 )
 {
+    const Certificate_t* cert = cerItem->getCert();
+    if (!cert) return RET_UAPKI_INVALID_STRUCT;
+
     int ret = RET_OK;
-    const TBSCertificate_t& tbs_cert = cerItem->getCert()->tbsCertificate;
+    const TBSCertificate_t& tbs_cert = cert->tbsCertificate;
     long version = 0;
     bool self_signed = false;
 
@@ -270,8 +274,11 @@ int extensionsToJson (
         bool& selfSigned
 )
 {
+    const Certificate_t* cert = cerItem->getCert();
+    if (!cert) return RET_UAPKI_INVALID_STRUCT;
+
     int ret = RET_OK;
-    const Extensions_t* extns = cerItem->getCert()->tbsCertificate.extensions;
+    const Extensions_t* extns = cert->tbsCertificate.extensions;
     SmartBA sba_authoritykeyid, sba_subjectkeyid;
     JSON_Array* ja_extns = nullptr;
 
@@ -295,47 +302,51 @@ int extensionsToJson (
         DO(json_object_set_base64(jo_extn, "extnValue", sba_value.get()));
 
         //  Decode specific extensions
-        if (oid_is_equal(s_extnid.c_str(), OID_X509v3_KeyUsage)) {
+        switch (oid_id_from_OID(&extn->extnID)) {
+        case OID_ID_X509v3_KeyUsage:
             DO(ExtensionHelper::DecodeToJsonObject::keyUsage(sba_value.get(), extn_json_add_decoded(jo_extn, "keyUsage")));
-        }
-        else if (oid_is_equal(s_extnid.c_str(), OID_X509v3_SubjectKeyIdentifier)) {
+            break;
+        case OID_ID_X509v3_SubjectKeyIdentifier:
             DO(ExtensionHelper::DecodeToJsonObject::subjectKeyId(sba_value.get(), extn_json_add_decoded(jo_extn, "subjectKeyIdentifier"), &sba_subjectkeyid));
-        }
-        else if (oid_is_equal(s_extnid.c_str(), OID_X509v3_AuthorityKeyIdentifier)) {
+            break;
+        case OID_ID_X509v3_AuthorityKeyIdentifier:
             DO(ExtensionHelper::DecodeToJsonObject::authorityKeyId(sba_value.get(), extn_json_add_decoded(jo_extn, "authorityKeyIdentifier"), &sba_authoritykeyid));
-        }
-        else if (oid_is_equal(s_extnid.c_str(), OID_X509v3_BasicConstraints)) {
+            break;
+        case OID_ID_X509v3_BasicConstraints:
             DO(ExtensionHelper::DecodeToJsonObject::basicConstraints(sba_value.get(), extn_json_add_decoded(jo_extn, "basicConstraints")));
-        }
-        else if (oid_is_equal(s_extnid.c_str(), OID_X509v3_CRLDistributionPoints)) {
+            break;
+        case OID_ID_X509v3_CRLDistributionPoints:
             DO(ExtensionHelper::DecodeToJsonObject::distributionPoints(sba_value.get(), extn_json_add_decoded(jo_extn, "cRLDistributionPoints")));
-        }
-        else if (oid_is_equal(s_extnid.c_str(), OID_X509v3_CertificatePolicies)) {
+            break;
+        case OID_ID_X509v3_CertificatePolicies:
             DO(ExtensionHelper::DecodeToJsonObject::certificatePolicies(sba_value.get(), extn_json_add_decoded(jo_extn, "certificatePolicies")));
-        }
-        else if (oid_is_equal(s_extnid.c_str(), OID_X509v3_ExtendedKeyUsage)) {
+            break;
+        case OID_ID_X509v3_ExtendedKeyUsage:
             DO(ExtensionHelper::DecodeToJsonObject::extendedKeyUsage(sba_value.get(), extn_json_add_decoded(jo_extn, "extKeyUsage")));
-        }
-        else if (oid_is_equal(s_extnid.c_str(), OID_X509v3_FreshestCRL)) {
+            break;
+        case OID_ID_X509v3_FreshestCRL:
             DO(ExtensionHelper::DecodeToJsonObject::distributionPoints(sba_value.get(), extn_json_add_decoded(jo_extn, "freshestCRL")));
-        }
-        else if (oid_is_equal(s_extnid.c_str(), OID_X509v3_SubjectDirectoryAttributes)) {
+            break;
+        case OID_ID_X509v3_SubjectDirectoryAttributes:
             DO(ExtensionHelper::DecodeToJsonObject::subjectDirectoryAttributes(sba_value.get(), extn_json_add_decoded(jo_extn, "subjectDirectoryAttributes")));
-        }
-        else if (oid_is_equal(s_extnid.c_str(), OID_PKIX_AuthorityInfoAccess)) {
+            break;
+        case OID_ID_PKIX_AuthorityInfoAccess:
             DO(ExtensionHelper::DecodeToJsonObject::accessDescriptions(sba_value.get(), extn_json_add_decoded(jo_extn, "authorityInfoAccess")));
-        }
-        else if (oid_is_equal(s_extnid.c_str(), OID_PKIX_QcStatements)) {
+            break;
+        case OID_ID_PKIX_QcStatements:
             DO(ExtensionHelper::DecodeToJsonObject::qcStatements(sba_value.get(), extn_json_add_decoded(jo_extn, "qcStatements")));
-        }
-        else if (oid_is_equal(s_extnid.c_str(), OID_PKIX_SubjectInfoAccess)) {
+            break;
+        case OID_ID_PKIX_SubjectInfoAccess:
             DO(ExtensionHelper::DecodeToJsonObject::accessDescriptions(sba_value.get(), extn_json_add_decoded(jo_extn, "subjectInfoAccess")));
-        }
-        else if (oid_is_equal(s_extnid.c_str(), OID_X509v3_SubjectAlternativeName)) {
+            break;
+        case OID_ID_X509v3_SubjectAlternativeName:
             DO(ExtensionHelper::DecodeToJsonObject::alternativeName(sba_value.get(), extn_json_add_decoded(jo_extn, "subjectAltName")));
-        }
-        else if (oid_is_equal(s_extnid.c_str(), OID_X509v3_IssuerAlternativeName)) {
+            break;
+        case OID_ID_X509v3_IssuerAlternativeName:
             DO(ExtensionHelper::DecodeToJsonObject::alternativeName(sba_value.get(), extn_json_add_decoded(jo_extn, "issuerAltName")));
+            break;
+        default:
+            break;
         }
     }
 
@@ -386,6 +397,7 @@ int signatureInfoToJson (
 )
 {
     if (!joResult || !cerItem) return RET_UAPKI_GENERAL_ERROR;
+    if (!cerItem->getCert()) return RET_UAPKI_INVALID_STRUCT;
 
     int ret = RET_OK;
     const Certificate_t& cert = *cerItem->getCert();
@@ -417,6 +429,7 @@ int spkiToJson (
 )
 {
     if (!joResult || !cerItem) return RET_UAPKI_GENERAL_ERROR;
+    if (!cerItem->getCert()) return RET_UAPKI_INVALID_STRUCT;
 
     int ret = RET_OK;
     const SubjectPublicKeyInfo_t& spki = cerItem->getCert()->tbsCertificate.subjectPublicKeyInfo;
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2021, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define FILE_MARKER "uapki/store-loader.cpp"
+
+#include <algorithm>
+#include <atomic>
+#include <string.h>
+#include <system_error>
+#include <thread>
+#include "store-loader.h"
+#include "asn1-utils.h"
+#include "dirent-internal.h"
+#include "macros-internal.h"
+#include "uapki-errors.h"
+
+
+using namespace std;
+
+
+namespace UapkiNS {
+
+namespace StoreLoader {
+
+
+struct ParallelForContext {
+    atomic<size_t>  next;
+    size_t          count;
+    void (*func)(void* ctx, const size_t index);
+    void*           ctx;
+};  //  end struct ParallelForContext
+
+static void parallel_for_worker (
+        ParallelForContext* pfCtx
+)
+{
+    for (size_t i = pfCtx->next++; i < pfCtx->count; i = pfCtx->next++) {
+        pfCtx->func(pfCtx->ctx, i);
+    }
+}   //  parallel_for_worker
+
+
+int listFiles (
+        const string& path,
+        const char* ext,
+        vector<string>& fileNames
+)
+{
+    DIR* dir = nullptr;
+    struct dirent* in_file;
+    const size_t ext_len = strlen(ext);
+
+    fileNames.clear();
+    dir = opendir(path.c_str());
+    if (!dir) return RET_UAPKI_FILE_OPEN_ERROR;
+
+    while ((in_file = readdir(dir))) {
+        if (!strcmp(in_file->d_name, ".") || !strcmp(in_file->d_name, "..")) {
+            continue;
+        }
+
+        //  Check file-extension
+        const string s_name = string(in_file->d_name);
+        const size_t pos = s_name.rfind(ext);
+        if ((pos == string::npos) || (pos != s_name.length() - ext_len)) {
+            continue;
+        }
+
+        const string s_fullpath = path + s_name;
+        if (!is_dir(s_fullpath.c_str())) {
+            fileNames.push_back(s_name);
+        }
+    }
+
+    closedir(dir);
+
+    sort(fileNames.begin(), fileNames.end());
+    return RET_OK;
+}
+
+void parallelFor (
+        const size_t count,
+        void (*func)(void* ctx, const size_t index),
+        void* ctx,
+        const size_t maxWorkers
+)
+{
+    ParallelForContext pf_ctx;
+    pf_ctx.next = 0;
+    pf_ctx.count = count;
+    pf_ctx.func = func;
+    pf_ctx.ctx = ctx;
+
+    size_t cnt_workers = (maxWorkers > 0) ? maxWorkers : (size_t)thread::hardware_concurrency();
+    cnt_workers = min(min(cnt_workers, count), MAX_WORKERS);
+
+    vector<thread> workers;
+    if (cnt_workers > 1) {
+        //  Descriptors of derived ASN.1-types are filled by the first use: it is done before workers decode
+        asn_init_descriptors();
+        workers.reserve(cnt_workers - 1);
+        try {
+            for (size_t i = 1; i < cnt_workers; i++) {
+                workers.push_back(thread(parallel_for_worker, &pf_ctx));
+            }
+        }
+        catch (const system_error&) {
+            //  Continue with the threads that have been started
+        }
+    }
+
+    //  The calling thread is a worker too
+    parallel_for_worker(&pf_ctx);
+
+    for (auto& it : workers) {
+        it.join();
+    }
+}
+
+
+}   //  end namespace StoreLoader
+
+}   //  end namespace UapkiNS
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2021, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UAPKI_STORE_LOADER_H
+#define UAPKI_STORE_LOADER_H
+
+
+#include <string>
+#include <vector>
+
+
+namespace UapkiNS {
+
+namespace StoreLoader {
+
+    //  Worker limit: parsing is CPU-bound, more threads only add memory pressure
+    static const size_t MAX_WORKERS = 16;
+
+    //  Names of the regular files with the extension (not recursive), sorted -
+    //  so that the result of loading does not depend on the order of readdir()
+    int listFiles (
+        const std::string& path,
+        const char* ext,
+        std::vector<std::string>& fileNames
+    );
+
+    //  Calls func(ctx, index) for every index in [0, count) on a pool of worker threads,
+    //  returns after all calls are completed. Runs on the calling thread if count is small
+    //  or threads are unavailable. maxWorkers 0 - by number of hardware threads
+    void parallelFor (
+        const size_t count,
+        void (*func)(void* ctx, const size_t index),
+        void* ctx,
+        const size_t maxWorkers = 0
+    );
+
+}   //  end namespace StoreLoader
+
+}   //  end namespace UapkiNS
+
+
+#endif
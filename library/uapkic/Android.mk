@@ -15,6 +15,7 @@ LOCAL_SRC_FILES := \
 	$(DIR_SRC)/aes.c \
 	$(DIR_SRC)/byte-array.c \
 	$(DIR_SRC)/byte-array-internal.c \
+	$(DIR_SRC)/byte-array-simd.c \
 	$(DIR_SRC)/byte-utils-internal.c \
 	$(DIR_SRC)/des.c \
 	$(DIR_SRC)/drbg.c \
@@ -29,6 +29,7 @@
 #ifndef UAPKIC_BYTE_ARRAY_H
 #define UAPKIC_BYTE_ARRAY_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include "uapkic-export.h"
@@ -66,6 +67,31 @@ UAPKIC_EXPORT ByteArray *ba_alloc_by_len(size_t len);
  */
 UAPKIC_EXPORT ByteArray *ba_alloc_from_uint8(const uint8_t *buf, size_t buf_len);
 
+/**
+ * Створює контекст масиву байт, що посилається на зовнішній буфер без копіювання.
+ * Контекст не продовжує життя буфера: буфер має існувати до звільнення контексту,
+ * ba_free() звільняє лише сам контекст. Для даних, декодованих через asn_decode_arena_view(),
+ * власником байтів є вихідний буфер декодування (а не арена чи об'єкт).
+ * Щоб зберегти дані довше, їх треба скопіювати через ba_copy_with_alloc().
+ * Буфер не завершується нульовим байтом.
+ * Контекст доступний лише для читання: функції, що змінюють розмір або вміст масиву
+ * (ba_change_len(), ba_append(), ba_set(), ba_set_byte(), ba_swap(), ba_xor(), ba_copy() та ін.),
+ * для нього повертають RET_INVALID_PARAM.
+ *
+ * @param buf массив байт
+ * @param buf_len розмір масиву байт
+ * @return контекст масиву байт
+ */
+UAPKIC_EXPORT ByteArray *ba_alloc_view(const uint8_t *buf, size_t buf_len);
+
+/**
+ * Перевіряє, чи є контекст масиву байт посиланням на зовнішній буфер.
+ *
+ * @param ba контекст масиву байт
+ * @return true - контекст створено через ba_alloc_view()
+ */
+UAPKIC_EXPORT bool ba_is_view(const ByteArray *ba);
+
 UAPKIC_EXPORT ByteArray* ba_alloc_from_hex(const char* str);
 
 UAPKIC_EXPORT ByteArray* ba_alloc_from_base64(const char* str);
@@ -128,6 +154,7 @@ UAPKIC_EXPORT size_t ba_get_len(const ByteArray* ba);
 
 /**
  * Повертає вказівник на дані, які зберігають контекст масиву байт.
+ * Дані контексту, створеного через ba_alloc_view(), не можна змінювати.
  *
  * @param ba контекст масиву байт
  * @return вказівник на дані, які зберігають контекст масиву байт
@@ -44,6 +44,18 @@ UAPKIC_EXPORT int dstu8845_set_iv(Dstu8845Ctx *ctx, const ByteArray* iv);
 
 UAPKIC_EXPORT int dstu8845_crypt(Dstu8845Ctx *ctx, ByteArray* inout);
 
+/**
+ * Шифрує/розшифровує дані довільної довжини. Може викликатися послідовно
+ * для частин потоку, результат не залежить від розбиття на частини.
+ *
+ * @param ctx контекст ДСТУ 8845
+ * @param in вхідні дані
+ * @param out вихідні дані, може збігатися з in
+ * @param len розмір даних у байтах
+ * @return код помилки
+ */
+UAPKIC_EXPORT int dstu8845_crypt_update(Dstu8845Ctx *ctx, const uint8_t *in, uint8_t *out, size_t len);
+
 UAPKIC_EXPORT void dstu8845_free(Dstu8845Ctx *ctx);
 
 UAPKIC_EXPORT int dstu8845_generate_key(size_t key_len, ByteArray** key);
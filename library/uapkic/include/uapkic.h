@@ -102,6 +102,15 @@
 
 #define SELF_TEST_ECDH_FAIL      0x80000000
 
+/**
+ * Режим виконання самотестування.
+ */
+typedef enum {
+    SELF_TEST_MODE_SERIAL   = 0,    /**< Послідовно під час ініціалізації */
+    SELF_TEST_MODE_PARALLEL = 1,    /**< Паралельно в пулі потоків під час ініціалізації */
+    SELF_TEST_MODE_DEFERRED = 2     /**< Відкладено: самотест алгоритму виконується один раз при першому використанні */
+} SelfTestMode;
+
 #ifdef  __cplusplus
 extern "C" {
 #endif
@@ -115,6 +124,27 @@ extern "C" {
  */
 UAPKIC_EXPORT int uapkic_init(uint32_t* version, uint32_t* self_test_status);
 
+/**
+ * Ініціалізує ГПВП, проводить самотестування у вказаному режимі.
+ * У режимі SELF_TEST_MODE_DEFERRED під час ініціалізації тестуються лише джерело ентропії та ГПВП,
+ * решта алгоритмів тестується при першому використанні; алгоритм, що не пройшов самотест,
+ * повертає RET_SELF_TEST_FAIL.
+ *
+ * @param version повертає версію бібліотеки, може бути NULL
+ * @param mode режим самотестування
+ * @param self_test_status повертає результат виконаного самотестування, може бути NULL
+ * @return код помилки
+ */
+UAPKIC_EXPORT int uapkic_init_ex(uint32_t* version, SelfTestMode mode, uint32_t* self_test_status);
+
+/**
+ * Повертає накопичений результат самотестування (маска SELF_TEST_*_FAIL),
+ * включно з відкладеними самотестами, виконаними після ініціалізації.
+ *
+ * @return результат самотестування
+ */
+UAPKIC_EXPORT uint32_t uapkic_get_self_test_status(void);
+
 #ifdef  __cplusplus
 }
 #endif
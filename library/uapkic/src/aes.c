@@ -31,6 +31,7 @@
 #include <memory.h>
 
 #include "macros-internal.h"
+#include "self-test-internal.h"
 #include "byte-array-internal.h"
 #include "aes.h"
 #include "byte-utils-internal.h"
@@ -1501,6 +1502,8 @@ AesCtx *aes_alloc(void)
     AesCtx *ctx = NULL;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_AES));
+
     CALLOC_CHECKED(ctx, sizeof(AesCtx));
 
 cleanup:
@@ -40,7 +40,7 @@ ByteArray *ba_alloc_from_uint8_be(const uint8_t *buf, size_t buf_len)
     int ret = RET_OK;
 
     if (buf != NULL && buf_len != 0) {
-        MALLOC_CHECKED(ba, sizeof (ByteArray));
+        CALLOC_CHECKED(ba, sizeof (ByteArray));
         CHECK_NOT_NULL(ba->buf = uint8_swap_with_alloc(buf, buf_len));
         ba->len = buf_len;
     }
@@ -61,7 +61,7 @@ ByteArray *ba_alloc_from_uint64(const uint64_t *buf, size_t buf_len)
     int ret = RET_OK;
 
     if (buf != NULL && buf_len != 0) {
-        MALLOC_CHECKED(ba, sizeof (ByteArray));
+        CALLOC_CHECKED(ba, sizeof (ByteArray));
         ba->len = buf_len * UINT64_LEN;
         MALLOC_CHECKED(ba->buf, ba->len);
         DO(uint64_to_uint8(buf, buf_len, ba->buf, ba->len));
@@ -118,7 +118,7 @@ ByteArray *ba_alloc_from_uint32(const uint32_t *buf, size_t buf_len)
     int ret = RET_OK;
 
     if (buf != NULL && buf_len != 0) {
-        MALLOC_CHECKED(ba, sizeof(ByteArray));
+        CALLOC_CHECKED(ba, sizeof(ByteArray));
         ba->len = buf_len * UINT32_LEN;
         MALLOC_CHECKED(ba->buf, ba->len);
         DO(uint32_to_uint8(buf, buf_len, ba->buf, ba->len));
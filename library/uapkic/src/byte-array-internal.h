@@ -42,6 +42,7 @@ extern "C" {
 struct ByteArray_st {
     uint8_t *buf;
     size_t len;
+    bool view;      /* buf не принадлежит контексту (ba_alloc_view) */
 };
 
 /**
@@ -92,6 +93,35 @@ int ba_trim_leading_zeros(ByteArray *ba);
 int ba_truncate(ByteArray *a, size_t bit_len);
 bool ba_is_zero(const ByteArray *a);
 
+/**
+ * Векторные ядра кодеков base64 и hex (SSSE3/AVX2 или NEON, выбираются при выполнении).
+ * Обрабатывают наибольший префикс из целых блоков канонического алфавита и возвращают
+ * его длину во входных символах/байтах, остаток обрабатывается скалярным кодом.
+ * Если векторные инструкции недоступны, возвращают 0.
+ *
+ * ba_simd_base64_encode: out должен вмещать 4 * (inlen / 3) символов;
+ * ba_simd_base64_decode: в out записывается не более outlen байт, возвращает кратное 4;
+ * ba_simd_hex_encode:    out должен вмещать 2 * len символов;
+ * ba_simd_hex_decode:    out должен вмещать hexlen / 2 байт, возвращает четное число.
+ */
+size_t ba_simd_base64_encode(const uint8_t *in, size_t inlen, uint8_t *out);
+size_t ba_simd_base64_decode(const uint8_t *in, size_t inlen, uint8_t *out, size_t outlen);
+size_t ba_simd_hex_encode(const uint8_t *in, size_t len, char *out);
+size_t ba_simd_hex_decode(const char *hex, size_t hexlen, uint8_t *out);
+
+#define BA_SIMD_FEATURE_SSSE3   1
+#define BA_SIMD_FEATURE_AVX2    2
+#define BA_SIMD_FEATURE_NEON    4
+
+#if defined(UAPKI_TEST_INTERNAL)
+/**
+ * Только для проверок (файл компилируется в test): ядра используются только для указанных
+ * векторных расширений, из них учитываются поддерживаемые процессором; -1 - все.
+ * Возвращает расширения, которые будут использоваться.
+ */
+int ba_simd_set_features(int features);
+#endif
+
 #ifdef  __cplusplus
 }
 #endif
@@ -0,0 +1,522 @@
+/*
+ * Copyright (c) 2023, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define FILE_MARKER "uapkic/byte-array-simd.c"
+
+#include <string.h>
+
+#include "byte-array-internal.h"
+
+//  Vectorized kernels for the base64 and hex codecs of byte-array.c.
+//  Every kernel handles the longest prefix that consists of whole blocks in the canonical alphabet
+//  and returns its length, the rest (tail, padding, whitespace, errors) is left to the scalar code.
+//  x86: SSSE3 and AVX2, selected at runtime; AArch64: NEON.
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#if defined(__GNUC__) || defined(__clang__)
+#define BA_SIMD_X86
+#define BA_TARGET(isa)  __attribute__((target(isa)))
+#elif defined(_MSC_VER)
+#define BA_SIMD_X86
+#define BA_TARGET(isa)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define BA_SIMD_NEON
+#endif
+
+#if defined(BA_SIMD_X86)
+#include <immintrin.h>
+
+static int simd_detect(void)
+{
+    int features = 0;
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("ssse3")) features |= BA_SIMD_FEATURE_SSSE3;
+    if (__builtin_cpu_supports("avx2")) features |= BA_SIMD_FEATURE_AVX2;
+#else
+    int info[4], max_leaf;
+    __cpuid(info, 0);
+    max_leaf = info[0];
+    if (max_leaf >= 1) {
+        __cpuid(info, 1);
+        if (info[2] & (1 << 9)) features |= BA_SIMD_FEATURE_SSSE3;
+        //  AVX2 also requires OS support of YMM state (OSXSAVE and XCR0)
+        if ((max_leaf >= 7) && (info[2] & (1 << 27)) && ((_xgetbv(0) & 6) == 6)) {
+            __cpuidex(info, 7, 0);
+            if (info[1] & (1 << 5)) features |= BA_SIMD_FEATURE_AVX2;
+        }
+    }
+#endif
+    return features;
+}
+
+BA_TARGET("ssse3")
+static __m128i b64_enc_reshuffle_ssse3(__m128i in)
+{
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1, t3);
+}
+
+BA_TARGET("ssse3")
+static __m128i b64_enc_translate_ssse3(__m128i in)
+{
+    const __m128i lut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    __m128i idx = _mm_subs_epu8(in, _mm_set1_epi8(51));
+    const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), in);
+    idx = _mm_or_si128(idx, _mm_and_si128(less, _mm_set1_epi8(13)));
+    return _mm_add_epi8(in, _mm_shuffle_epi8(lut, idx));
+}
+
+BA_TARGET("ssse3")
+static size_t b64_encode_ssse3(const uint8_t* in, size_t inlen, uint8_t* out)
+{
+    size_t i = 0;
+    //  12 bytes are used from every 16-byte load
+    for (; inlen - i >= 16; i += 12, out += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+        _mm_storeu_si128((__m128i*)out, b64_enc_translate_ssse3(b64_enc_reshuffle_ssse3(v)));
+    }
+    return i;
+}
+
+BA_TARGET("ssse3")
+static bool b64_dec_values_ssse3(__m128i in, __m128i* values)
+{
+    const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask_0f = _mm_set1_epi8(0x0F);
+    const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(in, 4), mask_0f);
+    const __m128i lo_nibbles = _mm_and_si128(in, mask_0f);
+    const __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+    const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0) return false;
+
+    const __m128i eq_2f = _mm_cmpeq_epi8(in, _mm_set1_epi8(0x2F));
+    *values = _mm_add_epi8(in, _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nibbles)));
+    return true;
+}
+
+BA_TARGET("ssse3")
+static __m128i b64_dec_pack_ssse3(__m128i values)
+{
+    const __m128i ab_bc = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    const __m128i abc = _mm_madd_epi16(ab_bc, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(abc, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+BA_TARGET("ssse3")
+static size_t b64_decode_ssse3(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen)
+{
+    size_t i = 0;
+    __m128i values;
+    //  16 bytes are stored for every 12 decoded
+    for (; (inlen - i >= 16) && (outlen >= 16); i += 16, out += 12, outlen -= 12) {
+        if (!b64_dec_values_ssse3(_mm_loadu_si128((const __m128i*)(in + i)), &values)) break;
+        _mm_storeu_si128((__m128i*)out, b64_dec_pack_ssse3(values));
+    }
+    return i;
+}
+
+BA_TARGET("avx2")
+static size_t b64_encode_avx2(const uint8_t* in, size_t inlen, uint8_t* out)
+{
+    const __m256i shuf = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+            1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i lut = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    size_t i = 0;
+    //  Every lane takes 12 bytes: the second 16-byte load starts at offset 12
+    for (; inlen - i >= 28; i += 24, out += 32) {
+        __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(in + i))),
+                _mm_loadu_si128((const __m128i*)(in + i + 12)), 1);
+        v = _mm256_shuffle_epi8(v, shuf);
+        const __m256i t1 = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+        const __m256i t3 = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+        v = _mm256_or_si256(t1, t3);
+        __m256i idx = _mm256_subs_epu8(v, _mm256_set1_epi8(51));
+        const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), v);
+        idx = _mm256_or_si256(idx, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+        _mm256_storeu_si256((__m256i*)out, _mm256_add_epi8(v, _mm256_shuffle_epi8(lut, idx)));
+    }
+    return i;
+}
+
+BA_TARGET("avx2")
+static size_t b64_decode_avx2(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen)
+{
+    const __m256i lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i mask_0f = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    //  32 bytes are stored for every 24 decoded
+    for (; (inlen - i >= 32) && (outlen >= 32); i += 32, out += 24, outlen -= 24) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(in + i));
+        const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(v, 4), mask_0f);
+        const __m256i lo = _mm256_shuffle_epi8(lut_lo, _mm256_and_si256(v, mask_0f));
+        const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+        if (!_mm256_testz_si256(lo, hi)) break;
+
+        const __m256i eq_2f = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x2F));
+        const __m256i values = _mm256_add_epi8(v, _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2f, hi_nibbles)));
+        const __m256i ab_bc = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        __m256i abc = _mm256_madd_epi16(ab_bc, _mm256_set1_epi32(0x00011000));
+        abc = _mm256_shuffle_epi8(abc, pack);
+        abc = _mm256_permutevar8x32_epi32(abc, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm256_storeu_si256((__m256i*)out, abc);
+    }
+    return i;
+}
+
+BA_TARGET("ssse3")
+static size_t hex_encode_ssse3(const uint8_t* in, size_t len, uint8_t* out)
+{
+    const __m128i lut = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+    const __m128i mask_0f = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; len - i >= 16; i += 16, out += 32) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+        const __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), mask_0f));
+        const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, mask_0f));
+        _mm_storeu_si128((__m128i*)out, _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i*)(out + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    return i;
+}
+
+BA_TARGET("ssse3")
+static bool hex_dec_nibbles_ssse3(__m128i v, __m128i* nibbles)
+{
+    //  '0'..'9' -> 0..9, 'A'..'F' and 'a'..'f' -> 10..15
+    const __m128i digit = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+    const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    const __m128i alpha = _mm_sub_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+
+    if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) != 0xFFFF) return false;
+
+    *nibbles = _mm_or_si128(_mm_and_si128(is_digit, digit),
+            _mm_and_si128(is_alpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+    return true;
+}
+
+BA_TARGET("ssse3")
+static size_t hex_decode_ssse3(const uint8_t* hex, size_t hexlen, uint8_t* out)
+{
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    __m128i n0, n1;
+    size_t i = 0;
+    for (; hexlen - i >= 32; i += 32, out += 16) {
+        if (!hex_dec_nibbles_ssse3(_mm_loadu_si128((const __m128i*)(hex + i)), &n0)
+            || !hex_dec_nibbles_ssse3(_mm_loadu_si128((const __m128i*)(hex + i + 16)), &n1)) break;
+        //  Every pair of nibbles (hi, lo) -> hi * 16 + lo
+        _mm_storeu_si128((__m128i*)out, _mm_packus_epi16(_mm_maddubs_epi16(n0, weights), _mm_maddubs_epi16(n1, weights)));
+    }
+    return i;
+}
+
+#elif defined(BA_SIMD_NEON)
+#include <arm_neon.h>
+
+static const uint8_t B64_ALPHABET[64] = {
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+    'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
+    'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
+    'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
+};
+
+//  Values of the characters 0x00..0x7F, 0xFF - not in the alphabet
+static const uint8_t B64_VALUES[128] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255, 255, 255,  63,
+     52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255, 255, 255, 255, 255,
+    255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
+     15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255, 255,
+    255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
+     41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255
+};
+
+static size_t b64_encode_neon(const uint8_t* in, size_t inlen, uint8_t* out)
+{
+    uint8x16x4_t lut;
+    lut.val[0] = vld1q_u8(B64_ALPHABET);
+    lut.val[1] = vld1q_u8(B64_ALPHABET + 16);
+    lut.val[2] = vld1q_u8(B64_ALPHABET + 32);
+    lut.val[3] = vld1q_u8(B64_ALPHABET + 48);
+    const uint8x16_t mask_3f = vdupq_n_u8(0x3F);
+    size_t i = 0;
+    for (; inlen - i >= 48; i += 48, out += 64) {
+        const uint8x16x3_t v = vld3q_u8(in + i);
+        uint8x16x4_t r;
+        r.val[0] = vshrq_n_u8(v.val[0], 2);
+        r.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(v.val[0], 4), vshrq_n_u8(v.val[1], 4)), mask_3f);
+        r.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(v.val[1], 2), vshrq_n_u8(v.val[2], 6)), mask_3f);
+        r.val[3] = vandq_u8(v.val[2], mask_3f);
+        r.val[0] = vqtbl4q_u8(lut, r.val[0]);
+        r.val[1] = vqtbl4q_u8(lut, r.val[1]);
+        r.val[2] = vqtbl4q_u8(lut, r.val[2]);
+        r.val[3] = vqtbl4q_u8(lut, r.val[3]);
+        vst4q_u8(out, r);
+    }
+    return i;
+}
+
+static uint8x16_t b64_dec_lookup_neon(const uint8x16x4_t lut_lo, const uint8x16x4_t lut_hi, uint8x16_t c)
+{
+    //  Indexes out of the table give 0, so each character is found in one of the halves,
+    //  characters 0x80..0xFF are marked explicitly
+    const uint8x16_t lo = vqtbl4q_u8(lut_lo, c);
+    const uint8x16_t hi = vqtbl4q_u8(lut_hi, vsubq_u8(c, vdupq_n_u8(0x40)));
+    return vorrq_u8(vorrq_u8(lo, hi), vcgeq_u8(c, vdupq_n_u8(0x80)));
+}
+
+static size_t b64_decode_neon(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen)
+{
+    uint8x16x4_t lut_lo, lut_hi;
+    for (int k = 0; k < 4; k++) {
+        lut_lo.val[k] = vld1q_u8(B64_VALUES + 16 * k);
+        lut_hi.val[k] = vld1q_u8(B64_VALUES + 64 + 16 * k);
+    }
+    size_t i = 0;
+    for (; (inlen - i >= 64) && (outlen >= 48); i += 64, out += 48, outlen -= 48) {
+        const uint8x16x4_t v = vld4q_u8(in + i);
+        const uint8x16_t a = b64_dec_lookup_neon(lut_lo, lut_hi, v.val[0]);
+        const uint8x16_t b = b64_dec_lookup_neon(lut_lo, lut_hi, v.val[1]);
+        const uint8x16_t c = b64_dec_lookup_neon(lut_lo, lut_hi, v.val[2]);
+        const uint8x16_t d = b64_dec_lookup_neon(lut_lo, lut_hi, v.val[3]);
+        if (vmaxvq_u8(vorrq_u8(vorrq_u8(a, b), vorrq_u8(c, d))) > 63) break;
+
+        uint8x16x3_t r;
+        r.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+        r.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+        r.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+        vst3q_u8(out, r);
+    }
+    return i;
+}
+
+static size_t hex_encode_neon(const uint8_t* in, size_t len, uint8_t* out)
+{
+    const uint8x16_t lut = vld1q_u8((const uint8_t*)"0123456789ABCDEF");
+    size_t i = 0;
+    for (; len - i >= 16; i += 16, out += 32) {
+        const uint8x16_t v = vld1q_u8(in + i);
+        uint8x16x2_t r;
+        r.val[0] = vqtbl1q_u8(lut, vshrq_n_u8(v, 4));
+        r.val[1] = vqtbl1q_u8(lut, vandq_u8(v, vdupq_n_u8(0x0F)));
+        vst2q_u8(out, r);
+    }
+    return i;
+}
+
+static bool hex_dec_nibbles_neon(uint8x16_t v, uint8x16_t* nibbles)
+{
+    const uint8x16_t digit = vsubq_u8(v, vdupq_n_u8('0'));
+    const uint8x16_t is_digit = vcleq_u8(digit, vdupq_n_u8(9));
+    const uint8x16_t alpha = vsubq_u8(vorrq_u8(v, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    const uint8x16_t is_alpha = vcleq_u8(alpha, vdupq_n_u8(5));
+
+    if (vminvq_u8(vorrq_u8(is_digit, is_alpha)) != 0xFF) return false;
+
+    *nibbles = vbslq_u8(is_digit, digit, vaddq_u8(alpha, vdupq_n_u8(10)));
+    return true;
+}
+
+static size_t hex_decode_neon(const uint8_t* hex, size_t hexlen, uint8_t* out)
+{
+    uint8x16_t hi, lo;
+    size_t i = 0;
+    for (; hexlen - i >= 32; i += 32, out += 16) {
+        const uint8x16x2_t v = vld2q_u8(hex + i);
+        if (!hex_dec_nibbles_neon(v.val[0], &hi) || !hex_dec_nibbles_neon(v.val[1], &lo)) break;
+        vst1q_u8(out, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+    }
+    return i;
+}
+
+#endif
+
+#if defined(BA_SIMD_X86) || defined(BA_SIMD_NEON)
+//  Features are detected once, before the first use of kernels
+static int simd_features = 0;
+
+static void simd_init_features(void)
+{
+#if defined(BA_SIMD_X86)
+    simd_features = simd_detect();
+#else
+    simd_features = BA_SIMD_FEATURE_NEON;
+#endif
+}
+
+#if defined(_WIN32)
+#include <windows.h>
+
+static INIT_ONCE simd_features_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK simd_init_features_once(PINIT_ONCE init_once, PVOID param, PVOID* context)
+{
+    (void)init_once;
+    (void)param;
+    (void)context;
+    simd_init_features();
+    return TRUE;
+}
+#else
+#include <pthread.h>
+
+static pthread_once_t simd_features_once = PTHREAD_ONCE_INIT;
+#endif
+
+#if defined(UAPKI_TEST_INTERNAL)
+static int simd_test_mask = -1;
+#endif
+
+static int simd_get_features(void)
+{
+#if defined(_WIN32)
+    (void)InitOnceExecuteOnce(&simd_features_once, simd_init_features_once, NULL, NULL);
+#else
+    (void)pthread_once(&simd_features_once, simd_init_features);
+#endif
+#if defined(UAPKI_TEST_INTERNAL)
+    return simd_features & simd_test_mask;
+#else
+    return simd_features;
+#endif
+}
+#endif
+
+#if defined(UAPKI_TEST_INTERNAL)
+int ba_simd_set_features(int features)
+{
+#if defined(BA_SIMD_X86) || defined(BA_SIMD_NEON)
+    simd_test_mask = -1;
+    simd_test_mask = features & simd_get_features();
+    return simd_test_mask;
+#else
+    (void)features;
+    return 0;
+#endif
+}
+#endif
+
+size_t ba_simd_base64_encode(const uint8_t* in, size_t inlen, uint8_t* out)
+{
+#if defined(BA_SIMD_X86)
+    const int features = simd_get_features();
+    size_t done = 0;
+    if (features & BA_SIMD_FEATURE_AVX2) {
+        done = b64_encode_avx2(in, inlen, out);
+    }
+    if (features & BA_SIMD_FEATURE_SSSE3) {
+        done += b64_encode_ssse3(in + done, inlen - done, out + done / 3 * 4);
+    }
+    return done;
+#elif defined(BA_SIMD_NEON)
+    return (simd_get_features() & BA_SIMD_FEATURE_NEON) ? b64_encode_neon(in, inlen, out) : 0;
+#else
+    (void)in;
+    (void)inlen;
+    (void)out;
+    return 0;
+#endif
+}
+
+size_t ba_simd_base64_decode(const uint8_t* in, size_t inlen, uint8_t* out, size_t outlen)
+{
+#if defined(BA_SIMD_X86)
+    const int features = simd_get_features();
+    size_t done = 0;
+    if (features & BA_SIMD_FEATURE_AVX2) {
+        done = b64_decode_avx2(in, inlen, out, outlen);
+    }
+    if (features & BA_SIMD_FEATURE_SSSE3) {
+        done += b64_decode_ssse3(in + done, inlen - done, out + done / 4 * 3, outlen - done / 4 * 3);
+    }
+    return done;
+#elif defined(BA_SIMD_NEON)
+    return (simd_get_features() & BA_SIMD_FEATURE_NEON) ? b64_decode_neon(in, inlen, out, outlen) : 0;
+#else
+    (void)in;
+    (void)inlen;
+    (void)out;
+    (void)outlen;
+    return 0;
+#endif
+}
+
+size_t ba_simd_hex_encode(const uint8_t* in, size_t len, char* out)
+{
+#if defined(BA_SIMD_X86)
+    return (simd_get_features() & BA_SIMD_FEATURE_SSSE3) ? hex_encode_ssse3(in, len, (uint8_t*)out) : 0;
+#elif defined(BA_SIMD_NEON)
+    return (simd_get_features() & BA_SIMD_FEATURE_NEON) ? hex_encode_neon(in, len, (uint8_t*)out) : 0;
+#else
+    (void)in;
+    (void)len;
+    (void)out;
+    return 0;
+#endif
+}
+
+size_t ba_simd_hex_decode(const char* hex, size_t hexlen, uint8_t* out)
+{
+#if defined(BA_SIMD_X86)
+    return (simd_get_features() & BA_SIMD_FEATURE_SSSE3) ? hex_decode_ssse3((const uint8_t*)hex, hexlen, out) : 0;
+#elif defined(BA_SIMD_NEON)
+    return (simd_get_features() & BA_SIMD_FEATURE_NEON) ? hex_decode_neon((const uint8_t*)hex, hexlen, out) : 0;
+#else
+    (void)hex;
+    (void)hexlen;
+    (void)out;
+    return 0;
+#endif
+}
@@ -41,7 +41,7 @@ ByteArray *ba_alloc(void)
     ByteArray *ba = NULL;
     int ret = RET_OK;
 
-    MALLOC_CHECKED(ba, sizeof (ByteArray));
+    CALLOC_CHECKED(ba, sizeof (ByteArray));
 
     ba->buf = NULL;
     ba->len = 0;
@@ -56,7 +56,7 @@ ByteArray *ba_alloc_by_len(size_t len)
     ByteArray *ba = NULL;
     int ret = RET_OK;
 
-    MALLOC_CHECKED(ba, sizeof (ByteArray));
+    CALLOC_CHECKED(ba, sizeof (ByteArray));
     MALLOC_CHECKED(ba->buf, len);
 
     ba->len = len;
@@ -72,7 +72,7 @@ ByteArray *ba_alloc_from_uint8(const uint8_t *buf, size_t buf_len)
     int ret = RET_OK;
 
     if (buf != NULL) {
-        MALLOC_CHECKED(ba, sizeof (ByteArray));
+        CALLOC_CHECKED(ba, sizeof (ByteArray));
         if (buf_len != 0) {
             MALLOC_CHECKED(ba->buf, buf_len);
             memcpy(ba->buf, buf, buf_len);
@@ -92,6 +92,28 @@ cleanup:
     return NULL;
 }
 
+ByteArray *ba_alloc_view(const uint8_t *buf, size_t buf_len)
+{
+    ByteArray *ba = NULL;
+    int ret = RET_OK;
+
+    if (buf != NULL) {
+        CALLOC_CHECKED(ba, sizeof (ByteArray));
+        ba->buf = (uint8_t *)buf;
+        ba->len = buf_len;
+        ba->view = true;
+    }
+
+cleanup:
+
+    return ba;
+}
+
+bool ba_is_view(const ByteArray *ba)
+{
+    return (ba != NULL) && ba->view;
+}
+
 ByteArray *ba_alloc_from_str(const char *buf)
 {
     ByteArray *ans = NULL;
@@ -116,7 +138,7 @@ ByteArray *ba_copy_with_alloc(const ByteArray *in, size_t off, size_t len)
             len = in->len - off;
         }
 
-        MALLOC_CHECKED(ba, sizeof (ByteArray));
+        CALLOC_CHECKED(ba, sizeof (ByteArray));
         MALLOC_CHECKED(ba->buf, len);
 
         memcpy(ba->buf, &in->buf[off], len);
@@ -135,6 +157,7 @@ int ba_swap(const ByteArray *a)
     int ret = RET_OK;
 
     CHECK_PARAM(a != NULL);
+    CHECK_PARAM(!a->view);
     DO(uint8_swap(a->buf, a->len, a->buf, a->len));
 
 cleanup:
@@ -148,6 +171,7 @@ int ba_xor(const ByteArray *a, const ByteArray *b)
     size_t i;
 
     CHECK_PARAM(a != NULL);
+    CHECK_PARAM(!a->view);
     CHECK_PARAM(b != NULL);
     CHECK_PARAM(b->len >= a->len);
 
@@ -165,6 +189,7 @@ int ba_set(ByteArray *a, uint8_t value)
     int ret = RET_OK;
 
     CHECK_PARAM(a != NULL);
+    CHECK_PARAM(!a->view);
 
     memset(a->buf, value, a->len);
 
@@ -253,6 +278,7 @@ int ba_set_byte(ByteArray* ba, size_t index, uint8_t value)
     int ret = RET_OK;
 
     CHECK_PARAM(ba != NULL);
+    CHECK_PARAM(!ba->view);
 
     if (index < ba->len) {
         ba->buf[index] = value;
@@ -300,6 +326,7 @@ int ba_copy(const ByteArray *in, size_t in_off, size_t len, ByteArray *out, size
 
     CHECK_PARAM(in != NULL);
     CHECK_PARAM(out != NULL);
+    CHECK_PARAM(!out->view);
 
     if (len == 0) {
         len = in->len - in_off;
@@ -318,6 +345,7 @@ int ba_append(const ByteArray *in, size_t in_off, size_t len, ByteArray *out)
 
     CHECK_PARAM(in != NULL);
     CHECK_PARAM(out != NULL);
+    CHECK_PARAM(!out->view);
 
     if (len == 0) {
         len = in->len - in_off;
@@ -334,7 +362,7 @@ cleanup:
 
 void ba_free(ByteArray *ba)
 {
-    if (ba) {
+    if (ba && !ba->view) {
         free(ba->buf);
     }
     free(ba);
@@ -344,7 +372,7 @@ void ba_free(ByteArray *ba)
 int ba_change_len(ByteArray *ba, size_t len)
 {
     int ret = RET_OK;
-    if (ba == NULL) {
+    if ((ba == NULL) || ba->view) {
         SET_ERROR(RET_INVALID_PARAM);
     }
 
@@ -362,7 +390,7 @@ cleanup:
 
 void ba_free_private(ByteArray *ba)
 {
-    if (ba) {
+    if (ba && !ba->view) {
         secure_zero(ba->buf, ba->len);
         free(ba->buf);
     }
@@ -404,9 +432,11 @@ static int base64_encode(const uint8_t* in, size_t inlen, uint8_t* out, size_t*
         return RET_DATA_TOO_LONG;
     }
 
-    p = out;
+    i = ba_simd_base64_encode(in, inlen, out);
+    p = out + i / 3 * 4;
+    in += i;
     leven = 3 * (inlen / 3);
-    for (i = 0; i < leven; i += 3) {
+    for (; i < leven; i += 3) {
         *p++ = codes[(in[0] >> 2) & 0x3F];
         *p++ = codes[(((in[0] & 3) << 4) + (in[1] >> 4)) & 0x3F];
         *p++ = codes[(((in[1] & 0xf) << 2) + (in[2] >> 6)) & 0x3F];
@@ -493,12 +523,19 @@ static int base64_decode(const uint8_t* in, size_t inlen, uint8_t* out, size_t*
     255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
     255, 255, 255, 255 };
 
-    size_t t, x, y, z;
+    size_t n, t, x, y, z;
     uint8_t c;
     int g;
 
     g = 3;
     for (x = y = z = t = 0; x < inlen; x++) {
+        if ((y == 0) && (g == 3) && (inlen - x >= 16)) {
+            //  Whole quads of the alphabet (no padding and separators)
+            n = ba_simd_base64_decode(in + x, inlen - x, out + z, *outlen - z);
+            x += n;
+            z += n / 4 * 3;
+            if (x == inlen) break;
+        }
         c = base64map[in[x] & 0xFF];
         if (c == 255) continue;
 
@@ -532,15 +569,26 @@ static int base64_decode(const uint8_t* in, size_t inlen, uint8_t* out, size_t*
     return RET_OK;
 }
 
+//  Exact size for canonical input, an upper bound if input contains separators
+static size_t base64_decoded_len(const char* str, size_t str_len)
+{
+    size_t len = (str_len / 4) * 3 + ((str_len % 4) * 3) / 4;
+    if ((str_len % 4 == 0) && (str_len > 0) && (str[str_len - 1] == '=')) {
+        len -= (str[str_len - 2] == '=') ? 2 : 1;
+    }
+    return len;
+}
+
 ByteArray* ba_alloc_from_base64(const char* str)
 {
     int ret = RET_OK;
     ByteArray* ba = NULL;
-    size_t len = (strlen(str) * 3) / 4;
+    const size_t str_len = strlen(str);
+    size_t len = base64_decoded_len(str, str_len);
 
     CHECK_NOT_NULL(ba = ba_alloc_by_len(len));
-    DO(base64_decode((const uint8_t*)str, strlen(str), ba->buf, &len));
-    if (len > 0) {
+    DO(base64_decode((const uint8_t*)str, str_len, ba->buf, &len));
+    if ((len > 0) && (len != ba->len)) {
         DO(ba_change_len(ba, len));
     }
 
@@ -555,17 +603,21 @@ cleanup:
 int ba_from_base64(const char* str, ByteArray* ba)
 {
     int ret = RET_OK;
-    size_t len;
+    size_t len, str_len;
 
     CHECK_PARAM(str != NULL);
     CHECK_PARAM(ba != NULL);
+    CHECK_PARAM(!ba->view);
 
-    len = (strlen(str) * 3) / 4;
+    str_len = strlen(str);
+    len = base64_decoded_len(str, str_len);
 
     REALLOC_CHECKED(ba->buf, len, ba->buf);
     ba->len = len;
-    DO(base64_decode((const uint8_t*)str, strlen(str), ba->buf, &len));
-    DO(ba_change_len(ba, len));
+    DO(base64_decode((const uint8_t*)str, str_len, ba->buf, &len));
+    if (len != ba->len) {
+        DO(ba_change_len(ba, len));
+    }
 
 cleanup:
 
@@ -579,6 +631,7 @@ int ba_from_uint8(const uint8_t* buf, size_t buf_len, ByteArray* ba)
     CHECK_PARAM(buf != NULL);
     CHECK_PARAM(buf_len != 0);
     CHECK_PARAM(ba != NULL);
+    CHECK_PARAM(!ba->view);
 
     REALLOC_CHECKED(ba->buf, buf_len, ba->buf);
 
@@ -633,7 +686,7 @@ static int uint8_from_hex(const char* hex, size_t hexlen, uint8_t* buf)
 
     len = hexlen / 2;
 
-    for (i = 0; i < len; i++) {
+    for (i = ba_simd_hex_decode(hex, hexlen, buf) / 2; i < len; i++) {
         val = (hexmap[(uint8_t)hex[i * 2]] << 4) | hexmap[(uint8_t)hex[i * 2 + 1]];
         if (val > 0xFF) {
             SET_ERROR(RET_INVALID_HEX_STRING);
@@ -674,6 +727,7 @@ int ba_from_hex(const char* hex, ByteArray* ba)
 
     CHECK_PARAM(hex != NULL);
     CHECK_PARAM(ba != NULL);
+    CHECK_PARAM(!ba->view);
 
     len = strlen(hex);
     if ((len & 1) != 0) {
@@ -707,7 +761,7 @@ int ba_to_hex_with_alloc(const ByteArray* ba, char** buf)
         SET_ERROR(RET_MEMORY_ALLOC_ERROR);
     }
 
-    for (i = 0; i < len; i++) {
+    for (i = ba_simd_hex_encode(bin, len, *buf); i < len; i++) {
         (*buf)[i * 2] = hex_symbols[bin[i] >> 4];
         (*buf)[i * 2 + 1] = hex_symbols[bin[i] & 0x0F];
     }
@@ -735,7 +789,7 @@ int ba_to_hex(const ByteArray* ba, char* buf, size_t *buf_len)
         SET_ERROR(RET_DATA_TOO_LONG);
     }
 
-    for (i = 0; i < len; i++) {
+    for (i = ba_simd_hex_encode(bin, len, buf); i < len; i++) {
         buf[i * 2] = hex_symbols[bin[i] >> 4];
         buf[i * 2 + 1] = hex_symbols[bin[i] & 0x0F];
     }
@@ -35,6 +35,7 @@
 #include "byte-array-internal.h"
 #include "drbg.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 
 #define DES_BLOCK_LEN 8
 
@@ -2324,6 +2325,8 @@ DesCtx *des_alloc(void)
     DesCtx *ctx = NULL;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_3DES));
+
     CALLOC_CHECKED(ctx, sizeof(DesCtx));
 
 cleanup:
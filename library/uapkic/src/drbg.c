@@ -27,6 +27,7 @@
 
 #define FILE_MARKER "uapkic/drbg.c"
 
+#include <stdlib.h>
 #include <string.h>
 #include "drbg.h"
 #include "pthread-internal.h"
@@ -35,128 +36,235 @@
 #include "byte-array-internal.h"
 
 #include "hmac.h"
+#include "byte-utils-internal.h"
 
-static ByteArray *drbg_Key = NULL;
-static ByteArray *drbg_V = NULL;
-static size_t drbg_reseed_counter = 0;
+#define DRBG_RESEED_INTERVAL        1000000
+#define DRBG_THREAD_SEED_LEN        64
+#define DRBG_THREAD_OS_ENTROPY_LEN  32
+
+#define DRBG_KEY_NOT_CREATED        0
+#define DRBG_KEY_READY              1
+#define DRBG_KEY_FAILED             2   //  Thread-local storage is unavailable, the global instance is used
+#define DRBG_KEY_DELETED            3   //  Library is unloaded
+
+typedef struct DrbgState_st {
+	ByteArray* Key;
+	ByteArray* V;
+	size_t reseed_counter;
+	HmacCtx* hmac_ctx;
+	uint32_t generation;
+} DrbgState;
+
+/*
+ * Глобальний екземпляр ініціалізується ентропією (entropy_get) і захищений drbg_mutex.
+ * Кожен потік має власний екземпляр, який отримує seed від глобального,
+ * тому генерація випадкових даних у різних потоках не конкурує за м'ютекс.
+ */
+static DrbgState drbg_global = { NULL, NULL, 0, NULL, 0 };
 static bool drbg_prediction_resistance = false;
-static HmacCtx* drbg_hmac_ctx = NULL;
 static pthread_mutex_t drbg_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+//  Incremented after fork() in the child and after drbg_reseed(): thread instances reseed.
+//  It is read without drbg_mutex, so it is accessed by atomic_*() only
+static volatile uint32_t drbg_generation = 0;
+//  Incremented after fork() in the child: the global instance reseeds from entropy source
+static volatile uint32_t drbg_fork_generation = 0;
+
+static pthread_key_t drbg_thread_key;
+static volatile uint32_t drbg_thread_key_state = DRBG_KEY_NOT_CREATED;
+static uint64_t drbg_thread_nonce = 0;
+
 static const uint8_t _separator0 = 0x00;
 static const uint8_t _separator1 = 0x01;
 
-static const ByteArray separator0 = { (uint8_t*)&_separator0, sizeof(_separator0) };
-static const ByteArray separator1 = { (uint8_t*)&_separator1, sizeof(_separator1) };
+static const ByteArray separator0 = { (uint8_t*)&_separator0, sizeof(_separator0), false };
+static const ByteArray separator1 = { (uint8_t*)&_separator1, sizeof(_separator1), false };
 
-static void drbg_free_internal(void)
+static void drbg_free_internal(DrbgState* st)
 {
-	hmac_free(drbg_hmac_ctx);
-	drbg_hmac_ctx = NULL;
-	ba_free(drbg_Key);
-	drbg_Key = NULL;
-	ba_free(drbg_V);
-	drbg_V = NULL;
-	drbg_reseed_counter = 0;
+	hmac_free(st->hmac_ctx);
+	st->hmac_ctx = NULL;
+	ba_free_private(st->Key);
+	st->Key = NULL;
+	ba_free_private(st->V);
+	st->V = NULL;
+	st->reseed_counter = 0;
 }
 
-static int drbg_update(const ByteArray *provided_data)
+static int drbg_update(DrbgState* st, const ByteArray *provided_data)
 {
 	int ret = RET_OK;
 	ByteArray* tmp = NULL;
 	
-	DO(hmac_init(drbg_hmac_ctx, drbg_Key));
-	DO(hmac_update(drbg_hmac_ctx, drbg_V));
-	DO(hmac_update(drbg_hmac_ctx, &separator0));
+	DO(hmac_init(st->hmac_ctx, st->Key));
+	DO(hmac_update(st->hmac_ctx, st->V));
+	DO(hmac_update(st->hmac_ctx, &separator0));
 
 	if (provided_data != NULL) {
-		DO(hmac_update(drbg_hmac_ctx, provided_data));
+		DO(hmac_update(st->hmac_ctx, provided_data));
 	}
 
-	DO(hmac_final(drbg_hmac_ctx, &tmp));
-	ba_free_private(drbg_Key);
-	drbg_Key = tmp;
+	DO(hmac_final(st->hmac_ctx, &tmp));
+	ba_free_private(st->Key);
+	st->Key = tmp;
 	tmp = NULL;
 
-	DO(hmac_init(drbg_hmac_ctx, drbg_Key));
-	DO(hmac_update(drbg_hmac_ctx, drbg_V));
-	DO(hmac_final(drbg_hmac_ctx, &tmp));
-	ba_free_private(drbg_V);
-	drbg_V = tmp;
+	DO(hmac_init(st->hmac_ctx, st->Key));
+	DO(hmac_update(st->hmac_ctx, st->V));
+	DO(hmac_final(st->hmac_ctx, &tmp));
+	ba_free_private(st->V);
+	st->V = tmp;
 	tmp = NULL;
 
 	if (provided_data == NULL) {
 		goto cleanup;
 	}
 
-	DO(hmac_init(drbg_hmac_ctx, drbg_Key));
-	DO(hmac_update(drbg_hmac_ctx, drbg_V));
-	DO(hmac_update(drbg_hmac_ctx, &separator1));
-	DO(hmac_update(drbg_hmac_ctx, provided_data));
+	DO(hmac_init(st->hmac_ctx, st->Key));
+	DO(hmac_update(st->hmac_ctx, st->V));
+	DO(hmac_update(st->hmac_ctx, &separator1));
+	DO(hmac_update(st->hmac_ctx, provided_data));
 
-	DO(hmac_final(drbg_hmac_ctx, &tmp));
-	ba_free_private(drbg_Key);
-	drbg_Key = tmp;
+	DO(hmac_final(st->hmac_ctx, &tmp));
+	ba_free_private(st->Key);
+	st->Key = tmp;
 	tmp = NULL;
 
-	DO(hmac_init(drbg_hmac_ctx, drbg_Key));
-	DO(hmac_update(drbg_hmac_ctx, drbg_V));
-	DO(hmac_final(drbg_hmac_ctx, &tmp));
-	ba_free_private(drbg_V);
-	drbg_V = tmp;
+	DO(hmac_init(st->hmac_ctx, st->Key));
+	DO(hmac_update(st->hmac_ctx, st->V));
+	DO(hmac_final(st->hmac_ctx, &tmp));
+	ba_free_private(st->V);
+	st->V = tmp;
 	tmp = NULL;
 
 cleanup:
 	return ret;
 }
 
-static int drbg_init_internal(const ByteArray *entropy)
+static int drbg_init_internal(DrbgState* st, const ByteArray *entropy)
 {
 	int ret = RET_OK;
 
-	CHECK_NOT_NULL(drbg_hmac_ctx = hmac_alloc(HASH_ALG_SHA512));
-	CHECK_NOT_NULL(drbg_Key = ba_alloc_by_len(64));
-	CHECK_NOT_NULL(drbg_V = ba_alloc_by_len(64));
+	CHECK_NOT_NULL(st->hmac_ctx = hmac_alloc(HASH_ALG_SHA512));
+	CHECK_NOT_NULL(st->Key = ba_alloc_by_len(64));
+	CHECK_NOT_NULL(st->V = ba_alloc_by_len(64));
 
-	memset(drbg_Key->buf, 0x00, drbg_Key->len);
-	memset(drbg_V->buf, 0x01, drbg_V->len);
+	memset(st->Key->buf, 0x00, st->Key->len);
+	memset(st->V->buf, 0x01, st->V->len);
 
-	DO(drbg_update(entropy));
-	drbg_reseed_counter = 1;
+	DO(drbg_update(st, entropy));
+	st->reseed_counter = 1;
 
 cleanup:
 	if (ret != 0) {
-		drbg_free_internal();
+		drbg_free_internal(st);
 	}
 	return ret;
 }
 
-int drbg_init(void)
+static bool drbg_is_initialized(const DrbgState* st)
+{
+	return (st->Key != NULL) && (st->V != NULL) && (st->hmac_ctx != NULL);
+}
+
+static int drbg_init_global(void)
 {
 	int ret = RET_OK;
 	ByteArray *entropy = NULL;
 
 	DO(entropy_get(&entropy));
 
-	DO(drbg_init_internal(entropy));
+	DO(drbg_init_internal(&drbg_global, entropy));
+	drbg_global.generation = drbg_fork_generation;
 
 cleanup:
 	ba_free_private(entropy);
 	return ret;
 }
 
-static int drbg_reseed_internal(const ByteArray* seed_material)
+static int drbg_reseed_internal(DrbgState* st, const ByteArray* seed_material)
 {
 	int ret = RET_OK;
 
-	DO(drbg_update(seed_material));
+	DO(drbg_update(st, seed_material));
 
-	drbg_reseed_counter = 1;
+	st->reseed_counter = 1;
 
 cleanup:
 	return ret;
 }
 
+static int drbg_random_internal(DrbgState* st, ByteArray* random)
+{
+	int ret = RET_OK;
+	uint8_t* bufptr = random->buf;
+	size_t current_len, outlen = random->len;
+	ByteArray* tmp = NULL;
+
+	if (outlen > (1 << 19)) {
+		return -1;
+	}
+
+	if ((st->reseed_counter > DRBG_RESEED_INTERVAL) || drbg_prediction_resistance) {
+		DO(drbg_reseed_internal(st, NULL));
+	}
+
+	st->reseed_counter++;
+
+	while (outlen > 0) {
+		DO(hmac_init(st->hmac_ctx, st->Key));
+		DO(hmac_update(st->hmac_ctx, st->V));
+		DO(hmac_final(st->hmac_ctx, &tmp));
+		ba_free_private(st->V);
+		st->V = tmp;
+		tmp = NULL;
+
+		current_len = (st->V->len > outlen) ? outlen : st->V->len;
+		memcpy(bufptr, st->V->buf, current_len);
+
+		bufptr += current_len;
+		outlen -= current_len;
+	}
+
+	DO(drbg_update(st, NULL));
+
+cleanup:
+	return ret;
+}
+
+//  Must be called under drbg_mutex
+static int drbg_global_prepare(void)
+{
+	int ret = RET_OK;
+	ByteArray* entropy = NULL;
+
+	if (!drbg_is_initialized(&drbg_global)) {
+		DO(drbg_init_global());
+	}
+	else if (drbg_global.generation != drbg_fork_generation) {
+		//  The state was inherited from the parent process
+		DO(entropy_get(&entropy));
+		DO(drbg_reseed_internal(&drbg_global, entropy));
+		drbg_global.generation = drbg_fork_generation;
+	}
+
+cleanup:
+	ba_free_private(entropy);
+	return ret;
+}
+
+int drbg_init(void)
+{
+	int ret = RET_OK;
+
+	pthread_mutex_lock(&drbg_mutex);
+	DO(drbg_global_prepare());
+
+cleanup:
+	pthread_mutex_unlock(&drbg_mutex);
+	return ret;
+}
+
 int drbg_reseed(const ByteArray* additional_input)
 {
 	int ret = RET_OK;
@@ -165,21 +273,22 @@ int drbg_reseed(const ByteArray* additional_input)
 
 	pthread_mutex_lock(&drbg_mutex);
 
-	if (drbg_Key == NULL || drbg_V == NULL || drbg_hmac_ctx == NULL) {
-		DO(drbg_init());
-	}
+	DO(drbg_global_prepare());
 
 	DO(entropy_get(&entropy));
 
 	if (additional_input != NULL) {
 		CHECK_NOT_NULL(seed_material = ba_join(entropy, additional_input));
-		DO(drbg_reseed_internal(seed_material));
+		DO(drbg_reseed_internal(&drbg_global, seed_material));
 	}
 	else {
-		DO(drbg_reseed_internal(entropy));
+		DO(drbg_reseed_internal(&drbg_global, entropy));
 	}
 
-	DO(drbg_reseed_internal(additional_input));
+	DO(drbg_reseed_internal(&drbg_global, additional_input));
+
+	//  Thread instances take the new seed on their next request
+	atomic_inc_u32(&drbg_generation);
 
 cleanup:
 	pthread_mutex_unlock(&drbg_mutex);
@@ -188,54 +297,185 @@ cleanup:
 	return ret;
 }
 
-static int drbg_random_internal(ByteArray* random)
+static void drbg_thread_state_free(void* data)
 {
-	int ret = RET_OK;
-	uint8_t* bufptr = random->buf;
-	size_t current_len, outlen = random->len;
-	ByteArray* tmp = NULL;
+	DrbgState* st = (DrbgState*)data;
 
-	if (outlen > (1 << 19)) {
-		return -1;
+	if (st) {
+		drbg_free_internal(st);
+		free(st);
 	}
-	
-	if (drbg_Key == NULL || drbg_V == NULL || drbg_hmac_ctx == NULL) {
-		DO(drbg_init());
+}
+
+#ifndef _WIN32
+static void drbg_atfork_prepare(void)
+{
+	pthread_mutex_lock(&drbg_mutex);
+}
+
+static void drbg_atfork_parent(void)
+{
+	pthread_mutex_unlock(&drbg_mutex);
+}
+
+static void drbg_atfork_child(void)
+{
+	drbg_fork_generation++;
+	atomic_inc_u32(&drbg_generation);
+	pthread_mutex_unlock(&drbg_mutex);
+}
+#endif
+
+//  Called at exit of process or at unload of library: thread instances of other threads are freed
+//  by key destructor (Windows) or left as is (POSIX), new requests use the global instance
+static void drbg_thread_key_delete(void)
+{
+	pthread_mutex_lock(&drbg_mutex);
+	if (atomic_load_u32(&drbg_thread_key_state) == DRBG_KEY_READY) {
+		DrbgState* st = (DrbgState*)pthread_getspecific(drbg_thread_key);
+		if (st) {
+			(void)pthread_setspecific(drbg_thread_key, NULL);
+			drbg_thread_state_free(st);
+		}
+		atomic_store_u32(&drbg_thread_key_state, DRBG_KEY_DELETED);
+		(void)pthread_key_delete(drbg_thread_key);
 	}
+	pthread_mutex_unlock(&drbg_mutex);
+}
 
-	if ((drbg_reseed_counter > 1000000) || drbg_prediction_resistance) {
-		DO(drbg_reseed_internal(NULL));
+static bool drbg_thread_key_ready(void)
+{
+	uint32_t state = atomic_load_u32(&drbg_thread_key_state);
+
+	if (state == DRBG_KEY_NOT_CREATED) {
+		pthread_mutex_lock(&drbg_mutex);
+		state = atomic_load_u32(&drbg_thread_key_state);
+		if (state == DRBG_KEY_NOT_CREATED) {
+			state = DRBG_KEY_FAILED;
+			if (pthread_key_create(&drbg_thread_key, drbg_thread_state_free) == 0) {
+				//  atexit() of shared library is called at its unload too
+				if (atexit(drbg_thread_key_delete) == 0) {
+#ifndef _WIN32
+					pthread_atfork(drbg_atfork_prepare, drbg_atfork_parent, drbg_atfork_child);
+#endif
+					state = DRBG_KEY_READY;
+				}
+				else {
+					(void)pthread_key_delete(drbg_thread_key);
+				}
+			}
+			atomic_store_u32(&drbg_thread_key_state, state);
+		}
+		pthread_mutex_unlock(&drbg_mutex);
 	}
 
-	drbg_reseed_counter++;
+	return (state == DRBG_KEY_READY);
+}
 
-	while (outlen > 0) {
-		DO(hmac_init(drbg_hmac_ctx, drbg_Key));
-		DO(hmac_update(drbg_hmac_ctx, drbg_V));
-		DO(hmac_final(drbg_hmac_ctx, &tmp));
-		ba_free_private(drbg_V);
-		drbg_V = tmp;
-		tmp = NULL;
+/*
+ * (Пере)ініціалізує екземпляр потоку: entropy input - вихід глобального ГПВЧ
+ * та системного ГПВЧ, nonce - ідентифікатор потоку та лічильник.
+ */
+static int drbg_thread_seed(DrbgState* st)
+{
+	int ret = RET_OK;
+	ByteArray* seed = NULL;
+	ByteArray* os_entropy = NULL;
+	ByteArray* seed_material = NULL;
+	uint8_t nonce[16];
+	uint64_t thread_id = (uint64_t)pthread_id();
+	uint64_t counter;
+	uint32_t generation;
 
-		current_len = (drbg_V->len > outlen) ? outlen : drbg_V->len;
-		memcpy(bufptr, drbg_V->buf, current_len);
+	CHECK_NOT_NULL(seed = ba_alloc_by_len(DRBG_THREAD_SEED_LEN + sizeof(nonce)));
+	CHECK_NOT_NULL(os_entropy = ba_alloc_by_len(DRBG_THREAD_OS_ENTROPY_LEN));
 
-		bufptr += current_len;
-		outlen -= current_len;
+	pthread_mutex_lock(&drbg_mutex);
+	ret = drbg_global_prepare();
+	if (ret == RET_OK) {
+		seed->len = DRBG_THREAD_SEED_LEN;
+		ret = drbg_random_internal(&drbg_global, seed);
+		seed->len = DRBG_THREAD_SEED_LEN + sizeof(nonce);
 	}
+	counter = ++drbg_thread_nonce;
+	generation = atomic_load_u32(&drbg_generation);
+	pthread_mutex_unlock(&drbg_mutex);
+	DO(ret);
 
-	DO(drbg_update(NULL));
+	memcpy(nonce, &thread_id, sizeof(thread_id));
+	memcpy(nonce + sizeof(thread_id), &counter, sizeof(counter));
+	memcpy(seed->buf + DRBG_THREAD_SEED_LEN, nonce, sizeof(nonce));
+
+	DO(entropy_std(os_entropy));
+	CHECK_NOT_NULL(seed_material = ba_join(seed, os_entropy));
+
+	if (drbg_is_initialized(st)) {
+		DO(drbg_reseed_internal(st, seed_material));
+	}
+	else {
+		DO(drbg_init_internal(st, seed_material));
+	}
+	st->generation = generation;
 
 cleanup:
+	secure_zero(nonce, sizeof(nonce));
+	ba_free_private(seed);
+	ba_free_private(os_entropy);
+	ba_free_private(seed_material);
 	return ret;
 }
- 
+
+static DrbgState* drbg_thread_state(void)
+{
+	DrbgState* st;
+
+	if (!drbg_thread_key_ready()) {
+		return NULL;
+	}
+
+	st = (DrbgState*)pthread_getspecific(drbg_thread_key);
+	if (st == NULL) {
+		st = (DrbgState*)calloc(1, sizeof(DrbgState));
+		if (st == NULL) {
+			return NULL;
+		}
+		if (pthread_setspecific(drbg_thread_key, st) != 0) {
+			free(st);
+			return NULL;
+		}
+	}
+
+	return st;
+}
+
 int drbg_random(ByteArray* random)
 {
-	int ret;
-	pthread_mutex_lock(&drbg_mutex);
-	ret = drbg_random_internal(random);
-	pthread_mutex_unlock(&drbg_mutex);
+	int ret = RET_OK;
+	DrbgState* st;
+
+	CHECK_PARAM(random != NULL);
+
+	st = drbg_thread_state();
+	if (st == NULL) {
+		//  Thread-local storage is unavailable, use the global instance
+		pthread_mutex_lock(&drbg_mutex);
+		ret = drbg_global_prepare();
+		if (ret == RET_OK) {
+			ret = drbg_random_internal(&drbg_global, random);
+		}
+		pthread_mutex_unlock(&drbg_mutex);
+		goto cleanup;
+	}
+
+	if (!drbg_is_initialized(st) ||
+		(st->generation != atomic_load_u32(&drbg_generation)) ||
+		(st->reseed_counter > DRBG_RESEED_INTERVAL)) {
+		DO(drbg_thread_seed(st));
+	}
+
+	DO(drbg_random_internal(st, random));
+
+cleanup:
 	return ret;
 }
 
@@ -272,32 +512,39 @@ int drbg_self_test(void)
 		0x2D, 0x22, 0x14, 0x7B, 0x0A, 0x17, 0x6E, 0xA8, 0xD9, 0xC4, 0xC3, 0x54, 0x04, 0x39, 0x5B, 0x65,
 		0x02, 0xEF, 0x33, 0x3A, 0x81, 0x3B, 0x65, 0x86, 0x03, 0x74, 0x79, 0xE0, 0xFA, 0x3C, 0x6A, 0x23 };
 
-	static const ByteArray ba_test_drbg_init_entropy = { (uint8_t*)&test_drbg_init_entropy, sizeof(test_drbg_init_entropy) };
-	static const ByteArray ba_test_reseed_entropy = { (uint8_t*)&test_drbg_reseed_entropy, sizeof(test_drbg_reseed_entropy) };
+	static const ByteArray ba_test_drbg_init_entropy = { (uint8_t*)&test_drbg_init_entropy, sizeof(test_drbg_init_entropy), false };
+	static const ByteArray ba_test_reseed_entropy = { (uint8_t*)&test_drbg_reseed_entropy, sizeof(test_drbg_reseed_entropy), false };
 
 	int ret = RET_OK;
+	DrbgState test_state = { NULL, NULL, 0, NULL, 0 };
 	ByteArray *test_drbg_out = NULL;
-	
-	if (drbg_Key || drbg_V || drbg_hmac_ctx) {
-		return RET_SELF_TEST_NOT_ALLOWED;
-	}
-
-	pthread_mutex_lock(&drbg_mutex);
+	ByteArray *thread_out1 = NULL;
+	ByteArray *thread_out2 = NULL;
 
-	DO(drbg_init_internal(&ba_test_drbg_init_entropy));
-	DO(drbg_reseed_internal(&ba_test_reseed_entropy));
+	DO(drbg_init_internal(&test_state, &ba_test_drbg_init_entropy));
+	DO(drbg_reseed_internal(&test_state, &ba_test_reseed_entropy));
 
 	CHECK_NOT_NULL(test_drbg_out = ba_alloc_by_len(sizeof(test_drbg_expected_bits)));
 
-	DO(drbg_random_internal(test_drbg_out));
-	DO(drbg_random_internal(test_drbg_out));
+	DO(drbg_random_internal(&test_state, test_drbg_out));
+	DO(drbg_random_internal(&test_state, test_drbg_out));
 	if (memcmp(test_drbg_out->buf, test_drbg_expected_bits, sizeof(test_drbg_expected_bits)) != 0) {
 		SET_ERROR(RET_SELF_TEST_FAIL);
 	}
 
+	//  The thread instance must produce distinct outputs
+	CHECK_NOT_NULL(thread_out1 = ba_alloc_by_len(64));
+	CHECK_NOT_NULL(thread_out2 = ba_alloc_by_len(64));
+	DO(drbg_random(thread_out1));
+	DO(drbg_random(thread_out2));
+	if (memcmp(thread_out1->buf, thread_out2->buf, thread_out1->len) == 0) {
+		SET_ERROR(RET_SELF_TEST_FAIL);
+	}
+
 cleanup:
-	drbg_free_internal();
-	pthread_mutex_unlock(&drbg_mutex);
+	drbg_free_internal(&test_state);
 	ba_free(test_drbg_out);
+	ba_free_private(thread_out1);
+	ba_free_private(thread_out2);
 	return ret;
 }
@@ -36,6 +36,7 @@
 #include "ec-cache-internal.h"
 #include "math-int-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 
 int dstu4145_generate_privkey(const EcCtx *ctx, ByteArray **d)
 {
@@ -277,6 +278,8 @@ int dstu4145_sign(const EcCtx *ctx, const ByteArray *H, ByteArray **r, ByteArray
     WordArray *e = NULL;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_DSTU4145));
+
     CHECK_PARAM(ctx != NULL);
     CHECK_PARAM(H != NULL);
     CHECK_PARAM((H->len == 32) || (H->len == 48) || (H->len == 64));
@@ -313,6 +316,8 @@ int dstu4145_verify(const EcCtx *ctx, const ByteArray *H, const ByteArray *r, co
     size_t n_bit_len;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_DSTU4145));
+
     CHECK_PARAM(ctx != NULL);
     CHECK_PARAM(H != NULL);
     CHECK_PARAM((H->len == 32) || (H->len == 48) || (H->len == 64));
@@ -438,8 +443,8 @@ int dstu4145_self_test(void)
         0xCA, 0x5A, 0x61, 0xB3, 0x32, 0xA3, 0xD6, 0x5B, 0x0F, 0x23, 0x8C, 0x8E, 0x2B, 0x83, 0x31, 0x73, 
         0x95, 0x86, 0x0D, 0x10, 0x02 };
 
-    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d) };
-    static const ByteArray ba_H = { (uint8_t*)test_H, sizeof(test_H) };
+    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d), false };
+    static const ByteArray ba_H = { (uint8_t*)test_H, sizeof(test_H), false };
 
     int ret = RET_OK;
     EcCtx* ec_ctx = NULL;
@@ -35,6 +35,7 @@
 #include "byte-utils-internal.h"
 #include "byte-array-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 
 #define UINT64_LEN 8
 #define ROWS 8
@@ -574,6 +575,8 @@ Dstu7564Ctx *dstu7564_alloc(void)
     Dstu7564Ctx *ctx = NULL;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_DSTU7564));
+
     CALLOC_CHECKED(ctx, sizeof(Dstu7564Ctx));
 
     ctx->is_inited = false;
@@ -921,7 +924,7 @@ static int dstu7564_self_test_hash(void)
         0x11, 0xEB, 0x18, 0x7D, 0x71, 0x5A, 0x95, 0x6B, 0x10, 0x7E, 0x3B, 0xFC, 0x76, 0x48, 0x22, 0x98,
         0x13, 0x3A, 0x9C, 0xE8, 0xCB, 0xC0, 0xBD, 0x5E, 0x14, 0x36, 0xA5, 0xB1, 0x97, 0x28, 0x4F, 0x7E };
 
-    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) };
+    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1), false };
     
     int ret = RET_OK;
     Dstu7564Ctx* ctx = NULL;
@@ -1087,10 +1090,10 @@ static int dstu7564_self_test_kmac(void)
         0x00, 0x57, 0x9F, 0x26, 0x9C, 0xEC, 0x24, 0xE3, 0x47, 0xA9, 0xD8, 0x64, 0x61, 0x4C, 0xF3, 0xAB, 
         0xBF, 0x66, 0x10, 0x74, 0x2E, 0x4D, 0xB3, 0xBD, 0x2A, 0xBC, 0x00, 0x03, 0x87, 0xC4, 0x9D, 0x24 };
 
-    static const ByteArray ba_M = { (uint8_t*)M, sizeof(M) };
-    static const ByteArray ba_K256 = { (uint8_t*)K256, sizeof(K256) };
-    static const ByteArray ba_K384 = { (uint8_t*)K384, sizeof(K384) };
-    static const ByteArray ba_K512 = { (uint8_t*)K512, sizeof(K512) };
+    static const ByteArray ba_M = { (uint8_t*)M, sizeof(M), false };
+    static const ByteArray ba_K256 = { (uint8_t*)K256, sizeof(K256), false };
+    static const ByteArray ba_K384 = { (uint8_t*)K384, sizeof(K384), false };
+    static const ByteArray ba_K512 = { (uint8_t*)K512, sizeof(K512), false };
 
     int ret = RET_OK;
     Dstu7564Ctx* ctx = NULL;
@@ -38,6 +38,7 @@
 #include "byte-array-internal.h"
 #include "math-gf2m-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 
 #define REDUCTION_POLYNOMIAL 0x11d  /* x^8 + x^4 + x^3 + x^2 + 1 */
 #define ROWS 8
@@ -1386,6 +1387,8 @@ Dstu7624Ctx *dstu7624_alloc(Dstu7624SboxId sbox_id)
     int ret = RET_OK;
     Dstu7624Ctx *ctx = NULL;
 
+    DO(self_test_require(SELF_TEST_ID_DSTU7624));
+
     CALLOC_CHECKED(ctx, sizeof(Dstu7624Ctx));
 
     switch (sbox_id) {
@@ -1431,6 +1434,8 @@ Dstu7624Ctx *dstu7624_alloc_user_sbox(ByteArray *sblocks)
     size_t sblock_len;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_DSTU7624));
+
     CHECK_PARAM(sblocks != NULL);
     DO(ba_to_uint8_with_alloc(sblocks, &sblocks_buf, &sblock_len));
 
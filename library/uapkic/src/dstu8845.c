@@ -35,6 +35,7 @@
 #include "byte-utils-internal.h"
 #include "byte-array-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 
 #define byte(n,w)   (((w)>>(n*8)) & 0xff)
 #define ainv_mul(w) (((w)>>8)^(invmul_T[w&0xff]))
@@ -720,119 +721,77 @@ struct Dstu8845Ctx_st {
     size_t gamma_cntr;
 };
 
-static void next_gamma(Dstu8845Ctx *ctx)
+#define KS_STEP(i0, i1, i11, i13)                                       \
+    st[i0] = a_mul(st[i0]) ^ st[i13] ^ ainv_mul(st[i11]);               \
+    tmp = r1 + st[i13];                                                 \
+    r1 = T(r0);                                                         \
+    r0 = tmp;                                                           \
+    ks[i0] = (r0 + st[i0]) ^ r1 ^ st[i1]
+
+/*
+ * Виробляє 16 слів гами за одну ітерацію. Стан регістра зсуву і скінченного
+ * автомата копіюється у локальні змінні, щоб компілятор тримав його у регістрах.
+ */
+static void keystream_block(Dstu8845Ctx *ctx, uint64_t *ks)
 {
+    uint64_t st[16];
+    uint64_t r0 = ctx->r[0];
+    uint64_t r1 = ctx->r[1];
     uint64_t tmp;
 
-    ctx->st[0] = a_mul(ctx->st[0]) ^ ctx->st[13] ^ ainv_mul(ctx->st[11]);
-    tmp = ctx->r[1] + ctx->st[13];
-    ctx->r[1] = T(ctx->r[0]);
-    ctx->r[0] = tmp;
-    ctx->gamma[0] = (ctx->r[0] + ctx->st[0]) ^ ctx->r[1] ^ ctx->st[1];
-
-    ctx->st[1] = a_mul(ctx->st[1]) ^ ctx->st[14] ^ ainv_mul(ctx->st[12]);
-    tmp = ctx->r[1] + ctx->st[14];
-    ctx->r[1] = T(ctx->r[0]);
-    ctx->r[0] = tmp;
-    ctx->gamma[1] = (ctx->r[0] + ctx->st[1]) ^ ctx->r[1] ^ ctx->st[2];
-
-    ctx->st[2] = a_mul(ctx->st[2]) ^ ctx->st[15] ^ ainv_mul(ctx->st[13]);
-    tmp = ctx->r[1] + ctx->st[15];
-    ctx->r[1] = T(ctx->r[0]);
-    ctx->r[0] = tmp;
-    ctx->gamma[2] = (ctx->r[0] + ctx->st[2]) ^ ctx->r[1] ^ ctx->st[3];
-
-    ctx->st[3] = a_mul(ctx->st[3]) ^ ctx->st[0] ^ ainv_mul(ctx->st[14]);
-    tmp = ctx->r[1] + ctx->st[0];
-    ctx->r[1] = T(ctx->r[0]);
-    ctx->r[0] = tmp;
-    ctx->gamma[3] = (ctx->r[0] + ctx->st[3]) ^ ctx->r[1] ^ ctx->st[4];
-
-    ctx->st[4] = a_mul(ctx->st[4]) ^ ctx->st[1] ^ ainv_mul(ctx->st[15]);
-    tmp = ctx->r[1] + ctx->st[1];
-    ctx->r[1] = T(ctx->r[0]);
-    ctx->r[0] = tmp;
-    ctx->gamma[4] = (ctx->r[0] + ctx->st[4]) ^ ctx->r[1] ^ ctx->st[5];
-
-    ctx->st[5] = a_mul(ctx->st[5]) ^ ctx->st[2] ^ ainv_mul(ctx->st[0]);
-    tmp = ctx->r[1] + ctx->st[2];
-    ctx->r[1] = T(ctx->r[0]);
-    ctx->r[0] = tmp;
-    ctx->gamma[5] = (ctx->r[0] + ctx->st[5]) ^ ctx->r[1] ^ ctx->st[6];
-
-    ctx->st[6] = a_mul(ctx->st[6]) ^ ctx->st[3] ^ ainv_mul(ctx->st[1]);
-    tmp = ctx->r[1] + ctx->st[3];
-    ctx->r[1] = T(ctx->r[0]);
-    ctx->r[0] = tmp;
-    ctx->gamma[6] = (ctx->r[0] + ctx->st[6]) ^ ctx->r[1] ^ ctx->st[7];
-
-    ctx->st[7] = a_mul(ctx->st[7]) ^ ctx->st[4] ^ ainv_mul(ctx->st[2]);
-    tmp = ctx->r[1] + ctx->st[4];
-    ctx->r[1] = T(ctx->r[0]);
-    ctx->r[0] = tmp;
-    ctx->gamma[7] = (ctx->r[0] + ctx->st[7]) ^ ctx->r[1] ^ ctx->st[8];
-
-    ctx->st[8] = a_mul(ctx->st[8]) ^ ctx->st[5] ^ ainv_mul(ctx->st[3]);
-    tmp = ctx->r[1] + ctx->st[5];
-    ctx->r[1] = T(ctx->r[0]);
-    ctx->r[0] = tmp;
-    ctx->gamma[8] = (ctx->r[0] + ctx->st[8]) ^ ctx->r[1] ^ ctx->st[9];
-
-    ctx->st[9] = a_mul(ctx->st[9]) ^ ctx->st[6] ^ ainv_mul(ctx->st[4]);
-    tmp = ctx->r[1] + ctx->st[6];
-    ctx->r[1] = T(ctx->r[0]);
-    ctx->r[0] = tmp;
-    ctx->gamma[9] = (ctx->r[0] + ctx->st[9]) ^ ctx->r[1] ^ ctx->st[10];
-
-    ctx->st[10] = a_mul(ctx->st[10]) ^ ctx->st[7] ^ ainv_mul(ctx->st[5]);
-    tmp = ctx->r[1] + ctx->st[7];
-    ctx->r[1] = T(ctx->r[0]);
-    ctx->r[0] = tmp;
-    ctx->gamma[10] = (ctx->r[0] + ctx->st[10]) ^ ctx->r[1] ^ ctx->st[11];
-
-    ctx->st[11] = a_mul(ctx->st[11]) ^ ctx->st[8] ^ ainv_mul(ctx->st[6]);
-    tmp = ctx->r[1] + ctx->st[8];
-    ctx->r[1] = T(ctx->r[0]);
-    ctx->r[0] = tmp;
-    ctx->gamma[11] = (ctx->r[0] + ctx->st[11]) ^ ctx->r[1] ^ ctx->st[12];
-
-    ctx->st[12] = a_mul(ctx->st[12]) ^ ctx->st[9] ^ ainv_mul(ctx->st[7]);
-    tmp = ctx->r[1] + ctx->st[9];
-    ctx->r[1] = T(ctx->r[0]);
-    ctx->r[0] = tmp;
-    ctx->gamma[12] = (ctx->r[0] + ctx->st[12]) ^ ctx->r[1] ^ ctx->st[13];
-
-    ctx->st[13] = a_mul(ctx->st[13]) ^ ctx->st[10] ^ ainv_mul(ctx->st[8]);
-    tmp = ctx->r[1] + ctx->st[10];
-    ctx->r[1] = T(ctx->r[0]);
-    ctx->r[0] = tmp;
-    ctx->gamma[13] = (ctx->r[0] + ctx->st[13]) ^ ctx->r[1] ^ ctx->st[14];
-
-    ctx->st[14] = a_mul(ctx->st[14]) ^ ctx->st[11] ^ ainv_mul(ctx->st[9]);
-    tmp = ctx->r[1] + ctx->st[11];
-    ctx->r[1] = T(ctx->r[0]);
-    ctx->r[0] = tmp;
-    ctx->gamma[14] = (ctx->r[0] + ctx->st[14]) ^ ctx->r[1] ^ ctx->st[15];
-
-    ctx->st[15] = a_mul(ctx->st[15]) ^ ctx->st[12] ^ ainv_mul(ctx->st[10]);
-    tmp = ctx->r[1] + ctx->st[12];
-    ctx->r[1] = T(ctx->r[0]);
-    ctx->r[0] = tmp;
-    ctx->gamma[15] = (ctx->r[0] + ctx->st[15]) ^ ctx->r[1] ^ ctx->st[0];
+    memcpy(st, ctx->st, sizeof(st));
+
+    KS_STEP(0, 1, 11, 13);
+    KS_STEP(1, 2, 12, 14);
+    KS_STEP(2, 3, 13, 15);
+    KS_STEP(3, 4, 14, 0);
+    KS_STEP(4, 5, 15, 1);
+    KS_STEP(5, 6, 0, 2);
+    KS_STEP(6, 7, 1, 3);
+    KS_STEP(7, 8, 2, 4);
+    KS_STEP(8, 9, 3, 5);
+    KS_STEP(9, 10, 4, 6);
+    KS_STEP(10, 11, 5, 7);
+    KS_STEP(11, 12, 6, 8);
+    KS_STEP(12, 13, 7, 9);
+    KS_STEP(13, 14, 8, 10);
+    KS_STEP(14, 15, 9, 11);
+    KS_STEP(15, 0, 10, 12);
+
+    memcpy(ctx->st, st, sizeof(st));
+    ctx->r[0] = r0;
+    ctx->r[1] = r1;
+}
 
+static void next_gamma(Dstu8845Ctx *ctx)
+{
+    keystream_block(ctx, ctx->gamma);
     ctx->gamma_cntr = 0;
 }
 
+static void xor_gamma_block(const uint64_t *gamma, const uint8_t *in, uint8_t *out)
+{
+    uint64_t w;
+    size_t i;
+
+    for (i = 0; i < 16; i++) {
+        memcpy(&w, in + i * 8, 8);
+        w ^= gamma[i];
+        memcpy(out + i * 8, &w, 8);
+    }
+}
+
 
 Dstu8845Ctx *dstu8845_alloc()
 {
     Dstu8845Ctx *ctx = NULL;
+    int ret = RET_OK;
 
-    ctx = calloc(1, sizeof(Dstu8845Ctx));
-    if (ctx == NULL) {
-        return NULL;
-    }
-    memset(ctx, 0, sizeof(Dstu8845Ctx));
+    DO(self_test_require(SELF_TEST_ID_DSTU8845));
+
+    CALLOC_CHECKED(ctx, sizeof(Dstu8845Ctx));
+
+cleanup:
 
     return ctx;
 }
@@ -1010,27 +969,53 @@ cleanup:
     return ret;
 }
 
-int dstu8845_crypt(Dstu8845Ctx *ctx, ByteArray *inout)
+int dstu8845_crypt_update(Dstu8845Ctx *ctx, const uint8_t *in, uint8_t *out, size_t len)
 {
     int ret = RET_OK;
-    uint8_t* in;
-    uint8_t* gamma;
-    size_t in_len;
+    const uint8_t* gamma;
 
     CHECK_PARAM(ctx != NULL);
-    CHECK_PARAM(inout != NULL);
+    CHECK_PARAM((in != NULL && out != NULL) || len == 0);
 
-    in = inout->buf;
-    in_len = inout->len;
-    gamma = (uint8_t*)ctx->gamma;
+    gamma = (const uint8_t*)ctx->gamma;
 
-    while (in_len--) {
-        *in++ ^= gamma[ctx->gamma_cntr++];
+    //  Use the rest of the current gamma block
+    while (len > 0 && ctx->gamma_cntr != 0) {
+        *out++ = *in++ ^ gamma[ctx->gamma_cntr++];
+        len--;
         if (ctx->gamma_cntr == 128) {
             next_gamma(ctx);
         }
     }
 
+    //  Whole blocks
+    while (len >= 128) {
+        xor_gamma_block(ctx->gamma, in, out);
+        keystream_block(ctx, ctx->gamma);
+        in += 128;
+        out += 128;
+        len -= 128;
+    }
+
+    //  Tail
+    while (len > 0) {
+        *out++ = *in++ ^ gamma[ctx->gamma_cntr++];
+        len--;
+    }
+
+cleanup:
+    return ret;
+}
+
+int dstu8845_crypt(Dstu8845Ctx *ctx, ByteArray *inout)
+{
+    int ret = RET_OK;
+
+    CHECK_PARAM(ctx != NULL);
+    CHECK_PARAM(inout != NULL);
+
+    DO(dstu8845_crypt_update(ctx, inout->buf, inout->buf, inout->len));
+
 cleanup:
     return ret;
 }
@@ -1116,16 +1101,18 @@ int dstu8845_self_test(void)
         0xd773b5e5193cafe1ULL, 0xb0a26671d259422bULL, 0x85b2aa326b280156ULL, 0x511ace6451435f0cULL };
 
 
-    static const ByteArray ba_iv_1 = { (uint8_t*)iv_1, sizeof(iv_1) };
-    static const ByteArray ba_iv_2 = { (uint8_t*)iv_2, sizeof(iv_2) };
-    static const ByteArray ba_k256_1 = { (uint8_t*)k256_1, sizeof(k256_1) };
-    static const ByteArray ba_k256_2 = { (uint8_t*)k256_2, sizeof(k256_2) };
-    static const ByteArray ba_k512_1 = { (uint8_t*)k512_1, sizeof(k512_1) };
-    static const ByteArray ba_k512_2 = { (uint8_t*)k512_2, sizeof(k512_2) };
+    static const ByteArray ba_iv_1 = { (uint8_t*)iv_1, sizeof(iv_1), false };
+    static const ByteArray ba_iv_2 = { (uint8_t*)iv_2, sizeof(iv_2), false };
+    static const ByteArray ba_k256_1 = { (uint8_t*)k256_1, sizeof(k256_1), false };
+    static const ByteArray ba_k256_2 = { (uint8_t*)k256_2, sizeof(k256_2), false };
+    static const ByteArray ba_k512_1 = { (uint8_t*)k512_1, sizeof(k512_1), false };
+    static const ByteArray ba_k512_2 = { (uint8_t*)k512_2, sizeof(k512_2), false };
 
     int ret = RET_OK;
     Dstu8845Ctx* ctx = NULL;
     ByteArray* Z = NULL;
+    ByteArray* Z2 = NULL;
+    size_t offset, chunk;
 
     CHECK_NOT_NULL(Z = ba_alloc_by_len(64));
     CHECK_NOT_NULL(ctx = dstu8845_alloc());
@@ -1185,9 +1172,29 @@ int dstu8845_self_test(void)
     if (memcmp(Z->buf, k512_2_iv_2, sizeof(k512_2_iv_2)) != 0) {
         SET_ERROR(RET_SELF_TEST_FAIL);
     }
-    
+
+    //  Chunked processing must produce the same stream as the whole-buffer one
+    ba_free(Z);
+    CHECK_NOT_NULL(Z = ba_alloc_by_len(1000));
+    CHECK_NOT_NULL(Z2 = ba_alloc_by_len(1000));
+    memset(Z->buf, 0, Z->len);
+    memset(Z2->buf, 0, Z2->len);
+    DO(dstu8845_init(ctx, &ba_k256_2, &ba_iv_2));
+    DO(dstu8845_crypt(ctx, Z));
+    DO(dstu8845_init(ctx, &ba_k256_2, &ba_iv_2));
+    for (offset = 0, chunk = 1; offset < Z2->len; offset += chunk, chunk = (chunk * 7) % 300 + 1) {
+        if (chunk > Z2->len - offset) {
+            chunk = Z2->len - offset;
+        }
+        DO(dstu8845_crypt_update(ctx, Z2->buf + offset, Z2->buf + offset, chunk));
+    }
+    if (memcmp(Z->buf, Z2->buf, Z->len) != 0) {
+        SET_ERROR(RET_SELF_TEST_FAIL);
+    }
+
 cleanup:
     ba_free(Z);
+    ba_free(Z2);
     dstu8845_free(ctx);
     return ret;
 }
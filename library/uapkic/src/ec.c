@@ -34,6 +34,7 @@
 #include "math-ec2m-internal.h"
 #include "math-int-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 
 static void ec_params_free(EcParamsCtx* params)
 {
@@ -1147,6 +1148,8 @@ int ec_dh(const EcCtx* ctx, bool with_cofactor, const ByteArray* d, const ByteAr
     ECPoint* r = NULL;
     size_t len;
 
+    DO(self_test_require(SELF_TEST_ID_ECDH));
+
     CHECK_PARAM(ctx != NULL);
     CHECK_PARAM(d != NULL);
     CHECK_PARAM(qx != NULL);
@@ -34,6 +34,7 @@
 #include "ec-cache-internal.h"
 #include "math-int-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 #include "hash.h"
 
 int ecdsa_generate_privkey(const EcCtx *ctx, ByteArray **d)
@@ -202,6 +203,8 @@ int ecdsa_sign(const EcCtx* ctx, const ByteArray* H, ByteArray** r, ByteArray**
     const WordArray* q;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_ECDSA));
+
     CHECK_PARAM(ctx != NULL);
     CHECK_PARAM(H != NULL);
     CHECK_PARAM(r != NULL);
@@ -244,6 +247,8 @@ int ecdsa_verify(const EcCtx *ctx, const ByteArray *H, const ByteArray *r, const
     int ret = RET_OK;
     size_t q_bit_len, q_byte_len, used_hash_len;
 
+    DO(self_test_require(SELF_TEST_ID_ECDSA));
+
     CHECK_PARAM(ctx != NULL);
     CHECK_PARAM(H != NULL);
     CHECK_PARAM(r != NULL);
@@ -358,8 +363,8 @@ static int ecdsa_p_self_test(void)
         0xE9, 0xEC, 0xC7, 0x81, 0x06, 0xDE, 0xF8, 0x2B, 0xF1, 0x07, 0x0C, 0xF1, 0xD4, 0xD8, 0x04, 0xC3, 
         0xCB, 0x39, 0x00, 0x46, 0x95, 0x1D, 0xF6, 0x86 };
 
-    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d) };
-    static const ByteArray ba_Msg = { (uint8_t*)test_Msg, sizeof(test_Msg) - 1 };
+    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d), false };
+    static const ByteArray ba_Msg = { (uint8_t*)test_Msg, sizeof(test_Msg) - 1, false };
 
     int ret = RET_OK;
     EcCtx* ec_ctx = NULL;
@@ -434,8 +439,8 @@ static int ecdsa_b_self_test(void)
         0x2D, 0x72, 0xC7, 0x3D, 0xA3, 0x3A, 0x9B, 0x26, 0x7F, 0x0B, 0xEC, 0x9E, 0x6C, 0xB6, 0xBE, 0xCE,
         0xED, 0x01, 0x4F, 0x67, 0xD4, 0xA3, 0xD3, 0x00, 0x06, 0xB3, 0xEB, 0xE2, 0xDC };
 
-    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d) };
-    static const ByteArray ba_Msg = { (uint8_t*)test_Msg, sizeof(test_Msg) - 1 };
+    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d), false };
+    static const ByteArray ba_Msg = { (uint8_t*)test_Msg, sizeof(test_Msg) - 1, false };
 
     int ret = RET_OK;
     EcCtx* ec_ctx = NULL;
@@ -33,6 +33,7 @@
 #include "ec-cache-internal.h"
 #include "math-int-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 #include "hash.h"
 
 int ecgdsa_generate_privkey(const EcCtx *ctx, ByteArray **d)
@@ -185,6 +186,8 @@ int ecgdsa_sign(const EcCtx* ctx, const ByteArray* H, ByteArray** r, ByteArray**
     const WordArray* q;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_ECGDSA));
+
     CHECK_PARAM(ctx != NULL);
     CHECK_PARAM(ctx->params->ec_field == EC_FIELD_PRIME);
     CHECK_PARAM(H != NULL);
@@ -226,6 +229,8 @@ int ecgdsa_verify(const EcCtx *ctx, const ByteArray *H, const ByteArray *r, cons
     const WordArray *q;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_ECGDSA));
+
     CHECK_PARAM(ctx != NULL);
     CHECK_PARAM(ctx->params->ec_field == EC_FIELD_PRIME);
     CHECK_PARAM(H != NULL);
@@ -324,8 +329,8 @@ int ecgdsa_self_test(void)
         0x3d, 0xc2, 0xf1, 0x03, 0x29, 0x6a, 0x79, 0x3e, 0x50, 0xdc, 0x22, 0x66, 0x65, 0x74, 0x70, 0xa4,
         0x0d, 0x2c, 0x9e, 0xa1, 0xca, 0x79, 0x7d, 0xea, 0x61, 0x00, 0x42, 0xb7, 0x73, 0x0b, 0xbd, 0xce };
 
-    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d) };
-    static const ByteArray ba_Msg = { (uint8_t*)test_Msg, sizeof(test_Msg) - 1 };
+    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d), false };
+    static const ByteArray ba_Msg = { (uint8_t*)test_Msg, sizeof(test_Msg) - 1, false };
 
     int ret = RET_OK;
     EcCtx* ec_ctx = NULL;
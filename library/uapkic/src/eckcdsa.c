@@ -33,6 +33,7 @@
 #include "ec-cache-internal.h"
 #include "math-int-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 
 int eckcdsa_generate_privkey(const EcCtx *ctx, ByteArray **d)
 {
@@ -216,6 +217,8 @@ int eckcdsa_sign(const EcCtx* ctx, const ByteArray* H, HashAlg hash_alg, ByteArr
     const WordArray* q;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_ECKCDSA));
+
     CHECK_PARAM(ctx != NULL);
     CHECK_PARAM(H != NULL);
     CHECK_PARAM(r != NULL);
@@ -258,6 +261,8 @@ int eckcdsa_verify(const EcCtx *ctx, const ByteArray *H, HashAlg hash_alg, const
     int ret = RET_OK;
     size_t i, q_byte_len, r_len, shift;
 
+    DO(self_test_require(SELF_TEST_ID_ECKCDSA));
+
     CHECK_PARAM(ctx != NULL);
     CHECK_PARAM(H != NULL);
     CHECK_PARAM(R != NULL);
@@ -368,7 +373,7 @@ cleanup:
 
 
 static const uint8_t test_Msg[] = "This is a sample message for EC-KCDSA implementation validation.";
-static const ByteArray ba_Msg = { (uint8_t*)test_Msg, sizeof(test_Msg) - 1 };
+static const ByteArray ba_Msg = { (uint8_t*)test_Msg, sizeof(test_Msg) - 1, false };
 
 static int eckcdsa_p_self_test(void)
 {
@@ -395,7 +400,7 @@ static int eckcdsa_p_self_test(void)
         0x68, 0x1C, 0x8E, 0xD8, 0x9E, 0x8B, 0x0E, 0x1B, 0xC3, 0x69, 0xAA, 0x10, 0x6F, 0x6B, 0x98, 0x13,
         0xE6, 0x33, 0x8F, 0x0C, 0x54, 0xBE, 0x57, 0x7A, 0x87, 0x62, 0x34, 0x92, 0x52, 0xF9, 0xBE, 0xDF };
 
-    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d) };
+    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d), false };
 
     int ret = RET_OK;
     EcCtx* ec_ctx = NULL;
@@ -477,7 +482,7 @@ static int eckcdsa_b_self_test(void)
         0xE7, 0x4B, 0x3C, 0x74, 0x72, 0xF2, 0xE9, 0x7E, 0xC3, 0x18, 0x61, 0xCA, 0x17, 0x73, 0x47, 0x2E, 
         0x58, 0x82, 0x8A, 0x98, 0x02, 0x62, 0x77, 0xCB, 0x00, 0xEF, 0x36, 0xAC };
 
-    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d) };
+    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d), false };
 
     int ret = RET_OK;
     EcCtx* ec_ctx = NULL;
@@ -33,6 +33,7 @@
 #include "ec-cache-internal.h"
 #include "math-int-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 #include "hash.h"
 
 int ecrdsa_generate_privkey(const EcCtx *ctx, ByteArray **d)
@@ -185,6 +186,8 @@ int ecrdsa_sign(const EcCtx* ctx, const ByteArray* H, ByteArray** r, ByteArray**
     const WordArray* q;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_ECRDSA));
+
     CHECK_PARAM(ctx != NULL);
     CHECK_PARAM(ctx->params->ec_field == EC_FIELD_PRIME);
     CHECK_PARAM(H != NULL);
@@ -227,6 +230,8 @@ int ecrdsa_verify(const EcCtx* ctx, const ByteArray* H, const ByteArray* r, cons
     const WordArray* q;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_ECRDSA));
+
     CHECK_PARAM(ctx != NULL);
     CHECK_PARAM(ctx->params->ec_field == EC_FIELD_PRIME);
     CHECK_PARAM(H != NULL);
@@ -331,8 +336,8 @@ int ecrdsa_self_test(void)
         0x0A, 0x7B, 0xA4, 0x72, 0x2D, 0xA5, 0x69, 0x3F, 0x22, 0x9D, 0x17, 0x5F, 0xAB, 0x6A, 0xFB, 0x85,
         0x7E, 0xC2, 0x27, 0x3B, 0x9F, 0x88, 0xDA, 0x58, 0x92, 0xCE, 0xD3, 0x11, 0x7F, 0xCF, 0x1E, 0x36 }; 
 
-    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d) };
-    static const ByteArray ba_Msg = { (uint8_t*)test_Msg, sizeof(test_Msg) - 1 };
+    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d), false };
+    static const ByteArray ba_Msg = { (uint8_t*)test_Msg, sizeof(test_Msg) - 1, false };
 
     int ret = RET_OK;
     EcCtx* ec_ctx = NULL;
@@ -36,6 +36,7 @@
 #include "byte-array-internal.h"
 #include "byte-utils-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 
 #define SBOX_LEN                 128
 #define KEY_LEN                  32
@@ -687,6 +688,8 @@ Gost28147Ctx *gost28147_alloc(Gost28147SboxId sbox_id)
     int ret = RET_OK;
     const uint8_t *sbox = NULL;
 
+    DO(self_test_require(SELF_TEST_ID_GOST28147));
+
     switch (sbox_id) {
     case GOST28147_SBOX_DEFAULT:
     case GOST28147_SBOX_ID_1:
@@ -760,6 +763,8 @@ Gost28147Ctx *gost28147_alloc_user_sbox(const ByteArray *sbox)
     Gost28147Ctx *ctx = NULL;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_GOST28147));
+
     CHECK_PARAM(sbox != NULL);
 
     DO(ba_to_uint8(sbox, buf, SBOX_LEN));
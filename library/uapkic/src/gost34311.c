@@ -32,9 +32,11 @@
 
 #include "gost28147.h"
 #include "gost34311.h"
+#include "hash-internal.h"
 #include "byte-array-internal.h"
 #include "byte-utils-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 
 void base_cycle32(Gost28147Ctx *ctx, uint32_t src[8], const uint32_t k[32]);
 
@@ -273,6 +275,8 @@ Gost34311Ctx *gost34311_alloc(Gost28147SboxId sbox_id, const ByteArray *sync)
     Gost34311Ctx *ctx = NULL;
     int ret = RET_OK;
     
+    DO(self_test_require(SELF_TEST_ID_GOST34311));
+
     CALLOC_CHECKED(ctx, sizeof(Gost34311Ctx));
     CHECK_NOT_NULL(ctx->gost = gost28147_alloc(sbox_id));
     if (sync) {
@@ -301,6 +305,8 @@ Gost34311Ctx *gost34311_alloc_user_sbox(const ByteArray *sbox, const ByteArray *
     Gost34311Ctx *ctx = NULL;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_GOST34311));
+
     CHECK_PARAM(sync != NULL);
     CHECK_PARAM(sync->len == 32);
 
@@ -373,7 +379,25 @@ cleanup:
     return ret;
 }
 
-int gost34311_final(Gost34311Ctx *ctx, ByteArray **out)
+int gost34311_copy_state(Gost34311Ctx *dst, const Gost34311Ctx *src)
+{
+    Gost28147Ctx *gost;
+    int ret = RET_OK;
+
+    CHECK_PARAM(dst != NULL);
+    CHECK_PARAM(src != NULL);
+
+    /* Контекст ГОСТ 28147 хранит только таблицу замен, ключи задаются на каждом шаге. */
+    gost = dst->gost;
+    memcpy(dst, src, sizeof(Gost34311Ctx));
+    dst->gost = gost;
+
+cleanup:
+
+    return ret;
+}
+
+int gost34311_final_to_buf(Gost34311Ctx *ctx, uint8_t *out)
 {
     uint32_t m32[8];
     uint32_t bit;
@@ -408,7 +432,7 @@ int gost34311_final(Gost34311Ctx *ctx, ByteArray **out)
     DO(uint32_to_uint8(ctx->sigma, 8, sigma8, 32));
     DO(hash_step(ctx, sigma8));
 
-    CHECK_NOT_NULL(*out = ba_alloc_from_uint8(ctx->H, 32));
+    memcpy(out, ctx->H, 32);
 
     /* Переинициализируем контекст хэш-вектора. */
     reset(ctx);
@@ -418,6 +442,22 @@ cleanup:
     return ret;
 }
 
+int gost34311_final(Gost34311Ctx *ctx, ByteArray **out)
+{
+    uint8_t H[32];
+    int ret = RET_OK;
+
+    CHECK_PARAM(ctx != NULL);
+    CHECK_PARAM(out != NULL);
+
+    DO(gost34311_final_to_buf(ctx, H));
+    CHECK_NOT_NULL(*out = ba_alloc_from_uint8(H, sizeof(H)));
+
+cleanup:
+
+    return ret;
+}
+
 void gost34311_free(Gost34311Ctx *ctx)
 {
     if (ctx) {
@@ -450,8 +490,8 @@ int gost34311_self_test(void)
         0x47, 0x1a, 0xba, 0x57, 0xa6, 0x0a, 0x77, 0x0d, 0x3a, 0x76, 0x13, 0x06, 0x35, 0xc1, 0xfb, 0xea,
         0x4e, 0xf1, 0x4d, 0xe5, 0x1f, 0x78, 0xb4, 0xae, 0x57, 0xdd, 0x89, 0x3b, 0x62, 0xf5, 0x52, 0x08 };
 
-    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) };
-    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) };
+    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1), false };
+    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2), false };
 
     int ret = RET_OK;
     Gost34311Ctx* ctx = NULL;
@@ -34,6 +34,9 @@
 #include "byte-utils-internal.h"
 #include "byte-array-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
+
+typedef void (*gostr3411_splx_fn)(uint64_t* out, const uint64_t* a, const uint64_t* b);
 
 struct GostR3411Ctx_st
 {
@@ -43,6 +46,7 @@ struct GostR3411Ctx_st
     uint8_t block[64];
     size_t block_ind;
     GostR3411Variant variant;
+    gostr3411_splx_fn splx;
 };
 
 #define LE_READ_UINT64(p)			\
@@ -648,19 +652,58 @@ static void SPLX(uint64_t *out, const uint64_t *a, const uint64_t *b)
     }
 }
 
-static void G(uint64_t* h, uint64_t* m, uint64_t* N)
+/*
+ * LPS-перетворення для little-endian платформ: стан (a ^ b) розглядається як
+ * матриця 8x8 байтів, тому індекси таблиць читаються безпосередньо,
+ * без зсувів і масок для кожного з 64 звернень.
+ */
+static void SPLX_le(uint64_t *out, const uint64_t *a, const uint64_t *b)
+{
+    union {
+        uint64_t w[8];
+        uint8_t b[64];
+    } tmp;
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        tmp.w[i] = a[i] ^ b[i];
+    }
+
+    for (i = 0; i < 8; i++) {
+        out[i] = gostr3411_2012_ext_table[0][tmp.b[i]]
+            ^ gostr3411_2012_ext_table[1][tmp.b[8 + i]]
+            ^ gostr3411_2012_ext_table[2][tmp.b[16 + i]]
+            ^ gostr3411_2012_ext_table[3][tmp.b[24 + i]]
+            ^ gostr3411_2012_ext_table[4][tmp.b[32 + i]]
+            ^ gostr3411_2012_ext_table[5][tmp.b[40 + i]]
+            ^ gostr3411_2012_ext_table[6][tmp.b[48 + i]]
+            ^ gostr3411_2012_ext_table[7][tmp.b[56 + i]];
+    }
+}
+
+static gostr3411_splx_fn gostr3411_select_splx(void)
+{
+    static const uint16_t endian_check = 1;
+
+    if (*(const uint8_t*)&endian_check == 1) {
+        return SPLX_le;
+    }
+    return SPLX;
+}
+
+static void G(gostr3411_splx_fn splx, uint64_t* h, uint64_t* m, uint64_t* N)
 {
     uint64_t K[8];
     uint64_t T[8];
     int i;
 
-    SPLX(K, h, N);
-    SPLX(T, K, m);
-    SPLX(K, K, C16[0]);
+    splx(K, h, N);
+    splx(T, K, m);
+    splx(K, K, C16[0]);
 
     for (i = 1; i < 12; i++) {
-        SPLX(T, K, T);
-        SPLX(K, K, C16[i]);
+        splx(T, K, T);
+        splx(K, K, C16[i]);
     }
 
     for (i = 7; i >= 0; i--) {
@@ -678,7 +721,7 @@ static void gostr3411_compress(GostR3411Ctx* ctx, const uint8_t* input, uint64_t
         M[i] = LE_READ_UINT64(input + i * 8);
     }
 
-    G(ctx->state, M, ctx->total_length);
+    G(ctx->splx, ctx->state, M, ctx->total_length);
     ctx->total_length[0] += bitlength;
     if (ctx->total_length[0] < bitlength) {
         for (i = 1; i < 8; i++)
@@ -705,6 +748,8 @@ GostR3411Ctx* gostr3411_alloc(GostR3411Variant variant)
     int ret = RET_OK;
     GostR3411Ctx* ctx = NULL;
 
+    DO(self_test_require(SELF_TEST_ID_GOSTR3411));
+
     CALLOC_CHECKED(ctx, sizeof(GostR3411Ctx));
 
     switch (variant) {
@@ -719,6 +764,7 @@ GostR3411Ctx* gostr3411_alloc(GostR3411Variant variant)
     }
 
     ctx->variant = variant;
+    ctx->splx = gostr3411_select_splx();
 
 cleanup:
 
@@ -796,8 +842,8 @@ int gostr3411_final(GostR3411Ctx *ctx, ByteArray** out)
     memset(ctx->block + ctx->block_ind + 1, 0, 64 - ctx->block_ind - 1);
     gostr3411_compress(ctx, ctx->block, ctx->block_ind * 8);
 
-    G(ctx->state, ctx->total_length, tmp);
-    G(ctx->state, ctx->sigma, tmp);
+    G(ctx->splx, ctx->state, ctx->total_length, tmp);
+    G(ctx->splx, ctx->state, ctx->sigma, tmp);
 
     if (ctx->variant == GOSTR3411_2012_VARIANT_256) {
         CHECK_NOT_NULL(*out = ba_alloc_by_len(32));
@@ -838,6 +884,38 @@ void gostr3411_free(GostR3411Ctx* ctx)
     }
 }
 
+static int gostr3411_splx_self_test(void)
+{
+    gostr3411_splx_fn splx = gostr3411_select_splx();
+    uint64_t a[8], b[8], expected[8], actual[8];
+    uint64_t x = 0x0123456789ABCDEFULL;
+    int ret = RET_OK;
+    int i, j;
+
+    if (splx == SPLX) {
+        goto cleanup;
+    }
+
+    //  Compare the selected LPS implementation with the reference one
+    for (i = 0; i < 64; i++) {
+        for (j = 0; j < 8; j++) {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            a[j] = x;
+            b[j] = (i < 12) ? C16[i][j] : ~x;
+        }
+        SPLX(expected, a, b);
+        splx(actual, a, b);
+        if (memcmp(expected, actual, sizeof(expected)) != 0) {
+            SET_ERROR(RET_SELF_TEST_FAIL);
+        }
+    }
+
+cleanup:
+    return ret;
+}
+
 int gostr3411_self_test(void)
 {
     // ГОСТ Р 34.11 - 2012. Приложение А (справочное). Контрольные примеры
@@ -868,13 +946,15 @@ int gostr3411_self_test(void)
     static const uint8_t H256_M2[32] = {
         0x9D, 0xD2, 0xFE, 0x4E, 0x90, 0x40, 0x9E, 0x5D, 0xA8, 0x7F, 0x53, 0x97, 0x6D, 0x74, 0x05, 0xB0, 
         0xC0, 0xCA, 0xC6, 0x28, 0xFC, 0x66, 0x9A, 0x74, 0x1D, 0x50, 0x06, 0x3C, 0x55, 0x7E, 0x8F, 0x50 };
-    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) };
-    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) };
+    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1), false };
+    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2), false };
 
     int ret = RET_OK;
     GostR3411Ctx* ctx = NULL;
     ByteArray* H = NULL;
 
+    DO(gostr3411_splx_self_test());
+
     CHECK_NOT_NULL(ctx = gostr3411_alloc(GOSTR3411_2012_VARIANT_512));
     DO(gostr3411_update(ctx, &ba_M1));
     DO(gostr3411_final(ctx, &H));
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2023, The UAPKI Project Authors.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions are 
+ * met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright 
+ * notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright 
+ * notice, this list of conditions and the following disclaimer in the 
+ * documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS 
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED 
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A 
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED 
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR 
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UAPKIC_HASH_INTERNAL_H
+#define UAPKIC_HASH_INTERNAL_H
+
+#include <stdint.h>
+
+#include "hash.h"
+#include "sha1.h"
+#include "sha2.h"
+#include "gost34311.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+//  Copies the hashing state of src into dst of the same algorithm, created with the same parameters
+//  (the same S-box for GOST 34.311). SHA-1, SHA-2 and GOST 34.311 do not allocate memory
+int hash_copy_state(HashCtx *dst, const HashCtx *src);
+
+//  Finishes hashing and writes the hash into out, of hash_get_size() bytes.
+//  SHA-1, SHA-2 and GOST 34.311 do not allocate memory
+int hash_final_to_buf(HashCtx *ctx, uint8_t *out);
+
+int sha1_copy_state(Sha1Ctx *dst, const Sha1Ctx *src);
+int sha1_final_to_buf(Sha1Ctx *ctx, uint8_t *out);
+
+int sha2_copy_state(Sha2Ctx *dst, const Sha2Ctx *src);
+int sha2_final_to_buf(Sha2Ctx *ctx, uint8_t *out);
+
+int gost34311_copy_state(Gost34311Ctx *dst, const Gost34311Ctx *src);
+int gost34311_final_to_buf(Gost34311Ctx *ctx, uint8_t *out);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif
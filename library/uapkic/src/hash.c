@@ -42,6 +42,7 @@
 #include "dstu7564.h"
 #include "whirlpool.h"
 #include "gostr3411-2012.h"
+#include "hash-internal.h"
 #include "byte-array-internal.h"
 #include "macros-internal.h"
 
@@ -50,6 +51,8 @@ typedef int (*f_final)(void* ctx, ByteArray** hash);
 typedef void (*f_free)(void* ctx);
 typedef size_t (*f_get_block_size)(const void* ctx);
 typedef void* (*f_copy_with_alloc)(const void* ctx);
+typedef int (*f_copy_state)(void* dst, const void* src);
+typedef int (*f_final_to_buf)(void* ctx, uint8_t* out);
 
 struct HashCtx_st {
     void* ctx;
@@ -59,6 +62,8 @@ struct HashCtx_st {
     f_free free;
     f_get_block_size get_block_size;
     f_copy_with_alloc copy_with_alloc;
+    f_copy_state copy_state;
+    f_final_to_buf final_to_buf;
 };
 
 HashCtx* hash_alloc(HashAlg alg)
@@ -66,7 +71,7 @@ HashCtx* hash_alloc(HashAlg alg)
     int ret = RET_OK;
     HashCtx *ctx = NULL;
 
-    MALLOC_CHECKED(ctx, sizeof(HashCtx));
+    CALLOC_CHECKED(ctx, sizeof(HashCtx));
     ctx->alg = alg;
 
     switch (ctx->alg)
@@ -114,6 +119,8 @@ HashCtx* hash_alloc(HashAlg alg)
         ctx->free = (f_free)gost34311_free;
         ctx->get_block_size = (f_get_block_size)gost34311_get_block_size;
         ctx->copy_with_alloc = (f_copy_with_alloc)gost34311_copy_with_alloc;
+        ctx->copy_state = (f_copy_state)gost34311_copy_state;
+        ctx->final_to_buf = (f_final_to_buf)gost34311_final_to_buf;
         break;
 
     case HASH_ALG_SHA1:
@@ -123,6 +130,8 @@ HashCtx* hash_alloc(HashAlg alg)
         ctx->free = (f_free)sha1_free;
         ctx->get_block_size = (f_get_block_size)sha1_get_block_size;
         ctx->copy_with_alloc = (f_copy_with_alloc)sha1_copy_with_alloc;
+        ctx->copy_state = (f_copy_state)sha1_copy_state;
+        ctx->final_to_buf = (f_final_to_buf)sha1_final_to_buf;
         break;
 
     case HASH_ALG_SHA224:
@@ -132,6 +141,8 @@ HashCtx* hash_alloc(HashAlg alg)
         ctx->free = (f_free)sha2_free;
         ctx->get_block_size = (f_get_block_size)sha2_get_block_size;
         ctx->copy_with_alloc = (f_copy_with_alloc)sha2_copy_with_alloc;
+        ctx->copy_state = (f_copy_state)sha2_copy_state;
+        ctx->final_to_buf = (f_final_to_buf)sha2_final_to_buf;
         break;
 
     case HASH_ALG_SHA256:
@@ -141,6 +152,8 @@ HashCtx* hash_alloc(HashAlg alg)
         ctx->free = (f_free)sha2_free;
         ctx->get_block_size = (f_get_block_size)sha2_get_block_size;
         ctx->copy_with_alloc = (f_copy_with_alloc)sha2_copy_with_alloc;
+        ctx->copy_state = (f_copy_state)sha2_copy_state;
+        ctx->final_to_buf = (f_final_to_buf)sha2_final_to_buf;
         break;
 
     case HASH_ALG_SHA384:
@@ -150,6 +163,8 @@ HashCtx* hash_alloc(HashAlg alg)
         ctx->free = (f_free)sha2_free;
         ctx->get_block_size = (f_get_block_size)sha2_get_block_size;
         ctx->copy_with_alloc = (f_copy_with_alloc)sha2_copy_with_alloc;
+        ctx->copy_state = (f_copy_state)sha2_copy_state;
+        ctx->final_to_buf = (f_final_to_buf)sha2_final_to_buf;
         break;
 
     case HASH_ALG_SHA512:
@@ -159,6 +174,8 @@ HashCtx* hash_alloc(HashAlg alg)
         ctx->free = (f_free)sha2_free;
         ctx->get_block_size = (f_get_block_size)sha2_get_block_size;
         ctx->copy_with_alloc = (f_copy_with_alloc)sha2_copy_with_alloc;
+        ctx->copy_state = (f_copy_state)sha2_copy_state;
+        ctx->final_to_buf = (f_final_to_buf)sha2_final_to_buf;
         break;
 
     case HASH_ALG_SHA3_224:
@@ -278,7 +295,7 @@ HashCtx* hash_alloc_gost34311_with_sbox_id(Gost28147SboxId sbox_id)
     int ret = RET_OK;
     HashCtx* ctx = NULL;
 
-    MALLOC_CHECKED(ctx, sizeof(HashCtx));
+    CALLOC_CHECKED(ctx, sizeof(HashCtx));
     ctx->alg = HASH_ALG_GOST34311;
 
     CHECK_NOT_NULL(ctx->ctx = gost34311_alloc(sbox_id, NULL));
@@ -287,6 +304,8 @@ HashCtx* hash_alloc_gost34311_with_sbox_id(Gost28147SboxId sbox_id)
     ctx->free = (f_free)gost34311_free;
     ctx->get_block_size = (f_get_block_size)gost34311_get_block_size;
     ctx->copy_with_alloc = (f_copy_with_alloc)gost34311_copy_with_alloc;
+    ctx->copy_state = (f_copy_state)gost34311_copy_state;
+    ctx->final_to_buf = (f_final_to_buf)gost34311_final_to_buf;
 
 cleanup:
     if (ret != RET_OK) {
@@ -302,7 +321,7 @@ HashCtx* hash_alloc_gost34311_with_sbox(const ByteArray *sbox)
     int ret = RET_OK;
     HashCtx* ctx = NULL;
 
-    MALLOC_CHECKED(ctx, sizeof(HashCtx));
+    CALLOC_CHECKED(ctx, sizeof(HashCtx));
     ctx->alg = HASH_ALG_GOST34311;
 
     CHECK_NOT_NULL(ctx->ctx = gost34311_alloc_user_sbox(sbox, NULL));
@@ -311,6 +330,8 @@ HashCtx* hash_alloc_gost34311_with_sbox(const ByteArray *sbox)
     ctx->free = (f_free)gost34311_free;
     ctx->get_block_size = (f_get_block_size)gost34311_get_block_size;
     ctx->copy_with_alloc = (f_copy_with_alloc)gost34311_copy_with_alloc;
+    ctx->copy_state = (f_copy_state)gost34311_copy_state;
+    ctx->final_to_buf = (f_final_to_buf)gost34311_final_to_buf;
     
 cleanup:
     if (ret != RET_OK) {
@@ -343,6 +364,49 @@ cleanup:
     return ret;
 }
 
+int hash_copy_state(HashCtx* dst, const HashCtx* src)
+{
+    int ret = RET_OK;
+    void* copy = NULL;
+
+    CHECK_PARAM(dst != NULL);
+    CHECK_PARAM(src != NULL);
+    CHECK_PARAM(dst->alg == src->alg);
+
+    if (src->copy_state) {
+        DO(src->copy_state(dst->ctx, src->ctx));
+    }
+    else {
+        CHECK_NOT_NULL(copy = src->copy_with_alloc(src->ctx));
+        dst->free(dst->ctx);
+        dst->ctx = copy;
+    }
+
+cleanup:
+    return ret;
+}
+
+int hash_final_to_buf(HashCtx* ctx, uint8_t* out)
+{
+    int ret = RET_OK;
+    ByteArray* hash_ba = NULL;
+
+    CHECK_PARAM(ctx != NULL);
+    CHECK_PARAM(out != NULL);
+
+    if (ctx->final_to_buf) {
+        DO(ctx->final_to_buf(ctx->ctx, out));
+    }
+    else {
+        DO(ctx->final(ctx->ctx, &hash_ba));
+        memcpy(out, hash_ba->buf, hash_ba->len);
+    }
+
+cleanup:
+    ba_free_private(hash_ba);
+    return ret;
+}
+
 size_t hash_get_block_size(const HashCtx* ctx)
 {
     if (ctx) {
@@ -33,6 +33,7 @@
 #include "hmac.h"
 #include "byte-array-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 
 #define HMAC_MAX_BLOCK_SIZE   144
 
@@ -50,6 +51,8 @@ HmacCtx* hmac_alloc(HashAlg alg)
     int ret = RET_OK;
     HmacCtx *ctx = NULL;
 
+    DO(self_test_require(SELF_TEST_ID_HMAC));
+
     CALLOC_CHECKED(ctx, sizeof(HmacCtx));
     CHECK_NOT_NULL(ctx->hctx = hash_alloc(alg));
     ctx->block_len = hash_get_block_size(ctx->hctx);
@@ -70,6 +73,8 @@ HmacCtx* hmac_alloc_gost34311_with_sbox_id(Gost28147SboxId sbox_id)
     int ret = RET_OK;
     HmacCtx* ctx = NULL;
 
+    DO(self_test_require(SELF_TEST_ID_HMAC));
+
     CALLOC_CHECKED(ctx, sizeof(HmacCtx));
     CHECK_NOT_NULL(ctx->hctx = hash_alloc_gost34311_with_sbox_id(sbox_id));
     ctx->block_len = hash_get_block_size(ctx->hctx);
@@ -90,6 +95,8 @@ HmacCtx* hmac_alloc_gost34311_with_sbox(const ByteArray* sbox)
     int ret = RET_OK;
     HmacCtx* ctx = NULL;
 
+    DO(self_test_require(SELF_TEST_ID_HMAC));
+
     CALLOC_CHECKED(ctx, sizeof(HmacCtx));
     CHECK_NOT_NULL(ctx->hctx = hash_alloc_gost34311_with_sbox(sbox));
     ctx->block_len = hash_get_block_size(ctx->hctx);
@@ -226,13 +233,13 @@ int hmac_self_test(void)
         0x67, 0x91, 0x42, 0x78, 0x14, 0x55, 0xAC, 0x14, 0xC7, 0xEA, 0x38, 0x4D, 0x6F, 0x81, 0xD9, 0x67,
         0xB7, 0xAF, 0xFB, 0xCF, 0x39, 0xEB, 0x9F, 0x9E, 0x2B, 0x25, 0x69, 0xD4, 0x3C, 0x7A, 0xD8, 0xB7 };
 
-    static const ByteArray ba_key = { (uint8_t*)key , sizeof(key) };
-    static const ByteArray ba_msg = { (uint8_t*)msg , sizeof(msg) - 1 };
-    static const ByteArray ba_gost34311_key = { (uint8_t*)gost34311_key , sizeof(gost34311_key) };
-    static const ByteArray ba_gost34311_msg = { (uint8_t*)gost34311_msg , sizeof(gost34311_msg) };
-    static const ByteArray ba_hmac_md5 = { (uint8_t*)hmac_md5 , sizeof(hmac_md5) };
-    static const ByteArray ba_hmac_sha1 = { (uint8_t*)hmac_sha1 , sizeof(hmac_sha1) };
-    static const ByteArray ba_hmac_gost34311 = { (uint8_t*)hmac_gost34311 , sizeof(hmac_gost34311) };
+    static const ByteArray ba_key = { (uint8_t*)key , sizeof(key), false };
+    static const ByteArray ba_msg = { (uint8_t*)msg , sizeof(msg) - 1, false };
+    static const ByteArray ba_gost34311_key = { (uint8_t*)gost34311_key , sizeof(gost34311_key), false };
+    static const ByteArray ba_gost34311_msg = { (uint8_t*)gost34311_msg , sizeof(gost34311_msg), false };
+    static const ByteArray ba_hmac_md5 = { (uint8_t*)hmac_md5 , sizeof(hmac_md5), false };
+    static const ByteArray ba_hmac_sha1 = { (uint8_t*)hmac_sha1 , sizeof(hmac_sha1), false };
+    static const ByteArray ba_hmac_gost34311 = { (uint8_t*)hmac_gost34311 , sizeof(hmac_gost34311), false };
 
     int ret = RET_OK;
     HmacCtx *ctx = NULL;
@@ -563,7 +563,7 @@ static void jent_hash_time(JitentCtx *ec, uint64_t time,
 	uint64_t lfsr_loop_cnt =
 		jent_loop_shuffle(ec, MAX_HASH_LOOP, MIN_HASH_LOOP);
 	ByteArray* tmp = NULL;
-	ByteArray t2 = {NULL, sizeof(uint64_t) };
+	ByteArray t2 = {NULL, sizeof(uint64_t), false };
 
 	/*
 	 * testing purposes -- allow test app to set the counter, not
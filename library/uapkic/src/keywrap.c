@@ -30,6 +30,7 @@
 #include <memory.h>
 
 #include "macros-internal.h"
+#include "self-test-internal.h"
 #include "keywrap.h"
 #include "drbg.h"
 #include "dstu7624.h"
@@ -99,6 +100,8 @@ int key_wrap_dstu7624(const ByteArray* kek, const ByteArray* key, ByteArray** wr
     int ret = RET_OK;
     ByteArray* iv = NULL;
 
+    DO(self_test_require(SELF_TEST_ID_KEY_WRAP));
+
     CHECK_PARAM(kek);
     CHECK_PARAM(key);
     CHECK_PARAM(wraped_key);
@@ -126,6 +129,8 @@ int key_unwrap_dstu7624(const ByteArray* kek, const ByteArray* wraped_key, ByteA
     ByteArray* enc_mac = NULL;
     Dstu7624Ctx* ctx = NULL;
 
+    DO(self_test_require(SELF_TEST_ID_KEY_WRAP));
+
     CHECK_PARAM(kek);
     CHECK_PARAM(wraped_key);
     CHECK_PARAM(key);
@@ -224,6 +229,8 @@ int key_wrap_gost28147(const ByteArray* sbox, const ByteArray* kek, const ByteAr
     int ret = RET_OK;
     ByteArray* iv = NULL;
 
+    DO(self_test_require(SELF_TEST_ID_KEY_WRAP));
+
     CHECK_PARAM(kek);
     CHECK_PARAM(key);
     CHECK_PARAM(wraped_key);
@@ -253,6 +260,8 @@ int key_unwrap_gost28147(const ByteArray* sbox, const ByteArray* kek, const Byte
 
     Gost28147Ctx* params = NULL;
 
+    DO(self_test_require(SELF_TEST_ID_KEY_WRAP));
+
     CHECK_PARAM(kek);
     CHECK_PARAM(wraped_key);
     CHECK_PARAM(key);
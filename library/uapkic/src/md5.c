@@ -34,6 +34,7 @@
 #include "md5.h"
 #include "byte-array-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 #include "byte-utils-internal.h"
 
 struct MD5Ctx_st {
@@ -252,6 +253,8 @@ Md5Ctx *md5_alloc(void)
     Md5Ctx *ctx = NULL;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_MD5));
+
     CALLOC_CHECKED(ctx, sizeof(Md5Ctx));
     md5_init(ctx);
 
@@ -397,8 +400,8 @@ int md5_self_test(void)
     static const uint8_t H2[] = {
         0xD1, 0x74, 0xAB, 0x98, 0xD2, 0x77, 0xD9, 0xF5, 0xA5, 0x61, 0x1C, 0x2C, 0x9F, 0x41, 0x9D, 0x9F };
 
-    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1 };
-    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1 };
+    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1, false };
+    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1, false };
 
     int ret = RET_OK;
     Md5Ctx* ctx = NULL;
@@ -36,10 +36,12 @@
 
 #include <string.h>
 #include "macros-internal.h"
+#include "self-test-internal.h"
 #include "byte-utils-internal.h"
 #include "byte-array-internal.h"
 #include "pbkdf.h"
 #include "hmac.h"
+#include "hash-internal.h"
 
  //PBKDF1 && PBKDF2
  //RFC: https://www.ietf.org/rfc/rfc2898.txt
@@ -131,6 +133,8 @@ int pbkdf1(const char* pass, const ByteArray* salt, uint8_t id, size_t iter, siz
     uint8_t* pass_utf16 = NULL;
     size_t pass_utf16_len = 0;
 
+    DO(self_test_require(SELF_TEST_ID_PBKDF));
+
     CHECK_NOT_NULL(hash_ctx = hash_alloc(hash_alg));
     v = hash_get_block_size(hash_ctx);
     u = hash_get_size(hash_alg);
@@ -221,7 +225,8 @@ cleanup:
     return ret;
 }
 
-int pbkdf2(const char* pass, const ByteArray* salt, size_t iterations, size_t key_len, HashAlg hash_alg, ByteArray** dk)
+//  Straightforward PBKDF2 on top of the HMAC API, kept as reference for the self-test
+static int pbkdf2_ref(const char* pass, const ByteArray* salt, size_t iterations, size_t key_len, HashAlg hash_alg, ByteArray** dk)
 {
     int ret = RET_OK;
     ByteArray* iv = NULL;
@@ -326,6 +331,149 @@ cleanup:
     return ret;
 }
 
+#define PBKDF2_MAX_BLOCK_SIZE   144
+#define PBKDF2_MAX_HASH_SIZE    64
+
+//  Completes HMAC: work holds the inner state after the message, u receives H(K ^ opad || H(K ^ ipad || msg))
+static int pbkdf2_hmac_final(HashCtx* work, const HashCtx* outer, uint8_t* u, size_t hash_len)
+{
+    int ret = RET_OK;
+    ByteArray ba_u = { u, hash_len, false };
+
+    DO(hash_final_to_buf(work, u));
+    DO(hash_copy_state(work, outer));
+    DO(hash_update(work, &ba_u));
+    DO(hash_final_to_buf(work, u));
+
+cleanup:
+    return ret;
+}
+
+int pbkdf2(const char* pass, const ByteArray* salt, size_t iterations, size_t key_len, HashAlg hash_alg, ByteArray** dk)
+{
+    int ret = RET_OK;
+    HashCtx* inner = NULL;
+    HashCtx* outer = NULL;
+    HashCtx* work = NULL;
+    ByteArray* out = NULL;
+    ByteArray* key_hash = NULL;
+    uint8_t k_ipad[PBKDF2_MAX_BLOCK_SIZE];
+    uint8_t k_opad[PBKDF2_MAX_BLOCK_SIZE];
+    uint8_t u[PBKDF2_MAX_HASH_SIZE];
+    uint8_t t[PBKDF2_MAX_HASH_SIZE];
+    uint8_t count_buf[4];
+    ByteArray ba_pass = { NULL, 0, false };
+    ByteArray ba_ipad = { k_ipad, 0, false };
+    ByteArray ba_opad = { k_opad, 0, false };
+    ByteArray ba_count = { count_buf, sizeof(count_buf), false };
+    ByteArray ba_u = { u, 0, false };
+    const uint8_t* key = NULL;
+    size_t key_size = 0;
+    size_t block_len = 0;
+    size_t hash_len = 0;
+    size_t cplen = 0;
+    size_t i, j;
+    uint32_t count = 1;
+
+    DO(self_test_require(SELF_TEST_ID_PBKDF));
+
+    CHECK_PARAM(pass != NULL);
+    CHECK_PARAM(salt != NULL);
+    CHECK_PARAM(dk != NULL);
+
+    CHECK_NOT_NULL(inner = hash_alloc(hash_alg));
+    CHECK_NOT_NULL(outer = hash_alloc(hash_alg));
+    CHECK_NOT_NULL(work = hash_alloc(hash_alg));
+
+    block_len = hash_get_block_size(inner);
+    hash_len = hash_get_size(hash_alg);
+    if ((block_len == 0) || (block_len > PBKDF2_MAX_BLOCK_SIZE) || (hash_len == 0) || (hash_len > PBKDF2_MAX_HASH_SIZE)) {
+        SET_ERROR(RET_UNSUPPORTED);
+    }
+
+    ba_pass.buf = (uint8_t*)pass;
+    ba_pass.len = strlen(pass);
+    key = ba_pass.buf;
+    key_size = ba_pass.len;
+    if (key_size > block_len) {
+        DO(hash_update(work, &ba_pass));
+        DO(hash_final(work, &key_hash));
+        key = key_hash->buf;
+        key_size = key_hash->len;
+    }
+
+    //  The ipad/opad blocks are absorbed once, every PRF call then starts from a copy of these states
+    memset(k_ipad, 0x36, block_len);
+    memset(k_opad, 0x5c, block_len);
+    for (i = 0; i < key_size; i++) {
+        k_ipad[i] ^= key[i];
+        k_opad[i] ^= key[i];
+    }
+    ba_ipad.len = block_len;
+    ba_opad.len = block_len;
+    DO(hash_update(inner, &ba_ipad));
+    DO(hash_update(outer, &ba_opad));
+
+    CHECK_NOT_NULL(out = (key_len > 0) ? ba_alloc_by_len(key_len) : ba_alloc());
+    ba_u.len = hash_len;
+
+    /* F(P, S, c, i) = U1 xor U2 xor ... Uc
+     *
+     * U1 = PRF(P, S || i)
+     * U2 = PRF(P, U1)
+     * Uc = PRF(P, Uc-1)
+     *
+     * T_1 = F (P, S, c, 1) ,
+     * T_2 = F (P, S, c, 2) ,
+     * ...
+     * T_l = F (P, S, c, l)
+     */
+
+    while (key_len) {
+        cplen = (key_len > hash_len) ? hash_len : key_len;
+
+        count_buf[0] = (uint8_t)(count >> 24);
+        count_buf[1] = (uint8_t)(count >> 16);
+        count_buf[2] = (uint8_t)(count >> 8);
+        count_buf[3] = (uint8_t)count;
+
+        DO(hash_copy_state(work, inner));
+        DO(hash_update(work, salt));
+        DO(hash_update(work, &ba_count));
+        DO(pbkdf2_hmac_final(work, outer, u, hash_len));
+        memcpy(t, u, hash_len);
+
+        for (i = 1; i < iterations; i++) {
+            DO(hash_copy_state(work, inner));
+            DO(hash_update(work, &ba_u));
+            DO(pbkdf2_hmac_final(work, outer, u, hash_len));
+            for (j = 0; j < hash_len; j++) {
+                t[j] ^= u[j];
+            }
+        }
+
+        memcpy(out->buf + (size_t)(count - 1) * hash_len, t, cplen);
+        count++;
+        key_len -= cplen;
+    }
+
+    *dk = out;
+    out = NULL;
+
+cleanup:
+    secure_zero(k_ipad, sizeof(k_ipad));
+    secure_zero(k_opad, sizeof(k_opad));
+    secure_zero(u, sizeof(u));
+    secure_zero(t, sizeof(t));
+    hash_free(inner);
+    hash_free(outer);
+    hash_free(work);
+    ba_free_private(key_hash);
+    ba_free_private(out);
+
+    return ret;
+}
+
 int pbkdf_self_test(void)
 {
     //test vectors from rfc6070
@@ -334,10 +482,15 @@ int pbkdf_self_test(void)
     static const uint32_t iterations = 2;
     static const uint8_t test_key[] = {
         0xea, 0x6c, 0x01, 0x4d, 0xc7, 0x2d, 0x6f, 0x8c, 0xcd, 0x1e, 0xd9, 0x2a, 0xce, 0x1d, 0x41, 0xf0, 0xd8, 0xde, 0x89, 0x57 };
-    static const ByteArray salt = { (uint8_t*)_salt, 4 };
+    static const ByteArray salt = { (uint8_t*)_salt, 4, false };
+    //  Long password (hashed HMAC key), multi-block output, SHA-2 and the generic hash path
+    static const char long_pass[] = "passwordPASSWORDpasswordPASSWORDpasswordPASSWORDpasswordPASSWORDpasswordPASSWORDpasswordPASSWORDpassword";
+    static const HashAlg test_algs[] = { HASH_ALG_SHA1, HASH_ALG_SHA256, HASH_ALG_SHA512, HASH_ALG_GOST34311, HASH_ALG_DSTU7564_256 };
 
     int ret = RET_OK;
     ByteArray* key = NULL;
+    ByteArray* key_ref = NULL;
+    size_t i;
 
     DO(pbkdf2(pass, &salt, iterations, sizeof(test_key), HASH_ALG_SHA1, &key));
     if ((ba_get_len(key) != sizeof(test_key)) ||
@@ -345,7 +498,20 @@ int pbkdf_self_test(void)
         SET_ERROR(RET_SELF_TEST_FAIL);
     }
 
+    for (i = 0; i < sizeof(test_algs) / sizeof(test_algs[0]); i++) {
+        ba_free(key);
+        key = NULL;
+        DO(pbkdf2(long_pass, &salt, 3, 100, test_algs[i], &key));
+        DO(pbkdf2_ref(long_pass, &salt, 3, 100, test_algs[i], &key_ref));
+        if (ba_cmp(key, key_ref) != 0) {
+            SET_ERROR(RET_SELF_TEST_FAIL);
+        }
+        ba_free(key_ref);
+        key_ref = NULL;
+    }
+
 cleanup:
     ba_free(key);
+    ba_free(key_ref);
     return ret;
 }
@@ -203,6 +203,102 @@ int pthread_attr_destroy(pthread_attr_t* attr)
     memset(attr, 0, sizeof(pthread_attr_t));
     return 0;
 }
+
+/*
+ * Деструктори ключів викликаються через FLS-callback, який не отримує індекс
+ * ключа, тому для кожного слоту використовується окрема функція-перехідник.
+ * Слот зайнятий від pthread_key_create() до pthread_key_delete() і потім використовується знову.
+ */
+static void (* volatile key_destructors[PTHREAD_KEYS_MAX])(void *);
+static volatile DWORD key_slot_indexes[PTHREAD_KEYS_MAX];   /* FLS-індекс + 1, 0 - слот вільний */
+
+#define FLS_CALLBACK(n)                                 \
+    static VOID WINAPI fls_callback_##n(PVOID data)     \
+    {                                                   \
+        if (data && key_destructors[n]) {               \
+            key_destructors[n](data);                   \
+        }                                               \
+    }
+
+FLS_CALLBACK(0)
+FLS_CALLBACK(1)
+FLS_CALLBACK(2)
+FLS_CALLBACK(3)
+
+static PFLS_CALLBACK_FUNCTION fls_callbacks[PTHREAD_KEYS_MAX] = {
+    fls_callback_0, fls_callback_1, fls_callback_2, fls_callback_3
+};
+
+static void key_slot_release(int slot)
+{
+    key_slot_indexes[slot] = 0;
+    (void)InterlockedExchangePointer((PVOID volatile *)&key_destructors[slot], NULL);
+}
+
+int pthread_key_create(pthread_key_t *key, void (*destructor)(void *))
+{
+    PFLS_CALLBACK_FUNCTION callback = NULL;
+    DWORD index;
+    int slot = -1;
+
+    if (!key) {
+        return EINVAL;
+    }
+
+    if (destructor) {
+        for (slot = 0; slot < PTHREAD_KEYS_MAX; slot++) {
+            if (InterlockedCompareExchangePointer((PVOID volatile *)&key_destructors[slot], (PVOID)destructor, NULL) == NULL) {
+                break;
+            }
+        }
+        if (slot == PTHREAD_KEYS_MAX) {
+            return EAGAIN;
+        }
+        callback = fls_callbacks[slot];
+    }
+
+    index = FlsAlloc(callback);
+    if (index == FLS_OUT_OF_INDEXES) {
+        if (slot >= 0) {
+            key_slot_release(slot);
+        }
+        return EAGAIN;
+    }
+
+    if (slot >= 0) {
+        key_slot_indexes[slot] = index + 1;
+    }
+    *key = index;
+    return 0;
+}
+
+int pthread_key_delete(pthread_key_t key)
+{
+    int slot;
+
+    /* FlsFree() викликає деструктор для значень усіх потоків, після цього слот вільний */
+    if (!FlsFree(key)) {
+        return EINVAL;
+    }
+
+    for (slot = 0; slot < PTHREAD_KEYS_MAX; slot++) {
+        if (key_slot_indexes[slot] == key + 1) {
+            key_slot_release(slot);
+            break;
+        }
+    }
+    return 0;
+}
+
+void *pthread_getspecific(pthread_key_t key)
+{
+    return FlsGetValue(key);
+}
+
+int pthread_setspecific(pthread_key_t key, const void *value)
+{
+    return FlsSetValue(key, (PVOID)value) ? 0 : EINVAL;
+}
 #endif
 
 unsigned long pthread_id(void)
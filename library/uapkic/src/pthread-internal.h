@@ -89,6 +89,11 @@ typedef struct {
     int type;
 } pthread_mutexattr_t;
 
+/* Кількість ключів з деструктором обмежена PTHREAD_KEYS_MAX */
+#define PTHREAD_KEYS_MAX            4
+
+typedef DWORD pthread_key_t;
+
 int pthread_create(pthread_t *, const pthread_attr_t *, void *(*)(void *), void *);
 int pthread_cancel(pthread_t);
 int pthread_detach(pthread_t);
@@ -100,12 +105,46 @@ int pthread_mutex_lock(pthread_mutex_t *);
 int pthread_mutex_unlock(pthread_mutex_t *);
 int pthread_attr_init(pthread_attr_t* attr);
 int pthread_attr_destroy(pthread_attr_t* attr);
+int pthread_key_create(pthread_key_t *, void (*)(void *));
+int pthread_key_delete(pthread_key_t);
+void *pthread_getspecific(pthread_key_t);
+int pthread_setspecific(pthread_key_t, const void *);
 #else
 
 #include <pthread.h>
 #include <unistd.h>
 #endif /* _WIN32 */
 
+#include <stdint.h>
+
 unsigned long pthread_id(void);
 
+/* Атомарні операції для лічильників і прапорців, які читаються без м'ютекса */
+static __inline uint32_t atomic_load_u32(volatile uint32_t *ptr)
+{
+#ifdef _WIN32
+    return (uint32_t)InterlockedCompareExchange((volatile LONG *)ptr, 0, 0);
+#else
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static __inline void atomic_store_u32(volatile uint32_t *ptr, uint32_t value)
+{
+#ifdef _WIN32
+    (void)InterlockedExchange((volatile LONG *)ptr, (LONG)value);
+#else
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif
+}
+
+static __inline uint32_t atomic_inc_u32(volatile uint32_t *ptr)
+{
+#ifdef _WIN32
+    return (uint32_t)InterlockedIncrement((volatile LONG *)ptr);
+#else
+    return __atomic_add_fetch(ptr, 1, __ATOMIC_ACQ_REL);
+#endif
+}
+
 #endif /* PTHREAD_INTERNAL_H_ */
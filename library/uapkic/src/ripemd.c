@@ -35,6 +35,7 @@
 #include "byte-utils-internal.h"
 #include "byte-array-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 
 #define BYTES_TO_DWORD(strptr)                          \
             (( *((strptr) + 3) << 24) |                 \
@@ -652,6 +653,8 @@ RipemdCtx *ripemd_alloc(RipemdVariant mode)
     RipemdCtx *ctx = NULL;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_RIPEMD));
+
     CALLOC_CHECKED(ctx, sizeof(RipemdCtx));
     switch (mode) {
     case RIPEMD_VARIANT_128:
@@ -710,8 +713,8 @@ static int ripemd128_self_test(void)
     static const uint8_t H2[] = {
         0xD1, 0xE9, 0x59, 0xEB, 0x17, 0x9C, 0x91, 0x1F, 0xAE, 0xA4, 0x62, 0x4C, 0x60, 0xC5, 0xC7, 0x02 };
 
-    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1 };
-    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1 };
+    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1, false };
+    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1, false };
 
     int ret = RET_OK;
     RipemdCtx* ctx = NULL;
@@ -752,8 +755,8 @@ static int ripemd160_self_test(void)
         0xB0, 0xE2, 0x0B, 0x6E, 0x31, 0x16, 0x64, 0x02, 0x86, 0xED, 0x3A, 0x87, 0xA5, 0x71, 0x30, 0x79, 
         0xB2, 0x1F, 0x51, 0x89 };
 
-    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1 };
-    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1 };
+    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1, false };
+    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1, false };
 
     int ret = RET_OK;
     RipemdCtx* ctx = NULL;
@@ -35,6 +35,7 @@
 #include "math-gfp-internal.h"
 #include "byte-utils-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 #include "drbg.h"
 
 typedef enum {
@@ -433,6 +434,8 @@ RsaCtx *rsa_alloc(void)
     RsaCtx *ctx = NULL;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_RSA));
+
     CALLOC_CHECKED(ctx, sizeof(RsaCtx));
 
     ctx->e = NULL;
@@ -1504,12 +1507,12 @@ static int rsa_sign_pss_self_test(void)
         0x92, 0x25, 0xA4, 0x60, 0x83, 0x85, 0xA4, 0x17, 0xEB, 0x80, 0x58, 0x7B, 0x47, 0x02, 0x09, 0xF9,
         0x38, 0x16, 0x58, 0xA7, 0x72, 0x73, 0x9B, 0xA8, 0x2D, 0xA0, 0x18, 0xE1, 0x4A, 0xAE, 0x56, 0x4C,
         0x0A, 0x74, 0x9A, 0x05, 0xD0, 0xC1, 0xE6, 0x1C, 0x93, 0xFD, 0xE7, 0x77, 0x6D, 0x82, 0x48, 0xE6 };
-    static const ByteArray ba_n = { (uint8_t*)test_n, sizeof(test_n) };
-    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d) };
-    static const ByteArray ba_e = { (uint8_t*)test_e, sizeof(test_e) };
-    static const ByteArray ba_salt = { (uint8_t*)test_salt, sizeof(test_salt) };
-    static const ByteArray ba_m = { (uint8_t*)test_m, sizeof(test_m) };
-    static const ByteArray ba_s = { (uint8_t*)test_s, sizeof(test_s) };
+    static const ByteArray ba_n = { (uint8_t*)test_n, sizeof(test_n), false };
+    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d), false };
+    static const ByteArray ba_e = { (uint8_t*)test_e, sizeof(test_e), false };
+    static const ByteArray ba_salt = { (uint8_t*)test_salt, sizeof(test_salt), false };
+    static const ByteArray ba_m = { (uint8_t*)test_m, sizeof(test_m), false };
+    static const ByteArray ba_s = { (uint8_t*)test_s, sizeof(test_s), false };
 
     int ret = RET_OK;
     RsaCtx* rsa_ctx = NULL;
@@ -1602,11 +1605,11 @@ static int rsa_sign_pkcs_self_test(void)
         0x22, 0x95, 0xBB, 0x36, 0x5D, 0x61, 0xCF, 0xB1, 0x07, 0xE9, 0x99, 0x3B, 0xBD, 0x93, 0x42, 0x1F,
         0x2D, 0x34, 0x4A, 0x86, 0xE4, 0x12, 0x78, 0x27, 0xFA, 0x0D, 0x0B, 0x25, 0x35, 0xF9, 0xB1, 0xD5,
         0x47, 0xDE, 0x12, 0xBA, 0x28, 0x68, 0xAC, 0xDE, 0xCF, 0x2C, 0xB5, 0xF9, 0x2A, 0x6A, 0x15, 0x9A };
-    static const ByteArray ba_n = { (uint8_t*)test_n, sizeof(test_n) };
-    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d) };
-    static const ByteArray ba_e = { (uint8_t*)test_e, sizeof(test_e) };
-    static const ByteArray ba_m = { (uint8_t*)test_m, sizeof(test_m) };
-    static const ByteArray ba_s = { (uint8_t*)test_s, sizeof(test_s) };
+    static const ByteArray ba_n = { (uint8_t*)test_n, sizeof(test_n), false };
+    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d), false };
+    static const ByteArray ba_e = { (uint8_t*)test_e, sizeof(test_e), false };
+    static const ByteArray ba_m = { (uint8_t*)test_m, sizeof(test_m), false };
+    static const ByteArray ba_s = { (uint8_t*)test_s, sizeof(test_s), false };
 
     int ret = RET_OK;
     RsaCtx* rsa_ctx = NULL;
@@ -1672,12 +1675,12 @@ static int rsa_encrypt_oaep_self_test(void)
         0xD6, 0xE8, 0x81, 0xEA, 0xA9, 0x1A, 0x99, 0x61, 0x70, 0xE6, 0x57, 0xA0, 0x5A, 0x26, 0x64, 0x26, 
         0xD9, 0x8C, 0x88, 0x00, 0x3F, 0x84, 0x77, 0xC1, 0x22, 0x70, 0x94, 0xA0, 0xD9, 0xFA, 0x1E, 0x8C, 
         0x40, 0x24, 0x30, 0x9C, 0xE1, 0xEC, 0xCC, 0xB5, 0x21, 0x00, 0x35, 0xD4, 0x7A, 0xC7, 0x2E, 0x8A };
-    static const ByteArray ba_n = { (uint8_t*)test_n, sizeof(test_n) };
-    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d) };
-    static const ByteArray ba_e = { (uint8_t*)test_e, sizeof(test_e) };
-    static const ByteArray ba_m = { (uint8_t*)test_m, sizeof(test_m) };
-    static const ByteArray ba_salt = { (uint8_t*)test_salt, sizeof(test_salt) };
-    static const ByteArray ba_ct = { (uint8_t*)test_ct, sizeof(test_ct) };
+    static const ByteArray ba_n = { (uint8_t*)test_n, sizeof(test_n), false };
+    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d), false };
+    static const ByteArray ba_e = { (uint8_t*)test_e, sizeof(test_e), false };
+    static const ByteArray ba_m = { (uint8_t*)test_m, sizeof(test_m), false };
+    static const ByteArray ba_salt = { (uint8_t*)test_salt, sizeof(test_salt), false };
+    static const ByteArray ba_ct = { (uint8_t*)test_ct, sizeof(test_ct), false };
 
     int ret = RET_OK;
     RsaCtx* rsa_ctx = NULL;
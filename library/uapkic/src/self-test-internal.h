@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2023, The UAPKI Project Authors.
+ * 
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions are 
+ * met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright 
+ * notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright 
+ * notice, this list of conditions and the following disclaimer in the 
+ * documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS 
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED 
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A 
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED 
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR 
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS 
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef UAPKIC_SELF_TEST_INTERNAL_H
+#define UAPKIC_SELF_TEST_INTERNAL_H
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+//  Identifiers of the self-tests of algorithms, the index in the table of self-tests
+typedef enum {
+    SELF_TEST_ID_ENTROPY = 0,
+    SELF_TEST_ID_DRBG,
+    SELF_TEST_ID_DSTU7564,
+    SELF_TEST_ID_GOST34311,
+    SELF_TEST_ID_SHA1,
+    SELF_TEST_ID_SHA2,
+    SELF_TEST_ID_SHA3,
+    SELF_TEST_ID_WHIRLPOOL,
+    SELF_TEST_ID_SM3,
+    SELF_TEST_ID_GOSTR3411,
+    SELF_TEST_ID_RIPEMD,
+    SELF_TEST_ID_MD5,
+    SELF_TEST_ID_HMAC,
+    SELF_TEST_ID_DSTU4145,
+    SELF_TEST_ID_ECDSA,
+    SELF_TEST_ID_ECGDSA,
+    SELF_TEST_ID_ECKCDSA,
+    SELF_TEST_ID_ECRDSA,
+    SELF_TEST_ID_SM2DSA,
+    SELF_TEST_ID_RSA,
+    SELF_TEST_ID_DSTU7624,
+    SELF_TEST_ID_GOST28147,
+    SELF_TEST_ID_AES,
+    SELF_TEST_ID_3DES,
+    SELF_TEST_ID_DSTU8845,
+    SELF_TEST_ID_KEY_WRAP,
+    SELF_TEST_ID_PBKDF,
+    SELF_TEST_ID_ECDH,
+    SELF_TEST_ID_COUNT
+} SelfTestId;
+
+//  Checks that the algorithm passed the self-test, returns RET_OK or RET_SELF_TEST_FAIL.
+//  In mode SELF_TEST_MODE_DEFERRED the self-test of algorithm is run on the first call,
+//  in other modes it always returns RET_OK
+int self_test_require(SelfTestId id);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif
@@ -32,10 +32,12 @@
 #include <memory.h>
 
 #include "sha1.h"
+#include "hash-internal.h"
 
 #include "byte-utils-internal.h"
 #include "byte-array-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 
 #define SCHEDULE(i)                                                             \
     temp = schedule[(i - 3) & 0xF] ^ schedule[(i - 8) & 0xF]^               \
@@ -203,6 +205,8 @@ Sha1Ctx *sha1_alloc(void)
     Sha1Ctx *ctx = NULL;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_SHA1));
+
     CALLOC_CHECKED(ctx, sizeof(Sha1Ctx));
     DO(sha1_init(ctx));
 
@@ -271,12 +275,25 @@ cleanup:
     return ret;
 }
 
-int sha1_final(Sha1Ctx *ctx, ByteArray **hash_code)
+int sha1_copy_state(Sha1Ctx *dst, const Sha1Ctx *src)
+{
+    int ret = RET_OK;
+
+    CHECK_PARAM(dst != NULL);
+    CHECK_PARAM(src != NULL);
+
+    memcpy(dst, src, sizeof(Sha1Ctx));
+
+cleanup:
+
+    return ret;
+}
+
+int sha1_final_to_buf(Sha1Ctx *ctx, uint8_t *hash_code)
 {
     size_t i;
     size_t rem;
     uint64_t wlen;
-    ByteArray *ans = NULL;
     int ret = RET_OK;
 
     CHECK_PARAM(ctx != NULL);
@@ -301,18 +318,28 @@ int sha1_final(Sha1Ctx *ctx, ByteArray **hash_code)
 
     sha1_compress(ctx->state, ctx->msg_last_block);
 
-    OUTPUT_TRANSFORM(ctx->state, ctx->msg_last_block);
+    OUTPUT_TRANSFORM(ctx->state, hash_code);
 
-    CHECK_NOT_NULL(ans = ba_alloc_from_uint8(ctx->msg_last_block, 20));
     memset(ctx->msg_last_block, 0, 64);
     DO(sha1_init(ctx));
 
-    *hash_code = ans;
-    ans = NULL;
-
 cleanup:
 
-    ba_free(ans);
+    return ret;
+}
+
+int sha1_final(Sha1Ctx *ctx, ByteArray **hash_code)
+{
+    uint8_t digest[20];
+    int ret = RET_OK;
+
+    CHECK_PARAM(ctx != NULL);
+    CHECK_PARAM(hash_code != NULL);
+
+    DO(sha1_final_to_buf(ctx, digest));
+    CHECK_NOT_NULL(*hash_code = ba_alloc_from_uint8(digest, sizeof(digest)));
+
+cleanup:
 
     return ret;
 }
@@ -343,8 +370,8 @@ int sha1_self_test(void)
         0x76, 0x1C, 0x45, 0x7B, 0xF7, 0x3B, 0x14, 0xD2, 0x7E, 0x9E, 0x92, 0x65, 0xC4, 0x6F, 0x4B, 0x4D, 
         0xDA, 0x11, 0xF9, 0x40 };
 
-    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1 };
-    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1 };
+    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1, false };
+    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1, false };
 
     int ret = RET_OK;
     Sha1Ctx* ctx = NULL;
@@ -32,9 +32,11 @@
 #include <stddef.h>
 
 #include "sha2.h"
+#include "hash-internal.h"
 #include "byte-utils-internal.h"
 #include "byte-array-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 
 #define SHA224_DIGEST_SIZE (224 >> 3)
 #define SHA256_DIGEST_SIZE (256 >> 3)
@@ -537,17 +539,14 @@ static void sha224_update(Sha224Ctx *ctx, const ByteArray *data_ba)
     ctx->len = rem_len;
 }
 
-static int sha224_final(Sha2Ctx *ctx, ByteArray **hash_code)
+static void sha224_final(Sha2Ctx *ctx, uint8_t *digest)
 {
     Sha224Ctx *ctx224;
-    uint8_t digest[28];
     size_t block_nb;
     size_t pm_len;
-    int ret = RET_OK;
 
     ctx224 = &ctx->type.ctx224;
 
-    memset(digest, 0, 28);
     block_nb = (size_t)1 + ((SHA224_BLOCK_SIZE - 9) < (ctx224->len % SHA224_BLOCK_SIZE));
     pm_len = block_nb << 6;
     memset(&ctx224->block[ctx224->len], 0, pm_len - ctx224->len);
@@ -563,12 +562,7 @@ static int sha224_final(Sha2Ctx *ctx, ByteArray **hash_code)
     UNPACK32(ctx224->h[5], &digest[20]);
     UNPACK32(ctx224->h[6], &digest[24]);
 
-    CHECK_NOT_NULL(*hash_code = ba_alloc_from_uint8(digest, 28));
     sha224_init(ctx);
-
-cleanup:
-
-    return ret;
 }
 
 static void sha256_update(Sha256Ctx *ctx, const ByteArray *msg_ba)
@@ -603,18 +597,14 @@ static void sha256_update(Sha256Ctx *ctx, const ByteArray *msg_ba)
     ctx->len = rem_len;
 }
 
-static int sha256_final(Sha2Ctx *ctx, ByteArray **hash_code)
+static void sha256_final(Sha2Ctx *ctx, uint8_t *digest)
 {
-    int ret = RET_OK;
     Sha256Ctx *ctx256;
-    uint8_t digest[32];
     size_t block_nb;
     size_t pm_len;
 
     ctx256 = &ctx->type.ctx256;
 
-    memset(digest, 0, 32);
-
     block_nb = (size_t)1 + ((SHA256_BLOCK_SIZE - 9) < (ctx256->len % SHA256_BLOCK_SIZE));
 
     pm_len = block_nb << 6;
@@ -634,12 +624,7 @@ static int sha256_final(Sha2Ctx *ctx, ByteArray **hash_code)
     UNPACK32(ctx256->h[6], &digest[24]);
     UNPACK32(ctx256->h[7], &digest[28]);
 
-    CHECK_NOT_NULL(*hash_code = ba_alloc_from_uint8(digest, SHA256_DIGEST_SIZE));
     sha256_init(ctx);
-
-cleanup:
-
-    return ret;
 }
 
 static void sha384_update(Sha384Ctx *ctx, const ByteArray *msg_ba)
@@ -677,17 +662,14 @@ static void sha384_update(Sha384Ctx *ctx, const ByteArray *msg_ba)
     ctx->len = rem_len;
 }
 
-static int sha384_final(Sha2Ctx *ctx, ByteArray **hash_code)
+static void sha384_final(Sha2Ctx *ctx, uint8_t *digest)
 {
-    int ret = RET_OK;
     Sha384Ctx *ctx384;
-    uint8_t digest[48];
     size_t block_nb;
     size_t pm_len;
 
     ctx384 = &ctx->type.ctx384;
 
-    memset(digest, 0, 48);
     block_nb = (size_t)1 + ((SHA384_BLOCK_SIZE - 17) < (ctx384->len % SHA384_BLOCK_SIZE));
     pm_len = block_nb << 7;
     memset(ctx384->block + ctx384->len, 0, pm_len - ctx384->len);
@@ -703,12 +685,7 @@ static int sha384_final(Sha2Ctx *ctx, ByteArray **hash_code)
     UNPACK64(ctx384->h[4], &digest[32]);
     UNPACK64(ctx384->h[5], &digest[40]);
 
-    CHECK_NOT_NULL(*hash_code = ba_alloc_from_uint8(digest, SHA384_DIGEST_SIZE));
     sha384_init(ctx);
-
-cleanup:
-
-    return ret;
 }
 
 static void sha512_update(Sha512Ctx *ctx, const ByteArray *msg_ba)
@@ -747,17 +724,14 @@ static void sha512_update(Sha512Ctx *ctx, const ByteArray *msg_ba)
     ctx->len = rem_len;
 }
 
-static int sha512_final(Sha2Ctx *ctx, ByteArray **hash_code)
+static void sha512_final(Sha2Ctx *ctx, uint8_t *digest)
 {
-    int ret = RET_OK;
     Sha512Ctx *ctx512;
-    uint8_t digest[64];
     size_t block_nb;
     size_t pm_len;
 
     ctx512 = &ctx->type.ctx512;
 
-    memset(digest, 0, 64);
     block_nb = (size_t)1 + ((SHA512_BLOCK_SIZE - 17) < (ctx512->len % SHA512_BLOCK_SIZE));
     pm_len = block_nb << 7;
     memset(ctx512->block + ctx512->len, 0, pm_len - ctx512->len);
@@ -775,12 +749,7 @@ static int sha512_final(Sha2Ctx *ctx, ByteArray **hash_code)
     UNPACK64(ctx512->h[6], &digest[48]);
     UNPACK64(ctx512->h[7], &digest[56]);
 
-    CHECK_NOT_NULL(*hash_code = ba_alloc_from_uint8(digest, SHA512_DIGEST_SIZE));
     sha512_init(ctx);
-
-cleanup:
-
-    return ret;
 }
 
 Sha2Ctx *sha2_alloc(Sha2Variant variant)
@@ -788,6 +757,8 @@ Sha2Ctx *sha2_alloc(Sha2Variant variant)
     int ret = RET_OK;
     Sha2Ctx *ctx = NULL;
 
+    DO(self_test_require(SELF_TEST_ID_SHA2));
+
     CALLOC_CHECKED(ctx, sizeof(Sha2Ctx));
 
     switch (variant) {
@@ -860,30 +831,78 @@ cleanup:
     return ret;
 }
 
+int sha2_copy_state(Sha2Ctx *dst, const Sha2Ctx *src)
+{
+    int ret = RET_OK;
+
+    CHECK_PARAM(dst != NULL);
+    CHECK_PARAM(src != NULL);
+
+    memcpy(dst, src, sizeof(Sha2Ctx));
+
+cleanup:
+
+    return ret;
+}
+
+int sha2_final_to_buf(Sha2Ctx *ctx, uint8_t *out)
+{
+    int ret = RET_OK;
+
+    CHECK_PARAM(ctx != NULL);
+    CHECK_PARAM(out != NULL);
+
+    switch (ctx->variant) {
+    case SHA2_VARIANT_224:
+        sha224_final(ctx, out);
+        break;
+    case SHA2_VARIANT_256:
+        sha256_final(ctx, out);
+        break;
+    case SHA2_VARIANT_384:
+        sha384_final(ctx, out);
+        break;
+    case SHA2_VARIANT_512:
+        sha512_final(ctx, out);
+        break;
+    default:
+        SET_ERROR(RET_INVALID_CTX_MODE);
+    }
+
+cleanup:
+
+    return ret;
+}
+
 int sha2_final(Sha2Ctx* ctx, ByteArray** out)
 {
     int ret = RET_OK;
+    uint8_t digest[SHA512_DIGEST_SIZE];
+    size_t digest_len = 0;
 
     CHECK_PARAM(ctx != NULL);
     CHECK_PARAM(out != NULL);
 
     switch (ctx->variant) {
     case SHA2_VARIANT_224:
-        DO(sha224_final(ctx, out));
+        digest_len = SHA224_DIGEST_SIZE;
         break;
     case SHA2_VARIANT_256:
-        DO(sha256_final(ctx, out));
+        digest_len = SHA256_DIGEST_SIZE;
         break;
     case SHA2_VARIANT_384:
-        DO(sha384_final(ctx, out));
+        digest_len = SHA384_DIGEST_SIZE;
         break;
     case SHA2_VARIANT_512:
-        DO(sha512_final(ctx, out));
+        digest_len = SHA512_DIGEST_SIZE;
         break;
     default:
         SET_ERROR(RET_INVALID_CTX_MODE);
     }
 
+    DO(sha2_final_to_buf(ctx, digest));
+    CHECK_NOT_NULL(*out = ba_alloc_from_uint8(digest, digest_len));
+
 cleanup:
 
     return ret;
@@ -928,8 +947,8 @@ static int sha224_self_test(void)
         0x75, 0x38, 0x8B, 0x16, 0x51, 0x27, 0x76, 0xCC, 0x5D, 0xBA, 0x5D, 0xA1, 0xFD, 0x89, 0x01, 0x50, 
         0xB0, 0xC6, 0x45, 0x5C, 0xB4, 0xF5, 0x8B, 0x19, 0x52, 0x52, 0x25, 0x25 };
 
-    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1 };
-    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1 };
+    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1, false };
+    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1, false };
 
     int ret = RET_OK;
     Sha2Ctx* ctx = NULL;
@@ -970,8 +989,8 @@ static int sha256_self_test(void)
         0xDB, 0x4B, 0xFC, 0xBD, 0x4D, 0xA0, 0xCD, 0x85, 0xA6, 0x0C, 0x3C, 0x37, 0xD3, 0xFB, 0xD8, 0x80, 
         0x5C, 0x77, 0xF1, 0x5F, 0xC6, 0xB1, 0xFD, 0xFE, 0x61, 0x4E, 0xE0, 0xA7, 0xC8, 0xFD, 0xB4, 0xC0 };
 
-    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1 };
-    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1 };
+    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1, false };
+    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1, false };
 
     int ret = RET_OK;
     Sha2Ctx* ctx = NULL;
@@ -1014,8 +1033,8 @@ static int sha384_self_test(void)
         0x1A, 0x44, 0x8E, 0x3B, 0x1F, 0xAF, 0xA6, 0x40, 0x39, 0xC1, 0x46, 0x4E, 0xE8, 0x73, 0x2F, 0x11, 
         0xA5, 0x34, 0x1A, 0x6F, 0x41, 0xE0, 0xC2, 0x02, 0x29, 0x47, 0x36, 0xED, 0x64, 0xDB, 0x1A, 0x84 };
 
-    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1 };
-    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1 };
+    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1, false };
+    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1, false };
 
     int ret = RET_OK;
     Sha2Ctx* ctx = NULL;
@@ -1060,8 +1079,8 @@ static int sha512_self_test(void)
         0x5C, 0x83, 0x70, 0x58, 0x3E, 0x0A, 0x78, 0xFA, 0x4A, 0x90, 0x04, 0x1D, 0x71, 0xA4, 0xCE, 0xAB, 
         0x74, 0x23, 0xF1, 0x9C, 0x71, 0xB9, 0xD5, 0xA3, 0xE0, 0x12, 0x49, 0xF0, 0xBE, 0xBD, 0x58, 0x94 };
 
-    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1 };
-    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1 };
+    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1, false };
+    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1, false };
 
     int ret = RET_OK;
     Sha2Ctx* ctx = NULL;
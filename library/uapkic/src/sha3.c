@@ -34,6 +34,7 @@
 #include "byte-utils-internal.h"
 #include "byte-array-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 
 struct Sha3Ctx_st {
     uint64_t s[25];
@@ -145,6 +146,8 @@ Sha3Ctx* sha3_alloc(Sha3Variant variant)
     int ret = RET_OK;
     Sha3Ctx* ctx = NULL;
 
+    DO(self_test_require(SELF_TEST_ID_SHA3));
+
     CALLOC_CHECKED(ctx, sizeof(Sha3Ctx));
 
     switch (variant) {
@@ -386,7 +389,7 @@ static const uint8_t sha3_1600_bit_test[] = {
     0xa3, 0xa3, 0xa3, 0xa3, 0xa3, 0xa3, 0xa3, 0xa3
 };
 
-static const ByteArray ba_M2 = { (uint8_t*)sha3_1600_bit_test, sizeof(sha3_1600_bit_test) };
+static const ByteArray ba_M2 = { (uint8_t*)sha3_1600_bit_test, sizeof(sha3_1600_bit_test), false };
 
 static int sha3_224_self_test(void)
 {
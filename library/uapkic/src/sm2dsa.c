@@ -33,6 +33,7 @@
 #include "ec-cache-internal.h"
 #include "math-int-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 #include "sm3.h"
 
 int sm2dsa_generate_privkey(const EcCtx *ctx, ByteArray **d)
@@ -210,6 +211,8 @@ int sm2dsa_sign(const EcCtx* ctx, const ByteArray* H, ByteArray** r, ByteArray**
     const WordArray* q;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_SM2DSA));
+
     CHECK_PARAM(ctx != NULL);
     CHECK_PARAM(H != NULL);
     CHECK_PARAM(r != NULL);
@@ -248,6 +251,8 @@ int sm2dsa_verify(const EcCtx *ctx, const ByteArray *H, const ByteArray *R, cons
     const WordArray *q;
     int ret = RET_OK;
 
+    DO(self_test_require(SELF_TEST_ID_SM2DSA));
+
     CHECK_PARAM(ctx != NULL);
     CHECK_PARAM(H != NULL);
     CHECK_PARAM(R != NULL);
@@ -426,8 +431,8 @@ cleanup:
 
 static const uint8_t test_Msg[] = "message digest";
 static const uint8_t test_ID[] = "ALICE123@YAHOO.COM";
-static const ByteArray ba_Msg = { (uint8_t*)test_Msg, sizeof(test_Msg) - 1 };
-static const ByteArray ba_ID = { (uint8_t*)test_ID, sizeof(test_ID) - 1 };
+static const ByteArray ba_Msg = { (uint8_t*)test_Msg, sizeof(test_Msg) - 1, false };
+static const ByteArray ba_ID = { (uint8_t*)test_ID, sizeof(test_ID) - 1, false };
 
 static int sm2dsa_p_self_test(void)
 {
@@ -454,7 +459,7 @@ static int sm2dsa_p_self_test(void)
         0xB5, 0x24, 0xF5, 0x52, 0xCD, 0x82, 0xB8, 0xB0, 0x28, 0x47, 0x6E, 0x00, 0x5C, 0x37, 0x7F, 0xB1,
         0x9A, 0x87, 0xE6, 0xFC, 0x68, 0x2D, 0x48, 0xBB, 0x5D, 0x42, 0xE3, 0xD9, 0xB9, 0xEF, 0xFE, 0x76 };
 
-    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d) };
+    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d), false };
 
     int ret = RET_OK;
     EcCtx* ec_ctx = NULL;
@@ -536,7 +541,7 @@ static int sm2dsa_b_self_test(void)
         0xAD, 0x67, 0x3C, 0xBD, 0xA3, 0x11, 0x41, 0x71, 0x29, 0xA9, 0xEA, 0xA5, 0xF9, 0xAB, 0x1A, 0xA1, 
         0x63, 0x3A, 0xD4, 0x77, 0x18, 0xA8, 0x4D, 0xFD, 0x46, 0xC1, 0x7C, 0x6F, 0xA0, 0xAA, 0x3B, 0x12 };
 
-    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d) };
+    static const ByteArray ba_d = { (uint8_t*)test_d, sizeof(test_d), false };
 
     int ret = RET_OK;
     EcCtx* ec_ctx = NULL;
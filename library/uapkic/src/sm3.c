@@ -34,6 +34,7 @@
 #include "byte-utils-internal.h"
 #include "byte-array-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 
 struct Sm3Ctx_st {
     uint32_t total[2];
@@ -187,10 +188,16 @@ static void sm3_process(Sm3Ctx* ctx, const uint8_t data[64])
 
 Sm3Ctx* sm3_alloc(void)
 {
-    Sm3Ctx *ctx = calloc(1, sizeof(Sm3Ctx));
-    if (ctx) {
-        sm3_init(ctx);
-    }
+    Sm3Ctx *ctx = NULL;
+    int ret = RET_OK;
+
+    DO(self_test_require(SELF_TEST_ID_SM3));
+
+    CALLOC_CHECKED(ctx, sizeof(Sm3Ctx));
+    sm3_init(ctx);
+
+cleanup:
+
     return ctx;
 }
 
@@ -320,8 +327,8 @@ int sm3_self_test(void)
         0xDE, 0xBE, 0x9F, 0xF9, 0x22, 0x75, 0xB8, 0xA1, 0x38, 0x60, 0x48, 0x89, 0xC1, 0x8E, 0x5A, 0x4D, 
         0x6F, 0xDB, 0x70, 0xE5, 0x38, 0x7E, 0x57, 0x65, 0x29, 0x3D, 0xCB, 0xA3, 0x9C, 0x0C, 0x57, 0x32 };
 
-    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1 };
-    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1 };
+    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1, false };
+    static const ByteArray ba_M2 = { (uint8_t*)M2, sizeof(M2) - 1, false };
 
     int ret = RET_OK;
     Sm3Ctx* ctx = NULL;
@@ -27,60 +27,199 @@
  
 #define FILE_MARKER "uapkic/uapkic.c"
 
+#include <string.h>
+
 #include "uapkic.h"
 #include "macros-internal.h"
+#include "pthread-internal.h"
+#include "self-test-internal.h"
+
+#define SELF_TEST_MAX_THREADS   8
+
+#define SELF_TEST_STATE_NOT_RUN 0
+#define SELF_TEST_STATE_PASSED  1
+#define SELF_TEST_STATE_FAILED  2
+
+typedef int (*self_test_fn)(void);
+
+typedef struct SelfTestEntry_st {
+	self_test_fn test;
+	uint32_t fail_flag;
+} SelfTestEntry;
+
+//  Indexed by SelfTestId
+static const SelfTestEntry self_tests[SELF_TEST_ID_COUNT] = {
+	// ENTROPY
+	{ entropy_self_test, SELF_TEST_ENTROPY_FAIL },
+	// DRBG-HMAC-SHA-512
+	{ drbg_self_test, SELF_TEST_DRBG_FAIL },
+	// HASHES
+	{ dstu7564_self_test, SELF_TEST_DSTU7564_FAIL },
+	{ gost34311_self_test, SELF_TEST_DSTU7564_FAIL },
+	{ sha1_self_test, SELF_TEST_SHA1_FAIL },
+	{ sha2_self_test, SELF_TEST_SHA2_FAIL },
+	{ sha3_self_test, SELF_TEST_SHA3_FAIL },
+	{ whirlpool_self_test, SELF_TEST_WHIRLPOOL_FAIL },
+	{ sm3_self_test, SELF_TEST_SM3_FAIL },
+	{ gostr3411_self_test, SELF_TEST_GOSTR3411_FAIL },
+	{ ripemd_self_test, SELF_TEST_RIPEMD_FAIL },
+	{ md5_self_test, SELF_TEST_MD5_FAIL },
+	// HMAC
+	{ hmac_self_test, SELF_TEST_HMAC_FAIL },
+	// SIGNATURES
+	{ dstu4145_self_test, SELF_TEST_DSTU4145_FAIL },
+	{ ecdsa_self_test, SELF_TEST_ECDSA_FAIL },
+	{ ecgdsa_self_test, SELF_TEST_ECGDSA_FAIL },
+	{ eckcdsa_self_test, SELF_TEST_ECKCDSA_FAIL },
+	{ ecrdsa_self_test, SELF_TEST_ECRDSA_FAIL },
+	{ sm2dsa_self_test, SELF_TEST_SM2DSA_FAIL },
+	{ rsa_self_test, SELF_TEST_RSA_FAIL },
+	// CIPHER
+	{ dstu7624_self_test, SELF_TEST_DSTU7624_FAIL },
+	{ gost28147_self_test, SELF_TEST_GOST28147_FAIL },
+	{ aes_self_test, SELF_TEST_AES_FAIL },
+	{ des3_self_test, SELF_TEST_3DES_FAIL },
+	{ dstu8845_self_test, SELF_TEST_DSTU8845_FAIL },
+	// UKRAINE KEY WRAP
+	{ key_wrap_self_test, SELF_TEST_KEY_WRAP_FAIL },
+	// PBKDF
+	{ pbkdf_self_test, SELF_TEST_PBKDF_FAIL },
+	// ECDH
+	{ ec_dh_self_test, SELF_TEST_ECDH_FAIL }
+};
+
+static volatile SelfTestMode self_test_mode = SELF_TEST_MODE_SERIAL;
+static volatile int self_test_state[SELF_TEST_ID_COUNT] = { 0 };
+static volatile uint32_t self_test_total_status = 0;
+static volatile unsigned long self_test_owner = 0;
+static pthread_mutex_t self_test_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void self_test_set_result(SelfTestId id, int ret)
+{
+	self_test_state[id] = (ret == RET_OK) ? SELF_TEST_STATE_PASSED : SELF_TEST_STATE_FAILED;
+	if (ret != RET_OK) {
+		self_test_total_status |= self_tests[id].fail_flag;
+	}
+}
 
 uint32_t uapkic_self_test(void)
 {
 	uint32_t test_status = 0;
+	size_t i;
 
-	// ENTROPY
-	if (entropy_self_test() != RET_OK) test_status |= SELF_TEST_ENTROPY_FAIL;
+	for (i = 0; i < SELF_TEST_ID_COUNT; i++) {
+		if (self_tests[i].test() != RET_OK) test_status |= self_tests[i].fail_flag;
+	}
 
-	// DRBG-HMAC-SHA-512
-	if (drbg_self_test() != RET_OK) test_status |= SELF_TEST_DRBG_FAIL;
+	return test_status;
+}
 
-	// HASHES
-	if (dstu7564_self_test() != RET_OK) test_status |= SELF_TEST_DSTU7564_FAIL;
-	if (gost34311_self_test() != RET_OK) test_status |= SELF_TEST_DSTU7564_FAIL;
-	if (sha1_self_test() != RET_OK) test_status |= SELF_TEST_SHA1_FAIL;
-	if (sha2_self_test() != RET_OK) test_status |= SELF_TEST_SHA2_FAIL;
-	if (sha3_self_test() != RET_OK) test_status |= SELF_TEST_SHA3_FAIL;
-	if (whirlpool_self_test() != RET_OK) test_status |= SELF_TEST_WHIRLPOOL_FAIL;
-	if (sm3_self_test() != RET_OK) test_status |= SELF_TEST_SM3_FAIL;
-	if (gostr3411_self_test() != RET_OK) test_status |= SELF_TEST_GOSTR3411_FAIL;
-	if (ripemd_self_test() != RET_OK) test_status |= SELF_TEST_RIPEMD_FAIL;
-	if (md5_self_test() != RET_OK) test_status |= SELF_TEST_MD5_FAIL;
+typedef struct SelfTestPool_st {
+	pthread_mutex_t mutex;
+	size_t next;
+	uint32_t status;
+} SelfTestPool;
 
-	// HMAC
-	if (hmac_self_test() != RET_OK) test_status |= SELF_TEST_HMAC_FAIL;
+static void* self_test_worker(void* arg)
+{
+	SelfTestPool* pool = (SelfTestPool*)arg;
+	size_t i;
+	int ret;
 
-	// SIGNATURES
-	if (dstu4145_self_test() != RET_OK) test_status |= SELF_TEST_DSTU4145_FAIL;
-	if (ecdsa_self_test() != RET_OK) test_status |= SELF_TEST_ECDSA_FAIL;
-	if (ecgdsa_self_test() != RET_OK) test_status |= SELF_TEST_ECGDSA_FAIL;
-	if (eckcdsa_self_test() != RET_OK) test_status |= SELF_TEST_ECKCDSA_FAIL;
-	if (ecrdsa_self_test() != RET_OK) test_status |= SELF_TEST_ECRDSA_FAIL;
-	if (sm2dsa_self_test() != RET_OK) test_status |= SELF_TEST_SM2DSA_FAIL;
-	if (rsa_self_test() != RET_OK) test_status |= SELF_TEST_RSA_FAIL;
+	for (;;) {
+		pthread_mutex_lock(&pool->mutex);
+		i = pool->next++;
+		pthread_mutex_unlock(&pool->mutex);
+		if (i >= SELF_TEST_ID_COUNT) {
+			break;
+		}
 
-	// CIPHER
-	if (dstu7624_self_test() != RET_OK) test_status |= SELF_TEST_DSTU7624_FAIL;
-	if (gost28147_self_test() != RET_OK) test_status |= SELF_TEST_GOST28147_FAIL;
-	if (aes_self_test() != RET_OK) test_status |= SELF_TEST_AES_FAIL;
-	if (des3_self_test() != RET_OK) test_status |= SELF_TEST_3DES_FAIL;
-	if (dstu8845_self_test() != RET_OK) test_status |= SELF_TEST_DSTU8845_FAIL;
+		ret = self_tests[i].test();
 
-	// UKRAINE KEY WRAP
-	if (key_wrap_self_test() != RET_OK) test_status |= SELF_TEST_KEY_WRAP_FAIL;
+		pthread_mutex_lock(&pool->mutex);
+		if (ret != RET_OK) {
+			pool->status |= self_tests[i].fail_flag;
+		}
+		pthread_mutex_unlock(&pool->mutex);
+	}
 
-	// PBKDF
-	if (pbkdf_self_test() != RET_OK) test_status |= SELF_TEST_PBKDF_FAIL;
+	return NULL;
+}
 
-	// PBKDF
-	if (ec_dh_self_test() != RET_OK) test_status |= SELF_TEST_ECDH_FAIL;
+static size_t self_test_cpu_count(void)
+{
+	long cpus = 1;
 
-	return test_status;
+#ifdef _WIN32
+	SYSTEM_INFO si;
+	GetSystemInfo(&si);
+	cpus = (long)si.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+	cpus = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+	return (cpus > 0) ? (size_t)cpus : 1;
+}
+
+static uint32_t uapkic_self_test_parallel(void)
+{
+	SelfTestPool pool;
+	pthread_t threads[SELF_TEST_MAX_THREADS - 1];
+	size_t threads_count = self_test_cpu_count();
+	size_t started = 0;
+	size_t i;
+
+	if (threads_count > SELF_TEST_MAX_THREADS) {
+		threads_count = SELF_TEST_MAX_THREADS;
+	}
+
+	memset(&pool, 0, sizeof(pool));
+	pthread_mutex_init(&pool.mutex, NULL);
+
+	//  The calling thread is a worker too, a failed pthread_create only reduces parallelism
+	for (i = 1; i < threads_count; i++) {
+		if (pthread_create(&threads[started], NULL, self_test_worker, &pool) == 0) {
+			started++;
+		}
+	}
+
+	self_test_worker(&pool);
+
+	for (i = 0; i < started; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	pthread_mutex_destroy(&pool.mutex);
+
+	return pool.status;
+}
+
+int self_test_require(SelfTestId id)
+{
+	int state;
+
+	if ((self_test_mode != SELF_TEST_MODE_DEFERRED) || (id >= SELF_TEST_ID_COUNT)) {
+		return RET_OK;
+	}
+
+	state = self_test_state[id];
+	if (state == SELF_TEST_STATE_NOT_RUN) {
+		//  Algorithms used inside a running self-test are not gated again
+		if (self_test_owner == pthread_id()) {
+			return RET_OK;
+		}
+
+		pthread_mutex_lock(&self_test_mutex);
+		if (self_test_state[id] == SELF_TEST_STATE_NOT_RUN) {
+			self_test_owner = pthread_id();
+			self_test_set_result(id, self_tests[id].test());
+			self_test_owner = 0;
+		}
+		state = self_test_state[id];
+		pthread_mutex_unlock(&self_test_mutex);
+	}
+
+	return (state == SELF_TEST_STATE_PASSED) ? RET_OK : RET_SELF_TEST_FAIL;
 }
 
 int drbg_init(void);
@@ -97,6 +236,7 @@ int uapkic_init(uint32_t *version, uint32_t* self_test_status)
 
 	if (self_test_status) {
 		*self_test_status = uapkic_self_test();
+		self_test_total_status = *self_test_status;
 	}
 
 	if (initialized == 0) {
@@ -111,3 +251,69 @@ int uapkic_init(uint32_t *version, uint32_t* self_test_status)
 cleanup:
 	return ret;
 }
+
+int uapkic_init_ex(uint32_t* version, SelfTestMode mode, uint32_t* self_test_status)
+{
+	int ret = RET_OK;
+	uint32_t status = 0;
+	size_t i;
+
+	if (version) {
+		*version = UAPKIC_VERSION;
+	}
+
+	switch (mode) {
+	case SELF_TEST_MODE_SERIAL:
+		status = uapkic_self_test();
+		break;
+	case SELF_TEST_MODE_PARALLEL:
+		status = uapkic_self_test_parallel();
+		break;
+	case SELF_TEST_MODE_DEFERRED:
+		pthread_mutex_lock(&self_test_mutex);
+		self_test_total_status = 0;
+		for (i = 0; i < SELF_TEST_ID_COUNT; i++) {
+			self_test_state[i] = SELF_TEST_STATE_NOT_RUN;
+		}
+		//  Entropy source and DRBG are instantiated right here, so they are tested now.
+		//  The mutex is held, the algorithms used by these tests are not gated (mode can be DEFERRED already)
+		self_test_owner = pthread_id();
+		self_test_set_result(SELF_TEST_ID_ENTROPY, self_tests[SELF_TEST_ID_ENTROPY].test());
+		self_test_set_result(SELF_TEST_ID_DRBG, self_tests[SELF_TEST_ID_DRBG].test());
+		self_test_owner = 0;
+		status = self_test_total_status;
+		self_test_mode = mode;
+		pthread_mutex_unlock(&self_test_mutex);
+		break;
+	default:
+		SET_ERROR(RET_INVALID_PARAM);
+	}
+
+	if (mode != SELF_TEST_MODE_DEFERRED) {
+		pthread_mutex_lock(&self_test_mutex);
+		self_test_mode = mode;
+		self_test_total_status = status;
+		pthread_mutex_unlock(&self_test_mutex);
+	}
+
+	if (self_test_status) {
+		*self_test_status = status;
+	}
+
+	if (initialized == 0) {
+		DO(drbg_init());
+		initialized = 1;
+	}
+
+	if (status != 0) {
+		SET_ERROR(RET_SELF_TEST_FAIL);
+	}
+
+cleanup:
+	return ret;
+}
+
+uint32_t uapkic_get_self_test_status(void)
+{
+	return self_test_total_status;
+}
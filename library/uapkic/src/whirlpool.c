@@ -34,6 +34,7 @@
 #include "byte-utils-internal.h"
 #include "byte-array-internal.h"
 #include "macros-internal.h"
+#include "self-test-internal.h"
 
 struct WhirlpoolCtx_st {
     uint64_t length, state[8];
@@ -194,7 +195,16 @@ static void whirlpool_compress(WhirlpoolCtx* ctx)
 
 WhirlpoolCtx* whirlpool_alloc(void)
 {
-    return calloc(1, sizeof(WhirlpoolCtx));
+    WhirlpoolCtx* ctx = NULL;
+    int ret = RET_OK;
+
+    DO(self_test_require(SELF_TEST_ID_WHIRLPOOL));
+
+    CALLOC_CHECKED(ctx, sizeof(WhirlpoolCtx));
+
+cleanup:
+
+    return ctx;
 }
 
 WhirlpoolCtx* whirlpool_copy_with_alloc(const WhirlpoolCtx* ctx)
@@ -303,7 +313,7 @@ int whirlpool_self_test(void)
         0x71, 0x81, 0xEE, 0xBD, 0xB6, 0xC5, 0x7E, 0x27, 0x7D, 0x0E, 0x34, 0x95, 0x71, 0x14, 0xCB, 0xD6, 
         0xC7, 0x97, 0xFC, 0x9D, 0x95, 0xD8, 0xB5, 0x82, 0xD2, 0x25, 0x29, 0x20, 0x76, 0xD4, 0xEE, 0xF5 };
 
-    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1 };
+    static const ByteArray ba_M1 = { (uint8_t*)M1, sizeof(M1) - 1, false };
 
     int ret = RET_OK;
     WhirlpoolCtx* ctx = NULL;
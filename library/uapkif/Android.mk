@@ -26,6 +26,10 @@ LOCAL_C_INCLUDES += \
 
 SRC_ASN1_FILES := \
 	$(DIR_SRC_ASN1)/ANY.c \
+	$(DIR_SRC_ASN1)/asn1-arena.c \
+	$(DIR_SRC_ASN1)/asn1-descriptors.c \
+	$(DIR_SRC_ASN1)/asn1-fast-decoders.c \
+	$(DIR_SRC_ASN1)/asn1-tlv.c \
 	$(DIR_SRC_ASN1)/asn1-utils.c \
 	$(DIR_SRC_ASN1)/asn_codecs_prim.c \
 	$(DIR_SRC_ASN1)/asn_SEQUENCE_OF.c \
@@ -41,6 +41,8 @@ extern "C" {
 /** Ошибка декодирования из байт. */
 #define RET_ASN1_DECODE_ERROR                    102
 #define RET_ASN1_TIME_ERROR                      103
+/** Элемент с заданным тегом не найден. */
+#define RET_ASN1_NOT_FOUND                       104
 
 #ifdef __cplusplus
 }
@@ -88,6 +88,206 @@ UAPKIF_EXPORT void *asn_decode_with_alloc(asn_TYPE_descriptor_t *desc, const voi
 
 UAPKIF_EXPORT void *asn_decode_ba_with_alloc(asn_TYPE_descriptor_t *desc, const ByteArray *encoded);
 
+#if defined(UAPKI_TEST_INTERNAL)
+/**
+ * Только для проверок (библиотека собрана с UAPKI_TEST_INTERNAL): включает или выключает
+ * быстрые декодеры часто используемых PKIX-типов (Certificate, BasicOCSPResponse, SignerInfo,
+ * TSTInfo и др.) для сравнения с общим BER-декодером. Действует только в вызывающем потоке.
+ *
+ * @param enabled     true - использовать быстрые декодеры
+ */
+UAPKIF_EXPORT void asn_set_fast_decoders(bool enabled);
+#endif
+
+/**
+ * Заполняет дескрипторы типов, определенных через другой тип (например, KeyIdentifier ::= OCTET STRING).
+ * Сгенерированные кодеки копируют поля базового дескриптора в свой при первом вызове,
+ * поэтому перед параллельным декодированием в нескольких потоках нужно вызвать эту функцию.
+ * Выполняется один раз, вызов потокобезопасен.
+ */
+UAPKIF_EXPORT void asn_init_descriptors(void);
+
+/**
+ * Арена (bump-pointer) для декодирования ASN.1 структур.
+ * Все узлы дерева размещаются в арене и освобождаются одним вызовом asn_arena_free().
+ */
+typedef struct AsnArena_st AsnArena;
+
+/**
+ * Создает арену.
+ *
+ * @param size_hint   ожидаемый объем данных (размер первого блока), 0 - по умолчанию
+ *
+ * @return указатель на арену или NULL
+ */
+UAPKIF_EXPORT AsnArena *asn_arena_alloc(size_t size_hint);
+
+/**
+ * Освобождает арену вместе со всеми декодированными в нее объектами.
+ *
+ * @param arena       арена
+ */
+UAPKIF_EXPORT void asn_arena_free(AsnArena *arena);
+
+/**
+ * Декодирует BER-представление в новый объект, размещенный в арене.
+ * Объект доступен только для чтения и живет до вызова asn_arena_free():
+ * asn_free() оставляет его без изменений, память арены не освобождается через FREEMEM,
+ * а ее перераспределение (например, asn_bytes2OCTSTRING(), ASN_SEQUENCE_ADD) завершается ошибкой.
+ * Для изменения объект нужно скопировать в кучу через asn_copy_with_alloc().
+ * При ошибке арена возвращается в исходное состояние.
+ *
+ * @param desc        дескриптор объекта
+ * @param arena       арена
+ * @param encode      указатель буфер содержащий BER-представление структуры.
+ * @param encode_len  размер буфер
+ *
+ * @return указатель на объект или NULL
+ */
+UAPKIF_EXPORT const void *asn_decode_arena(asn_TYPE_descriptor_t *desc, AsnArena *arena, const void *encode, size_t encode_len);
+
+UAPKIF_EXPORT const void *asn_decode_ba_arena(asn_TYPE_descriptor_t *desc, AsnArena *arena, const ByteArray *encoded);
+
+/**
+ * Декодирует BER-представление в арену без копирования содержимого примитивов.
+ * Поля buf у OCTET STRING, INTEGER, ENUMERATED, OBJECT IDENTIFIER и ANY указывают прямо в буфер encode,
+ * поэтому буфер должен существовать, пока не освобождена арена.
+ * Такие buf не завершаются нулевым байтом (buf[size] - следующий байт encode),
+ * их читают только с учетом size (asn_OCTSTRING2ba(), asn_INTEGER2ba(), asn_oid_to_text()).
+ * Символьные строки и BIT STRING копируются в арену и завершаются нулевым байтом.
+ * ByteArray, созданный ba_alloc_view() поверх buf, зависит от буфера encode, а не от арены.
+ * Буфер, как и память арены, защищен от освобождения и изменения объекта (см. asn_decode_arena()).
+ *
+ * @param desc        дескриптор объекта
+ * @param arena       арена
+ * @param encode      указатель буфер содержащий BER-представление структуры.
+ * @param encode_len  размер буфер
+ *
+ * @return указатель на объект или NULL
+ */
+UAPKIF_EXPORT const void *asn_decode_arena_view(asn_TYPE_descriptor_t *desc, AsnArena *arena, const void *encode, size_t encode_len);
+
+UAPKIF_EXPORT const void *asn_decode_ba_arena_view(asn_TYPE_descriptor_t *desc, AsnArena *arena, const ByteArray *encoded);
+
+/**
+ * Элемент DER-представления (TLV), найденный курсором.
+ * Все указатели ссылаются на разбираемый буфер, память не выделяется.
+ * Тег - октеты идентификатора (класс, признак составного типа и номер) в порядке big-endian,
+ * например 0x30 для SEQUENCE, 0xA0 для [0] EXPLICIT, 0x9F2A для [PRIVATE 42].
+ */
+typedef struct AsnTlv_st {
+    uint32_t tag;
+    const uint8_t *tlv;         /* начало элемента (тег) */
+    size_t tlv_len;             /* полный размер элемента */
+    const uint8_t *value;       /* начало содержимого */
+    size_t len;                 /* размер содержимого */
+} AsnTlv;
+
+/**
+ * Курсор для последовательного обхода элементов DER-представления без декодирования.
+ * Поддерживается только определенная форма длины, выход за границы буфера невозможен.
+ */
+typedef struct AsnTlvCursor_st {
+    const uint8_t *buf;
+    size_t size;
+    size_t pos;
+} AsnTlvCursor;
+
+/** Признак составного типа (SEQUENCE, SET, [n] EXPLICIT, ...). */
+#define ASN_TLV_IS_CONSTRUCTED(item)    ((((item)->tlv[0]) & 0x20) != 0)
+
+/**
+ * Разбирает элемент в начале буфера. Элемент должен полностью помещаться в буфер,
+ * остаток буфера после элемента допускается.
+ *
+ * @param buf         буфер
+ * @param size        размер буфера
+ * @param tlv         найденный элемент
+ *
+ * @return код ошибки (RET_ASN1_DECODE_ERROR - элемент поврежден или выходит за границы буфера)
+ */
+UAPKIF_EXPORT int asn_tlv_read(const uint8_t *buf, size_t size, AsnTlv *tlv);
+
+/**
+ * Устанавливает курсор на начало буфера.
+ *
+ * @param cursor      курсор
+ * @param buf         буфер, должен существовать во время обхода
+ * @param size        размер буфера
+ */
+UAPKIF_EXPORT void asn_tlv_cursor_init(AsnTlvCursor *cursor, const uint8_t *buf, size_t size);
+
+/**
+ * Устанавливает курсор на начало содержимого составного элемента.
+ *
+ * @param cursor      курсор
+ * @param tlv         составной элемент
+ *
+ * @return код ошибки (RET_ASN1_DECODE_ERROR - элемент не составной)
+ */
+UAPKIF_EXPORT int asn_tlv_enter(AsnTlvCursor *cursor, const AsnTlv *tlv);
+
+/**
+ * Проверяет, пройдены ли все элементы.
+ *
+ * @param cursor      курсор
+ *
+ * @return true - элементов больше нет
+ */
+UAPKIF_EXPORT bool asn_tlv_cursor_end(const AsnTlvCursor *cursor);
+
+/**
+ * Возвращает текущий элемент, не сдвигая курсор.
+ *
+ * @param cursor      курсор
+ * @param tlv         текущий элемент
+ *
+ * @return код ошибки (RET_ASN1_DECODE_ERROR - элементов нет или элемент поврежден)
+ */
+UAPKIF_EXPORT int asn_tlv_peek(const AsnTlvCursor *cursor, AsnTlv *tlv);
+
+/**
+ * Возвращает текущий элемент и сдвигает курсор на следующий.
+ *
+ * @param cursor      курсор
+ * @param tlv         текущий элемент, может быть NULL
+ *
+ * @return код ошибки (RET_ASN1_DECODE_ERROR - элементов нет или элемент поврежден)
+ */
+UAPKIF_EXPORT int asn_tlv_next(AsnTlvCursor *cursor, AsnTlv *tlv);
+
+/**
+ * Пропускает текущий элемент.
+ *
+ * @param cursor      курсор
+ *
+ * @return код ошибки
+ */
+UAPKIF_EXPORT int asn_tlv_skip(AsnTlvCursor *cursor);
+
+/**
+ * Ищет среди оставшихся элементов первый элемент с заданным тегом,
+ * предшествующие элементы пропускаются. Курсор устанавливается за найденный элемент.
+ *
+ * @param cursor      курсор
+ * @param tag         тег
+ * @param tlv         найденный элемент, может быть NULL
+ *
+ * @return код ошибки (RET_ASN1_NOT_FOUND - элемент не найден, курсор в конце)
+ */
+UAPKIF_EXPORT int asn_tlv_find_tag(AsnTlvCursor *cursor, uint32_t tag, AsnTlv *tlv);
+
+/**
+ * Возвращает элемент в виде ByteArray без копирования данных (см. ba_alloc_view()).
+ * ByteArray ссылается на разбираемый буфер и должен быть освобожден раньше него.
+ * Выделяемая память требует освобождения.
+ *
+ * @param tlv         элемент
+ *
+ * @return ByteArray с полным DER-представлением элемента или NULL
+ */
+UAPKIF_EXPORT ByteArray *asn_tlv_to_ba_view(const AsnTlv *tlv);
+
 /**
  * Создает копию ASN.1 объекта заданного типа.
  *
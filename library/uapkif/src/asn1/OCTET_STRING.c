@@ -197,6 +197,35 @@ _new_stack(void)
 /*
  * Decode OCTET STRING type.
  */
+/*
+ * Only OCTET STRING and ANY may refer to the source bytes:
+ * character strings are expected to be nul-terminated, BIT STRING is modified in place.
+ * Character strings end with the OCTET STRING tag too, they are recognized by their own universal tag.
+ */
+static int
+OS__can_borrow(asn_TYPE_descriptor_t *td, enum asn_OS_Subvariant type_variant)
+{
+    int i;
+
+    switch (type_variant) {
+    case ASN_OSUBV_ANY:
+        return 1;
+    case ASN_OSUBV_STR:
+        if (td->all_tags_count == 0
+                || td->all_tags[td->all_tags_count - 1] != (ASN_TAG_CLASS_UNIVERSAL | (4 << 2))) {
+            return 0;
+        }
+        for (i = 0; i < td->all_tags_count - 1; i++) {
+            if (BER_TAG_CLASS(td->all_tags[i]) == ASN_TAG_CLASS_UNIVERSAL) {
+                return 0;
+            }
+        }
+        return 1;
+    default:
+        return 0;
+    }
+}
+
 asn_dec_rval_t
 OCTET_STRING_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
         asn_TYPE_descriptor_t *td,
@@ -256,6 +285,25 @@ OCTET_STRING_decode_ber(asn_codec_ctx_t *opt_codec_ctx,
                 RETURN(RC_FAIL);
             }
         } else {
+            /*
+             * Refer to the source bytes when decoding in the view mode.
+             */
+            if (OS__can_borrow(td, type_variant) && !st->buf
+                    && (size - rval.consumed >= (size_t)ctx->left)) {
+                size_t hdr = (type_variant == ASN_OSUBV_ANY && tag_mode != 1)
+                        ? (size_t)rval.consumed : 0;
+                const void *view = asn_mem_borrow(
+                        (const char *)buf_ptr + rval.consumed - hdr,
+                        hdr + (size_t)ctx->left);
+                if (view) {
+                    st->buf = (uint8_t *)view;
+                    st->size = (int)(hdr + (size_t)ctx->left);
+                    ADVANCE(rval.consumed + ctx->left);
+                    ctx->left = 0;
+                    _CH_PHASE(ctx, 4);
+                    RETURN(RC_OK);
+                }
+            }
             /*
              * Jump into stackless primitive decoding.
              */
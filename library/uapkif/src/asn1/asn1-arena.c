@@ -0,0 +1,543 @@
+/*
+ * Copyright (c) 2023, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define FILE_MARKER "uapkif/asn1/asn1-arena.c"
+
+#include "asn1-utils.h"
+#include "asn_internal.h"
+#include "macros-internal.h"
+
+#if defined(_MSC_VER)
+#define ASN_ARENA_TLS __declspec(thread)
+#else
+#define ASN_ARENA_TLS __thread
+#endif
+
+#if defined(_WIN32)
+#include <windows.h>
+static SRWLOCK registry_lock = SRWLOCK_INIT;
+#define REGISTRY_LOCK_READ()        AcquireSRWLockShared(&registry_lock)
+#define REGISTRY_UNLOCK_READ()      ReleaseSRWLockShared(&registry_lock)
+#define REGISTRY_LOCK_WRITE()       AcquireSRWLockExclusive(&registry_lock)
+#define REGISTRY_UNLOCK_WRITE()     ReleaseSRWLockExclusive(&registry_lock)
+#else
+#include <pthread.h>
+static pthread_rwlock_t registry_lock = PTHREAD_RWLOCK_INITIALIZER;
+#define REGISTRY_LOCK_READ()        pthread_rwlock_rdlock(&registry_lock)
+#define REGISTRY_UNLOCK_READ()      pthread_rwlock_unlock(&registry_lock)
+#define REGISTRY_LOCK_WRITE()       pthread_rwlock_wrlock(&registry_lock)
+#define REGISTRY_UNLOCK_WRITE()     pthread_rwlock_unlock(&registry_lock)
+#endif
+
+#define ASN_ARENA_ALIGN             8
+#define ASN_ARENA_ROUND(n)          (((n) + (ASN_ARENA_ALIGN - 1)) & ~((size_t)ASN_ARENA_ALIGN - 1))
+#define ASN_ARENA_MIN_CHUNK_SIZE    1024
+#define ASN_ARENA_MAX_CHUNK_SIZE    (1024 * 1024)
+#define ASN_ARENA_HDR_SIZE          ASN_ARENA_ROUND(sizeof(size_t))
+#define ASN_ARENA_CHUNK_HDR_SIZE    ASN_ARENA_ROUND(sizeof(AsnArenaChunk))
+#define ASN_ARENA_NO_BLOCK          ((size_t)-1)
+
+//  Every block is prefixed by its size (needed by REALLOC to copy the old content),
+//  "last" points to the header of the most recent block - it can grow or be released in place.
+typedef struct AsnArenaChunk_st {
+    struct AsnArenaChunk_st* prev;
+    size_t size;
+    size_t used;
+    size_t last;
+} AsnArenaChunk;
+
+//  Source buffer of asn_decode_arena_view(), kept in the arena until it is released
+typedef struct AsnArenaView_st {
+    struct AsnArenaView_st* prev;
+    const uint8_t* begin;
+    const uint8_t* end;
+} AsnArenaView;
+
+struct AsnArena_st {
+    AsnArenaChunk* head;
+    AsnArenaView* views;
+    size_t next_size;
+};
+
+//  Memory of all live arenas (chunks and view sources), sorted by the beginning. Outside of the decoding
+//  REALLOC/FREEMEM and asn_free() use it to recognize this memory - it must never reach realloc()/free().
+//  View sources may be nested, "max_end" is the maximum end of this and all previous ranges
+typedef struct AsnArenaRange_st {
+    uintptr_t begin;
+    uintptr_t end;
+    uintptr_t max_end;
+} AsnArenaRange;
+
+static AsnArenaRange* registry_ranges = NULL;
+static size_t registry_count = 0;
+static size_t registry_capacity = 0;
+
+//  The arena used by CALLOC/MALLOC/REALLOC/FREEMEM while asn_decode_arena() is running
+static ASN_ARENA_TLS AsnArena* arena_current = NULL;
+//  Source buffer that decoded primitives may point into (asn_decode_arena_view)
+static ASN_ARENA_TLS const uint8_t* view_begin = NULL;
+static ASN_ARENA_TLS const uint8_t* view_end = NULL;
+//  Set while asn_free() releases an object that is known to be allocated on the heap
+static ASN_ARENA_TLS bool heap_object_free = false;
+
+static uint8_t* chunk_data(AsnArenaChunk* chunk)
+{
+    return (uint8_t*)chunk + ASN_ARENA_CHUNK_HDR_SIZE;
+}
+
+//  Index of the first range that begins after ptr
+static size_t registry_upper_bound(uintptr_t ptr)
+{
+    size_t lo = 0, hi = registry_count;
+
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (registry_ranges[mid].begin <= ptr) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static void registry_update_max_end(size_t idx)
+{
+    uintptr_t max_end = (idx > 0) ? registry_ranges[idx - 1].max_end : 0;
+
+    for (; idx < registry_count; idx++) {
+        if (registry_ranges[idx].end > max_end) {
+            max_end = registry_ranges[idx].end;
+        }
+        registry_ranges[idx].max_end = max_end;
+    }
+}
+
+static bool registry_add(uintptr_t begin, uintptr_t end)
+{
+    size_t idx;
+
+    REGISTRY_LOCK_WRITE();
+    if (registry_count == registry_capacity) {
+        const size_t capacity = registry_capacity ? 2 * registry_capacity : 64;
+        AsnArenaRange* ranges = realloc(registry_ranges, capacity * sizeof(AsnArenaRange));
+        if (!ranges) {
+            REGISTRY_UNLOCK_WRITE();
+            return false;
+        }
+        registry_ranges = ranges;
+        registry_capacity = capacity;
+    }
+
+    idx = registry_upper_bound(begin);
+    memmove(&registry_ranges[idx + 1], &registry_ranges[idx], (registry_count - idx) * sizeof(AsnArenaRange));
+    registry_ranges[idx].begin = begin;
+    registry_ranges[idx].end = end;
+    registry_count++;
+    registry_update_max_end(idx);
+    REGISTRY_UNLOCK_WRITE();
+    return true;
+}
+
+static void registry_remove(uintptr_t begin, uintptr_t end)
+{
+    size_t idx;
+
+    REGISTRY_LOCK_WRITE();
+    idx = registry_upper_bound(begin);
+    //  The same source can be decoded as a view several times, any of the equal ranges is removed
+    while ((idx > 0) && (registry_ranges[idx - 1].begin == begin)) {
+        idx--;
+        if (registry_ranges[idx].end == end) {
+            memmove(&registry_ranges[idx], &registry_ranges[idx + 1], (registry_count - idx - 1) * sizeof(AsnArenaRange));
+            registry_count--;
+            registry_update_max_end(idx);
+            break;
+        }
+    }
+    REGISTRY_UNLOCK_WRITE();
+}
+
+static bool registry_contains(const void* ptr)
+{
+    const uintptr_t p = (uintptr_t)ptr;
+    size_t idx;
+    bool rv;
+
+    REGISTRY_LOCK_READ();
+    idx = registry_upper_bound(p);
+    rv = (idx > 0) && (p < registry_ranges[idx - 1].max_end);
+    REGISTRY_UNLOCK_READ();
+    return rv;
+}
+
+static void arena_free_chunk(AsnArenaChunk* chunk)
+{
+    registry_remove((uintptr_t)chunk_data(chunk), (uintptr_t)chunk_data(chunk) + chunk->size);
+    free(chunk);
+}
+
+static AsnArenaChunk* arena_find_chunk(AsnArena* arena, const void* ptr)
+{
+    AsnArenaChunk* chunk = arena->head;
+    const uint8_t* p = (const uint8_t*)ptr;
+
+    while (chunk) {
+        const uint8_t* data = chunk_data(chunk);
+        if ((p >= data) && (p < data + chunk->used)) {
+            return chunk;
+        }
+        chunk = chunk->prev;
+    }
+    return NULL;
+}
+
+static AsnArenaChunk* arena_add_chunk(AsnArena* arena, size_t min_size)
+{
+    AsnArenaChunk* chunk;
+    size_t size = arena->next_size;
+
+    if (size < min_size) {
+        size = ASN_ARENA_ROUND(min_size);
+    }
+
+    chunk = malloc(ASN_ARENA_CHUNK_HDR_SIZE + size);
+    if (!chunk) return NULL;
+
+    chunk->prev = arena->head;
+    chunk->size = size;
+    chunk->used = 0;
+    chunk->last = ASN_ARENA_NO_BLOCK;
+    if (!registry_add((uintptr_t)chunk_data(chunk), (uintptr_t)chunk_data(chunk) + size)) {
+        free(chunk);
+        return NULL;
+    }
+    arena->head = chunk;
+
+    if (arena->next_size < ASN_ARENA_MAX_CHUNK_SIZE) {
+        arena->next_size <<= 1;
+    }
+    return chunk;
+}
+
+static void* arena_alloc_block(AsnArena* arena, size_t size)
+{
+    AsnArenaChunk* chunk = arena->head;
+    size_t need = ASN_ARENA_HDR_SIZE + ASN_ARENA_ROUND(size);
+    uint8_t* block;
+
+    if (need < size) return NULL;
+
+    if (!chunk || (chunk->size - chunk->used < need)) {
+        chunk = arena_add_chunk(arena, need);
+        if (!chunk) return NULL;
+    }
+
+    block = chunk_data(chunk) + chunk->used;
+    *(size_t*)block = size;
+    chunk->last = chunk->used;
+    chunk->used += need;
+    return block + ASN_ARENA_HDR_SIZE;
+}
+
+static bool is_view_ptr(const void* ptr)
+{
+    return (view_begin != NULL) && ((const uint8_t*)ptr >= view_begin) && ((const uint8_t*)ptr < view_end);
+}
+
+static size_t arena_block_size(const void* ptr)
+{
+    return *(const size_t*)((const uint8_t*)ptr - ASN_ARENA_HDR_SIZE);
+}
+
+static bool arena_is_last_block(const AsnArenaChunk* chunk, const void* ptr)
+{
+    return (chunk->last != ASN_ARENA_NO_BLOCK)
+        && ((const uint8_t*)ptr == (const uint8_t*)chunk + ASN_ARENA_CHUNK_HDR_SIZE + chunk->last + ASN_ARENA_HDR_SIZE);
+}
+
+void* asn_mem_malloc(size_t size)
+{
+    if (!arena_current) {
+        return malloc(size);
+    }
+    return arena_alloc_block(arena_current, size);
+}
+
+void* asn_mem_calloc(size_t nmemb, size_t size)
+{
+    void* ptr;
+    size_t total = nmemb * size;
+
+    if (!arena_current) {
+        return calloc(nmemb, size);
+    }
+
+    if (size && (total / size != nmemb)) return NULL;
+
+    ptr = arena_alloc_block(arena_current, total);
+    if (ptr) {
+        memset(ptr, 0, total);
+    }
+    return ptr;
+}
+
+void* asn_mem_realloc(void* ptr, size_t size)
+{
+    AsnArenaChunk* chunk;
+    size_t old_size;
+    void* new_ptr;
+
+    if (!arena_current) {
+        //  The object decoded into an arena can not be changed
+        if (ptr && registry_contains(ptr)) return NULL;
+        return realloc(ptr, size);
+    }
+    if (!ptr) {
+        return arena_alloc_block(arena_current, size);
+    }
+
+    if (is_view_ptr(ptr)) {
+        //  Borrowed bytes can not grow in place, move them into the arena
+        old_size = (size_t)(view_end - (const uint8_t*)ptr);
+        new_ptr = arena_alloc_block(arena_current, size);
+        if (new_ptr) {
+            memcpy(new_ptr, ptr, (old_size < size) ? old_size : size);
+        }
+        return new_ptr;
+    }
+
+    chunk = arena_find_chunk(arena_current, ptr);
+    if (!chunk) {
+        //  Memory was allocated outside of the arena
+        return realloc(ptr, size);
+    }
+
+    old_size = arena_block_size(ptr);
+    if (arena_is_last_block(chunk, ptr)) {
+        size_t need = ASN_ARENA_HDR_SIZE + ASN_ARENA_ROUND(size);
+        if ((need >= size) && (chunk->size - chunk->last >= need)) {
+            *(size_t*)((uint8_t*)ptr - ASN_ARENA_HDR_SIZE) = size;
+            chunk->used = chunk->last + need;
+            return ptr;
+        }
+    }
+
+    new_ptr = arena_alloc_block(arena_current, size);
+    if (new_ptr) {
+        memcpy(new_ptr, ptr, (old_size < size) ? old_size : size);
+    }
+    return new_ptr;
+}
+
+void asn_mem_free(void* ptr)
+{
+    AsnArenaChunk* chunk;
+
+    if (!ptr) return;
+
+    if (!arena_current) {
+        //  The arena memory is released together with the arena
+        if (heap_object_free || !registry_contains(ptr)) {
+            free(ptr);
+        }
+        return;
+    }
+
+    if (is_view_ptr(ptr)) return;
+
+    chunk = arena_find_chunk(arena_current, ptr);
+    if (!chunk) {
+        free(ptr);
+        return;
+    }
+
+    //  Only the most recent block is released, the rest is freed together with the arena
+    if (arena_is_last_block(chunk, ptr)) {
+        chunk->used = chunk->last;
+        chunk->last = ASN_ARENA_NO_BLOCK;
+    }
+}
+
+void asn_mem_free_struct(asn_TYPE_descriptor_t* td, void* ptr)
+{
+    bool prev;
+
+    //  The object decoded into an arena is released together with the arena
+    if (registry_contains(ptr)) return;
+
+    //  Members of the heap object need no lookup in the registry
+    prev = heap_object_free;
+    heap_object_free = true;
+    td->free_struct(td, ptr, 0);
+    heap_object_free = prev;
+}
+
+const void* asn_mem_borrow(const void* ptr, size_t size)
+{
+    if (!arena_current || !is_view_ptr(ptr) || (size > (size_t)(view_end - (const uint8_t*)ptr))) {
+        return NULL;
+    }
+    return ptr;
+}
+
+AsnArena* asn_arena_alloc(size_t size_hint)
+{
+    AsnArena* arena = malloc(sizeof(AsnArena));
+
+    if (arena) {
+        arena->head = NULL;
+        arena->views = NULL;
+        arena->next_size = (size_hint > ASN_ARENA_MIN_CHUNK_SIZE) ? ASN_ARENA_ROUND(size_hint) : ASN_ARENA_MIN_CHUNK_SIZE;
+    }
+    return arena;
+}
+
+void asn_arena_free(AsnArena* arena)
+{
+    AsnArenaChunk* chunk;
+    AsnArenaView* view;
+
+    if (!arena) return;
+
+    //  Records of the views are placed in the chunks
+    for (view = arena->views; view; view = view->prev) {
+        registry_remove((uintptr_t)view->begin, (uintptr_t)view->end);
+    }
+
+    chunk = arena->head;
+    while (chunk) {
+        AsnArenaChunk* prev = chunk->prev;
+        arena_free_chunk(chunk);
+        chunk = prev;
+    }
+    free(arena);
+}
+
+static const void* arena_decode(asn_TYPE_descriptor_t* desc, AsnArena* arena, const void* encode, size_t encode_len, bool view)
+{
+    void* object = NULL;
+    AsnArena* prev_arena;
+    const uint8_t* prev_view_begin;
+    const uint8_t* prev_view_end;
+    AsnArenaChunk* mark_chunk;
+    size_t mark_used = 0, mark_last = ASN_ARENA_NO_BLOCK;
+    asn_dec_rval_t ret_old;
+    int ret = RET_OK;
+
+    CHECK_PARAM(desc != NULL);
+    CHECK_PARAM(arena != NULL);
+    CHECK_PARAM(encode != NULL);
+
+    mark_chunk = arena->head;
+    if (mark_chunk) {
+        mark_used = mark_chunk->used;
+        mark_last = mark_chunk->last;
+    }
+
+    prev_arena = arena_current;
+    prev_view_begin = view_begin;
+    prev_view_end = view_end;
+    arena_current = arena;
+    view_begin = view ? (const uint8_t*)encode : NULL;
+    view_end = view ? (const uint8_t*)encode + encode_len : NULL;
+    ret_old = ber_decode(NULL, desc, &object, encode, encode_len);
+    arena_current = prev_arena;
+    view_begin = prev_view_begin;
+    view_end = prev_view_end;
+    ret = ret_old.code;
+
+    if ((ret == RET_OK) && view) {
+        //  The source is registered like the chunks - the borrowed bytes are not freed or reallocated
+        AsnArenaView* record = arena_alloc_block(arena, sizeof(AsnArenaView));
+        if (record && registry_add((uintptr_t)encode, (uintptr_t)encode + encode_len)) {
+            record->prev = arena->views;
+            record->begin = (const uint8_t*)encode;
+            record->end = (const uint8_t*)encode + encode_len;
+            arena->views = record;
+        }
+        else {
+            ret = RET_MEMORY_ALLOC_ERROR;
+        }
+    }
+
+    if (ret != RET_OK) {
+        //  Drop everything that was allocated by the failed decoding
+        while (arena->head != mark_chunk) {
+            AsnArenaChunk* prev = arena->head->prev;
+            arena_free_chunk(arena->head);
+            arena->head = prev;
+        }
+        if (mark_chunk) {
+            mark_chunk->used = mark_used;
+            mark_chunk->last = mark_last;
+        }
+        object = NULL;
+    }
+
+cleanup:
+    return object;
+}
+
+const void* asn_decode_arena(asn_TYPE_descriptor_t* desc, AsnArena* arena, const void* encode, size_t encode_len)
+{
+    return arena_decode(desc, arena, encode, encode_len, false);
+}
+
+const void* asn_decode_arena_view(asn_TYPE_descriptor_t* desc, AsnArena* arena, const void* encode, size_t encode_len)
+{
+    return arena_decode(desc, arena, encode, encode_len, true);
+}
+
+const void* asn_decode_ba_arena(asn_TYPE_descriptor_t* desc, AsnArena* arena, const ByteArray* encoded)
+{
+    int ret = RET_OK;
+    const void* value = NULL;
+
+    CHECK_PARAM(desc != NULL);
+    CHECK_PARAM(encoded != NULL);
+
+    CHECK_NOT_NULL(value = asn_decode_arena(desc, arena, ba_get_buf_const(encoded), ba_get_len(encoded)));
+
+cleanup:
+    return value;
+}
+
+const void* asn_decode_ba_arena_view(asn_TYPE_descriptor_t* desc, AsnArena* arena, const ByteArray* encoded)
+{
+    int ret = RET_OK;
+    const void* value = NULL;
+
+    CHECK_PARAM(desc != NULL);
+    CHECK_PARAM(encoded != NULL);
+
+    CHECK_NOT_NULL(value = asn_decode_arena_view(desc, arena, ba_get_buf_const(encoded), ba_get_len(encoded)));
+
+cleanup:
+    return value;
+}
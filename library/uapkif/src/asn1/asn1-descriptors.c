@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2023, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define FILE_MARKER "uapkif/asn1/asn1-descriptors.c"
+
+#include "asn1-utils.h"
+#include "asn_internal.h"
+#include "AttCertVersion.h"
+#include "AttCertVersionV1.h"
+#include "AttributeCertificateV2.h"
+#include "AttributeType.h"
+#include "AttributeValue.h"
+#include "AttributeValueAssertion.h"
+#include "CMSVersion.h"
+#include "CRLNumber.h"
+#include "CRLReason.h"
+#include "CertPolicyId.h"
+#include "CertificateSerialNumber.h"
+#include "ContentEncryptionAlgorithmIdentifier.h"
+#include "ContentType.h"
+#include "Digest.h"
+#include "DigestAlgorithmIdentifier.h"
+#include "EncryptedContent.h"
+#include "EncryptedKey.h"
+#include "FreshestCRL.h"
+#include "Hash.h"
+#include "IssuerAltName.h"
+#include "KeyBag.h"
+#include "KeyDerivationAlgorithmIdentifier.h"
+#include "KeyEncryptionAlgorithmIdentifier.h"
+#include "KeyHash.h"
+#include "KeyIdentifier.h"
+#include "KeyPurposeId.h"
+#include "KeyUsage.h"
+#include "MessageAuthenticationCodeAlgorithm.h"
+#include "NumericUserIdentifier.h"
+#include "OCSPResponseStatus.h"
+#include "ObjectDigestInfo.h"
+#include "OrganizationName.h"
+#include "OrganizationalUnitName.h"
+#include "OtherHashValue.h"
+#include "OtherRevRefType.h"
+#include "OtherRevValType.h"
+#include "PKCS8ShroudedKeyBag.h"
+#include "PKIFailureInfo.h"
+#include "PKIStatus.h"
+#include "PolicyQualifierId.h"
+#include "QcEuLimitValue.h"
+#include "ReasonFlags.h"
+#include "SigPolicyHash.h"
+#include "SigPolicyId.h"
+#include "SigPolicyQualifierId.h"
+#include "SignatureAlgorithmIdentifier.h"
+#include "SignedAttributes.h"
+#include "SubjectAltName.h"
+#include "SubjectKeyIdentifier.h"
+#include "TSAPolicyId.h"
+#include "TSVersion.h"
+#include "TerminalIdentifier.h"
+#include "TimeStampToken.h"
+#include "UnauthAttributes.h"
+#include "UniqueIdentifier.h"
+#include "UnknownInfo.h"
+#include "UnprotectedAttributes.h"
+#include "UnsignedAttributes.h"
+#include "UserKeyingMaterial.h"
+#include "Version.h"
+#include "X121Address.h"
+#include "NetworkAddress.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+//  Types that are defined by other type (e.g. "KeyIdentifier ::= OCTET STRING"): the generated codecs
+//  copy the fields of base descriptor (free_struct, der_encoder, elements, ...) into own descriptor
+//  by each call. NetworkAddress is based on X121Address, so it follows its base
+static asn_TYPE_descriptor_t* const INHERITED_DESCRIPTORS[] = {
+    &AttCertVersion_desc,
+    &AttCertVersionV1_desc,
+    &AttributeCertificateV2_desc,
+    &AttributeType_desc,
+    &AttributeValue_desc,
+    &AttributeValueAssertion_desc,
+    &CMSVersion_desc,
+    &CRLNumber_desc,
+    &CRLReason_desc,
+    &CertPolicyId_desc,
+    &CertificateSerialNumber_desc,
+    &ContentEncryptionAlgorithmIdentifier_desc,
+    &ContentType_desc,
+    &Digest_desc,
+    &DigestAlgorithmIdentifier_desc,
+    &EncryptedContent_desc,
+    &EncryptedKey_desc,
+    &FreshestCRL_desc,
+    &Hash_desc,
+    &IssuerAltName_desc,
+    &KeyBag_desc,
+    &KeyDerivationAlgorithmIdentifier_desc,
+    &KeyEncryptionAlgorithmIdentifier_desc,
+    &KeyHash_desc,
+    &KeyIdentifier_desc,
+    &KeyPurposeId_desc,
+    &KeyUsage_desc,
+    &MessageAuthenticationCodeAlgorithm_desc,
+    &NumericUserIdentifier_desc,
+    &OCSPResponseStatus_desc,
+    &ObjectDigestInfo_desc,
+    &OrganizationName_desc,
+    &OrganizationalUnitName_desc,
+    &OtherHashValue_desc,
+    &OtherRevRefType_desc,
+    &OtherRevValType_desc,
+    &PKCS8ShroudedKeyBag_desc,
+    &PKIFailureInfo_desc,
+    &PKIStatus_desc,
+    &PolicyQualifierId_desc,
+    &QcEuLimitValue_desc,
+    &ReasonFlags_desc,
+    &SigPolicyHash_desc,
+    &SigPolicyId_desc,
+    &SigPolicyQualifierId_desc,
+    &SignatureAlgorithmIdentifier_desc,
+    &SignedAttributes_desc,
+    &SubjectAltName_desc,
+    &SubjectKeyIdentifier_desc,
+    &TSAPolicyId_desc,
+    &TSVersion_desc,
+    &TerminalIdentifier_desc,
+    &TimeStampToken_desc,
+    &UnauthAttributes_desc,
+    &UniqueIdentifier_desc,
+    &UnknownInfo_desc,
+    &UnprotectedAttributes_desc,
+    &UnsignedAttributes_desc,
+    &UserKeyingMaterial_desc,
+    &Version_desc,
+    &X121Address_desc,
+    &NetworkAddress_desc,
+};
+
+static void init_descriptors (void)
+{
+    //  The first call of free_struct() fills the descriptor, there is nothing to free for NULL
+    for (size_t i = 0; i < sizeof(INHERITED_DESCRIPTORS) / sizeof(INHERITED_DESCRIPTORS[0]); i++) {
+        asn_TYPE_descriptor_t* td = INHERITED_DESCRIPTORS[i];
+        td->free_struct(td, NULL, 0);
+    }
+}
+
+#if defined(_WIN32)
+static INIT_ONCE descriptors_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK init_descriptors_once (PINIT_ONCE initOnce, PVOID param, PVOID* context)
+{
+    (void)initOnce;
+    (void)param;
+    (void)context;
+    init_descriptors();
+    return TRUE;
+}
+
+void asn_init_descriptors (void)
+{
+    (void)InitOnceExecuteOnce(&descriptors_once, init_descriptors_once, NULL, NULL);
+}
+#else
+static pthread_once_t descriptors_once = PTHREAD_ONCE_INIT;
+
+void asn_init_descriptors (void)
+{
+    (void)pthread_once(&descriptors_once, init_descriptors);
+}
+#endif
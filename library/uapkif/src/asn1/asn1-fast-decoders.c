@@ -0,0 +1,616 @@
+/*
+ * Copyright (c) 2023, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define FILE_MARKER "uapkif/asn1/asn1-fast-decoders.c"
+
+//  Straight-line DER decoders for the hot fixed-shape PKIX types.
+//  They are installed as ber_decoder of the type descriptors and build exactly the same
+//  structures as the generic SEQUENCE_decode_ber(), but without the restartable state machine,
+//  tag-to-member lookups and repeated tag/length parsing on every nesting level.
+//  Only complete definite-length input in the expected shape is handled here: on anything else
+//  (BER constructed strings, indefinite length, partial input, unexpected tags) the partially
+//  decoded structure is released and the generic decoder is run on the same input, so the
+//  result and the error reporting stay the same as before.
+//  Members of non-hot types (Name, Extensions, CertStatus, ...) are decoded by their own
+//  ber_decoder on the exact TLV.
+//  In the build with UAPKI_TEST_INTERNAL the fast path can be switched off for the calling thread
+//  with asn_set_fast_decoders(false), which is used by the differential tests to compare both
+//  decoders on the same input.
+
+#include "asn_internal.h"
+#include "asn1-utils.h"
+#include "AlgorithmIdentifier.h"
+#include "BasicOCSPResponse.h"
+#include "Certificate.h"
+#include "Extension.h"
+#include "RevokedCertificate.h"
+#include "SignerInfo.h"
+#include "SingleResponse.h"
+#include "TSTInfo.h"
+#include "BIT_STRING.h"
+#include "BOOLEAN.h"
+#include <stdbool.h>
+#include <string.h>
+
+#define TAG_BOOLEAN             0x01
+#define TAG_INTEGER             0x02
+#define TAG_BIT_STRING          0x03
+#define TAG_OCTET_STRING        0x04
+#define TAG_OID                 0x06
+#define TAG_UTC_TIME            0x17
+#define TAG_GENERALIZED_TIME    0x18
+#define TAG_SEQUENCE            0x30
+#define TAG_CONTEXT(n)          (0x80 | (n))
+#define TAG_CONS_CONTEXT(n)     (0xA0 | (n))
+#define FAST_MAX_LENGTH         0x7FFFFFFF
+
+typedef struct FastTlv_st {
+    uint8_t tag;
+    const uint8_t *tlv;
+    size_t tlv_len;
+    const uint8_t *value;
+    size_t len;
+} FastTlv;
+
+typedef struct FastReader_st {
+    const uint8_t *buf;
+    size_t size;
+    size_t pos;
+} FastReader;
+
+static bool fast_tlv(const uint8_t *buf, size_t size, size_t *pos, FastTlv *t)
+{
+    size_t p = *pos;
+    size_t len, cnt;
+
+    if (size - p < 2) return false;
+
+    t->tlv = buf + p;
+    t->tag = buf[p++];
+    //  High tag numbers never occur in these types
+    if ((t->tag & 0x1F) == 0x1F) return false;
+
+    len = buf[p++];
+    if (len & 0x80) {
+        cnt = len & 0x7F;
+        //  Indefinite length is left to the generic decoder
+        if ((cnt == 0) || (cnt > 4) || (size - p < cnt)) return false;
+        for (len = 0; cnt > 0; cnt--) {
+            len = (len << 8) | buf[p++];
+        }
+        if (len > FAST_MAX_LENGTH) return false;
+    }
+    if (size - p < len) return false;
+
+    t->value = buf + p;
+    t->len = len;
+    p += len;
+    t->tlv_len = p - *pos;
+    *pos = p;
+    return true;
+}
+
+static void fast_reader_init(FastReader *r, const FastTlv *seq)
+{
+    r->buf = seq->value;
+    r->size = seq->len;
+    r->pos = 0;
+}
+
+static int fast_peek(const FastReader *r)
+{
+    return (r->pos < r->size) ? r->buf[r->pos] : -1;
+}
+
+static bool fast_read(FastReader *r, FastTlv *t)
+{
+    return fast_tlv(r->buf, r->size, &r->pos, t);
+}
+
+static bool fast_next(FastReader *r, uint8_t tag, FastTlv *t)
+{
+    return (fast_peek(r) == tag) && fast_read(r, t);
+}
+
+static bool fast_end(const FastReader *r)
+{
+    return (r->pos == r->size);
+}
+
+//  INTEGER, OBJECT IDENTIFIER (ber_decode_primitive)
+static bool fast_prim(ASN__PRIMITIVE_TYPE_t *st, const FastTlv *t)
+{
+    st->size = (int)t->len;
+    st->buf = (uint8_t *)asn_mem_borrow(t->value, t->len);
+    if (!st->buf) {
+        st->buf = MALLOC(t->len + 1);
+        if (!st->buf) {
+            st->size = 0;
+            return false;
+        }
+        memcpy(st->buf, t->value, t->len);
+        st->buf[t->len] = '\0';
+    }
+    return true;
+}
+
+//  Primitive OCTET STRING and the time types based on it, borrowing is allowed for OCTET STRING only
+static bool fast_octets(OCTET_STRING_t *st, const FastTlv *t, bool can_borrow)
+{
+    st->size = (int)t->len;
+    st->buf = can_borrow ? (uint8_t *)asn_mem_borrow(t->value, t->len) : NULL;
+    if (!st->buf) {
+        st->buf = MALLOC(t->len + 1);
+        if (!st->buf) {
+            st->size = 0;
+            return false;
+        }
+        memcpy(st->buf, t->value, t->len);
+        st->buf[t->len] = '\0';
+    }
+    return true;
+}
+
+//  The generic ANY decoder walks into constructed values, so malformed nested TLVs are rejected there
+static bool fast_nested_valid(const FastTlv *t, int depth)
+{
+    FastTlv child;
+    size_t pos = 0;
+
+    if (!(t->tag & 0x20)) return true;
+    if (depth == 0) return false;
+
+    while (pos < t->len) {
+        if (!fast_tlv(t->value, t->len, &pos, &child) || !fast_nested_valid(&child, depth - 1)) return false;
+    }
+    return true;
+}
+
+//  ANY keeps the whole TLV
+static bool fast_any(ANY_t *st, const FastTlv *t)
+{
+    if (!fast_nested_valid(t, 16)) return false;
+
+    st->size = (int)t->tlv_len;
+    st->buf = (uint8_t *)asn_mem_borrow(t->tlv, t->tlv_len);
+    if (!st->buf) {
+        st->buf = MALLOC(t->tlv_len + 1);
+        if (!st->buf) {
+            st->size = 0;
+            return false;
+        }
+        memcpy(st->buf, t->tlv, t->tlv_len);
+        st->buf[t->tlv_len] = '\0';
+    }
+    return true;
+}
+
+static bool fast_bit_string(BIT_STRING_t *st, const FastTlv *t)
+{
+    const size_t len = (t->len > 0) ? t->len - 1 : 0;
+
+    if ((t->len > 0) && (t->value[0] > 7)) return false;
+
+    st->bits_unused = (t->len > 0) ? t->value[0] : 0;
+    st->size = (int)len;
+    st->buf = MALLOC(len + 1);
+    if (!st->buf) {
+        st->size = 0;
+        return false;
+    }
+    if (len > 0) {
+        memcpy(st->buf, t->value + 1, len);
+        //  Zero out unused bits like BIT_STRING decoder does
+        st->buf[len - 1] &= 0xff << st->bits_unused;
+    }
+    st->buf[len] = '\0';
+    return true;
+}
+
+static bool fast_time(PKIXTime_t *st, const FastTlv *t)
+{
+    if (t->tag == TAG_UTC_TIME) {
+        st->present = PKIXTime_PR_utcTime;
+        return fast_octets(&st->choice.utcTime, t, false);
+    }
+    if (t->tag == TAG_GENERALIZED_TIME) {
+        st->present = PKIXTime_PR_generalTime;
+        return fast_octets(&st->choice.generalTime, t, false);
+    }
+    return false;
+}
+
+static bool fast_pointer(void **memb, size_t size)
+{
+    *memb = CALLOC(1, size);
+    return (*memb != NULL);
+}
+
+//  Decodes member idx of td by its own (generic) decoder, the TLV must be consumed exactly
+static bool fast_member(asn_TYPE_descriptor_t *td, int idx, void *st, const FastTlv *t)
+{
+    asn_TYPE_member_t *elm = &td->elements[idx];
+    void **memb_ptr2;
+    void *memb_ptr;
+    asn_dec_rval_t rval;
+
+    if (elm->flags & ATF_POINTER) {
+        memb_ptr2 = (void **)((char *)st + elm->memb_offset);
+    } else {
+        memb_ptr = (char *)st + elm->memb_offset;
+        memb_ptr2 = &memb_ptr;
+    }
+
+    rval = elm->type->ber_decoder(NULL, elm->type, memb_ptr2, t->tlv, t->tlv_len, elm->tag_mode);
+    return (rval.code == RC_OK) && (rval.consumed == t->tlv_len);
+}
+
+/*
+ * AlgorithmIdentifier ::= SEQUENCE { algorithm OBJECT IDENTIFIER, parameters ANY OPTIONAL }
+ */
+static bool fast_AlgorithmIdentifier(AlgorithmIdentifier_t *st, const FastTlv *seq)
+{
+    FastReader r;
+    FastTlv t;
+
+    fast_reader_init(&r, seq);
+    if (!fast_next(&r, TAG_OID, &t) || !fast_prim(&st->algorithm, &t)) return false;
+    if (!fast_end(&r)) {
+        if (!fast_read(&r, &t)
+                || !fast_pointer((void **)&st->parameters, sizeof(ANY_t))
+                || !fast_any(st->parameters, &t)) return false;
+    }
+    return fast_end(&r);
+}
+
+static bool fast_next_AlgorithmIdentifier(FastReader *r, AlgorithmIdentifier_t *st)
+{
+    FastTlv t;
+    return fast_next(r, TAG_SEQUENCE, &t) && fast_AlgorithmIdentifier(st, &t);
+}
+
+/*
+ * Extension ::= SEQUENCE { extnID OBJECT IDENTIFIER, critical BOOLEAN DEFAULT FALSE, extnValue OCTET STRING }
+ */
+static bool fast_Extension(Extension_t *st, const FastTlv *seq)
+{
+    FastReader r;
+    FastTlv t;
+    size_t i;
+
+    fast_reader_init(&r, seq);
+    if (!fast_next(&r, TAG_OID, &t) || !fast_prim(&st->extnID, &t)) return false;
+    if (fast_peek(&r) == TAG_BOOLEAN) {
+        if (!fast_read(&r, &t) || !fast_pointer((void **)&st->critical, sizeof(BOOLEAN_t))) return false;
+        //  Same as BOOLEAN_decode_ber(): the first non-zero octet is the value
+        for (i = 0; (i < t.len) && (*st->critical == 0); i++) {
+            *st->critical |= t.value[i];
+        }
+    }
+    if (!fast_next(&r, TAG_OCTET_STRING, &t) || !fast_octets(&st->extnValue, &t, true)) return false;
+    return fast_end(&r);
+}
+
+/*
+ * RevokedCertificate ::= SEQUENCE { userCertificate CertificateSerialNumber, revocationDate Time,
+ *     crlEntryExtensions Extensions OPTIONAL }
+ */
+static bool fast_RevokedCertificate(RevokedCertificate_t *st, const FastTlv *seq)
+{
+    FastReader r;
+    FastTlv t;
+
+    fast_reader_init(&r, seq);
+    if (!fast_next(&r, TAG_INTEGER, &t) || !fast_prim(&st->userCertificate, &t)) return false;
+    if (!fast_read(&r, &t) || !fast_time(&st->revocationDate, &t)) return false;
+    if (fast_peek(&r) == TAG_SEQUENCE) {
+        if (!fast_read(&r, &t) || !fast_member(&RevokedCertificate_desc, 2, st, &t)) return false;
+    }
+    return fast_end(&r);
+}
+
+/*
+ * TBSCertificate ::= SEQUENCE { version [0] EXPLICIT Version DEFAULT v1, serialNumber, signature,
+ *     issuer, validity, subject, subjectPublicKeyInfo, issuerUniqueID [1] IMPLICIT OPTIONAL,
+ *     subjectUniqueID [2] IMPLICIT OPTIONAL, extensions [3] EXPLICIT Extensions OPTIONAL }
+ */
+static bool fast_TBSCertificate(TBSCertificate_t *st, const FastTlv *seq)
+{
+    FastReader r, rv;
+    FastTlv t, tv;
+
+    fast_reader_init(&r, seq);
+    if (fast_peek(&r) == TAG_CONS_CONTEXT(0)) {
+        if (!fast_read(&r, &t) || !fast_member(&TBSCertificate_desc, 0, st, &t)) return false;
+    }
+    if (!fast_next(&r, TAG_INTEGER, &t) || !fast_prim(&st->serialNumber, &t)) return false;
+    if (!fast_next_AlgorithmIdentifier(&r, &st->signature)) return false;
+    if (!fast_next(&r, TAG_SEQUENCE, &t) || !fast_member(&TBSCertificate_desc, 3, st, &t)) return false;
+
+    //  Validity ::= SEQUENCE { notBefore Time, notAfter Time }
+    if (!fast_next(&r, TAG_SEQUENCE, &t)) return false;
+    fast_reader_init(&rv, &t);
+    if (!fast_read(&rv, &tv) || !fast_time(&st->validity.notBefore, &tv)) return false;
+    if (!fast_read(&rv, &tv) || !fast_time(&st->validity.notAfter, &tv) || !fast_end(&rv)) return false;
+
+    if (!fast_next(&r, TAG_SEQUENCE, &t) || !fast_member(&TBSCertificate_desc, 5, st, &t)) return false;
+
+    //  SubjectPublicKeyInfo ::= SEQUENCE { algorithm AlgorithmIdentifier, subjectPublicKey BIT STRING }
+    if (!fast_next(&r, TAG_SEQUENCE, &t)) return false;
+    fast_reader_init(&rv, &t);
+    if (!fast_next_AlgorithmIdentifier(&rv, &st->subjectPublicKeyInfo.algorithm)) return false;
+    if (!fast_next(&rv, TAG_BIT_STRING, &tv)
+            || !fast_bit_string(&st->subjectPublicKeyInfo.subjectPublicKey, &tv)
+            || !fast_end(&rv)) return false;
+
+    if ((fast_peek(&r) == TAG_CONTEXT(1)) || (fast_peek(&r) == TAG_CONS_CONTEXT(1))) {
+        if (!fast_read(&r, &t) || !fast_member(&TBSCertificate_desc, 7, st, &t)) return false;
+    }
+    if ((fast_peek(&r) == TAG_CONTEXT(2)) || (fast_peek(&r) == TAG_CONS_CONTEXT(2))) {
+        if (!fast_read(&r, &t) || !fast_member(&TBSCertificate_desc, 8, st, &t)) return false;
+    }
+    if (fast_peek(&r) == TAG_CONS_CONTEXT(3)) {
+        if (!fast_read(&r, &t) || !fast_member(&TBSCertificate_desc, 9, st, &t)) return false;
+    }
+    return fast_end(&r);
+}
+
+/*
+ * Certificate ::= SEQUENCE { tbsCertificate TBSCertificate, signatureAlgorithm AlgorithmIdentifier,
+ *     signature BIT STRING }
+ */
+static bool fast_Certificate(Certificate_t *st, const FastTlv *seq)
+{
+    FastReader r;
+    FastTlv t;
+
+    fast_reader_init(&r, seq);
+    if (!fast_next(&r, TAG_SEQUENCE, &t) || !fast_TBSCertificate(&st->tbsCertificate, &t)) return false;
+    if (!fast_next_AlgorithmIdentifier(&r, &st->signatureAlgorithm)) return false;
+    if (!fast_next(&r, TAG_BIT_STRING, &t) || !fast_bit_string(&st->signature, &t)) return false;
+    return fast_end(&r);
+}
+
+/*
+ * SignerInfo ::= SEQUENCE { version CMSVersion, sid SignerIdentifier, digestAlgorithm,
+ *     signedAttrs [0] IMPLICIT SignedAttributes, signatureAlgorithm, signature OCTET STRING,
+ *     unsignedAttrs [1] IMPLICIT UnsignedAttributes OPTIONAL }
+ * sid, signedAttrs and unsignedAttrs are kept as ANY (see SignerInfo.h).
+ */
+static bool fast_SignerInfo(SignerInfo_t *st, const FastTlv *seq)
+{
+    FastReader r;
+    FastTlv t;
+
+    fast_reader_init(&r, seq);
+    if (!fast_next(&r, TAG_INTEGER, &t) || !fast_prim(&st->version, &t)) return false;
+    if (!fast_read(&r, &t) || !fast_any(&st->sid, &t)) return false;
+    if (!fast_next_AlgorithmIdentifier(&r, &st->digestAlgorithm)) return false;
+    if (!fast_next(&r, TAG_CONS_CONTEXT(0), &t) || !fast_any(&st->signedAttrs, &t)) return false;
+    if (!fast_next_AlgorithmIdentifier(&r, &st->signatureAlgorithm)) return false;
+    if (!fast_next(&r, TAG_OCTET_STRING, &t) || !fast_octets(&st->signature, &t, true)) return false;
+    if (!fast_end(&r)) {
+        if (!fast_read(&r, &t)
+                || !fast_pointer((void **)&st->unsignedAttrs, sizeof(ANY_t))
+                || !fast_any(st->unsignedAttrs, &t)) return false;
+    }
+    return fast_end(&r);
+}
+
+/*
+ * SingleResponse ::= SEQUENCE { certID CertID, certStatus CertStatus, thisUpdate GeneralizedTime,
+ *     nextUpdate [0] EXPLICIT GeneralizedTime OPTIONAL, singleExtensions [1] EXPLICIT Extensions OPTIONAL }
+ */
+static bool fast_SingleResponse(SingleResponse_t *st, const FastTlv *seq)
+{
+    FastReader r, rc;
+    FastTlv t, tc;
+
+    fast_reader_init(&r, seq);
+
+    //  CertID ::= SEQUENCE { hashAlgorithm, issuerNameHash OCTET STRING, issuerKeyHash OCTET STRING,
+    //      serialNumber CertificateSerialNumber }
+    if (!fast_next(&r, TAG_SEQUENCE, &t)) return false;
+    fast_reader_init(&rc, &t);
+    if (!fast_next_AlgorithmIdentifier(&rc, &st->certID.hashAlgorithm)) return false;
+    if (!fast_next(&rc, TAG_OCTET_STRING, &tc) || !fast_octets(&st->certID.issuerNameHash, &tc, true)) return false;
+    if (!fast_next(&rc, TAG_OCTET_STRING, &tc) || !fast_octets(&st->certID.issuerKeyHash, &tc, true)) return false;
+    if (!fast_next(&rc, TAG_INTEGER, &tc) || !fast_prim(&st->certID.serialNumber, &tc) || !fast_end(&rc)) return false;
+
+    if (!fast_read(&r, &t) || !fast_member(&SingleResponse_desc, 1, st, &t)) return false;
+    if (!fast_next(&r, TAG_GENERALIZED_TIME, &t) || !fast_octets(&st->thisUpdate, &t, false)) return false;
+    if (fast_peek(&r) == TAG_CONS_CONTEXT(0)) {
+        if (!fast_read(&r, &t) || !fast_member(&SingleResponse_desc, 3, st, &t)) return false;
+    }
+    if (fast_peek(&r) == TAG_CONS_CONTEXT(1)) {
+        if (!fast_read(&r, &t) || !fast_member(&SingleResponse_desc, 4, st, &t)) return false;
+    }
+    return fast_end(&r);
+}
+
+/*
+ * ResponseData ::= SEQUENCE { version [0] EXPLICIT Version DEFAULT v1, responderID ResponderID,
+ *     producedAt GeneralizedTime, responses SEQUENCE OF SingleResponse,
+ *     responseExtensions [1] EXPLICIT Extensions OPTIONAL }
+ */
+static bool fast_ResponseData(ResponseData_t *st, const FastTlv *seq)
+{
+    FastReader r;
+    FastTlv t;
+
+    fast_reader_init(&r, seq);
+    if (fast_peek(&r) == TAG_CONS_CONTEXT(0)) {
+        if (!fast_read(&r, &t) || !fast_member(&ResponseData_desc, 0, st, &t)) return false;
+    }
+    if (!fast_read(&r, &t) || !fast_member(&ResponseData_desc, 1, st, &t)) return false;
+    if (!fast_next(&r, TAG_GENERALIZED_TIME, &t) || !fast_octets(&st->producedAt, &t, false)) return false;
+    if (!fast_next(&r, TAG_SEQUENCE, &t) || !fast_member(&ResponseData_desc, 3, st, &t)) return false;
+    if (fast_peek(&r) == TAG_CONS_CONTEXT(1)) {
+        if (!fast_read(&r, &t) || !fast_member(&ResponseData_desc, 4, st, &t)) return false;
+    }
+    return fast_end(&r);
+}
+
+/*
+ * BasicOCSPResponse ::= SEQUENCE { tbsResponseData ResponseData, signatureAlgorithm AlgorithmIdentifier,
+ *     signature BIT STRING, certs [0] EXPLICIT SEQUENCE OF Certificate OPTIONAL }
+ */
+static bool fast_BasicOCSPResponse(BasicOCSPResponse_t *st, const FastTlv *seq)
+{
+    FastReader r;
+    FastTlv t;
+
+    fast_reader_init(&r, seq);
+    if (!fast_next(&r, TAG_SEQUENCE, &t) || !fast_ResponseData(&st->tbsResponseData, &t)) return false;
+    if (!fast_next_AlgorithmIdentifier(&r, &st->signatureAlgorithm)) return false;
+    if (!fast_next(&r, TAG_BIT_STRING, &t) || !fast_bit_string(&st->signature, &t)) return false;
+    if (fast_peek(&r) == TAG_CONS_CONTEXT(0)) {
+        if (!fast_read(&r, &t) || !fast_member(&BasicOCSPResponse_desc, 3, st, &t)) return false;
+    }
+    return fast_end(&r);
+}
+
+/*
+ * TSTInfo ::= SEQUENCE { version INTEGER, policy TSAPolicyId, messageImprint MessageImprint,
+ *     serialNumber INTEGER, genTime GeneralizedTime, accuracy Accuracy OPTIONAL,
+ *     nonce INTEGER OPTIONAL, tsa [0] GeneralName OPTIONAL, extensions [1] IMPLICIT Extensions OPTIONAL }
+ */
+static bool fast_TSTInfo(TSTInfo_t *st, const FastTlv *seq)
+{
+    FastReader r, rm;
+    FastTlv t, tm;
+
+    fast_reader_init(&r, seq);
+    if (!fast_next(&r, TAG_INTEGER, &t) || !fast_prim(&st->version, &t)) return false;
+    if (!fast_next(&r, TAG_OID, &t) || !fast_prim(&st->policy, &t)) return false;
+
+    //  MessageImprint ::= SEQUENCE { hashAlgorithm AlgorithmIdentifier, hashedMessage OCTET STRING }
+    if (!fast_next(&r, TAG_SEQUENCE, &t)) return false;
+    fast_reader_init(&rm, &t);
+    if (!fast_next_AlgorithmIdentifier(&rm, &st->messageImprint.hashAlgorithm)) return false;
+    if (!fast_next(&rm, TAG_OCTET_STRING, &tm)
+            || !fast_octets(&st->messageImprint.hashedMessage, &tm, true)
+            || !fast_end(&rm)) return false;
+
+    if (!fast_next(&r, TAG_INTEGER, &t) || !fast_prim(&st->serialNumber, &t)) return false;
+    if (!fast_next(&r, TAG_GENERALIZED_TIME, &t) || !fast_octets(&st->genTime, &t, false)) return false;
+    if (fast_peek(&r) == TAG_SEQUENCE) {
+        if (!fast_read(&r, &t) || !fast_member(&TSTInfo_desc, 5, st, &t)) return false;
+    }
+    if (fast_peek(&r) == TAG_INTEGER) {
+        if (!fast_read(&r, &t)
+                || !fast_pointer((void **)&st->nonce, sizeof(INTEGER_t))
+                || !fast_prim(st->nonce, &t)) return false;
+    }
+    if (fast_peek(&r) == TAG_CONS_CONTEXT(0)) {
+        if (!fast_read(&r, &t) || !fast_member(&TSTInfo_desc, 7, st, &t)) return false;
+    }
+    if (fast_peek(&r) == TAG_CONS_CONTEXT(1)) {
+        if (!fast_read(&r, &t) || !fast_member(&TSTInfo_desc, 8, st, &t)) return false;
+    }
+    return fast_end(&r);
+}
+
+#if defined(UAPKI_TEST_INTERNAL)
+#if defined(_MSC_VER)
+#define ASN_FAST_TLS __declspec(thread)
+#else
+#define ASN_FAST_TLS __thread
+#endif
+
+static ASN_FAST_TLS bool fast_decoders_disabled = false;
+
+void asn_set_fast_decoders(bool enabled)
+{
+    fast_decoders_disabled = !enabled;
+}
+
+#define FAST_DECODERS_ENABLED   (!fast_decoders_disabled)
+#else
+#define FAST_DECODERS_ENABLED   true
+#endif
+
+static void *fast_decode_begin(asn_TYPE_descriptor_t *td, void *st, const void *buf_ptr, size_t size,
+        int tag_mode, FastTlv *seq, bool *allocated)
+{
+    const asn_SEQUENCE_specifics_t *specs = (const asn_SEQUENCE_specifics_t *)td->specifics;
+    size_t pos = 0;
+
+    *allocated = false;
+    if (!FAST_DECODERS_ENABLED || (tag_mode != 0) || !buf_ptr) return NULL;
+    if (!fast_tlv((const uint8_t *)buf_ptr, size, &pos, seq) || (seq->tag != TAG_SEQUENCE)) return NULL;
+
+    if (!st) {
+        *allocated = true;
+        return CALLOC(1, specs->struct_size);
+    }
+    //  Continuation of the generic decoding
+    if (((asn_struct_ctx_t *)((char *)st + specs->ctx_offset))->phase != 0) return NULL;
+    return st;
+}
+
+static void fast_decode_rollback(asn_TYPE_descriptor_t *td, void *st, bool allocated)
+{
+    if (allocated) {
+        td->free_struct(td, st, 0);
+    } else {
+        td->free_struct(td, st, 1);
+        memset(st, 0, ((const asn_SEQUENCE_specifics_t *)td->specifics)->struct_size);
+    }
+}
+
+#define FAST_DECODER(TYPE)                                                                      \
+asn_dec_rval_t TYPE##_decode_ber_fast(asn_codec_ctx_t *opt_codec_ctx, asn_TYPE_descriptor_t *td, \
+        void **sptr, const void *buf_ptr, size_t size, int tag_mode)                            \
+{                                                                                               \
+    FastTlv seq;                                                                                \
+    bool allocated;                                                                             \
+    void *st = fast_decode_begin(td, *sptr, buf_ptr, size, tag_mode, &seq, &allocated);        \
+    asn_dec_rval_t rval;                                                                        \
+                                                                                                \
+    if (st) {                                                                                   \
+        if (fast_##TYPE((TYPE##_t *)st, &seq)) {                                                \
+            *sptr = st;                                                                         \
+            rval.code = RC_OK;                                                                  \
+            rval.consumed = seq.tlv_len;                                                        \
+            return rval;                                                                        \
+        }                                                                                       \
+        fast_decode_rollback(td, st, allocated);                                                \
+    }                                                                                           \
+    return SEQUENCE_decode_ber(opt_codec_ctx, td, sptr, buf_ptr, size, tag_mode);               \
+}
+
+FAST_DECODER(AlgorithmIdentifier)
+FAST_DECODER(Extension)
+FAST_DECODER(RevokedCertificate)
+FAST_DECODER(TBSCertificate)
+FAST_DECODER(Certificate)
+FAST_DECODER(SignerInfo)
+FAST_DECODER(SingleResponse)
+FAST_DECODER(ResponseData)
+FAST_DECODER(BasicOCSPResponse)
+FAST_DECODER(TSTInfo)
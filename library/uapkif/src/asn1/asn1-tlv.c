@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2023, The UAPKI Project Authors.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define FILE_MARKER "uapkif/asn1/asn1-tlv.c"
+
+#include "asn1-utils.h"
+#include "macros-internal.h"
+
+//  Zero-allocation DER walker: only tags and lengths are parsed, the content is never decoded.
+//  It is used to enumerate or skip large structures (CRL entries, attributes) and to take
+//  the exact encoded bytes of an element for hashing or deferred decoding.
+
+#define ASN_TLV_MAX_TAG_BYTES       4
+#define ASN_TLV_MAX_LENGTH_BYTES    4
+
+int asn_tlv_read(const uint8_t *buf, size_t size, AsnTlv *tlv)
+{
+    size_t p = 0, len, cnt;
+    uint32_t tag;
+
+    if (!buf || !tlv || (size < 2)) return RET_ASN1_DECODE_ERROR;
+
+    tag = buf[p++];
+    if ((tag & 0x1F) == 0x1F) {
+        //  High tag number: base-128 octets, the last one has bit 8 cleared
+        do {
+            if ((p == size) || (p == ASN_TLV_MAX_TAG_BYTES)) return RET_ASN1_DECODE_ERROR;
+            tag = (tag << 8) | buf[p];
+        } while (buf[p++] & 0x80);
+    }
+
+    if (p == size) return RET_ASN1_DECODE_ERROR;
+    len = buf[p++];
+    if (len & 0x80) {
+        cnt = len & 0x7F;
+        //  Indefinite length is not DER
+        if ((cnt == 0) || (cnt > ASN_TLV_MAX_LENGTH_BYTES) || (size - p < cnt)) return RET_ASN1_DECODE_ERROR;
+        for (len = 0; cnt > 0; cnt--) {
+            len = (len << 8) | buf[p++];
+        }
+    }
+    if (size - p < len) return RET_ASN1_DECODE_ERROR;
+
+    tlv->tag = tag;
+    tlv->tlv = buf;
+    tlv->tlv_len = p + len;
+    tlv->value = buf + p;
+    tlv->len = len;
+    return RET_OK;
+}
+
+void asn_tlv_cursor_init(AsnTlvCursor *cursor, const uint8_t *buf, size_t size)
+{
+    if (!cursor) return;
+
+    cursor->buf = buf;
+    cursor->size = buf ? size : 0;
+    cursor->pos = 0;
+}
+
+int asn_tlv_enter(AsnTlvCursor *cursor, const AsnTlv *tlv)
+{
+    if (!cursor || !tlv || !tlv->tlv || !ASN_TLV_IS_CONSTRUCTED(tlv)) return RET_ASN1_DECODE_ERROR;
+
+    cursor->buf = tlv->value;
+    cursor->size = tlv->len;
+    cursor->pos = 0;
+    return RET_OK;
+}
+
+bool asn_tlv_cursor_end(const AsnTlvCursor *cursor)
+{
+    return (!cursor || (cursor->pos >= cursor->size));
+}
+
+int asn_tlv_peek(const AsnTlvCursor *cursor, AsnTlv *tlv)
+{
+    if (asn_tlv_cursor_end(cursor)) return RET_ASN1_DECODE_ERROR;
+
+    return asn_tlv_read(cursor->buf + cursor->pos, cursor->size - cursor->pos, tlv);
+}
+
+int asn_tlv_next(AsnTlvCursor *cursor, AsnTlv *tlv)
+{
+    AsnTlv cur;
+    int ret = asn_tlv_peek(cursor, &cur);
+
+    if (ret == RET_OK) {
+        cursor->pos += cur.tlv_len;
+        if (tlv) {
+            *tlv = cur;
+        }
+    }
+    return ret;
+}
+
+int asn_tlv_skip(AsnTlvCursor *cursor)
+{
+    return asn_tlv_next(cursor, NULL);
+}
+
+int asn_tlv_find_tag(AsnTlvCursor *cursor, uint32_t tag, AsnTlv *tlv)
+{
+    AsnTlv cur;
+    int ret;
+
+    while (!asn_tlv_cursor_end(cursor)) {
+        ret = asn_tlv_next(cursor, &cur);
+        if (ret != RET_OK) return ret;
+        if (cur.tag == tag) {
+            if (tlv) {
+                *tlv = cur;
+            }
+            return RET_OK;
+        }
+    }
+    return RET_ASN1_NOT_FOUND;
+}
+
+ByteArray *asn_tlv_to_ba_view(const AsnTlv *tlv)
+{
+    if (!tlv || !tlv->tlv) return NULL;
+
+    return ba_alloc_view(tlv->tlv, tlv->tlv_len);
+}
@@ -28,6 +28,15 @@
 #define FILE_MARKER "uapkif/asn1/asn1-utils.c"
 
 #include "asn1-utils.h"
+#include "asn_internal.h"
+#include "asn_SET_OF.h"
+#include "BIT_STRING.h"
+#include "BOOLEAN.h"
+#include "INTEGER.h"
+#include "NULL.h"
+#include "NativeInteger.h"
+#include "constr_SEQUENCE_OF.h"
+#include "constr_SET_OF.h"
 #include "macros-internal.h"
 #include <time.h>
 
@@ -35,33 +44,348 @@
 #error Supported only 64bit time
 #endif
 
-struct _callback_arg {
-    uint8_t *buffer;
-    size_t   offset;
-    size_t   size;
-};
+/*
+ * Базовый тип ASN.1 структуры, определяемый по asn_TYPE_descriptor_t.
+ */
+typedef enum {
+    ASN_KIND_UNKNOWN = 0,
+    ASN_KIND_PRIMITIVE,
+    ASN_KIND_OCTET_STRING,
+    ASN_KIND_BOOLEAN,
+    ASN_KIND_NULL,
+    ASN_KIND_NATIVE_INTEGER,
+    ASN_KIND_SEQUENCE,
+    ASN_KIND_SET_OF,
+    ASN_KIND_CHOICE
+} AsnStructKind;
+
+#define ASN_INHERIT_DEPTH_MAX 8
+
+static AsnStructKind asn_struct_kind(asn_TYPE_descriptor_t *td)
+{
+    asn_struct_free_f *free_struct;
+    int i;
+
+    for (i = 0; i < ASN_INHERIT_DEPTH_MAX; i++) {
+        free_struct = td->free_struct;
+        if (free_struct == SEQUENCE_free) {
+            return ASN_KIND_SEQUENCE;
+        } else if (free_struct == SET_OF_free) {
+            return ASN_KIND_SET_OF;
+        } else if (free_struct == CHOICE_free) {
+            return ASN_KIND_CHOICE;
+        } else if (free_struct == OCTET_STRING_free) {
+            return ASN_KIND_OCTET_STRING;
+        } else if (free_struct == ASN__PRIMITIVE_TYPE_free) {
+            return ASN_KIND_PRIMITIVE;
+        } else if (free_struct == NativeInteger_free) {
+            return ASN_KIND_NATIVE_INTEGER;
+        } else if (free_struct == BOOLEAN_free) {
+            return (td->der_encoder == NULL_encode_der) ? ASN_KIND_NULL : ASN_KIND_BOOLEAN;
+        }
+
+        //  Derived types copy the base descriptor into td on the first call
+        free_struct(td, NULL, 0);
+        if (td->free_struct == free_struct) {
+            break;
+        }
+    }
+
+    return ASN_KIND_UNKNOWN;
+}
+
+static int asn_choice_get_present(const void *sptr, const asn_CHOICE_specifics_t *specs)
+{
+    const void *present_ptr = (const char *)sptr + specs->pres_offset;
+
+    switch (specs->pres_size) {
+    case sizeof(int):
+        return *(const int *)present_ptr;
+    case sizeof(short):
+        return *(const short *)present_ptr;
+    case sizeof(char):
+        return *(const char *)present_ptr;
+    default:
+        return 0;
+    }
+}
+
+/*
+ * DER-кодирование выполняется в два прохода: первый проход снизу вверх
+ * вычисляет и кэширует длины всех узлов, второй записывает результат
+ * в буфер точного размера. Каждое поддерево кодируется один раз.
+ */
+typedef struct DerLenCache_st {
+    size_t *lens;
+    size_t count;
+    size_t size;
+    size_t pos;
+} DerLenCache;
+
+typedef struct DerWriter_st {
+    uint8_t *buf;
+    size_t offset;
+    size_t size;
+} DerWriter;
+
+typedef struct DerElement_st {
+    const uint8_t *buf;
+    size_t len;
+} DerElement;
+
+static int der_writer_cb(const void *buffer, size_t size, void *key)
+{
+    DerWriter *writer = (DerWriter *)key;
+
+    if (size > writer->size - writer->offset) {
+        return -1;
+    }
+
+    memcpy(writer->buf + writer->offset, buffer, size);
+    writer->offset += size;
+    return 0;
+}
+
+static int der_element_cmp(const void *ap, const void *bp)
+{
+    const DerElement *a = (const DerElement *)ap;
+    const DerElement *b = (const DerElement *)bp;
+    const int ret = memcmp(a->buf, b->buf, (a->len < b->len) ? a->len : b->len);
+
+    if (ret != 0) {
+        return ret;
+    }
+    return (a->len < b->len) ? -1 : (a->len > b->len) ? 1 : 0;
+}
 
-static int der_encode_consume_bytes(const void *buffer, size_t size, void *key)
+static int der_cache_add(DerLenCache *cache, size_t *slot)
 {
-    struct _callback_arg *arg = (struct _callback_arg *)key;
     int ret = RET_OK;
 
-    if ((arg->offset + size) >= arg->size) {
-        size_t nsize = (arg->size ? arg->size << 2 : 16) + size;
+    if (cache->count == cache->size) {
+        size_t nsize = cache->size ? cache->size << 1 : 64;
         void *p = NULL;
 
-        REALLOC_CHECKED(arg->buffer, nsize, p);
+        REALLOC_CHECKED(cache->lens, nsize * sizeof(size_t), p);
+
+        cache->lens = (size_t *)p;
+        cache->size = nsize;
+    }
+
+    *slot = cache->count++;
+
+cleanup:
+    return ret;
+}
+
+static int der_member_ptr(const asn_TYPE_member_t *elm, const void *sptr, const void **memb_ptr)
+{
+    *memb_ptr = (const char *)sptr + elm->memb_offset;
+    if (elm->flags & ATF_POINTER) {
+        *memb_ptr = *(const void * const *)*memb_ptr;
+        if (!*memb_ptr) {
+            return elm->optional ? RET_OK : RET_ASN1_ERROR;
+        }
+    }
+    return RET_OK;
+}
+
+static int der_choice_member(asn_TYPE_descriptor_t *td, const void *sptr, const asn_TYPE_member_t **elm)
+{
+    const int present = asn_choice_get_present(sptr, (const asn_CHOICE_specifics_t *)td->specifics);
+
+    if ((present <= 0) || (present > td->elements_count)) {
+        *elm = NULL;
+        return ((present == 0) && (td->elements_count == 0)) ? RET_OK : RET_ASN1_ERROR;
+    }
+
+    *elm = &td->elements[present - 1];
+    return RET_OK;
+}
+
+static int der_measure(asn_TYPE_descriptor_t *td, const void *sptr, int tag_mode, ber_tlv_tag_t tag,
+        DerLenCache *cache, size_t *encoded_len)
+{
+    const void *memb_ptr = NULL;
+    size_t content_len = 0;
+    size_t memb_len = 0;
+    size_t slot = 0;
+    ssize_t tags_len = 0;
+    int i;
+    int ret = RET_OK;
+
+    //  Resolves derived types, so that der_encoder below is the base encoder
+    (void)asn_struct_kind(td);
+    DO(der_cache_add(cache, &slot));
+
+    if (td->der_encoder == SEQUENCE_encode_der) {
+        for (i = 0; i < td->elements_count; i++) {
+            const asn_TYPE_member_t *elm = &td->elements[i];
+            DO(der_member_ptr(elm, sptr, &memb_ptr));
+            if (memb_ptr) {
+                DO(der_measure(elm->type, memb_ptr, elm->tag_mode, elm->tag, cache, &memb_len));
+                content_len += memb_len;
+            }
+        }
+        tags_len = der_write_tags(td, content_len, tag_mode, 1, tag, NULL, NULL);
+    } else if ((td->der_encoder == SET_OF_encode_der) || (td->der_encoder == SEQUENCE_OF_encode_der)) {
+        const asn_anonymous_set_ *list = _A_CSET_FROM_VOID(sptr);
+        for (i = 0; i < list->count; i++) {
+            if (list->array[i]) {
+                DO(der_measure(td->elements[0].type, list->array[i], 0, td->elements[0].tag, cache, &memb_len));
+                content_len += memb_len;
+            }
+        }
+        tags_len = der_write_tags(td, content_len, tag_mode, 1, tag, NULL, NULL);
+    } else if (td->der_encoder == CHOICE_encode_der) {
+        const asn_TYPE_member_t *elm = NULL;
+        DO(der_choice_member(td, sptr, &elm));
+        if (elm) {
+            DO(der_member_ptr(elm, sptr, &memb_ptr));
+        }
+        if (memb_ptr) {
+            DO(der_measure(elm->type, memb_ptr, elm->tag_mode, elm->tag, cache, &content_len));
+            if ((tag_mode == 1) || td->tags_count) {
+                tags_len = der_write_tags(td, content_len, tag_mode, 1, tag, NULL, NULL);
+            }
+        }
+    } else {
+        const asn_enc_rval_t erval = td->der_encoder(td, (void *)sptr, tag_mode, tag, NULL, NULL);
+        if (erval.encoded == -1) {
+            SET_ERROR(RET_ASN1_ERROR);
+        }
+        content_len = erval.encoded;
+    }
+
+    if (tags_len == -1) {
+        SET_ERROR(RET_ASN1_ERROR);
+    }
+
+    cache->lens[slot] = content_len;
+    *encoded_len = tags_len + content_len;
+
+cleanup:
+    return ret;
+}
+
+static int der_write_set_of_sorted(DerWriter *writer, size_t start, const DerElement *els, size_t els_count)
+{
+    DerElement *sorted = NULL;
+    uint8_t *content = NULL;
+    const size_t content_len = writer->offset - start;
+    size_t i;
+    int ret = RET_OK;
+
+    MALLOC_CHECKED(sorted, els_count * sizeof(DerElement));
+    MALLOC_CHECKED(content, content_len);
+    memcpy(content, writer->buf + start, content_len);
 
-        arg->buffer = (uint8_t *)p;
-        arg->size = nsize;
+    for (i = 0; i < els_count; i++) {
+        sorted[i].buf = content + (els[i].buf - (writer->buf + start));
+        sorted[i].len = els[i].len;
     }
+    qsort(sorted, els_count, sizeof(DerElement), der_element_cmp);
 
-    memcpy(arg->buffer + arg->offset, buffer, size);
-    arg->offset += size;
-    ASSERT(arg->offset < arg->size);
+    writer->offset = start;
+    for (i = 0; i < els_count; i++) {
+        (void)der_writer_cb(sorted[i].buf, sorted[i].len, writer);
+    }
 
 cleanup:
+    free(sorted);
+    free(content);
+    return ret;
+}
 
+static int der_write(asn_TYPE_descriptor_t *td, const void *sptr, int tag_mode, ber_tlv_tag_t tag,
+        DerLenCache *cache, DerWriter *writer)
+{
+    const void *memb_ptr = NULL;
+    const size_t content_len = cache->lens[cache->pos++];
+    DerElement *els = NULL;
+    int i;
+    int ret = RET_OK;
+
+    if (td->der_encoder == SEQUENCE_encode_der) {
+        if (der_write_tags(td, content_len, tag_mode, 1, tag, der_writer_cb, writer) == -1) {
+            SET_ERROR(RET_ASN1_ERROR);
+        }
+        for (i = 0; i < td->elements_count; i++) {
+            const asn_TYPE_member_t *elm = &td->elements[i];
+            DO(der_member_ptr(elm, sptr, &memb_ptr));
+            if (memb_ptr) {
+                DO(der_write(elm->type, memb_ptr, elm->tag_mode, elm->tag, cache, writer));
+            }
+        }
+    } else if ((td->der_encoder == SET_OF_encode_der) || (td->der_encoder == SEQUENCE_OF_encode_der)) {
+        const asn_anonymous_set_ *list = _A_CSET_FROM_VOID(sptr);
+        const bool sort = (td->der_encoder == SET_OF_encode_der) && (list->count > 1);
+        size_t els_count = 0;
+        size_t start;
+        if (der_write_tags(td, content_len, tag_mode, 1, tag, der_writer_cb, writer) == -1) {
+            SET_ERROR(RET_ASN1_ERROR);
+        }
+        if (sort) {
+            MALLOC_CHECKED(els, list->count * sizeof(DerElement));
+        }
+        start = writer->offset;
+        for (i = 0; i < list->count; i++) {
+            if (list->array[i]) {
+                const size_t el_start = writer->offset;
+                DO(der_write(td->elements[0].type, list->array[i], 0, td->elements[0].tag, cache, writer));
+                if (sort) {
+                    els[els_count].buf = writer->buf + el_start;
+                    els[els_count].len = writer->offset - el_start;
+                    els_count++;
+                }
+            }
+        }
+        //  DER mandates SET OF elements sorted by their encodings
+        if (els_count > 1) {
+            DO(der_write_set_of_sorted(writer, start, els, els_count));
+        }
+    } else if (td->der_encoder == CHOICE_encode_der) {
+        const asn_TYPE_member_t *elm = NULL;
+        DO(der_choice_member(td, sptr, &elm));
+        if (elm) {
+            DO(der_member_ptr(elm, sptr, &memb_ptr));
+        }
+        if (memb_ptr) {
+            if (((tag_mode == 1) || td->tags_count)
+                    && (der_write_tags(td, content_len, tag_mode, 1, tag, der_writer_cb, writer) == -1)) {
+                SET_ERROR(RET_ASN1_ERROR);
+            }
+            DO(der_write(elm->type, memb_ptr, elm->tag_mode, elm->tag, cache, writer));
+        }
+    } else {
+        const asn_enc_rval_t erval = td->der_encoder(td, (void *)sptr, tag_mode, tag, der_writer_cb, writer);
+        if ((erval.encoded == -1) || ((size_t)erval.encoded != content_len)) {
+            SET_ERROR(RET_ASN1_ERROR);
+        }
+    }
+
+cleanup:
+    free(els);
+    return ret;
+}
+
+static int der_encode_cached(asn_TYPE_descriptor_t *desc, const void *object, DerLenCache *cache,
+        uint8_t *buf, size_t len)
+{
+    DerWriter writer;
+    int ret = RET_OK;
+
+    writer.buf = buf;
+    writer.offset = 0;
+    writer.size = len;
+    cache->pos = 0;
+
+    DO(der_write(desc, object, 0, 0, cache, &writer));
+    if (writer.offset != len) {
+        SET_ERROR(RET_ASN1_ERROR);
+    }
+
+cleanup:
     return ret;
 }
 
@@ -79,47 +403,55 @@ cleanup:
 int asn_encode(asn_TYPE_descriptor_t *desc, const void *object,
         uint8_t **encode, size_t *encode_len)
 {
-    struct _callback_arg arg_cb;
-    asn_enc_rval_t ret_old;
+    DerLenCache cache;
+    uint8_t *buf = NULL;
+    size_t len = 0;
     int ret = RET_OK;
 
+    memset(&cache, 0, sizeof(cache));
+
     CHECK_PARAM(desc != NULL);
     CHECK_PARAM(object != NULL);
     CHECK_PARAM(encode != NULL);
     CHECK_PARAM(encode_len != NULL);
 
-    arg_cb.offset = arg_cb.size = 0;
-    arg_cb.buffer = 0;
+    DO(der_measure(desc, object, 0, 0, &cache, &len));
+    MALLOC_CHECKED(buf, len ? len : 1);
+    DO(der_encode_cached(desc, object, &cache, buf, len));
 
-    ret_old = der_encode(desc, (void *)object, der_encode_consume_bytes, &arg_cb);
+    *encode = buf;
+    *encode_len = len;
+    buf = NULL;
 
-    if (ret_old.encoded == -1) {
-        free(arg_cb.buffer);
-        SET_ERROR(RET_ASN1_ERROR);
-    }
-
-    *encode = arg_cb.buffer;
-    *encode_len = ret_old.encoded;
 cleanup:
-
+    free(buf);
+    free(cache.lens);
     return ret;
 }
 
 int asn_encode_ba(asn_TYPE_descriptor_t *desc, const void *object, ByteArray **encoded)
 {
-    uint8_t *encoded_bytes = NULL;
-    size_t encoded_bytes_len = 0;
+    DerLenCache cache;
+    ByteArray *ba_encoded = NULL;
+    size_t len = 0;
     int ret = RET_OK;
 
+    memset(&cache, 0, sizeof(cache));
+
     CHECK_PARAM(desc);
     CHECK_PARAM(object);
     CHECK_PARAM(encoded);
 
-    DO(asn_encode(desc, object, &encoded_bytes, &encoded_bytes_len));
-    CHECK_NOT_NULL(*encoded = ba_alloc_from_uint8(encoded_bytes, encoded_bytes_len));
+    DO(der_measure(desc, object, 0, 0, &cache, &len));
+    CHECK_NOT_NULL(ba_encoded = len ? ba_alloc_by_len(len) : ba_alloc());
+    DO(der_encode_cached(desc, object, &cache, ba_get_buf(ba_encoded), len));
+
+    *encoded = ba_encoded;
+    ba_encoded = NULL;
 
 cleanup:
-    free(encoded_bytes);
+    ba_free(ba_encoded);
+    free(cache.lens);
     return ret;
 }
 /**
@@ -198,6 +530,356 @@ cleanup:
     return value;
 }
 
+/*
+ * Структурное копирование и сравнение выполняется по таблицам членов
+ * asn_TYPE_descriptor_t, без промежуточного DER-кодирования.
+ * Для типов, не покрытых обходом (SET и неизвестные базовые типы),
+ * используется кодирование.
+ */
+static size_t asn_struct_size(asn_TYPE_descriptor_t *td, AsnStructKind kind)
+{
+    switch (kind) {
+    case ASN_KIND_PRIMITIVE:
+        return sizeof(ASN__PRIMITIVE_TYPE_t);
+    case ASN_KIND_OCTET_STRING:
+        return td->specifics
+                ? (size_t)((asn_OCTET_STRING_specifics_t *)td->specifics)->struct_size
+                : sizeof(OCTET_STRING_t);
+    case ASN_KIND_BOOLEAN:
+    case ASN_KIND_NULL:
+        return sizeof(BOOLEAN_t);
+    case ASN_KIND_NATIVE_INTEGER:
+        return sizeof(long);
+    case ASN_KIND_SEQUENCE:
+        return ((asn_SEQUENCE_specifics_t *)td->specifics)->struct_size;
+    case ASN_KIND_SET_OF:
+        return ((asn_SET_OF_specifics_t *)td->specifics)->struct_size;
+    case ASN_KIND_CHOICE:
+        return ((asn_CHOICE_specifics_t *)td->specifics)->struct_size;
+    default:
+        return 0;
+    }
+}
+
+static void asn_choice_set_present(void *sptr, const asn_CHOICE_specifics_t *specs, int present)
+{
+    void *present_ptr = (char *)sptr + specs->pres_offset;
+
+    switch (specs->pres_size) {
+    case sizeof(int):
+        *(int *)present_ptr = present;
+        break;
+    case sizeof(short):
+        *(short *)present_ptr = (short)present;
+        break;
+    case sizeof(char):
+        *(char *)present_ptr = (char)present;
+        break;
+    }
+}
+
+static int asn_copy_der(asn_TYPE_descriptor_t *type, const void *src, void *dst)
+{
+    uint8_t *encode = NULL;
+    size_t encode_len = 0;
+    int ret = RET_OK;
+
+    DO(asn_encode(type, src, &encode, &encode_len));
+    DO(asn_decode(type, dst, encode, encode_len));
+
+cleanup:
+    free(encode);
+    return ret;
+}
+
+static bool asn_equals_der(asn_TYPE_descriptor_t *type, const void *a, const void *b)
+{
+    uint8_t *a_buffer = NULL;
+    uint8_t *b_buffer = NULL;
+    size_t a_size = 0;
+    size_t b_size = 0;
+    int ret = RET_OK;
+
+    DO(asn_encode(type, a, &a_buffer, &a_size));
+    DO(asn_encode(type, b, &b_buffer, &b_size));
+
+    ret = (a_size == b_size) ? memcmp(a_buffer, b_buffer, a_size) : -1;
+
+cleanup:
+    free(a_buffer);
+    free(b_buffer);
+    return (ret == 0);
+}
+
+static int asn_copy_struct(asn_TYPE_descriptor_t *td, const void *src, void *dst);
+
+static int asn_copy_alloc_struct(asn_TYPE_descriptor_t *td, const void *src, void **dst)
+{
+    void *object = NULL;
+    uint8_t *encode = NULL;
+    size_t encode_len = 0;
+    size_t struct_size;
+    int ret = RET_OK;
+
+    struct_size = asn_struct_size(td, asn_struct_kind(td));
+    if (struct_size > 0) {
+        CALLOC_CHECKED(object, struct_size);
+        DO(asn_copy_struct(td, src, object));
+    } else {
+        DO(asn_encode(td, src, &encode, &encode_len));
+        CHECK_NOT_NULL(object = asn_decode_with_alloc(td, encode, encode_len));
+    }
+
+    *dst = object;
+    object = NULL;
+
+cleanup:
+    if (object) {
+        ASN_FREE(td, object);
+    }
+    free(encode);
+    return ret;
+}
+
+static int asn_copy_buf(const uint8_t *src, int size, uint8_t **dst)
+{
+    uint8_t *buf = NULL;
+    int ret = RET_OK;
+
+    if (src) {
+        //  Keep the trailing zero added by the asn1c decoders
+        MALLOC_CHECKED(buf, (size_t)size + 1);
+        memcpy(buf, src, size);
+        buf[size] = 0;
+    }
+    *dst = buf;
+
+cleanup:
+    return ret;
+}
+
+static int asn_copy_struct(asn_TYPE_descriptor_t *td, const void *src, void *dst)
+{
+    int ret = RET_OK;
+
+    switch (asn_struct_kind(td)) {
+    case ASN_KIND_PRIMITIVE: {
+        const ASN__PRIMITIVE_TYPE_t *s = (const ASN__PRIMITIVE_TYPE_t *)src;
+        ASN__PRIMITIVE_TYPE_t *d = (ASN__PRIMITIVE_TYPE_t *)dst;
+        DO(asn_copy_buf(s->buf, s->size, &d->buf));
+        d->size = s->size;
+        break;
+    }
+    case ASN_KIND_OCTET_STRING: {
+        const asn_OCTET_STRING_specifics_t *specs = (const asn_OCTET_STRING_specifics_t *)td->specifics;
+        const size_t struct_size = asn_struct_size(td, ASN_KIND_OCTET_STRING);
+        const int ctx_offset = specs ? specs->ctx_offset : (int)offsetof(OCTET_STRING_t, _asn_ctx);
+        const OCTET_STRING_t *s = (const OCTET_STRING_t *)src;
+        uint8_t *buf = NULL;
+        DO(asn_copy_buf(s->buf, s->size, &buf));
+        //  Whole-struct copy also carries BIT STRING's bits_unused
+        memcpy(dst, src, struct_size);
+        memset((char *)dst + ctx_offset, 0, sizeof(asn_struct_ctx_t));
+        ((OCTET_STRING_t *)dst)->buf = buf;
+        break;
+    }
+    case ASN_KIND_BOOLEAN:
+    case ASN_KIND_NULL:
+        *(BOOLEAN_t *)dst = *(const BOOLEAN_t *)src;
+        break;
+    case ASN_KIND_NATIVE_INTEGER:
+        *(long *)dst = *(const long *)src;
+        break;
+    case ASN_KIND_SEQUENCE: {
+        int i;
+        for (i = 0; i < td->elements_count; i++) {
+            const asn_TYPE_member_t *elm = &td->elements[i];
+            const void *memb_src = (const char *)src + elm->memb_offset;
+            void *memb_dst = (char *)dst + elm->memb_offset;
+            if (elm->flags & ATF_POINTER) {
+                memb_src = *(const void * const *)memb_src;
+                if (!memb_src) {
+                    if (!elm->optional) {
+                        SET_ERROR(RET_ASN1_ERROR);
+                    }
+                    continue;
+                }
+                DO(asn_copy_alloc_struct(elm->type, memb_src, (void **)memb_dst));
+            } else {
+                DO(asn_copy_struct(elm->type, memb_src, memb_dst));
+            }
+        }
+        break;
+    }
+    case ASN_KIND_SET_OF: {
+        const asn_anonymous_set_ *s = _A_CSET_FROM_VOID(src);
+        asn_anonymous_set_ *d = _A_SET_FROM_VOID(dst);
+        asn_TYPE_descriptor_t *elm_type = td->elements[0].type;
+        if (s->count > 0) {
+            CALLOC_CHECKED(d->array, s->count * sizeof(void *));
+            d->size = s->count;
+            for (d->count = 0; d->count < s->count; d->count++) {
+                DO(asn_copy_alloc_struct(elm_type, s->array[d->count], &d->array[d->count]));
+            }
+        }
+        break;
+    }
+    case ASN_KIND_CHOICE: {
+        const asn_CHOICE_specifics_t *specs = (const asn_CHOICE_specifics_t *)td->specifics;
+        const int present = asn_choice_get_present(src, specs);
+        const asn_TYPE_member_t *elm;
+        const void *memb_src;
+        void *memb_dst;
+        if ((present <= 0) || (present > td->elements_count)) {
+            SET_ERROR(RET_ASN1_ERROR);
+        }
+        elm = &td->elements[present - 1];
+        memb_src = (const char *)src + elm->memb_offset;
+        memb_dst = (char *)dst + elm->memb_offset;
+        if (elm->flags & ATF_POINTER) {
+            memb_src = *(const void * const *)memb_src;
+            if (!memb_src) {
+                SET_ERROR(RET_ASN1_ERROR);
+            }
+            DO(asn_copy_alloc_struct(elm->type, memb_src, (void **)memb_dst));
+        } else {
+            DO(asn_copy_struct(elm->type, memb_src, memb_dst));
+        }
+        asn_choice_set_present(dst, specs, present);
+        break;
+    }
+    default:
+        DO(asn_copy_der(td, src, dst));
+        break;
+    }
+
+cleanup:
+    return ret;
+}
+
+static bool asn_equals_integer(const ASN__PRIMITIVE_TYPE_t *a, const ASN__PRIMITIVE_TYPE_t *b)
+{
+    const uint8_t *a_buf = a->buf;
+    const uint8_t *b_buf = b->buf;
+    int a_size = a->buf ? a->size : 0;
+    int b_size = b->buf ? b->size : 0;
+
+    //  Skip the superfluous sign extension, as INTEGER_encode_der does
+    while ((a_size > 1) && (((a_buf[0] == 0x00) && !(a_buf[1] & 0x80)) || ((a_buf[0] == 0xFF) && (a_buf[1] & 0x80)))) {
+        a_buf++;
+        a_size--;
+    }
+    while ((b_size > 1) && (((b_buf[0] == 0x00) && !(b_buf[1] & 0x80)) || ((b_buf[0] == 0xFF) && (b_buf[1] & 0x80)))) {
+        b_buf++;
+        b_size--;
+    }
+
+    return (a_size == b_size) && ((a_size == 0) || (memcmp(a_buf, b_buf, a_size) == 0));
+}
+
+static bool asn_equals_struct(asn_TYPE_descriptor_t *td, const void *a, const void *b)
+{
+    if (a == b) {
+        return true;
+    }
+
+    switch (asn_struct_kind(td)) {
+    case ASN_KIND_PRIMITIVE: {
+        const ASN__PRIMITIVE_TYPE_t *pa = (const ASN__PRIMITIVE_TYPE_t *)a;
+        const ASN__PRIMITIVE_TYPE_t *pb = (const ASN__PRIMITIVE_TYPE_t *)b;
+        if (td->der_encoder == INTEGER_encode_der) {
+            return asn_equals_integer(pa, pb);
+        }
+        return (pa->size == pb->size) && ((pa->size == 0) || (memcmp(pa->buf, pb->buf, pa->size) == 0));
+    }
+    case ASN_KIND_OCTET_STRING: {
+        const asn_OCTET_STRING_specifics_t *specs = (const asn_OCTET_STRING_specifics_t *)td->specifics;
+        const OCTET_STRING_t *pa = (const OCTET_STRING_t *)a;
+        const OCTET_STRING_t *pb = (const OCTET_STRING_t *)b;
+        if (specs && (specs->subvariant == ASN_OSUBV_BIT)) {
+            //  As OCTET_STRING_encode_der writes it: 3 bits of bits_unused, the unused bits are zeroed
+            const int unused = ((const BIT_STRING_t *)a)->bits_unused & 0x07;
+            if ((pa->size != pb->size) || (unused != (((const BIT_STRING_t *)b)->bits_unused & 0x07))) {
+                return false;
+            }
+            if (pa->size == 0) {
+                return true;
+            }
+            return (memcmp(pa->buf, pb->buf, pa->size - 1) == 0)
+                    && (((pa->buf[pa->size - 1] ^ pb->buf[pa->size - 1]) & (0xFF << unused) & 0xFF) == 0);
+        }
+        return (pa->size == pb->size) && ((pa->size == 0) || (memcmp(pa->buf, pb->buf, pa->size) == 0));
+    }
+    case ASN_KIND_BOOLEAN:
+        return !*(const BOOLEAN_t *)a == !*(const BOOLEAN_t *)b;
+    case ASN_KIND_NULL:
+        return true;
+    case ASN_KIND_NATIVE_INTEGER:
+        return *(const long *)a == *(const long *)b;
+    case ASN_KIND_SEQUENCE: {
+        int i;
+        for (i = 0; i < td->elements_count; i++) {
+            const asn_TYPE_member_t *elm = &td->elements[i];
+            const void *memb_a = (const char *)a + elm->memb_offset;
+            const void *memb_b = (const char *)b + elm->memb_offset;
+            if (elm->flags & ATF_POINTER) {
+                memb_a = *(const void * const *)memb_a;
+                memb_b = *(const void * const *)memb_b;
+                if (!memb_a || !memb_b) {
+                    if (memb_a || memb_b || !elm->optional) {
+                        return false;
+                    }
+                    continue;
+                }
+            }
+            if (!asn_equals_struct(elm->type, memb_a, memb_b)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    case ASN_KIND_SET_OF: {
+        const asn_anonymous_set_ *la = _A_CSET_FROM_VOID(a);
+        const asn_anonymous_set_ *lb = _A_CSET_FROM_VOID(b);
+        asn_TYPE_descriptor_t *elm_type = td->elements[0].type;
+        int i;
+        if (la->count != lb->count) {
+            return false;
+        }
+        for (i = 0; i < la->count; i++) {
+            if (!asn_equals_struct(elm_type, la->array[i], lb->array[i])) {
+                //  DER sorts SET OF components, so a different order may still be equal
+                return (td->der_encoder == SET_OF_encode_der) && asn_equals_der(td, a, b);
+            }
+        }
+        return true;
+    }
+    case ASN_KIND_CHOICE: {
+        const asn_CHOICE_specifics_t *specs = (const asn_CHOICE_specifics_t *)td->specifics;
+        const int present = asn_choice_get_present(a, specs);
+        const asn_TYPE_member_t *elm;
+        const void *memb_a;
+        const void *memb_b;
+        if ((present <= 0) || (present > td->elements_count) || (present != asn_choice_get_present(b, specs))) {
+            return false;
+        }
+        elm = &td->elements[present - 1];
+        memb_a = (const char *)a + elm->memb_offset;
+        memb_b = (const char *)b + elm->memb_offset;
+        if (elm->flags & ATF_POINTER) {
+            memb_a = *(const void * const *)memb_a;
+            memb_b = *(const void * const *)memb_b;
+            if (!memb_a || !memb_b) {
+                return false;
+            }
+        }
+        return asn_equals_struct(elm->type, memb_a, memb_b);
+    }
+    default:
+        return asn_equals_der(td, a, b);
+    }
+}
+
 /**
  * Создает копию ASN.1 объекта заданного типа.
  * Если (*dst == NULL) выделяется память.
@@ -211,22 +893,16 @@ cleanup:
  */
 int asn_copy(asn_TYPE_descriptor_t *type, const void *src, void *dst)
 {
-    uint8_t *encode = NULL;
-    size_t encode_len = 0;
     int ret = RET_OK;
 
     CHECK_PARAM(type != NULL);
     CHECK_PARAM(src != NULL);
     CHECK_PARAM(dst != NULL);
 
-    DO(asn_encode(type, src, &encode, &encode_len));
-    DO(asn_decode(type, dst, encode, encode_len));
-    CHECK_NOT_NULL(dst);
+    DO(asn_copy_struct(type, src, dst));
 
 cleanup:
 
-    free(encode);
-
     return ret;
 }
 
@@ -243,22 +919,16 @@ cleanup:
 */
 void *asn_copy_with_alloc(asn_TYPE_descriptor_t *type, const void *src)
 {
-    uint8_t *encode = NULL;
     void *dst = NULL;
-    size_t encode_len = 0;
     int ret = RET_OK;
 
     CHECK_PARAM(type != NULL);
     CHECK_PARAM(src != NULL);
 
-    DO(asn_encode(type, src, &encode, &encode_len));
-    dst = asn_decode_with_alloc(type, encode, encode_len);
-    CHECK_NOT_NULL(dst);
+    DO(asn_copy_alloc_struct(type, src, &dst));
 
 cleanup:
 
-    free(encode);
-
     return dst;
 }
 
@@ -273,32 +943,17 @@ cleanup:
  */
 bool asn_equals(asn_TYPE_descriptor_t *type, const void *a, const void *b)
 {
-    uint8_t *a_buffer = NULL;
-    uint8_t *b_buffer = NULL;
-    size_t a_size = 0;
-    size_t b_size = 0;
     int ret = RET_OK;
 
     CHECK_PARAM(type);
     CHECK_PARAM(a);
     CHECK_PARAM(b);
 
-    DO(asn_encode(type, a, &a_buffer, &a_size));
-    DO(asn_encode(type, b, &b_buffer, &b_size));
-
-    ret = (int)(a_size - b_size);
-    if (ret) {
-        goto cleanup;
-    }
-
-    ret = memcmp(a_buffer, b_buffer, a_size);
+    return asn_equals_struct(type, a, b);
 
 cleanup:
 
-    free(a_buffer);
-    free(b_buffer);
-
-    return (ret == 0);
+    return false;
 }
 
 int asn_parse_args_oid(const char *text, long **arcs, size_t *size)
@@ -856,12 +1511,17 @@ cleanup:
  */
 int asn_bytes2OCTSTRING(OCTET_STRING_t *octet, const unsigned char *bytes, size_t bytes_len)
 {
+    void *buf = NULL;
     int ret = RET_OK;
 
     CHECK_PARAM(octet != NULL);
     CHECK_PARAM(bytes != NULL);
 
-    REALLOC_CHECKED(octet->buf, bytes_len, octet->buf);
+    //  The memory of the object is reallocated by asn1c (it is rejected for the arena object)
+    if (NULL == (buf = REALLOC(octet->buf, bytes_len))) {
+        SET_ERROR(RET_MEMORY_ALLOC_ERROR);
+    }
+    octet->buf = buf;
     memcpy(octet->buf, bytes, bytes_len);
     octet->size = (int)bytes_len;
 
@@ -955,7 +1615,7 @@ int asn_bytes2INTEGER(INTEGER_t *integer, const unsigned char *value, size_t len
     }
 
     if (integer->buf) {
-        free(integer->buf);
+        FREEMEM(integer->buf);
     }
 
     integer->buf = buf;
@@ -1065,12 +1725,16 @@ cleanup:
  */
 int asn_bytes2BITSTRING(const unsigned char *bytes, BIT_STRING_t *string, size_t bytes_len)
 {
+    void *buf = NULL;
     int ret = RET_OK;
 
     CHECK_PARAM(string != NULL);
     CHECK_PARAM(bytes != NULL);
 
-    REALLOC_CHECKED(string->buf, bytes_len, string->buf);
+    if (NULL == (buf = REALLOC(string->buf, bytes_len))) {
+        SET_ERROR(RET_MEMORY_ALLOC_ERROR);
+    }
+    string->buf = buf;
 
     memcpy(string->buf, bytes, bytes_len);
     string->size = (int)bytes_len;
@@ -1210,7 +1874,7 @@ cleanup:
 void asn_free(asn_TYPE_descriptor_t *td, void *ptr)
 {
     if (td != NULL && ptr != NULL) {
-        td->free_struct(td, ptr, 0);
+        asn_mem_free_struct(td, ptr);
     }
 }
 
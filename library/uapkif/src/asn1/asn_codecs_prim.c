@@ -89,14 +89,18 @@ ber_decode_primitive(asn_codec_ctx_t *opt_codec_ctx,
         ASN__DECODE_FAILED;
     }
 
-    st->buf = (uint8_t *)MALLOC(length + 1);
+    /* Refer to the source bytes when decoding in the view mode */
+    st->buf = (uint8_t *)asn_mem_borrow(buf_ptr, length);
     if (!st->buf) {
-        st->size = 0;
-        ASN__DECODE_FAILED;
-    }
+        st->buf = (uint8_t *)MALLOC(length + 1);
+        if (!st->buf) {
+            st->size = 0;
+            ASN__DECODE_FAILED;
+        }
 
-    memcpy(st->buf, buf_ptr, length);
-    st->buf[length] = '\0';        /* Just in case */
+        memcpy(st->buf, buf_ptr, length);
+        st->buf[length] = '\0';        /* Just in case */
+    }
 
     rval.code = RC_OK;
     rval.consumed += length;
@@ -45,10 +45,33 @@ extern "C" {
 #define ASN1C_ENVIRONMENT_VERSION    923       /* Compile-time version */
 UAPKIF_EXPORT int get_asn1c_environment_version(void);       /* Run-time version */
 
-#define CALLOC(nmemb, size)    calloc(nmemb, size)
-#define MALLOC(size)           malloc(size)
-#define REALLOC(oldptr, size)  realloc(oldptr, size)
-#define FREEMEM(ptr)           free(ptr); ptr = NULL;
+/* Memory routines, redirected into the arena while asn_decode_arena() is active (asn1-arena.c).
+ * Outside of the decoding the memory of live arenas and their view sources is never freed or reallocated */
+void *asn_mem_calloc(size_t nmemb, size_t size);
+void *asn_mem_malloc(size_t size);
+void *asn_mem_realloc(void *ptr, size_t size);
+void asn_mem_free(void *ptr);
+/* Frees the object like td->free_struct(), the object decoded into an arena is left intact */
+void asn_mem_free_struct(asn_TYPE_descriptor_t *td, void *ptr);
+/* Returns ptr if the decoded object may refer to these source bytes (asn_decode_arena_view), NULL otherwise */
+const void *asn_mem_borrow(const void *ptr, size_t size);
+
+/* Straight-line DER decoders of the hot PKIX types, fall back to SEQUENCE_decode_ber (asn1-fast-decoders.c) */
+ber_type_decoder_f AlgorithmIdentifier_decode_ber_fast;
+ber_type_decoder_f BasicOCSPResponse_decode_ber_fast;
+ber_type_decoder_f Certificate_decode_ber_fast;
+ber_type_decoder_f Extension_decode_ber_fast;
+ber_type_decoder_f ResponseData_decode_ber_fast;
+ber_type_decoder_f RevokedCertificate_decode_ber_fast;
+ber_type_decoder_f SignerInfo_decode_ber_fast;
+ber_type_decoder_f SingleResponse_decode_ber_fast;
+ber_type_decoder_f TBSCertificate_decode_ber_fast;
+ber_type_decoder_f TSTInfo_decode_ber_fast;
+
+#define CALLOC(nmemb, size)    asn_mem_calloc(nmemb, size)
+#define MALLOC(size)           asn_mem_malloc(size)
+#define REALLOC(oldptr, size)  asn_mem_realloc(oldptr, size)
+#define FREEMEM(ptr)           asn_mem_free(ptr); ptr = NULL;
 
 #define asn_debug_indent    0
 #define ASN_DEBUG_INDENT_ADD(i) do{}while(0)
@@ -75,7 +75,7 @@ asn_TYPE_descriptor_t AlgorithmIdentifier_desc = {
     SEQUENCE_free,
     SEQUENCE_print,
     SEQUENCE_constraint,
-    SEQUENCE_decode_ber,
+    AlgorithmIdentifier_decode_ber_fast,
     SEQUENCE_encode_der,
     SEQUENCE_decode_xer,
     SEQUENCE_encode_xer,
@@ -100,7 +100,7 @@ asn_TYPE_descriptor_t BasicOCSPResponse_desc = {
     SEQUENCE_free,
     SEQUENCE_print,
     SEQUENCE_constraint,
-    SEQUENCE_decode_ber,
+    BasicOCSPResponse_decode_ber_fast,
     SEQUENCE_encode_der,
     SEQUENCE_decode_xer,
     SEQUENCE_encode_xer,